@@ -0,0 +1,62 @@
+##============================================================================
+##  Copyright (c) Kitware, Inc.
+##  All rights reserved.
+##  See LICENSE.txt for details.
+##  This software is distributed WITHOUT ANY WARRANTY; without even
+##  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+##  PURPOSE.  See the above copyright notice for more information.
+##
+##  Copyright 2014 Sandia Corporation.
+##  Copyright 2014 UT-Battelle, LLC.
+##  Copyright 2014. Los Alamos National Security
+##
+##  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+##  the U.S. Government retains certain rights in this software.
+##
+##  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+##  Laboratory (LANL), the U.S. Government retains certain rights in
+##  this software.
+##============================================================================
+
+# This script is used to create the benchmark regression tests. It runs a
+# benchmark program, writing its results as CSV, and then compares them to a
+# baseline result file with the BenchmarkCompare program. The test fails if
+# any benchmark case got slower than the threshold allows.
+#
+# This script is called with a command like:
+#
+# cmake -D BENCHMARK=<benchmark-program>
+#       -D COMPARE=<BenchmarkCompare-program>
+#       -D BASELINE=<baseline-csv-file>
+#       -D OUTPUT=<output-csv-file>
+#       -D THRESHOLD=<fraction>
+#       -D BENCHMARK_ARGS=<semicolon-separated-arguments>
+#       -P <this-script>
+#
+
+foreach(var BENCHMARK COMPARE BASELINE OUTPUT THRESHOLD)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "Need to define ${var}.")
+  endif()
+endforeach()
+
+execute_process(
+  COMMAND ${BENCHMARK} ${BENCHMARK_ARGS} --format=csv --output=${OUTPUT}
+  RESULT_VARIABLE benchmark_result
+  )
+if(NOT benchmark_result EQUAL 0)
+  message(FATAL_ERROR "Benchmark ${BENCHMARK} failed: ${benchmark_result}")
+endif()
+
+if(NOT EXISTS "${BASELINE}")
+  message(FATAL_ERROR "The baseline \"${BASELINE}\" does not exist. "
+    "To create it, copy the results in \"${OUTPUT}\".")
+endif()
+
+execute_process(
+  COMMAND ${COMPARE} --threshold=${THRESHOLD} ${BASELINE} ${OUTPUT}
+  RESULT_VARIABLE compare_result
+  )
+if(NOT compare_result EQUAL 0)
+  message(FATAL_ERROR "Benchmark ${BENCHMARK} regressed against ${BASELINE}.")
+endif()
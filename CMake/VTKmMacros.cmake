@@ -169,6 +169,7 @@ function(vtkm_unit_tests)
 
   #set up what we possibly need to link too.
   list(APPEND VTKm_UT_LIBRARIES ${TBB_LIBRARIES})
+  list(APPEND VTKm_UT_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
   #set up storage for the include dirs
   set(VTKm_UT_INCLUDE_DIRS )
 
@@ -368,3 +369,49 @@ macro(vtkm_disable_troublesome_thrust_warnings_var flags_var)
   string(REPLACE "-Wall" "" new_flags "${new_flags}")
   set(${flags_var} "${new_flags}")
 endmacro(vtkm_disable_troublesome_thrust_warnings_var)
+
+# Declare benchmark programs. Each source file becomes an executable of the
+# same name. Benchmarks are not run as regular tests since their run time is
+# long and their results depend on the machine. If VTKm_BENCHMARK_BASELINE_DIR
+# is set, a test labeled Benchmark is added for each program that compares its
+# results to <VTKm_BENCHMARK_BASELINE_DIR>/<program>.csv. Usage:
+#
+# vtkm_benchmarks(
+#   SOURCES <source_list>
+#   LIBRARIES <dependent_library_list>
+#   )
+function(vtkm_benchmarks)
+  set(options)
+  set(oneValueArgs)
+  set(multiValueArgs SOURCES LIBRARIES)
+  cmake_parse_arguments(VTKm_BM
+    "${options}" "${oneValueArgs}" "${multiValueArgs}"
+    ${ARGN}
+    )
+
+  if (VTKm_ENABLE_BENCHMARKS)
+    foreach (benchmark ${VTKm_BM_SOURCES})
+      get_filename_component(bname ${benchmark} NAME_WE)
+      add_executable(${bname} ${benchmark})
+      if(VTKm_EXTRA_COMPILER_WARNINGS)
+        set_target_properties(${bname}
+          PROPERTIES COMPILE_FLAGS ${CMAKE_CXX_FLAGS_WARN_EXTRA})
+      endif(VTKm_EXTRA_COMPILER_WARNINGS)
+      target_link_libraries(${bname} ${VTKm_BM_LIBRARIES})
+
+      if (VTKm_ENABLE_TESTING AND VTKm_BENCHMARK_BASELINE_DIR)
+        add_test(NAME ${bname}Regression
+          COMMAND ${CMAKE_COMMAND}
+            "-DBENCHMARK=$<TARGET_FILE:${bname}>"
+            "-DCOMPARE=$<TARGET_FILE:BenchmarkCompare>"
+            "-DBASELINE=${VTKm_BENCHMARK_BASELINE_DIR}/${bname}.csv"
+            "-DOUTPUT=${CMAKE_CURRENT_BINARY_DIR}/${bname}.csv"
+            "-DTHRESHOLD=${VTKm_BENCHMARK_REGRESSION_THRESHOLD}"
+            "-DBENCHMARK_ARGS=${VTKm_BENCHMARK_REGRESSION_ARGS}"
+            -P "${VTKm_SOURCE_DIR}/CMake/VTKmBenchmarkRegression.cmake"
+          )
+        set_tests_properties(${bname}Regression PROPERTIES LABELS Benchmark)
+      endif ()
+    endforeach (benchmark)
+  endif (VTKm_ENABLE_BENCHMARKS)
+endfunction(vtkm_benchmarks)
@@ -0,0 +1,128 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_Bounds_h
+#define vtk_m_Bounds_h
+
+#include <vtkm/Range.h>
+#include <vtkm/Types.h>
+
+namespace vtkm {
+
+/// \brief The axis-aligned box containing a set of points.
+///
+/// Bounds holds a Range for each of the three axes. A default constructed
+/// Bounds is empty.
+///
+struct Bounds
+{
+  vtkm::Range X;
+  vtkm::Range Y;
+  vtkm::Range Z;
+
+  VTKM_EXEC_CONT_EXPORT
+  Bounds() {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  Bounds(const vtkm::Range &xRange,
+         const vtkm::Range &yRange,
+         const vtkm::Range &zRange)
+    : X(xRange), Y(yRange), Z(zRange) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  Bounds(vtkm::Float64 minX, vtkm::Float64 maxX,
+         vtkm::Float64 minY, vtkm::Float64 maxY,
+         vtkm::Float64 minZ, vtkm::Float64 maxZ)
+    : X(minX, maxX), Y(minY, maxY), Z(minZ, maxZ) {  }
+
+  /// Returns true if the bounds contain at least one point.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  bool IsNonEmpty() const
+  {
+    return (this->X.IsNonEmpty()
+            && this->Y.IsNonEmpty()
+            && this->Z.IsNonEmpty());
+  }
+
+  template<typename T>
+  VTKM_EXEC_CONT_EXPORT
+  bool Contains(const vtkm::Vec<T,3> &point) const
+  {
+    return (this->X.Contains(static_cast<vtkm::Float64>(point[0]))
+            && this->Y.Contains(static_cast<vtkm::Float64>(point[1]))
+            && this->Z.Contains(static_cast<vtkm::Float64>(point[2])));
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Vec<vtkm::Float64,3> Center() const
+  {
+    return vtkm::Vec<vtkm::Float64,3>(this->X.Center(),
+                                      this->Y.Center(),
+                                      this->Z.Center());
+  }
+
+  /// Expands the bounds to include the given point.
+  ///
+  template<typename T>
+  VTKM_EXEC_CONT_EXPORT
+  void Include(const vtkm::Vec<T,3> &point)
+  {
+    this->X.Include(static_cast<vtkm::Float64>(point[0]));
+    this->Y.Include(static_cast<vtkm::Float64>(point[1]));
+    this->Z.Include(static_cast<vtkm::Float64>(point[2]));
+  }
+
+  /// Expands the bounds to include the given bounds.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  void Include(const vtkm::Bounds &bounds)
+  {
+    this->X.Include(bounds.X);
+    this->Y.Include(bounds.Y);
+    this->Z.Include(bounds.Z);
+  }
+
+  /// Returns the smallest bounds containing both these bounds and \c other.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Bounds Union(const vtkm::Bounds &other) const
+  {
+    vtkm::Bounds unionBounds(*this);
+    unionBounds.Include(other);
+    return unionBounds;
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  bool operator==(const vtkm::Bounds &other) const
+  {
+    return ((this->X == other.X) && (this->Y == other.Y) &&
+            (this->Z == other.Z));
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  bool operator!=(const vtkm::Bounds &other) const
+  {
+    return !(*this == other);
+  }
+};
+
+} // namespace vtkm
+
+#endif //vtk_m_Bounds_h
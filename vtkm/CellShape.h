@@ -0,0 +1,68 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_CellShape_h
+#define vtk_m_CellShape_h
+
+#include <vtkm/Types.h>
+
+namespace vtkm {
+
+/// CellShape identifies the shape of a cell. The values (and the order of the
+/// points in each shape) match the linear cell types of VTK so that cells can
+/// be passed back and forth without conversion.
+///
+enum CellShape
+{
+  CELL_SHAPE_EMPTY = 0,
+  CELL_SHAPE_VERTEX = 1,
+  CELL_SHAPE_LINE = 3,
+  CELL_SHAPE_TRIANGLE = 5,
+  CELL_SHAPE_POLYGON = 7,
+  CELL_SHAPE_QUAD = 9,
+  CELL_SHAPE_TETRA = 10,
+  CELL_SHAPE_HEXAHEDRON = 12,
+  CELL_SHAPE_WEDGE = 13,
+  CELL_SHAPE_PYRAMID = 14
+};
+
+/// Returns the number of points in a cell of the given shape, or -1 for
+/// shapes (such as polygons) whose number of points varies.
+///
+VTKM_EXEC_CONT_EXPORT
+vtkm::IdComponent CellShapeNumberOfPoints(vtkm::CellShape shape)
+{
+  switch (shape)
+  {
+    case vtkm::CELL_SHAPE_EMPTY: return 0;
+    case vtkm::CELL_SHAPE_VERTEX: return 1;
+    case vtkm::CELL_SHAPE_LINE: return 2;
+    case vtkm::CELL_SHAPE_TRIANGLE: return 3;
+    case vtkm::CELL_SHAPE_QUAD: return 4;
+    case vtkm::CELL_SHAPE_TETRA: return 4;
+    case vtkm::CELL_SHAPE_HEXAHEDRON: return 8;
+    case vtkm::CELL_SHAPE_WEDGE: return 6;
+    case vtkm::CELL_SHAPE_PYRAMID: return 5;
+    default: return -1;
+  }
+}
+
+} // namespace vtkm
+
+#endif //vtk_m_CellShape_h
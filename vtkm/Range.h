@@ -0,0 +1,116 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_Range_h
+#define vtk_m_Range_h
+
+#include <vtkm/Types.h>
+
+#include <limits>
+
+namespace vtkm {
+
+/// \brief The range of values of a scalar quantity.
+///
+/// A default constructed Range is empty: its minimum is larger than its
+/// maximum, so including any value makes it contain exactly that value.
+///
+struct Range
+{
+  vtkm::Float64 Min;
+  vtkm::Float64 Max;
+
+  VTKM_EXEC_CONT_EXPORT
+  Range()
+    : Min(std::numeric_limits<vtkm::Float64>::max()),
+      Max(-std::numeric_limits<vtkm::Float64>::max()) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  Range(vtkm::Float64 min, vtkm::Float64 max) : Min(min), Max(max) {  }
+
+  /// Returns true if the range contains at least one value.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  bool IsNonEmpty() const { return (this->Min <= this->Max); }
+
+  VTKM_EXEC_CONT_EXPORT
+  bool Contains(vtkm::Float64 value) const
+  {
+    return ((this->Min <= value) && (value <= this->Max));
+  }
+
+  /// The distance between the minimum and maximum, or 0 if the range is
+  /// empty.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Float64 Length() const
+  {
+    return this->IsNonEmpty() ? (this->Max - this->Min) : 0.0;
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Float64 Center() const { return 0.5*(this->Max + this->Min); }
+
+  /// Expands the range to include the given value.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  void Include(vtkm::Float64 value)
+  {
+    if (value < this->Min) { this->Min = value; }
+    if (value > this->Max) { this->Max = value; }
+  }
+
+  /// Expands the range to include the given range.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  void Include(const vtkm::Range &range)
+  {
+    if (range.IsNonEmpty())
+    {
+      this->Include(range.Min);
+      this->Include(range.Max);
+    }
+  }
+
+  /// Returns the smallest range containing both this range and \c other.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Range Union(const vtkm::Range &other) const
+  {
+    vtkm::Range unionRange(*this);
+    unionRange.Include(other);
+    return unionRange;
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  bool operator==(const vtkm::Range &other) const
+  {
+    return ((this->Min == other.Min) && (this->Max == other.Max));
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  bool operator!=(const vtkm::Range &other) const
+  {
+    return !(*this == other);
+  }
+};
+
+} // namespace vtkm
+
+#endif //vtk_m_Range_h
@@ -0,0 +1,44 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_TopologyElementTag_h
+#define vtk_m_TopologyElementTag_h
+
+namespace vtkm {
+
+/// \brief A tag used to identify the point elements in a topology.
+///
+/// Connectivity in a cell set is requested as a map from one type of element
+/// to another. For example, the connectivity from \c TopologyElementTagPoint
+/// to \c TopologyElementTagCell has an entry for each cell listing the points
+/// incident on that cell.
+///
+struct TopologyElementTagPoint {  };
+
+/// \brief A tag used to identify the cell elements in a topology.
+///
+/// The connectivity from \c TopologyElementTagCell to \c
+/// TopologyElementTagPoint has an entry for each point listing the cells
+/// incident on that point.
+///
+struct TopologyElementTagCell {  };
+
+} // namespace vtkm
+
+#endif //vtk_m_TopologyElementTag_h
@@ -0,0 +1,540 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_BenchmarkArrayHandle_h
+#define vtk_m_benchmarking_BenchmarkArrayHandle_h
+
+#include <vtkm/benchmarking/BenchmarkDriver.h>
+
+#include <vtkm/TypeListTag.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DynamicArrayHandle.h>
+#include <vtkm/cont/StorageBasic.h>
+#include <vtkm/cont/internal/ArrayHandleExecutionManager.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <boost/scoped_ptr.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace benchmarking {
+
+namespace internal {
+
+/// Functor for DynamicArrayHandle::CastAndCall that records the size of the
+/// array it is called with so that the call cannot be optimized away.
+///
+struct BenchmarkCastAndCallFunctor
+{
+  vtkm::Id *NumberOfValues;
+
+  VTKM_CONT_EXPORT
+  BenchmarkCastAndCallFunctor(vtkm::Id *numberOfValues)
+    : NumberOfValues(numberOfValues) {  }
+
+  template<typename ArrayHandleType>
+  VTKM_CONT_EXPORT
+  void operator()(const ArrayHandleType &array) const
+  {
+    *this->NumberOfValues = array.GetNumberOfValues();
+  }
+};
+
+} // namespace internal
+
+/// This class has a single static member, Run, that measures the overhead of
+/// managing ArrayHandle data with the templated DeviceAdapter: creating
+/// handles, the PrepareFor* calls, moving data between the control and
+/// execution environments, the virtual dispatch of
+/// ArrayHandleExecutionManager, and DynamicArrayHandle::CastAndCall. By
+/// default it measures arrays from 16 to 1M values so that the fixed cost on
+/// small arrays can be compared to the transfer cost on large ones.
+///
+/// Operations that only have a fixed cost (PrepareForInput and
+/// PrepareForInPlace on data already in the execution environment, the
+/// execution manager calls, and CastAndCall) are repeated \c CALLS_PER_RUN
+/// times in each run so that they are long enough to time. Their results are
+/// the times of a single call.
+///
+/// Run recognizes the options described in ParseBenchmarkOptions.
+///
+template<class DeviceAdapterTag>
+struct BenchmarkArrayHandle
+{
+private:
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef vtkm::cont::StorageTagBasic StorageTag;
+
+  static const vtkm::Id CALLS_PER_RUN = 100;
+
+  template<typename Value>
+  struct ArrayTypes
+  {
+    typedef vtkm::cont::ArrayHandle<Value, StorageTag> ArrayHandle;
+  };
+
+  template<typename Value>
+  static VTKM_CONT_EXPORT
+  void FillArray(vtkm::cont::ArrayHandle<Value, StorageTag> &array,
+                 vtkm::Id size)
+  {
+    std::vector<Value> values(static_cast<std::size_t>(size));
+    for (vtkm::Id index = 0; index < size; index++)
+    {
+      values[static_cast<std::size_t>(index)] = TestValue(index, Value());
+    }
+    Algorithm::Copy(vtkm::cont::make_ArrayHandle(values), array);
+  }
+
+  //--------------------------------------------------------------------------
+  // Benchmarks.
+
+  // Creates a handle, allocates it in the execution environment, and
+  // destroys it.
+  template<typename Value>
+  struct BenchCreateAndAllocate
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+
+    VTKM_CONT_EXPORT
+    BenchCreateAndAllocate(vtkm::Id size) : Size(size) {  }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      ValueArrayHandle handle;
+      handle.PrepareForOutput(this->Size, DeviceAdapterTag());
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "CreateAndAllocate";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  // Wraps a user array in a handle and loads it for input.
+  template<typename Value>
+  struct BenchWrapUserArray
+  {
+    vtkm::Id Size;
+    std::vector<Value> UserArray;
+
+    VTKM_CONT_EXPORT
+    BenchWrapUserArray(vtkm::Id size)
+      : Size(size), UserArray(static_cast<std::size_t>(size))
+    {
+      for (vtkm::Id index = 0; index < size; index++)
+      {
+        this->UserArray[static_cast<std::size_t>(index)] =
+            TestValue(index, Value());
+      }
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      vtkm::cont::make_ArrayHandle(this->UserArray)
+          .PrepareForInput(DeviceAdapterTag());
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "WrapUserArray";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  // PrepareForInput on data already in the execution environment.
+  template<typename Value>
+  struct BenchPrepareForInput
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle Handle;
+
+    VTKM_CONT_EXPORT
+    BenchPrepareForInput(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->Handle, size);
+    }
+
+    VTKM_CONT_EXPORT void Setup()
+    {
+      this->Handle.PrepareForInput(DeviceAdapterTag());
+    }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      for (vtkm::Id call = 0; call < CALLS_PER_RUN; call++)
+      {
+        this->Handle.PrepareForInput(DeviceAdapterTag());
+      }
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "PrepareForInput";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const { return 0; }
+  };
+
+  // PrepareForOutput on a handle that already has an execution array.
+  template<typename Value>
+  struct BenchPrepareForOutput
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle Handle;
+
+    VTKM_CONT_EXPORT
+    BenchPrepareForOutput(vtkm::Id size) : Size(size)
+    {
+      this->Handle.PrepareForOutput(size, DeviceAdapterTag());
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      this->Handle.PrepareForOutput(this->Size, DeviceAdapterTag());
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "PrepareForOutput";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  // PrepareForInPlace on data already in the execution environment.
+  template<typename Value>
+  struct BenchPrepareForInPlace
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle Handle;
+
+    VTKM_CONT_EXPORT
+    BenchPrepareForInPlace(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->Handle, size);
+    }
+
+    VTKM_CONT_EXPORT void Setup()
+    {
+      this->Handle.PrepareForInPlace(DeviceAdapterTag());
+    }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      for (vtkm::Id call = 0; call < CALLS_PER_RUN; call++)
+      {
+        this->Handle.PrepareForInPlace(DeviceAdapterTag());
+      }
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "PrepareForInPlace";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const { return 0; }
+  };
+
+  // GetPortalControl releases the execution array, so the following
+  // PrepareForInPlace has to load the data to the execution environment
+  // again.
+  template<typename Value>
+  struct BenchControlExecutionRoundTrip
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle Handle;
+
+    VTKM_CONT_EXPORT
+    BenchControlExecutionRoundTrip(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->Handle, size);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      this->Handle.GetPortalControl();
+      this->Handle.PrepareForInPlace(DeviceAdapterTag());
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "ControlExecutionRoundTrip";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return 2*this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  // Gets the control portal of data last written in the execution
+  // environment, which copies the data back to the control environment.
+  template<typename Value>
+  struct BenchSyncToControl
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle Handle;
+
+    VTKM_CONT_EXPORT
+    BenchSyncToControl(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->Handle, size);
+    }
+
+    VTKM_CONT_EXPORT void Setup()
+    {
+      this->Handle.PrepareForInPlace(DeviceAdapterTag());
+    }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      this->Handle.GetPortalConstControl();
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "SyncToControl";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  // Gets execution portals through the ArrayHandleExecutionManagerBase
+  // interface, which checks the device at run time and uses virtual methods.
+  template<typename Value>
+  struct BenchExecutionManager
+  {
+    typedef vtkm::cont::internal::ArrayHandleExecutionManagerBase<
+        Value, StorageTag> ManagerBaseType;
+    typedef vtkm::cont::internal::ArrayHandleExecutionManager<
+        Value, StorageTag, DeviceAdapterTag> ManagerType;
+    typedef typename ManagerBaseType::template ExecutionTypes<DeviceAdapterTag>
+        ::PortalConst PortalConstType;
+
+    vtkm::Id Size;
+    typename ArrayTypes<Value>::ArrayHandle Handle;
+    boost::scoped_ptr<ManagerBaseType> Manager;
+    vtkm::Id NumberOfValues;
+
+    VTKM_CONT_EXPORT
+    BenchExecutionManager(vtkm::Id size)
+      : Size(size), Manager(new ManagerType), NumberOfValues(0)
+    {
+      FillArray(this->Handle, size);
+      this->Manager->LoadDataForInput(this->Handle.GetPortalConstControl());
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      for (vtkm::Id call = 0; call < CALLS_PER_RUN; call++)
+      {
+        PortalConstType portal =
+            this->Manager->GetPortalConstExecution(DeviceAdapterTag());
+        this->NumberOfValues = portal.GetNumberOfValues();
+      }
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "ExecutionManager";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const { return 0; }
+  };
+
+  // Resolves the type of a DynamicArrayHandle holding the array.
+  template<typename Value>
+  struct BenchCastAndCall
+  {
+    vtkm::Id Size;
+    vtkm::cont::DynamicArrayHandle DynamicHandle;
+    vtkm::Id NumberOfValues;
+
+    VTKM_CONT_EXPORT
+    BenchCastAndCall(vtkm::Id size) : Size(size), NumberOfValues(0)
+    {
+      typename ArrayTypes<Value>::ArrayHandle handle;
+      FillArray(handle, size);
+      this->DynamicHandle = vtkm::cont::DynamicArrayHandle(handle);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      internal::BenchmarkCastAndCallFunctor functor(&this->NumberOfValues);
+      for (vtkm::Id call = 0; call < CALLS_PER_RUN; call++)
+      {
+        this->DynamicHandle.CastAndCall(functor);
+      }
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "CastAndCall";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const { return 0; }
+  };
+
+  //--------------------------------------------------------------------------
+  template<template<typename> class BenchmarkType, typename Value>
+  static VTKM_CONT_EXPORT
+  void RunBenchmark(const std::string &algorithmName,
+                    const BenchmarkOptions &options,
+                    std::vector<BenchmarkResult> &results,
+                    vtkm::Id callsPerRun = 1)
+  {
+    RunBenchmarkSizes<DeviceAdapterTag, BenchmarkType, Value>(
+          algorithmName,
+          vtkm::testing::TypeName<Value>::Name(),
+          options,
+          results,
+          callsPerRun);
+  }
+
+  struct BenchmarkValueTypeFunctor
+  {
+    const BenchmarkOptions &Opts;
+    std::vector<BenchmarkResult> &Results;
+
+    VTKM_CONT_EXPORT
+    BenchmarkValueTypeFunctor(const BenchmarkOptions &options,
+                              std::vector<BenchmarkResult> &results)
+      : Opts(options), Results(results) {  }
+
+    template<typename Value>
+    VTKM_CONT_EXPORT void operator()(Value) const
+    {
+      RunBenchmark<BenchCreateAndAllocate, Value>(
+            "CreateAndAllocate", this->Opts, this->Results);
+      RunBenchmark<BenchWrapUserArray, Value>(
+            "WrapUserArray", this->Opts, this->Results);
+      RunBenchmark<BenchPrepareForInput, Value>(
+            "PrepareForInput", this->Opts, this->Results, CALLS_PER_RUN);
+      RunBenchmark<BenchPrepareForOutput, Value>(
+            "PrepareForOutput", this->Opts, this->Results);
+      RunBenchmark<BenchPrepareForInPlace, Value>(
+            "PrepareForInPlace", this->Opts, this->Results, CALLS_PER_RUN);
+      RunBenchmark<BenchControlExecutionRoundTrip, Value>(
+            "ControlExecutionRoundTrip", this->Opts, this->Results);
+      RunBenchmark<BenchSyncToControl, Value>(
+            "SyncToControl", this->Opts, this->Results);
+      RunBenchmark<BenchExecutionManager, Value>(
+            "ExecutionManager", this->Opts, this->Results, CALLS_PER_RUN);
+      RunBenchmark<BenchCastAndCall, Value>(
+            "CastAndCall", this->Opts, this->Results, CALLS_PER_RUN);
+    }
+  };
+
+public:
+  /// Runs the benchmarks selected by the command line arguments and writes
+  /// the results in the requested format. Returns 0 on success or a nonzero
+  /// error code, so that it can be returned from a main function.
+  ///
+  static VTKM_CONT_EXPORT int Run(int argc, char *argv[])
+  {
+    BenchmarkOptions options;
+    options.MinimumSize = 16;
+    int status;
+    if (!ParseBenchmarkOptions(argc,
+                               argv,
+                               "BenchmarkArrayHandle",
+                               "CreateAndAllocate, WrapUserArray, "
+                               "PrepareForInput, PrepareForOutput, "
+                               "PrepareForInPlace, ControlExecutionRoundTrip, "
+                               "SyncToControl, ExecutionManager, CastAndCall",
+                               options,
+                               status))
+    {
+      return status;
+    }
+
+    if (options.PrintProgress())
+    {
+      std::cout << "Benchmarking ArrayHandle on device adapter "
+                << vtkm::cont::internal::DeviceAdapterTraits<DeviceAdapterTag>
+                   ::GetId()
+                << std::endl;
+    }
+
+    std::vector<BenchmarkResult> results;
+    try
+    {
+      vtkm::ListForEach(BenchmarkValueTypeFunctor(options, results),
+                        vtkm::TypeListTagCommon());
+      WriteBenchmarkResults(options, results);
+    }
+    catch (const vtkm::cont::Error &error)
+    {
+      std::cerr << "Error while benchmarking: " << error.GetMessage()
+                << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+};
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_BenchmarkArrayHandle_h
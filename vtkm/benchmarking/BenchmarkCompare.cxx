@@ -0,0 +1,148 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#include <vtkm/benchmarking/BenchmarkComparison.h>
+#include <vtkm/benchmarking/BenchmarkOutput.h>
+#include <vtkm/benchmarking/Benchmarker.h>
+
+#include <vtkm/cont/Error.h>
+#include <vtkm/testing/OptionParser.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// Compares two benchmark result files written with --format=csv. Returns 0
+// if no benchmark case got slower than the threshold, 1 if any case
+// regressed, and 2 if the files could not be compared.
+
+namespace {
+
+namespace option = vtkm::testing::option;
+
+enum CompareOptionIndex {
+  UNKNOWN,
+  HELP,
+  THRESHOLD,
+  REQUIRE_ALL
+};
+
+std::vector<vtkm::benchmarking::BenchmarkResult>
+ReadResults(const char *fileName)
+{
+  std::ifstream file(fileName);
+  if (!file)
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          std::string("Could not open benchmark result file ") + fileName);
+  }
+  return vtkm::benchmarking::ReadBenchmarkResultsCSV(file);
+}
+
+} // anonymous namespace
+
+int main(int argc, char *argv[])
+{
+  typedef vtkm::benchmarking::internal::BenchmarkArg Arg;
+
+  const option::Descriptor usage[] =
+  {
+    {UNKNOWN, 0, "", "", Arg::Unknown,
+     "USAGE: BenchmarkCompare [options] baseline.csv current.csv\n\n"
+     "Options:"},
+    {HELP, 0, "h", "help", Arg::None,
+     "  --help, -h \tPrint this help message."},
+    {THRESHOLD, 0, "", "threshold", Arg::Numeric,
+     "  --threshold=F \tA case regresses when its median time grows by more "
+     "than this fraction (default 0.1)."},
+    {REQUIRE_ALL, 0, "", "require-all", Arg::None,
+     "  --require-all \tAlso fail when a case is missing from either file."},
+    {0, 0, 0, 0, 0, 0}
+  };
+
+  // Skip the program name.
+  if (argc > 0) { argc--; argv++; }
+
+  option::Stats stats(usage, argc, argv);
+  std::vector<option::Option> opts(stats.options_max);
+  std::vector<option::Option> buffer(stats.buffer_max);
+  option::Parser parse(usage, argc, argv, &opts[0], &buffer[0]);
+
+  if (parse.error() || (!opts[HELP] && (parse.nonOptionsCount() != 2)))
+  {
+    option::printUsage(std::cerr, usage);
+    return 2;
+  }
+  if (opts[HELP])
+  {
+    option::printUsage(std::cout, usage);
+    return 0;
+  }
+
+  vtkm::Float64 threshold = 0.1;
+  if (opts[THRESHOLD])
+  {
+    threshold = std::atof(opts[THRESHOLD].arg);
+  }
+
+  try
+  {
+    std::vector<vtkm::benchmarking::BenchmarkResult> baseline =
+        ReadResults(parse.nonOption(0));
+    std::vector<vtkm::benchmarking::BenchmarkResult> current =
+        ReadResults(parse.nonOption(1));
+
+    std::vector<vtkm::benchmarking::BenchmarkResult> unmatched;
+    std::vector<vtkm::benchmarking::BenchmarkComparison> comparisons =
+        vtkm::benchmarking::CompareBenchmarkResults(
+          baseline, current, threshold, unmatched);
+
+    vtkm::benchmarking::PrintComparisons(std::cout, comparisons);
+
+    vtkm::Id numRegressions = 0;
+    for (std::size_t index = 0; index < comparisons.size(); index++)
+    {
+      if (comparisons[index].Regressed) { numRegressions++; }
+    }
+
+    for (std::size_t index = 0; index < unmatched.size(); index++)
+    {
+      std::cout << "Unmatched case: " << unmatched[index].Algorithm << " "
+                << unmatched[index].ValueType << " "
+                << unmatched[index].Size << " "
+                << unmatched[index].Device << std::endl;
+    }
+
+    std::cout << comparisons.size() << " cases compared, "
+              << numRegressions << " regressed, "
+              << unmatched.size() << " unmatched." << std::endl;
+
+    if (numRegressions > 0) { return 1; }
+    if (opts[REQUIRE_ALL] && !unmatched.empty()) { return 1; }
+  }
+  catch (const vtkm::cont::Error &error)
+  {
+    std::cerr << error.GetMessage() << std::endl;
+    return 2;
+  }
+
+  return 0;
+}
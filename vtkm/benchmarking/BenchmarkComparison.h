@@ -0,0 +1,154 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_BenchmarkComparison_h
+#define vtk_m_benchmarking_BenchmarkComparison_h
+
+#include <vtkm/benchmarking/Benchmarker.h>
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace benchmarking {
+
+/// The result of comparing one benchmark case between a baseline run and a
+/// current run. \c Ratio is the current median time divided by the baseline
+/// median time, so values greater than 1 are slower.
+///
+struct BenchmarkComparison
+{
+  BenchmarkResult Baseline;
+  BenchmarkResult Current;
+  vtkm::Float64 Ratio;
+  bool Regressed;
+
+  BenchmarkComparison() : Ratio(1), Regressed(false) {  }
+};
+
+namespace internal {
+
+VTKM_CONT_EXPORT
+std::string BenchmarkKey(const BenchmarkResult &result)
+{
+  std::stringstream key;
+  key << result.Algorithm << "|" << result.ValueType << "|"
+      << result.Size << "|" << result.Device;
+  return key.str();
+}
+
+} // namespace internal
+
+/// Matches the cases in \p current to the cases in \p baseline by algorithm,
+/// value type, size, and device. A case regresses when its median time is
+/// more than <tt>(1 + threshold)</tt> times the baseline median. Cases only
+/// in one of the sets are added to \p unmatched.
+///
+VTKM_CONT_EXPORT
+std::vector<BenchmarkComparison>
+CompareBenchmarkResults(const std::vector<BenchmarkResult> &baseline,
+                        const std::vector<BenchmarkResult> &current,
+                        vtkm::Float64 threshold,
+                        std::vector<BenchmarkResult> &unmatched)
+{
+  typedef std::map<std::string, const BenchmarkResult *> MapType;
+  MapType baselineMap;
+  for (std::vector<BenchmarkResult>::const_iterator result = baseline.begin();
+       result != baseline.end();
+       result++)
+  {
+    baselineMap[internal::BenchmarkKey(*result)] = &(*result);
+  }
+
+  std::vector<BenchmarkComparison> comparisons;
+  for (std::vector<BenchmarkResult>::const_iterator result = current.begin();
+       result != current.end();
+       result++)
+  {
+    MapType::iterator match = baselineMap.find(internal::BenchmarkKey(*result));
+    if (match == baselineMap.end())
+    {
+      unmatched.push_back(*result);
+      continue;
+    }
+
+    BenchmarkComparison comparison;
+    comparison.Baseline = *match->second;
+    comparison.Current = *result;
+    if (comparison.Baseline.MedianTime > 0)
+    {
+      comparison.Ratio =
+          comparison.Current.MedianTime/comparison.Baseline.MedianTime;
+    }
+    comparison.Regressed = (comparison.Ratio > 1 + threshold);
+    comparisons.push_back(comparison);
+
+    baselineMap.erase(match);
+  }
+
+  for (MapType::iterator remaining = baselineMap.begin();
+       remaining != baselineMap.end();
+       remaining++)
+  {
+    unmatched.push_back(*remaining->second);
+  }
+
+  return comparisons;
+}
+
+/// Prints a table of comparisons with regressions marked.
+///
+VTKM_CONT_EXPORT
+void PrintComparisons(std::ostream &stream,
+                      const std::vector<BenchmarkComparison> &comparisons)
+{
+  std::ios::fmtflags oldFlags = stream.flags();
+  std::streamsize oldPrecision = stream.precision();
+
+  for (std::vector<BenchmarkComparison>::const_iterator comparison =
+         comparisons.begin();
+       comparison != comparisons.end();
+       comparison++)
+  {
+    const BenchmarkResult &current = comparison->Current;
+    stream << std::left
+           << std::setw(26) << current.Algorithm << " "
+           << std::setw(32) << current.ValueType << " "
+           << std::right << std::setw(12) << current.Size << " "
+           << std::scientific << std::setprecision(3)
+           << comparison->Baseline.MedianTime << " s -> "
+           << current.MedianTime << " s  "
+           << std::fixed << std::setprecision(2)
+           << "x" << comparison->Ratio
+           << (comparison->Regressed ? "  REGRESSION" : "")
+           << std::endl;
+  }
+
+  stream.flags(oldFlags);
+  stream.precision(oldPrecision);
+}
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_BenchmarkComparison_h
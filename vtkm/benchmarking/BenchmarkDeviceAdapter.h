@@ -0,0 +1,603 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_BenchmarkDeviceAdapter_h
+#define vtk_m_benchmarking_BenchmarkDeviceAdapter_h
+
+#include <vtkm/benchmarking/BenchmarkDriver.h>
+
+#include <vtkm/TypeListTag.h>
+#include <vtkm/TypeTraits.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/StorageBasic.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace benchmarking {
+
+namespace internal {
+
+/// Values used by the benchmarks are drawn from a limited set of indices so
+/// that the test values do not overflow the smaller integer types.
+///
+static const vtkm::Int64 BENCHMARK_VALUE_RANGE = 1048573;
+
+/// Less-than comparison reversed. Used to benchmark sorting with a custom
+/// comparison functor.
+///
+struct BenchmarkGreater
+{
+  template<typename T>
+  VTKM_EXEC_CONT_EXPORT bool operator()(const T &a, const T &b) const
+  {
+    return b < a;
+  }
+};
+
+/// Fills an array with test values. When \c Scramble is true, the values are
+/// in a pseudo-random order. Otherwise they are sorted with every value
+/// repeated \c Repeat times.
+///
+template<typename PortalType>
+struct BenchmarkFillKernel : public vtkm::exec::FunctorBase
+{
+  typedef typename PortalType::ValueType ValueType;
+
+  PortalType Portal;
+  bool Scramble;
+  vtkm::Id Repeat;
+
+  VTKM_CONT_EXPORT
+  BenchmarkFillKernel(const PortalType &portal, bool scramble, vtkm::Id repeat)
+    : Portal(portal), Scramble(scramble), Repeat(repeat) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Int64 valueIndex;
+    if (this->Scramble)
+    {
+      valueIndex = (static_cast<vtkm::Int64>(index)*7919 + 104729)
+          % BENCHMARK_VALUE_RANGE;
+    }
+    else
+    {
+      valueIndex = (static_cast<vtkm::Int64>(index)/this->Repeat)
+          % BENCHMARK_VALUE_RANGE;
+    }
+    this->Portal.Set(index,
+                     TestValue(static_cast<vtkm::Id>(valueIndex), ValueType()));
+  }
+};
+
+/// Fills a stencil array with alternating 0 and 1 so that stream compaction
+/// keeps half of the values.
+///
+template<typename PortalType>
+struct BenchmarkStencilKernel : public vtkm::exec::FunctorBase
+{
+  PortalType Portal;
+
+  VTKM_CONT_EXPORT
+  BenchmarkStencilKernel(const PortalType &portal) : Portal(portal) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    this->Portal.Set(index, index%2);
+  }
+};
+
+} // namespace internal
+
+/// This class has a single static member, Run, that measures the performance
+/// of the basic algorithms of the templated DeviceAdapter. Each algorithm is
+/// run on every type in \c TypeListTagCommon and on arrays with sizes that
+/// grow from 1K to the requested maximum by factors of 32.
+///
+/// The following options are recognized by Run.
+///
+/// \li \c --min-size=N Smallest array size benchmarked (default 1024).
+/// \li \c --max-size=N Largest array size benchmarked (default 1048576, at
+///     most 1073741824).
+/// \li \c --max-runs=N Maximum runs of each benchmark (default 100).
+/// \li \c --max-time=S Maximum seconds spent on each benchmark (default 1).
+/// \li \c --algorithms=A,B,... Only run the named algorithms.
+/// \li \c --format=F Write results as \c text, \c csv, or \c json.
+/// \li \c --output=FILE Write the results to a file instead of standard out.
+///
+template<class DeviceAdapterTag>
+struct BenchmarkDeviceAdapter
+{
+private:
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef vtkm::cont::StorageTagBasic StorageTag;
+
+  typedef vtkm::cont::ArrayHandle<vtkm::Id, StorageTag> IdArrayHandle;
+
+  template<typename Value>
+  struct ArrayTypes
+  {
+    typedef vtkm::cont::ArrayHandle<Value, StorageTag> ArrayHandle;
+    typedef typename ArrayHandle::template ExecutionTypes<DeviceAdapterTag>
+        ::Portal Portal;
+  };
+
+  template<typename Value>
+  static VTKM_CONT_EXPORT
+  void FillArray(vtkm::cont::ArrayHandle<Value, StorageTag> &array,
+                 vtkm::Id size,
+                 bool scramble,
+                 vtkm::Id repeat = 1)
+  {
+    typedef typename ArrayTypes<Value>::Portal PortalType;
+    Algorithm::Schedule(
+          internal::BenchmarkFillKernel<PortalType>(
+            array.PrepareForOutput(size, DeviceAdapterTag()),
+            scramble,
+            repeat),
+          size);
+  }
+
+  //--------------------------------------------------------------------------
+  // Benchmarks. Each constructor allocates its input in the execution
+  // environment so that data transfer is not included in the measurements.
+
+  template<typename Value>
+  struct BenchCopy
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle InputHandle;
+    ValueArrayHandle OutputHandle;
+
+    VTKM_CONT_EXPORT
+    BenchCopy(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->InputHandle, size, true);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::Copy(this->InputHandle, this->OutputHandle);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const { return "Copy"; }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return 2*this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  template<typename Value>
+  struct BenchLowerBounds
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle InputHandle;
+    ValueArrayHandle ValuesHandle;
+    IdArrayHandle OutputHandle;
+
+    VTKM_CONT_EXPORT
+    BenchLowerBounds(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->InputHandle, size, false);
+      FillArray(this->ValuesHandle, size, true);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::LowerBounds(this->InputHandle,
+                             this->ValuesHandle,
+                             this->OutputHandle);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "LowerBounds";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Size*static_cast<vtkm::Id>(sizeof(Value)+sizeof(vtkm::Id));
+    }
+  };
+
+  template<typename Value>
+  struct BenchUpperBounds
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle InputHandle;
+    ValueArrayHandle ValuesHandle;
+    IdArrayHandle OutputHandle;
+
+    VTKM_CONT_EXPORT
+    BenchUpperBounds(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->InputHandle, size, false);
+      FillArray(this->ValuesHandle, size, true);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::UpperBounds(this->InputHandle,
+                             this->ValuesHandle,
+                             this->OutputHandle);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "UpperBounds";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Size*static_cast<vtkm::Id>(sizeof(Value)+sizeof(vtkm::Id));
+    }
+  };
+
+  template<typename Value>
+  struct BenchScanInclusive
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle InputHandle;
+    ValueArrayHandle OutputHandle;
+
+    VTKM_CONT_EXPORT
+    BenchScanInclusive(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->InputHandle, size, true);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::ScanInclusive(this->InputHandle, this->OutputHandle);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "ScanInclusive";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return 2*this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  template<typename Value>
+  struct BenchScanExclusive
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle InputHandle;
+    ValueArrayHandle OutputHandle;
+
+    VTKM_CONT_EXPORT
+    BenchScanExclusive(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->InputHandle, size, true);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::ScanExclusive(this->InputHandle, this->OutputHandle);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "ScanExclusive";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return 2*this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  template<typename Value>
+  struct BenchSort
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle UnsortedHandle;
+    ValueArrayHandle ValuesHandle;
+
+    VTKM_CONT_EXPORT
+    BenchSort(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->UnsortedHandle, size, true);
+    }
+
+    // Sorting is done in place, so restore the unsorted values each run.
+    VTKM_CONT_EXPORT void Setup()
+    {
+      Algorithm::Copy(this->UnsortedHandle, this->ValuesHandle);
+    }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::Sort(this->ValuesHandle);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const { return "Sort"; }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return 2*this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  template<typename Value>
+  struct BenchSortWithComparison
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle UnsortedHandle;
+    ValueArrayHandle ValuesHandle;
+
+    VTKM_CONT_EXPORT
+    BenchSortWithComparison(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->UnsortedHandle, size, true);
+    }
+
+    VTKM_CONT_EXPORT void Setup()
+    {
+      Algorithm::Copy(this->UnsortedHandle, this->ValuesHandle);
+    }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::Sort(this->ValuesHandle, internal::BenchmarkGreater());
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "SortWithComparison";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return 2*this->Size*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  template<typename Value>
+  struct BenchStreamCompact
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    vtkm::Id Size;
+    ValueArrayHandle InputHandle;
+    IdArrayHandle StencilHandle;
+    ValueArrayHandle OutputHandle;
+
+    VTKM_CONT_EXPORT
+    BenchStreamCompact(vtkm::Id size) : Size(size)
+    {
+      typedef typename IdArrayHandle::template ExecutionTypes<DeviceAdapterTag>
+          ::Portal IdPortalType;
+
+      FillArray(this->InputHandle, size, true);
+      Algorithm::Schedule(
+            internal::BenchmarkStencilKernel<IdPortalType>(
+              this->StencilHandle.PrepareForOutput(size, DeviceAdapterTag())),
+            size);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::StreamCompact(this->InputHandle,
+                               this->StencilHandle,
+                               this->OutputHandle);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "StreamCompact";
+    }
+
+    // Reads the input and stencil and writes half of the input.
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Size*static_cast<vtkm::Id>(sizeof(Value)+sizeof(vtkm::Id))
+          + (this->Size/2)*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  template<typename Value>
+  struct BenchUnique
+  {
+    typedef typename ArrayTypes<Value>::ArrayHandle ValueArrayHandle;
+
+    static const vtkm::Id REPEAT = 4;
+
+    vtkm::Id Size;
+    ValueArrayHandle SortedHandle;
+    ValueArrayHandle ValuesHandle;
+
+    VTKM_CONT_EXPORT
+    BenchUnique(vtkm::Id size) : Size(size)
+    {
+      FillArray(this->SortedHandle, size, false, REPEAT);
+    }
+
+    // Unique shrinks the array in place, so restore the values each run.
+    VTKM_CONT_EXPORT void Setup()
+    {
+      Algorithm::Copy(this->SortedHandle, this->ValuesHandle);
+    }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      Algorithm::Unique(this->ValuesHandle);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const { return "Unique"; }
+
+    // Reads every value and writes one of each repeated group.
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Size*static_cast<vtkm::Id>(sizeof(Value))
+          + (this->Size/REPEAT)*static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  template<template<typename> class BenchmarkType, typename Value>
+  static VTKM_CONT_EXPORT
+  void RunBenchmark(const std::string &algorithmName,
+                    const BenchmarkOptions &options,
+                    std::vector<BenchmarkResult> &results)
+  {
+    RunBenchmarkSizes<DeviceAdapterTag, BenchmarkType, Value>(
+          algorithmName,
+          vtkm::testing::TypeName<Value>::Name(),
+          options,
+          results);
+  }
+
+  struct BenchmarkValueTypeFunctor
+  {
+    const BenchmarkOptions &Opts;
+    std::vector<BenchmarkResult> &Results;
+
+    VTKM_CONT_EXPORT
+    BenchmarkValueTypeFunctor(const BenchmarkOptions &options,
+                              std::vector<BenchmarkResult> &results)
+      : Opts(options), Results(results) {  }
+
+    template<typename Value>
+    VTKM_CONT_EXPORT void operator()(Value) const
+    {
+      RunBenchmark<BenchCopy, Value>(
+            "Copy", this->Opts, this->Results);
+      RunBenchmark<BenchLowerBounds, Value>(
+            "LowerBounds", this->Opts, this->Results);
+      RunBenchmark<BenchUpperBounds, Value>(
+            "UpperBounds", this->Opts, this->Results);
+      this->RunScans(Value(),
+                     typename vtkm::TypeTraits<Value>::DimensionalityTag());
+      RunBenchmark<BenchSort, Value>(
+            "Sort", this->Opts, this->Results);
+      RunBenchmark<BenchSortWithComparison, Value>(
+            "SortWithComparison", this->Opts, this->Results);
+      RunBenchmark<BenchStreamCompact, Value>(
+            "StreamCompact", this->Opts, this->Results);
+      RunBenchmark<BenchUnique, Value>(
+            "Unique", this->Opts, this->Results);
+    }
+
+    template<typename Value>
+    VTKM_CONT_EXPORT
+    void RunScans(Value, vtkm::TypeTraitsScalarTag) const
+    {
+      RunBenchmark<BenchScanInclusive, Value>(
+            "ScanInclusive", this->Opts, this->Results);
+      RunBenchmark<BenchScanExclusive, Value>(
+            "ScanExclusive", this->Opts, this->Results);
+    }
+
+    // The scan algorithms start from a scalar 0, so they are only benchmarked
+    // on scalar types.
+    template<typename Value>
+    VTKM_CONT_EXPORT
+    void RunScans(Value, vtkm::TypeTraitsVectorTag) const {  }
+  };
+
+public:
+  /// Runs the benchmarks selected by the command line arguments and writes
+  /// the results in the requested format. Returns 0 on success or a nonzero
+  /// error code, so that it can be returned from a main function.
+  ///
+  static VTKM_CONT_EXPORT int Run(int argc, char *argv[])
+  {
+    BenchmarkOptions options;
+    int status;
+    if (!ParseBenchmarkOptions(argc,
+                               argv,
+                               "BenchmarkDeviceAdapter",
+                               "Copy, LowerBounds, UpperBounds, "
+                               "ScanInclusive, ScanExclusive, Sort, "
+                               "SortWithComparison, StreamCompact, Unique",
+                               options,
+                               status))
+    {
+      return status;
+    }
+
+    if (options.PrintProgress())
+    {
+      std::cout << "Benchmarking device adapter "
+                << vtkm::cont::internal::DeviceAdapterTraits<DeviceAdapterTag>
+                   ::GetId()
+                << std::endl;
+    }
+
+    std::vector<BenchmarkResult> results;
+    try
+    {
+      vtkm::ListForEach(BenchmarkValueTypeFunctor(options, results),
+                        vtkm::TypeListTagCommon());
+      WriteBenchmarkResults(options, results);
+    }
+    catch (const vtkm::cont::Error &error)
+    {
+      std::cerr << "Error while benchmarking: " << error.GetMessage()
+                << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+};
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_BenchmarkDeviceAdapter_h
@@ -0,0 +1,370 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_BenchmarkDriver_h
+#define vtk_m_benchmarking_BenchmarkDriver_h
+
+#include <vtkm/benchmarking/BenchmarkOutput.h>
+#include <vtkm/benchmarking/Benchmarker.h>
+
+#include <vtkm/cont/ErrorControlOutOfMemory.h>
+
+#include <vtkm/testing/OptionParser.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace benchmarking {
+
+namespace internal {
+
+// Splits a comma separated list of names, dropping the spaces around each
+// name.
+VTKM_CONT_EXPORT
+std::vector<std::string> SplitBenchmarkNames(const std::string &list)
+{
+  std::vector<std::string> names;
+  std::string::size_type start = 0;
+  while (true)
+  {
+    std::string::size_type end = list.find(',', start);
+    std::string name = list.substr(
+          start, (end == std::string::npos) ? end : end - start);
+    std::string::size_type first = name.find_first_not_of(' ');
+    std::string::size_type last = name.find_last_not_of(' ');
+    names.push_back((first == std::string::npos)
+                    ? std::string() : name.substr(first, last - first + 1));
+    if (end == std::string::npos) { break; }
+    start = end + 1;
+  }
+  return names;
+}
+
+} // namespace internal
+
+/// Options shared by the benchmark programs. Set the members before calling
+/// ParseBenchmarkOptions to change the defaults of a program.
+///
+struct BenchmarkOptions
+{
+  vtkm::Id MinimumSize;
+  vtkm::Id MaximumSize;
+  vtkm::Id SizeMultiplier;
+  vtkm::Id MaximumRuns;
+  vtkm::Float64 MaximumTime;
+  std::string Algorithms;
+  std::string Format;
+  std::string OutputFile;
+
+  VTKM_CONT_EXPORT
+  BenchmarkOptions()
+    : MinimumSize(1024),
+      MaximumSize(1024*1024),
+      SizeMultiplier(32),
+      MaximumRuns(100),
+      MaximumTime(1.0),
+      Format("text") {  }
+
+  /// Returns true if the named algorithm was selected on the command line.
+  ///
+  VTKM_CONT_EXPORT
+  bool RunAlgorithm(const std::string &name) const
+  {
+    if (this->Algorithms.empty()) { return true; }
+    std::vector<std::string> names =
+        internal::SplitBenchmarkNames(this->Algorithms);
+    return (std::find(names.begin(), names.end(), name) != names.end());
+  }
+
+  /// Progress is printed to standard out unless the machine readable
+  /// results are written there.
+  ///
+  VTKM_CONT_EXPORT
+  bool PrintProgress() const
+  {
+    return (this->Format == "text") || !this->OutputFile.empty();
+  }
+};
+
+namespace internal {
+
+enum BenchmarkOptionIndex {
+  UNKNOWN,
+  HELP,
+  MIN_SIZE,
+  MAX_SIZE,
+  MAX_RUNS,
+  MAX_TIME,
+  ALGORITHMS,
+  FORMAT,
+  OUTPUT
+};
+
+} // namespace internal
+
+/// Parses the command line of a benchmark program into \p options. The
+/// values already in \p options are the defaults. \p algorithmNames is the
+/// comma separated list of the algorithms the program measures, which is
+/// shown in the help message and checked against the names selected with
+/// --algorithms. Returns false if the
+/// program should exit (on an error or when help was requested), in which
+/// case \p status is the program's exit code.
+///
+VTKM_CONT_EXPORT
+bool ParseBenchmarkOptions(int argc,
+                           char *argv[],
+                           const std::string &programName,
+                           const std::string &algorithmNames,
+                           BenchmarkOptions &options,
+                           int &status)
+{
+  namespace option = vtkm::testing::option;
+  typedef internal::BenchmarkArg Arg;
+
+  std::stringstream usageHelp;
+  usageHelp << "USAGE: " << programName << " [options]\n\nOptions:";
+  std::stringstream minSizeHelp;
+  minSizeHelp << "  --min-size=N \tSmallest array size to benchmark (default "
+              << options.MinimumSize << ").";
+  std::stringstream maxSizeHelp;
+  maxSizeHelp << "  --max-size=N \tLargest array size to benchmark (default "
+              << options.MaximumSize << ", at most 1073741824). Sizes grow "
+              << "by a factor of " << options.SizeMultiplier << ".";
+  std::stringstream maxRunsHelp;
+  maxRunsHelp << "  --max-runs=N \tMaximum number of runs of each benchmark "
+              << "(default " << options.MaximumRuns << ").";
+  std::stringstream maxTimeHelp;
+  maxTimeHelp << "  --max-time=S \tMaximum seconds spent on each benchmark "
+              << "(default " << options.MaximumTime << ").";
+  std::string algorithmsHelp =
+      "  --algorithms=A,B \tComma separated algorithms to run. One of "
+      + algorithmNames + " (default all).";
+
+  // The help strings must stay alive while usage is used.
+  const std::string usageString = usageHelp.str();
+  const std::string minSizeString = minSizeHelp.str();
+  const std::string maxSizeString = maxSizeHelp.str();
+  const std::string maxRunsString = maxRunsHelp.str();
+  const std::string maxTimeString = maxTimeHelp.str();
+
+  const option::Descriptor usage[] =
+  {
+    {internal::UNKNOWN, 0, "", "", Arg::Unknown, usageString.c_str()},
+    {internal::HELP, 0, "h", "help", Arg::None,
+     "  --help, -h \tPrint this help message."},
+    {internal::MIN_SIZE, 0, "", "min-size", Arg::Numeric,
+     minSizeString.c_str()},
+    {internal::MAX_SIZE, 0, "", "max-size", Arg::Numeric,
+     maxSizeString.c_str()},
+    {internal::MAX_RUNS, 0, "", "max-runs", Arg::Numeric,
+     maxRunsString.c_str()},
+    {internal::MAX_TIME, 0, "", "max-time", Arg::Numeric,
+     maxTimeString.c_str()},
+    {internal::ALGORITHMS, 0, "", "algorithms", Arg::NonEmpty,
+     algorithmsHelp.c_str()},
+    {internal::FORMAT, 0, "", "format", Arg::NonEmpty,
+     "  --format=F \tFormat of the results. One of text, csv, json "
+     "(default text)."},
+    {internal::OUTPUT, 0, "", "output", Arg::NonEmpty,
+     "  --output=FILE \tWrite the results to FILE instead of standard out."},
+    {0, 0, 0, 0, 0, 0}
+  };
+
+  // Skip the program name.
+  if (argc > 0) { argc--; argv++; }
+
+  option::Stats stats(usage, argc, argv);
+  std::vector<option::Option> opts(stats.options_max);
+  std::vector<option::Option> buffer(stats.buffer_max);
+  option::Parser parse(usage, argc, argv, &opts[0], &buffer[0]);
+
+  if (parse.error())
+  {
+    option::printUsage(std::cerr, usage);
+    status = 1;
+    return false;
+  }
+  if (opts[internal::HELP])
+  {
+    option::printUsage(std::cout, usage);
+    status = 0;
+    return false;
+  }
+
+  // Sizes are read as floating point so that out of range values can be
+  // reported rather than overflowing vtkm::Id.
+  vtkm::Float64 minimumSize = static_cast<vtkm::Float64>(options.MinimumSize);
+  vtkm::Float64 maximumSize = static_cast<vtkm::Float64>(options.MaximumSize);
+  vtkm::Float64 maximumRuns = static_cast<vtkm::Float64>(options.MaximumRuns);
+  if (opts[internal::MIN_SIZE])
+  {
+    minimumSize = std::atof(opts[internal::MIN_SIZE].arg);
+  }
+  if (opts[internal::MAX_SIZE])
+  {
+    maximumSize = std::atof(opts[internal::MAX_SIZE].arg);
+  }
+  if (opts[internal::MAX_RUNS])
+  {
+    maximumRuns = std::atof(opts[internal::MAX_RUNS].arg);
+  }
+  if (opts[internal::MAX_TIME])
+  {
+    options.MaximumTime = std::atof(opts[internal::MAX_TIME].arg);
+  }
+  if (opts[internal::ALGORITHMS])
+  {
+    options.Algorithms = opts[internal::ALGORITHMS].arg;
+  }
+  if (opts[internal::FORMAT])
+  {
+    options.Format = opts[internal::FORMAT].arg;
+  }
+  if (opts[internal::OUTPUT])
+  {
+    options.OutputFile = opts[internal::OUTPUT].arg;
+  }
+
+  const vtkm::Float64 largestSize = 1024.0*1024.0*1024.0;
+  if ((minimumSize < 1)
+      || (maximumSize > largestSize)
+      || (minimumSize > maximumSize)
+      || (maximumRuns < 1)
+      || (maximumRuns > largestSize)
+      || (options.MaximumTime < 0))
+  {
+    std::cerr << "Invalid benchmark sizes, runs, or time." << std::endl;
+    option::printUsage(std::cerr, usage);
+    status = 1;
+    return false;
+  }
+  if ((options.Format != "text")
+      && (options.Format != "csv")
+      && (options.Format != "json"))
+  {
+    std::cerr << "Unknown output format " << options.Format << std::endl;
+    option::printUsage(std::cerr, usage);
+    status = 1;
+    return false;
+  }
+  if (!options.Algorithms.empty())
+  {
+    std::vector<std::string> knownNames =
+        internal::SplitBenchmarkNames(algorithmNames);
+    std::vector<std::string> selectedNames =
+        internal::SplitBenchmarkNames(options.Algorithms);
+    for (std::size_t index = 0; index < selectedNames.size(); index++)
+    {
+      if (std::find(knownNames.begin(), knownNames.end(), selectedNames[index])
+          == knownNames.end())
+      {
+        std::cerr << "Unknown algorithm \"" << selectedNames[index] << "\""
+                  << std::endl;
+        option::printUsage(std::cerr, usage);
+        status = 1;
+        return false;
+      }
+    }
+  }
+  options.MinimumSize = static_cast<vtkm::Id>(minimumSize);
+  options.MaximumSize = static_cast<vtkm::Id>(maximumSize);
+  options.MaximumRuns = static_cast<vtkm::Id>(maximumRuns);
+
+  status = 0;
+  return true;
+}
+
+/// Runs the benchmark \c BenchmarkType<Value> for every array size selected
+/// in \p options and appends the results to \p results. The benchmark is
+/// constructed with the array size. Sizes that run out of memory are
+/// reported and skipped along with all larger sizes. \p callsPerRun is
+/// passed to Benchmarker::Run.
+///
+template<class DeviceAdapterTag,
+         template<typename> class BenchmarkType,
+         typename Value>
+VTKM_CONT_EXPORT
+void RunBenchmarkSizes(const std::string &algorithmName,
+                       const std::string &typeName,
+                       const BenchmarkOptions &options,
+                       std::vector<BenchmarkResult> &results,
+                       vtkm::Id callsPerRun = 1)
+{
+  if (!options.RunAlgorithm(algorithmName)) { return; }
+
+  Benchmarker<DeviceAdapterTag> benchmarker(options.MaximumRuns,
+                                            options.MaximumTime);
+
+  for (vtkm::Int64 size = options.MinimumSize;
+       size <= options.MaximumSize;
+       size *= options.SizeMultiplier)
+  {
+    try
+    {
+      BenchmarkType<Value> benchmark(static_cast<vtkm::Id>(size));
+      BenchmarkResult result =
+          benchmarker.Run(benchmark,
+                          typeName,
+                          static_cast<vtkm::Id>(size),
+                          callsPerRun);
+      if (options.PrintProgress())
+      {
+        PrintResult(std::cout, result);
+      }
+      results.push_back(result);
+    }
+    catch (const vtkm::cont::ErrorControlOutOfMemory &)
+    {
+      std::cerr << "Skipping " << algorithmName << " " << typeName
+                << " of size " << size << ": out of memory." << std::endl;
+      return;
+    }
+    catch (const std::bad_alloc &)
+    {
+      std::cerr << "Skipping " << algorithmName << " " << typeName
+                << " of size " << size << ": out of memory." << std::endl;
+      return;
+    }
+  }
+}
+
+/// Writes the results collected by a benchmark program in the format
+/// selected in \p options. Text results are printed as they are measured, so
+/// they are only written again when an output file is given.
+///
+VTKM_CONT_EXPORT
+void WriteBenchmarkResults(const BenchmarkOptions &options,
+                           const std::vector<BenchmarkResult> &results)
+{
+  if ((options.Format != "text") || !options.OutputFile.empty())
+  {
+    WriteBenchmarkResults(options.Format, options.OutputFile, results);
+  }
+}
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_BenchmarkDriver_h
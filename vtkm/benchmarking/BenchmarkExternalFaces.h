@@ -0,0 +1,294 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_BenchmarkExternalFaces_h
+#define vtk_m_benchmarking_BenchmarkExternalFaces_h
+
+#include <vtkm/benchmarking/BenchmarkDriver.h>
+
+#include <vtkm/CellShape.h>
+#include <vtkm/Types.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+#include <vtkm/worklet/ExternalFaces.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace benchmarking {
+
+/// This class has a single static member, Run, that measures
+/// vtkm::worklet::ExternalFaces on the templated DeviceAdapter. The size of
+/// a benchmark is the number of points of a cubic grid of hexahedra, or of
+/// the same grid with each cube split into six tetrahedra. It measures the
+/// default method, which counts the faces with a hash table, against the
+/// method that sorts the keys of all the faces.
+///
+/// Run recognizes the options described in ParseBenchmarkOptions.
+///
+template<class DeviceAdapterTag>
+struct BenchmarkExternalFaces
+{
+private:
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef vtkm::worklet::ExternalFaces<DeviceAdapterTag> ExternalFacesType;
+
+  // The corners of the cube at the given index of a grid with the given
+  // number of points on each side, in the order of a VTK hexahedron.
+  static VTKM_CONT_EXPORT
+  void GetCubeCorners(vtkm::Id side, vtkm::Id cube, vtkm::Id corners[8])
+  {
+    vtkm::Id cubesPerSide = side - 1;
+    vtkm::Id i = cube % cubesPerSide;
+    vtkm::Id j = (cube/cubesPerSide) % cubesPerSide;
+    vtkm::Id k = cube/(cubesPerSide*cubesPerSide);
+    vtkm::Id first = (k*side + j)*side + i;
+    corners[0] = first;
+    corners[1] = first + 1;
+    corners[2] = first + side + 1;
+    corners[3] = first + side;
+    for (vtkm::IdComponent corner = 0; corner < 4; corner++)
+    {
+      corners[corner+4] = corners[corner] + side*side;
+    }
+  }
+
+  struct Hexahedra
+  {
+    static VTKM_CONT_EXPORT
+    void AddCells(vtkm::Id side,
+                  vtkm::Id cube,
+                  std::vector<vtkm::UInt8> &shapes,
+                  std::vector<vtkm::IdComponent> &numIndices,
+                  std::vector<vtkm::Id> &connectivity)
+    {
+      vtkm::Id corners[8];
+      GetCubeCorners(side, cube, corners);
+      shapes.push_back(static_cast<vtkm::UInt8>(vtkm::CELL_SHAPE_HEXAHEDRON));
+      numIndices.push_back(8);
+      connectivity.insert(connectivity.end(), corners, corners + 8);
+    }
+  };
+
+  // Six tetrahedra around the diagonal from corner 0 to corner 6, which
+  // match across the faces of neighboring cubes.
+  struct Tetrahedra
+  {
+    static VTKM_CONT_EXPORT
+    void AddCells(vtkm::Id side,
+                  vtkm::Id cube,
+                  std::vector<vtkm::UInt8> &shapes,
+                  std::vector<vtkm::IdComponent> &numIndices,
+                  std::vector<vtkm::Id> &connectivity)
+    {
+      const vtkm::IdComponent paths[6][2] = {
+        { 1, 2 }, { 1, 5 }, { 4, 5 }, { 4, 7 }, { 3, 7 }, { 3, 2 } };
+      vtkm::Id corners[8];
+      GetCubeCorners(side, cube, corners);
+      for (vtkm::IdComponent tet = 0; tet < 6; tet++)
+      {
+        shapes.push_back(static_cast<vtkm::UInt8>(vtkm::CELL_SHAPE_TETRA));
+        numIndices.push_back(4);
+        connectivity.push_back(corners[0]);
+        connectivity.push_back(corners[paths[tet][0]]);
+        connectivity.push_back(corners[paths[tet][1]]);
+        connectivity.push_back(corners[6]);
+      }
+    }
+  };
+
+  // A grid with about the given number of points.
+  template<typename MeshType>
+  struct Mesh
+  {
+    vtkm::cont::CellSetExplicit<> Cells;
+
+    VTKM_CONT_EXPORT
+    Mesh(vtkm::Id size)
+    {
+      vtkm::Id side = static_cast<vtkm::Id>(
+            std::floor(std::pow(static_cast<vtkm::Float64>(size),
+                                1.0/3.0) + 0.5));
+      if (side < 2) { side = 2; }
+      vtkm::Id numCubes = (side-1)*(side-1)*(side-1);
+
+      std::vector<vtkm::UInt8> shapes;
+      std::vector<vtkm::IdComponent> numIndices;
+      std::vector<vtkm::Id> connectivity;
+      for (vtkm::Id cube = 0; cube < numCubes; cube++)
+      {
+        MeshType::AddCells(side, cube, shapes, numIndices, connectivity);
+      }
+
+      typename vtkm::cont::CellSetExplicit<>::ShapeArrayType shapeArray;
+      typename vtkm::cont::CellSetExplicit<>::NumIndicesArrayType
+          numIndicesArray;
+      typename vtkm::cont::CellSetExplicit<>::ConnectivityArrayType
+          connectivityArray;
+      Algorithm::Copy(vtkm::cont::make_ArrayHandle(shapes), shapeArray);
+      Algorithm::Copy(vtkm::cont::make_ArrayHandle(numIndices),
+                      numIndicesArray);
+      Algorithm::Copy(vtkm::cont::make_ArrayHandle(connectivity),
+                      connectivityArray);
+      this->Cells = vtkm::cont::CellSetExplicit<>("cells", side*side*side);
+      this->Cells.Fill(shapeArray, numIndicesArray, connectivityArray);
+    }
+
+    VTKM_CONT_EXPORT
+    vtkm::Id GetBytes() const
+    {
+      return this->Cells.GetConnectivityArray().GetNumberOfValues()
+          * static_cast<vtkm::Id>(sizeof(vtkm::Id));
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  // Benchmarks.
+
+  // External faces counted with a hash table.
+  template<typename MeshType>
+  struct BenchExternalFaces
+  {
+    vtkm::Id Size;
+    Mesh<MeshType> Data;
+    ExternalFacesType ExternalFaces;
+
+    VTKM_CONT_EXPORT
+    BenchExternalFaces(vtkm::Id size) : Size(size), Data(size) {  }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      this->ExternalFaces.Run(this->Data.Cells);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "ExternalFaces";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Data.GetBytes();
+    }
+  };
+
+  // External faces found by sorting the keys of all the faces.
+  template<typename MeshType>
+  struct BenchExternalFacesSort
+  {
+    vtkm::Id Size;
+    Mesh<MeshType> Data;
+    ExternalFacesType ExternalFaces;
+
+    VTKM_CONT_EXPORT
+    BenchExternalFacesSort(vtkm::Id size) : Size(size), Data(size)
+    {
+      this->ExternalFaces.SetUseSorting(true);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      this->ExternalFaces.Run(this->Data.Cells);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "ExternalFacesSort";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Data.GetBytes();
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  template<template<typename> class BenchmarkType, typename MeshType>
+  static VTKM_CONT_EXPORT
+  void RunBenchmark(const std::string &algorithmName,
+                    const std::string &meshName,
+                    const BenchmarkOptions &options,
+                    std::vector<BenchmarkResult> &results)
+  {
+    RunBenchmarkSizes<DeviceAdapterTag, BenchmarkType, MeshType>(
+          algorithmName, meshName, options, results);
+  }
+
+public:
+  /// Runs the benchmarks selected by the command line arguments and writes
+  /// the results in the requested format. Returns 0 on success or a nonzero
+  /// error code, so that it can be returned from a main function.
+  ///
+  static VTKM_CONT_EXPORT int Run(int argc, char *argv[])
+  {
+    BenchmarkOptions options;
+    int status;
+    if (!ParseBenchmarkOptions(argc,
+                               argv,
+                               "BenchmarkExternalFaces",
+                               "ExternalFaces, ExternalFacesSort",
+                               options,
+                               status))
+    {
+      return status;
+    }
+
+    if (options.PrintProgress())
+    {
+      std::cout << "Benchmarking external faces on device adapter "
+                << vtkm::cont::internal::DeviceAdapterTraits<DeviceAdapterTag>
+                   ::GetId()
+                << std::endl;
+    }
+
+    std::vector<BenchmarkResult> results;
+    try
+    {
+      RunBenchmark<BenchExternalFaces, Tetrahedra>(
+            "ExternalFaces", "Tetrahedra", options, results);
+      RunBenchmark<BenchExternalFacesSort, Tetrahedra>(
+            "ExternalFacesSort", "Tetrahedra", options, results);
+      RunBenchmark<BenchExternalFaces, Hexahedra>(
+            "ExternalFaces", "Hexahedra", options, results);
+      RunBenchmark<BenchExternalFacesSort, Hexahedra>(
+            "ExternalFacesSort", "Hexahedra", options, results);
+      WriteBenchmarkResults(options, results);
+    }
+    catch (const vtkm::cont::Error &error)
+    {
+      std::cerr << "Error while benchmarking: " << error.GetMessage()
+                << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+};
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_BenchmarkExternalFaces_h
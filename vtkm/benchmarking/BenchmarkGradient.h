@@ -0,0 +1,329 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_BenchmarkGradient_h
+#define vtk_m_benchmarking_BenchmarkGradient_h
+
+#include <vtkm/benchmarking/BenchmarkDriver.h>
+
+#include <vtkm/ListTag.h>
+#include <vtkm/Types.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+#include <vtkm/worklet/Gradient.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace benchmarking {
+
+/// This class has a single static member, Run, that measures
+/// vtkm::worklet::Gradient on the templated DeviceAdapter. The size of a
+/// benchmark is the number of points of a cubic grid (a 512^3 grid is
+/// --min-size=134217728), which holds a smooth scalar field and a swirling
+/// velocity field. It measures the gradient of the scalar field, the
+/// gradient of the velocity, the velocity gradient together with its
+/// vorticity, divergence, and Q-criterion, and the Q-criterion alone.
+///
+/// Run recognizes the options described in ParseBenchmarkOptions.
+///
+template<class DeviceAdapterTag>
+struct BenchmarkGradient
+{
+private:
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef vtkm::worklet::Gradient<DeviceAdapterTag> GradientType;
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+
+  // A grid with about the given number of points and the fields on it.
+  template<typename Value>
+  struct Grid
+  {
+    typedef vtkm::Vec<Value,3> VectorType;
+
+    vtkm::cont::ArrayHandleUniformPointCoordinates Coordinates;
+    vtkm::cont::ArrayHandle<Value> Scalars;
+    vtkm::cont::ArrayHandle<VectorType> Vectors;
+
+    VTKM_CONT_EXPORT
+    Grid(vtkm::Id size)
+    {
+      vtkm::Id dimension = static_cast<vtkm::Id>(
+            std::floor(std::pow(static_cast<vtkm::Float64>(size),
+                                1.0/3.0) + 0.5));
+      if (dimension < 2) { dimension = 2; }
+      this->Coordinates = vtkm::cont::ArrayHandleUniformPointCoordinates(
+            vtkm::Extent3(vtkm::Id3(0, 0, 0),
+                          vtkm::Id3(dimension - 1)),
+            PointType(0.0f),
+            PointType(1.0f/static_cast<vtkm::FloatDefault>(dimension - 1)));
+
+      vtkm::Id numPoints = this->Coordinates.GetNumberOfValues();
+      std::vector<Value> scalars(static_cast<std::size_t>(numPoints));
+      std::vector<VectorType> vectors(static_cast<std::size_t>(numPoints));
+      for (vtkm::Id index = 0; index < numPoints; index++)
+      {
+        PointType point =
+            this->Coordinates.GetPortalConstControl().Get(index);
+        vtkm::Float64 x = point[0];
+        vtkm::Float64 y = point[1];
+        vtkm::Float64 z = point[2];
+        std::size_t entry = static_cast<std::size_t>(index);
+        scalars[entry] = static_cast<Value>(
+              std::sin(6.0*x)*std::cos(5.0*y)*std::sin(4.0*z + 1.0));
+        vectors[entry] = VectorType(
+              static_cast<Value>(std::sin(3.0*y)*std::cos(2.0*z)),
+              static_cast<Value>(std::sin(3.0*z)*std::cos(2.0*x)),
+              static_cast<Value>(std::sin(3.0*x)*std::cos(2.0*y)));
+      }
+      Algorithm::Copy(vtkm::cont::make_ArrayHandle(scalars), this->Scalars);
+      Algorithm::Copy(vtkm::cont::make_ArrayHandle(vectors), this->Vectors);
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  // Benchmarks.
+
+  // The gradient of a scalar field.
+  template<typename Value>
+  struct BenchGradient
+  {
+    vtkm::Id Size;
+    Grid<Value> Data;
+    vtkm::cont::ArrayHandle<vtkm::Vec<Value,3> > Gradient;
+
+    VTKM_CONT_EXPORT
+    BenchGradient(vtkm::Id size) : Size(size), Data(size) {  }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      GradientType().Run(this->Data.Coordinates,
+                         this->Data.Scalars,
+                         this->Gradient);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "Gradient";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Data.Scalars.GetNumberOfValues()
+          * static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  // The gradient of a vector field, all components in one pass.
+  template<typename Value>
+  struct BenchVectorGradient
+  {
+    typedef vtkm::Vec<Value,3> VectorType;
+
+    vtkm::Id Size;
+    Grid<Value> Data;
+    vtkm::cont::ArrayHandle<vtkm::Vec<VectorType,3> > Gradient;
+
+    VTKM_CONT_EXPORT
+    BenchVectorGradient(vtkm::Id size) : Size(size), Data(size) {  }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      GradientType().Run(this->Data.Coordinates,
+                         this->Data.Vectors,
+                         this->Gradient);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "VectorGradient";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Data.Vectors.GetNumberOfValues()
+          * static_cast<vtkm::Id>(sizeof(VectorType));
+    }
+  };
+
+  // The gradient of a vector field with the quantities derived from it,
+  // either all of them or only the Q-criterion.
+  template<typename Value, bool AllOutputs>
+  struct BenchDerivedBase
+  {
+    typedef vtkm::Vec<Value,3> VectorType;
+
+    vtkm::Id Size;
+    Grid<Value> Data;
+    GradientType Gradient;
+    vtkm::cont::ArrayHandle<vtkm::Vec<VectorType,3> > GradientValues;
+    vtkm::cont::ArrayHandle<VectorType> Vorticity;
+    vtkm::cont::ArrayHandle<Value> Divergence;
+    vtkm::cont::ArrayHandle<Value> QCriterion;
+
+    VTKM_CONT_EXPORT
+    BenchDerivedBase(vtkm::Id size) : Size(size), Data(size)
+    {
+      this->Gradient.SetComputeGradient(AllOutputs);
+      this->Gradient.SetComputeVorticity(AllOutputs);
+      this->Gradient.SetComputeDivergence(AllOutputs);
+      this->Gradient.SetComputeQCriterion(true);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      this->Gradient.Run(this->Data.Coordinates,
+                         this->Data.Vectors,
+                         this->GradientValues,
+                         this->Vorticity,
+                         this->Divergence,
+                         this->QCriterion);
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Data.Vectors.GetNumberOfValues()
+          * static_cast<vtkm::Id>(sizeof(VectorType));
+    }
+  };
+
+  template<typename Value>
+  struct BenchVectorDerived : public BenchDerivedBase<Value,true>
+  {
+    VTKM_CONT_EXPORT
+    BenchVectorDerived(vtkm::Id size) : BenchDerivedBase<Value,true>(size) {  }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "VectorDerived";
+    }
+  };
+
+  template<typename Value>
+  struct BenchQCriterion : public BenchDerivedBase<Value,false>
+  {
+    VTKM_CONT_EXPORT
+    BenchQCriterion(vtkm::Id size) : BenchDerivedBase<Value,false>(size) {  }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "QCriterion";
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  template<template<typename> class BenchmarkType, typename Value>
+  static VTKM_CONT_EXPORT
+  void RunBenchmark(const std::string &algorithmName,
+                    const BenchmarkOptions &options,
+                    std::vector<BenchmarkResult> &results)
+  {
+    RunBenchmarkSizes<DeviceAdapterTag, BenchmarkType, Value>(
+          algorithmName,
+          vtkm::testing::TypeName<Value>::Name(),
+          options,
+          results);
+  }
+
+  struct BenchmarkValueTypeFunctor
+  {
+    const BenchmarkOptions &Opts;
+    std::vector<BenchmarkResult> &Results;
+
+    VTKM_CONT_EXPORT
+    BenchmarkValueTypeFunctor(const BenchmarkOptions &options,
+                              std::vector<BenchmarkResult> &results)
+      : Opts(options), Results(results) {  }
+
+    template<typename Value>
+    VTKM_CONT_EXPORT void operator()(Value) const
+    {
+      RunBenchmark<BenchGradient, Value>(
+            "Gradient", this->Opts, this->Results);
+      RunBenchmark<BenchVectorGradient, Value>(
+            "VectorGradient", this->Opts, this->Results);
+      RunBenchmark<BenchVectorDerived, Value>(
+            "VectorDerived", this->Opts, this->Results);
+      RunBenchmark<BenchQCriterion, Value>(
+            "QCriterion", this->Opts, this->Results);
+    }
+  };
+
+public:
+  /// Runs the benchmarks selected by the command line arguments and writes
+  /// the results in the requested format. Returns 0 on success or a nonzero
+  /// error code, so that it can be returned from a main function.
+  ///
+  static VTKM_CONT_EXPORT int Run(int argc, char *argv[])
+  {
+    BenchmarkOptions options;
+    int status;
+    if (!ParseBenchmarkOptions(argc,
+                               argv,
+                               "BenchmarkGradient",
+                               "Gradient, VectorGradient, VectorDerived, "
+                               "QCriterion",
+                               options,
+                               status))
+    {
+      return status;
+    }
+
+    if (options.PrintProgress())
+    {
+      std::cout << "Benchmarking gradient on device adapter "
+                << vtkm::cont::internal::DeviceAdapterTraits<DeviceAdapterTag>
+                   ::GetId()
+                << std::endl;
+    }
+
+    std::vector<BenchmarkResult> results;
+    try
+    {
+      vtkm::ListForEach(
+            BenchmarkValueTypeFunctor(options, results),
+            vtkm::ListTagBase<vtkm::Float32,vtkm::Float64>());
+      WriteBenchmarkResults(options, results);
+    }
+    catch (const vtkm::cont::Error &error)
+    {
+      std::cerr << "Error while benchmarking: " << error.GetMessage()
+                << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+};
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_BenchmarkGradient_h
@@ -0,0 +1,306 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_BenchmarkIsosurface_h
+#define vtk_m_benchmarking_BenchmarkIsosurface_h
+
+#include <vtkm/benchmarking/BenchmarkDriver.h>
+
+#include <vtkm/ListTag.h>
+#include <vtkm/Types.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+#include <vtkm/worklet/IsosurfaceUniformGrid.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace benchmarking {
+
+/// This class has a single static member, Run, that measures
+/// vtkm::worklet::IsosurfaceUniformGrid on the templated DeviceAdapter. The
+/// size of a benchmark is the number of points of a cubic grid, which holds
+/// a smooth field with several lobes so that the surfaces cross a fair
+/// fraction of the cells. It measures extracting one isosurface with and
+/// without merging points, and extracting four isosurfaces in one pass.
+///
+/// Run recognizes the options described in ParseBenchmarkOptions.
+///
+template<class DeviceAdapterTag>
+struct BenchmarkIsosurface
+{
+private:
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef vtkm::worklet::IsosurfaceUniformGrid<DeviceAdapterTag>
+      IsosurfaceType;
+  typedef typename IsosurfaceType::PointType PointType;
+
+  static const vtkm::IdComponent NUM_ISO_VALUES = 4;
+
+  // A grid with about the given number of points and a field on it that
+  // varies between -1 and 1.
+  template<typename Value>
+  struct Grid
+  {
+    vtkm::cont::ArrayHandleUniformPointCoordinates Coordinates;
+    vtkm::cont::ArrayHandle<Value> Field;
+
+    VTKM_CONT_EXPORT
+    Grid(vtkm::Id size)
+    {
+      vtkm::Id dimension = static_cast<vtkm::Id>(
+            std::floor(std::pow(static_cast<vtkm::Float64>(size),
+                                1.0/3.0) + 0.5));
+      if (dimension < 2) { dimension = 2; }
+      this->Coordinates = vtkm::cont::ArrayHandleUniformPointCoordinates(
+            vtkm::Extent3(vtkm::Id3(0, 0, 0),
+                          vtkm::Id3(dimension - 1)),
+            PointType(0.0f),
+            PointType(1.0f/static_cast<vtkm::FloatDefault>(dimension - 1)));
+
+      vtkm::Id numPoints = this->Coordinates.GetNumberOfValues();
+      std::vector<Value> values(static_cast<std::size_t>(numPoints));
+      for (vtkm::Id index = 0; index < numPoints; index++)
+      {
+        PointType point =
+            this->Coordinates.GetPortalConstControl().Get(index);
+        values[static_cast<std::size_t>(index)] = static_cast<Value>(
+              std::sin(6.0*point[0])*std::cos(5.0*point[1])
+              * std::sin(4.0*point[2] + 1.0));
+      }
+      Algorithm::Copy(vtkm::cont::make_ArrayHandle(values), this->Field);
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  // Benchmarks.
+
+  // One isosurface with duplicate points merged.
+  template<typename Value>
+  struct BenchIsosurface
+  {
+    vtkm::Id Size;
+    Grid<Value> Data;
+    vtkm::cont::ArrayHandle<PointType> Points;
+    vtkm::cont::ArrayHandle<vtkm::Id> Connectivity;
+
+    VTKM_CONT_EXPORT
+    BenchIsosurface(vtkm::Id size) : Size(size), Data(size) {  }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      IsosurfaceType().Run(this->Data.Coordinates,
+                           this->Data.Field,
+                           Value(0.1f),
+                           this->Points,
+                           this->Connectivity);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "Isosurface";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Data.Field.GetNumberOfValues()
+          * static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  // One isosurface leaving three points per triangle.
+  template<typename Value>
+  struct BenchIsosurfaceNoMerge
+  {
+    vtkm::Id Size;
+    Grid<Value> Data;
+    IsosurfaceType Isosurface;
+    vtkm::cont::ArrayHandle<PointType> Points;
+    vtkm::cont::ArrayHandle<vtkm::Id> Connectivity;
+
+    VTKM_CONT_EXPORT
+    BenchIsosurfaceNoMerge(vtkm::Id size) : Size(size), Data(size)
+    {
+      this->Isosurface.SetMergeDuplicatePoints(false);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      this->Isosurface.Run(this->Data.Coordinates,
+                           this->Data.Field,
+                           Value(0.1f),
+                           this->Points,
+                           this->Connectivity);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "IsosurfaceNoMerge";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Data.Field.GetNumberOfValues()
+          * static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  // Several isosurfaces extracted in one pass over the field.
+  template<typename Value>
+  struct BenchIsosurfaceMultiple
+  {
+    vtkm::Id Size;
+    Grid<Value> Data;
+    vtkm::cont::ArrayHandle<Value> IsoValues;
+    vtkm::cont::ArrayHandle<PointType> Points;
+    vtkm::cont::ArrayHandle<vtkm::Id> Connectivity;
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> IsoValueIndices;
+
+    VTKM_CONT_EXPORT
+    BenchIsosurfaceMultiple(vtkm::Id size) : Size(size), Data(size)
+    {
+      std::vector<Value> isoValues;
+      for (vtkm::IdComponent index = 0; index < NUM_ISO_VALUES; index++)
+      {
+        isoValues.push_back(static_cast<Value>(-0.6 + 0.4*index));
+      }
+      Algorithm::Copy(vtkm::cont::make_ArrayHandle(isoValues),
+                      this->IsoValues);
+    }
+
+    VTKM_CONT_EXPORT void Setup() {  }
+
+    VTKM_CONT_EXPORT void operator()()
+    {
+      IsosurfaceType().Run(this->Data.Coordinates,
+                           this->Data.Field,
+                           this->IsoValues,
+                           this->Points,
+                           this->Connectivity,
+                           this->IsoValueIndices);
+    }
+
+    VTKM_CONT_EXPORT std::string GetAlgorithmName() const
+    {
+      return "IsosurfaceMultiple";
+    }
+
+    VTKM_CONT_EXPORT vtkm::Id GetBytesPerRun() const
+    {
+      return this->Data.Field.GetNumberOfValues()
+          * static_cast<vtkm::Id>(sizeof(Value));
+    }
+  };
+
+  //--------------------------------------------------------------------------
+  template<template<typename> class BenchmarkType, typename Value>
+  static VTKM_CONT_EXPORT
+  void RunBenchmark(const std::string &algorithmName,
+                    const BenchmarkOptions &options,
+                    std::vector<BenchmarkResult> &results)
+  {
+    RunBenchmarkSizes<DeviceAdapterTag, BenchmarkType, Value>(
+          algorithmName,
+          vtkm::testing::TypeName<Value>::Name(),
+          options,
+          results);
+  }
+
+  struct BenchmarkValueTypeFunctor
+  {
+    const BenchmarkOptions &Opts;
+    std::vector<BenchmarkResult> &Results;
+
+    VTKM_CONT_EXPORT
+    BenchmarkValueTypeFunctor(const BenchmarkOptions &options,
+                              std::vector<BenchmarkResult> &results)
+      : Opts(options), Results(results) {  }
+
+    template<typename Value>
+    VTKM_CONT_EXPORT void operator()(Value) const
+    {
+      RunBenchmark<BenchIsosurface, Value>(
+            "Isosurface", this->Opts, this->Results);
+      RunBenchmark<BenchIsosurfaceNoMerge, Value>(
+            "IsosurfaceNoMerge", this->Opts, this->Results);
+      RunBenchmark<BenchIsosurfaceMultiple, Value>(
+            "IsosurfaceMultiple", this->Opts, this->Results);
+    }
+  };
+
+public:
+  /// Runs the benchmarks selected by the command line arguments and writes
+  /// the results in the requested format. Returns 0 on success or a nonzero
+  /// error code, so that it can be returned from a main function.
+  ///
+  static VTKM_CONT_EXPORT int Run(int argc, char *argv[])
+  {
+    BenchmarkOptions options;
+    int status;
+    if (!ParseBenchmarkOptions(argc,
+                               argv,
+                               "BenchmarkIsosurface",
+                               "Isosurface, IsosurfaceNoMerge, "
+                               "IsosurfaceMultiple",
+                               options,
+                               status))
+    {
+      return status;
+    }
+
+    if (options.PrintProgress())
+    {
+      std::cout << "Benchmarking isosurface on device adapter "
+                << vtkm::cont::internal::DeviceAdapterTraits<DeviceAdapterTag>
+                   ::GetId()
+                << std::endl;
+    }
+
+    std::vector<BenchmarkResult> results;
+    try
+    {
+      vtkm::ListForEach(
+            BenchmarkValueTypeFunctor(options, results),
+            vtkm::ListTagBase<vtkm::Float32,vtkm::Float64>());
+      WriteBenchmarkResults(options, results);
+    }
+    catch (const vtkm::cont::Error &error)
+    {
+      std::cerr << "Error while benchmarking: " << error.GetMessage()
+                << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+};
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_BenchmarkIsosurface_h
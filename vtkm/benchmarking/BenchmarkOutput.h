@@ -0,0 +1,415 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_BenchmarkOutput_h
+#define vtk_m_benchmarking_BenchmarkOutput_h
+
+#include <vtkm/benchmarking/Benchmarker.h>
+#include <vtkm/benchmarking/BenchmarkSystemInformation.h>
+
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace vtkm {
+namespace benchmarking {
+
+/// Describes the machine and build that produced a set of benchmark results.
+/// The build description comes from the CMake configuration (the same values
+/// reported by the SystemInformation test) and the host name is queried when
+/// the benchmark runs.
+///
+struct SystemInformation
+{
+  std::string HostName;
+  std::string OperatingSystem;
+  std::string Processor;
+  std::string Compiler;
+  std::string BuildType;
+  vtkm::Id IdSize;
+  vtkm::Id ScalarSize;
+
+  SystemInformation() : IdSize(0), ScalarSize(0) {  }
+
+  /// Returns the information for the running program.
+  ///
+  static VTKM_CONT_EXPORT SystemInformation GetCurrent()
+  {
+    SystemInformation info;
+
+    char hostName[256];
+    hostName[0] = '\0';
+#ifdef _WIN32
+    DWORD hostNameSize = sizeof(hostName);
+    if (!GetComputerNameA(hostName, &hostNameSize))
+    {
+      hostName[0] = '\0';
+    }
+#else
+    if (gethostname(hostName, sizeof(hostName)) != 0)
+    {
+      hostName[0] = '\0';
+    }
+#endif
+    hostName[sizeof(hostName)-1] = '\0';
+
+    info.HostName = hostName;
+    info.OperatingSystem = VTKM_BENCHMARK_SYSTEM_NAME;
+    info.Processor = VTKM_BENCHMARK_SYSTEM_PROCESSOR;
+    info.Compiler = VTKM_BENCHMARK_CXX_COMPILER;
+    info.BuildType = VTKM_BENCHMARK_BUILD_TYPE;
+    info.IdSize = VTKM_SIZE_ID;
+    info.ScalarSize = VTKM_SIZE_SCALAR;
+    return info;
+  }
+};
+
+namespace internal {
+
+VTKM_CONT_EXPORT
+std::string EscapeJSON(const std::string &value)
+{
+  std::string result;
+  for (std::string::const_iterator c = value.begin(); c != value.end(); c++)
+  {
+    switch (*c)
+    {
+      case '"':  result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\t': result += "\\t"; break;
+      default:   result += *c; break;
+    }
+  }
+  return result;
+}
+
+VTKM_CONT_EXPORT
+std::string QuoteCSV(const std::string &value)
+{
+  std::string result = "\"";
+  for (std::string::const_iterator c = value.begin(); c != value.end(); c++)
+  {
+    if (*c == '"') { result += '"'; }
+    result += *c;
+  }
+  result += '"';
+  return result;
+}
+
+/// Splits one line of a CSV file into fields. Fields may be quoted, and a
+/// doubled quote inside a quoted field is a literal quote.
+///
+VTKM_CONT_EXPORT
+std::vector<std::string> SplitCSVLine(const std::string &line)
+{
+  std::vector<std::string> fields;
+  std::string field;
+  bool inQuotes = false;
+  for (std::string::size_type i = 0; i < line.size(); i++)
+  {
+    char c = line[i];
+    if (inQuotes)
+    {
+      if (c == '"')
+      {
+        if ((i+1 < line.size()) && (line[i+1] == '"'))
+        {
+          field += '"';
+          i++;
+        }
+        else
+        {
+          inQuotes = false;
+        }
+      }
+      else
+      {
+        field += c;
+      }
+    }
+    else if (c == '"')
+    {
+      inQuotes = true;
+    }
+    else if (c == ',')
+    {
+      fields.push_back(field);
+      field.clear();
+    }
+    else if (c != '\r')
+    {
+      field += c;
+    }
+  }
+  fields.push_back(field);
+  return fields;
+}
+
+} // namespace internal
+
+/// Writes results as comma separated values with a header line. Every line
+/// also contains the system information so that files can be concatenated.
+///
+VTKM_CONT_EXPORT
+void WriteBenchmarkResultsCSV(std::ostream &stream,
+                              const std::vector<BenchmarkResult> &results,
+                              const SystemInformation &system)
+{
+  using internal::QuoteCSV;
+
+  std::ios::fmtflags oldFlags = stream.flags();
+  std::streamsize oldPrecision = stream.precision();
+
+  stream << "algorithm,value_type,size,device,runs,bytes_per_run,"
+         << "min_time,max_time,median_time,mean_time,stddev_time,variance,"
+         << "host,system,processor,compiler,build_type,id_size,scalar_size"
+         << std::endl;
+
+  stream << std::scientific << std::setprecision(9);
+  for (std::vector<BenchmarkResult>::const_iterator result = results.begin();
+       result != results.end();
+       result++)
+  {
+    stream << QuoteCSV(result->Algorithm) << ","
+           << QuoteCSV(result->ValueType) << ","
+           << result->Size << ","
+           << QuoteCSV(result->Device) << ","
+           << result->NumberOfRuns << ","
+           << result->BytesPerRun << ","
+           << result->MinimumTime << ","
+           << result->MaximumTime << ","
+           << result->MedianTime << ","
+           << result->MeanTime << ","
+           << result->StandardDeviation << ","
+           << result->StandardDeviation*result->StandardDeviation << ","
+           << QuoteCSV(system.HostName) << ","
+           << QuoteCSV(system.OperatingSystem) << ","
+           << QuoteCSV(system.Processor) << ","
+           << QuoteCSV(system.Compiler) << ","
+           << QuoteCSV(system.BuildType) << ","
+           << system.IdSize << ","
+           << system.ScalarSize
+           << std::endl;
+  }
+
+  stream.flags(oldFlags);
+  stream.precision(oldPrecision);
+}
+
+/// Writes results as a JSON object with a "system" object and a "results"
+/// array.
+///
+VTKM_CONT_EXPORT
+void WriteBenchmarkResultsJSON(std::ostream &stream,
+                               const std::vector<BenchmarkResult> &results,
+                               const SystemInformation &system)
+{
+  using internal::EscapeJSON;
+
+  std::ios::fmtflags oldFlags = stream.flags();
+  std::streamsize oldPrecision = stream.precision();
+
+  stream << "{" << std::endl
+         << "  \"system\": {" << std::endl
+         << "    \"host\": \"" << EscapeJSON(system.HostName) << "\","
+         << std::endl
+         << "    \"system\": \"" << EscapeJSON(system.OperatingSystem) << "\","
+         << std::endl
+         << "    \"processor\": \"" << EscapeJSON(system.Processor) << "\","
+         << std::endl
+         << "    \"compiler\": \"" << EscapeJSON(system.Compiler) << "\","
+         << std::endl
+         << "    \"build_type\": \"" << EscapeJSON(system.BuildType) << "\","
+         << std::endl
+         << "    \"id_size\": " << system.IdSize << "," << std::endl
+         << "    \"scalar_size\": " << system.ScalarSize << std::endl
+         << "  }," << std::endl
+         << "  \"results\": [" << std::endl;
+
+  stream << std::scientific << std::setprecision(9);
+  for (std::vector<BenchmarkResult>::const_iterator result = results.begin();
+       result != results.end();
+       result++)
+  {
+    stream << "    {"
+           << "\"algorithm\": \"" << EscapeJSON(result->Algorithm) << "\", "
+           << "\"value_type\": \"" << EscapeJSON(result->ValueType) << "\", "
+           << "\"size\": " << result->Size << ", "
+           << "\"device\": \"" << EscapeJSON(result->Device) << "\", "
+           << "\"runs\": " << result->NumberOfRuns << ", "
+           << "\"bytes_per_run\": " << result->BytesPerRun << ", "
+           << "\"min_time\": " << result->MinimumTime << ", "
+           << "\"max_time\": " << result->MaximumTime << ", "
+           << "\"median_time\": " << result->MedianTime << ", "
+           << "\"mean_time\": " << result->MeanTime << ", "
+           << "\"stddev_time\": " << result->StandardDeviation << ", "
+           << "\"variance\": "
+           << result->StandardDeviation*result->StandardDeviation
+           << "}";
+    if (result+1 != results.end()) { stream << ","; }
+    stream << std::endl;
+  }
+
+  stream << "  ]" << std::endl
+         << "}" << std::endl;
+
+  stream.flags(oldFlags);
+  stream.precision(oldPrecision);
+}
+
+/// Reads results written by WriteBenchmarkResultsCSV. Columns are found by
+/// name in the header line, so columns may be reordered or added. Throws
+/// vtkm::cont::ErrorControlBadValue if the input is malformed.
+///
+VTKM_CONT_EXPORT
+std::vector<BenchmarkResult> ReadBenchmarkResultsCSV(std::istream &stream)
+{
+  std::string line;
+  if (!std::getline(stream, line))
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Benchmark result file is empty.");
+  }
+
+  std::vector<std::string> header = internal::SplitCSVLine(line);
+  std::map<std::string, std::size_t> columns;
+  for (std::size_t index = 0; index < header.size(); index++)
+  {
+    columns[header[index]] = index;
+  }
+
+  const char *requiredColumns[] =
+    { "algorithm", "value_type", "size", "device", "median_time", 0 };
+  for (const char **name = requiredColumns; *name != 0; name++)
+  {
+    if (columns.find(*name) == columns.end())
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            std::string("Benchmark result file is missing column ") + *name);
+    }
+  }
+
+  std::vector<BenchmarkResult> results;
+  while (std::getline(stream, line))
+  {
+    if (line.empty() || (line == "\r")) { continue; }
+
+    std::vector<std::string> fields = internal::SplitCSVLine(line);
+    if (fields.size() != header.size())
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Benchmark result line has wrong number of fields: " + line);
+    }
+
+    BenchmarkResult result;
+    result.Algorithm = fields[columns["algorithm"]];
+    result.ValueType = fields[columns["value_type"]];
+    result.Size =
+        static_cast<vtkm::Id>(std::atof(fields[columns["size"]].c_str()));
+    result.Device = fields[columns["device"]];
+    result.MedianTime = std::atof(fields[columns["median_time"]].c_str());
+
+#define VTKM_BENCHMARK_READ_OPTIONAL(column, member, type) \
+    if (columns.find(column) != columns.end()) \
+    { \
+      result.member = \
+          static_cast<type>(std::atof(fields[columns[column]].c_str())); \
+    }
+
+    VTKM_BENCHMARK_READ_OPTIONAL("runs", NumberOfRuns, vtkm::Id);
+    VTKM_BENCHMARK_READ_OPTIONAL("bytes_per_run", BytesPerRun, vtkm::Id);
+    VTKM_BENCHMARK_READ_OPTIONAL("min_time", MinimumTime, vtkm::Float64);
+    VTKM_BENCHMARK_READ_OPTIONAL("max_time", MaximumTime, vtkm::Float64);
+    VTKM_BENCHMARK_READ_OPTIONAL("mean_time", MeanTime, vtkm::Float64);
+    VTKM_BENCHMARK_READ_OPTIONAL("stddev_time",
+                                 StandardDeviation,
+                                 vtkm::Float64);
+
+#undef VTKM_BENCHMARK_READ_OPTIONAL
+
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+/// Writes the results in the given format, which is one of "text", "csv", or
+/// "json", to the named file or to standard out if \p fileName is empty.
+/// Throws vtkm::cont::ErrorControlBadValue if the format is unknown or the
+/// file cannot be written.
+///
+VTKM_CONT_EXPORT
+void WriteBenchmarkResults(const std::string &format,
+                           const std::string &fileName,
+                           const std::vector<BenchmarkResult> &results)
+{
+  std::ofstream file;
+  if (!fileName.empty())
+  {
+    file.open(fileName.c_str());
+    if (!file)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Could not open benchmark output file " + fileName);
+    }
+  }
+  std::ostream &stream = fileName.empty() ? std::cout : file;
+
+  if (format == "csv")
+  {
+    WriteBenchmarkResultsCSV(stream, results, SystemInformation::GetCurrent());
+  }
+  else if (format == "json")
+  {
+    WriteBenchmarkResultsJSON(stream, results, SystemInformation::GetCurrent());
+  }
+  else if (format == "text")
+  {
+    for (std::vector<BenchmarkResult>::const_iterator result = results.begin();
+         result != results.end();
+         result++)
+    {
+      PrintResult(stream, *result);
+    }
+  }
+  else
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Unknown benchmark output format " + format);
+  }
+}
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_BenchmarkOutput_h
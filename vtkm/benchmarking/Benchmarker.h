@@ -0,0 +1,273 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_benchmarking_Benchmarker_h
+#define vtk_m_benchmarking_Benchmarker_h
+
+#include <vtkm/cont/ErrorControlOutOfMemory.h>
+#include <vtkm/cont/Timer.h>
+
+#include <vtkm/testing/OptionParser.h>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace vtkm {
+namespace benchmarking {
+
+/// Holds the measurements of one benchmark case (one algorithm run on one
+/// value type and array size). The times are in seconds.
+///
+struct BenchmarkResult
+{
+  std::string Algorithm;
+  std::string ValueType;
+  vtkm::Id Size;
+  std::string Device;
+  vtkm::Id NumberOfRuns;
+  vtkm::Id BytesPerRun;
+  vtkm::Float64 MinimumTime;
+  vtkm::Float64 MaximumTime;
+  vtkm::Float64 MedianTime;
+  vtkm::Float64 MeanTime;
+  vtkm::Float64 StandardDeviation;
+
+  BenchmarkResult()
+    : Size(0),
+      NumberOfRuns(0),
+      BytesPerRun(0),
+      MinimumTime(0),
+      MaximumTime(0),
+      MedianTime(0),
+      MeanTime(0),
+      StandardDeviation(0)
+  {  }
+
+  /// Elements processed per second based on the median time.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetElementsPerSecond() const
+  {
+    return (this->MedianTime > 0)
+        ? vtkm::Float64(this->Size)/this->MedianTime : 0;
+  }
+
+  /// Gigabytes (10^9 bytes) processed per second based on the median time.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetGigabytesPerSecond() const
+  {
+    return (this->MedianTime > 0)
+        ? vtkm::Float64(this->BytesPerRun)/(1.0e9*this->MedianTime) : 0;
+  }
+};
+
+/// \brief Repeatedly runs a benchmark and collects timing statistics.
+///
+/// A benchmark is a functor with the following interface.
+///
+/// \code{.cpp}
+/// struct BenchFoo
+/// {
+///   // Called before every run. Not included in the timing. Use it to
+///   // restore any state (such as an array sorted in place) that the previous
+///   // run modified.
+///   void Setup();
+///
+///   // The operation to time.
+///   void operator()();
+///
+///   // Name of the algorithm being measured.
+///   std::string GetAlgorithmName() const;
+///
+///   // The number of bytes read and written by one run.
+///   vtkm::Id GetBytesPerRun() const;
+/// };
+/// \endcode
+///
+/// The benchmark is run until either \c MaximumRuns runs have completed or
+/// \c MaximumTime seconds have been spent, whichever is first. At least
+/// \c MinimumRuns runs are always done.
+///
+template<class DeviceAdapterTag>
+class Benchmarker
+{
+public:
+  VTKM_CONT_EXPORT
+  Benchmarker(vtkm::Id maximumRuns = 100,
+              vtkm::Float64 maximumTime = 1.0,
+              vtkm::Id minimumRuns = 3)
+    : MaximumRuns(maximumRuns),
+      MaximumTime(maximumTime),
+      MinimumRuns(minimumRuns)
+  {  }
+
+  VTKM_CONT_EXPORT
+  void SetMaximumRuns(vtkm::Id runs) { this->MaximumRuns = runs; }
+  VTKM_CONT_EXPORT
+  vtkm::Id GetMaximumRuns() const { return this->MaximumRuns; }
+
+  VTKM_CONT_EXPORT
+  void SetMaximumTime(vtkm::Float64 seconds) { this->MaximumTime = seconds; }
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetMaximumTime() const { return this->MaximumTime; }
+
+  VTKM_CONT_EXPORT
+  void SetMinimumRuns(vtkm::Id runs) { this->MinimumRuns = runs; }
+  VTKM_CONT_EXPORT
+  vtkm::Id GetMinimumRuns() const { return this->MinimumRuns; }
+
+  /// Runs the benchmark and returns its timing statistics. The \c valueType
+  /// and \c size are recorded in the result to identify the case. A
+  /// benchmark that repeats its operation several times in each run (to make
+  /// a short operation long enough to time) gives the number of repeats as
+  /// \c callsPerRun, and the times are reported for a single call.
+  ///
+  template<class BenchmarkType>
+  VTKM_CONT_EXPORT
+  BenchmarkResult Run(BenchmarkType &benchmark,
+                      const std::string &valueType,
+                      vtkm::Id size,
+                      vtkm::Id callsPerRun = 1) const
+  {
+    vtkm::cont::Timer<DeviceAdapterTag> totalTimer;
+    vtkm::cont::Timer<DeviceAdapterTag> runTimer;
+
+    do
+    {
+      benchmark.Setup();
+      runTimer.Reset();
+      benchmark();
+      runTimer.Lap();
+    } while ((runTimer.GetNumberOfLaps() < this->MinimumRuns)
+             || ((runTimer.GetNumberOfLaps() < this->MaximumRuns)
+                 && (totalTimer.GetElapsedTime() < this->MaximumTime)));
+
+    BenchmarkResult result;
+    result.Algorithm = benchmark.GetAlgorithmName();
+    result.ValueType = valueType;
+    result.Size = size;
+    result.Device =
+        vtkm::cont::internal::DeviceAdapterTraits<DeviceAdapterTag>::GetId();
+    result.NumberOfRuns = runTimer.GetNumberOfLaps();
+    result.BytesPerRun = benchmark.GetBytesPerRun();
+    const vtkm::Float64 scale = 1.0/static_cast<vtkm::Float64>(callsPerRun);
+    result.MinimumTime = scale*runTimer.GetMinimumLapTime();
+    result.MaximumTime = scale*runTimer.GetMaximumLapTime();
+    result.MedianTime = scale*runTimer.GetMedianLapTime();
+    result.MeanTime = scale*runTimer.GetMeanLapTime();
+    result.StandardDeviation = scale*runTimer.GetLapTimeStandardDeviation();
+    return result;
+  }
+
+private:
+  vtkm::Id MaximumRuns;
+  vtkm::Float64 MaximumTime;
+  vtkm::Id MinimumRuns;
+};
+
+namespace internal {
+
+namespace option = vtkm::testing::option;
+
+/// Argument checks for the vtkm::testing::option parser used by the
+/// benchmark programs.
+///
+struct BenchmarkArg : public option::Arg
+{
+  static option::ArgStatus Numeric(const option::Option &option, bool msg)
+  {
+    char *endptr = 0;
+    if (option.arg != 0)
+    {
+      std::strtod(option.arg, &endptr);
+    }
+    if ((option.arg != 0) && (endptr != option.arg) && (*endptr == '\0'))
+    {
+      return option::ARG_OK;
+    }
+    if (msg)
+    {
+      std::cerr << "Option '" << std::string(option.name, option.namelen)
+                << "' requires a numeric argument." << std::endl;
+    }
+    return option::ARG_ILLEGAL;
+  }
+
+  static option::ArgStatus NonEmpty(const option::Option &option, bool msg)
+  {
+    if ((option.arg != 0) && (option.arg[0] != '\0'))
+    {
+      return option::ARG_OK;
+    }
+    if (msg)
+    {
+      std::cerr << "Option '" << std::string(option.name, option.namelen)
+                << "' requires a non-empty argument." << std::endl;
+    }
+    return option::ARG_ILLEGAL;
+  }
+
+  static option::ArgStatus Unknown(const option::Option &option, bool msg)
+  {
+    if (msg)
+    {
+      std::cerr << "Unknown option '"
+                << std::string(option.name, option.namelen) << "'."
+                << std::endl;
+    }
+    return option::ARG_ILLEGAL;
+  }
+};
+
+} // namespace internal
+
+/// Prints a one-line, human readable summary of a benchmark result.
+///
+VTKM_CONT_EXPORT
+void PrintResult(std::ostream &stream, const BenchmarkResult &result)
+{
+  std::ios::fmtflags oldFlags = stream.flags();
+  std::streamsize oldPrecision = stream.precision();
+
+  stream << std::left
+         << std::setw(26) << result.Algorithm << " "
+         << std::setw(32) << result.ValueType << " "
+         << std::right << std::setw(12) << result.Size << " "
+         << std::scientific << std::setprecision(3)
+         << "median " << result.MedianTime << " s "
+         << "(min " << result.MinimumTime
+         << ", mean " << result.MeanTime
+         << ", stddev " << result.StandardDeviation
+         << ", runs " << result.NumberOfRuns << ")  "
+         << result.GetElementsPerSecond() << " elem/s  "
+         << std::fixed << std::setprecision(3)
+         << result.GetGigabytesPerSecond() << " GB/s"
+         << std::endl;
+
+  stream.flags(oldFlags);
+  stream.precision(oldPrecision);
+}
+
+}
+} // namespace vtkm::benchmarking
+
+#endif //vtk_m_benchmarking_Benchmarker_h
@@ -0,0 +1,171 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#include <vtkm/benchmarking/BenchmarkComparison.h>
+#include <vtkm/benchmarking/BenchmarkOutput.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+vtkm::benchmarking::BenchmarkResult MakeResult(const std::string &algorithm,
+                                               const std::string &valueType,
+                                               vtkm::Id size,
+                                               vtkm::Float64 median)
+{
+  vtkm::benchmarking::BenchmarkResult result;
+  result.Algorithm = algorithm;
+  result.ValueType = valueType;
+  result.Size = size;
+  result.Device = "Serial";
+  result.NumberOfRuns = 10;
+  result.BytesPerRun = 8*size;
+  result.MinimumTime = 0.5*median;
+  result.MaximumTime = 2.0*median;
+  result.MedianTime = median;
+  result.MeanTime = median;
+  result.StandardDeviation = 0.25*median;
+  return result;
+}
+
+std::vector<vtkm::benchmarking::BenchmarkResult> MakeResults()
+{
+  std::vector<vtkm::benchmarking::BenchmarkResult> results;
+  results.push_back(MakeResult("Copy", "vtkm::Int32", 1024, 1.0e-6));
+  results.push_back(MakeResult("Sort", "vtkm::Vec< vtkm::Float32, 3 >",
+                               32768, 2.5e-3));
+  results.push_back(MakeResult("Odd \"name\"", "vtkm::Float64", 1, 3.0));
+  return results;
+}
+
+void TestCSVRoundTrip()
+{
+  std::cout << "Writing and reading CSV." << std::endl;
+  std::vector<vtkm::benchmarking::BenchmarkResult> results = MakeResults();
+
+  vtkm::benchmarking::SystemInformation system =
+      vtkm::benchmarking::SystemInformation::GetCurrent();
+  VTKM_TEST_ASSERT(system.IdSize == sizeof(vtkm::Id), "Bad id size.");
+
+  std::stringstream stream;
+  vtkm::benchmarking::WriteBenchmarkResultsCSV(stream, results, system);
+
+  std::vector<vtkm::benchmarking::BenchmarkResult> readResults =
+      vtkm::benchmarking::ReadBenchmarkResultsCSV(stream);
+  VTKM_TEST_ASSERT(readResults.size() == results.size(),
+                   "Wrong number of results read.");
+  for (std::size_t index = 0; index < results.size(); index++)
+  {
+    const vtkm::benchmarking::BenchmarkResult &expected = results[index];
+    const vtkm::benchmarking::BenchmarkResult &found = readResults[index];
+    VTKM_TEST_ASSERT(found.Algorithm == expected.Algorithm, "Bad algorithm.");
+    VTKM_TEST_ASSERT(found.ValueType == expected.ValueType, "Bad type.");
+    VTKM_TEST_ASSERT(found.Size == expected.Size, "Bad size.");
+    VTKM_TEST_ASSERT(found.Device == expected.Device, "Bad device.");
+    VTKM_TEST_ASSERT(found.NumberOfRuns == expected.NumberOfRuns,
+                     "Bad number of runs.");
+    VTKM_TEST_ASSERT(found.BytesPerRun == expected.BytesPerRun, "Bad bytes.");
+    VTKM_TEST_ASSERT(test_equal(found.MedianTime, expected.MedianTime),
+                     "Bad median.");
+    VTKM_TEST_ASSERT(test_equal(found.StandardDeviation,
+                                expected.StandardDeviation),
+                     "Bad standard deviation.");
+  }
+
+  std::cout << "Reading malformed CSV." << std::endl;
+  try
+  {
+    std::stringstream badStream("algorithm,size\nCopy,10\n");
+    vtkm::benchmarking::ReadBenchmarkResultsCSV(badStream);
+    VTKM_TEST_FAIL("Did not get error for missing columns.");
+  }
+  catch (const vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestJSON()
+{
+  std::cout << "Writing JSON." << std::endl;
+  std::stringstream stream;
+  vtkm::benchmarking::WriteBenchmarkResultsJSON(
+        stream,
+        MakeResults(),
+        vtkm::benchmarking::SystemInformation::GetCurrent());
+  std::string json = stream.str();
+  std::cout << json;
+
+  VTKM_TEST_ASSERT(json.find("\"results\": [") != std::string::npos,
+                   "Missing results.");
+  VTKM_TEST_ASSERT(json.find("\"algorithm\": \"Odd \\\"name\\\"\"")
+                   != std::string::npos,
+                   "Quote not escaped.");
+  VTKM_TEST_ASSERT(json.find("\"variance\"") != std::string::npos,
+                   "Missing variance.");
+}
+
+void TestComparison()
+{
+  std::cout << "Comparing results." << std::endl;
+  std::vector<vtkm::benchmarking::BenchmarkResult> baseline = MakeResults();
+
+  std::vector<vtkm::benchmarking::BenchmarkResult> current;
+  // 5% slower is within the threshold.
+  current.push_back(MakeResult("Copy", "vtkm::Int32", 1024, 1.05e-6));
+  // 50% slower is a regression.
+  current.push_back(MakeResult("Sort", "vtkm::Vec< vtkm::Float32, 3 >",
+                               32768, 3.75e-3));
+  // Not in the baseline.
+  current.push_back(MakeResult("Copy", "vtkm::Int32", 2048, 1.0e-6));
+
+  std::vector<vtkm::benchmarking::BenchmarkResult> unmatched;
+  std::vector<vtkm::benchmarking::BenchmarkComparison> comparisons =
+      vtkm::benchmarking::CompareBenchmarkResults(
+        baseline, current, 0.1, unmatched);
+  vtkm::benchmarking::PrintComparisons(std::cout, comparisons);
+
+  VTKM_TEST_ASSERT(comparisons.size() == 2, "Wrong number of comparisons.");
+  VTKM_TEST_ASSERT(!comparisons[0].Regressed, "Small change regressed.");
+  VTKM_TEST_ASSERT(test_equal(comparisons[0].Ratio, 1.05), "Bad ratio.");
+  VTKM_TEST_ASSERT(comparisons[1].Regressed, "Regression not found.");
+  VTKM_TEST_ASSERT(test_equal(comparisons[1].Ratio, 1.5), "Bad ratio.");
+
+  // One case only in current and one only in baseline.
+  VTKM_TEST_ASSERT(unmatched.size() == 2, "Wrong number unmatched.");
+}
+
+void TestBenchmarkOutput()
+{
+  TestCSVRoundTrip();
+  TestJSON();
+  TestComparison();
+}
+
+} // anonymous namespace
+
+int UnitTestBenchmarkOutput(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestBenchmarkOutput);
+}
@@ -31,6 +31,7 @@
 #include <vtkm/cont/internal/DeviceAdapterTag.h>
 
 #include <boost/concept_check.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/mpl/not.hpp>
 #include <boost/smart_ptr/scoped_ptr.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
@@ -113,6 +114,7 @@ public:
     this->Internals->UserPortalValid = false;
     this->Internals->ControlArrayValid = false;
     this->Internals->ExecutionArrayValid = false;
+    this->Internals->ModifiedCount = 0;
   }
 
   /// Constructs an ArrayHandle pointing to the data in the given array portal.
@@ -125,6 +127,36 @@ public:
 
     this->Internals->ControlArrayValid = false;
     this->Internals->ExecutionArrayValid = false;
+    this->Internals->ModifiedCount = 0;
+  }
+
+  /// Two handles are equal if they refer to the same array. Copies of a
+  /// handle share the array, so changes made through one are seen by all.
+  ///
+  VTKM_CONT_EXPORT
+  bool operator==(const ArrayHandle<T,StorageTag_> &rhs) const
+  {
+    return (this->Internals == rhs.Internals);
+  }
+
+  VTKM_CONT_EXPORT
+  bool operator!=(const ArrayHandle<T,StorageTag_> &rhs) const
+  {
+    return (this->Internals != rhs.Internals);
+  }
+
+  /// Returns a count that changes every time the array is given out for
+  /// writing (through GetPortalControl, PrepareForOutput, or
+  /// PrepareForInPlace) or is resized or released. It is shared by all copies
+  /// of the handle, so anything derived from the values of the array can be
+  /// kept along with this count and reused as long as the count is the same.
+  /// Writing to a portal after it was obtained does not change the count
+  /// again.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::UInt64 GetModifiedCount() const
+  {
+    return this->Internals->ModifiedCount;
   }
 
   /// Get the array portal of the control array.
@@ -143,6 +175,7 @@ public:
       // array will become invalid. Play it safe and release the execution
       // resources. (Use the const version to preserve the execution array.)
       this->ReleaseResourcesExecution();
+      this->Internals->ModifiedCount++;
       return this->Internals->ControlArray.GetPortal();
     }
     else
@@ -220,6 +253,7 @@ public:
       {
         this->Internals->ExecutionArray->Shrink(numberOfValues);
       }
+      this->Internals->ModifiedCount++;
     }
     else if (numberOfValues == originalNumberOfValues)
     {
@@ -260,6 +294,7 @@ public:
       this->Internals->ControlArray.ReleaseResources();
       this->Internals->ControlArrayValid = false;
     }
+    this->Internals->ModifiedCount++;
   }
 
   /// Prepares this array to be used as an input to an operation in the
@@ -337,6 +372,7 @@ public:
     // returned from this method, so you would have to work to invalidate this
     // assumption anyway.)
     this->Internals->ExecutionArrayValid = true;
+    this->Internals->ModifiedCount++;
 
     return this->Internals->ExecutionArray->GetPortalExecution(DeviceAdapterTag());
   }
@@ -386,6 +422,7 @@ public:
     // the execution data is overwritten. Don't actually release the control
     // array. It may be shared as the execution array.
     this->Internals->ControlArrayValid = false;
+    this->Internals->ModifiedCount++;
 
     return this->Internals->ExecutionArray->GetPortalExecution(DeviceAdapterTag());
   }
@@ -402,6 +439,7 @@ public:
     this->Internals->ControlArray = storage;
     this->Internals->ControlArrayValid = true;
     this->Internals->ExecutionArrayValid = false;
+    this->Internals->ModifiedCount = 0;
   }
 
   // private:
@@ -417,6 +455,13 @@ public:
       vtkm::cont::internal::ArrayHandleExecutionManagerBase<
         ValueType,StorageTag> > ExecutionArray;
     bool ExecutionArrayValid;
+
+    vtkm::UInt64 ModifiedCount;
+
+    // Data derived from the values that other parts of VTK-m keep with the
+    // array so that it is shared by all copies of the handle (such as the
+    // range found by vtkm::cont::ComputeRange). ArrayHandle never reads it.
+    boost::shared_ptr<void> DerivedData;
   };
 
   ArrayHandle(boost::shared_ptr<InternalStruct> i)
@@ -499,6 +544,35 @@ public:
   boost::shared_ptr<InternalStruct> Internals;
 };
 
+namespace internal {
+
+namespace detail {
+
+typedef char IsArrayHandleYes;
+struct IsArrayHandleNo { char Padding[2]; };
+
+template<typename T, typename StorageTag>
+IsArrayHandleYes
+IsArrayHandleTest(const vtkm::cont::ArrayHandle<T,StorageTag> *);
+
+IsArrayHandleNo IsArrayHandleTest(...);
+
+} // namespace detail
+
+/// Checks to see if the given type is an \c ArrayHandle or a subclass of one
+/// (such as \c ArrayHandleCounting). This check is compatible with the Boost
+/// meta-template programming library (MPL). It contains a typedef named type
+/// that is either boost::mpl::true_ or boost::mpl::false_.
+///
+template<typename T>
+struct IsArrayHandle {
+  typedef boost::mpl::bool_<
+    sizeof(detail::IsArrayHandleTest(static_cast<T *>(0)))
+    == sizeof(detail::IsArrayHandleYes)> type;
+};
+
+} // namespace internal
+
 /// A convenience function for creating an ArrayHandle from a standard C array.
 /// Unless properly specialized, this only works with storage types that use an
 /// array portal that accepts a pair of pointers to signify the beginning and
@@ -0,0 +1,111 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_ArrayHandleConstant_h
+#define vtk_m_cont_ArrayHandleConstant_h
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/StorageImplicit.h>
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+/// \brief An implicit array portal that returns the same value everywhere.
+template <class ConstantValueType>
+class ArrayPortalConstant
+{
+public:
+  typedef ConstantValueType ValueType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ArrayPortalConstant() :
+    Value(),
+    NumberOfValues(0)
+  {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ArrayPortalConstant(ValueType value, vtkm::Id numValues) :
+    Value(value),
+    NumberOfValues(numValues)
+  {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const { return this->NumberOfValues; }
+
+  VTKM_EXEC_CONT_EXPORT
+  ValueType Get(vtkm::Id) const { return this->Value; }
+
+private:
+  ValueType Value;
+  vtkm::Id NumberOfValues;
+};
+
+/// A convenience class that provides a typedef to the appropriate tag for
+/// a constant storage.
+template<typename ConstantValueType>
+struct ArrayHandleConstantTraits
+{
+  typedef vtkm::cont::StorageTagImplicit<
+      vtkm::cont::internal::ArrayPortalConstant<ConstantValueType> > Tag;
+};
+
+} // namespace internal
+
+/// ArrayHandleConstant is a specialization of ArrayHandle. It returns the
+/// same value for every index and stores nothing but that value and the
+/// length.
+template <typename ConstantValueType>
+class ArrayHandleConstant
+    : public vtkm::cont::ArrayHandle <
+          ConstantValueType,
+          typename internal::ArrayHandleConstantTraits<ConstantValueType>::Tag
+          >
+{
+  typedef vtkm::cont::ArrayHandle <
+          ConstantValueType,
+          typename internal::ArrayHandleConstantTraits<ConstantValueType>::Tag
+          > Superclass;
+public:
+
+  VTKM_CONT_EXPORT
+  ArrayHandleConstant(ConstantValueType value, vtkm::Id length)
+    : Superclass(typename Superclass::PortalConstControl(value, length))
+  {
+  }
+
+  VTKM_CONT_EXPORT
+  ArrayHandleConstant() : Superclass() {}
+};
+
+/// A convenience function for creating an ArrayHandleConstant. It takes the
+/// value returned for every index and the number of values.
+template<typename ConstantValueType>
+VTKM_CONT_EXPORT
+vtkm::cont::ArrayHandleConstant<ConstantValueType>
+make_ArrayHandleConstant(ConstantValueType value, vtkm::Id length)
+{
+  return vtkm::cont::ArrayHandleConstant<ConstantValueType>(value, length);
+}
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ArrayHandleConstant_h
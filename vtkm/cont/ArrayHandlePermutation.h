@@ -0,0 +1,323 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_ArrayHandlePermutation_h
+#define vtk_m_cont_ArrayHandlePermutation_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/Assert.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/ErrorControlInternal.h>
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+/// \brief An array portal that gathers values of one portal through the
+/// indices in another.
+///
+/// Get(index) returns the value of the value portal at the position given by
+/// the index portal at \c index. This is the portal used within
+/// ArrayHandlePermutation in both the control and execution environments.
+///
+template<typename IndexPortalType_, typename ValuePortalType_>
+class ArrayPortalPermutation
+{
+public:
+  typedef IndexPortalType_ IndexPortalType;
+  typedef ValuePortalType_ ValuePortalType;
+  typedef typename ValuePortalType::ValueType ValueType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ArrayPortalPermutation() {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ArrayPortalPermutation(const IndexPortalType &indexPortal,
+                         const ValuePortalType &valuePortal)
+    : IndexPortal(indexPortal), ValuePortal(valuePortal) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const {
+    return this->IndexPortal.GetNumberOfValues();
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ValueType Get(vtkm::Id index) const {
+    return this->ValuePortal.Get(this->IndexPortal.Get(index));
+  }
+
+private:
+  IndexPortalType IndexPortal;
+  ValuePortalType ValuePortal;
+};
+
+template<typename IndexArrayHandleType, typename ValueArrayHandleType>
+struct StorageTagPermutation {  };
+
+// The storage holds the index and value arrays. Values are only gathered
+// when a portal is used, so nothing is copied when the array is created.
+template<typename T,
+         typename IndexArrayHandleType,
+         typename ValueArrayHandleType>
+class Storage<
+    T, StorageTagPermutation<IndexArrayHandleType, ValueArrayHandleType> >
+{
+public:
+  typedef T ValueType;
+
+  typedef ArrayPortalPermutation<
+      typename IndexArrayHandleType::PortalConstControl,
+      typename ValueArrayHandleType::PortalConstControl> PortalConstType;
+
+  // Permuted arrays are read only, so there is no writable portal.
+  typedef PortalConstType PortalType;
+
+  VTKM_CONT_EXPORT
+  Storage() : Valid(false) {  }
+
+  VTKM_CONT_EXPORT
+  Storage(const IndexArrayHandleType &indexArray,
+          const ValueArrayHandleType &valueArray)
+    : IndexArray(indexArray), ValueArray(valueArray), Valid(true) {  }
+
+  VTKM_CONT_EXPORT
+  PortalType GetPortal() {
+    throw vtkm::cont::ErrorControlBadValue("Permuted arrays are read only.");
+  }
+
+  VTKM_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    VTKM_ASSERT_CONT(this->Valid);
+    return PortalConstType(this->IndexArray.GetPortalConstControl(),
+                           this->ValueArray.GetPortalConstControl());
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const {
+    VTKM_ASSERT_CONT(this->Valid);
+    return this->IndexArray.GetNumberOfValues();
+  }
+
+  VTKM_CONT_EXPORT
+  void Allocate(vtkm::Id vtkmNotUsed(numberOfValues)) {
+    throw vtkm::cont::ErrorControlInternal(
+          "The allocate method for the permutation storage should never have "
+          "been called. The allocate is generally only called by the "
+          "execution array manager, and the array transfer for the "
+          "permutation storage should prevent the execution array manager "
+          "from being directly used.");
+  }
+
+  VTKM_CONT_EXPORT
+  void Shrink(vtkm::Id vtkmNotUsed(numberOfValues)) {
+    throw vtkm::cont::ErrorControlBadValue("Permuted arrays are read only.");
+  }
+
+  VTKM_CONT_EXPORT
+  void ReleaseResources() {
+    // The delegate arrays may be shared with other handles, so their
+    // resources are not released here.
+  }
+
+  VTKM_CONT_EXPORT
+  const IndexArrayHandleType &GetIndexArray() const {
+    VTKM_ASSERT_CONT(this->Valid);
+    return this->IndexArray;
+  }
+
+  VTKM_CONT_EXPORT
+  const ValueArrayHandleType &GetValueArray() const {
+    VTKM_ASSERT_CONT(this->Valid);
+    return this->ValueArray;
+  }
+
+private:
+  IndexArrayHandleType IndexArray;
+  ValueArrayHandleType ValueArray;
+  bool Valid;
+};
+
+template<typename T,
+         typename IndexArrayHandleType,
+         typename ValueArrayHandleType,
+         typename DeviceAdapterTag>
+class ArrayTransfer<
+    T,
+    StorageTagPermutation<IndexArrayHandleType, ValueArrayHandleType>,
+    DeviceAdapterTag>
+{
+  typedef StorageTagPermutation<IndexArrayHandleType, ValueArrayHandleType>
+      StorageTag;
+  typedef vtkm::cont::internal::Storage<T,StorageTag> StorageType;
+
+public:
+  typedef T ValueType;
+
+  typedef typename StorageType::PortalType PortalControl;
+  typedef typename StorageType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalPermutation<
+      typename IndexArrayHandleType::template ExecutionTypes<
+        DeviceAdapterTag>::PortalConst,
+      typename ValueArrayHandleType::template ExecutionTypes<
+        DeviceAdapterTag>::PortalConst> PortalConstExecution;
+  typedef PortalConstExecution PortalExecution;
+
+  VTKM_CONT_EXPORT
+  ArrayTransfer() : StorageValid(false) {  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const {
+    VTKM_ASSERT_CONT(this->StorageValid);
+    return this->Storage.GetNumberOfValues();
+  }
+
+  VTKM_CONT_EXPORT
+  void LoadDataForInput(const PortalConstControl &vtkmNotUsed(portal))
+  {
+    throw vtkm::cont::ErrorControlInternal(
+          "ArrayHandlePermutation in a bad state. "
+          "There must be a UserArray set, but how did that happen?");
+  }
+
+  VTKM_CONT_EXPORT
+  void LoadDataForInput(const StorageType &controlArray)
+  {
+    this->Storage = controlArray;
+    this->StorageValid = true;
+  }
+
+  VTKM_CONT_EXPORT
+  void LoadDataForInPlace(StorageType &vtkmNotUsed(controlArray))
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Permuted arrays cannot be used for output or in place.");
+  }
+
+  VTKM_CONT_EXPORT
+  void AllocateArrayForOutput(StorageType &vtkmNotUsed(controlArray),
+                              vtkm::Id vtkmNotUsed(numberOfValues))
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Permuted arrays cannot be used for output.");
+  }
+
+  VTKM_CONT_EXPORT
+  void RetrieveOutputData(StorageType &vtkmNotUsed(controlArray)) const
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Permuted arrays cannot be used for output.");
+  }
+
+  VTKM_CONT_EXPORT
+  void Shrink(vtkm::Id vtkmNotUsed(numberOfValues))
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Permuted arrays cannot be resized.");
+  }
+
+  VTKM_CONT_EXPORT
+  PortalExecution GetPortalExecution()
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Permuted arrays are read-only. (Get the const portal.)");
+  }
+
+  VTKM_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const
+  {
+    VTKM_ASSERT_CONT(this->StorageValid);
+    return PortalConstExecution(
+          this->Storage.GetIndexArray().PrepareForInput(DeviceAdapterTag()),
+          this->Storage.GetValueArray().PrepareForInput(DeviceAdapterTag()));
+  }
+
+  VTKM_CONT_EXPORT
+  void ReleaseResources() {
+    this->Storage.ReleaseResources();
+  }
+
+private:
+  bool StorageValid;
+  StorageType Storage;
+};
+
+} // namespace internal
+
+/// \brief An \c ArrayHandle that gathers values from another array.
+///
+/// \c ArrayHandlePermutation is a specialization of \c ArrayHandle that holds
+/// an array of indices and an array of values. Value \c i of the permutation
+/// is the value at position \c indices[i] of the value array. The gather
+/// happens as values are read through a portal from \c GetPortalConstControl
+/// or \c PrepareForInput, so the permuted values are never stored.
+///
+/// Either array may itself be an implicit or transformed array, so a gather
+/// can be combined with other lazy operations without creating intermediate
+/// arrays. The indices may repeat or skip values, so the permutation may be
+/// shorter or longer than the value array. Permuted arrays are read only.
+///
+/// The easiest way to create an \c ArrayHandlePermutation is with
+/// \c make_ArrayHandlePermutation.
+///
+template<typename IndexArrayHandleType, typename ValueArrayHandleType>
+class ArrayHandlePermutation
+    : public vtkm::cont::ArrayHandle<
+        typename ValueArrayHandleType::ValueType,
+        internal::StorageTagPermutation<
+          IndexArrayHandleType, ValueArrayHandleType> >
+{
+  typedef internal::StorageTagPermutation<
+      IndexArrayHandleType, ValueArrayHandleType> StorageTag;
+  typedef vtkm::cont::internal::Storage<
+      typename ValueArrayHandleType::ValueType, StorageTag> StorageType;
+
+public:
+  typedef vtkm::cont::ArrayHandle<
+      typename ValueArrayHandleType::ValueType, StorageTag> Superclass;
+
+  VTKM_CONT_EXPORT
+  ArrayHandlePermutation() : Superclass() {  }
+
+  VTKM_CONT_EXPORT
+  ArrayHandlePermutation(const IndexArrayHandleType &indexArray,
+                         const ValueArrayHandleType &valueArray)
+    : Superclass(StorageType(indexArray, valueArray)) {  }
+};
+
+/// Creates an \c ArrayHandlePermutation that gathers the values of \c
+/// valueArray at the positions in \c indexArray.
+///
+template<typename IndexArrayHandleType, typename ValueArrayHandleType>
+VTKM_CONT_EXPORT
+vtkm::cont::ArrayHandlePermutation<IndexArrayHandleType, ValueArrayHandleType>
+make_ArrayHandlePermutation(const IndexArrayHandleType &indexArray,
+                            const ValueArrayHandleType &valueArray)
+{
+  return vtkm::cont::ArrayHandlePermutation<
+      IndexArrayHandleType, ValueArrayHandleType>(indexArray, valueArray);
+}
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ArrayHandlePermutation_h
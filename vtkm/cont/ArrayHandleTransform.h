@@ -0,0 +1,328 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_ArrayHandleTransform_h
+#define vtk_m_cont_ArrayHandleTransform_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/Assert.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/ErrorControlInternal.h>
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+/// \brief An array portal that transforms the values of another portal.
+///
+/// Each call to Get reads the value from the delegate portal and returns the
+/// result of the functor applied to it. This is the portal used within
+/// ArrayHandleTransform in both the control and execution environments.
+///
+template<typename ValueType_, typename PortalType_, typename FunctorType_>
+class ArrayPortalTransform
+{
+public:
+  typedef ValueType_ ValueType;
+  typedef PortalType_ PortalType;
+  typedef FunctorType_ FunctorType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ArrayPortalTransform() {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ArrayPortalTransform(const PortalType &portal, const FunctorType &functor)
+    : Portal(portal), Functor(functor) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const {
+    return this->Portal.GetNumberOfValues();
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ValueType Get(vtkm::Id index) const {
+    return this->Functor(this->Portal.Get(index));
+  }
+
+private:
+  PortalType Portal;
+  FunctorType Functor;
+};
+
+template<typename ArrayHandleType, typename FunctorType>
+struct StorageTagTransform {  };
+
+// The storage holds the delegate array and the functor. Values are only
+// computed when a portal is used, so nothing is allocated or evaluated when
+// the array is created.
+template<typename T, typename ArrayHandleType, typename FunctorType>
+class Storage<T, StorageTagTransform<ArrayHandleType, FunctorType> >
+{
+public:
+  typedef T ValueType;
+
+  typedef ArrayPortalTransform<
+      ValueType, typename ArrayHandleType::PortalConstControl, FunctorType>
+      PortalConstType;
+
+  // Transformed arrays are read only, so there is no writable portal.
+  typedef PortalConstType PortalType;
+
+  VTKM_CONT_EXPORT
+  Storage() : Valid(false) {  }
+
+  VTKM_CONT_EXPORT
+  Storage(const ArrayHandleType &array, const FunctorType &functor)
+    : Array(array), Functor(functor), Valid(true) {  }
+
+  VTKM_CONT_EXPORT
+  PortalType GetPortal() {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Transformed arrays are read only.");
+  }
+
+  VTKM_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    VTKM_ASSERT_CONT(this->Valid);
+    return PortalConstType(this->Array.GetPortalConstControl(),
+                           this->Functor);
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const {
+    VTKM_ASSERT_CONT(this->Valid);
+    return this->Array.GetNumberOfValues();
+  }
+
+  VTKM_CONT_EXPORT
+  void Allocate(vtkm::Id vtkmNotUsed(numberOfValues)) {
+    throw vtkm::cont::ErrorControlInternal(
+          "The allocate method for the transform storage should never have "
+          "been called. The allocate is generally only called by the "
+          "execution array manager, and the array transfer for the transform "
+          "storage should prevent the execution array manager from being "
+          "directly used.");
+  }
+
+  VTKM_CONT_EXPORT
+  void Shrink(vtkm::Id vtkmNotUsed(numberOfValues)) {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Transformed arrays are read only.");
+  }
+
+  VTKM_CONT_EXPORT
+  void ReleaseResources() {
+    // The delegate array may be shared with other handles, so its resources
+    // are not released here.
+  }
+
+  VTKM_CONT_EXPORT
+  const ArrayHandleType &GetArray() const {
+    VTKM_ASSERT_CONT(this->Valid);
+    return this->Array;
+  }
+
+  VTKM_CONT_EXPORT
+  const FunctorType &GetFunctor() const {
+    return this->Functor;
+  }
+
+private:
+  ArrayHandleType Array;
+  FunctorType Functor;
+  bool Valid;
+};
+
+template<typename T,
+         typename ArrayHandleType,
+         typename FunctorType,
+         typename DeviceAdapterTag>
+class ArrayTransfer<
+    T, StorageTagTransform<ArrayHandleType,FunctorType>, DeviceAdapterTag>
+{
+  typedef StorageTagTransform<ArrayHandleType,FunctorType> StorageTag;
+  typedef vtkm::cont::internal::Storage<T,StorageTag> StorageType;
+
+public:
+  typedef T ValueType;
+
+  typedef typename StorageType::PortalType PortalControl;
+  typedef typename StorageType::PortalConstType PortalConstControl;
+
+  typedef ArrayPortalTransform<
+      ValueType,
+      typename ArrayHandleType::template ExecutionTypes<
+        DeviceAdapterTag>::PortalConst,
+      FunctorType> PortalConstExecution;
+  typedef PortalConstExecution PortalExecution;
+
+  VTKM_CONT_EXPORT
+  ArrayTransfer() : StorageValid(false) {  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const {
+    VTKM_ASSERT_CONT(this->StorageValid);
+    return this->Storage.GetNumberOfValues();
+  }
+
+  VTKM_CONT_EXPORT
+  void LoadDataForInput(const PortalConstControl &vtkmNotUsed(portal))
+  {
+    throw vtkm::cont::ErrorControlInternal(
+          "ArrayHandleTransform in a bad state. "
+          "There must be a UserArray set, but how did that happen?");
+  }
+
+  VTKM_CONT_EXPORT
+  void LoadDataForInput(const StorageType &controlArray)
+  {
+    this->Storage = controlArray;
+    this->StorageValid = true;
+  }
+
+  VTKM_CONT_EXPORT
+  void LoadDataForInPlace(StorageType &vtkmNotUsed(controlArray))
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Transformed arrays cannot be used for output or in place.");
+  }
+
+  VTKM_CONT_EXPORT
+  void AllocateArrayForOutput(StorageType &vtkmNotUsed(controlArray),
+                              vtkm::Id vtkmNotUsed(numberOfValues))
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Transformed arrays cannot be used for output.");
+  }
+
+  VTKM_CONT_EXPORT
+  void RetrieveOutputData(StorageType &vtkmNotUsed(controlArray)) const
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Transformed arrays cannot be used for output.");
+  }
+
+  VTKM_CONT_EXPORT
+  void Shrink(vtkm::Id vtkmNotUsed(numberOfValues))
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Transformed arrays cannot be resized.");
+  }
+
+  VTKM_CONT_EXPORT
+  PortalExecution GetPortalExecution()
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Transformed arrays are read-only. (Get the const portal.)");
+  }
+
+  VTKM_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const
+  {
+    VTKM_ASSERT_CONT(this->StorageValid);
+    // Only the delegate array is moved to the execution environment. The
+    // transformed values are computed as they are read.
+    return PortalConstExecution(
+          this->Storage.GetArray().PrepareForInput(DeviceAdapterTag()),
+          this->Storage.GetFunctor());
+  }
+
+  VTKM_CONT_EXPORT
+  void ReleaseResources() {
+    this->Storage.ReleaseResources();
+  }
+
+private:
+  bool StorageValid;
+  StorageType Storage;
+};
+
+} // namespace internal
+
+/// \brief An \c ArrayHandle that applies a functor to the values of another
+/// array.
+///
+/// \c ArrayHandleTransform is a specialization of \c ArrayHandle that holds a
+/// delegate array and a functor rather than values. Nothing is computed when
+/// the array is created. Each value is computed as it is read through a
+/// portal from \c GetPortalConstControl or \c PrepareForInput, so the
+/// transformed values are never stored.
+///
+/// Because a transform can be applied to another transform (or to any other
+/// array, such as an \c ArrayHandlePermutation), a chain of elementwise
+/// operations builds up an expression that is evaluated only where it is
+/// used. When the chain is given to an algorithm or a worklet, all the
+/// operations happen in the same pass with no intermediate arrays.
+///
+/// The functor must have an operator() const that can be called in both the
+/// control and execution environments and returns a value convertible to \c
+/// ValueType. Transformed arrays are read only.
+///
+/// The easiest way to create an \c ArrayHandleTransform is with
+/// \c make_ArrayHandleTransform.
+///
+template<typename ValueType,
+         typename ArrayHandleType,
+         typename FunctorType>
+class ArrayHandleTransform
+    : public vtkm::cont::ArrayHandle<
+        ValueType,
+        internal::StorageTagTransform<ArrayHandleType, FunctorType> >
+{
+  typedef internal::StorageTagTransform<ArrayHandleType, FunctorType>
+      StorageTag;
+  typedef vtkm::cont::internal::Storage<ValueType, StorageTag> StorageType;
+
+public:
+  typedef vtkm::cont::ArrayHandle<ValueType, StorageTag> Superclass;
+
+  VTKM_CONT_EXPORT
+  ArrayHandleTransform() : Superclass() {  }
+
+  VTKM_CONT_EXPORT
+  ArrayHandleTransform(const ArrayHandleType &array,
+                       const FunctorType &functor = FunctorType())
+    : Superclass(StorageType(array, functor)) {  }
+};
+
+/// Creates an \c ArrayHandleTransform that applies \c functor to the values
+/// of \c array. The value type of the result must be given because it cannot
+/// be deduced from the functor.
+///
+/// \code{.cpp}
+/// vtkm::cont::make_ArrayHandleTransform<vtkm::Float32>(array, Scale(2.0f))
+/// \endcode
+///
+template<typename ValueType, typename ArrayHandleType, typename FunctorType>
+VTKM_CONT_EXPORT
+vtkm::cont::ArrayHandleTransform<ValueType, ArrayHandleType, FunctorType>
+make_ArrayHandleTransform(const ArrayHandleType &array,
+                          const FunctorType &functor)
+{
+  return vtkm::cont::ArrayHandleTransform<
+      ValueType, ArrayHandleType, FunctorType>(array, functor);
+}
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ArrayHandleTransform_h
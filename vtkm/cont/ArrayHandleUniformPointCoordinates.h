@@ -91,6 +91,12 @@ public:
     return this->GetCoordinatesForTopologyIndex(index + this->Extent.Min);
   }
 
+  VTKM_EXEC_CONT_EXPORT
+  const ValueType &GetOrigin() const { return this->Origin; }
+
+  VTKM_EXEC_CONT_EXPORT
+  const ValueType &GetSpacing() const { return this->Spacing; }
+
 private:
   vtkm::Extent3 Extent;
   vtkm::Id3 Dimensions;
@@ -0,0 +1,336 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_ArrayRangeCompute_h
+#define vtk_m_cont_ArrayRangeCompute_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/Range.h>
+#include <vtkm/Types.h>
+#include <vtkm/VecTraits.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/DynamicPointCoordinates.h>
+#include <vtkm/cont/StorageBasic.h>
+#include <vtkm/cont/StorageImplicit.h>
+
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <vector>
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+/// Set to true for storage whose values change monotonically in each
+/// component, so that the range of the values is that of the first and last
+/// values. The range of these arrays is found without reading the array.
+///
+template<typename StorageTag>
+struct ArrayRangeComputeIsMonotonic : boost::false_type {  };
+
+template<typename T>
+struct ArrayRangeComputeIsMonotonic<
+    vtkm::cont::StorageTagImplicit<
+      vtkm::cont::internal::ArrayPortalCounting<T> > >
+    : boost::true_type {  };
+
+template<typename T>
+struct ArrayRangeComputeIsMonotonic<
+    vtkm::cont::StorageTagImplicit<
+      vtkm::cont::internal::ArrayPortalConstant<T> > >
+    : boost::true_type {  };
+
+template<>
+struct ArrayRangeComputeIsMonotonic<
+    vtkm::cont::StorageTagImplicit<
+      vtkm::cont::internal::ArrayPortalUniformPointCoordinates> >
+    : boost::true_type {  };
+
+/// Set to true for storage whose values can only change through its own
+/// ArrayHandle, so that the modified count of the handle tells when a range
+/// kept with it is out of date. Arrays that get their values from other
+/// arrays (such as transformed or permuted arrays) are not cached because
+/// writing the delegate arrays does not modify them.
+///
+template<typename StorageTag>
+struct ArrayRangeComputeIsCacheable : boost::false_type {  };
+
+template<>
+struct ArrayRangeComputeIsCacheable<vtkm::cont::StorageTagBasic>
+    : boost::true_type {  };
+
+// The ranges of an array kept in the derived data of its handle, along with
+// the modified count of the array when they were computed.
+struct ArrayRangeComputeCache
+{
+  std::vector<vtkm::Range> Ranges;
+  vtkm::UInt64 ModifiedCount;
+};
+
+/// Gets the per-component ranges last stored with the array by
+/// ArrayRangeComputeSetCached. Returns false, leaving \c ranges unchanged, if
+/// no ranges were stored or the array has been modified since.
+///
+template<typename T, typename Storage>
+VTKM_CONT_EXPORT
+bool ArrayRangeComputeGetCached(const vtkm::cont::ArrayHandle<T,Storage> &array,
+                                std::vector<vtkm::Range> &ranges)
+{
+  const ArrayRangeComputeCache *cache =
+      static_cast<const ArrayRangeComputeCache *>(
+        array.Internals->DerivedData.get());
+  if ((cache != NULL) && (cache->ModifiedCount == array.GetModifiedCount()))
+  {
+    ranges = cache->Ranges;
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+/// Stores the per-component ranges of the values with the array. Like the
+/// rest of the state of the array, they are shared by all copies of the
+/// handle.
+///
+template<typename T, typename Storage>
+VTKM_CONT_EXPORT
+void ArrayRangeComputeSetCached(const vtkm::cont::ArrayHandle<T,Storage> &array,
+                                const std::vector<vtkm::Range> &ranges)
+{
+  boost::shared_ptr<ArrayRangeComputeCache> cache(new ArrayRangeComputeCache);
+  cache->Ranges = ranges;
+  cache->ModifiedCount = array.GetModifiedCount();
+  array.Internals->DerivedData = cache;
+}
+
+// Makes an empty range for each component of a value and includes the value.
+template<typename T>
+struct ArrayRangeComputeToRanges
+{
+  typedef vtkm::VecTraits<T> Traits;
+  static const vtkm::IdComponent NUM_COMPONENTS = Traits::NUM_COMPONENTS;
+  typedef vtkm::Vec<vtkm::Range,NUM_COMPONENTS> RangesType;
+
+  VTKM_EXEC_CONT_EXPORT
+  RangesType operator()(const T &value) const
+  {
+    RangesType ranges;
+    for (vtkm::IdComponent component = 0;
+         component < NUM_COMPONENTS;
+         component++)
+    {
+      vtkm::Float64 componentValue =
+          static_cast<vtkm::Float64>(Traits::GetComponent(value, component));
+      ranges[component] = vtkm::Range(componentValue, componentValue);
+    }
+    return ranges;
+  }
+};
+
+template<vtkm::IdComponent NumComponents>
+struct ArrayRangeComputeUnion
+{
+  typedef vtkm::Vec<vtkm::Range,NumComponents> RangesType;
+
+  VTKM_EXEC_CONT_EXPORT
+  RangesType operator()(const RangesType &a, const RangesType &b) const
+  {
+    RangesType ranges;
+    for (vtkm::IdComponent component = 0;
+         component < NumComponents;
+         component++)
+    {
+      ranges[component] = a[component].Union(b[component]);
+    }
+    return ranges;
+  }
+};
+
+template<typename T, typename Storage, typename DeviceAdapterTag>
+VTKM_CONT_EXPORT
+void ArrayRangeComputeImpl(const vtkm::cont::ArrayHandle<T,Storage> &array,
+                           std::vector<vtkm::Range> &ranges,
+                           DeviceAdapterTag,
+                           boost::true_type /*isMonotonic*/)
+{
+  typedef internal::ArrayRangeComputeToRanges<T> ToRangesType;
+  typedef typename ToRangesType::RangesType RangesType;
+  const vtkm::IdComponent numComponents = ToRangesType::NUM_COMPONENTS;
+
+  ranges.assign(static_cast<std::size_t>(numComponents), vtkm::Range());
+  vtkm::Id numValues = array.GetNumberOfValues();
+  if (numValues < 1) { return; }
+
+  typename vtkm::cont::ArrayHandle<T,Storage>::PortalConstControl portal =
+      array.GetPortalConstControl();
+  RangesType result = internal::ArrayRangeComputeUnion<numComponents>()(
+        ToRangesType()(portal.Get(0)), ToRangesType()(portal.Get(numValues-1)));
+  for (vtkm::IdComponent component = 0;
+       component < numComponents;
+       component++)
+  {
+    ranges[static_cast<std::size_t>(component)] = result[component];
+  }
+}
+
+template<typename T, typename Storage, typename DeviceAdapterTag>
+VTKM_CONT_EXPORT
+void ArrayRangeComputeImpl(const vtkm::cont::ArrayHandle<T,Storage> &array,
+                           std::vector<vtkm::Range> &ranges,
+                           DeviceAdapterTag,
+                           boost::false_type /*isMonotonic*/)
+{
+  typedef internal::ArrayRangeComputeToRanges<T> ToRangesType;
+  typedef typename ToRangesType::RangesType RangesType;
+  const vtkm::IdComponent numComponents = ToRangesType::NUM_COMPONENTS;
+
+  // The minimum and maximum of every component are found in one pass by
+  // reducing a Vec of ranges, one per component, made on the fly from the
+  // values.
+  RangesType result =
+      vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Reduce(
+        vtkm::cont::make_ArrayHandleTransform<RangesType>(array,
+                                                          ToRangesType()),
+        RangesType(vtkm::Range()),
+        internal::ArrayRangeComputeUnion<numComponents>());
+
+  ranges.resize(static_cast<std::size_t>(numComponents));
+  for (vtkm::IdComponent component = 0;
+       component < numComponents;
+       component++)
+  {
+    ranges[static_cast<std::size_t>(component)] = result[component];
+  }
+}
+
+template<typename DeviceAdapterTag>
+struct ArrayRangeComputeBoundsFunctor
+{
+  vtkm::Bounds *Bounds;
+
+  VTKM_CONT_EXPORT
+  ArrayRangeComputeBoundsFunctor(vtkm::Bounds *bounds) : Bounds(bounds) {  }
+
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void operator()(
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &array) const;
+};
+
+} // namespace internal
+
+/// \brief Computes the range of each component of the values in an array.
+///
+/// Returns one vtkm::Range per component (as given by vtkm::VecTraits). The
+/// minimum and maximum of all components are found with a single reduction
+/// on the given device. Counting, constant, and uniform point coordinate
+/// arrays are not read; their ranges come from their first and last values.
+///
+/// For basic arrays the result is stored with the array handle (and so is
+/// shared by its copies) and returned again without reading the array until
+/// the array is next modified (see ArrayHandle::GetModifiedCount).
+///
+/// An empty array gives empty ranges.
+///
+template<typename T, typename Storage, typename DeviceAdapterTag>
+VTKM_CONT_EXPORT
+std::vector<vtkm::Range>
+ComputeRange(const vtkm::cont::ArrayHandle<T,Storage> &array,
+             DeviceAdapterTag)
+{
+  const bool isCacheable =
+      internal::ArrayRangeComputeIsCacheable<Storage>::value;
+
+  std::vector<vtkm::Range> ranges;
+  if (isCacheable && internal::ArrayRangeComputeGetCached(array, ranges))
+  {
+    return ranges;
+  }
+
+  internal::ArrayRangeComputeImpl(
+        array,
+        ranges,
+        DeviceAdapterTag(),
+        typename internal::ArrayRangeComputeIsMonotonic<Storage>::type());
+
+  if (isCacheable)
+  {
+    internal::ArrayRangeComputeSetCached(array, ranges);
+  }
+  return ranges;
+}
+
+/// \brief Computes the bounds of an array of 3D points.
+///
+template<typename T, typename Storage, typename DeviceAdapterTag>
+VTKM_CONT_EXPORT
+vtkm::Bounds
+ComputeBounds(const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &points,
+              DeviceAdapterTag)
+{
+  std::vector<vtkm::Range> ranges =
+      vtkm::cont::ComputeRange(points, DeviceAdapterTag());
+  return vtkm::Bounds(ranges[0], ranges[1], ranges[2]);
+}
+
+/// \brief Computes the bounds of point coordinates.
+///
+/// The coordinates are resolved with the default lists of the
+/// DynamicPointCoordinates.
+///
+template<typename DeviceAdapterTag>
+VTKM_CONT_EXPORT
+vtkm::Bounds
+ComputeBounds(const vtkm::cont::DynamicPointCoordinates &coordinates,
+              DeviceAdapterTag)
+{
+  vtkm::Bounds bounds;
+  coordinates.CastAndCall(
+        internal::ArrayRangeComputeBoundsFunctor<DeviceAdapterTag>(&bounds));
+  return bounds;
+}
+
+namespace internal {
+
+template<typename DeviceAdapterTag>
+template<typename T, typename Storage>
+VTKM_CONT_EXPORT
+void ArrayRangeComputeBoundsFunctor<DeviceAdapterTag>::operator()(
+    const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &array) const
+{
+  *this->Bounds = vtkm::cont::ComputeBounds(array, DeviceAdapterTag());
+}
+
+} // namespace internal
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ArrayRangeCompute_h
@@ -0,0 +1,68 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_CellSet_h
+#define vtk_m_cont_CellSet_h
+
+#include <vtkm/Types.h>
+
+#include <string>
+
+namespace vtkm {
+namespace cont {
+
+/// \brief Base class for the sets of cells that make up a mesh.
+///
+/// A cell set defines the topology of a mesh: its cells and the points of
+/// each cell. Structured cell sets compute the connectivity from the
+/// dimensions of a grid whereas explicit cell sets store it in arrays. This
+/// base class gives access to what all cell sets have in common so that they
+/// can be held together (for example, in a DataSet). The connectivity itself
+/// is accessed through the subclasses.
+///
+class CellSet
+{
+public:
+  VTKM_CONT_EXPORT
+  CellSet(const std::string &name, vtkm::IdComponent dimensionality)
+    : Name(name), Dimensionality(dimensionality) {  }
+
+  virtual ~CellSet() {  }
+
+  VTKM_CONT_EXPORT
+  const std::string &GetName() const { return this->Name; }
+
+  /// The topological dimension of the cells (for example, 3 for hexahedra).
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::IdComponent GetDimensionality() const { return this->Dimensionality; }
+
+  virtual vtkm::Id GetNumberOfCells() const = 0;
+
+  virtual vtkm::Id GetNumberOfPoints() const = 0;
+
+protected:
+  std::string Name;
+  vtkm::IdComponent Dimensionality;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_CellSet_h
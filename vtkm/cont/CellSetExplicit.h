@@ -0,0 +1,278 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_CellSetExplicit_h
+#define vtk_m_cont_CellSetExplicit_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/CellSet.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+#include <vtkm/cont/internal/ReverseConnectivity.h>
+
+#include <vtkm/exec/ConnectivityExplicit.h>
+
+namespace vtkm {
+namespace cont {
+
+/// \brief A cell set with the connectivity of each cell given explicitly.
+///
+/// The cells are described by three arrays: the shape of each cell, the
+/// number of points in each cell, and the point indices of all cells packed
+/// one after the other. The offset of each cell into the connectivity array
+/// is computed from the number of indices with an exclusive scan the first
+/// time the cell set is prepared for a device, and is kept until the cells
+/// are replaced. The cells incident on each point are likewise built the
+/// first time they are requested and kept until the cells are replaced, so
+/// filters that need them after the first one get them for free.
+///
+template<typename ShapeStorageTag = VTKM_DEFAULT_STORAGE_TAG,
+         typename NumIndicesStorageTag = VTKM_DEFAULT_STORAGE_TAG,
+         typename ConnectivityStorageTag = VTKM_DEFAULT_STORAGE_TAG>
+class CellSetExplicit : public vtkm::cont::CellSet
+{
+public:
+  typedef vtkm::cont::ArrayHandle<vtkm::UInt8,ShapeStorageTag>
+      ShapeArrayType;
+  typedef vtkm::cont::ArrayHandle<vtkm::IdComponent,NumIndicesStorageTag>
+      NumIndicesArrayType;
+  typedef vtkm::cont::ArrayHandle<vtkm::Id,ConnectivityStorageTag>
+      ConnectivityArrayType;
+  typedef vtkm::cont::ArrayHandle<vtkm::Id> IndexOffsetArrayType;
+
+  /// The types of the execution objects that give the connectivity from \c
+  /// FromTopology elements to \c ToTopology elements.
+  ///
+  template<typename DeviceAdapterTag,
+           typename FromTopology,
+           typename ToTopology>
+  struct ExecutionTypes;
+
+  template<typename DeviceAdapterTag>
+  struct ExecutionTypes<DeviceAdapterTag,
+                        vtkm::TopologyElementTagPoint,
+                        vtkm::TopologyElementTagCell>
+  {
+    typedef vtkm::exec::ConnectivityExplicit<
+        typename ShapeArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::PortalConst,
+        typename NumIndicesArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::PortalConst,
+        typename ConnectivityArrayType::template ExecutionTypes<
+            DeviceAdapterTag>::PortalConst,
+        typename IndexOffsetArrayType::template ExecutionTypes<
+            DeviceAdapterTag>::PortalConst> ExecObjectType;
+  };
+
+  template<typename DeviceAdapterTag>
+  struct ExecutionTypes<DeviceAdapterTag,
+                        vtkm::TopologyElementTagCell,
+                        vtkm::TopologyElementTagPoint>
+  {
+    typedef typename vtkm::cont::internal::ReverseConnectivity
+        ::ExecutionTypes<DeviceAdapterTag>::ExecObjectType ExecObjectType;
+  };
+
+  VTKM_CONT_EXPORT
+  CellSetExplicit(const std::string &name = std::string(),
+                  vtkm::Id numberOfPoints = 0,
+                  vtkm::IdComponent dimensionality = 3)
+    : CellSet(name, dimensionality),
+      NumberOfPoints(numberOfPoints),
+      IndexOffsetsValid(false) {  }
+
+  VTKM_CONT_EXPORT
+  virtual vtkm::Id GetNumberOfCells() const
+  {
+    return this->Shapes.GetNumberOfValues();
+  }
+
+  VTKM_CONT_EXPORT
+  virtual vtkm::Id GetNumberOfPoints() const
+  {
+    return this->NumberOfPoints;
+  }
+
+  VTKM_CONT_EXPORT
+  void SetNumberOfPoints(vtkm::Id numberOfPoints)
+  {
+    this->NumberOfPoints = numberOfPoints;
+    this->CellsOfPoints.Reset();
+  }
+
+  /// Replaces the cells. \c shapes and \c numIndices have one entry per
+  /// cell, and \c connectivity holds the point indices of all the cells in
+  /// order, so its length must be the sum of \c numIndices. The arrays are
+  /// shallow copied, so they should not be modified afterward.
+  ///
+  VTKM_CONT_EXPORT
+  void Fill(const ShapeArrayType &shapes,
+            const NumIndicesArrayType &numIndices,
+            const ConnectivityArrayType &connectivity)
+  {
+    if (shapes.GetNumberOfValues() != numIndices.GetNumberOfValues())
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Shapes and number of indices must have the same length.");
+    }
+    typename NumIndicesArrayType::PortalConstControl numIndicesPortal =
+        numIndices.GetPortalConstControl();
+    vtkm::Id totalIndices = 0;
+    for (vtkm::Id cellIndex = 0;
+         cellIndex < numIndicesPortal.GetNumberOfValues();
+         cellIndex++)
+    {
+      totalIndices += numIndicesPortal.Get(cellIndex);
+    }
+    if (totalIndices != connectivity.GetNumberOfValues())
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Connectivity length does not match the number of indices.");
+    }
+    this->Shapes = shapes;
+    this->NumIndices = numIndices;
+    this->Connectivity = connectivity;
+    this->IndexOffsets = IndexOffsetArrayType();
+    this->IndexOffsetsValid = false;
+    this->CellsOfPoints.Reset();
+  }
+
+  VTKM_CONT_EXPORT
+  const ShapeArrayType &GetShapesArray() const { return this->Shapes; }
+
+  VTKM_CONT_EXPORT
+  const NumIndicesArrayType &GetNumIndicesArray() const
+  {
+    return this->NumIndices;
+  }
+
+  VTKM_CONT_EXPORT
+  const ConnectivityArrayType &GetConnectivityArray() const
+  {
+    return this->Connectivity;
+  }
+
+  /// Returns the offset of each cell into the connectivity array, computing
+  /// the offsets on the given device if they are not already known.
+  ///
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  const IndexOffsetArrayType &GetIndexOffsetArray(DeviceAdapterTag) const
+  {
+    this->BuildIndexOffsets(DeviceAdapterTag());
+    return this->IndexOffsets;
+  }
+
+  /// Returns an object that gives the points of each cell in the execution
+  /// environment.
+  ///
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  typename ExecutionTypes<DeviceAdapterTag,
+                          vtkm::TopologyElementTagPoint,
+                          vtkm::TopologyElementTagCell>::ExecObjectType
+  PrepareForInput(DeviceAdapterTag,
+                  vtkm::TopologyElementTagPoint,
+                  vtkm::TopologyElementTagCell) const
+  {
+    typedef typename ExecutionTypes<DeviceAdapterTag,
+                                    vtkm::TopologyElementTagPoint,
+                                    vtkm::TopologyElementTagCell>
+        ::ExecObjectType ExecObjectType;
+
+    this->BuildIndexOffsets(DeviceAdapterTag());
+    return ExecObjectType(this->Shapes.PrepareForInput(DeviceAdapterTag()),
+                          this->NumIndices.PrepareForInput(DeviceAdapterTag()),
+                          this->Connectivity.PrepareForInput(
+                            DeviceAdapterTag()),
+                          this->IndexOffsets.PrepareForInput(
+                            DeviceAdapterTag()));
+  }
+
+  /// Returns an object that gives the cells incident on each point in the
+  /// execution environment. The incidence is computed on the given device
+  /// the first time it is requested and is kept until the cells are
+  /// replaced.
+  ///
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  typename ExecutionTypes<DeviceAdapterTag,
+                          vtkm::TopologyElementTagCell,
+                          vtkm::TopologyElementTagPoint>::ExecObjectType
+  PrepareForInput(DeviceAdapterTag,
+                  vtkm::TopologyElementTagCell,
+                  vtkm::TopologyElementTagPoint) const
+  {
+    if (!this->CellsOfPoints.IsBuilt())
+    {
+      this->BuildIndexOffsets(DeviceAdapterTag());
+      this->CellsOfPoints.Build(this->NumIndices,
+                                this->Connectivity,
+                                this->IndexOffsets,
+                                this->NumberOfPoints,
+                                DeviceAdapterTag());
+    }
+    return this->CellsOfPoints.PrepareForInput(DeviceAdapterTag());
+  }
+
+  /// The cells incident on each point, or an empty structure if they have
+  /// not been requested since the cells were last replaced.
+  ///
+  VTKM_CONT_EXPORT
+  const vtkm::cont::internal::ReverseConnectivity &GetCellsOfPoints() const
+  {
+    return this->CellsOfPoints;
+  }
+
+private:
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  void BuildIndexOffsets(DeviceAdapterTag) const
+  {
+    if (this->IndexOffsetsValid) { return; }
+
+    vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::ScanExclusive(
+          vtkm::cont::make_ArrayHandleTransform<vtkm::Id>(
+            this->NumIndices,
+            internal::ConnectivityNumIndicesToId()),
+          this->IndexOffsets);
+    this->IndexOffsetsValid = true;
+  }
+
+  vtkm::Id NumberOfPoints;
+  ShapeArrayType Shapes;
+  NumIndicesArrayType NumIndices;
+  ConnectivityArrayType Connectivity;
+
+  // The offsets and the cells of each point are derived from the other
+  // arrays, so they are caches that can be filled in from const methods.
+  mutable IndexOffsetArrayType IndexOffsets;
+  mutable bool IndexOffsetsValid;
+  mutable vtkm::cont::internal::ReverseConnectivity CellsOfPoints;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_CellSetExplicit_h
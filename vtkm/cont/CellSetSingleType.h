@@ -0,0 +1,304 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_CellSetSingleType_h
+#define vtk_m_cont_CellSetSingleType_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/CellSet.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/ReverseConnectivity.h>
+
+#include <vtkm/exec/ConnectivityExplicit.h>
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+/// Computes the offset of a cell into the connectivity array of a cell set
+/// where every cell has the same number of points.
+///
+struct CellSetSingleTypeIndexOffset
+{
+  VTKM_EXEC_CONT_EXPORT
+  CellSetSingleTypeIndexOffset() : NumberOfPointsInCell(0) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  CellSetSingleTypeIndexOffset(vtkm::IdComponent numberOfPointsInCell)
+    : NumberOfPointsInCell(numberOfPointsInCell) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id operator()(vtkm::Id cellIndex) const
+  {
+    return cellIndex * this->NumberOfPointsInCell;
+  }
+
+  vtkm::IdComponent NumberOfPointsInCell;
+};
+
+} // namespace internal
+
+/// \brief An explicit cell set where every cell has the same shape.
+///
+/// Only the connectivity array is stored. The shapes, number of indices, and
+/// offsets that \c CellSetExplicit keeps in arrays are replaced by implicit
+/// arrays computed from the shape and the cell index, so preparing the cell
+/// set moves and reads a single array. The execution object has the same
+/// interface as the one of \c CellSetExplicit.
+///
+template<typename ConnectivityStorageTag = VTKM_DEFAULT_STORAGE_TAG>
+class CellSetSingleType : public vtkm::cont::CellSet
+{
+public:
+  typedef vtkm::cont::ArrayHandleConstant<vtkm::UInt8> ShapeArrayType;
+  typedef vtkm::cont::ArrayHandleConstant<vtkm::IdComponent>
+      NumIndicesArrayType;
+  typedef vtkm::cont::ArrayHandle<vtkm::Id,ConnectivityStorageTag>
+      ConnectivityArrayType;
+  typedef vtkm::cont::ArrayHandleTransform<
+      vtkm::Id,
+      vtkm::cont::ArrayHandleCounting<vtkm::Id>,
+      internal::CellSetSingleTypeIndexOffset> IndexOffsetArrayType;
+
+  /// The types of the execution objects that give the connectivity from \c
+  /// FromTopology elements to \c ToTopology elements.
+  ///
+  template<typename DeviceAdapterTag,
+           typename FromTopology,
+           typename ToTopology>
+  struct ExecutionTypes;
+
+  template<typename DeviceAdapterTag>
+  struct ExecutionTypes<DeviceAdapterTag,
+                        vtkm::TopologyElementTagPoint,
+                        vtkm::TopologyElementTagCell>
+  {
+    typedef vtkm::exec::ConnectivityExplicit<
+        typename ShapeArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::PortalConst,
+        typename NumIndicesArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::PortalConst,
+        typename ConnectivityArrayType::template ExecutionTypes<
+            DeviceAdapterTag>::PortalConst,
+        typename IndexOffsetArrayType::template ExecutionTypes<
+            DeviceAdapterTag>::PortalConst> ExecObjectType;
+  };
+
+  template<typename DeviceAdapterTag>
+  struct ExecutionTypes<DeviceAdapterTag,
+                        vtkm::TopologyElementTagCell,
+                        vtkm::TopologyElementTagPoint>
+  {
+    typedef typename vtkm::cont::internal::ReverseConnectivity
+        ::ExecutionTypes<DeviceAdapterTag>::ExecObjectType ExecObjectType;
+  };
+
+  VTKM_CONT_EXPORT
+  CellSetSingleType(const std::string &name = std::string(),
+                    vtkm::Id numberOfPoints = 0,
+                    vtkm::IdComponent dimensionality = 3)
+    : CellSet(name, dimensionality),
+      NumberOfPoints(numberOfPoints),
+      Shape(vtkm::CELL_SHAPE_EMPTY),
+      NumberOfPointsInCell(0) {  }
+
+  VTKM_CONT_EXPORT
+  virtual vtkm::Id GetNumberOfCells() const
+  {
+    if (this->NumberOfPointsInCell <= 0) { return 0; }
+    return this->Connectivity.GetNumberOfValues()/this->NumberOfPointsInCell;
+  }
+
+  VTKM_CONT_EXPORT
+  virtual vtkm::Id GetNumberOfPoints() const
+  {
+    return this->NumberOfPoints;
+  }
+
+  VTKM_CONT_EXPORT
+  void SetNumberOfPoints(vtkm::Id numberOfPoints)
+  {
+    this->NumberOfPoints = numberOfPoints;
+    this->CellsOfPoints.Reset();
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::CellShape GetCellShape() const { return this->Shape; }
+
+  VTKM_CONT_EXPORT
+  vtkm::IdComponent GetNumberOfPointsInCell() const
+  {
+    return this->NumberOfPointsInCell;
+  }
+
+  /// Replaces the cells with cells of the given shape. The number of points
+  /// in each cell comes from the shape, which therefore must have a fixed
+  /// number of points.
+  ///
+  VTKM_CONT_EXPORT
+  void Fill(vtkm::CellShape shape, const ConnectivityArrayType &connectivity)
+  {
+    this->Fill(shape, vtkm::CellShapeNumberOfPoints(shape), connectivity);
+  }
+
+  /// Replaces the cells with cells of the given shape that each have \c
+  /// numberOfPointsInCell points. This form is needed for shapes such as
+  /// polygons that do not have a fixed number of points.
+  ///
+  VTKM_CONT_EXPORT
+  void Fill(vtkm::CellShape shape,
+            vtkm::IdComponent numberOfPointsInCell,
+            const ConnectivityArrayType &connectivity)
+  {
+    if (numberOfPointsInCell <= 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Cells must have a positive number of points.");
+    }
+    if (connectivity.GetNumberOfValues() % numberOfPointsInCell != 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Connectivity length is not a multiple of the cell size.");
+    }
+    this->Shape = shape;
+    this->NumberOfPointsInCell = numberOfPointsInCell;
+    this->Connectivity = connectivity;
+    this->CellsOfPoints.Reset();
+  }
+
+  VTKM_CONT_EXPORT
+  ShapeArrayType GetShapesArray() const
+  {
+    return ShapeArrayType(static_cast<vtkm::UInt8>(this->Shape),
+                          this->GetNumberOfCells());
+  }
+
+  VTKM_CONT_EXPORT
+  NumIndicesArrayType GetNumIndicesArray() const
+  {
+    return NumIndicesArrayType(this->NumberOfPointsInCell,
+                               this->GetNumberOfCells());
+  }
+
+  VTKM_CONT_EXPORT
+  const ConnectivityArrayType &GetConnectivityArray() const
+  {
+    return this->Connectivity;
+  }
+
+  /// Returns the offset of each cell into the connectivity array. The
+  /// offsets are implicit, so no device is needed to compute them.
+  ///
+  VTKM_CONT_EXPORT
+  IndexOffsetArrayType GetIndexOffsetArray() const
+  {
+    return IndexOffsetArrayType(
+          vtkm::cont::ArrayHandleCounting<vtkm::Id>(0,
+                                                    this->GetNumberOfCells()),
+          internal::CellSetSingleTypeIndexOffset(this->NumberOfPointsInCell));
+  }
+
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  IndexOffsetArrayType GetIndexOffsetArray(DeviceAdapterTag) const
+  {
+    return this->GetIndexOffsetArray();
+  }
+
+  /// Returns an object that gives the points of each cell in the execution
+  /// environment.
+  ///
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  typename ExecutionTypes<DeviceAdapterTag,
+                          vtkm::TopologyElementTagPoint,
+                          vtkm::TopologyElementTagCell>::ExecObjectType
+  PrepareForInput(DeviceAdapterTag,
+                  vtkm::TopologyElementTagPoint,
+                  vtkm::TopologyElementTagCell) const
+  {
+    typedef typename ExecutionTypes<DeviceAdapterTag,
+                                    vtkm::TopologyElementTagPoint,
+                                    vtkm::TopologyElementTagCell>
+        ::ExecObjectType ExecObjectType;
+
+    return ExecObjectType(
+          this->GetShapesArray().PrepareForInput(DeviceAdapterTag()),
+          this->GetNumIndicesArray().PrepareForInput(DeviceAdapterTag()),
+          this->Connectivity.PrepareForInput(DeviceAdapterTag()),
+          this->GetIndexOffsetArray().PrepareForInput(DeviceAdapterTag()));
+  }
+
+  /// Returns an object that gives the cells incident on each point in the
+  /// execution environment. The incidence is computed on the given device
+  /// the first time it is requested and is kept until the cells are
+  /// replaced.
+  ///
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  typename ExecutionTypes<DeviceAdapterTag,
+                          vtkm::TopologyElementTagCell,
+                          vtkm::TopologyElementTagPoint>::ExecObjectType
+  PrepareForInput(DeviceAdapterTag,
+                  vtkm::TopologyElementTagCell,
+                  vtkm::TopologyElementTagPoint) const
+  {
+    if (!this->CellsOfPoints.IsBuilt())
+    {
+      this->CellsOfPoints.Build(this->GetNumIndicesArray(),
+                                this->Connectivity,
+                                this->GetIndexOffsetArray(),
+                                this->NumberOfPoints,
+                                DeviceAdapterTag());
+    }
+    return this->CellsOfPoints.PrepareForInput(DeviceAdapterTag());
+  }
+
+  /// The cells incident on each point, or an empty structure if they have
+  /// not been requested since the cells were last replaced.
+  ///
+  VTKM_CONT_EXPORT
+  const vtkm::cont::internal::ReverseConnectivity &GetCellsOfPoints() const
+  {
+    return this->CellsOfPoints;
+  }
+
+private:
+  vtkm::Id NumberOfPoints;
+  vtkm::CellShape Shape;
+  vtkm::IdComponent NumberOfPointsInCell;
+  ConnectivityArrayType Connectivity;
+
+  // The cells of each point are derived from the connectivity, so they are a
+  // cache that can be filled in from const methods.
+  mutable vtkm::cont::internal::ReverseConnectivity CellsOfPoints;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_CellSetSingleType_h
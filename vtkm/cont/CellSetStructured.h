@@ -0,0 +1,123 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_CellSetStructured_h
+#define vtk_m_cont_CellSetStructured_h
+
+#include <vtkm/Extent.h>
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/CellSet.h>
+
+#include <vtkm/exec/ConnectivityStructured.h>
+
+#include <vtkm/internal/ConnectivityStructuredInternals.h>
+
+namespace vtkm {
+namespace cont {
+
+/// \brief A cell set for the cells of a structured grid.
+///
+/// A structured cell set stores only the \c Extent of the grid. Its cells are
+/// quadrilaterals (for 2 dimensions) or hexahedra (for 3 dimensions), and the
+/// connectivity in both directions (the points of each cell and the cells of
+/// each point) is computed from the extent when it is requested, so a
+/// structured grid holds no connectivity arrays.
+///
+/// Points and cells are identified by flat indices starting at 0 for the
+/// element at the minimum of the extent, which match the flat indices used by
+/// the functions in vtkm/Extent.h after subtracting the minimum.
+///
+template<vtkm::IdComponent Dimensions>
+class CellSetStructured : public vtkm::cont::CellSet
+{
+  typedef vtkm::internal::ConnectivityStructuredInternals<Dimensions>
+      InternalsType;
+
+public:
+  static const vtkm::IdComponent DIMENSIONS = Dimensions;
+
+  typedef vtkm::Extent<Dimensions> ExtentType;
+
+  /// The types of the execution objects that give the connectivity from \c
+  /// FromTopology elements to \c ToTopology elements.
+  ///
+  template<typename DeviceAdapterTag,
+           typename FromTopology,
+           typename ToTopology>
+  struct ExecutionTypes
+  {
+    typedef vtkm::exec::ConnectivityStructured<
+        FromTopology,ToTopology,Dimensions> ExecObjectType;
+  };
+
+  VTKM_CONT_EXPORT
+  CellSetStructured(const std::string &name = std::string(),
+                    const ExtentType &extent = ExtentType())
+    : CellSet(name, Dimensions), Internals(extent) {  }
+
+  VTKM_CONT_EXPORT
+  void SetExtent(const ExtentType &extent)
+  {
+    this->Internals = InternalsType(extent);
+  }
+
+  VTKM_CONT_EXPORT
+  const ExtentType &GetExtent() const { return this->Internals.GetExtent(); }
+
+  VTKM_CONT_EXPORT
+  virtual vtkm::Id GetNumberOfCells() const
+  {
+    return this->Internals.GetNumberOfCells();
+  }
+
+  VTKM_CONT_EXPORT
+  virtual vtkm::Id GetNumberOfPoints() const
+  {
+    return this->Internals.GetNumberOfPoints();
+  }
+
+  /// Returns an object that gives the connectivity from \c FromTopology
+  /// elements to \c ToTopology elements in the execution environment. For
+  /// example, use TopologyElementTagPoint and TopologyElementTagCell to get
+  /// the points of each cell. Structured connectivity has no data to move,
+  /// so this is a copy of the dimensions.
+  ///
+  template<typename DeviceAdapterTag,
+           typename FromTopology,
+           typename ToTopology>
+  VTKM_CONT_EXPORT
+  typename ExecutionTypes<DeviceAdapterTag,FromTopology,ToTopology>
+      ::ExecObjectType
+  PrepareForInput(DeviceAdapterTag, FromTopology, ToTopology) const
+  {
+    typedef typename ExecutionTypes<DeviceAdapterTag,FromTopology,ToTopology>
+        ::ExecObjectType ExecObjectType;
+    return ExecObjectType(this->Internals);
+  }
+
+private:
+  InternalsType Internals;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_CellSetStructured_h
@@ -0,0 +1,86 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_CoordinateSystem_h
+#define vtk_m_cont_CoordinateSystem_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/ListTag.h>
+#include <vtkm/TypeListTag.h>
+
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/Field.h>
+#include <vtkm/cont/StorageBasic.h>
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+struct CoordinateSystemStorageList
+    : vtkm::ListTagBase<
+        vtkm::cont::StorageTagBasic,
+        vtkm::cont::ArrayHandleUniformPointCoordinates::StorageTag>
+{  };
+
+} // namespace internal
+
+/// \brief A point field that holds the coordinates of the points.
+///
+/// The coordinates are 3-component vectors. The bounds of the points are the
+/// ranges of the components, computed like the ranges of any other field.
+///
+class CoordinateSystem : public vtkm::cont::Field
+{
+public:
+  VTKM_CONT_EXPORT
+  CoordinateSystem(const std::string &name,
+                   const vtkm::cont::DynamicArrayHandle &data)
+    : Field(name, ASSOC_POINTS, data) {  }
+
+  /// Returns the bounds of the points, computed on the given device. Basic
+  /// arrays and uniform point coordinates are tried.
+  ///
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  vtkm::Bounds GetBounds(DeviceAdapterTag) const
+  {
+    return this->GetBounds(DeviceAdapterTag(),
+                           vtkm::TypeListTagFieldVec3(),
+                           internal::CoordinateSystemStorageList());
+  }
+
+  /// A version of GetBounds that tries the given lists of value types and
+  /// storage types when resolving the coordinates array.
+  ///
+  template<typename DeviceAdapterTag, typename TypeList, typename StorageList>
+  VTKM_CONT_EXPORT
+  vtkm::Bounds GetBounds(DeviceAdapterTag, TypeList, StorageList) const
+  {
+    std::vector<vtkm::Range> ranges =
+        this->GetRange(DeviceAdapterTag(), TypeList(), StorageList());
+    VTKM_ASSERT_CONT(ranges.size() == 3);
+    return vtkm::Bounds(ranges[0], ranges[1], ranges[2]);
+  }
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_CoordinateSystem_h
@@ -0,0 +1,271 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_DataSet_h
+#define vtk_m_cont_DataSet_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/CellSet.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/Field.h>
+
+#include <boost/smart_ptr/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace cont {
+
+/// \brief A mesh with the fields defined on it.
+///
+/// A DataSet holds coordinate systems, cell sets, and fields, all of which
+/// refer to their arrays through handles. Copying a DataSet is therefore a
+/// shallow copy: the copy shares every array (and the cached field ranges)
+/// with the original. Adding or replacing a member of the copy does not
+/// change the original.
+///
+class DataSet
+{
+public:
+  VTKM_CONT_EXPORT
+  DataSet() {  }
+
+  /// Adds a field. A field already in the data set with the same name and
+  /// association is replaced.
+  ///
+  VTKM_CONT_EXPORT
+  void AddField(const vtkm::cont::Field &field)
+  {
+    vtkm::Id index = this->FindFieldIndex(field.GetName(),
+                                          field.GetAssociation());
+    if (index < 0)
+    {
+      this->Fields.push_back(field);
+    }
+    else
+    {
+      this->Fields[static_cast<std::size_t>(index)] = field;
+    }
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfFields() const
+  {
+    return static_cast<vtkm::Id>(this->Fields.size());
+  }
+
+  VTKM_CONT_EXPORT
+  const vtkm::cont::Field &GetField(vtkm::Id index) const
+  {
+    if ((index < 0) || (index >= this->GetNumberOfFields()))
+    {
+      throw vtkm::cont::ErrorControlBadValue("Invalid field index.");
+    }
+    return this->Fields[static_cast<std::size_t>(index)];
+  }
+
+  /// Returns true if the data set has a field with the given name. If \c
+  /// association is not ASSOC_ANY, the field must also have that
+  /// association.
+  ///
+  VTKM_CONT_EXPORT
+  bool HasField(const std::string &name,
+                vtkm::cont::Field::AssociationEnum association =
+                    vtkm::cont::Field::ASSOC_ANY) const
+  {
+    return (this->FindFieldIndex(name, association) >= 0);
+  }
+
+  /// Returns the index of the field with the given name (and association if
+  /// not ASSOC_ANY). Throws ErrorControlBadValue if there is no such field.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Id GetFieldIndex(const std::string &name,
+                         vtkm::cont::Field::AssociationEnum association =
+                             vtkm::cont::Field::ASSOC_ANY) const
+  {
+    vtkm::Id index = this->FindFieldIndex(name, association);
+    if (index < 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "No field with requested name: " + name);
+    }
+    return index;
+  }
+
+  VTKM_CONT_EXPORT
+  const vtkm::cont::Field &
+  GetField(const std::string &name,
+           vtkm::cont::Field::AssociationEnum association =
+               vtkm::cont::Field::ASSOC_ANY) const
+  {
+    return this->GetField(this->GetFieldIndex(name, association));
+  }
+
+  /// Adds a coordinate system. One with the same name is replaced.
+  ///
+  VTKM_CONT_EXPORT
+  void AddCoordinateSystem(const vtkm::cont::CoordinateSystem &coordinates)
+  {
+    vtkm::Id index = this->FindCoordinateSystemIndex(coordinates.GetName());
+    if (index < 0)
+    {
+      this->CoordinateSystems.push_back(coordinates);
+    }
+    else
+    {
+      this->CoordinateSystems[static_cast<std::size_t>(index)] = coordinates;
+    }
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfCoordinateSystems() const
+  {
+    return static_cast<vtkm::Id>(this->CoordinateSystems.size());
+  }
+
+  VTKM_CONT_EXPORT
+  const vtkm::cont::CoordinateSystem &
+  GetCoordinateSystem(vtkm::Id index = 0) const
+  {
+    if ((index < 0) || (index >= this->GetNumberOfCoordinateSystems()))
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Invalid coordinate system index.");
+    }
+    return this->CoordinateSystems[static_cast<std::size_t>(index)];
+  }
+
+  VTKM_CONT_EXPORT
+  const vtkm::cont::CoordinateSystem &
+  GetCoordinateSystem(const std::string &name) const
+  {
+    vtkm::Id index = this->FindCoordinateSystemIndex(name);
+    if (index < 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "No coordinate system with requested name: " + name);
+    }
+    return this->GetCoordinateSystem(index);
+  }
+
+  /// Adds a cell set. One with the same name is replaced.
+  ///
+  VTKM_CONT_EXPORT
+  void AddCellSet(boost::shared_ptr<vtkm::cont::CellSet> cellSet)
+  {
+    vtkm::Id index = this->FindCellSetIndex(cellSet->GetName());
+    if (index < 0)
+    {
+      this->CellSets.push_back(cellSet);
+    }
+    else
+    {
+      this->CellSets[static_cast<std::size_t>(index)] = cellSet;
+    }
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfCellSets() const
+  {
+    return static_cast<vtkm::Id>(this->CellSets.size());
+  }
+
+  /// Returns a cell set. Use \c boost::dynamic_pointer_cast to get the
+  /// concrete type of the cell set.
+  ///
+  VTKM_CONT_EXPORT
+  boost::shared_ptr<vtkm::cont::CellSet> GetCellSet(vtkm::Id index = 0) const
+  {
+    if ((index < 0) || (index >= this->GetNumberOfCellSets()))
+    {
+      throw vtkm::cont::ErrorControlBadValue("Invalid cell set index.");
+    }
+    return this->CellSets[static_cast<std::size_t>(index)];
+  }
+
+  VTKM_CONT_EXPORT
+  boost::shared_ptr<vtkm::cont::CellSet>
+  GetCellSet(const std::string &name) const
+  {
+    vtkm::Id index = this->FindCellSetIndex(name);
+    if (index < 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "No cell set with requested name: " + name);
+    }
+    return this->GetCellSet(index);
+  }
+
+private:
+  std::vector<vtkm::cont::CoordinateSystem> CoordinateSystems;
+  std::vector<vtkm::cont::Field> Fields;
+  std::vector<boost::shared_ptr<vtkm::cont::CellSet> > CellSets;
+
+  VTKM_CONT_EXPORT
+  vtkm::Id FindFieldIndex(const std::string &name,
+                          vtkm::cont::Field::AssociationEnum association) const
+  {
+    for (std::size_t index = 0; index < this->Fields.size(); index++)
+    {
+      const vtkm::cont::Field &field = this->Fields[index];
+      if ((field.GetName() == name) &&
+          ((association == vtkm::cont::Field::ASSOC_ANY) ||
+           (association == field.GetAssociation())))
+      {
+        return static_cast<vtkm::Id>(index);
+      }
+    }
+    return -1;
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id FindCoordinateSystemIndex(const std::string &name) const
+  {
+    for (std::size_t index = 0; index < this->CoordinateSystems.size(); index++)
+    {
+      if (this->CoordinateSystems[index].GetName() == name)
+      {
+        return static_cast<vtkm::Id>(index);
+      }
+    }
+    return -1;
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id FindCellSetIndex(const std::string &name) const
+  {
+    for (std::size_t index = 0; index < this->CellSets.size(); index++)
+    {
+      if (this->CellSets[index]->GetName() == name)
+      {
+        return static_cast<vtkm::Id>(index);
+      }
+    }
+    return -1;
+  }
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_DataSet_h
@@ -0,0 +1,213 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_DispatcherMapField_h
+#define vtk_m_cont_DispatcherMapField_h
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/internal/DispatcherBase.h>
+
+#include <vtkm/exec/WorkletMapField.h>
+
+#include <vtkm/exec/internal/ExecutionField.h>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/static_assert.hpp>
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+/// Transport policy for the \c Field tags of vtkm::exec::WorkletMapField. See
+/// DispatcherBase for the interface.
+///
+struct DispatcherMapFieldTransportPolicy
+{
+  typedef vtkm::exec::WorkletMapField::Field Field;
+  typedef vtkm::exec::WorkletMapField::In In;
+  typedef vtkm::exec::WorkletMapField::Out Out;
+  typedef vtkm::exec::WorkletMapField::InOut InOut;
+
+  // Tags in a ControlSignature decay to function pointers (for example,
+  // Field(In) becomes Field(*)(In)), so that is what is specialized here.
+  // Array arguments may be any ArrayHandle or subclass of one.
+  template<typename ControlTag, typename ArgumentType, typename Device>
+  struct Transport;
+
+  template<typename T, typename Device, typename IsArray>
+  struct TransportFieldIn;
+
+  // Field(In) with a single value.
+  template<typename T, typename Device>
+  struct TransportFieldIn<T, Device, boost::mpl::false_>
+  {
+    typedef vtkm::exec::internal::ExecutionFieldConstant<T> ExecObjectType;
+
+    VTKM_CONT_EXPORT
+    static ExecObjectType Prepare(const T &value, vtkm::Id)
+    {
+      return ExecObjectType(value);
+    }
+
+    VTKM_CONT_EXPORT
+    static vtkm::Id GetInputSize(const T &) { return -1; }
+  };
+
+  // Field(In) with an array.
+  template<typename ArrayHandleType, typename Device>
+  struct TransportFieldIn<ArrayHandleType, Device, boost::mpl::true_>
+  {
+    typedef vtkm::exec::internal::ExecutionFieldIn<
+        typename ArrayHandleType::template ExecutionTypes<Device>::PortalConst>
+        ExecObjectType;
+
+    VTKM_CONT_EXPORT
+    static ExecObjectType Prepare(const ArrayHandleType &array, vtkm::Id)
+    {
+      return ExecObjectType(array.PrepareForInput(Device()));
+    }
+
+    VTKM_CONT_EXPORT
+    static vtkm::Id GetInputSize(const ArrayHandleType &array)
+    {
+      return array.GetNumberOfValues();
+    }
+  };
+
+  template<typename T, typename Device>
+  struct Transport<Field(*)(In), T, Device>
+    : TransportFieldIn<
+        T, Device, typename vtkm::cont::internal::IsArrayHandle<T>::type>
+  {  };
+
+  template<typename ArrayHandleType, typename Device>
+  struct Transport<Field(*)(Out), ArrayHandleType, Device>
+  {
+    BOOST_STATIC_ASSERT_MSG(
+        vtkm::cont::internal::IsArrayHandle<ArrayHandleType>::type::value,
+        "Field(Out) arguments must be array handles.");
+
+    typedef vtkm::exec::internal::ExecutionFieldOut<
+        typename ArrayHandleType::template ExecutionTypes<Device>::Portal>
+        ExecObjectType;
+
+    VTKM_CONT_EXPORT
+    static ExecObjectType Prepare(ArrayHandleType array, vtkm::Id numInstances)
+    {
+      return ExecObjectType(array.PrepareForOutput(numInstances, Device()));
+    }
+
+    VTKM_CONT_EXPORT
+    static vtkm::Id GetInputSize(const ArrayHandleType &) { return -1; }
+  };
+
+  template<typename ArrayHandleType, typename Device>
+  struct Transport<Field(*)(InOut), ArrayHandleType, Device>
+  {
+    BOOST_STATIC_ASSERT_MSG(
+        vtkm::cont::internal::IsArrayHandle<ArrayHandleType>::type::value,
+        "Field(InOut) arguments must be array handles.");
+
+    typedef vtkm::exec::internal::ExecutionFieldInOut<
+        typename ArrayHandleType::template ExecutionTypes<Device>::Portal>
+        ExecObjectType;
+
+    VTKM_CONT_EXPORT
+    static ExecObjectType Prepare(ArrayHandleType array, vtkm::Id)
+    {
+      return ExecObjectType(array.PrepareForInPlace(Device()));
+    }
+
+    VTKM_CONT_EXPORT
+    static vtkm::Id GetInputSize(const ArrayHandleType &array)
+    {
+      return array.GetNumberOfValues();
+    }
+  };
+};
+
+} // namespace internal
+
+/// \brief Dispatcher for worklets that inherit from
+/// vtkm::exec::WorkletMapField.
+///
+/// Invoke takes one argument for each tag in the worklet's \c
+/// ControlSignature. Arguments may be ArrayHandle or DynamicArrayHandle
+/// objects (and, for <tt>Field(In)</tt>, single values). One instance of the
+/// worklet is run for each value of the input arrays, which must all be the
+/// same size. Output arrays are allocated to that size.
+///
+/// Each DynamicArrayHandle argument is resolved at run time, so the worklet is
+/// compiled for every combination of types in the lists of the dynamic
+/// arguments. Narrow these lists with ResetTypeList to the types the worklet
+/// supports.
+///
+/// \code{.cpp}
+/// vtkm::cont::DispatcherMapField<Square> dispatcher;
+/// dispatcher.Invoke(inputArray, outputArray);
+/// \endcode
+///
+template<typename WorkletType,
+         typename DeviceAdapterTag = VTKM_DEFAULT_DEVICE_ADAPTER_TAG>
+class DispatcherMapField :
+    public vtkm::cont::internal::DispatcherBase<
+      DispatcherMapField<WorkletType,DeviceAdapterTag>,
+      WorkletType,
+      vtkm::cont::internal::DispatcherMapFieldTransportPolicy,
+      DeviceAdapterTag>
+{
+  typedef vtkm::cont::internal::DispatcherBase<
+      DispatcherMapField<WorkletType,DeviceAdapterTag>,
+      WorkletType,
+      vtkm::cont::internal::DispatcherMapFieldTransportPolicy,
+      DeviceAdapterTag> Superclass;
+
+public:
+  VTKM_CONT_EXPORT
+  DispatcherMapField(const WorkletType &worklet = WorkletType())
+    : Superclass(worklet) {  }
+
+private:
+  friend struct vtkm::cont::internal::detail
+      ::DispatcherBaseDynamicTransformFinish<DispatcherMapField>;
+
+  template<typename Signature>
+  VTKM_CONT_EXPORT
+  void DoInvoke(
+      const vtkm::internal::FunctionInterface<Signature> &parameters) const
+  {
+    vtkm::Id numInstances = this->GetInputSize(parameters);
+    if (numInstances < 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "DispatcherMapField requires at least one input array.");
+    }
+
+    this->BasicInvoke(parameters, numInstances);
+  }
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_DispatcherMapField_h
@@ -27,7 +27,6 @@
 #include <vtkm/cont/StorageListTag.h>
 
 #include <vtkm/cont/internal/DynamicTransform.h>
-#include <vtkm/cont/internal/SimplePolymorphicContainer.h>
 
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/utility/enable_if.hpp>
@@ -44,6 +43,40 @@ namespace internal {
 template<typename TypeList, typename StorageList>
 class DynamicArrayHandleCast;
 
+/// Holds an ArrayHandle of any type behind a base class that gives the
+/// properties of the array that do not depend on its type.
+///
+struct DynamicArrayHandleContainerBase
+{
+  virtual ~DynamicArrayHandleContainerBase() {  }
+
+  virtual vtkm::Id GetNumberOfValues() const = 0;
+
+  virtual vtkm::UInt64 GetModifiedCount() const = 0;
+};
+
+template<typename ArrayHandleType>
+struct DynamicArrayHandleContainer : public DynamicArrayHandleContainerBase
+{
+  ArrayHandleType Item;
+
+  VTKM_CONT_EXPORT
+  DynamicArrayHandleContainer() : Item() {  }
+
+  VTKM_CONT_EXPORT
+  DynamicArrayHandleContainer(const ArrayHandleType &src) : Item(src) {  }
+
+  virtual vtkm::Id GetNumberOfValues() const
+  {
+    return this->Item.GetNumberOfValues();
+  }
+
+  virtual vtkm::UInt64 GetModifiedCount() const
+  {
+    return this->Item.GetModifiedCount();
+  }
+};
+
 } // namespace internal
 
 /// \brief Holds an array handle without having to specify template parameters.
@@ -82,7 +115,7 @@ public:
   template<typename Type, typename Storage>
   VTKM_CONT_EXPORT
   DynamicArrayHandle(const vtkm::cont::ArrayHandle<Type,Storage> &array)
-    : ArrayStorage(new vtkm::cont::internal::SimplePolymorphicContainer<
+    : ArrayStorage(new vtkm::cont::internal::DynamicArrayHandleContainer<
                      vtkm::cont::ArrayHandle<Type,Storage> >(array))
   {  }
 
@@ -109,7 +142,7 @@ public:
   VTKM_CONT_EXPORT
   vtkm::cont::ArrayHandle<Type, Storage>
   CastToArrayHandle(Type = Type(), Storage = Storage()) const {
-    vtkm::cont::internal::SimplePolymorphicContainer<
+    vtkm::cont::internal::DynamicArrayHandleContainer<
       vtkm::cont::ArrayHandle<Type,Storage> > *container =
         this->TryCastStorage<Type,Storage>();
     if (container == NULL)
@@ -119,6 +152,28 @@ public:
     return container->Item;
   }
 
+  /// Returns true if this object holds an array.
+  ///
+  VTKM_CONT_EXPORT
+  bool IsValid() const { return (this->ArrayStorage.get() != NULL); }
+
+  /// Returns the number of values in the held array, or 0 if there is none.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const
+  {
+    return this->IsValid() ? this->ArrayStorage->GetNumberOfValues() : 0;
+  }
+
+  /// Returns the modified count of the held array (see
+  /// ArrayHandle::GetModifiedCount), or 0 if there is none.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::UInt64 GetModifiedCount() const
+  {
+    return this->IsValid() ? this->ArrayStorage->GetModifiedCount() : 0;
+  }
+
   /// Changes the types to try casting to when resolving this dynamic array,
   /// which is specified with a list tag like those in TypeListTag.h. Since C++
   /// does not allow you to actually change the template arguments, this method
@@ -172,17 +227,17 @@ public:
   void CastAndCall(const Functor &f, TypeList, StorageList) const;
 
 private:
-  boost::shared_ptr<vtkm::cont::internal::SimplePolymorphicContainerBase>
+  boost::shared_ptr<vtkm::cont::internal::DynamicArrayHandleContainerBase>
     ArrayStorage;
 
   template<typename Type, typename Storage>
   VTKM_CONT_EXPORT
-  vtkm::cont::internal::SimplePolymorphicContainer<
+  vtkm::cont::internal::DynamicArrayHandleContainer<
     vtkm::cont::ArrayHandle<Type,Storage> > *
   TryCastStorage() const {
     return
         dynamic_cast<
-          vtkm::cont::internal::SimplePolymorphicContainer<
+          vtkm::cont::internal::DynamicArrayHandleContainer<
             vtkm::cont::ArrayHandle<Type,Storage> > *>(
           this->ArrayStorage.get());
   }
@@ -20,19 +20,42 @@
 #ifndef vtk_m_cont_ErrorExecution_h
 #define vtk_m_cont_ErrorExecution_h
 
+#include <vtkm/Types.h>
 #include <vtkm/cont/Error.h>
 
 namespace vtkm {
 namespace cont {
 
 /// This class is thrown in the control environment whenever an error occurs in
-/// the execution environment.
+/// the execution environment. The message is the one raised by the first
+/// failing instance; the number of instances that raised errors and the index
+/// of the instance that raised the message are also recorded when the device
+/// adapter can provide them.
 ///
 class ErrorExecution : public vtkm::cont::Error
 {
 public:
   ErrorExecution(const std::string message)
-    : Error(message) { }
+    : Error(message), NumberOfErrors(1), ErrorInstance(-1) { }
+
+  ErrorExecution(const std::string message,
+                 vtkm::Id numberOfErrors,
+                 vtkm::Id errorInstance)
+    : Error(message),
+      NumberOfErrors(numberOfErrors),
+      ErrorInstance(errorInstance) { }
+
+  /// The number of instances that raised an error before execution stopped.
+  ///
+  vtkm::Id GetNumberOfErrors() const { return this->NumberOfErrors; }
+
+  /// The index of the instance that raised the message, or -1 if unknown.
+  ///
+  vtkm::Id GetErrorInstance() const { return this->ErrorInstance; }
+
+private:
+  vtkm::Id NumberOfErrors;
+  vtkm::Id ErrorInstance;
 };
 
 }
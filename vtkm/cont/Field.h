@@ -0,0 +1,168 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_Field_h
+#define vtk_m_cont_Field_h
+
+#include <vtkm/Range.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/Assert.h>
+#include <vtkm/cont/DynamicArrayHandle.h>
+
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+// Computes the range of each component of an array on the given device.
+template<typename DeviceAdapterTag>
+struct FieldRangeFunctor
+{
+  std::vector<vtkm::Range> *Ranges;
+
+  VTKM_CONT_EXPORT
+  FieldRangeFunctor(std::vector<vtkm::Range> *ranges) : Ranges(ranges) {  }
+
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void operator()(const vtkm::cont::ArrayHandle<T,Storage> &array) const
+  {
+    *this->Ranges = vtkm::cont::ComputeRange(array, DeviceAdapterTag());
+  }
+};
+
+} // namespace internal
+
+/// \brief A named array of values associated with the elements of a mesh.
+///
+/// A Field holds its array in a DynamicArrayHandle, so copying a Field is a
+/// shallow copy that shares the array. The range of each component of the
+/// array comes from vtkm::cont::ComputeRange, which keeps the range of a
+/// basic array with the array itself, so copies of the field share it and
+/// it is recomputed only after the array has been given out for writing.
+///
+class Field
+{
+public:
+  enum AssociationEnum
+  {
+    ASSOC_ANY,
+    ASSOC_WHOLE_MESH,
+    ASSOC_POINTS,
+    ASSOC_CELL_SET
+  };
+
+  /// Creates a field associated with the points or the whole mesh.
+  ///
+  VTKM_CONT_EXPORT
+  Field(const std::string &name,
+        AssociationEnum association,
+        const vtkm::cont::DynamicArrayHandle &data)
+    : Name(name),
+      Association(association),
+      Data(data)
+  {
+    VTKM_ASSERT_CONT((association == ASSOC_WHOLE_MESH)
+                     || (association == ASSOC_POINTS));
+  }
+
+  /// Creates a field associated with the cells of the named cell set.
+  ///
+  VTKM_CONT_EXPORT
+  Field(const std::string &name,
+        const std::string &cellSetName,
+        const vtkm::cont::DynamicArrayHandle &data)
+    : Name(name),
+      Association(ASSOC_CELL_SET),
+      AssocCellSetName(cellSetName),
+      Data(data) {  }
+
+  VTKM_CONT_EXPORT
+  const std::string &GetName() const { return this->Name; }
+
+  VTKM_CONT_EXPORT
+  AssociationEnum GetAssociation() const { return this->Association; }
+
+  /// The name of the cell set this field is associated with. Empty unless
+  /// the association is ASSOC_CELL_SET.
+  ///
+  VTKM_CONT_EXPORT
+  const std::string &GetAssocCellSet() const
+  {
+    return this->AssocCellSetName;
+  }
+
+  VTKM_CONT_EXPORT
+  const vtkm::cont::DynamicArrayHandle &GetData() const { return this->Data; }
+
+  /// Replaces the array of this field. Other copies of the field keep the
+  /// previous array.
+  ///
+  VTKM_CONT_EXPORT
+  void SetData(const vtkm::cont::DynamicArrayHandle &data)
+  {
+    this->Data = data;
+  }
+
+  /// Returns the range of each component of the field's values, computed
+  /// with vtkm::cont::ComputeRange on the given device.
+  ///
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  std::vector<vtkm::Range> GetRange(DeviceAdapterTag) const
+  {
+    return this->GetRange(DeviceAdapterTag(),
+                          VTKM_DEFAULT_TYPE_LIST_TAG(),
+                          VTKM_DEFAULT_STORAGE_LIST_TAG());
+  }
+
+  /// A version of GetRange that tries the given lists of value types and
+  /// storage types when resolving the array.
+  ///
+  template<typename DeviceAdapterTag, typename TypeList, typename StorageList>
+  VTKM_CONT_EXPORT
+  std::vector<vtkm::Range> GetRange(DeviceAdapterTag,
+                                    TypeList,
+                                    StorageList) const
+  {
+    std::vector<vtkm::Range> ranges;
+    this->Data.CastAndCall(
+          internal::FieldRangeFunctor<DeviceAdapterTag>(&ranges),
+          TypeList(),
+          StorageList());
+    return ranges;
+  }
+
+private:
+  std::string Name;
+  AssociationEnum Association;
+  std::string AssocCellSetName;
+  vtkm::cont::DynamicArrayHandle Data;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_Field_h
@@ -0,0 +1,446 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_TaskGraph_h
+#define vtk_m_cont_TaskGraph_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <boost/smart_ptr/shared_ptr.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef VTKM_USE_STD_THREAD
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace vtkm {
+namespace cont {
+
+namespace internal {
+
+/// \brief Base class for the tasks held by a TaskGraph.
+///
+struct TaskGraphTaskBase
+{
+  virtual ~TaskGraphTaskBase() {  }
+  virtual void Execute() const = 0;
+};
+
+template<typename TaskType>
+struct TaskGraphTask : public TaskGraphTaskBase
+{
+  TaskType Task;
+
+  VTKM_CONT_EXPORT
+  TaskGraphTask(const TaskType &task) : Task(task) {  }
+
+  VTKM_CONT_EXPORT
+  virtual void Execute() const { this->Task(); }
+};
+
+/// \brief Base class for the arrays that tasks of a TaskGraph use.
+///
+/// Array handles of different types never share data, so two holders refer to
+/// the same array only if they hold the same type of handle and the handles
+/// are equal.
+///
+struct TaskGraphArrayBase
+{
+  virtual ~TaskGraphArrayBase() {  }
+  virtual bool IsSameArray(const TaskGraphArrayBase &other) const = 0;
+  virtual void PrepareForInput() const = 0;
+};
+
+template<typename ArrayHandleType>
+struct TaskGraphArray : public TaskGraphArrayBase
+{
+  ArrayHandleType Array;
+
+  VTKM_CONT_EXPORT
+  TaskGraphArray(const ArrayHandleType &array) : Array(array) {  }
+
+  VTKM_CONT_EXPORT
+  virtual bool IsSameArray(const TaskGraphArrayBase &other) const
+  {
+    const TaskGraphArray<ArrayHandleType> *otherArray =
+        dynamic_cast<const TaskGraphArray<ArrayHandleType> *>(&other);
+    return ((otherArray != NULL) && (otherArray->Array == this->Array));
+  }
+
+  VTKM_CONT_EXPORT
+  virtual void PrepareForInput() const
+  {
+    this->Array.PrepareForInput(VTKM_DEFAULT_DEVICE_ADAPTER_TAG());
+  }
+};
+
+#ifdef VTKM_USE_STD_THREAD
+
+/// \brief Runs the tasks of one wave of a TaskGraph on a set of threads.
+///
+/// Each thread takes the next task that has not been started until all are
+/// taken. The first exception a task throws is kept, and no tasks are
+/// started after it.
+///
+class TaskGraphWaveRunner
+{
+public:
+  VTKM_CONT_EXPORT
+  TaskGraphWaveRunner(const std::vector<const TaskGraphTaskBase *> &tasks)
+    : Tasks(tasks), NextTask(0), Failed(false) {  }
+
+  VTKM_CONT_EXPORT
+  void Run(std::size_t numThreads)
+  {
+    std::vector<std::thread> threads;
+    for (std::size_t index = 1; index < numThreads; index++)
+    {
+      threads.push_back(std::thread(&TaskGraphWaveRunner::Work, this));
+    }
+    // The calling thread works too, so it is not left idle.
+    this->Work();
+    for (std::size_t index = 0; index < threads.size(); index++)
+    {
+      threads[index].join();
+    }
+
+    if (this->Error)
+    {
+      std::rethrow_exception(this->Error);
+    }
+  }
+
+private:
+  std::vector<const TaskGraphTaskBase *> Tasks;
+  std::atomic<std::size_t> NextTask;
+  std::atomic<bool> Failed;
+  std::mutex ErrorLock;
+  std::exception_ptr Error;
+
+  VTKM_CONT_EXPORT
+  void Work()
+  {
+    while (!this->Failed)
+    {
+      std::size_t index = this->NextTask++;
+      if (index >= this->Tasks.size()) { return; }
+      try
+      {
+        this->Tasks[index]->Execute();
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(this->ErrorLock);
+        if (!this->Error)
+        {
+          this->Error = std::current_exception();
+        }
+        this->Failed = true;
+      }
+    }
+  }
+};
+
+#endif //VTKM_USE_STD_THREAD
+
+} // namespace internal
+
+/// \brief Runs a set of tasks in an order that respects their data
+/// dependencies.
+///
+/// Each task is a functor with an operator() const that runs in the control
+/// environment, usually calling device adapter algorithms or dispatching
+/// worklets. Along with each task, declare the ArrayHandles it reads with
+/// AddInput and the ones it writes with AddOutput. A task depends on an
+/// earlier task (in the order they were added) if one of them writes an array
+/// that the other reads or writes. Tasks that do not depend on each other
+/// may run in any order.
+///
+/// Execute groups the tasks into waves. Every task in a wave depends only on
+/// tasks in earlier waves, so the tasks of one wave are independent of each
+/// other (for example, different fields derived from the same input). The
+/// waves are run in order. When the C++11 thread library is available
+/// (VTKM_USE_STD_THREAD), the tasks of a wave run concurrently on a pool of
+/// threads that is joined before the next wave starts. Otherwise they run
+/// one after another in the order they were added. The pool has at most
+/// SetNumberOfThreads threads, one per hardware thread by default. Tasks
+/// usually call algorithms that are themselves parallel, so lower it to
+/// avoid oversubscribing the device.
+///
+/// Arrays that several tasks of a wave read are prepared for input on the
+/// default device adapter before the wave starts, so the concurrent tasks
+/// only read the state of those handles.
+///
+/// Arrays are matched by identity, so declare the handles that actually hold
+/// data. For example, a task that reads an ArrayHandleTransform should
+/// declare the array that the transform reads.
+///
+class TaskGraph
+{
+public:
+  VTKM_CONT_EXPORT
+  TaskGraph() : NumberOfThreads(0) {  }
+
+  /// The most threads that run the tasks of a wave. 0 (the default) uses one
+  /// thread per hardware thread, and 1 runs the tasks one after another.
+  ///
+  VTKM_CONT_EXPORT
+  void SetNumberOfThreads(vtkm::IdComponent numThreads)
+  {
+    if (numThreads < 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Number of task graph threads is negative.");
+    }
+    this->NumberOfThreads = numThreads;
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::IdComponent GetNumberOfThreads() const
+  {
+    return this->NumberOfThreads;
+  }
+
+  /// Adds a task to the graph and returns its index, which is used to declare
+  /// the arrays of the task.
+  ///
+  template<typename TaskType>
+  VTKM_CONT_EXPORT
+  vtkm::Id AddTask(const TaskType &task)
+  {
+    TaskEntry entry;
+    entry.Task.reset(new internal::TaskGraphTask<TaskType>(task));
+    this->Tasks.push_back(entry);
+    return static_cast<vtkm::Id>(this->Tasks.size()) - 1;
+  }
+
+  /// Declares that the given task reads the data in \c array.
+  ///
+  template<typename T, typename StorageTag>
+  VTKM_CONT_EXPORT
+  void AddInput(vtkm::Id taskIndex,
+                const vtkm::cont::ArrayHandle<T,StorageTag> &array)
+  {
+    this->GetTaskEntry(taskIndex).Inputs.push_back(
+          ArrayPointer(new internal::TaskGraphArray<
+                         vtkm::cont::ArrayHandle<T,StorageTag> >(array)));
+  }
+
+  /// Declares that the given task writes (or reads and writes) the data in \c
+  /// array.
+  ///
+  template<typename T, typename StorageTag>
+  VTKM_CONT_EXPORT
+  void AddOutput(vtkm::Id taskIndex,
+                 const vtkm::cont::ArrayHandle<T,StorageTag> &array)
+  {
+    this->GetTaskEntry(taskIndex).Outputs.push_back(
+          ArrayPointer(new internal::TaskGraphArray<
+                         vtkm::cont::ArrayHandle<T,StorageTag> >(array)));
+  }
+
+  /// Returns the number of tasks added to the graph.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfTasks() const
+  {
+    return static_cast<vtkm::Id>(this->Tasks.size());
+  }
+
+  /// Returns true if the task \c taskIndex must run after the task \c
+  /// otherIndex because of the arrays they use.
+  ///
+  VTKM_CONT_EXPORT
+  bool DependsOn(vtkm::Id taskIndex, vtkm::Id otherIndex) const
+  {
+    const TaskEntry &task = this->GetTaskEntry(taskIndex);
+    const TaskEntry &other = this->GetTaskEntry(otherIndex);
+    if (otherIndex >= taskIndex) { return false; }
+
+    return (Overlap(other.Outputs, task.Inputs)
+            || Overlap(other.Outputs, task.Outputs)
+            || Overlap(other.Inputs, task.Outputs));
+  }
+
+  /// Groups the tasks into waves of independent tasks. Every task in a wave
+  /// depends only on tasks in earlier waves, and each task is placed in the
+  /// earliest wave it can run in. Within a wave, tasks are in the order they
+  /// were added.
+  ///
+  VTKM_CONT_EXPORT
+  std::vector<std::vector<vtkm::Id> > GetWaves() const
+  {
+    vtkm::Id numTasks = this->GetNumberOfTasks();
+    std::vector<vtkm::Id> taskWave(static_cast<std::size_t>(numTasks), 0);
+    vtkm::Id numWaves = 0;
+    for (vtkm::Id taskIndex = 0; taskIndex < numTasks; taskIndex++)
+    {
+      vtkm::Id wave = 0;
+      for (vtkm::Id otherIndex = 0; otherIndex < taskIndex; otherIndex++)
+      {
+        if (this->DependsOn(taskIndex, otherIndex))
+        {
+          wave = std::max(wave,
+                          taskWave[static_cast<std::size_t>(otherIndex)] + 1);
+        }
+      }
+      taskWave[static_cast<std::size_t>(taskIndex)] = wave;
+      numWaves = std::max(numWaves, wave + 1);
+    }
+
+    std::vector<std::vector<vtkm::Id> > waves(
+          static_cast<std::size_t>(numWaves));
+    for (vtkm::Id taskIndex = 0; taskIndex < numTasks; taskIndex++)
+    {
+      waves[static_cast<std::size_t>(
+            taskWave[static_cast<std::size_t>(taskIndex)])].push_back(
+            taskIndex);
+    }
+    return waves;
+  }
+
+  /// Runs all the tasks, one wave at a time. If a task throws an exception,
+  /// the exception is passed on once the tasks of its wave that already
+  /// started have finished, and no other tasks are started.
+  ///
+  VTKM_CONT_EXPORT
+  void Execute() const
+  {
+    std::vector<std::vector<vtkm::Id> > waves = this->GetWaves();
+    for (std::size_t waveIndex = 0; waveIndex < waves.size(); waveIndex++)
+    {
+      this->ExecuteWave(waves[waveIndex]);
+    }
+  }
+
+private:
+  typedef boost::shared_ptr<internal::TaskGraphArrayBase> ArrayPointer;
+
+  struct TaskEntry
+  {
+    boost::shared_ptr<internal::TaskGraphTaskBase> Task;
+    std::vector<ArrayPointer> Inputs;
+    std::vector<ArrayPointer> Outputs;
+  };
+
+  std::vector<TaskEntry> Tasks;
+  vtkm::IdComponent NumberOfThreads;
+
+  VTKM_CONT_EXPORT
+  void ExecuteWave(const std::vector<vtkm::Id> &wave) const
+  {
+#ifdef VTKM_USE_STD_THREAD
+    std::size_t numThreads = static_cast<std::size_t>(this->NumberOfThreads);
+    if (numThreads == 0)
+    {
+      numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    numThreads = std::min(numThreads, wave.size());
+    if (numThreads > 1)
+    {
+      this->PrepareSharedInputs(wave);
+      std::vector<const internal::TaskGraphTaskBase *> tasks;
+      for (std::size_t index = 0; index < wave.size(); index++)
+      {
+        tasks.push_back(this->GetTaskEntry(wave[index]).Task.get());
+      }
+      internal::TaskGraphWaveRunner(tasks).Run(numThreads);
+      return;
+    }
+#endif //VTKM_USE_STD_THREAD
+
+    for (std::size_t index = 0; index < wave.size(); index++)
+    {
+      this->GetTaskEntry(wave[index]).Task->Execute();
+    }
+  }
+
+  // Preparing an array for input the first time changes the state of the
+  // handle, so it is done here for the arrays that more than one task of the
+  // wave reads rather than by the tasks at the same time.
+  VTKM_CONT_EXPORT
+  void PrepareSharedInputs(const std::vector<vtkm::Id> &wave) const
+  {
+    for (std::size_t index = 0; index < wave.size(); index++)
+    {
+      const std::vector<ArrayPointer> &inputs =
+          this->GetTaskEntry(wave[index]).Inputs;
+      for (std::size_t inputIndex = 0; inputIndex < inputs.size(); inputIndex++)
+      {
+        for (std::size_t other = index + 1; other < wave.size(); other++)
+        {
+          std::vector<ArrayPointer> input(1, inputs[inputIndex]);
+          if (Overlap(input, this->GetTaskEntry(wave[other]).Inputs))
+          {
+            inputs[inputIndex]->PrepareForInput();
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  VTKM_CONT_EXPORT
+  static bool Overlap(const std::vector<ArrayPointer> &arrays1,
+                      const std::vector<ArrayPointer> &arrays2)
+  {
+    for (std::size_t index1 = 0; index1 < arrays1.size(); index1++)
+    {
+      for (std::size_t index2 = 0; index2 < arrays2.size(); index2++)
+      {
+        if (arrays1[index1]->IsSameArray(*arrays2[index2])) { return true; }
+      }
+    }
+    return false;
+  }
+
+  VTKM_CONT_EXPORT
+  TaskEntry &GetTaskEntry(vtkm::Id taskIndex)
+  {
+    if ((taskIndex < 0) || (taskIndex >= this->GetNumberOfTasks()))
+    {
+      throw vtkm::cont::ErrorControlBadValue("Invalid task index.");
+    }
+    return this->Tasks[static_cast<std::size_t>(taskIndex)];
+  }
+
+  VTKM_CONT_EXPORT
+  const TaskEntry &GetTaskEntry(vtkm::Id taskIndex) const
+  {
+    if ((taskIndex < 0) || (taskIndex >= this->GetNumberOfTasks()))
+    {
+      throw vtkm::cont::ErrorControlBadValue("Invalid task index.");
+    }
+    return this->Tasks[static_cast<std::size_t>(taskIndex)];
+  }
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_TaskGraph_h
@@ -21,6 +21,21 @@
 #define vtk_m_cont_Timer_h
 
 #include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/SystemClock.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define VTKM_TIMER_HAS_CYCLE_COUNTER
+#elif (defined(__GNUC__) || defined(__clang__)) \
+  && (defined(__i386__) || defined(__x86_64__))
+#include <x86intrin.h>
+#define VTKM_TIMER_HAS_CYCLE_COUNTER
+#endif
 
 namespace vtkm {
 namespace cont {
@@ -30,8 +45,14 @@ namespace cont {
 /// matches that being used to execute algorithms to ensure that the thread
 /// synchronization is correct.
 ///
-/// The there is no guaranteed resolution of the time but should generally be
-/// good to about a millisecond.
+/// The wall time is taken from a monotonic clock, which has a resolution of
+/// nanoseconds on most systems.
+///
+/// The timer can also record laps. Each call to Lap records the time elapsed
+/// since the previous lap (or since the last Reset). This makes it possible to
+/// time many iterations of the same operation with a single timer and then
+/// query the minimum, maximum, median, mean, and standard deviation of the
+/// lap times.
 ///
 template<class Device = VTKM_DEFAULT_DEVICE_ADAPTER_TAG>
 class Timer
@@ -41,16 +62,27 @@ public:
   /// current time is marked so that GetElapsedTime returns the number of
   /// seconds elapsed since the construction.
   VTKM_CONT_EXPORT
-  Timer() : TimerImplementation() {  }
+  Timer() : TimerImplementation()
+  {
+    this->LastLapTime = 0.0;
+    this->StartCPUTime = GetCurrentCPUTime();
+    this->StartCycles = GetCurrentCycles();
+  }
 
   /// Resets the timer. All further calls to GetElapsedTime will report the
   /// number of seconds elapsed since the call to this. This method
   /// synchronizes all asynchronous operations.
   ///
+  /// Recorded laps are not removed by Reset, but the next lap will be
+  /// measured from this call. Use ClearLaps to remove recorded laps.
+  ///
   VTKM_CONT_EXPORT
   void Reset()
   {
     this->TimerImplementation.Reset();
+    this->LastLapTime = 0.0;
+    this->StartCPUTime = GetCurrentCPUTime();
+    this->StartCycles = GetCurrentCycles();
   }
 
   /// Returns the elapsed time in seconds between the construction of this
@@ -65,16 +97,200 @@ public:
     return this->TimerImplementation.GetElapsedTime();
   }
 
+  /// Returns the processor time in seconds used by this process between the
+  /// construction of this class or the last call to Reset and the time this
+  /// function is called. Comparing this to GetElapsedTime helps separate time
+  /// spent computing on the host from time spent waiting (for example on
+  /// memory or another device). Note that processor time is summed over all
+  /// threads of the process.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetElapsedCPUTime()
+  {
+    vtkm::cont::DeviceAdapterAlgorithm<Device>::Synchronize();
+    return GetCurrentCPUTime() - this->StartCPUTime;
+  }
+
+  /// Returns the number of processor time stamp counter ticks between the
+  /// construction of this class or the last call to Reset and the time this
+  /// function is called. The counter is only available on x86 processors. On
+  /// other processors this method always returns 0 (which can be checked with
+  /// HasCycleCounter).
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Int64 GetElapsedCycles()
+  {
+    vtkm::cont::DeviceAdapterAlgorithm<Device>::Synchronize();
+    return GetCurrentCycles() - this->StartCycles;
+  }
+
+  /// Returns true if GetElapsedCycles reports a real cycle counter on this
+  /// platform.
+  ///
+  VTKM_CONT_EXPORT
+  static bool HasCycleCounter()
+  {
+#ifdef VTKM_TIMER_HAS_CYCLE_COUNTER
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /// Records a lap. The lap time is the wall time in seconds since the
+  /// previous call to Lap or, if there was none, since the construction of
+  /// this class or the last call to Reset. The lap time is returned. This
+  /// method synchronizes all asynchronous operations.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 Lap()
+  {
+    vtkm::Float64 elapsedTime = this->GetElapsedTime();
+    vtkm::Float64 lapTime = elapsedTime - this->LastLapTime;
+    this->LastLapTime = elapsedTime;
+    this->LapTimes.push_back(lapTime);
+    return lapTime;
+  }
+
+  /// Removes all recorded laps.
+  ///
+  VTKM_CONT_EXPORT
+  void ClearLaps()
+  {
+    this->LapTimes.clear();
+  }
+
+  /// Returns the number of laps recorded since construction or the last call
+  /// to ClearLaps.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfLaps() const
+  {
+    return static_cast<vtkm::Id>(this->LapTimes.size());
+  }
+
+  /// Returns the time in seconds of the lap with the given index.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetLapTime(vtkm::Id lapIndex) const
+  {
+    if ((lapIndex < 0) || (lapIndex >= this->GetNumberOfLaps()))
+    {
+      throw vtkm::cont::ErrorControlBadValue("Invalid lap index.");
+    }
+    return this->LapTimes[static_cast<std::size_t>(lapIndex)];
+  }
+
+  /// Returns the shortest recorded lap time in seconds.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetMinimumLapTime() const
+  {
+    this->CheckHasLaps();
+    return *std::min_element(this->LapTimes.begin(), this->LapTimes.end());
+  }
+
+  /// Returns the longest recorded lap time in seconds.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetMaximumLapTime() const
+  {
+    this->CheckHasLaps();
+    return *std::max_element(this->LapTimes.begin(), this->LapTimes.end());
+  }
+
+  /// Returns the median of the recorded lap times in seconds. The median is
+  /// less sensitive to the occasional slow outlier (caused by, for example,
+  /// the operating system) than the mean.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetMedianLapTime() const
+  {
+    this->CheckHasLaps();
+    std::vector<vtkm::Float64> sortedTimes(this->LapTimes);
+    std::sort(sortedTimes.begin(), sortedTimes.end());
+    std::size_t middle = sortedTimes.size()/2;
+    if ((sortedTimes.size() % 2) == 1)
+    {
+      return sortedTimes[middle];
+    }
+    else
+    {
+      return 0.5*(sortedTimes[middle-1] + sortedTimes[middle]);
+    }
+  }
+
+  /// Returns the mean of the recorded lap times in seconds.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetMeanLapTime() const
+  {
+    this->CheckHasLaps();
+    vtkm::Float64 sum = 0.0;
+    for (std::size_t lapIndex = 0; lapIndex < this->LapTimes.size(); lapIndex++)
+    {
+      sum += this->LapTimes[lapIndex];
+    }
+    return sum/vtkm::Float64(this->LapTimes.size());
+  }
+
+  /// Returns the (population) standard deviation of the recorded lap times in
+  /// seconds.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetLapTimeStandardDeviation() const
+  {
+    vtkm::Float64 mean = this->GetMeanLapTime();
+    vtkm::Float64 sumSquares = 0.0;
+    for (std::size_t lapIndex = 0; lapIndex < this->LapTimes.size(); lapIndex++)
+    {
+      vtkm::Float64 difference = this->LapTimes[lapIndex] - mean;
+      sumSquares += difference*difference;
+    }
+    return std::sqrt(sumSquares/vtkm::Float64(this->LapTimes.size()));
+  }
+
 private:
   /// Some timers are ill-defined when copied, so disallow that for all timers.
   VTKM_CONT_EXPORT Timer(const Timer<Device> &);  // Not implemented.
   VTKM_CONT_EXPORT void operator=(const Timer<Device> &); // Not implemented.
 
+  VTKM_CONT_EXPORT
+  void CheckHasLaps() const
+  {
+    if (this->LapTimes.empty())
+    {
+      throw vtkm::cont::ErrorControlBadValue("Timer has no recorded laps.");
+    }
+  }
+
+  VTKM_CONT_EXPORT
+  static vtkm::Float64 GetCurrentCPUTime()
+  {
+    return vtkm::cont::internal::SystemClockProcessCPUTime();
+  }
+
+  VTKM_CONT_EXPORT
+  static vtkm::Int64 GetCurrentCycles()
+  {
+#ifdef VTKM_TIMER_HAS_CYCLE_COUNTER
+    return static_cast<vtkm::Int64>(__rdtsc());
+#else
+    return 0;
+#endif
+  }
+
   vtkm::cont::DeviceAdapterTimerImplementation<Device>
       TimerImplementation;
+  vtkm::Float64 StartCPUTime;
+  vtkm::Int64 StartCycles;
+  vtkm::Float64 LastLapTime;
+  std::vector<vtkm::Float64> LapTimes;
 };
 
 }
 } // namespace vtkm::cont
 
+#undef VTKM_TIMER_HAS_CYCLE_COUNTER
+
 #endif //vtk_m_cont_Timer_h
@@ -0,0 +1,121 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_internal_ArrayPortalAtomic_h
+#define vtk_m_cont_internal_ArrayPortalAtomic_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayPortalToIterators.h>
+
+#include <vtkm/exec/internal/AtomicOperations.h>
+
+namespace vtkm {
+namespace cont {
+namespace internal {
+
+/// \brief An execution portal whose values can be changed atomically.
+///
+/// Wraps the in-place execution portal of an array of 32 or 64 bit integers
+/// and adds Add and CompareAndSwap, which are done with the primitives of
+/// AtomicOperations.h on the storage of the value. Kernels that coordinate
+/// through an array (counters, cursors, hash table slots, union-find
+/// parents) hold one of these instead of a pointer into the array.
+///
+/// Get and Set read and write the value through a volatile reference, so a
+/// loop that waits for another instance to change a value sees the change.
+/// They are not ordered with respect to other memory operations; use the
+/// result of Add or CompareAndSwap to publish data written elsewhere.
+///
+template<typename T, typename DeviceAdapterTag>
+class ArrayPortalAtomic
+{
+public:
+  typedef T ValueType;
+  typedef typename vtkm::cont::ArrayHandle<T>
+      ::template ExecutionTypes<DeviceAdapterTag>::Portal PortalType;
+
+  VTKM_CONT_EXPORT
+  ArrayPortalAtomic() {  }
+
+  /// Prepares \c array for in place use on the device.
+  ///
+  VTKM_CONT_EXPORT
+  ArrayPortalAtomic(vtkm::cont::ArrayHandle<T> &array)
+    : Portal(array.PrepareForInPlace(DeviceAdapterTag())) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfValues() const
+  {
+    return this->Portal.GetNumberOfValues();
+  }
+
+  VTKM_EXEC_EXPORT
+  ValueType Get(vtkm::Id index) const
+  {
+    return *static_cast<volatile ValueType *>(this->GetAddress(index));
+  }
+
+  VTKM_EXEC_EXPORT
+  void Set(vtkm::Id index, const ValueType &value) const
+  {
+    *static_cast<volatile ValueType *>(this->GetAddress(index)) = value;
+  }
+
+  /// Atomically adds \c value to the value at \c index and returns the
+  /// value before the addition.
+  ///
+  VTKM_EXEC_EXPORT
+  ValueType Add(vtkm::Id index, const ValueType &value) const
+  {
+    return vtkm::exec::internal::AtomicAdd(this->GetAddress(index), value);
+  }
+
+  /// Atomically replaces the value at \c index with \c newValue if it equals
+  /// \c expected. Returns the value before the operation, so the swap
+  /// happened if and only if the result equals \c expected.
+  ///
+  VTKM_EXEC_EXPORT
+  ValueType CompareAndSwap(vtkm::Id index,
+                           const ValueType &expected,
+                           const ValueType &newValue) const
+  {
+    return vtkm::exec::internal::AtomicCompareAndSwap(
+          this->GetAddress(index), expected, newValue);
+  }
+
+private:
+  PortalType Portal;
+
+  // The devices so far share memory with the control environment, and their
+  // portals iterate over the array itself. A device with separate memory
+  // needs to find the address in its own way.
+  VTKM_EXEC_EXPORT
+  ValueType *GetAddress(vtkm::Id index) const
+  {
+    return &*(vtkm::cont::ArrayPortalToIteratorBegin(this->Portal) + index);
+  }
+};
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_ArrayPortalAtomic_h
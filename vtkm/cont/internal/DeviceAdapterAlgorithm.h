@@ -24,15 +24,7 @@
 
 #include <vtkm/cont/internal/ArrayManagerExecution.h>
 #include <vtkm/cont/internal/DeviceAdapterTag.h>
-
-#ifdef _WIN32
-#include <sys/timeb.h>
-#include <sys/types.h>
-#else //!_WIN32
-#include <limits.h>
-#include <sys/time.h>
-#include <unistd.h>
-#endif
+#include <vtkm/cont/internal/SystemClock.h>
 
 namespace vtkm {
 namespace cont {
@@ -48,6 +40,28 @@ template<class DeviceAdapterTag>
 struct DeviceAdapterAlgorithm
 #ifdef VTKM_DOXYGEN_ONLY
 {
+  /// \brief Returns true if \c predicate holds for every value in \c input.
+  ///
+  /// Stops scheduling work as soon as a value fails the predicate. \c
+  /// predicate must have a const <tt>bool operator()(const T &)</tt> that can
+  /// be called in the execution environment. Returns true for an empty array.
+  ///
+  template<typename T, class CIn, class UnaryPredicate>
+  VTKM_CONT_EXPORT static bool AllOf(
+      const vtkm::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      UnaryPredicate predicate);
+
+  /// \brief Returns true if \c predicate holds for any value in \c input.
+  ///
+  /// Stops scheduling work as soon as a value passes the predicate. \c
+  /// predicate must have a const <tt>bool operator()(const T &)</tt> that can
+  /// be called in the execution environment. Returns false for an empty array.
+  ///
+  template<typename T, class CIn, class UnaryPredicate>
+  VTKM_CONT_EXPORT static bool AnyOf(
+      const vtkm::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      UnaryPredicate predicate);
+
   /// \brief Copy the contents of one ArrayHandle to another
   ///
   /// Copies the contents of \c input to \c output. The array \c to will be
@@ -58,6 +72,18 @@ struct DeviceAdapterAlgorithm
       const vtkm::cont::ArrayHandle<T, CIn, DeviceAdapterTag> &input,
       vtkm::cont::ArrayHandle<T, COut, DeviceAdapterTag> &output);
 
+  /// \brief Returns the index of the first value in \c input that satisfies
+  /// \c predicate, or -1 if there is none.
+  ///
+  /// Stops scheduling work once a match is found. Matches with a higher index
+  /// than the first may or may not be evaluated, so \c predicate should not
+  /// have side effects.
+  ///
+  template<typename T, class CIn, class UnaryPredicate>
+  VTKM_CONT_EXPORT static vtkm::Id FindFirst(
+      const vtkm::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      UnaryPredicate predicate);
+
   /// \brief Output is the first index in input for each item in values that wouldn't alter the ordering of input
   ///
   /// LowerBounds is a vectorized search. From each value in \c values it finds
@@ -102,6 +128,39 @@ struct DeviceAdapterAlgorithm
       const vtkm::cont::ArrayHandle<vtkm::Id,CIn,DeviceAdapterTag>& input,
       vtkm::cont::ArrayHandle<vtkm::Id,COut,DeviceAdapterTag>& values_output);
 
+  /// \brief Compute the sum of all the values in the input ArrayHandle.
+  ///
+  /// Adds together all the values in \c input and \c initialValue and
+  /// returns the result. Like the scans, the summation order is not defined,
+  /// so a custom plus operator for T must be associative. No array the size
+  /// of the input is written (at most a small array of partial sums), so
+  /// reducing an implicit or transformed array (such as an
+  /// ArrayHandleTransform) computes the values as they are summed.
+  ///
+  /// \return The total sum.
+  ///
+  template<typename T, class CIn>
+  VTKM_CONT_EXPORT static T Reduce(
+      const vtkm::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      T initialValue);
+
+  /// \brief Combine all the values in the input ArrayHandle with a functor.
+  ///
+  /// Like the other form of Reduce, except that values are combined with
+  /// <tt>binary_functor(a, b)</tt> instead of addition. \c binary_functor
+  /// must be associative (but need not be commutative), and \c initialValue
+  /// is combined with the values once, so it should be an identity of the
+  /// operation. Several quantities can be reduced in a single pass by
+  /// reducing a structure that holds them all.
+  ///
+  /// \return The combined value.
+  ///
+  template<typename T, class CIn, class BinaryFunctor>
+  VTKM_CONT_EXPORT static T Reduce(
+      const vtkm::cont::ArrayHandle<T,CIn,DeviceAdapterTag> &input,
+      T initialValue,
+      BinaryFunctor binary_functor);
+
   /// \brief Compute an inclusive prefix sum operation on the input ArrayHandle.
   ///
   /// Computes an inclusive prefix sum operation on the \c input ArrayHandle,
@@ -153,6 +212,19 @@ struct DeviceAdapterAlgorithm
   /// instance of the invocation. There should be one invocation for each index
   /// in the range [0, \c numInstances].
   ///
+  /// Once an instance raises an error, the device adapter may stop invoking
+  /// the remaining instances. The thrown ErrorExecution carries the message of
+  /// the first error raised along with the number of errors raised and, when
+  /// known, the index of the instance that raised the message.
+  ///
+  /// The functor can also cancel execution through the error message buffer
+  /// (see vtkm::exec::FunctorBase::Cancel). The device adapter checks for
+  /// cancellation between the chunks of instances it dispatches and does not
+  /// start any more chunks once it is set. Chunks are dispatched in order of
+  /// increasing index, so every instance with an index lower than that of a
+  /// cancelling instance still runs. Cancelling without an error returns
+  /// from Schedule normally.
+  ///
   template<class Functor>
   VTKM_CONT_EXPORT static void Schedule(Functor functor,
                                         vtkm::Id numInstances);
@@ -354,35 +426,30 @@ public:
     vtkm::Float64 elapsedTime;
     elapsedTime = vtkm::Float64(currentTime.Seconds - this->StartTime.Seconds);
     elapsedTime +=
-      (vtkm::Float64(currentTime.Microseconds - this->StartTime.Microseconds)
-       /vtkm::Float64(1000000));
+      (vtkm::Float64(currentTime.Nanoseconds - this->StartTime.Nanoseconds)
+       /vtkm::Float64(1000000000));
 
     return elapsedTime;
   }
   struct TimeStamp
   {
     vtkm::Int64 Seconds;
-    vtkm::Int64 Microseconds;
+    vtkm::Int64 Nanoseconds;
   };
   TimeStamp StartTime;
 
+  /// Returns the current time from a monotonic clock (one that is never
+  /// adjusted backward by changes to the system time). The resolution is
+  /// nanoseconds where the operating system supports it.
+  ///
   VTKM_CONT_EXPORT TimeStamp GetCurrentTime()
   {
     vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
         ::Synchronize();
 
     TimeStamp retval;
-#ifdef _WIN32
-    timeb currentTime;
-    ::ftime(&currentTime);
-    retval.Seconds = currentTime.time;
-    retval.Microseconds = 1000*currentTime.millitm;
-#else
-    timeval currentTime;
-    gettimeofday(&currentTime, NULL);
-    retval.Seconds = currentTime.tv_sec;
-    retval.Microseconds = currentTime.tv_usec;
-#endif
+    vtkm::cont::internal::SystemClockMonotonic(retval.Seconds,
+                                               retval.Nanoseconds);
     return retval;
   }
 };
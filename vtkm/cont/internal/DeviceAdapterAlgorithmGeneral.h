@@ -24,6 +24,7 @@
 #include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/ArrayPortalToIterators.h>
 #include <vtkm/cont/StorageBasic.h>
+#include <vtkm/cont/internal/ArrayPortalAtomic.h>
 
 #include <vtkm/exec/FunctorBase.h>
 
@@ -180,6 +181,110 @@ public:
     DerivedAlgorithm::Schedule(kernel, arraySize);
   }
 
+  //--------------------------------------------------------------------------
+  // Find First, Any Of, All Of
+private:
+  template<class InputPortalType, class UnaryPredicate, class ResultPortalType>
+  struct FindFirstKernel : vtkm::exec::FunctorBase
+  {
+    InputPortalType InputPortal;
+    UnaryPredicate Predicate;
+    ResultPortalType ResultPortal;
+    bool Target;
+
+    VTKM_CONT_EXPORT
+    FindFirstKernel(InputPortalType inputPortal,
+                    UnaryPredicate predicate,
+                    ResultPortalType resultPortal,
+                    bool target)
+      : InputPortal(inputPortal),
+        Predicate(predicate),
+        ResultPortal(resultPortal),
+        Target(target) {  }
+
+    VTKM_EXEC_EXPORT
+    void operator()(vtkm::Id index) const
+    {
+      if (static_cast<bool>(this->Predicate(this->InputPortal.Get(index)))
+          != this->Target)
+      {
+        return;
+      }
+
+      // The device adapter dispatches chunks in increasing index order and
+      // stops dispatching once cancelled, so every lower index has been (or
+      // is being) checked. Instances in chunks that run concurrently may
+      // find matches at the same time, so the smallest index is kept with a
+      // compare and swap loop.
+      vtkm::Id found = this->ResultPortal.Get(0);
+      while ((found < 0) || (index < found))
+      {
+        vtkm::Id previous =
+            this->ResultPortal.CompareAndSwap(0, found, index);
+        if (previous == found) { break; }
+        found = previous;
+      }
+      this->Cancel();
+    }
+  };
+
+  template<typename T, class CIn, class UnaryPredicate>
+  VTKM_CONT_EXPORT
+  static vtkm::Id FindFirstWithValue(const vtkm::cont::ArrayHandle<T,CIn> &input,
+                                     UnaryPredicate predicate,
+                                     bool target)
+  {
+    typedef vtkm::cont::ArrayHandle<vtkm::Id,vtkm::cont::StorageTagBasic>
+        ResultArrayType;
+    typedef typename vtkm::cont::ArrayHandle<T,CIn>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        InputPortalType;
+    typedef vtkm::cont::internal::ArrayPortalAtomic<vtkm::Id,DeviceAdapterTag>
+        ResultPortalType;
+
+    vtkm::Id arraySize = input.GetNumberOfValues();
+    if (arraySize <= 0) { return -1; }
+
+    const vtkm::Id notFound = -1;
+    ResultArrayType result;
+    DerivedAlgorithm::Copy(vtkm::cont::make_ArrayHandle(&notFound, 1), result);
+
+    FindFirstKernel<InputPortalType, UnaryPredicate, ResultPortalType>
+        kernel(input.PrepareForInput(DeviceAdapterTag()),
+               predicate,
+               ResultPortalType(result),
+               target);
+
+    DerivedAlgorithm::Schedule(kernel, arraySize);
+
+    return result.GetPortalConstControl().Get(0);
+  }
+
+public:
+  template<typename T, class CIn, class UnaryPredicate>
+  VTKM_CONT_EXPORT
+  static vtkm::Id FindFirst(const vtkm::cont::ArrayHandle<T,CIn> &input,
+                            UnaryPredicate predicate)
+  {
+    return FindFirstWithValue(input, predicate, true);
+  }
+
+  template<typename T, class CIn, class UnaryPredicate>
+  VTKM_CONT_EXPORT
+  static bool AnyOf(const vtkm::cont::ArrayHandle<T,CIn> &input,
+                    UnaryPredicate predicate)
+  {
+    return (DerivedAlgorithm::FindFirst(input, predicate) >= 0);
+  }
+
+  template<typename T, class CIn, class UnaryPredicate>
+  VTKM_CONT_EXPORT
+  static bool AllOf(const vtkm::cont::ArrayHandle<T,CIn> &input,
+                    UnaryPredicate predicate)
+  {
+    return (FindFirstWithValue(input, predicate, false) < 0);
+  }
+
   //--------------------------------------------------------------------------
   // Lower Bounds
 private:
@@ -329,6 +434,103 @@ public:
                                                         values_output);
   }
 
+  //--------------------------------------------------------------------------
+  // Reduce
+public:
+  template<typename T, class CIn>
+  VTKM_CONT_EXPORT static T Reduce(
+      const vtkm::cont::ArrayHandle<T,CIn> &input,
+      T initialValue)
+  {
+    return DerivedAlgorithm::Reduce(input, initialValue, vtkm::internal::Add());
+  }
+
+private:
+  // Each instance combines one contiguous chunk of the input.
+  template<class InputPortalType, class OutputPortalType, class BinaryFunctor>
+  struct ReduceKernel : vtkm::exec::FunctorBase
+  {
+    InputPortalType InputPortal;
+    OutputPortalType OutputPortal;
+    BinaryFunctor Functor;
+    vtkm::Id ChunkSize;
+
+    VTKM_CONT_EXPORT
+    ReduceKernel(const InputPortalType &inputPortal,
+                 const OutputPortalType &outputPortal,
+                 BinaryFunctor functor,
+                 vtkm::Id chunkSize)
+      : InputPortal(inputPortal),
+        OutputPortal(outputPortal),
+        Functor(functor),
+        ChunkSize(chunkSize)
+    {  }
+
+    VTKM_EXEC_EXPORT
+    void operator()(vtkm::Id chunk) const
+    {
+      typedef typename OutputPortalType::ValueType ValueType;
+
+      vtkm::Id begin = chunk*this->ChunkSize;
+      vtkm::Id end = begin + this->ChunkSize;
+      if (end > this->InputPortal.GetNumberOfValues())
+      {
+        end = this->InputPortal.GetNumberOfValues();
+      }
+
+      ValueType value = this->InputPortal.Get(begin);
+      for (vtkm::Id index = begin + 1; index < end; index++)
+      {
+        value = this->Functor(value, this->InputPortal.Get(index));
+      }
+      this->OutputPortal.Set(chunk, value);
+    }
+  };
+
+public:
+  template<typename T, class CIn, class BinaryFunctor>
+  VTKM_CONT_EXPORT static T Reduce(
+      const vtkm::cont::ArrayHandle<T,CIn> &input,
+      T initialValue,
+      BinaryFunctor binary_functor)
+  {
+    typedef vtkm::cont::ArrayHandle<T,vtkm::cont::StorageTagBasic>
+        TempArrayType;
+    typedef typename vtkm::cont::ArrayHandle<T,CIn>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        InputPortalType;
+    typedef typename TempArrayType
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal OutputPortalType;
+
+    // Chunks are long enough that the partial results are a small fraction
+    // of the input. The partial results are reduced the same way until only
+    // one is left.
+    const vtkm::Id CHUNK_SIZE = 1024;
+
+    vtkm::Id numValues = input.GetNumberOfValues();
+    if (numValues < 1) { return initialValue; }
+
+    vtkm::Id numChunks = (numValues + CHUNK_SIZE - 1)/CHUNK_SIZE;
+    TempArrayType partials;
+    InputPortalType inputPortal = input.PrepareForInput(DeviceAdapterTag());
+    OutputPortalType partialsPortal =
+        partials.PrepareForOutput(numChunks, DeviceAdapterTag());
+    DerivedAlgorithm::Schedule(
+          ReduceKernel<InputPortalType,OutputPortalType,BinaryFunctor>(
+            inputPortal, partialsPortal, binary_functor, CHUNK_SIZE),
+          numChunks);
+
+    if (numChunks > 1)
+    {
+      return DerivedAlgorithm::Reduce(partials, initialValue, binary_functor);
+    }
+    else
+    {
+      return binary_functor(initialValue,
+                            partials.GetPortalConstControl().Get(0));
+    }
+  }
+
   //--------------------------------------------------------------------------
   // Scan Exclusive
 private:
@@ -973,7 +1175,7 @@ public:
     UpperBoundsKernel<
         typename vtkm::cont::ArrayHandle<T,CIn>::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
         typename vtkm::cont::ArrayHandle<T,CVal>::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
-        typename vtkm::cont::ArrayHandle<T,COut>::template ExecutionTypes<DeviceAdapterTag>::Portal>
+        typename vtkm::cont::ArrayHandle<vtkm::Id,COut>::template ExecutionTypes<DeviceAdapterTag>::Portal>
         kernel(input.PrepareForInput(DeviceAdapterTag()),
                values.PrepareForInput(DeviceAdapterTag()),
                output.PrepareForOutput(arraySize, DeviceAdapterTag()));
@@ -993,7 +1195,7 @@ public:
     UpperBoundsKernelComparisonKernel<
         typename vtkm::cont::ArrayHandle<T,CIn>::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
         typename vtkm::cont::ArrayHandle<T,CVal>::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
-        typename vtkm::cont::ArrayHandle<T,COut>::template ExecutionTypes<DeviceAdapterTag>::Portal,
+        typename vtkm::cont::ArrayHandle<vtkm::Id,COut>::template ExecutionTypes<DeviceAdapterTag>::Portal,
         Compare>
         kernel(input.PrepareForInput(DeviceAdapterTag()),
                values.PrepareForInput(DeviceAdapterTag()),
@@ -29,7 +29,6 @@
 
 #include <vtkm/exec/internal/ErrorMessageBuffer.h>
 
-#include <boost/iterator/counting_iterator.hpp>
 #include <boost/utility/enable_if.hpp>
 
 #include <algorithm>
@@ -48,6 +47,36 @@ private:
   typedef vtkm::cont::DeviceAdapterTagSerial Device;
 
 public:
+  template<typename T, class CIn>
+  VTKM_CONT_EXPORT static T Reduce(
+      const vtkm::cont::ArrayHandle<T,CIn> &input,
+      T initialValue)
+  {
+    typedef typename vtkm::cont::ArrayHandle<T,CIn>
+        ::template ExecutionTypes<Device>::PortalConst PortalIn;
+
+    PortalIn inputPortal = input.PrepareForInput(Device());
+    return std::accumulate(vtkm::cont::ArrayPortalToIteratorBegin(inputPortal),
+                           vtkm::cont::ArrayPortalToIteratorEnd(inputPortal),
+                           initialValue);
+  }
+
+  template<typename T, class CIn, class BinaryFunctor>
+  VTKM_CONT_EXPORT static T Reduce(
+      const vtkm::cont::ArrayHandle<T,CIn> &input,
+      T initialValue,
+      BinaryFunctor binary_functor)
+  {
+    typedef typename vtkm::cont::ArrayHandle<T,CIn>
+        ::template ExecutionTypes<Device>::PortalConst PortalIn;
+
+    PortalIn inputPortal = input.PrepareForInput(Device());
+    return std::accumulate(vtkm::cont::ArrayPortalToIteratorBegin(inputPortal),
+                           vtkm::cont::ArrayPortalToIteratorEnd(inputPortal),
+                           initialValue,
+                           binary_functor);
+  }
+
   template<typename T, class CIn, class COut>
   VTKM_CONT_EXPORT static T ScanInclusive(
       const vtkm::cont::ArrayHandle<T,CIn> &input,
@@ -104,48 +133,44 @@ public:
     return fullSum;
   }
 
-private:
-  // This runs in the execution environment.
-  template<class FunctorType>
-  class ScheduleKernel
-  {
-  public:
-    ScheduleKernel(const FunctorType &functor)
-      : Functor(functor) {  }
-
-    //needed for when calling from schedule on a range
-    VTKM_EXEC_EXPORT void operator()(vtkm::Id index) const
-    {
-      this->Functor(index);
-    }
-
-  private:
-    const FunctorType Functor;
-  };
-
-public:
   template<class Functor>
   VTKM_CONT_EXPORT static void Schedule(Functor functor,
                                         vtkm::Id numInstances)
   {
+    // The message storage is left uninitialized; only the small error state
+    // is reset for each call.
     const vtkm::Id MESSAGE_SIZE = 1024;
     char errorString[MESSAGE_SIZE];
     errorString[0] = '\0';
+    vtkm::exec::internal::ErrorMessageState errorState;
+    errorState.Reset();
     vtkm::exec::internal::ErrorMessageBuffer
-        errorMessage(errorString, MESSAGE_SIZE);
+        errorMessage(errorString, MESSAGE_SIZE, &errorState);
 
     functor.SetErrorMessageBuffer(errorMessage);
 
-    DeviceAdapterAlgorithm<Device>::ScheduleKernel<Functor> kernel(functor);
-
-    std::for_each(
-          ::boost::counting_iterator<vtkm::Id>(0),
-          ::boost::counting_iterator<vtkm::Id>(numInstances),
-          kernel);
+    // Instances are dispatched in order, one at a time, so the cancellation
+    // token is checked after every instance. Reading it is much cheaper than
+    // invoking the functor, and stopping right away lets us report exactly
+    // which instance raised an error.
+    for (vtkm::Id index = 0; index < numInstances; index++)
+    {
+      functor(index);
+      if (errorMessage.IsCancelled())
+      {
+        if (errorMessage.IsErrorRaised())
+        {
+          errorMessage.SetErrorInstanceIfUnknown(index);
+        }
+        break;
+      }
+    }
 
     if (errorMessage.IsErrorRaised())
     {
-      throw vtkm::cont::ErrorExecution(errorString);
+      throw vtkm::cont::ErrorExecution(errorString,
+                                       errorMessage.GetNumberOfErrors(),
+                                       errorMessage.GetErrorInstance());
     }
   }
 
@@ -0,0 +1,442 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_internal_DispatcherBase_h
+#define vtk_m_cont_internal_DispatcherBase_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/internal/DynamicTransform.h>
+
+#include <vtkm/exec/internal/WorkletInvokeFunctor.h>
+
+#include <vtkm/internal/FunctionInterface.h>
+
+#include <boost/function_types/function_arity.hpp>
+#include <boost/function_types/parameter_types.hpp>
+#include <boost/mpl/at.hpp>
+#include <boost/static_assert.hpp>
+
+namespace vtkm {
+namespace cont {
+namespace internal {
+
+namespace detail {
+
+// Finds the size of the input domain by asking the transport of each
+// argument for its input size. Arguments that do not define the domain
+// report a negative size.
+template<typename TransportPolicy,
+         typename ControlSignature,
+         typename DeviceAdapterTag,
+         vtkm::IdComponent NumRemaining,
+         vtkm::IdComponent ParameterIndex = 1>
+struct DispatcherBaseInputSize
+{
+  template<typename ParameterInterface>
+  VTKM_CONT_EXPORT
+  static vtkm::Id Get(const ParameterInterface &parameters, vtkm::Id size)
+  {
+    typedef typename boost::mpl::at_c<
+        typename boost::function_types::parameter_types<ControlSignature>,
+        ParameterIndex-1>::type ControlTag;
+    typedef typename ParameterInterface
+        ::template ParameterType<ParameterIndex>::type ArgumentType;
+    typedef typename TransportPolicy::template Transport<
+        ControlTag,ArgumentType,DeviceAdapterTag> TransportType;
+
+    vtkm::Id argumentSize = TransportType::GetInputSize(
+          parameters.template GetParameter<ParameterIndex>());
+    if (argumentSize >= 0)
+    {
+      if (size < 0)
+      {
+        size = argumentSize;
+      }
+      else if (size != argumentSize)
+      {
+        throw vtkm::cont::ErrorControlBadValue(
+              "Input arrays given to a dispatcher have different sizes.");
+      }
+    }
+
+    return DispatcherBaseInputSize<
+        TransportPolicy,
+        ControlSignature,
+        DeviceAdapterTag,
+        NumRemaining-1,
+        ParameterIndex+1>::Get(parameters, size);
+  }
+};
+
+template<typename TransportPolicy,
+         typename ControlSignature,
+         typename DeviceAdapterTag,
+         vtkm::IdComponent ParameterIndex>
+struct DispatcherBaseInputSize<
+    TransportPolicy,ControlSignature,DeviceAdapterTag,0,ParameterIndex>
+{
+  template<typename ParameterInterface>
+  VTKM_CONT_EXPORT
+  static vtkm::Id Get(const ParameterInterface &, vtkm::Id size)
+  {
+    return size;
+  }
+};
+
+// Builds a FunctionInterface of execution objects by transporting the
+// control arguments one at a time and appending the results.
+template<typename TransportPolicy,
+         typename ControlSignature,
+         typename DeviceAdapterTag,
+         typename ParameterInterface,
+         typename ExecObjectInterface,
+         bool Finished =
+           (ExecObjectInterface::ARITY == ParameterInterface::ARITY)>
+struct DispatcherBaseTransport
+{
+  static const vtkm::IdComponent PARAMETER_INDEX =
+      ExecObjectInterface::ARITY + 1;
+
+  typedef typename boost::mpl::at_c<
+      typename boost::function_types::parameter_types<ControlSignature>,
+      PARAMETER_INDEX-1>::type ControlTag;
+  typedef typename ParameterInterface
+      ::template ParameterType<PARAMETER_INDEX>::type ArgumentType;
+  typedef typename TransportPolicy::template Transport<
+      ControlTag,ArgumentType,DeviceAdapterTag> TransportType;
+
+  typedef typename ExecObjectInterface::template AppendType<
+      typename TransportType::ExecObjectType>::type NextExecObjectInterface;
+  typedef DispatcherBaseTransport<
+      TransportPolicy,
+      ControlSignature,
+      DeviceAdapterTag,
+      ParameterInterface,
+      NextExecObjectInterface> NextTransport;
+
+  typedef typename NextTransport::type type;
+
+  VTKM_CONT_EXPORT
+  static type Transport(const ParameterInterface &parameters,
+                        const ExecObjectInterface &execObjects,
+                        vtkm::Id numInstances)
+  {
+    return NextTransport::Transport(
+          parameters,
+          execObjects.Append(
+            TransportType::Prepare(
+              parameters.template GetParameter<PARAMETER_INDEX>(),
+              numInstances)),
+          numInstances);
+  }
+};
+
+template<typename TransportPolicy,
+         typename ControlSignature,
+         typename DeviceAdapterTag,
+         typename ParameterInterface,
+         typename ExecObjectInterface>
+struct DispatcherBaseTransport<
+    TransportPolicy,
+    ControlSignature,
+    DeviceAdapterTag,
+    ParameterInterface,
+    ExecObjectInterface,
+    true>
+{
+  typedef ExecObjectInterface type;
+
+  VTKM_CONT_EXPORT
+  static type Transport(const ParameterInterface &,
+                        const ExecObjectInterface &execObjects,
+                        vtkm::Id)
+  {
+    return execObjects;
+  }
+};
+
+template<typename DispatcherType>
+struct DispatcherBaseDynamicTransformFinish
+{
+  const DispatcherType *Dispatcher;
+
+  VTKM_CONT_EXPORT
+  DispatcherBaseDynamicTransformFinish(const DispatcherType *dispatcher)
+    : Dispatcher(dispatcher) {  }
+
+  template<typename Signature>
+  VTKM_CONT_EXPORT
+  void operator()(
+      const vtkm::internal::FunctionInterface<Signature> &parameters) const
+  {
+    this->Dispatcher->DoInvoke(parameters);
+  }
+};
+
+} // namespace detail
+
+/// \brief Common implementation of worklet dispatchers.
+///
+/// A dispatcher takes the arguments given to its Invoke method, resolves any
+/// dynamic arrays to their concrete types with DynamicTransform, transports
+/// each argument to an execution object according to the matching tag in the
+/// worklet's \c ControlSignature, and schedules a
+/// vtkm::exec::internal::WorkletInvokeFunctor on the device. All worklet
+/// invocations go through this one path.
+///
+/// \c TransportPolicy has a nested template <tt>Transport<ControlTag,
+/// ArgumentType, DeviceAdapterTag></tt> with an \c ExecObjectType typedef, a
+/// static \c Prepare method that returns the execution object for an
+/// argument given the number of instances, and a static \c GetInputSize
+/// method that returns the size of the input domain defined by an argument
+/// (or -1 if the argument does not define it).
+///
+/// \c DerivedClass must provide a const \c DoInvoke method that takes the
+/// resolved FunctionInterface of arguments. It usually determines the number
+/// of instances and then calls BasicInvoke.
+///
+template<class DerivedClass,
+         class WorkletType,
+         class TransportPolicy,
+         class DeviceAdapterTag>
+class DispatcherBase
+{
+public:
+  typedef typename WorkletType::ControlSignature ControlSignature;
+  typedef typename WorkletType::ExecutionSignature ExecutionSignature;
+
+  /// The number of arguments expected by Invoke.
+  ///
+  static const vtkm::IdComponent ARITY =
+      boost::function_types::function_arity<ControlSignature>::value;
+
+  template<typename T1>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1) const
+  {
+    this->StartInvoke(vtkm::internal::make_FunctionInterface<void>(a1));
+  }
+
+  template<typename T1, typename T2>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1,
+              T2 a2) const
+  {
+    this->StartInvoke(vtkm::internal::make_FunctionInterface<void>(a1, a2));
+  }
+
+  template<typename T1, typename T2, typename T3>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1,
+              T2 a2,
+              T3 a3) const
+  {
+    this->StartInvoke(vtkm::internal::make_FunctionInterface<void>(a1, a2, a3));
+  }
+
+  template<typename T1, typename T2, typename T3, typename T4>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1,
+              T2 a2,
+              T3 a3,
+              T4 a4) const
+  {
+    this->StartInvoke(
+          vtkm::internal::make_FunctionInterface<void>(a1, a2, a3, a4));
+  }
+
+  template<typename T1, typename T2, typename T3, typename T4, typename T5>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1,
+              T2 a2,
+              T3 a3,
+              T4 a4,
+              T5 a5) const
+  {
+    this->StartInvoke(
+          vtkm::internal::make_FunctionInterface<void>(a1, a2, a3, a4, a5));
+  }
+
+  template<typename T1,
+           typename T2,
+           typename T3,
+           typename T4,
+           typename T5,
+           typename T6>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1,
+              T2 a2,
+              T3 a3,
+              T4 a4,
+              T5 a5,
+              T6 a6) const
+  {
+    this->StartInvoke(
+          vtkm::internal::make_FunctionInterface<void>(a1, a2, a3, a4, a5, a6));
+  }
+
+  template<typename T1,
+           typename T2,
+           typename T3,
+           typename T4,
+           typename T5,
+           typename T6,
+           typename T7>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1,
+              T2 a2,
+              T3 a3,
+              T4 a4,
+              T5 a5,
+              T6 a6,
+              T7 a7) const
+  {
+    this->StartInvoke(
+          vtkm::internal::make_FunctionInterface<void>(
+            a1, a2, a3, a4, a5, a6, a7));
+  }
+
+  template<typename T1,
+           typename T2,
+           typename T3,
+           typename T4,
+           typename T5,
+           typename T6,
+           typename T7,
+           typename T8>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1,
+              T2 a2,
+              T3 a3,
+              T4 a4,
+              T5 a5,
+              T6 a6,
+              T7 a7,
+              T8 a8) const
+  {
+    this->StartInvoke(
+          vtkm::internal::make_FunctionInterface<void>(
+            a1, a2, a3, a4, a5, a6, a7, a8));
+  }
+
+  template<typename T1,
+           typename T2,
+           typename T3,
+           typename T4,
+           typename T5,
+           typename T6,
+           typename T7,
+           typename T8,
+           typename T9>
+  VTKM_CONT_EXPORT
+  void Invoke(T1 a1,
+              T2 a2,
+              T3 a3,
+              T4 a4,
+              T5 a5,
+              T6 a6,
+              T7 a7,
+              T8 a8,
+              T9 a9) const
+  {
+    this->StartInvoke(
+          vtkm::internal::make_FunctionInterface<void>(
+            a1, a2, a3, a4, a5, a6, a7, a8, a9));
+  }
+
+  VTKM_CONT_EXPORT
+  const WorkletType &GetWorklet() const { return this->Worklet; }
+
+protected:
+  VTKM_CONT_EXPORT
+  DispatcherBase(const WorkletType &worklet) : Worklet(worklet) {  }
+
+  /// Returns the size of the input domain defined by the arguments, or -1 if
+  /// no argument defines it. Throws ErrorControlBadValue if two arguments
+  /// disagree.
+  ///
+  template<typename Signature>
+  VTKM_CONT_EXPORT
+  vtkm::Id GetInputSize(
+      const vtkm::internal::FunctionInterface<Signature> &parameters) const
+  {
+    return detail::DispatcherBaseInputSize<
+        TransportPolicy,ControlSignature,DeviceAdapterTag,ARITY>::Get(
+          parameters, -1);
+  }
+
+  /// Transports all the arguments to the execution environment and schedules
+  /// \c numInstances instances of the worklet.
+  ///
+  template<typename Signature>
+  VTKM_CONT_EXPORT
+  void BasicInvoke(
+      const vtkm::internal::FunctionInterface<Signature> &parameters,
+      vtkm::Id numInstances) const
+  {
+    typedef vtkm::internal::FunctionInterface<Signature> ParameterInterface;
+    typedef detail::DispatcherBaseTransport<
+        TransportPolicy,
+        ControlSignature,
+        DeviceAdapterTag,
+        ParameterInterface,
+        vtkm::internal::FunctionInterface<void()> > TransportType;
+    typedef typename TransportType::type ExecObjectInterface;
+
+    ExecObjectInterface execObjects =
+        TransportType::Transport(parameters,
+                                 vtkm::internal::FunctionInterface<void()>(),
+                                 numInstances);
+
+    vtkm::exec::internal::WorkletInvokeFunctor<WorkletType,ExecObjectInterface>
+        invokeFunctor(this->Worklet, execObjects);
+    vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          invokeFunctor, numInstances);
+  }
+
+private:
+  WorkletType Worklet;
+
+  template<typename Signature>
+  VTKM_CONT_EXPORT
+  void StartInvoke(
+      const vtkm::internal::FunctionInterface<Signature> &parameters) const
+  {
+    typedef vtkm::internal::FunctionInterface<Signature> ParameterInterface;
+    BOOST_STATIC_ASSERT_MSG(ParameterInterface::ARITY == ARITY,
+                            "Dispatcher Invoke called with wrong number of "
+                            "arguments for the worklet's ControlSignature.");
+
+    ParameterInterface parametersCopy = parameters;
+    parametersCopy.DynamicTransformCont(
+          vtkm::cont::internal::DynamicTransform(),
+          detail::DispatcherBaseDynamicTransformFinish<DerivedClass>(
+            static_cast<const DerivedClass *>(this)));
+  }
+};
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_DispatcherBase_h
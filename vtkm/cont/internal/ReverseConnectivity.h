@@ -0,0 +1,307 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_internal_ReverseConnectivity_h
+#define vtk_m_cont_internal_ReverseConnectivity_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/internal/ArrayPortalAtomic.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/ConnectivityExplicit.h>
+#include <vtkm/exec/FunctorBase.h>
+
+namespace vtkm {
+namespace cont {
+namespace internal {
+
+/// Widens a number of indices to the type of the offsets so that the counts
+/// can be scanned without a temporary array.
+///
+struct ConnectivityNumIndicesToId
+{
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id operator()(vtkm::IdComponent numIndices) const
+  {
+    return static_cast<vtkm::Id>(numIndices);
+  }
+};
+
+// Counts the number of times each point is referenced by the connectivity.
+template<typename ConnectivityPortalType, typename CountPortalType>
+struct ReverseConnectivityCountKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityPortalType Connectivity;
+  CountPortalType CellCounts;
+  vtkm::Id NumberOfPoints;
+
+  VTKM_CONT_EXPORT
+  ReverseConnectivityCountKernel(const ConnectivityPortalType &connectivity,
+                                 const CountPortalType &cellCounts,
+                                 vtkm::Id numberOfPoints)
+    : Connectivity(connectivity),
+      CellCounts(cellCounts),
+      NumberOfPoints(numberOfPoints) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id pointIndex = this->Connectivity.Get(index);
+    if ((pointIndex < 0) || (pointIndex >= this->NumberOfPoints))
+    {
+      this->RaiseError("Cell references a point index out of range.");
+      return;
+    }
+    this->CellCounts.Add(pointIndex, 1);
+  }
+};
+
+// Writes each cell into the lists of the points it uses. Every point has a
+// cursor into its list that is advanced atomically, so cells can be handled
+// in parallel.
+template<typename NumIndicesPortalType,
+         typename ConnectivityPortalType,
+         typename IndexOffsetPortalType,
+         typename PointOffsetPortalType,
+         typename CursorPortalType,
+         typename CellsPortalType>
+struct ReverseConnectivityFillKernel : public vtkm::exec::FunctorBase
+{
+  NumIndicesPortalType NumIndices;
+  ConnectivityPortalType Connectivity;
+  IndexOffsetPortalType IndexOffsets;
+  PointOffsetPortalType PointOffsets;
+  CursorPortalType Cursors;
+  CellsPortalType Cells;
+
+  VTKM_CONT_EXPORT
+  ReverseConnectivityFillKernel(const NumIndicesPortalType &numIndices,
+                                const ConnectivityPortalType &connectivity,
+                                const IndexOffsetPortalType &indexOffsets,
+                                const PointOffsetPortalType &pointOffsets,
+                                const CursorPortalType &cursors,
+                                const CellsPortalType &cells)
+    : NumIndices(numIndices),
+      Connectivity(connectivity),
+      IndexOffsets(indexOffsets),
+      PointOffsets(pointOffsets),
+      Cursors(cursors),
+      Cells(cells) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    vtkm::IdComponent numIndices =
+        static_cast<vtkm::IdComponent>(this->NumIndices.Get(cellIndex));
+    vtkm::Id offset = this->IndexOffsets.Get(cellIndex);
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < numIndices;
+         pointInCell++)
+    {
+      vtkm::Id pointIndex = this->Connectivity.Get(offset + pointInCell);
+      vtkm::IdComponent slot = this->Cursors.Add(pointIndex, 1);
+      this->Cells.Set(this->PointOffsets.Get(pointIndex) + slot, cellIndex);
+    }
+  }
+};
+
+/// \brief The cells incident on each point of an explicit cell set.
+///
+/// This is the transpose of the connectivity of an explicit cell set, held
+/// in the same compressed sparse row form so that it can be used through
+/// \c ConnectivityExplicit. It is built without sorting: a counting pass
+/// makes a histogram of the point references, an exclusive scan of the
+/// histogram gives the offset of each point, and a fill pass writes each
+/// cell into the lists of its points.
+///
+/// When the cells are processed in parallel, the order of the cells within
+/// the list of a point depends on scheduling. The serial device lists them
+/// in increasing order.
+///
+class ReverseConnectivity
+{
+public:
+  typedef vtkm::cont::ArrayHandleConstant<vtkm::UInt8> ShapeArrayType;
+  typedef vtkm::cont::ArrayHandle<vtkm::IdComponent> NumIndicesArrayType;
+  typedef vtkm::cont::ArrayHandle<vtkm::Id> ConnectivityArrayType;
+  typedef vtkm::cont::ArrayHandle<vtkm::Id> IndexOffsetArrayType;
+
+  template<typename DeviceAdapterTag>
+  struct ExecutionTypes
+  {
+    typedef vtkm::exec::ConnectivityExplicit<
+        typename ShapeArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::PortalConst,
+        typename NumIndicesArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::PortalConst,
+        typename ConnectivityArrayType::template ExecutionTypes<
+            DeviceAdapterTag>::PortalConst,
+        typename IndexOffsetArrayType::template ExecutionTypes<
+            DeviceAdapterTag>::PortalConst> ExecObjectType;
+  };
+
+  VTKM_CONT_EXPORT
+  ReverseConnectivity() : Built(false) {  }
+
+  VTKM_CONT_EXPORT
+  bool IsBuilt() const { return this->Built; }
+
+  /// Releases the arrays. The next call to \c Build computes them again.
+  ///
+  VTKM_CONT_EXPORT
+  void Reset()
+  {
+    this->NumIndices = NumIndicesArrayType();
+    this->Connectivity = ConnectivityArrayType();
+    this->IndexOffsets = IndexOffsetArrayType();
+    this->Built = false;
+  }
+
+  /// Computes the cells incident on each of \c numberOfPoints points from
+  /// the points of each cell, given in compressed sparse row form.
+  ///
+  template<typename CellNumIndicesArrayType,
+           typename CellConnectivityArrayType,
+           typename CellIndexOffsetArrayType,
+           typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  void Build(const CellNumIndicesArrayType &cellNumIndices,
+             const CellConnectivityArrayType &cellConnectivity,
+             const CellIndexOffsetArrayType &cellIndexOffsets,
+             vtkm::Id numberOfPoints,
+             DeviceAdapterTag)
+  {
+    typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef vtkm::cont::internal::ArrayPortalAtomic<
+        vtkm::IdComponent,DeviceAdapterTag> CountPortalType;
+
+    this->Reset();
+    if (numberOfPoints <= 0)
+    {
+      this->Built = true;
+      return;
+    }
+
+    // Counting pass: histogram of how many cells use each point.
+    Algorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::IdComponent>(
+                      0, numberOfPoints),
+                    this->NumIndices);
+    Algorithm::Schedule(
+          ReverseConnectivityCountKernel<
+            typename CellConnectivityArrayType::template ExecutionTypes<
+              DeviceAdapterTag>::PortalConst,
+            CountPortalType>(
+            cellConnectivity.PrepareForInput(DeviceAdapterTag()),
+            CountPortalType(this->NumIndices),
+            numberOfPoints),
+          cellConnectivity.GetNumberOfValues());
+
+    // The offset of each point's list is the exclusive scan of the counts.
+    vtkm::Id totalIndices = Algorithm::ScanExclusive(
+          vtkm::cont::make_ArrayHandleTransform<vtkm::Id>(
+            this->NumIndices, ConnectivityNumIndicesToId()),
+          this->IndexOffsets);
+
+    // Fill pass. The cursors are the number of cells already written to the
+    // list of each point.
+    NumIndicesArrayType cursors;
+    Algorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::IdComponent>(
+                      0, numberOfPoints),
+                    cursors);
+    Algorithm::Schedule(
+          ReverseConnectivityFillKernel<
+            typename CellNumIndicesArrayType::template ExecutionTypes<
+              DeviceAdapterTag>::PortalConst,
+            typename CellConnectivityArrayType::template ExecutionTypes<
+              DeviceAdapterTag>::PortalConst,
+            typename CellIndexOffsetArrayType::template ExecutionTypes<
+              DeviceAdapterTag>::PortalConst,
+            typename IndexOffsetArrayType::template ExecutionTypes<
+              DeviceAdapterTag>::PortalConst,
+            CountPortalType,
+            typename ConnectivityArrayType::template ExecutionTypes<
+              DeviceAdapterTag>::Portal>(
+            cellNumIndices.PrepareForInput(DeviceAdapterTag()),
+            cellConnectivity.PrepareForInput(DeviceAdapterTag()),
+            cellIndexOffsets.PrepareForInput(DeviceAdapterTag()),
+            this->IndexOffsets.PrepareForInput(DeviceAdapterTag()),
+            CountPortalType(cursors),
+            this->Connectivity.PrepareForOutput(totalIndices,
+                                                DeviceAdapterTag())),
+          cellNumIndices.GetNumberOfValues());
+
+    this->Built = true;
+  }
+
+  VTKM_CONT_EXPORT
+  ShapeArrayType GetShapesArray() const
+  {
+    return ShapeArrayType(static_cast<vtkm::UInt8>(vtkm::CELL_SHAPE_VERTEX),
+                          this->NumIndices.GetNumberOfValues());
+  }
+
+  VTKM_CONT_EXPORT
+  const NumIndicesArrayType &GetNumIndicesArray() const
+  {
+    return this->NumIndices;
+  }
+
+  VTKM_CONT_EXPORT
+  const ConnectivityArrayType &GetConnectivityArray() const
+  {
+    return this->Connectivity;
+  }
+
+  VTKM_CONT_EXPORT
+  const IndexOffsetArrayType &GetIndexOffsetArray() const
+  {
+    return this->IndexOffsets;
+  }
+
+  template<typename DeviceAdapterTag>
+  VTKM_CONT_EXPORT
+  typename ExecutionTypes<DeviceAdapterTag>::ExecObjectType
+  PrepareForInput(DeviceAdapterTag) const
+  {
+    typedef typename ExecutionTypes<DeviceAdapterTag>::ExecObjectType
+        ExecObjectType;
+    return ExecObjectType(
+          this->GetShapesArray().PrepareForInput(DeviceAdapterTag()),
+          this->NumIndices.PrepareForInput(DeviceAdapterTag()),
+          this->Connectivity.PrepareForInput(DeviceAdapterTag()),
+          this->IndexOffsets.PrepareForInput(DeviceAdapterTag()));
+  }
+
+private:
+  bool Built;
+  NumIndicesArrayType NumIndices;
+  ConnectivityArrayType Connectivity;
+  IndexOffsetArrayType IndexOffsets;
+};
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_ReverseConnectivity_h
@@ -0,0 +1,118 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_cont_internal_SystemClock_h
+#define vtk_m_cont_internal_SystemClock_h
+
+#include <vtkm/Types.h>
+
+// The system clocks are read in this header only, so the platform headers
+// they need are kept out of the rest of VTK-m. windows.h in particular
+// defines min and max macros and much of the Win32 API unless told not to.
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+// windows.h defines GetCurrentTime as a macro, which collides with the method
+// of the same name in DeviceAdapterTimerImplementation.
+#ifdef GetCurrentTime
+#undef GetCurrentTime
+#endif
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#include <unistd.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <ctime>
+
+namespace vtkm {
+namespace cont {
+namespace internal {
+
+/// Reads a monotonic clock (one that is never adjusted backward by changes
+/// to the system time) into whole seconds and the remaining nanoseconds.
+/// The resolution is nanoseconds where the operating system supports it.
+///
+VTKM_CONT_EXPORT
+void SystemClockMonotonic(vtkm::Int64 &seconds, vtkm::Int64 &nanoseconds)
+{
+#ifdef _WIN32
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  ::QueryPerformanceFrequency(&frequency);
+  ::QueryPerformanceCounter(&counter);
+  seconds = counter.QuadPart / frequency.QuadPart;
+  nanoseconds = ((counter.QuadPart % frequency.QuadPart) * 1000000000)
+      / frequency.QuadPart;
+#elif defined(__APPLE__)
+  mach_timebase_info_data_t timebase;
+  mach_timebase_info(&timebase);
+  vtkm::Int64 totalNanoseconds =
+      static_cast<vtkm::Int64>(mach_absolute_time())
+      * timebase.numer / timebase.denom;
+  seconds = totalNanoseconds / 1000000000;
+  nanoseconds = totalNanoseconds % 1000000000;
+#else
+  timespec currentTime;
+  clock_gettime(CLOCK_MONOTONIC, &currentTime);
+  seconds = currentTime.tv_sec;
+  nanoseconds = currentTime.tv_nsec;
+#endif
+}
+
+/// Returns the processor time in seconds used so far by all the threads of
+/// this process.
+///
+VTKM_CONT_EXPORT
+vtkm::Float64 SystemClockProcessCPUTime()
+{
+#ifdef _WIN32
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  ::GetProcessTimes(
+        ::GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+  ULARGE_INTEGER user;
+  user.LowPart = userTime.dwLowDateTime;
+  user.HighPart = userTime.dwHighDateTime;
+  ULARGE_INTEGER kernel;
+  kernel.LowPart = kernelTime.dwLowDateTime;
+  kernel.HighPart = kernelTime.dwHighDateTime;
+  // FILETIME is measured in 100 nanosecond intervals.
+  return vtkm::Float64(user.QuadPart + kernel.QuadPart)*1.0e-7;
+#elif defined(CLOCK_PROCESS_CPUTIME_ID)
+  timespec currentTime;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &currentTime);
+  return (vtkm::Float64(currentTime.tv_sec)
+          + vtkm::Float64(currentTime.tv_nsec)*1.0e-9);
+#else
+  return vtkm::Float64(std::clock())/vtkm::Float64(CLOCKS_PER_SEC);
+#endif
+}
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_SystemClock_h
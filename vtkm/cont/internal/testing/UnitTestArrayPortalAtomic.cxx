@@ -0,0 +1,119 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/internal/ArrayPortalAtomic.h>
+
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/DeviceAdapter.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+namespace {
+
+const vtkm::Id ARRAY_SIZE = 10;
+const vtkm::Id REPEATS = 7;
+
+template<typename AtomicPortalType>
+struct AddKernel : public vtkm::exec::FunctorBase
+{
+  AtomicPortalType Counts;
+
+  VTKM_CONT_EXPORT
+  AddKernel(const AtomicPortalType &counts) : Counts(counts) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    this->Counts.Add(index % this->Counts.GetNumberOfValues(), 1);
+  }
+};
+
+// Every instance tries to claim slot 0 with its index. Slot 1 counts the
+// instances whose swap succeeded.
+template<typename AtomicPortalType>
+struct ClaimKernel : public vtkm::exec::FunctorBase
+{
+  AtomicPortalType Slots;
+
+  VTKM_CONT_EXPORT
+  ClaimKernel(const AtomicPortalType &slots) : Slots(slots) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    typedef typename AtomicPortalType::ValueType ValueType;
+    if (this->Slots.CompareAndSwap(0, -1, static_cast<ValueType>(index)) == -1)
+    {
+      this->Slots.Add(1, 1);
+    }
+  }
+};
+
+template<typename T>
+void TestAtomicValues()
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<VTKM_DEFAULT_DEVICE_ADAPTER_TAG>
+      Algorithm;
+  typedef vtkm::cont::internal::ArrayPortalAtomic<
+      T, VTKM_DEFAULT_DEVICE_ADAPTER_TAG> AtomicPortalType;
+
+  std::cout << "Adding to every value." << std::endl;
+  vtkm::cont::ArrayHandle<T> counts;
+  Algorithm::Copy(vtkm::cont::make_ArrayHandleConstant(T(0), ARRAY_SIZE),
+                  counts);
+  Algorithm::Schedule(AddKernel<AtomicPortalType>(AtomicPortalType(counts)),
+                      ARRAY_SIZE*REPEATS);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    VTKM_TEST_ASSERT(counts.GetPortalConstControl().Get(index) == REPEATS,
+                     "Wrong count.");
+  }
+
+  std::cout << "Claiming a value with compare and swap." << std::endl;
+  vtkm::cont::ArrayHandle<T> slots;
+  Algorithm::Copy(vtkm::cont::make_ArrayHandleConstant(T(-1), 2), slots);
+  slots.GetPortalControl().Set(1, 0);
+  Algorithm::Schedule(ClaimKernel<AtomicPortalType>(AtomicPortalType(slots)),
+                      ARRAY_SIZE);
+  VTKM_TEST_ASSERT(slots.GetPortalConstControl().Get(1) == 1,
+                   "More than one instance claimed the value.");
+  T owner = slots.GetPortalConstControl().Get(0);
+  VTKM_TEST_ASSERT((owner >= 0) && (owner < ARRAY_SIZE),
+                   "Claimed value is not an instance.");
+}
+
+void TestArrayPortalAtomic()
+{
+  std::cout << "Testing vtkm::Int32." << std::endl;
+  TestAtomicValues<vtkm::Int32>();
+  std::cout << "Testing vtkm::Int64." << std::endl;
+  TestAtomicValues<vtkm::Int64>();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayPortalAtomic(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestArrayPortalAtomic);
+}
@@ -21,6 +21,8 @@
 #define vtk_m_cont_testing_TestingDeviceAdapter_h
 
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
 #include <vtkm/cont/ArrayPortalToIterators.h>
 #include <vtkm/cont/ErrorControlOutOfMemory.h>
 #include <vtkm/cont/ErrorExecution.h>
@@ -30,6 +32,8 @@
 
 #include <vtkm/cont/internal/DeviceAdapterError.h>
 
+#include <vtkm/exec/FunctorBase.h>
+
 #include <vtkm/cont/testing/Testing.h>
 
 #include <algorithm>
@@ -215,7 +219,7 @@ public:
     {
       if (index == ARRAY_SIZE/2)
       {
-        this->ErrorMessage.RaiseError(ERROR_MESSAGE);
+        this->ErrorMessage.RaiseError(ERROR_MESSAGE, index);
       }
     }
 
@@ -300,6 +304,86 @@ public:
     }
   };
 
+  struct CancelAtKernel : public vtkm::exec::FunctorBase
+  {
+    VTKM_CONT_EXPORT
+    CancelAtKernel(const IdPortalType &array, vtkm::Id cancelIndex)
+      : Array(array), CancelIndex(cancelIndex) {  }
+
+    VTKM_EXEC_EXPORT void operator()(vtkm::Id index) const
+    {
+      this->Array.Set(index, 1);
+      if (index == this->CancelIndex)
+      {
+        this->Cancel();
+      }
+    }
+
+    IdPortalType Array;
+    vtkm::Id CancelIndex;
+  };
+
+  struct IdEquals
+  {
+    VTKM_EXEC_CONT_EXPORT IdEquals(vtkm::Id value) : Value(value) {  }
+
+    VTKM_EXEC_CONT_EXPORT bool operator()(vtkm::Id x) const
+    {
+      return (x == this->Value);
+    }
+
+    vtkm::Id Value;
+  };
+
+  struct IdMaximum
+  {
+    VTKM_EXEC_CONT_EXPORT vtkm::Id operator()(vtkm::Id a, vtkm::Id b) const
+    {
+      return (a < b) ? b : a;
+    }
+  };
+
+  // Makes the interval holding only the given index.
+  struct IdToInterval
+  {
+    VTKM_EXEC_CONT_EXPORT vtkm::Id2 operator()(vtkm::Id index) const
+    {
+      return vtkm::Id2(index, index);
+    }
+  };
+
+  // Joins two intervals of indices if the second starts right after the
+  // first ends. Otherwise the result is the invalid interval (-2,-2), which
+  // stays invalid. This is associative but not commutative, so it only gives
+  // a valid interval when the values are combined in order.
+  struct JoinIntervals
+  {
+    VTKM_EXEC_CONT_EXPORT
+    vtkm::Id2 operator()(const vtkm::Id2 &a, const vtkm::Id2 &b) const
+    {
+      if (a[1] + 1 == b[0])
+      {
+        return vtkm::Id2(a[0], b[1]);
+      }
+      else
+      {
+        return vtkm::Id2(-2, -2);
+      }
+    }
+  };
+
+  struct IdLess
+  {
+    VTKM_EXEC_CONT_EXPORT IdLess(vtkm::Id value) : Value(value) {  }
+
+    VTKM_EXEC_CONT_EXPORT bool operator()(vtkm::Id x) const
+    {
+      return (x < this->Value);
+    }
+
+    vtkm::Id Value;
+  };
+
   struct FuseAll
   {
     template<typename T>
@@ -628,6 +712,82 @@ private:
   //     }
   // }
 
+  static VTKM_CONT_EXPORT void TestCancel()
+  {
+    std::cout << "-------------------------------------------" << std::endl;
+    std::cout << "Testing Schedule cancellation" << std::endl;
+
+    const vtkm::Id cancelIndex = ARRAY_SIZE/4;
+
+    IdArrayHandle handle;
+    Algorithm::Schedule(
+          ClearArrayKernel(handle.PrepareForOutput(ARRAY_SIZE,
+                                                   DeviceAdapterTag())),
+          ARRAY_SIZE);
+
+    // Cancelling is not an error, so this must not throw.
+    Algorithm::Schedule(
+          CancelAtKernel(handle.PrepareForInPlace(DeviceAdapterTag()),
+                         cancelIndex),
+          ARRAY_SIZE);
+
+    // Instances after the cancelling one may or may not have run, but every
+    // instance before it must have.
+    vtkm::Id numberRun = 0;
+    for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+      vtkm::Id value = handle.GetPortalConstControl().Get(index);
+      VTKM_TEST_ASSERT((value == 1) || (value == OFFSET),
+                       "Got bad value in cancelled array.");
+      if (index <= cancelIndex)
+      {
+        VTKM_TEST_ASSERT(value == 1, "Instance before cancel did not run.");
+      }
+      if (value == 1) { numberRun++; }
+    }
+    std::cout << "Ran " << numberRun << " of " << ARRAY_SIZE
+              << " instances." << std::endl;
+  }
+
+  static VTKM_CONT_EXPORT void TestFindFirstAnyOfAllOf()
+  {
+    std::cout << "-------------------------------------------" << std::endl;
+    std::cout << "Testing FindFirst, AnyOf, and AllOf" << std::endl;
+
+    vtkm::Id testData[ARRAY_SIZE];
+    for(vtkm::Id i=0; i < ARRAY_SIZE; ++i)
+    {
+      testData[i]= OFFSET+(i % 50);
+    }
+    IdArrayHandle input = MakeArrayHandle(testData, ARRAY_SIZE);
+
+    VTKM_TEST_ASSERT(Algorithm::FindFirst(input, IdEquals(OFFSET+42)) == 42,
+                     "FindFirst did not find first match.");
+    VTKM_TEST_ASSERT(Algorithm::FindFirst(input, IdEquals(OFFSET)) == 0,
+                     "FindFirst did not find match at beginning.");
+    VTKM_TEST_ASSERT(Algorithm::FindFirst(input, IdEquals(0)) == -1,
+                     "FindFirst found nonexistent value.");
+
+    VTKM_TEST_ASSERT(Algorithm::AnyOf(input, IdEquals(OFFSET+49)),
+                     "AnyOf missed a value.");
+    VTKM_TEST_ASSERT(!Algorithm::AnyOf(input, IdEquals(OFFSET+50)),
+                     "AnyOf found nonexistent value.");
+
+    VTKM_TEST_ASSERT(Algorithm::AllOf(input, IdLess(OFFSET+50)),
+                     "AllOf missed that all values pass.");
+    VTKM_TEST_ASSERT(!Algorithm::AllOf(input, IdLess(OFFSET+49)),
+                     "AllOf missed a failing value.");
+
+    IdArrayHandle empty;
+    Algorithm::Copy(MakeArrayHandle(testData, 0), empty);
+    VTKM_TEST_ASSERT(Algorithm::FindFirst(empty, IdEquals(OFFSET)) == -1,
+                     "FindFirst found value in empty array.");
+    VTKM_TEST_ASSERT(!Algorithm::AnyOf(empty, IdEquals(OFFSET)),
+                     "AnyOf found value in empty array.");
+    VTKM_TEST_ASSERT(Algorithm::AllOf(empty, IdEquals(OFFSET)),
+                     "AllOf should be true for empty array.");
+  }
+
   static VTKM_CONT_EXPORT void TestStreamCompact()
   {
     std::cout << "-------------------------------------------" << std::endl;
@@ -1007,6 +1167,65 @@ private:
     VTKM_TEST_ASSERT(value == OFFSET, "Got bad unique value");
   }
 
+  static VTKM_CONT_EXPORT void TestReduce()
+  {
+    std::cout << "-------------------------------------------" << std::endl;
+    std::cout << "Testing Reduce" << std::endl;
+
+    //construct the index array
+    IdArrayHandle array;
+    Algorithm::Schedule(
+      ClearArrayKernel(array.PrepareForOutput(ARRAY_SIZE,
+                       DeviceAdapterTag())),
+      ARRAY_SIZE);
+
+    //we know have an array whose sum is equal to OFFSET * ARRAY_SIZE,
+    //let's validate that
+    vtkm::Id sum = Algorithm::Reduce(array, vtkm::Id(0));
+    VTKM_TEST_ASSERT(sum == OFFSET * ARRAY_SIZE, "Got bad sum from Reduce");
+
+    sum = Algorithm::Reduce(array, vtkm::Id(1));
+    VTKM_TEST_ASSERT(sum == OFFSET * ARRAY_SIZE + 1,
+                     "Reduce did not add initial value");
+
+    //reduce an implicit array, which has no values to copy
+    sum = Algorithm::Reduce(
+          vtkm::cont::make_ArrayHandleCounting(vtkm::Id(1), ARRAY_SIZE),
+          vtkm::Id(0));
+    VTKM_TEST_ASSERT(sum == (ARRAY_SIZE*(ARRAY_SIZE+1))/2,
+                     "Got bad sum from Reduce of counting array");
+
+    IdArrayHandle empty;
+    empty.PrepareForOutput(0, DeviceAdapterTag());
+    sum = Algorithm::Reduce(empty, vtkm::Id(OFFSET));
+    VTKM_TEST_ASSERT(sum == OFFSET, "Reduce of empty array is not initial");
+
+    //reduce with a functor over enough values to need several passes
+    vtkm::Id maximum = Algorithm::Reduce(
+          vtkm::cont::make_ArrayHandleCounting(vtkm::Id(-OFFSET),
+                                               ARRAY_SIZE*5),
+          vtkm::Id(-OFFSET),
+          IdMaximum());
+    VTKM_TEST_ASSERT(maximum == ARRAY_SIZE*5 - 1 - OFFSET,
+                     "Got bad maximum from Reduce with functor");
+
+    maximum = Algorithm::Reduce(empty, vtkm::Id(OFFSET), IdMaximum());
+    VTKM_TEST_ASSERT(maximum == OFFSET,
+                     "Reduce with functor of empty array is not initial");
+
+    //reduce with a functor that is not commutative over enough values that a
+    //reduction done in chunks combines partial results of partial results
+    const vtkm::Id numIntervals = 1100*1100;
+    vtkm::Id2 interval = Algorithm::Reduce(
+          vtkm::cont::make_ArrayHandleTransform<vtkm::Id2>(
+            vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), numIntervals),
+            IdToInterval()),
+          vtkm::Id2(-1, -1),
+          JoinIntervals());
+    VTKM_TEST_ASSERT(interval == vtkm::Id2(-1, numIntervals - 1),
+                     "Reduce with functor combined values out of order");
+  }
+
   static VTKM_CONT_EXPORT void TestScanInclusive()
   {
     std::cout << "-------------------------------------------" << std::endl;
@@ -1079,6 +1298,8 @@ private:
 
     std::cout << "Generating one error." << std::endl;
     std::string message;
+    vtkm::Id numberOfErrors = 0;
+    vtkm::Id errorInstance = -1;
     try
     {
       Algorithm::Schedule(OneErrorKernel(), ARRAY_SIZE);
@@ -1087,12 +1308,18 @@ private:
     {
       std::cout << "Got expected error: " << error.GetMessage() << std::endl;
       message = error.GetMessage();
+      numberOfErrors = error.GetNumberOfErrors();
+      errorInstance = error.GetErrorInstance();
     }
     VTKM_TEST_ASSERT(message == ERROR_MESSAGE,
                      "Did not get expected error message.");
+    VTKM_TEST_ASSERT(numberOfErrors == 1, "Wrong number of errors reported.");
+    VTKM_TEST_ASSERT(errorInstance == ARRAY_SIZE/2,
+                     "Wrong failing instance reported.");
 
     std::cout << "Generating lots of errors." << std::endl;
     message = "";
+    numberOfErrors = 0;
     try
     {
       Algorithm::Schedule(AllErrorKernel(), ARRAY_SIZE);
@@ -1100,10 +1327,19 @@ private:
     catch (vtkm::cont::ErrorExecution error)
     {
       std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+      std::cout << "Reported " << error.GetNumberOfErrors()
+                << " error(s), first at instance " << error.GetErrorInstance()
+                << std::endl;
       message = error.GetMessage();
+      numberOfErrors = error.GetNumberOfErrors();
+      errorInstance = error.GetErrorInstance();
     }
     VTKM_TEST_ASSERT(message == ERROR_MESSAGE,
                      "Did not get expected error message.");
+    VTKM_TEST_ASSERT((numberOfErrors >= 1) && (numberOfErrors <= ARRAY_SIZE),
+                     "Wrong number of errors reported.");
+    VTKM_TEST_ASSERT(errorInstance < ARRAY_SIZE,
+                     "Wrong failing instance reported.");
   }
 
   // template<typename GridType>
@@ -1294,6 +1530,9 @@ private:
 
       TestAlgorithmSchedule();
       TestErrorExecution();
+      TestCancel();
+      TestFindFirstAnyOfAllOf();
+      TestReduce();
       TestScanInclusive();
       TestScanExclusive();
       TestSortWithComparisonObject();
@@ -0,0 +1,162 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/ArrayHandlePermutation.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const vtkm::Id ARRAY_SIZE = 10;
+
+typedef vtkm::cont::DeviceAdapterAlgorithm<VTKM_DEFAULT_DEVICE_ADAPTER_TAG>
+    Algorithm;
+
+// Maps an index to the value array index that the permutation reads from:
+// every other value, in reverse.
+struct EveryOtherReversed
+{
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id operator()(vtkm::Id index) const
+  {
+    return ARRAY_SIZE - 1 - 2*(index % (ARRAY_SIZE/2));
+  }
+};
+
+template<typename ArrayHandleType>
+void CheckGather(const ArrayHandleType &array,
+                 const std::vector<vtkm::Id> &indices,
+                 const std::vector<vtkm::Id> &values)
+{
+  VTKM_TEST_ASSERT(array.GetNumberOfValues()
+                   == static_cast<vtkm::Id>(indices.size()),
+                   "Permuted array has wrong size.");
+  for (vtkm::Id index = 0; index < array.GetNumberOfValues(); index++)
+  {
+    vtkm::Id valueIndex = indices[static_cast<std::size_t>(index)];
+    VTKM_TEST_ASSERT(array.GetPortalConstControl().Get(index)
+                     == values[static_cast<std::size_t>(valueIndex)],
+                     "Got bad permuted value.");
+  }
+}
+
+void TestPermutation()
+{
+  std::cout << "Testing permutation with index array." << std::endl;
+  std::vector<vtkm::Id> values(ARRAY_SIZE);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    values[static_cast<std::size_t>(index)] = TestValue(index, vtkm::Id());
+  }
+
+  // Indices repeat and skip values, and there are more of them than values.
+  std::vector<vtkm::Id> indices(2*ARRAY_SIZE);
+  for (vtkm::Id index = 0; index < 2*ARRAY_SIZE; index++)
+  {
+    indices[static_cast<std::size_t>(index)] = (7*index) % ARRAY_SIZE;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> valueArray =
+      vtkm::cont::make_ArrayHandle(values);
+  vtkm::cont::ArrayHandle<vtkm::Id> indexArray =
+      vtkm::cont::make_ArrayHandle(indices);
+
+  vtkm::cont::ArrayHandlePermutation<
+      vtkm::cont::ArrayHandle<vtkm::Id>, vtkm::cont::ArrayHandle<vtkm::Id> >
+      permutation(indexArray, valueArray);
+  CheckGather(permutation, indices, values);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> result;
+  Algorithm::Copy(permutation, result);
+  CheckGather(result, indices, values);
+
+  vtkm::Id expectedSum = 0;
+  for (std::size_t index = 0; index < indices.size(); index++)
+  {
+    expectedSum += values[static_cast<std::size_t>(indices[index])];
+  }
+  VTKM_TEST_ASSERT(Algorithm::Reduce(permutation, vtkm::Id(0)) == expectedSum,
+                   "Got bad sum of permuted values.");
+
+  std::cout << "Testing permuted arrays are read only." << std::endl;
+  bool gotError = false;
+  try
+  {
+    permutation.GetPortalControl();
+  }
+  catch (vtkm::cont::ErrorControlBadValue error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Writing a permuted array did not fail.");
+}
+
+void TestPermutationOfImplicitArrays()
+{
+  std::cout << "Testing permutation with implicit indices and values."
+            << std::endl;
+  std::vector<vtkm::Id> indices(ARRAY_SIZE);
+  std::vector<vtkm::Id> values(ARRAY_SIZE);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    indices[static_cast<std::size_t>(index)] = EveryOtherReversed()(index);
+    values[static_cast<std::size_t>(index)] = index + 5;
+  }
+
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> counting(0, ARRAY_SIZE);
+  typedef vtkm::cont::ArrayHandleTransform<
+      vtkm::Id, vtkm::cont::ArrayHandleCounting<vtkm::Id>, EveryOtherReversed>
+      IndexArrayType;
+  IndexArrayType indexArray(counting);
+
+  vtkm::cont::ArrayHandlePermutation<
+      IndexArrayType, vtkm::cont::ArrayHandleCounting<vtkm::Id> >
+      permutation = vtkm::cont::make_ArrayHandlePermutation(
+        indexArray, vtkm::cont::make_ArrayHandleCounting(vtkm::Id(5),
+                                                         ARRAY_SIZE));
+  CheckGather(permutation, indices, values);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> result;
+  Algorithm::Copy(permutation, result);
+  CheckGather(result, indices, values);
+}
+
+void TestArrayHandlePermutation()
+{
+  TestPermutation();
+  TestPermutationOfImplicitArrays();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandlePermutation(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestArrayHandlePermutation);
+}
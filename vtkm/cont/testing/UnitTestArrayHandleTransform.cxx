@@ -0,0 +1,186 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/ArrayHandleTransform.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const vtkm::Id ARRAY_SIZE = 10;
+
+typedef vtkm::cont::DeviceAdapterAlgorithm<VTKM_DEFAULT_DEVICE_ADAPTER_TAG>
+    Algorithm;
+
+struct Scale
+{
+  vtkm::FloatDefault Factor;
+
+  VTKM_EXEC_CONT_EXPORT
+  Scale(vtkm::FloatDefault factor = 1) : Factor(factor) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::FloatDefault operator()(vtkm::FloatDefault value) const
+  {
+    return value*this->Factor;
+  }
+};
+
+struct Offset
+{
+  vtkm::FloatDefault Amount;
+
+  VTKM_EXEC_CONT_EXPORT
+  Offset(vtkm::FloatDefault amount = 0) : Amount(amount) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::FloatDefault operator()(vtkm::FloatDefault value) const
+  {
+    return value + this->Amount;
+  }
+};
+
+struct IdToFloat
+{
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::FloatDefault operator()(vtkm::Id value) const
+  {
+    return static_cast<vtkm::FloatDefault>(value);
+  }
+};
+
+template<typename ArrayHandleType>
+void CheckValues(const ArrayHandleType &array,
+                 const std::vector<vtkm::FloatDefault> &expected)
+{
+  VTKM_TEST_ASSERT(array.GetNumberOfValues()
+                   == static_cast<vtkm::Id>(expected.size()),
+                   "Transformed array has wrong size.");
+  for (vtkm::Id index = 0; index < array.GetNumberOfValues(); index++)
+  {
+    VTKM_TEST_ASSERT(test_equal(array.GetPortalConstControl().Get(index),
+                                expected[static_cast<std::size_t>(index)]),
+                     "Got bad transformed value.");
+  }
+}
+
+void TestTransformControl()
+{
+  std::cout << "Testing transform in control environment." << std::endl;
+  std::vector<vtkm::FloatDefault> buffer(ARRAY_SIZE);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    buffer[static_cast<std::size_t>(index)] =
+        TestValue(index, vtkm::FloatDefault());
+  }
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> input =
+      vtkm::cont::make_ArrayHandle(buffer);
+
+  vtkm::cont::ArrayHandleTransform<
+      vtkm::FloatDefault, vtkm::cont::ArrayHandle<vtkm::FloatDefault>, Scale>
+      scaled(input, Scale(2));
+
+  std::vector<vtkm::FloatDefault> expected(ARRAY_SIZE);
+  for (std::size_t index = 0; index < buffer.size(); index++)
+  {
+    expected[index] = 2*buffer[index];
+  }
+  CheckValues(scaled, expected);
+
+  std::cout << "Testing that values are computed when read." << std::endl;
+  buffer[0] = 100;
+  expected[0] = 200;
+  CheckValues(scaled, expected);
+
+  std::cout << "Testing transformed arrays are read only." << std::endl;
+  bool gotError = false;
+  try
+  {
+    scaled.GetPortalControl();
+  }
+  catch (vtkm::cont::ErrorControlBadValue error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Writing a transformed array did not fail.");
+}
+
+void TestTransformChainExecution()
+{
+  std::cout << "Testing chained transforms in execution environment."
+            << std::endl;
+  // Counting -> float -> scale -> offset. None of these stores values.
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> counting(0, ARRAY_SIZE);
+  typedef vtkm::cont::ArrayHandleTransform<
+      vtkm::FloatDefault, vtkm::cont::ArrayHandleCounting<vtkm::Id>, IdToFloat>
+      FloatArrayType;
+  typedef vtkm::cont::ArrayHandleTransform<
+      vtkm::FloatDefault, FloatArrayType, Scale> ScaledArrayType;
+  typedef vtkm::cont::ArrayHandleTransform<
+      vtkm::FloatDefault, ScaledArrayType, Offset> OffsetArrayType;
+  OffsetArrayType chain =
+      vtkm::cont::make_ArrayHandleTransform<vtkm::FloatDefault>(
+        vtkm::cont::make_ArrayHandleTransform<vtkm::FloatDefault>(
+          vtkm::cont::make_ArrayHandleTransform<vtkm::FloatDefault>(
+            counting, IdToFloat()),
+          Scale(3)),
+        Offset(1));
+
+  std::vector<vtkm::FloatDefault> expected(ARRAY_SIZE);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    expected[static_cast<std::size_t>(index)] =
+        static_cast<vtkm::FloatDefault>(3*index + 1);
+  }
+  CheckValues(chain, expected);
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> result;
+  Algorithm::Copy(chain, result);
+  CheckValues(result, expected);
+
+  std::cout << "Testing reduce of chained transforms." << std::endl;
+  vtkm::FloatDefault sum = Algorithm::Reduce(chain, vtkm::FloatDefault(0));
+  VTKM_TEST_ASSERT(
+        test_equal(sum, static_cast<vtkm::FloatDefault>(
+                     3*(ARRAY_SIZE*(ARRAY_SIZE-1))/2 + ARRAY_SIZE)),
+        "Got bad sum of transformed values.");
+}
+
+void TestArrayHandleTransform()
+{
+  TestTransformControl();
+  TestTransformChainExecution();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleTransform(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestArrayHandleTransform);
+}
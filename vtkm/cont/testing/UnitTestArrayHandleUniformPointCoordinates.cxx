@@ -51,6 +51,10 @@ void TestArrayHandleUniformPointCoordinates()
                    "Portal has wrong number of points.");
   VTKM_TEST_ASSERT(portal.GetRange3() == POINT_DIMS,
                    "Portal range is wrong.");
+  VTKM_TEST_ASSERT(test_equal(portal.GetOrigin(), ORIGIN),
+                   "Portal origin is wrong.");
+  VTKM_TEST_ASSERT(test_equal(portal.GetSpacing(), SPACING),
+                   "Portal spacing is wrong.");
 
   std::cout << "Checking computed values of portal." << std::endl;
   Vector3 expectedValue;
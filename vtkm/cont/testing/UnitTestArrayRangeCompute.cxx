@@ -0,0 +1,189 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/ArrayRangeCompute.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/DynamicPointCoordinates.h>
+#include <vtkm/cont/PointCoordinatesUniform.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+
+const vtkm::Id ARRAY_SIZE = 3000;
+
+bool IsRangeCached(const vtkm::cont::ArrayHandle<vtkm::Float32> &array,
+                   std::vector<vtkm::Range> &cachedRanges)
+{
+  return vtkm::cont::internal::ArrayRangeComputeGetCached(array,
+                                                          cachedRanges);
+}
+
+void TestBasicArray()
+{
+  std::cout << "Testing range of basic array." << std::endl;
+  std::vector<vtkm::Float32> values(static_cast<std::size_t>(ARRAY_SIZE));
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    values[static_cast<std::size_t>(index)] =
+        static_cast<vtkm::Float32>((index*37)%ARRAY_SIZE) - 100.0f;
+  }
+  vtkm::cont::ArrayHandle<vtkm::Float32> array;
+  vtkm::cont::DeviceAdapterAlgorithm<Device>::Copy(
+        vtkm::cont::make_ArrayHandle(values), array);
+
+  std::vector<vtkm::Range> cachedRanges;
+  VTKM_TEST_ASSERT(!IsRangeCached(array, cachedRanges),
+                   "Range cached before it was computed.");
+
+  std::vector<vtkm::Range> ranges = vtkm::cont::ComputeRange(array, Device());
+  VTKM_TEST_ASSERT(ranges.size() == 1, "Wrong number of components.");
+  VTKM_TEST_ASSERT(ranges[0] == vtkm::Range(-100.0, ARRAY_SIZE - 101.0),
+                   "Wrong range.");
+
+  std::cout << "Checking that the range is kept with the array." << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Float32> copy = array;
+  VTKM_TEST_ASSERT(IsRangeCached(copy, cachedRanges),
+                   "Range not cached.");
+  VTKM_TEST_ASSERT(cachedRanges == ranges, "Wrong cached range.");
+
+  std::cout << "Checking that writing invalidates the range." << std::endl;
+  array.PrepareForInPlace(Device()).Set(5, 5000.0f);
+  VTKM_TEST_ASSERT(!IsRangeCached(copy, cachedRanges),
+                   "Writing did not invalidate range.");
+  ranges = vtkm::cont::ComputeRange(copy, Device());
+  VTKM_TEST_ASSERT(ranges[0] == vtkm::Range(-100.0, 5000.0),
+                   "Wrong range after writing.");
+
+  array.PrepareForOutput(ARRAY_SIZE/2, Device());
+  VTKM_TEST_ASSERT(!IsRangeCached(array, cachedRanges),
+                   "Output did not invalidate range.");
+}
+
+void TestVecArray()
+{
+  std::cout << "Testing range of Vec array." << std::endl;
+  typedef vtkm::Vec<vtkm::Float64,3> Vec3;
+  std::vector<Vec3> points(static_cast<std::size_t>(ARRAY_SIZE));
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    vtkm::Float64 x = static_cast<vtkm::Float64>(index);
+    points[static_cast<std::size_t>(index)] = Vec3(x, -x, 0.5);
+  }
+  vtkm::cont::ArrayHandle<Vec3> array = vtkm::cont::make_ArrayHandle(points);
+
+  std::vector<vtkm::Range> ranges = vtkm::cont::ComputeRange(array, Device());
+  VTKM_TEST_ASSERT(ranges.size() == 3, "Wrong number of components.");
+  VTKM_TEST_ASSERT(ranges[0] == vtkm::Range(0.0, ARRAY_SIZE - 1.0),
+                   "Wrong x range.");
+  VTKM_TEST_ASSERT(ranges[1] == vtkm::Range(1.0 - ARRAY_SIZE, 0.0),
+                   "Wrong y range.");
+  VTKM_TEST_ASSERT(ranges[2] == vtkm::Range(0.5, 0.5), "Wrong z range.");
+
+  vtkm::Bounds bounds =
+      vtkm::cont::ComputeBounds(vtkm::cont::DynamicPointCoordinates(array),
+                                Device());
+  VTKM_TEST_ASSERT(bounds == vtkm::Bounds(ranges[0], ranges[1], ranges[2]),
+                   "Wrong bounds of dynamic point coordinates.");
+}
+
+void TestImplicitArrays()
+{
+  std::cout << "Testing range of counting array." << std::endl;
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> counting =
+      vtkm::cont::make_ArrayHandleCounting(vtkm::Id(-10), ARRAY_SIZE);
+  std::vector<vtkm::Range> ranges =
+      vtkm::cont::ComputeRange(counting, Device());
+  VTKM_TEST_ASSERT(ranges.size() == 1, "Wrong number of components.");
+  VTKM_TEST_ASSERT(ranges[0] == vtkm::Range(-10.0, ARRAY_SIZE - 11.0),
+                   "Wrong counting range.");
+
+  std::cout << "Testing range of constant array." << std::endl;
+  vtkm::cont::ArrayHandleConstant<vtkm::Vec<vtkm::Float32,2> > constant =
+      vtkm::cont::make_ArrayHandleConstant(
+        vtkm::Vec<vtkm::Float32,2>(1.5f, -3.0f), ARRAY_SIZE);
+  ranges = vtkm::cont::ComputeRange(constant, Device());
+  VTKM_TEST_ASSERT(ranges.size() == 2, "Wrong number of components.");
+  VTKM_TEST_ASSERT(ranges[0] == vtkm::Range(1.5, 1.5), "Wrong range.");
+  VTKM_TEST_ASSERT(ranges[1] == vtkm::Range(-3.0, -3.0), "Wrong range.");
+
+  std::cout << "Testing bounds of uniform point coordinates." << std::endl;
+  const vtkm::Extent3 extent(vtkm::Id3(0,0,0), vtkm::Id3(9,4,2));
+  const vtkm::Vec<vtkm::FloatDefault,3> origin(1.0f, -2.0f, 0.0f);
+  const vtkm::Vec<vtkm::FloatDefault,3> spacing(0.5f, 1.0f, 2.0f);
+  const vtkm::Bounds expected(1.0, 5.5, -2.0, 2.0, 0.0, 4.0);
+
+  vtkm::Bounds bounds = vtkm::cont::ComputeBounds(
+        vtkm::cont::ArrayHandleUniformPointCoordinates(extent,
+                                                       origin,
+                                                       spacing),
+        Device());
+  VTKM_TEST_ASSERT(bounds == expected, "Wrong uniform bounds.");
+
+  bounds = vtkm::cont::ComputeBounds(
+        vtkm::cont::DynamicPointCoordinates(
+          vtkm::cont::PointCoordinatesUniform(extent, origin, spacing)),
+        Device());
+  VTKM_TEST_ASSERT(bounds == expected, "Wrong dynamic uniform bounds.");
+}
+
+void TestEmptyArray()
+{
+  std::cout << "Testing range of empty array." << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Float32,3> > empty;
+  empty.PrepareForOutput(0, Device());
+  std::vector<vtkm::Range> ranges = vtkm::cont::ComputeRange(empty, Device());
+  VTKM_TEST_ASSERT(ranges.size() == 3, "Wrong number of components.");
+  VTKM_TEST_ASSERT(!ranges[0].IsNonEmpty() &&
+                   !ranges[1].IsNonEmpty() &&
+                   !ranges[2].IsNonEmpty(),
+                   "Range of empty array is not empty.");
+
+  ranges = vtkm::cont::ComputeRange(
+        vtkm::cont::make_ArrayHandleCounting(vtkm::Float32(3.0f), 0),
+        Device());
+  VTKM_TEST_ASSERT(!ranges[0].IsNonEmpty(),
+                   "Range of empty counting array is not empty.");
+}
+
+void TestArrayRangeCompute()
+{
+  TestBasicArray();
+  TestVecArray();
+  TestImplicitArrays();
+  TestEmptyArray();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayRangeCompute(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestArrayRangeCompute);
+}
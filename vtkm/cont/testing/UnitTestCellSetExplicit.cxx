@@ -0,0 +1,429 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetSingleType.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/ErrorExecution.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapterTag;
+typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+const vtkm::Id NUMBER_OF_POINTS = 7;
+
+// A triangle, a quad, and a tetrahedron.
+const vtkm::Id NUMBER_OF_MIXED_CELLS = 3;
+const vtkm::UInt8 MIXED_SHAPES[NUMBER_OF_MIXED_CELLS] = {
+  vtkm::CELL_SHAPE_TRIANGLE, vtkm::CELL_SHAPE_QUAD, vtkm::CELL_SHAPE_TETRA };
+const vtkm::IdComponent MIXED_NUM_INDICES[NUMBER_OF_MIXED_CELLS] = {3, 4, 4};
+const vtkm::Id MIXED_OFFSETS[NUMBER_OF_MIXED_CELLS] = {0, 3, 7};
+const vtkm::Id MIXED_CONNECTIVITY_LENGTH = 11;
+const vtkm::Id MIXED_CONNECTIVITY[MIXED_CONNECTIVITY_LENGTH] = {
+  0, 1, 2,  1, 3, 4, 2,  2, 4, 5, 6 };
+
+// Three tetrahedra.
+const vtkm::Id NUMBER_OF_TETRAS = 3;
+const vtkm::Id TETRA_CONNECTIVITY_LENGTH = 12;
+const vtkm::Id TETRA_CONNECTIVITY[TETRA_CONNECTIVITY_LENGTH] = {
+  0, 1, 2, 3,  1, 2, 3, 4,  3, 4, 5, 6 };
+
+// Writes the sum of the point indices of each cell.
+template<typename ConnectivityType, typename PortalType>
+struct PointSumKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  PortalType PointSums;
+
+  VTKM_CONT_EXPORT
+  PointSumKernel(const ConnectivityType &connectivity,
+                 const PortalType &pointSums)
+    : Connectivity(connectivity), PointSums(pointSums) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    vtkm::Vec<vtkm::Id,8> points(0);
+    this->Connectivity.GetIndices(cellIndex, points);
+    vtkm::Id sum = 0;
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < this->Connectivity.GetNumberOfIndices(cellIndex);
+         pointInCell++)
+    {
+      sum += points[pointInCell];
+    }
+    this->PointSums.Set(cellIndex, sum);
+  }
+};
+
+template<typename CellSetType>
+void CheckCellsOfPoints(const CellSetType &cellSet,
+                        const vtkm::IdComponent *expectedNumIndices,
+                        const vtkm::Id *expectedOffsets,
+                        const vtkm::Id *expectedConnectivity)
+{
+  std::cout << "  Checking cells of points." << std::endl;
+  VTKM_TEST_ASSERT(!cellSet.GetCellsOfPoints().IsBuilt(),
+                   "Cells of points built before they were requested.");
+
+  std::vector<std::vector<vtkm::Id> > expectedCellsOfPoints(
+        static_cast<std::size_t>(NUMBER_OF_POINTS));
+  for (vtkm::Id cellIndex = 0;
+       cellIndex < cellSet.GetNumberOfCells();
+       cellIndex++)
+  {
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < expectedNumIndices[cellIndex];
+         pointInCell++)
+    {
+      vtkm::Id pointIndex =
+          expectedConnectivity[expectedOffsets[cellIndex]+pointInCell];
+      expectedCellsOfPoints[static_cast<std::size_t>(pointIndex)].push_back(
+            cellIndex);
+    }
+  }
+
+  typedef typename CellSetType::template ExecutionTypes<
+      DeviceAdapterTag,
+      vtkm::TopologyElementTagCell,
+      vtkm::TopologyElementTagPoint>::ExecObjectType CellsOfPointsType;
+  CellsOfPointsType cellsOfPoints =
+      cellSet.PrepareForInput(DeviceAdapterTag(),
+                              vtkm::TopologyElementTagCell(),
+                              vtkm::TopologyElementTagPoint());
+  VTKM_TEST_ASSERT(cellSet.GetCellsOfPoints().IsBuilt(),
+                   "Cells of points not kept.");
+  VTKM_TEST_ASSERT(cellsOfPoints.GetNumberOfElements() == NUMBER_OF_POINTS,
+                   "Wrong number of points.");
+  for (vtkm::Id pointIndex = 0; pointIndex < NUMBER_OF_POINTS; pointIndex++)
+  {
+    const std::vector<vtkm::Id> &expectedCells =
+        expectedCellsOfPoints[static_cast<std::size_t>(pointIndex)];
+    VTKM_TEST_ASSERT(
+          cellsOfPoints.GetCellShape(pointIndex) == vtkm::CELL_SHAPE_VERTEX,
+          "Points should be vertices.");
+    VTKM_TEST_ASSERT(
+          cellsOfPoints.GetNumberOfIndices(pointIndex)
+          == static_cast<vtkm::IdComponent>(expectedCells.size()),
+          "Wrong number of cells on point.");
+    vtkm::Vec<vtkm::Id,8> cells(-1);
+    cellsOfPoints.GetIndices(pointIndex, cells);
+    for (std::size_t cellOnPoint = 0;
+         cellOnPoint < expectedCells.size();
+         cellOnPoint++)
+    {
+      // The serial device fills the cells of each point in order.
+      VTKM_TEST_ASSERT(
+            cells[static_cast<vtkm::IdComponent>(cellOnPoint)]
+            == expectedCells[cellOnPoint],
+            "Wrong cell on point.");
+    }
+  }
+
+  // A second request uses the arrays already built.
+  vtkm::cont::ArrayHandle<vtkm::Id> builtConnectivity =
+      cellSet.GetCellsOfPoints().GetConnectivityArray();
+  cellSet.PrepareForInput(DeviceAdapterTag(),
+                          vtkm::TopologyElementTagCell(),
+                          vtkm::TopologyElementTagPoint());
+  VTKM_TEST_ASSERT(
+        cellSet.GetCellsOfPoints().GetConnectivityArray() == builtConnectivity,
+        "Cells of points were built again.");
+}
+
+template<typename CellSetType>
+void CheckConnectivity(const CellSetType &cellSet,
+                       const vtkm::UInt8 *expectedShapes,
+                       const vtkm::IdComponent *expectedNumIndices,
+                       const vtkm::Id *expectedOffsets,
+                       const vtkm::Id *expectedConnectivity)
+{
+  vtkm::Id numberOfCells = cellSet.GetNumberOfCells();
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfPoints() == NUMBER_OF_POINTS,
+                   "Wrong number of points.");
+
+  std::cout << "  Checking control arrays." << std::endl;
+  typename CellSetType::ShapeArrayType shapes = cellSet.GetShapesArray();
+  typename CellSetType::NumIndicesArrayType numIndices =
+      cellSet.GetNumIndicesArray();
+  typename CellSetType::IndexOffsetArrayType offsets =
+      cellSet.GetIndexOffsetArray(DeviceAdapterTag());
+  VTKM_TEST_ASSERT(shapes.GetNumberOfValues() == numberOfCells,
+                   "Wrong number of shapes.");
+  VTKM_TEST_ASSERT(numIndices.GetNumberOfValues() == numberOfCells,
+                   "Wrong number of num indices.");
+  VTKM_TEST_ASSERT(offsets.GetNumberOfValues() == numberOfCells,
+                   "Wrong number of offsets.");
+  for (vtkm::Id cellIndex = 0; cellIndex < numberOfCells; cellIndex++)
+  {
+    VTKM_TEST_ASSERT(
+          shapes.GetPortalConstControl().Get(cellIndex)
+          == expectedShapes[cellIndex],
+          "Wrong shape.");
+    VTKM_TEST_ASSERT(
+          numIndices.GetPortalConstControl().Get(cellIndex)
+          == expectedNumIndices[cellIndex],
+          "Wrong number of indices.");
+    VTKM_TEST_ASSERT(
+          offsets.GetPortalConstControl().Get(cellIndex)
+          == expectedOffsets[cellIndex],
+          "Wrong offset.");
+  }
+
+  std::cout << "  Checking execution object." << std::endl;
+  typedef typename CellSetType::template ExecutionTypes<
+      DeviceAdapterTag,
+      vtkm::TopologyElementTagPoint,
+      vtkm::TopologyElementTagCell>::ExecObjectType ConnectivityType;
+  ConnectivityType connectivity =
+      cellSet.PrepareForInput(DeviceAdapterTag(),
+                              vtkm::TopologyElementTagPoint(),
+                              vtkm::TopologyElementTagCell());
+  VTKM_TEST_ASSERT(connectivity.GetNumberOfElements() == numberOfCells,
+                   "Wrong number of elements.");
+  for (vtkm::Id cellIndex = 0; cellIndex < numberOfCells; cellIndex++)
+  {
+    VTKM_TEST_ASSERT(
+          connectivity.GetCellShape(cellIndex) == expectedShapes[cellIndex],
+          "Wrong shape in execution object.");
+    VTKM_TEST_ASSERT(
+          connectivity.GetNumberOfIndices(cellIndex)
+          == expectedNumIndices[cellIndex],
+          "Wrong number of indices in execution object.");
+    vtkm::Vec<vtkm::Id,8> points(-1);
+    connectivity.GetIndices(cellIndex, points);
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < expectedNumIndices[cellIndex];
+         pointInCell++)
+    {
+      VTKM_TEST_ASSERT(
+            points[pointInCell]
+            == expectedConnectivity[expectedOffsets[cellIndex]+pointInCell],
+            "Wrong point in cell.");
+      VTKM_TEST_ASSERT(
+            connectivity.GetIndex(cellIndex, pointInCell)
+            == expectedConnectivity[expectedOffsets[cellIndex]+pointInCell],
+            "Wrong single point in cell.");
+    }
+
+    // Asking for fewer indices than the cell has gets the first ones.
+    vtkm::Vec<vtkm::Id,2> firstPoints;
+    connectivity.GetIndices(cellIndex, firstPoints);
+    VTKM_TEST_ASSERT(firstPoints[1] == points[1], "Wrong truncated indices.");
+  }
+
+  typedef vtkm::cont::ArrayHandle<vtkm::Id> IdArrayHandle;
+  typedef typename IdArrayHandle::template ExecutionTypes<DeviceAdapterTag>
+      ::Portal PortalType;
+  IdArrayHandle pointSums;
+  Algorithm::Schedule(
+        PointSumKernel<ConnectivityType,PortalType>(
+          connectivity,
+          pointSums.PrepareForOutput(numberOfCells, DeviceAdapterTag())),
+        numberOfCells);
+  for (vtkm::Id cellIndex = 0; cellIndex < numberOfCells; cellIndex++)
+  {
+    vtkm::Id expectedSum = 0;
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < expectedNumIndices[cellIndex];
+         pointInCell++)
+    {
+      expectedSum +=
+          expectedConnectivity[expectedOffsets[cellIndex]+pointInCell];
+    }
+    VTKM_TEST_ASSERT(
+          pointSums.GetPortalConstControl().Get(cellIndex) == expectedSum,
+          "Bad connectivity in execution environment.");
+  }
+
+  CheckCellsOfPoints(cellSet,
+                     expectedNumIndices,
+                     expectedOffsets,
+                     expectedConnectivity);
+}
+
+void TestCellSetExplicit()
+{
+  std::cout << "Testing explicit cell set." << std::endl;
+  vtkm::cont::CellSetExplicit<> cellSet("cells", NUMBER_OF_POINTS);
+  VTKM_TEST_ASSERT(cellSet.GetName() == "cells", "Wrong name.");
+  VTKM_TEST_ASSERT(cellSet.GetDimensionality() == 3, "Wrong dimensionality.");
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == 0, "Cell set not empty.");
+
+  cellSet.Fill(
+        vtkm::cont::make_ArrayHandle(MIXED_SHAPES, NUMBER_OF_MIXED_CELLS),
+        vtkm::cont::make_ArrayHandle(MIXED_NUM_INDICES, NUMBER_OF_MIXED_CELLS),
+        vtkm::cont::make_ArrayHandle(MIXED_CONNECTIVITY,
+                                     MIXED_CONNECTIVITY_LENGTH));
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == NUMBER_OF_MIXED_CELLS,
+                   "Wrong number of cells.");
+  CheckConnectivity(cellSet,
+                    MIXED_SHAPES,
+                    MIXED_NUM_INDICES,
+                    MIXED_OFFSETS,
+                    MIXED_CONNECTIVITY);
+
+  std::cout << "  Checking that refilling recomputes offsets." << std::endl;
+  cellSet.Fill(
+        vtkm::cont::make_ArrayHandle(MIXED_SHAPES+1, NUMBER_OF_MIXED_CELLS-1),
+        vtkm::cont::make_ArrayHandle(MIXED_NUM_INDICES+1,
+                                     NUMBER_OF_MIXED_CELLS-1),
+        vtkm::cont::make_ArrayHandle(MIXED_CONNECTIVITY+3,
+                                     MIXED_CONNECTIVITY_LENGTH-3));
+  const vtkm::Id refilledOffsets[2] = {0, 4};
+  CheckConnectivity(cellSet,
+                    MIXED_SHAPES+1,
+                    MIXED_NUM_INDICES+1,
+                    refilledOffsets,
+                    MIXED_CONNECTIVITY+3);
+
+  std::cout << "  Checking mismatched arrays." << std::endl;
+  try
+  {
+    cellSet.Fill(
+          vtkm::cont::make_ArrayHandle(MIXED_SHAPES, NUMBER_OF_MIXED_CELLS),
+          vtkm::cont::make_ArrayHandle(MIXED_NUM_INDICES, 1),
+          vtkm::cont::make_ArrayHandle(MIXED_CONNECTIVITY,
+                                       MIXED_CONNECTIVITY_LENGTH));
+    VTKM_TEST_FAIL("Mismatched arrays did not throw.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  std::cout << "  Checking connectivity shorter than the indices." << std::endl;
+  try
+  {
+    cellSet.Fill(
+          vtkm::cont::make_ArrayHandle(MIXED_SHAPES, NUMBER_OF_MIXED_CELLS),
+          vtkm::cont::make_ArrayHandle(MIXED_NUM_INDICES,
+                                       NUMBER_OF_MIXED_CELLS),
+          vtkm::cont::make_ArrayHandle(MIXED_CONNECTIVITY,
+                                       MIXED_CONNECTIVITY_LENGTH-1));
+    VTKM_TEST_FAIL("Short connectivity did not throw.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  std::cout << "  Checking point index out of range." << std::endl;
+  cellSet.Fill(
+        vtkm::cont::make_ArrayHandle(MIXED_SHAPES, NUMBER_OF_MIXED_CELLS),
+        vtkm::cont::make_ArrayHandle(MIXED_NUM_INDICES, NUMBER_OF_MIXED_CELLS),
+        vtkm::cont::make_ArrayHandle(MIXED_CONNECTIVITY,
+                                     MIXED_CONNECTIVITY_LENGTH));
+  cellSet.SetNumberOfPoints(NUMBER_OF_POINTS-1);
+  try
+  {
+    cellSet.PrepareForInput(DeviceAdapterTag(),
+                            vtkm::TopologyElementTagCell(),
+                            vtkm::TopologyElementTagPoint());
+    VTKM_TEST_FAIL("Point index out of range did not throw.");
+  }
+  catch (vtkm::cont::ErrorExecution &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestCellSetSingleType()
+{
+  std::cout << "Testing single type cell set." << std::endl;
+  vtkm::cont::CellSetSingleType<> cellSet("tetras", NUMBER_OF_POINTS);
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == 0, "Cell set not empty.");
+
+  cellSet.Fill(vtkm::CELL_SHAPE_TETRA,
+               vtkm::cont::make_ArrayHandle(TETRA_CONNECTIVITY,
+                                            TETRA_CONNECTIVITY_LENGTH));
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == NUMBER_OF_TETRAS,
+                   "Wrong number of cells.");
+  VTKM_TEST_ASSERT(cellSet.GetCellShape() == vtkm::CELL_SHAPE_TETRA,
+                   "Wrong cell shape.");
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfPointsInCell() == 4,
+                   "Wrong number of points in cell.");
+
+  const vtkm::UInt8 shapes[NUMBER_OF_TETRAS] = {
+    vtkm::CELL_SHAPE_TETRA, vtkm::CELL_SHAPE_TETRA, vtkm::CELL_SHAPE_TETRA };
+  const vtkm::IdComponent numIndices[NUMBER_OF_TETRAS] = {4, 4, 4};
+  const vtkm::Id offsets[NUMBER_OF_TETRAS] = {0, 4, 8};
+  CheckConnectivity(cellSet, shapes, numIndices, offsets, TETRA_CONNECTIVITY);
+
+  std::cout << "  Checking polygons with a given size." << std::endl;
+  cellSet.Fill(vtkm::CELL_SHAPE_POLYGON,
+               6,
+               vtkm::cont::make_ArrayHandle(TETRA_CONNECTIVITY,
+                                            TETRA_CONNECTIVITY_LENGTH));
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == 2, "Wrong number of cells.");
+  VTKM_TEST_ASSERT(
+        cellSet.GetIndexOffsetArray().GetPortalConstControl().Get(1) == 6,
+        "Wrong implicit offset.");
+
+  std::cout << "  Checking bad connectivity length." << std::endl;
+  try
+  {
+    cellSet.Fill(vtkm::CELL_SHAPE_HEXAHEDRON,
+                 vtkm::cont::make_ArrayHandle(TETRA_CONNECTIVITY,
+                                              TETRA_CONNECTIVITY_LENGTH));
+    VTKM_TEST_FAIL("Bad connectivity length did not throw.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  std::cout << "  Checking shape without fixed size." << std::endl;
+  try
+  {
+    cellSet.Fill(vtkm::CELL_SHAPE_POLYGON,
+                 vtkm::cont::make_ArrayHandle(TETRA_CONNECTIVITY,
+                                              TETRA_CONNECTIVITY_LENGTH));
+    VTKM_TEST_FAIL("Polygon without size did not throw.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestExplicitCellSets()
+{
+  TestCellSetExplicit();
+  TestCellSetSingleType();
+}
+
+} // anonymous namespace
+
+int UnitTestCellSetExplicit(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestExplicitCellSets);
+}
@@ -0,0 +1,260 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/CellSetStructured.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapter.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapterTag;
+typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+// Offsets of the points of a cell from its first point, in the order of the
+// VTK cell shapes.
+vtkm::Id2 PointOffset(const vtkm::Id2 &, vtkm::IdComponent pointInCell)
+{
+  const vtkm::Id offsets[4][2] = { {0,0}, {1,0}, {1,1}, {0,1} };
+  return vtkm::Id2(offsets[pointInCell][0], offsets[pointInCell][1]);
+}
+
+vtkm::Id3 PointOffset(const vtkm::Id3 &, vtkm::IdComponent pointInCell)
+{
+  const vtkm::Id offsets[8][3] = { {0,0,0}, {1,0,0}, {1,1,0}, {0,1,0},
+                                   {0,0,1}, {1,0,1}, {1,1,1}, {0,1,1} };
+  return vtkm::Id3(offsets[pointInCell][0],
+                   offsets[pointInCell][1],
+                   offsets[pointInCell][2]);
+}
+
+// Writes the number of cells incident on each point and the sum of the point
+// indices of each cell.
+template<typename PointToCellType,
+         typename CellToPointType,
+         typename PortalType>
+struct ConnectivityKernel : public vtkm::exec::FunctorBase
+{
+  PointToCellType PointToCell;
+  CellToPointType CellToPoint;
+  PortalType CellsOnPoint;
+  PortalType PointSumOfCell;
+
+  VTKM_CONT_EXPORT
+  ConnectivityKernel(const PointToCellType &pointToCell,
+                     const CellToPointType &cellToPoint,
+                     const PortalType &cellsOnPoint,
+                     const PortalType &pointSumOfCell)
+    : PointToCell(pointToCell),
+      CellToPoint(cellToPoint),
+      CellsOnPoint(cellsOnPoint),
+      PointSumOfCell(pointSumOfCell) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    if (index < this->CellToPoint.GetNumberOfElements())
+    {
+      this->CellsOnPoint.Set(index,
+                             this->CellToPoint.GetNumberOfIndices(index));
+    }
+    if (index < this->PointToCell.GetNumberOfElements())
+    {
+      typename PointToCellType::IndicesType points =
+          this->PointToCell.GetIndices(index);
+      vtkm::Id sum = 0;
+      for (vtkm::IdComponent pointInCell = 0;
+           pointInCell < this->PointToCell.GetNumberOfIndices(index);
+           pointInCell++)
+      {
+        sum += points[pointInCell];
+      }
+      this->PointSumOfCell.Set(index, sum);
+    }
+  }
+};
+
+template<vtkm::IdComponent Dimensions>
+void TestCellSet(const vtkm::Extent<Dimensions> &extent,
+                 vtkm::Id expectedPoints,
+                 vtkm::Id expectedCells,
+                 vtkm::CellShape expectedShape)
+{
+  typedef vtkm::Vec<vtkm::Id,Dimensions> IndexType;
+  vtkm::cont::CellSetStructured<Dimensions> cellSet("cells", extent);
+
+  VTKM_TEST_ASSERT(cellSet.GetName() == "cells", "Wrong name.");
+  VTKM_TEST_ASSERT(cellSet.GetDimensionality() == Dimensions,
+                   "Wrong dimensionality.");
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfPoints() == expectedPoints,
+                   "Wrong number of points.");
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == expectedCells,
+                   "Wrong number of cells.");
+
+  typedef typename vtkm::cont::CellSetStructured<Dimensions>
+      ::template ExecutionTypes<DeviceAdapterTag,
+                                vtkm::TopologyElementTagPoint,
+                                vtkm::TopologyElementTagCell>::ExecObjectType
+      PointToCellType;
+  typedef typename vtkm::cont::CellSetStructured<Dimensions>
+      ::template ExecutionTypes<DeviceAdapterTag,
+                                vtkm::TopologyElementTagCell,
+                                vtkm::TopologyElementTagPoint>::ExecObjectType
+      CellToPointType;
+  PointToCellType pointToCell =
+      cellSet.PrepareForInput(DeviceAdapterTag(),
+                              vtkm::TopologyElementTagPoint(),
+                              vtkm::TopologyElementTagCell());
+  CellToPointType cellToPoint =
+      cellSet.PrepareForInput(DeviceAdapterTag(),
+                              vtkm::TopologyElementTagCell(),
+                              vtkm::TopologyElementTagPoint());
+
+  std::cout << "  Checking points of cells." << std::endl;
+  std::vector<std::vector<vtkm::Id> > cellsOfPoints(
+        static_cast<std::size_t>(expectedPoints));
+  for (vtkm::Id cellIndex = 0; cellIndex < expectedCells; cellIndex++)
+  {
+    VTKM_TEST_ASSERT(pointToCell.GetCellShape(cellIndex) == expectedShape,
+                     "Wrong cell shape.");
+    vtkm::IdComponent numPoints = pointToCell.GetNumberOfIndices(cellIndex);
+    VTKM_TEST_ASSERT(numPoints == vtkm::CellShapeNumberOfPoints(expectedShape),
+                     "Wrong number of points in cell.");
+
+    IndexType cellIjk =
+        vtkm::ExtentCellFlatIndexToTopologyIndex(cellIndex, extent);
+    typename PointToCellType::IndicesType points =
+        pointToCell.GetIndices(cellIndex);
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < numPoints;
+         pointInCell++)
+    {
+      vtkm::Id expectedPoint = vtkm::ExtentPointTopologyIndexToFlatIndex(
+            cellIjk + PointOffset(cellIjk, pointInCell), extent);
+      VTKM_TEST_ASSERT(points[pointInCell] == expectedPoint,
+                       "Wrong point in cell.");
+      VTKM_TEST_ASSERT(
+            pointToCell.GetIndex(cellIndex, pointInCell) == expectedPoint,
+            "Wrong single point in cell.");
+      cellsOfPoints[static_cast<std::size_t>(expectedPoint)].push_back(
+            cellIndex);
+    }
+  }
+  VTKM_TEST_ASSERT(
+        pointToCell.GetIndices(0)[0]
+        == vtkm::ExtentFirstPointOnCell(0, extent),
+        "First point does not match extent.");
+
+  std::cout << "  Checking cells of points." << std::endl;
+  for (vtkm::Id pointIndex = 0; pointIndex < expectedPoints; pointIndex++)
+  {
+    const std::vector<vtkm::Id> &expectedCellsOfPoint =
+        cellsOfPoints[static_cast<std::size_t>(pointIndex)];
+    vtkm::IdComponent numCells = cellToPoint.GetNumberOfIndices(pointIndex);
+    VTKM_TEST_ASSERT(
+          numCells == static_cast<vtkm::IdComponent>(
+            expectedCellsOfPoint.size()),
+          "Wrong number of cells on point.");
+    typename CellToPointType::IndicesType cells =
+        cellToPoint.GetIndices(pointIndex);
+    for (vtkm::IdComponent cellOnPoint = 0;
+         cellOnPoint < CellToPointType::MAX_NUMBER_OF_INDICES;
+         cellOnPoint++)
+    {
+      vtkm::Id expectedCell = (cellOnPoint < numCells)
+          ? expectedCellsOfPoint[static_cast<std::size_t>(cellOnPoint)] : -1;
+      VTKM_TEST_ASSERT(cells[cellOnPoint] == expectedCell,
+                       "Wrong cell on point.");
+    }
+  }
+
+  std::cout << "  Checking connectivity in execution environment."
+            << std::endl;
+  typedef vtkm::cont::ArrayHandle<vtkm::Id> IdArrayHandle;
+  typedef typename IdArrayHandle::template ExecutionTypes<DeviceAdapterTag>
+      ::Portal PortalType;
+  IdArrayHandle cellsOnPoint;
+  IdArrayHandle pointSumOfCell;
+  Algorithm::Schedule(
+        ConnectivityKernel<PointToCellType,CellToPointType,PortalType>(
+          pointToCell,
+          cellToPoint,
+          cellsOnPoint.PrepareForOutput(expectedPoints, DeviceAdapterTag()),
+          pointSumOfCell.PrepareForOutput(expectedCells, DeviceAdapterTag())),
+        expectedPoints);
+
+  VTKM_TEST_ASSERT(
+        Algorithm::Reduce(cellsOnPoint, vtkm::Id(0))
+        == expectedCells*vtkm::CellShapeNumberOfPoints(expectedShape),
+        "Cells on points do not add up to points of cells.");
+  for (vtkm::Id cellIndex = 0; cellIndex < expectedCells; cellIndex++)
+  {
+    typename PointToCellType::IndicesType points =
+        pointToCell.GetIndices(cellIndex);
+    vtkm::Id sum = 0;
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < PointToCellType::MAX_NUMBER_OF_INDICES;
+         pointInCell++)
+    {
+      sum += points[pointInCell];
+    }
+    VTKM_TEST_ASSERT(pointSumOfCell.GetPortalConstControl().Get(cellIndex)
+                     == sum,
+                     "Bad connectivity in execution environment.");
+  }
+}
+
+void TestCellSetStructured()
+{
+  std::cout << "Testing 2D structured cell set." << std::endl;
+  TestCellSet(vtkm::Extent2(vtkm::Id2(-2,1), vtkm::Id2(3,4)),
+              6*4,
+              5*3,
+              vtkm::CELL_SHAPE_QUAD);
+
+  std::cout << "Testing 3D structured cell set." << std::endl;
+  TestCellSet(vtkm::Extent3(vtkm::Id3(1,-1,2), vtkm::Id3(4,3,4)),
+              4*5*3,
+              3*4*2,
+              vtkm::CELL_SHAPE_HEXAHEDRON);
+
+  std::cout << "Testing set extent." << std::endl;
+  vtkm::cont::CellSetStructured<3> cellSet;
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == 0,
+                   "Default cell set is not empty.");
+  cellSet.SetExtent(vtkm::Extent3(vtkm::Id3(0), vtkm::Id3(2)));
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfCells() == 8, "Wrong number of cells.");
+  VTKM_TEST_ASSERT(cellSet.GetNumberOfPoints() == 27,
+                   "Wrong number of points.");
+}
+
+} // anonymous namespace
+
+int UnitTestCellSetStructured(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestCellSetStructured);
+}
@@ -0,0 +1,278 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/DataSet.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+namespace {
+
+typedef vtkm::Vec<vtkm::Float32,3> Vec3;
+
+const vtkm::Id NUMBER_OF_POINTS = 4;
+const Vec3 COORDINATES[NUMBER_OF_POINTS] = {
+  Vec3(0.0f, 0.0f, 0.0f),
+  Vec3(2.0f, 0.0f, -1.0f),
+  Vec3(2.0f, 1.0f, 0.0f),
+  Vec3(0.0f, 1.0f, 3.0f)
+};
+const vtkm::Float32 POINT_VALUES[NUMBER_OF_POINTS] = {
+  10.0f, -2.0f, 5.5f, 7.0f };
+
+const vtkm::Id NUMBER_OF_CELLS = 2;
+const vtkm::Id CONNECTIVITY[NUMBER_OF_CELLS*3] = { 0, 1, 2,  0, 2, 3 };
+const vtkm::Float64 CELL_VALUES[NUMBER_OF_CELLS] = { 100.0, 200.0 };
+
+vtkm::cont::DataSet MakeDataSet()
+{
+  vtkm::cont::DataSet dataSet;
+
+  dataSet.AddCoordinateSystem(
+        vtkm::cont::CoordinateSystem(
+          "coordinates",
+          vtkm::cont::make_ArrayHandle(COORDINATES, NUMBER_OF_POINTS)));
+
+  boost::shared_ptr<vtkm::cont::CellSetSingleType<> > cellSet(
+        new vtkm::cont::CellSetSingleType<>("cells", NUMBER_OF_POINTS, 2));
+  cellSet->Fill(vtkm::CELL_SHAPE_TRIANGLE,
+                vtkm::cont::make_ArrayHandle(CONNECTIVITY,
+                                             NUMBER_OF_CELLS*3));
+  dataSet.AddCellSet(cellSet);
+
+  // Copy the point values so that the test can write to them.
+  vtkm::cont::ArrayHandle<vtkm::Float32> pointValues;
+  vtkm::cont::DeviceAdapterAlgorithm<VTKM_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        vtkm::cont::make_ArrayHandle(POINT_VALUES, NUMBER_OF_POINTS),
+        pointValues);
+  dataSet.AddField(vtkm::cont::Field("pointvar",
+                                     vtkm::cont::Field::ASSOC_POINTS,
+                                     pointValues));
+  dataSet.AddField(vtkm::cont::Field(
+                     "cellvar",
+                     "cells",
+                     vtkm::cont::make_ArrayHandle(CELL_VALUES,
+                                                  NUMBER_OF_CELLS)));
+  return dataSet;
+}
+
+void TestModifiedCount()
+{
+  std::cout << "Testing array modified count." << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Float32> array;
+  vtkm::UInt64 count = array.GetModifiedCount();
+
+  array.PrepareForOutput(NUMBER_OF_POINTS, VTKM_DEFAULT_DEVICE_ADAPTER_TAG());
+  VTKM_TEST_ASSERT(array.GetModifiedCount() != count,
+                   "Output did not change modified count.");
+  count = array.GetModifiedCount();
+
+  vtkm::cont::ArrayHandle<vtkm::Float32> copy = array;
+  copy.GetPortalConstControl();
+  array.PrepareForInput(VTKM_DEFAULT_DEVICE_ADAPTER_TAG());
+  VTKM_TEST_ASSERT(array.GetModifiedCount() == count,
+                   "Reading changed modified count.");
+
+  copy.GetPortalControl();
+  VTKM_TEST_ASSERT(array.GetModifiedCount() != count,
+                   "Writing through a copy did not change modified count.");
+  count = array.GetModifiedCount();
+
+  vtkm::cont::DynamicArrayHandle dynamicArray(array);
+  VTKM_TEST_ASSERT(dynamicArray.IsValid(), "Dynamic array not valid.");
+  VTKM_TEST_ASSERT(dynamicArray.GetNumberOfValues() == NUMBER_OF_POINTS,
+                   "Wrong dynamic array size.");
+  VTKM_TEST_ASSERT(dynamicArray.GetModifiedCount() == count,
+                   "Wrong dynamic array modified count.");
+  array.PrepareForInPlace(VTKM_DEFAULT_DEVICE_ADAPTER_TAG());
+  VTKM_TEST_ASSERT(dynamicArray.GetModifiedCount() != count,
+                   "In place did not change dynamic array modified count.");
+
+  VTKM_TEST_ASSERT(!vtkm::cont::DynamicArrayHandle().IsValid(),
+                   "Empty dynamic array is valid.");
+}
+
+void TestMembers()
+{
+  std::cout << "Testing data set members." << std::endl;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+
+  VTKM_TEST_ASSERT(dataSet.GetNumberOfCoordinateSystems() == 1,
+                   "Wrong number of coordinate systems.");
+  VTKM_TEST_ASSERT(dataSet.GetNumberOfCellSets() == 1,
+                   "Wrong number of cell sets.");
+  VTKM_TEST_ASSERT(dataSet.GetNumberOfFields() == 2,
+                   "Wrong number of fields.");
+
+  VTKM_TEST_ASSERT(dataSet.GetCellSet("cells")->GetNumberOfCells()
+                   == NUMBER_OF_CELLS,
+                   "Wrong cell set.");
+  VTKM_TEST_ASSERT(
+        boost::dynamic_pointer_cast<vtkm::cont::CellSetSingleType<> >(
+          dataSet.GetCellSet()).get() != NULL,
+        "Could not get concrete cell set.");
+
+  VTKM_TEST_ASSERT(dataSet.HasField("pointvar"), "Missing field.");
+  VTKM_TEST_ASSERT(dataSet.HasField("pointvar",
+                                    vtkm::cont::Field::ASSOC_POINTS),
+                   "Missing point field.");
+  VTKM_TEST_ASSERT(!dataSet.HasField("pointvar",
+                                     vtkm::cont::Field::ASSOC_CELL_SET),
+                   "Point field found as cell field.");
+  VTKM_TEST_ASSERT(!dataSet.HasField("nothing"), "Found missing field.");
+
+  const vtkm::cont::Field &cellField = dataSet.GetField("cellvar");
+  VTKM_TEST_ASSERT(cellField.GetAssociation()
+                   == vtkm::cont::Field::ASSOC_CELL_SET,
+                   "Wrong association.");
+  VTKM_TEST_ASSERT(cellField.GetAssocCellSet() == "cells",
+                   "Wrong associated cell set.");
+  VTKM_TEST_ASSERT(cellField.GetData().GetNumberOfValues() == NUMBER_OF_CELLS,
+                   "Wrong cell field size.");
+
+  try
+  {
+    dataSet.GetField("nothing");
+    VTKM_TEST_FAIL("Did not get exception for missing field.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  std::cout << "Replacing a field." << std::endl;
+  dataSet.AddField(vtkm::cont::Field(
+                     "cellvar",
+                     "cells",
+                     vtkm::cont::make_ArrayHandle(CELL_VALUES, 1)));
+  VTKM_TEST_ASSERT(dataSet.GetNumberOfFields() == 2,
+                   "Field was added instead of replaced.");
+  VTKM_TEST_ASSERT(
+        dataSet.GetField("cellvar").GetData().GetNumberOfValues() == 1,
+        "Field was not replaced.");
+}
+
+// Whether ComputeRange has kept the range of a field with its array.
+template<typename T>
+bool IsRangeCached(const vtkm::cont::Field &field, T)
+{
+  std::vector<vtkm::Range> ranges;
+  return vtkm::cont::internal::ArrayRangeComputeGetCached(
+        field.GetData().CastToArrayHandle(T(), VTKM_DEFAULT_STORAGE_TAG()),
+        ranges);
+}
+
+void TestRangeCache()
+{
+  typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+
+  std::cout << "Testing field range cache." << std::endl;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+
+  const vtkm::cont::Field &pointField = dataSet.GetField("pointvar");
+  VTKM_TEST_ASSERT(!IsRangeCached(pointField, vtkm::Float32()),
+                   "Range known before it was computed.");
+  std::vector<vtkm::Range> ranges = pointField.GetRange(Device());
+  VTKM_TEST_ASSERT(ranges.size() == 1, "Wrong number of components.");
+  VTKM_TEST_ASSERT(ranges[0] == vtkm::Range(-2.0, 10.0), "Wrong range.");
+  VTKM_TEST_ASSERT(IsRangeCached(pointField, vtkm::Float32()),
+                   "Range not cached.");
+
+  std::cout << "Checking that shallow copies share the cache." << std::endl;
+  vtkm::cont::DataSet copy = dataSet;
+  VTKM_TEST_ASSERT(IsRangeCached(copy.GetField("pointvar"),
+                                 vtkm::Float32()),
+                   "Copy does not share range cache.");
+  const vtkm::cont::Field &cellField = copy.GetField("cellvar");
+  VTKM_TEST_ASSERT(cellField.GetRange(Device())[0] ==
+                   vtkm::Range(100.0, 200.0),
+                   "Wrong cell range.");
+  VTKM_TEST_ASSERT(IsRangeCached(dataSet.GetField("cellvar"),
+                                 vtkm::Float64()),
+                   "Range computed on copy not shared.");
+
+  std::cout << "Checking that writing invalidates the cache." << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Float32> pointValues =
+      pointField.GetData().CastToArrayHandle(vtkm::Float32(),
+                                             VTKM_DEFAULT_STORAGE_TAG());
+  pointValues.GetPortalControl().Set(1, 20.0f);
+  VTKM_TEST_ASSERT(!IsRangeCached(pointField, vtkm::Float32()),
+                   "Writing did not invalidate range.");
+  VTKM_TEST_ASSERT(!IsRangeCached(copy.GetField("pointvar"),
+                                  vtkm::Float32()),
+                   "Writing did not invalidate range of copy.");
+  VTKM_TEST_ASSERT(pointField.GetRange(Device())[0] ==
+                   vtkm::Range(5.5, 20.0),
+                   "Wrong range after writing.");
+
+  std::cout << "Checking that replacing data does not touch copies."
+            << std::endl;
+  vtkm::cont::Field replacedField = pointField;
+  replacedField.SetData(
+        vtkm::cont::make_ArrayHandle(POINT_VALUES, NUMBER_OF_POINTS));
+  VTKM_TEST_ASSERT(!IsRangeCached(replacedField, vtkm::Float32()),
+                   "Replaced data kept the old range.");
+  VTKM_TEST_ASSERT(IsRangeCached(pointField, vtkm::Float32()),
+                   "Replacing data in a copy invalidated the original.");
+  VTKM_TEST_ASSERT(replacedField.GetRange(Device())[0] ==
+                   vtkm::Range(-2.0, 10.0),
+                   "Wrong range of replaced data.");
+}
+
+void TestBounds()
+{
+  std::cout << "Testing coordinate bounds." << std::endl;
+  vtkm::cont::DataSet dataSet = MakeDataSet();
+  vtkm::Bounds bounds = dataSet.GetCoordinateSystem().GetBounds(
+      VTKM_DEFAULT_DEVICE_ADAPTER_TAG());
+  VTKM_TEST_ASSERT(bounds == vtkm::Bounds(0.0, 2.0, 0.0, 1.0, -1.0, 3.0),
+                   "Wrong bounds.");
+  VTKM_TEST_ASSERT(bounds.Contains(COORDINATES[3]), "Bounds miss a point.");
+  VTKM_TEST_ASSERT(!bounds.Contains(Vec3(3.0f, 0.0f, 0.0f)),
+                   "Bounds contain outside point.");
+  VTKM_TEST_ASSERT(test_equal(bounds.Center(),
+                              vtkm::Vec<vtkm::Float64,3>(1.0, 0.5, 1.0)),
+                   "Wrong center.");
+  VTKM_TEST_ASSERT(!vtkm::Bounds().IsNonEmpty(), "Default bounds not empty.");
+  VTKM_TEST_ASSERT(
+        IsRangeCached(dataSet.GetCoordinateSystem("coordinates"), Vec3()),
+        "Bounds not cached.");
+}
+
+void TestDataSet()
+{
+  TestModifiedCount();
+  TestMembers();
+  TestRangeCache();
+  TestBounds();
+}
+
+} // anonymous namespace
+
+int UnitTestDataSet(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestDataSet);
+}
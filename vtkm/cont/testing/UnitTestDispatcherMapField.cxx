@@ -0,0 +1,263 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/DispatcherMapField.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/DynamicArrayHandle.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/ErrorExecution.h>
+
+#include <vtkm/exec/WorkletMapField.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vtkm/TypeListTag.h>
+
+#include <vector>
+
+namespace {
+
+const vtkm::Id ARRAY_SIZE = 10;
+
+struct Square : public vtkm::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  template<typename T>
+  VTKM_EXEC_EXPORT
+  T operator()(T x) const
+  {
+    return x*x;
+  }
+};
+
+struct MultiplyAdd : public vtkm::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(In), Field(In), Field(Out));
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+
+  template<typename T1, typename T2, typename T3, typename T4>
+  VTKM_EXEC_EXPORT
+  void operator()(const T1 &a, const T2 &b, const T3 &c, T4 &result) const
+  {
+    result = static_cast<T4>(a*b + c);
+  }
+};
+
+struct AddWorkIndex : public vtkm::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(InOut));
+  typedef void ExecutionSignature(_1, WorkIndex);
+
+  template<typename T>
+  VTKM_EXEC_EXPORT
+  void operator()(T &value, vtkm::Id index) const
+  {
+    value = value + static_cast<T>(index);
+  }
+};
+
+struct RaiseOnValue : public vtkm::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In));
+  typedef void ExecutionSignature(_1);
+
+  VTKM_CONT_EXPORT
+  RaiseOnValue(vtkm::Id badValue = -1) : BadValue(badValue) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id value) const
+  {
+    if (value == this->BadValue)
+    {
+      this->RaiseError("Found bad value.");
+    }
+  }
+
+  vtkm::Id BadValue;
+};
+
+template<typename T>
+vtkm::cont::ArrayHandle<T> MakeInputArray(std::vector<T> &buffer)
+{
+  buffer.resize(ARRAY_SIZE);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    buffer[index] = TestValue(index, T());
+  }
+  return vtkm::cont::make_ArrayHandle(buffer);
+}
+
+void TestBasicMap()
+{
+  std::cout << "Testing basic map with array handles." << std::endl;
+  std::vector<vtkm::FloatDefault> buffer;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> input = MakeInputArray(buffer);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> output;
+
+  vtkm::cont::DispatcherMapField<Square> dispatcher;
+  dispatcher.Invoke(input, output);
+
+  VTKM_TEST_ASSERT(output.GetNumberOfValues() == ARRAY_SIZE,
+                   "Output array has wrong size.");
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    vtkm::FloatDefault expected = buffer[index]*buffer[index];
+    VTKM_TEST_ASSERT(
+          test_equal(output.GetPortalConstControl().Get(index), expected),
+          "Got bad squared value.");
+  }
+
+  std::cout << "Testing map with implicit array." << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Id> idOutput;
+  vtkm::cont::DispatcherMapField<Square>().Invoke(
+        vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), ARRAY_SIZE),
+        idOutput);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    VTKM_TEST_ASSERT(idOutput.GetPortalConstControl().Get(index)
+                     == index*index,
+                     "Got bad squared value.");
+  }
+}
+
+void TestMultipleArgumentsAndConstants()
+{
+  std::cout << "Testing map with several inputs and a constant."
+            << std::endl;
+  std::vector<vtkm::Id> buffer;
+  vtkm::cont::ArrayHandle<vtkm::Id> input = MakeInputArray(buffer);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> output;
+
+  vtkm::cont::DispatcherMapField<MultiplyAdd> dispatcher;
+  dispatcher.Invoke(input, vtkm::Id(2), input, output);
+
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    vtkm::FloatDefault expected =
+        static_cast<vtkm::FloatDefault>(3*buffer[index]);
+    VTKM_TEST_ASSERT(
+          test_equal(output.GetPortalConstControl().Get(index), expected),
+          "Got bad multiply-add value.");
+  }
+}
+
+void TestDynamicArrays()
+{
+  std::cout << "Testing map with dynamic arrays." << std::endl;
+  std::vector<vtkm::FloatDefault> buffer;
+  vtkm::cont::DynamicArrayHandle input(MakeInputArray(buffer));
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> output;
+
+  vtkm::cont::DispatcherMapField<Square> dispatcher;
+  dispatcher.Invoke(input.ResetTypeList(vtkm::TypeListTagFieldScalar()),
+                    output);
+
+  VTKM_TEST_ASSERT(output.GetNumberOfValues() == ARRAY_SIZE,
+                   "Output array has wrong size.");
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    vtkm::FloatDefault expected = buffer[index]*buffer[index];
+    VTKM_TEST_ASSERT(
+          test_equal(output.GetPortalConstControl().Get(index), expected),
+          "Got bad squared value.");
+  }
+}
+
+void TestInOutAndWorkIndex()
+{
+  std::cout << "Testing in place map with work index." << std::endl;
+  std::vector<vtkm::Id> buffer;
+  vtkm::cont::ArrayHandle<vtkm::Id> input = MakeInputArray(buffer);
+  vtkm::cont::ArrayHandle<vtkm::Id> inOut;
+  vtkm::cont::DeviceAdapterAlgorithm<VTKM_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        input, inOut);
+
+  vtkm::cont::DispatcherMapField<AddWorkIndex>().Invoke(inOut);
+
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    VTKM_TEST_ASSERT(inOut.GetPortalConstControl().Get(index)
+                     == buffer[index] + index,
+                     "Got bad in place value.");
+  }
+}
+
+void TestErrors()
+{
+  std::cout << "Testing error raised in worklet." << std::endl;
+  std::vector<vtkm::Id> buffer;
+  vtkm::cont::ArrayHandle<vtkm::Id> input = MakeInputArray(buffer);
+
+  bool gotError = false;
+  try
+  {
+    RaiseOnValue worklet(buffer[ARRAY_SIZE/2]);
+    vtkm::cont::DispatcherMapField<RaiseOnValue> dispatcher(worklet);
+    dispatcher.Invoke(input);
+  }
+  catch (vtkm::cont::ErrorExecution error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    VTKM_TEST_ASSERT(error.GetErrorInstance() == ARRAY_SIZE/2,
+                     "Wrong failing instance.");
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Did not get error from worklet.");
+
+  std::cout << "Testing mismatched input sizes." << std::endl;
+  gotError = false;
+  try
+  {
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> output;
+    vtkm::cont::DispatcherMapField<MultiplyAdd>().Invoke(
+          input,
+          input,
+          vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), ARRAY_SIZE/2),
+          output);
+  }
+  catch (vtkm::cont::ErrorControlBadValue error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Did not get error for mismatched sizes.");
+}
+
+void TestDispatcherMapField()
+{
+  TestBasicMap();
+  TestMultipleArgumentsAndConstants();
+  TestDynamicArrays();
+  TestInOutAndWorkIndex();
+  TestErrors();
+}
+
+} // anonymous namespace
+
+int UnitTestDispatcherMapField(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestDispatcherMapField);
+}
@@ -0,0 +1,236 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/exec/FusedWorklet.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/DispatcherMapField.h>
+#include <vtkm/cont/ErrorExecution.h>
+
+#include <vtkm/exec/FunctorBase.h>
+#include <vtkm/exec/WorkletMapField.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const vtkm::Id ARRAY_SIZE = 10;
+
+typedef vtkm::Vec<vtkm::FloatDefault,3> Vec3;
+
+struct Scale
+{
+  vtkm::FloatDefault Factor;
+
+  VTKM_CONT_EXPORT
+  Scale(vtkm::FloatDefault factor = 1) : Factor(factor) {  }
+
+  VTKM_EXEC_EXPORT
+  Vec3 operator()(const Vec3 &value) const
+  {
+    return value*this->Factor;
+  }
+};
+
+struct Clamp
+{
+  vtkm::FloatDefault Low;
+  vtkm::FloatDefault High;
+
+  VTKM_CONT_EXPORT
+  Clamp(vtkm::FloatDefault low = 0, vtkm::FloatDefault high = 1)
+    : Low(low), High(high) {  }
+
+  VTKM_EXEC_EXPORT
+  Vec3 operator()(const Vec3 &value) const
+  {
+    Vec3 result;
+    for (vtkm::IdComponent component = 0; component < 3; component++)
+    {
+      vtkm::FloatDefault x = value[component];
+      result[component] =
+          (x < this->Low) ? this->Low : ((x > this->High) ? this->High : x);
+    }
+    return result;
+  }
+};
+
+struct MagnitudeSquared
+{
+  VTKM_EXEC_EXPORT
+  vtkm::FloatDefault operator()(const Vec3 &value) const
+  {
+    return vtkm::dot(value, value);
+  }
+};
+
+// Wraps a step as a map worklet so that the unfused pipeline can be run for
+// comparison.
+template<typename StepType>
+struct StepWorklet : public vtkm::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef void ExecutionSignature(_1, _2);
+
+  StepType Step;
+
+  VTKM_CONT_EXPORT
+  StepWorklet(const StepType &step = StepType()) : Step(step) {  }
+
+  template<typename InType, typename OutType>
+  VTKM_EXEC_EXPORT
+  void operator()(const InType &input, OutType &output) const
+  {
+    output = this->Step(input);
+  }
+};
+
+struct Square : public vtkm::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef _2 ExecutionSignature(_1);
+
+  template<typename T>
+  VTKM_EXEC_EXPORT
+  T operator()(T x) const
+  {
+    return x*x;
+  }
+};
+
+struct RaiseOnValue : public vtkm::exec::FunctorBase
+{
+  vtkm::Id BadValue;
+
+  VTKM_CONT_EXPORT
+  RaiseOnValue(vtkm::Id badValue = -1) : BadValue(badValue) {  }
+
+  VTKM_EXEC_EXPORT
+  vtkm::Id operator()(vtkm::Id value) const
+  {
+    if (value == this->BadValue)
+    {
+      this->RaiseError("Found bad value.");
+    }
+    return value;
+  }
+};
+
+void TestFusedChain()
+{
+  std::cout << "Testing fused scale, clamp, and magnitude." << std::endl;
+  std::vector<Vec3> buffer(ARRAY_SIZE);
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    buffer[index] = TestValue(index, Vec3());
+  }
+  vtkm::cont::ArrayHandle<Vec3> input = vtkm::cont::make_ArrayHandle(buffer);
+
+  Scale scale(0.05f);
+  Clamp clamp(0.25f, 0.75f);
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> fusedOutput;
+  vtkm::cont::DispatcherMapField<
+      vtkm::exec::FusedWorklet<Scale,Clamp,MagnitudeSquared> >(
+        vtkm::exec::make_FusedWorklet(scale, clamp, MagnitudeSquared()))
+      .Invoke(input, fusedOutput);
+
+  vtkm::cont::ArrayHandle<Vec3> scaled;
+  vtkm::cont::DispatcherMapField<StepWorklet<Scale> >(scale)
+      .Invoke(input, scaled);
+  vtkm::cont::ArrayHandle<Vec3> clamped;
+  vtkm::cont::DispatcherMapField<StepWorklet<Clamp> >(clamp)
+      .Invoke(scaled, clamped);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> unfusedOutput;
+  vtkm::cont::DispatcherMapField<StepWorklet<MagnitudeSquared> >()
+      .Invoke(clamped, unfusedOutput);
+
+  VTKM_TEST_ASSERT(fusedOutput.GetNumberOfValues() == ARRAY_SIZE,
+                   "Fused output has wrong size.");
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    vtkm::FloatDefault fusedValue =
+        fusedOutput.GetPortalConstControl().Get(index);
+    VTKM_TEST_ASSERT(
+          test_equal(fusedValue,
+                     unfusedOutput.GetPortalConstControl().Get(index)),
+          "Fused result differs from separate worklets.");
+    Vec3 expected = clamp(scale(buffer[index]));
+    VTKM_TEST_ASSERT(test_equal(fusedValue, vtkm::dot(expected, expected)),
+                     "Got bad fused value.");
+  }
+}
+
+void TestWorkletSteps()
+{
+  std::cout << "Testing fused map worklets." << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Id> output;
+  vtkm::cont::DispatcherMapField<vtkm::exec::FusedWorklet<Square,Square> >()
+      .Invoke(vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), ARRAY_SIZE),
+              output);
+
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    VTKM_TEST_ASSERT(output.GetPortalConstControl().Get(index)
+                     == index*index*index*index,
+                     "Got bad fused square value.");
+  }
+}
+
+void TestStepErrors()
+{
+  std::cout << "Testing error raised in a fused step." << std::endl;
+  bool gotError = false;
+  try
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> output;
+    vtkm::cont::DispatcherMapField<
+        vtkm::exec::FusedWorklet<Square,RaiseOnValue> >(
+          vtkm::exec::make_FusedWorklet(Square(), RaiseOnValue(4)))
+        .Invoke(vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), ARRAY_SIZE),
+                output);
+  }
+  catch (vtkm::cont::ErrorExecution error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    VTKM_TEST_ASSERT(error.GetErrorInstance() == 2,
+                     "Wrong failing instance.");
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Did not get error from fused step.");
+}
+
+void TestFusedWorklet()
+{
+  TestFusedChain();
+  TestWorkletSteps();
+  TestStepErrors();
+}
+
+} // anonymous namespace
+
+int UnitTestFusedWorklet(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestFusedWorklet);
+}
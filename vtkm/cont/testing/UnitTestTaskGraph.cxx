@@ -0,0 +1,368 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/cont/TaskGraph.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/DispatcherMapField.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/exec/WorkletMapField.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+#ifdef VTKM_USE_STD_THREAD
+#include <atomic>
+#include <chrono>
+#include <thread>
+#endif
+
+namespace {
+
+const vtkm::Id ARRAY_SIZE = 10;
+
+typedef vtkm::cont::ArrayHandle<vtkm::Id> IdArrayHandle;
+
+struct MultiplyAdd : public vtkm::exec::WorkletMapField
+{
+  typedef void ControlSignature(Field(In), Field(In), Field(In), Field(Out));
+  typedef _4 ExecutionSignature(_1, _2, _3);
+
+  VTKM_EXEC_EXPORT
+  vtkm::Id operator()(vtkm::Id a, vtkm::Id b, vtkm::Id c) const
+  {
+    return a*b + c;
+  }
+};
+
+// Task that computes out = a*b + c and records that it ran. Tasks of one
+// wave may run at the same time, so each task has its own flag, and it
+// checks that the tasks it must follow have finished.
+struct MultiplyAddTask
+{
+  IdArrayHandle A;
+  IdArrayHandle B;
+  vtkm::Id C;
+  IdArrayHandle Out;
+  vtkm::Id TaskIndex;
+  vtkm::Id FirstTaskAfter;
+  std::vector<char> *Finished;
+
+  VTKM_CONT_EXPORT
+  MultiplyAddTask(const IdArrayHandle &a,
+                  const IdArrayHandle &b,
+                  vtkm::Id c,
+                  const IdArrayHandle &out,
+                  vtkm::Id taskIndex,
+                  vtkm::Id firstTaskAfter,
+                  std::vector<char> *finished)
+    : A(a),
+      B(b),
+      C(c),
+      Out(out),
+      TaskIndex(taskIndex),
+      FirstTaskAfter(firstTaskAfter),
+      Finished(finished) {  }
+
+  VTKM_CONT_EXPORT
+  void operator()() const
+  {
+    for (vtkm::Id index = 0; index < this->FirstTaskAfter; index++)
+    {
+      VTKM_TEST_ASSERT((*this->Finished)[static_cast<std::size_t>(index)],
+                       "Task ran before a task it depends on.");
+    }
+    IdArrayHandle out = this->Out;
+    vtkm::cont::DispatcherMapField<MultiplyAdd>().Invoke(
+          this->A, this->B, this->C, out);
+    (*this->Finished)[static_cast<std::size_t>(this->TaskIndex)] = 1;
+  }
+};
+
+struct ThrowTask
+{
+  VTKM_CONT_EXPORT
+  void operator()() const
+  {
+    throw vtkm::cont::ErrorControlBadValue("Task failed.");
+  }
+};
+
+struct NoOpTask
+{
+  bool *Ran;
+
+  VTKM_CONT_EXPORT
+  NoOpTask(bool *ran) : Ran(ran) {  }
+
+  VTKM_CONT_EXPORT
+  void operator()() const { *this->Ran = true; }
+};
+
+void CheckWave(const std::vector<vtkm::Id> &wave,
+               vtkm::Id task1,
+               vtkm::Id task2 = -1)
+{
+  VTKM_TEST_ASSERT(wave.size() == ((task2 < 0) ? 1u : 2u),
+                   "Wave has wrong number of tasks.");
+  VTKM_TEST_ASSERT(wave[0] == task1, "Wrong task in wave.");
+  if (task2 >= 0)
+  {
+    VTKM_TEST_ASSERT(wave[1] == task2, "Wrong task in wave.");
+  }
+}
+
+void TestDependencies()
+{
+  std::cout << "Testing dependencies between tasks." << std::endl;
+  IdArrayHandle input;
+  vtkm::cont::DeviceAdapterAlgorithm<VTKM_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), ARRAY_SIZE), input);
+  IdArrayHandle squared;
+  IdArrayHandle squaredPlusOne;
+  IdArrayHandle product;
+  IdArrayHandle final;
+
+  std::vector<char> finished(5, 0);
+  vtkm::cont::TaskGraph graph;
+
+  // Two fields derived from the same input are independent.
+  vtkm::Id squareTask = graph.AddTask(
+        MultiplyAddTask(input, input, 0, squared, 0, 0, &finished));
+  graph.AddInput(squareTask, input);
+  graph.AddOutput(squareTask, squared);
+
+  vtkm::Id squarePlusOneTask = graph.AddTask(
+        MultiplyAddTask(input, input, 1, squaredPlusOne, 1, 0, &finished));
+  graph.AddInput(squarePlusOneTask, input);
+  graph.AddOutput(squarePlusOneTask, squaredPlusOne);
+
+  // Reads both derived fields.
+  vtkm::Id productTask = graph.AddTask(
+        MultiplyAddTask(squared, squaredPlusOne, 1, product, 2, 2, &finished));
+  graph.AddInput(productTask, squared);
+  graph.AddInput(productTask, squaredPlusOne);
+  graph.AddOutput(productTask, product);
+
+  // Overwrites the input, so it must wait for the tasks that read it.
+  vtkm::Id overwriteTask = graph.AddTask(
+        MultiplyAddTask(squared, squaredPlusOne, 0, input, 3, 2, &finished));
+  graph.AddInput(overwriteTask, squared);
+  graph.AddInput(overwriteTask, squaredPlusOne);
+  graph.AddOutput(overwriteTask, input);
+
+  vtkm::Id finalTask = graph.AddTask(
+        MultiplyAddTask(product, input, 0, final, 4, 4, &finished));
+  graph.AddInput(finalTask, product);
+  graph.AddInput(finalTask, input);
+  graph.AddOutput(finalTask, final);
+
+  VTKM_TEST_ASSERT(graph.GetNumberOfTasks() == 5, "Wrong number of tasks.");
+  VTKM_TEST_ASSERT(!graph.DependsOn(squarePlusOneTask, squareTask),
+                   "Independent tasks have a dependency.");
+  VTKM_TEST_ASSERT(graph.DependsOn(productTask, squareTask),
+                   "Missing read after write dependency.");
+  VTKM_TEST_ASSERT(graph.DependsOn(overwriteTask, squareTask),
+                   "Missing write after read dependency.");
+  VTKM_TEST_ASSERT(!graph.DependsOn(overwriteTask, productTask),
+                   "Tasks that only read the same arrays have a dependency.");
+  VTKM_TEST_ASSERT(!graph.DependsOn(squareTask, productTask),
+                   "Earlier task depends on later task.");
+
+  std::vector<std::vector<vtkm::Id> > waves = graph.GetWaves();
+  VTKM_TEST_ASSERT(waves.size() == 3, "Wrong number of waves.");
+  CheckWave(waves[0], squareTask, squarePlusOneTask);
+  CheckWave(waves[1], productTask, overwriteTask);
+  CheckWave(waves[2], finalTask);
+
+  graph.Execute();
+  for (std::size_t index = 0; index < finished.size(); index++)
+  {
+    VTKM_TEST_ASSERT(finished[index], "Not all tasks ran.");
+  }
+
+  VTKM_TEST_ASSERT(final.GetNumberOfValues() == ARRAY_SIZE,
+                   "Final array has wrong size.");
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; index++)
+  {
+    vtkm::Id square = index*index;
+    vtkm::Id expected = (square*(square + 1) + 1)*(square*(square + 1));
+    VTKM_TEST_ASSERT(final.GetPortalConstControl().Get(index) == expected,
+                     "Got bad final value.");
+  }
+}
+
+void TestErrors()
+{
+  std::cout << "Testing error in task." << std::endl;
+  vtkm::cont::TaskGraph graph;
+  IdArrayHandle array;
+  bool ran = false;
+
+  vtkm::Id throwTask = graph.AddTask(ThrowTask());
+  graph.AddOutput(throwTask, array);
+  vtkm::Id laterTask = graph.AddTask(NoOpTask(&ran));
+  graph.AddInput(laterTask, array);
+
+  bool gotError = false;
+  try
+  {
+    graph.Execute();
+  }
+  catch (vtkm::cont::ErrorControlBadValue error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Did not get error from task.");
+  VTKM_TEST_ASSERT(!ran, "Task ran after an earlier task failed.");
+
+  std::cout << "Testing bad task index." << std::endl;
+  gotError = false;
+  try
+  {
+    graph.AddInput(2, array);
+  }
+  catch (vtkm::cont::ErrorControlBadValue error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Did not get error for bad task index.");
+}
+
+#ifdef VTKM_USE_STD_THREAD
+// Task that waits (for a while) until all the tasks that share its counter
+// have started, so it only sees them all if they run at the same time.
+struct WaitForOthersTask
+{
+  std::atomic<vtkm::Id> *Started;
+  vtkm::Id NumberOfTasks;
+  char *SawOthers;
+
+  VTKM_CONT_EXPORT
+  WaitForOthersTask(std::atomic<vtkm::Id> *started,
+                    vtkm::Id numTasks,
+                    char *sawOthers)
+    : Started(started), NumberOfTasks(numTasks), SawOthers(sawOthers) {  }
+
+  VTKM_CONT_EXPORT
+  void operator()() const
+  {
+    (*this->Started)++;
+    std::chrono::steady_clock::time_point giveUp =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((*this->Started < this->NumberOfTasks)
+           && (std::chrono::steady_clock::now() < giveUp))
+    {
+      std::this_thread::yield();
+    }
+    *this->SawOthers = (*this->Started >= this->NumberOfTasks);
+  }
+};
+
+void TestConcurrentWave()
+{
+  std::cout << "Testing that independent tasks run concurrently."
+            << std::endl;
+  const vtkm::Id numTasks = 3;
+  std::atomic<vtkm::Id> started(0);
+  std::vector<char> sawOthers(static_cast<std::size_t>(numTasks), 0);
+  IdArrayHandle input;
+  vtkm::cont::DeviceAdapterAlgorithm<VTKM_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), ARRAY_SIZE), input);
+
+  vtkm::cont::TaskGraph graph;
+  graph.SetNumberOfThreads(static_cast<vtkm::IdComponent>(numTasks));
+  for (vtkm::Id index = 0; index < numTasks; index++)
+  {
+    vtkm::Id task = graph.AddTask(WaitForOthersTask(
+          &started, numTasks, &sawOthers[static_cast<std::size_t>(index)]));
+    graph.AddInput(task, input);
+  }
+  VTKM_TEST_ASSERT(graph.GetWaves().size() == 1, "Wrong number of waves.");
+
+  graph.Execute();
+  VTKM_TEST_ASSERT(started == numTasks, "Not all tasks ran.");
+  for (std::size_t index = 0; index < sawOthers.size(); index++)
+  {
+    VTKM_TEST_ASSERT(sawOthers[index],
+                     "Tasks of one wave did not run at the same time.");
+  }
+}
+#endif //VTKM_USE_STD_THREAD
+
+void TestNumberOfThreads()
+{
+  std::cout << "Testing number of threads." << std::endl;
+  vtkm::cont::TaskGraph graph;
+  VTKM_TEST_ASSERT(graph.GetNumberOfThreads() == 0,
+                   "Wrong default number of threads.");
+
+  // With one thread, the tasks of a wave run in the order they were added.
+  graph.SetNumberOfThreads(1);
+  std::vector<char> finished(3, 0);
+  IdArrayHandle input;
+  vtkm::cont::DeviceAdapterAlgorithm<VTKM_DEFAULT_DEVICE_ADAPTER_TAG>::Copy(
+        vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), ARRAY_SIZE), input);
+  IdArrayHandle outputs[3];
+  for (vtkm::Id index = 0; index < 3; index++)
+  {
+    vtkm::Id task = graph.AddTask(MultiplyAddTask(
+          input, input, index, outputs[index], index, index, &finished));
+    graph.AddInput(task, input);
+    graph.AddOutput(task, outputs[index]);
+  }
+  graph.Execute();
+  VTKM_TEST_ASSERT(finished[2], "Not all tasks ran.");
+
+  bool gotError = false;
+  try
+  {
+    graph.SetNumberOfThreads(-1);
+  }
+  catch (const vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Did not get error for bad number of threads.");
+}
+
+void TestTaskGraph()
+{
+  TestDependencies();
+  TestErrors();
+  TestNumberOfThreads();
+#ifdef VTKM_USE_STD_THREAD
+  TestConcurrentWave();
+#endif
+}
+
+} // anonymous namespace
+
+int UnitTestTaskGraph(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestTaskGraph);
+}
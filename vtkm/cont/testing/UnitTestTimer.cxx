@@ -28,7 +28,16 @@
 
 namespace {
 
-void Time()
+void Wait(vtkm::Id milliseconds)
+{
+#ifndef _WIN32
+  usleep(static_cast<useconds_t>(1000*milliseconds));
+#else
+  Sleep(static_cast<DWORD>(milliseconds));
+#endif
+}
+
+void TestElapsedTime()
 {
   vtkm::cont::Timer<> timer;
 
@@ -46,11 +55,142 @@ void Time()
                    "Timer did not capture full second wait.");
   VTKM_TEST_ASSERT(elapsedTime < 2.0,
                    "Timer counted too far or system really busy.");
+
+  std::cout << "Checking that time never runs backward." << std::endl;
+  vtkm::Float64 previousTime = timer.GetElapsedTime();
+  for (vtkm::Id trial = 0; trial < 1000; trial++)
+  {
+    vtkm::Float64 currentTime = timer.GetElapsedTime();
+    VTKM_TEST_ASSERT(currentTime >= previousTime, "Timer is not monotonic.");
+    previousTime = currentTime;
+  }
+}
+
+void TestLaps()
+{
+  const vtkm::Id NUM_LAPS = 5;
+
+  vtkm::cont::Timer<> timer;
+  VTKM_TEST_ASSERT(timer.GetNumberOfLaps() == 0, "New timer has laps.");
+
+  bool gotError = false;
+  try
+  {
+    timer.GetMeanLapTime();
+  }
+  catch (vtkm::cont::ErrorControlBadValue error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+  }
+  VTKM_TEST_ASSERT(gotError, "Statistics of no laps did not raise error.");
+
+  for (vtkm::Id lapIndex = 0; lapIndex < NUM_LAPS; lapIndex++)
+  {
+    Wait(10*(lapIndex+1));
+    vtkm::Float64 lapTime = timer.Lap();
+    std::cout << "Lap " << lapIndex << ": " << lapTime << std::endl;
+    VTKM_TEST_ASSERT(lapTime >= 0.001*vtkm::Float64(10*(lapIndex+1)),
+                     "Lap did not capture wait.");
+  }
+  vtkm::Float64 elapsedTime = timer.GetElapsedTime();
+
+  VTKM_TEST_ASSERT(timer.GetNumberOfLaps() == NUM_LAPS,
+                   "Wrong number of laps.");
+
+  vtkm::Float64 sum = 0.0;
+  for (vtkm::Id lapIndex = 0; lapIndex < NUM_LAPS; lapIndex++)
+  {
+    sum += timer.GetLapTime(lapIndex);
+  }
+  VTKM_TEST_ASSERT(sum <= elapsedTime, "Laps longer than elapsed time.");
+
+  vtkm::Float64 minimum = timer.GetMinimumLapTime();
+  vtkm::Float64 maximum = timer.GetMaximumLapTime();
+  vtkm::Float64 median = timer.GetMedianLapTime();
+  vtkm::Float64 mean = timer.GetMeanLapTime();
+  vtkm::Float64 deviation = timer.GetLapTimeStandardDeviation();
+  std::cout << "Min: " << minimum << "  Max: " << maximum
+            << "  Median: " << median << "  Mean: " << mean
+            << "  Std dev: " << deviation << std::endl;
+
+  // These hold for any lap times, so they do not depend on how long the
+  // waits actually took.
+  vtkm::Id numAtOrBelowMedian = 0;
+  vtkm::Id numAtOrAboveMedian = 0;
+  for (vtkm::Id lapIndex = 0; lapIndex < NUM_LAPS; lapIndex++)
+  {
+    vtkm::Float64 lapTime = timer.GetLapTime(lapIndex);
+    VTKM_TEST_ASSERT((minimum <= lapTime) && (lapTime <= maximum),
+                     "Lap outside of minimum/maximum.");
+    if (lapTime <= median) { numAtOrBelowMedian++; }
+    if (lapTime >= median) { numAtOrAboveMedian++; }
+  }
+  VTKM_TEST_ASSERT((2*numAtOrBelowMedian >= NUM_LAPS)
+                   && (2*numAtOrAboveMedian >= NUM_LAPS),
+                   "Bad median lap.");
+  VTKM_TEST_ASSERT(test_equal(mean, sum/NUM_LAPS), "Bad mean lap.");
+  VTKM_TEST_ASSERT((deviation >= 0)
+                   && (deviation <= maximum - minimum + 1e-9),
+                   "Bad lap standard deviation.");
+
+  std::cout << "Checking reset and clear of laps." << std::endl;
+  // Let time pass since the last lap so that a lap measured from before the
+  // reset would be noticeably longer than one measured from the reset.
+  Wait(100);
+  vtkm::Float64 elapsedBeforeReset = timer.GetElapsedTime();
+  timer.Reset();
+  VTKM_TEST_ASSERT(timer.GetNumberOfLaps() == NUM_LAPS,
+                   "Reset should not clear laps.");
+  vtkm::Float64 lapAfterReset = timer.Lap();
+  std::cout << "Elapsed before reset: " << elapsedBeforeReset
+            << "  Lap after reset: " << lapAfterReset << std::endl;
+  VTKM_TEST_ASSERT(lapAfterReset >= 0.0, "Negative lap after reset.");
+  VTKM_TEST_ASSERT(lapAfterReset < elapsedBeforeReset,
+                   "Lap after reset not measured from the reset.");
+  VTKM_TEST_ASSERT(timer.GetNumberOfLaps() == NUM_LAPS + 1,
+                   "Lap after reset not recorded.");
+  timer.ClearLaps();
+  VTKM_TEST_ASSERT(timer.GetNumberOfLaps() == 0, "Laps not cleared.");
+}
+
+void TestCPUTime()
+{
+  vtkm::cont::Timer<> timer;
+
+  // Do some busy work so that there is measurable processor time.
+  volatile vtkm::Float64 accumulator = 0.0;
+  for (vtkm::Id count = 0; count < 10000000; count++)
+  {
+    accumulator = accumulator + 1.0;
+  }
+
+  vtkm::Float64 cpuTime = timer.GetElapsedCPUTime();
+  vtkm::Int64 cycles = timer.GetElapsedCycles();
+  std::cout << "CPU time: " << cpuTime << std::endl;
+  std::cout << "Cycles: " << cycles << std::endl;
+
+  VTKM_TEST_ASSERT(cpuTime >= 0.0, "Negative CPU time.");
+  if (vtkm::cont::Timer<>::HasCycleCounter())
+  {
+    VTKM_TEST_ASSERT(cycles > 0, "Cycle counter did not advance.");
+  }
+  else
+  {
+    VTKM_TEST_ASSERT(cycles == 0, "Cycle count reported without counter.");
+  }
+}
+
+void TestTimer()
+{
+  TestElapsedTime();
+  TestLaps();
+  TestCPUTime();
 }
 
 } // anonymous namespace
 
 int UnitTestTimer(int, char *[])
 {
-  return vtkm::cont::testing::Testing::Run(Time);
+  return vtkm::cont::testing::Testing::Run(TestTimer);
 }
@@ -0,0 +1,114 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_exec_ConnectivityExplicit_h
+#define vtk_m_exec_ConnectivityExplicit_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/Types.h>
+
+namespace vtkm {
+namespace exec {
+
+/// \brief Execution object for explicit connectivity.
+///
+/// The connectivity is held in compressed sparse row form: the indices of
+/// element \c i are the \c NumIndices[i] entries of \c Connectivity that
+/// start at \c IndexOffsets[i]. The portals can be any readable portals, so
+/// implicit portals can stand in for arrays that follow a pattern (such as
+/// the offsets of cells that all have the same number of points).
+///
+template<typename ShapePortalType,
+         typename NumIndicesPortalType,
+         typename ConnectivityPortalType,
+         typename IndexOffsetPortalType>
+class ConnectivityExplicit
+{
+public:
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityExplicit() {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityExplicit(const ShapePortalType &shapes,
+                       const NumIndicesPortalType &numIndices,
+                       const ConnectivityPortalType &connectivity,
+                       const IndexOffsetPortalType &indexOffsets)
+    : Shapes(shapes),
+      NumIndices(numIndices),
+      Connectivity(connectivity),
+      IndexOffsets(indexOffsets) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfElements() const {
+    return this->Shapes.GetNumberOfValues();
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::CellShape GetCellShape(vtkm::Id index) const {
+    return static_cast<vtkm::CellShape>(this->Shapes.Get(index));
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::IdComponent GetNumberOfIndices(vtkm::Id index) const {
+    return static_cast<vtkm::IdComponent>(this->NumIndices.Get(index));
+  }
+
+  /// The location in the connectivity array of the first index of the given
+  /// element.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetIndexOffset(vtkm::Id index) const {
+    return this->IndexOffsets.Get(index);
+  }
+
+  /// The index at position \c which of the given element, which must be less
+  /// than the number of indices of the element.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetIndex(vtkm::Id index, vtkm::IdComponent which) const {
+    return this->Connectivity.Get(this->IndexOffsets.Get(index) + which);
+  }
+
+  /// Copies the indices of the given element into \c ids. If the element has
+  /// more indices than fit in \c ids, only the first ones are copied.
+  ///
+  template<vtkm::IdComponent Size>
+  VTKM_EXEC_CONT_EXPORT
+  void GetIndices(vtkm::Id index, vtkm::Vec<vtkm::Id,Size> &ids) const
+  {
+    vtkm::IdComponent numIndices = this->GetNumberOfIndices(index);
+    if (numIndices > Size) { numIndices = Size; }
+    vtkm::Id offset = this->IndexOffsets.Get(index);
+    for (vtkm::IdComponent i = 0; i < numIndices; i++)
+    {
+      ids[i] = this->Connectivity.Get(offset + i);
+    }
+  }
+
+private:
+  ShapePortalType Shapes;
+  NumIndicesPortalType NumIndices;
+  ConnectivityPortalType Connectivity;
+  IndexOffsetPortalType IndexOffsets;
+};
+
+}
+} // namespace vtkm::exec
+
+#endif //vtk_m_exec_ConnectivityExplicit_h
@@ -0,0 +1,152 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_exec_ConnectivityStructured_h
+#define vtk_m_exec_ConnectivityStructured_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/internal/ConnectivityStructuredInternals.h>
+
+namespace vtkm {
+namespace exec {
+
+/// \brief Execution object for the connectivity of a structured cell set.
+///
+/// This object maps each element of type \c ToTopology to the incident
+/// elements of type \c FromTopology. GetIndices for the map from points to
+/// cells returns the points of a cell, and for the map from cells to points
+/// returns the cells incident on a point. Nothing is stored beyond the
+/// dimensions of the grid; the indices are computed as they are requested.
+///
+/// Objects of this type are returned from CellSetStructured::PrepareForInput.
+/// They may also be used in the control environment.
+///
+template<typename FromTopology,
+         typename ToTopology,
+         vtkm::IdComponent Dimensions>
+class ConnectivityStructured;
+
+template<vtkm::IdComponent Dimensions>
+class ConnectivityStructured<
+    vtkm::TopologyElementTagPoint,vtkm::TopologyElementTagCell,Dimensions>
+{
+  typedef vtkm::internal::ConnectivityStructuredInternals<Dimensions>
+      InternalsType;
+
+public:
+  static const vtkm::IdComponent MAX_NUMBER_OF_INDICES =
+      InternalsType::NUM_POINTS_IN_CELL;
+  typedef typename InternalsType::PointsOfCellType IndicesType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityStructured() {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityStructured(const InternalsType &internals)
+    : Internals(internals) {  }
+
+  /// The number of cells.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfElements() const {
+    return this->Internals.GetNumberOfCells();
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::IdComponent GetNumberOfIndices(vtkm::Id) const {
+    return InternalsType::NUM_POINTS_IN_CELL;
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::CellShape GetCellShape(vtkm::Id) const {
+    return this->Internals.GetCellShape();
+  }
+
+  /// The points of the given cell.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  IndicesType GetIndices(vtkm::Id cellIndex) const {
+    return this->Internals.GetPointsOfCell(cellIndex);
+  }
+
+  /// One point of the given cell. This is the same as an entry of
+  /// GetIndices, for code that also works with explicit connectivity.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetIndex(vtkm::Id cellIndex, vtkm::IdComponent which) const {
+    return this->Internals.GetPointsOfCell(cellIndex)[which];
+  }
+
+private:
+  InternalsType Internals;
+};
+
+template<vtkm::IdComponent Dimensions>
+class ConnectivityStructured<
+    vtkm::TopologyElementTagCell,vtkm::TopologyElementTagPoint,Dimensions>
+{
+  typedef vtkm::internal::ConnectivityStructuredInternals<Dimensions>
+      InternalsType;
+
+public:
+  static const vtkm::IdComponent MAX_NUMBER_OF_INDICES =
+      InternalsType::MAX_CELLS_ON_POINT;
+  typedef typename InternalsType::CellsOfPointType IndicesType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityStructured() {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityStructured(const InternalsType &internals)
+    : Internals(internals) {  }
+
+  /// The number of points.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfElements() const {
+    return this->Internals.GetNumberOfPoints();
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::IdComponent GetNumberOfIndices(vtkm::Id pointIndex) const {
+    vtkm::IdComponent numberOfCells;
+    this->Internals.GetCellsOfPoint(pointIndex, numberOfCells);
+    return numberOfCells;
+  }
+
+  /// The cells incident on the given point. Entries past the number of
+  /// indices are -1.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  IndicesType GetIndices(vtkm::Id pointIndex) const {
+    vtkm::IdComponent numberOfCells;
+    return this->Internals.GetCellsOfPoint(pointIndex, numberOfCells);
+  }
+
+private:
+  InternalsType Internals;
+};
+
+}
+} // namespace vtkm::exec
+
+#endif //vtk_m_exec_ConnectivityStructured_h
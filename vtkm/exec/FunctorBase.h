@@ -32,7 +32,14 @@ namespace exec {
 /// implement operator() const with an index argument.
 ///
 /// This class contains a public method named RaiseError that can be called in
-/// the execution environment to signal a problem.
+/// the execution environment to signal a problem. Once any instance has raised
+/// an error, the device adapter stops scheduling further instances and
+/// IsErrorRaised returns true, so long-running functors can poll it to finish
+/// early.
+///
+/// Search-style functors that find their answer before all instances have run
+/// can call Cancel to stop the device adapter from dispatching the remaining
+/// instances. Unlike RaiseError, cancelling does not cause Schedule to throw.
 ///
 class FunctorBase
 {
@@ -46,6 +53,32 @@ public:
     this->ErrorMessage.RaiseError(message);
   }
 
+  /// Returns true if any instance of this functor has raised an error. This is
+  /// a single read of shared memory and is cheap enough to call inside loops.
+  ///
+  VTKM_EXEC_EXPORT
+  bool IsErrorRaised() const
+  {
+    return this->ErrorMessage.IsErrorRaised();
+  }
+
+  /// Asks the device adapter to stop dispatching instances that have not yet
+  /// started. Instances already running finish normally.
+  ///
+  VTKM_EXEC_EXPORT
+  void Cancel() const
+  {
+    this->ErrorMessage.Cancel();
+  }
+
+  /// Returns true if any instance has cancelled execution or raised an error.
+  ///
+  VTKM_EXEC_EXPORT
+  bool IsCancelled() const
+  {
+    return this->ErrorMessage.IsCancelled();
+  }
+
   /// Set the error message buffer so that running algorithms can report
   /// errors. This is supposed to be set by the dispatcher. This method may be
   /// replaced as the execution semantics change.
@@ -0,0 +1,209 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_exec_FusedWorklet_h
+#define vtk_m_exec_FusedWorklet_h
+
+#include <vtkm/exec/FunctorBase.h>
+#include <vtkm/exec/WorkletMapField.h>
+
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/utility/enable_if.hpp>
+
+namespace vtkm {
+namespace exec {
+
+namespace internal {
+
+/// Step that passes its value through unchanged. FusedWorklet uses it to fill
+/// the steps that are not given.
+///
+struct FusedWorkletIdentity
+{
+  template<typename T>
+  VTKM_EXEC_EXPORT
+  T operator()(const T &value) const { return value; }
+};
+
+namespace detail {
+
+// Steps that derive from FunctorBase (such as other worklets) may call
+// RaiseError or Cancel, so they get the error buffer of the fused worklet.
+// Other steps are plain functors and are left alone.
+template<typename StepType>
+VTKM_CONT_EXPORT
+typename boost::enable_if<
+    boost::is_base_of<vtkm::exec::FunctorBase,StepType> >::type
+FusedWorkletSetStepErrorBuffer(
+    StepType &step, const vtkm::exec::internal::ErrorMessageBuffer &buffer)
+{
+  step.SetErrorMessageBuffer(buffer);
+}
+
+template<typename StepType>
+VTKM_CONT_EXPORT
+typename boost::disable_if<
+    boost::is_base_of<vtkm::exec::FunctorBase,StepType> >::type
+FusedWorkletSetStepErrorBuffer(
+    StepType &, const vtkm::exec::internal::ErrorMessageBuffer &)
+{  }
+
+} // namespace detail
+
+} // namespace internal
+
+/// \brief A map worklet that applies a chain of elementwise steps.
+///
+/// Running a pipeline such as "scale, then clamp, then magnitude" as separate
+/// worklets writes a full intermediate array after every step and reads it
+/// back in the next one. A FusedWorklet applies all the steps to each value
+/// in a single instance, so the chain reads its input and writes its output
+/// once per value and allocates no intermediate arrays.
+///
+/// Each step is a unary functor with an operator() const that can be called
+/// in the execution environment. The steps are applied in order, with the
+/// result of each step passed to the next. The type of each intermediate
+/// value is whatever the step returns, so steps may change types (for example
+/// from a vector to its magnitude). Map worklets with an \c ExecutionSignature
+/// of <tt>_2(_1)</tt> can be used directly as steps. Steps that derive from
+/// FunctorBase may raise errors.
+///
+/// The \c ControlSignature is <tt>void(Field(In), Field(Out))</tt>, so a
+/// fused chain is run with vtkm::cont::DispatcherMapField like any other map
+/// worklet. Use make_FusedWorklet to build one without spelling out the
+/// types.
+///
+template<typename StepType1,
+         typename StepType2,
+         typename StepType3 = vtkm::exec::internal::FusedWorkletIdentity,
+         typename StepType4 = vtkm::exec::internal::FusedWorkletIdentity,
+         typename StepType5 = vtkm::exec::internal::FusedWorkletIdentity>
+class FusedWorklet : public vtkm::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(Field(In), Field(Out));
+  typedef void ExecutionSignature(_1, _2);
+
+  VTKM_CONT_EXPORT
+  FusedWorklet(const StepType1 &step1 = StepType1(),
+               const StepType2 &step2 = StepType2(),
+               const StepType3 &step3 = StepType3(),
+               const StepType4 &step4 = StepType4(),
+               const StepType5 &step5 = StepType5())
+    : Step1(step1), Step2(step2), Step3(step3), Step4(step4), Step5(step5)
+  {  }
+
+  template<typename InType, typename OutType>
+  VTKM_EXEC_EXPORT
+  void operator()(const InType &input, OutType &output) const
+  {
+    // The steps are nested in a single expression so that the type of each
+    // intermediate value never has to be named.
+    output = static_cast<OutType>(
+          this->Step5(this->Step4(this->Step3(this->Step2(this->Step1(
+            input))))));
+  }
+
+  /// Sets the error message buffer of this worklet and of any steps that are
+  /// functors themselves.
+  ///
+  VTKM_CONT_EXPORT
+  void SetErrorMessageBuffer(
+      const vtkm::exec::internal::ErrorMessageBuffer &buffer)
+  {
+    this->WorkletMapField::SetErrorMessageBuffer(buffer);
+    internal::detail::FusedWorkletSetStepErrorBuffer(this->Step1, buffer);
+    internal::detail::FusedWorkletSetStepErrorBuffer(this->Step2, buffer);
+    internal::detail::FusedWorkletSetStepErrorBuffer(this->Step3, buffer);
+    internal::detail::FusedWorkletSetStepErrorBuffer(this->Step4, buffer);
+    internal::detail::FusedWorkletSetStepErrorBuffer(this->Step5, buffer);
+  }
+
+private:
+  StepType1 Step1;
+  StepType2 Step2;
+  StepType3 Step3;
+  StepType4 Step4;
+  StepType5 Step5;
+};
+
+/// Creates a FusedWorklet that applies the given steps in order.
+///
+template<typename StepType1, typename StepType2>
+VTKM_CONT_EXPORT
+vtkm::exec::FusedWorklet<StepType1,StepType2>
+make_FusedWorklet(const StepType1 &step1, const StepType2 &step2)
+{
+  return vtkm::exec::FusedWorklet<StepType1,StepType2>(step1, step2);
+}
+
+/// Creates a FusedWorklet that applies the given steps in order.
+///
+template<typename StepType1, typename StepType2, typename StepType3>
+VTKM_CONT_EXPORT
+vtkm::exec::FusedWorklet<StepType1,StepType2,StepType3>
+make_FusedWorklet(const StepType1 &step1,
+                  const StepType2 &step2,
+                  const StepType3 &step3)
+{
+  return vtkm::exec::FusedWorklet<StepType1,StepType2,StepType3>(
+        step1, step2, step3);
+}
+
+/// Creates a FusedWorklet that applies the given steps in order.
+///
+template<typename StepType1,
+         typename StepType2,
+         typename StepType3,
+         typename StepType4>
+VTKM_CONT_EXPORT
+vtkm::exec::FusedWorklet<StepType1,StepType2,StepType3,StepType4>
+make_FusedWorklet(const StepType1 &step1,
+                  const StepType2 &step2,
+                  const StepType3 &step3,
+                  const StepType4 &step4)
+{
+  return vtkm::exec::FusedWorklet<StepType1,StepType2,StepType3,StepType4>(
+        step1, step2, step3, step4);
+}
+
+/// Creates a FusedWorklet that applies the given steps in order.
+///
+template<typename StepType1,
+         typename StepType2,
+         typename StepType3,
+         typename StepType4,
+         typename StepType5>
+VTKM_CONT_EXPORT
+vtkm::exec::FusedWorklet<StepType1,StepType2,StepType3,StepType4,StepType5>
+make_FusedWorklet(const StepType1 &step1,
+                  const StepType2 &step2,
+                  const StepType3 &step3,
+                  const StepType4 &step4,
+                  const StepType5 &step5)
+{
+  return vtkm::exec::FusedWorklet<
+      StepType1,StepType2,StepType3,StepType4,StepType5>(
+        step1, step2, step3, step4, step5);
+}
+
+}
+} // namespace vtkm::exec
+
+#endif //vtk_m_exec_FusedWorklet_h
@@ -0,0 +1,78 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_exec_WorkletMapField_h
+#define vtk_m_exec_WorkletMapField_h
+
+#include <vtkm/exec/internal/WorkletBase.h>
+
+namespace vtkm {
+namespace exec {
+
+/// Base class for worklets that map each value of one or more fields to new
+/// values, one instance per field value. The \c ControlSignature of a
+/// subclass has one \c Field tag for each argument of the dispatcher's
+/// Invoke, modified by the direction of the data:
+///
+/// \li <tt>Field(In)</tt> is read. The argument is either an ArrayHandle
+/// (or DynamicArrayHandle), which determines the number of instances, or a
+/// single value that is passed to every instance.
+/// \li <tt>Field(Out)</tt> is an ArrayHandle that is allocated to the number
+/// of instances and written.
+/// \li <tt>Field(InOut)</tt> is an ArrayHandle that is read and written in
+/// place.
+///
+/// \code{.cpp}
+/// struct Square : public vtkm::exec::WorkletMapField
+/// {
+///   typedef void ControlSignature(Field(In), Field(Out));
+///   typedef _2 ExecutionSignature(_1);
+///
+///   template<typename T>
+///   VTKM_EXEC_EXPORT
+///   T operator()(T x) const { return x*x; }
+/// };
+/// \endcode
+///
+/// Worklets of this type are run with vtkm::cont::DispatcherMapField.
+///
+class WorkletMapField : public vtkm::exec::internal::WorkletBase
+{
+public:
+  /// Control signature tag for an argument holding one value per instance.
+  ///
+  struct Field {  };
+
+  /// Modifier for \c Field: the values are only read.
+  ///
+  struct In {  };
+
+  /// Modifier for \c Field: the values are only written.
+  ///
+  struct Out {  };
+
+  /// Modifier for \c Field: the values are read and written in place.
+  ///
+  struct InOut {  };
+};
+
+}
+} // namespace vtkm::exec
+
+#endif //vtk_m_exec_WorkletMapField_h
@@ -0,0 +1,135 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_exec_internal_AtomicOperations_h
+#define vtk_m_exec_internal_AtomicOperations_h
+
+#include <vtkm/Types.h>
+
+#if defined(_MSC_VER) && !defined(__CUDA_ARCH__)
+#include <intrin.h>
+#endif
+
+namespace vtkm {
+namespace exec {
+namespace internal {
+
+// These are the minimal atomic primitives needed for coordinating the threads
+// of a scheduled functor (for example, claiming the error message buffer).
+// They operate on plain integers shared by all instances and return the value
+// stored at the address before the operation. Compilers without a known
+// intrinsic fall back to plain (non-atomic) operations, which is only correct
+// for serial execution.
+
+/// Atomically adds \c value to the integer at \c address and returns the
+/// value that was stored there before the addition.
+///
+VTKM_EXEC_EXPORT
+vtkm::Int32 AtomicAdd(vtkm::Int32 *address, vtkm::Int32 value)
+{
+#if defined(__CUDA_ARCH__)
+  return atomicAdd(address, value);
+#elif defined(_MSC_VER)
+  return _InterlockedExchangeAdd(reinterpret_cast<volatile long *>(address),
+                                 value);
+#elif defined(__GNUC__)
+  return __sync_fetch_and_add(address, value);
+#else
+  vtkm::Int32 oldValue = *address;
+  *address = oldValue + value;
+  return oldValue;
+#endif
+}
+
+/// Atomically adds \c value to the integer at \c address and returns the
+/// value that was stored there before the addition.
+///
+VTKM_EXEC_EXPORT
+vtkm::Int64 AtomicAdd(vtkm::Int64 *address, vtkm::Int64 value)
+{
+#if defined(__CUDA_ARCH__)
+  return static_cast<vtkm::Int64>(
+        atomicAdd(reinterpret_cast<unsigned long long *>(address),
+                  static_cast<unsigned long long>(value)));
+#elif defined(_MSC_VER)
+  return _InterlockedExchangeAdd64(address, value);
+#elif defined(__GNUC__)
+  return __sync_fetch_and_add(address, value);
+#else
+  vtkm::Int64 oldValue = *address;
+  *address = oldValue + value;
+  return oldValue;
+#endif
+}
+
+/// Atomically replaces the integer at \c address with \c newValue if it is
+/// currently equal to \c expected. Returns the value that was stored at
+/// \c address before the operation, so the swap succeeded if and only if the
+/// returned value equals \c expected.
+///
+VTKM_EXEC_EXPORT
+vtkm::Int32 AtomicCompareAndSwap(vtkm::Int32 *address,
+                                 vtkm::Int32 expected,
+                                 vtkm::Int32 newValue)
+{
+#if defined(__CUDA_ARCH__)
+  return atomicCAS(address, expected, newValue);
+#elif defined(_MSC_VER)
+  return _InterlockedCompareExchange(
+        reinterpret_cast<volatile long *>(address), newValue, expected);
+#elif defined(__GNUC__)
+  return __sync_val_compare_and_swap(address, expected, newValue);
+#else
+  vtkm::Int32 oldValue = *address;
+  if (oldValue == expected) { *address = newValue; }
+  return oldValue;
+#endif
+}
+
+/// Atomically replaces the integer at \c address with \c newValue if it is
+/// currently equal to \c expected. Returns the value that was stored at
+/// \c address before the operation, so the swap succeeded if and only if the
+/// returned value equals \c expected.
+///
+VTKM_EXEC_EXPORT
+vtkm::Int64 AtomicCompareAndSwap(vtkm::Int64 *address,
+                                 vtkm::Int64 expected,
+                                 vtkm::Int64 newValue)
+{
+#if defined(__CUDA_ARCH__)
+  return static_cast<vtkm::Int64>(
+        atomicCAS(reinterpret_cast<unsigned long long *>(address),
+                  static_cast<unsigned long long>(expected),
+                  static_cast<unsigned long long>(newValue)));
+#elif defined(_MSC_VER)
+  return _InterlockedCompareExchange64(address, newValue, expected);
+#elif defined(__GNUC__)
+  return __sync_val_compare_and_swap(address, expected, newValue);
+#else
+  vtkm::Int64 oldValue = *address;
+  if (oldValue == expected) { *address = newValue; }
+  return oldValue;
+#endif
+}
+
+}
+}
+} // namespace vtkm::exec::internal
+
+#endif //vtk_m_exec_internal_AtomicOperations_h
@@ -22,10 +22,56 @@
 
 #include <vtkm/Types.h>
 
+#include <vtkm/exec/internal/AtomicOperations.h>
+
 namespace vtkm {
 namespace exec {
 namespace internal {
 
+/// Bookkeeping shared by all instances of a scheduled functor that report
+/// errors through the same ErrorMessageBuffer. The device adapter places one
+/// of these in memory visible to every thread and calls Reset before
+/// scheduling. Only the instance that wins the atomic claim on \c Claimed
+/// writes the message, so concurrent errors can never mangle it, and it
+/// marks the claim as published only once the message is complete.
+///
+/// The state also holds the cancellation token of the scheduled functor. Any
+/// instance can set it to tell the device adapter that the remaining work is
+/// not needed, and raising an error sets it as well.
+///
+struct ErrorMessageState
+{
+  /// 0 while no error was raised, CLAIMED while the instance that owns the
+  /// message is writing it, and PUBLISHED once the message is complete.
+  ///
+  vtkm::Int32 Claimed;
+
+  static const vtkm::Int32 CLAIMED = 1;
+  static const vtkm::Int32 PUBLISHED = 2;
+
+  /// The number of instances that raised an error. Because execution stops
+  /// early once an error is raised, this counts the errors raised before the
+  /// device adapter stopped scheduling, not every instance that would fail.
+  ///
+  vtkm::Id NumberOfErrors;
+
+  /// The instance that raised the recorded message, or -1 if it is unknown.
+  ///
+  vtkm::Id ErrorInstance;
+
+  /// Nonzero once an instance has cancelled execution or raised an error.
+  ///
+  vtkm::Int32 Cancelled;
+
+  VTKM_EXEC_CONT_EXPORT void Reset()
+  {
+    this->Cancelled = 0;
+    this->Claimed = 0;
+    this->NumberOfErrors = 0;
+    this->ErrorInstance = -1;
+  }
+};
+
 /// Used to hold an error in the execution environment until the parallel
 /// execution can complete. This is to be used in conjunction with a
 /// DeviceAdapter's Schedule function to implement errors in execution
@@ -34,6 +80,13 @@ namespace internal {
 /// terminator), then we consider it as no error. Otherwise, the array contains
 /// the string describing the error.
 ///
+/// When the buffer is also given an ErrorMessageState, errors are recorded
+/// atomically: the first instance to raise an error writes the message and
+/// then publishes it, and every raised error is counted. IsErrorRaised
+/// reduces to a single read of the published flag, so long-running functors
+/// can poll it and exit early, and a reader that sees an error always sees
+/// its whole message.
+///
 /// Before scheduling worklets, the global array should be cleared to have no
 /// error. This can only be reliably done by the device adapter.
 ///
@@ -41,37 +94,75 @@ class ErrorMessageBuffer
 {
 public:
   VTKM_EXEC_CONT_EXPORT ErrorMessageBuffer()
-    : MessageBuffer(), MessageBufferSize(0) {  }
+    : MessageBuffer(), MessageBufferSize(0), State(NULL) {  }
 
   VTKM_EXEC_CONT_EXPORT
   ErrorMessageBuffer(char *messageBuffer, vtkm::Id bufferSize)
-    : MessageBuffer(messageBuffer), MessageBufferSize(bufferSize) { }
+    : MessageBuffer(messageBuffer),
+      MessageBufferSize(bufferSize),
+      State(NULL) { }
+
+  VTKM_EXEC_CONT_EXPORT
+  ErrorMessageBuffer(char *messageBuffer,
+                     vtkm::Id bufferSize,
+                     vtkm::exec::internal::ErrorMessageState *state)
+    : MessageBuffer(messageBuffer),
+      MessageBufferSize(bufferSize),
+      State(state) { }
 
   VTKM_EXEC_EXPORT void RaiseError(const char *message) const
   {
-    // Only raise the error if one has not been raised yet. This check is not
-    // guaranteed to work across threads. However, chances are that if two or
-    // more threads simultaneously pass this test, they will be writing the
-    // same error, which is fine. Even in the much less likely case that two
-    // threads simultaneously write different error messages, the worst case is
-    // that you get a mangled message. That's not good (and it's what we are
-    // trying to avoid), but it's not critical.
-    if (this->IsErrorRaised()) { return; }
+    this->RaiseError(message, -1);
+  }
 
-    // Safely copy message into array.
-    for (vtkm::Id index = 0; index < this->MessageBufferSize; index++)
+  /// Raises an error and records \c instance as the index of the failing
+  /// instance if this is the error whose message is kept.
+  ///
+  VTKM_EXEC_EXPORT void RaiseError(const char *message, vtkm::Id instance) const
+  {
+    if (this->State != NULL)
     {
-      this->MessageBuffer[index] = message[index];
-      if (message[index] == '\0') { break; }
+      this->Cancel();
+      bool owner = (vtkm::exec::internal::AtomicCompareAndSwap(
+                      &this->State->Claimed,
+                      0,
+                      ErrorMessageState::CLAIMED) == 0);
+      if (owner)
+      {
+        this->State->ErrorInstance = instance;
+        this->WriteMessage(message);
+      }
+      vtkm::exec::internal::AtomicAdd(&this->State->NumberOfErrors,
+                                      static_cast<vtkm::Id>(1));
+      if (owner)
+      {
+        // The atomic swap orders the writes above before the flag, so
+        // anyone who sees the error published sees the whole message.
+        vtkm::exec::internal::AtomicCompareAndSwap(
+              &this->State->Claimed,
+              ErrorMessageState::CLAIMED,
+              ErrorMessageState::PUBLISHED);
+      }
+      return;
+    }
+    else if (this->IsErrorRaised())
+    {
+      // Without shared state, only raise the error if one has not been raised
+      // yet. This check is not guaranteed to work across threads.
+      return;
     }
 
-    // Make sure message is null terminated.
-    this->MessageBuffer[this->MessageBufferSize-1] = '\0';
+    this->WriteMessage(message);
   }
 
   VTKM_EXEC_CONT_EXPORT bool IsErrorRaised() const
   {
-    if (this->MessageBufferSize > 0)
+    if (this->State != NULL)
+    {
+      return (*static_cast<volatile vtkm::Int32 *>(&this->State->Claimed)
+              == ErrorMessageState::PUBLISHED);
+    }
+    else if (this->MessageBufferSize > 0)
     {
       return (this->MessageBuffer[0] != '\0');
     }
@@ -82,9 +173,82 @@ public:
     }
   }
 
+  /// Sets the cancellation token, asking the device adapter to stop
+  /// scheduling instances that have not started yet. Does nothing if the
+  /// buffer has no ErrorMessageState.
+  ///
+  VTKM_EXEC_EXPORT void Cancel() const
+  {
+    if (this->State != NULL)
+    {
+      *static_cast<volatile vtkm::Int32 *>(&this->State->Cancelled) = 1;
+    }
+  }
+
+  /// Returns true if execution was cancelled or an error was raised. Like
+  /// IsErrorRaised, this is a single read of the shared state.
+  ///
+  VTKM_EXEC_CONT_EXPORT bool IsCancelled() const
+  {
+    if (this->State != NULL)
+    {
+      return (*static_cast<volatile vtkm::Int32 *>(&this->State->Cancelled)
+              != 0);
+    }
+    return false;
+  }
+
+  /// Returns the number of errors raised, or 0/1 when the buffer has no
+  /// ErrorMessageState to count with.
+  ///
+  VTKM_EXEC_CONT_EXPORT vtkm::Id GetNumberOfErrors() const
+  {
+    if (this->State != NULL)
+    {
+      return this->State->NumberOfErrors;
+    }
+    return this->IsErrorRaised() ? 1 : 0;
+  }
+
+  /// Returns the index of the instance that raised the recorded message, or
+  /// -1 if no error was raised or the instance is unknown.
+  ///
+  VTKM_EXEC_CONT_EXPORT vtkm::Id GetErrorInstance() const
+  {
+    return (this->State != NULL) ? this->State->ErrorInstance : -1;
+  }
+
+  /// Records \c instance as the failing instance if an error was raised
+  /// without one. Device adapters that know which instance was running when
+  /// the error appeared use this to fill in the index.
+  ///
+  VTKM_EXEC_CONT_EXPORT void SetErrorInstanceIfUnknown(vtkm::Id instance) const
+  {
+    if ((this->State != NULL) && (this->State->ErrorInstance < 0))
+    {
+      this->State->ErrorInstance = instance;
+    }
+  }
+
 private:
+  VTKM_EXEC_EXPORT void WriteMessage(const char *message) const
+  {
+    if (this->MessageBufferSize <= 0) { return; }
+
+    // Safely copy message into array.
+    for (vtkm::Id index = 0; index < this->MessageBufferSize; index++)
+    {
+      this->MessageBuffer[index] = message[index];
+      if (message[index] == '\0') { break; }
+    }
+
+    // Make sure message is null terminated.
+    this->MessageBuffer[this->MessageBufferSize-1] = '\0';
+  }
+
   char *MessageBuffer;
   vtkm::Id MessageBufferSize;
+  vtkm::exec::internal::ErrorMessageState *State;
 };
 
 }
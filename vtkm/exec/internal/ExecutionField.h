@@ -0,0 +1,153 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_exec_internal_ExecutionField_h
+#define vtk_m_exec_internal_ExecutionField_h
+
+#include <vtkm/Types.h>
+
+namespace vtkm {
+namespace exec {
+namespace internal {
+
+// The execution objects in this file are what a dispatcher hands to the
+// execution environment for each field argument of a worklet. They all have
+// the same interface: a ValueType, a Load method that returns the value for
+// an instance, and a Store method that writes the (possibly modified) value
+// back after the worklet runs.
+
+/// Execution object for a field that is only read.
+///
+template<typename PortalType>
+struct ExecutionFieldIn
+{
+  typedef typename PortalType::ValueType ValueType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ExecutionFieldIn() {  }
+
+  VTKM_CONT_EXPORT
+  ExecutionFieldIn(const PortalType &portal) : Portal(portal) {  }
+
+  VTKM_EXEC_EXPORT
+  ValueType Load(vtkm::Id index) const
+  {
+    return this->Portal.Get(index);
+  }
+
+  VTKM_EXEC_EXPORT
+  void Store(vtkm::Id, const ValueType &) const
+  {
+    // Input only. Nothing to store.
+  }
+
+  PortalType Portal;
+};
+
+/// Execution object for a field that is only written.
+///
+template<typename PortalType>
+struct ExecutionFieldOut
+{
+  typedef typename PortalType::ValueType ValueType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ExecutionFieldOut() {  }
+
+  VTKM_CONT_EXPORT
+  ExecutionFieldOut(const PortalType &portal) : Portal(portal) {  }
+
+  VTKM_EXEC_EXPORT
+  ValueType Load(vtkm::Id) const
+  {
+    // Output only. There is no value to read yet.
+    return ValueType();
+  }
+
+  VTKM_EXEC_EXPORT
+  void Store(vtkm::Id index, const ValueType &value) const
+  {
+    this->Portal.Set(index, value);
+  }
+
+  PortalType Portal;
+};
+
+/// Execution object for a field that is read and written in place.
+///
+template<typename PortalType>
+struct ExecutionFieldInOut
+{
+  typedef typename PortalType::ValueType ValueType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ExecutionFieldInOut() {  }
+
+  VTKM_CONT_EXPORT
+  ExecutionFieldInOut(const PortalType &portal) : Portal(portal) {  }
+
+  VTKM_EXEC_EXPORT
+  ValueType Load(vtkm::Id index) const
+  {
+    return this->Portal.Get(index);
+  }
+
+  VTKM_EXEC_EXPORT
+  void Store(vtkm::Id index, const ValueType &value) const
+  {
+    this->Portal.Set(index, value);
+  }
+
+  PortalType Portal;
+};
+
+/// Execution object for an input field given as a single value that every
+/// instance sees.
+///
+template<typename T>
+struct ExecutionFieldConstant
+{
+  typedef T ValueType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ExecutionFieldConstant() {  }
+
+  VTKM_CONT_EXPORT
+  ExecutionFieldConstant(const ValueType &value) : Value(value) {  }
+
+  VTKM_EXEC_EXPORT
+  ValueType Load(vtkm::Id) const
+  {
+    return this->Value;
+  }
+
+  VTKM_EXEC_EXPORT
+  void Store(vtkm::Id, const ValueType &) const
+  {
+    // Input only. Nothing to store.
+  }
+
+  ValueType Value;
+};
+
+}
+}
+} // namespace vtkm::exec::internal
+
+#endif //vtk_m_exec_internal_ExecutionField_h
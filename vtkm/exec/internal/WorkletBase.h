@@ -26,12 +26,49 @@ namespace vtkm {
 namespace exec {
 namespace internal {
 
+/// Placeholder used in a worklet's \c ExecutionSignature to refer to the
+/// argument at position \c Index of the dispatcher's Invoke (and the
+/// corresponding entry of the \c ControlSignature). Indices start at 1.
+/// Worklets refer to these through the \c _1, \c _2, ... typedefs in
+/// WorkletBase.
+///
+template<vtkm::IdComponent Index>
+struct WorkletPlaceholder
+{
+  static const vtkm::IdComponent INDEX = Index;
+};
+
+/// Tag used in a worklet's \c ExecutionSignature to pass the index of the
+/// instance being invoked (as a vtkm::Id).
+///
+struct WorkletWorkIndex {  };
+
 /// Base class for all worklet classes. Worklet classes are subclasses and a
 /// operator() const is added to implement an algorithm in VTK-m. Different
 /// worklets have different calling semantics.
 ///
+/// Every worklet declares two function types. The \c ControlSignature has one
+/// tag per argument given to the dispatcher's Invoke and describes how that
+/// argument is brought to the execution environment. The \c
+/// ExecutionSignature describes how operator() is called using the
+/// placeholders defined here: \c _1 passes the value fetched from the first
+/// argument, \c WorkIndex passes the instance index, and a placeholder as the
+/// return type stores the result in that argument.
+///
 class WorkletBase : public FunctorBase
 {
+public:
+  typedef vtkm::exec::internal::WorkletPlaceholder<1> _1;
+  typedef vtkm::exec::internal::WorkletPlaceholder<2> _2;
+  typedef vtkm::exec::internal::WorkletPlaceholder<3> _3;
+  typedef vtkm::exec::internal::WorkletPlaceholder<4> _4;
+  typedef vtkm::exec::internal::WorkletPlaceholder<5> _5;
+  typedef vtkm::exec::internal::WorkletPlaceholder<6> _6;
+  typedef vtkm::exec::internal::WorkletPlaceholder<7> _7;
+  typedef vtkm::exec::internal::WorkletPlaceholder<8> _8;
+  typedef vtkm::exec::internal::WorkletPlaceholder<9> _9;
+
+  typedef vtkm::exec::internal::WorkletWorkIndex WorkIndex;
 };
 
 }
@@ -0,0 +1,273 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_exec_internal_WorkletInvokeFunctor_h
+#define vtk_m_exec_internal_WorkletInvokeFunctor_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/exec/internal/ErrorMessageBuffer.h>
+#include <vtkm/exec/internal/WorkletBase.h>
+
+#include <vtkm/internal/FunctionInterface.h>
+
+#include <boost/function_types/components.hpp>
+#include <boost/function_types/function_arity.hpp>
+#include <boost/function_types/function_type.hpp>
+#include <boost/function_types/parameter_types.hpp>
+#include <boost/function_types/result_type.hpp>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/back_inserter.hpp>
+#include <boost/mpl/transform.hpp>
+#include <boost/mpl/vector.hpp>
+
+namespace vtkm {
+namespace exec {
+namespace internal {
+
+namespace detail {
+
+/// Loads and stores the value passed to the worklet for one entry of its
+/// ExecutionSignature. \c ExecutionTag is a placeholder, \c WorkIndex, or (for
+/// the return value only) \c void.
+///
+template<typename ExecutionTag, typename ExecObjectInterface>
+struct WorkletInvokeFetch;
+
+template<vtkm::IdComponent Index, typename ExecObjectInterface>
+struct WorkletInvokeFetch<
+    vtkm::exec::internal::WorkletPlaceholder<Index>, ExecObjectInterface>
+{
+  typedef typename ExecObjectInterface::template ParameterType<Index>::type
+      ExecObjectType;
+  typedef typename ExecObjectType::ValueType ValueType;
+
+  VTKM_EXEC_EXPORT
+  static ValueType Load(const ExecObjectInterface &execObjects,
+                        vtkm::Id index)
+  {
+    return execObjects.template GetParameter<Index>().Load(index);
+  }
+
+  VTKM_EXEC_EXPORT
+  static void Store(const ExecObjectInterface &execObjects,
+                    vtkm::Id index,
+                    const ValueType &value)
+  {
+    execObjects.template GetParameter<Index>().Store(index, value);
+  }
+};
+
+template<typename ExecObjectInterface>
+struct WorkletInvokeFetch<
+    vtkm::exec::internal::WorkletWorkIndex, ExecObjectInterface>
+{
+  typedef vtkm::Id ValueType;
+
+  VTKM_EXEC_EXPORT
+  static ValueType Load(const ExecObjectInterface &, vtkm::Id index)
+  {
+    return index;
+  }
+
+  VTKM_EXEC_EXPORT
+  static void Store(const ExecObjectInterface &, vtkm::Id, const ValueType &)
+  {  }
+};
+
+template<typename ExecObjectInterface>
+struct WorkletInvokeFetch<void, ExecObjectInterface>
+{
+  typedef void ValueType;
+};
+
+template<typename ExecObjectInterface>
+struct WorkletInvokeFetchValueType
+{
+  template<typename ExecutionTag>
+  struct apply
+  {
+    typedef typename WorkletInvokeFetch<ExecutionTag,ExecObjectInterface>
+        ::ValueType type;
+  };
+};
+
+/// The signature of the worklet's operator() as called: each placeholder in
+/// the ExecutionSignature replaced by the type of the value it fetches.
+///
+template<typename ExecutionSignature, typename ExecObjectInterface>
+struct WorkletInvokeValueSignature
+{
+  typedef typename boost::mpl::transform<
+      typename boost::function_types::components<ExecutionSignature>::types,
+      WorkletInvokeFetchValueType<ExecObjectInterface>,
+      boost::mpl::back_inserter<boost::mpl::vector0<> > >::type Components;
+
+  typedef typename boost::function_types::function_type<Components>::type
+      type;
+};
+
+template<typename ExecutionSignature,
+         vtkm::IdComponent NumRemaining,
+         vtkm::IdComponent ParameterIndex = 1>
+struct WorkletInvokeParameters
+{
+  typedef typename boost::mpl::at_c<
+      typename boost::function_types::parameter_types<ExecutionSignature>,
+      ParameterIndex-1>::type ExecutionTag;
+
+  typedef WorkletInvokeParameters<
+      ExecutionSignature,NumRemaining-1,ParameterIndex+1> Next;
+
+  template<typename ValueInterface, typename ExecObjectInterface>
+  VTKM_EXEC_EXPORT
+  static void Load(ValueInterface &values,
+                   const ExecObjectInterface &execObjects,
+                   vtkm::Id index)
+  {
+    values.template SetParameter<ParameterIndex>(
+          WorkletInvokeFetch<ExecutionTag,ExecObjectInterface>::Load(
+            execObjects, index));
+    Next::Load(values, execObjects, index);
+  }
+
+  template<typename ValueInterface, typename ExecObjectInterface>
+  VTKM_EXEC_EXPORT
+  static void Store(const ValueInterface &values,
+                    const ExecObjectInterface &execObjects,
+                    vtkm::Id index)
+  {
+    WorkletInvokeFetch<ExecutionTag,ExecObjectInterface>::Store(
+          execObjects,
+          index,
+          values.template GetParameter<ParameterIndex>());
+    Next::Store(values, execObjects, index);
+  }
+};
+
+template<typename ExecutionSignature, vtkm::IdComponent ParameterIndex>
+struct WorkletInvokeParameters<ExecutionSignature, 0, ParameterIndex>
+{
+  template<typename ValueInterface, typename ExecObjectInterface>
+  VTKM_EXEC_EXPORT
+  static void Load(ValueInterface &, const ExecObjectInterface &, vtkm::Id)
+  {  }
+
+  template<typename ValueInterface, typename ExecObjectInterface>
+  VTKM_EXEC_EXPORT
+  static void Store(const ValueInterface &,
+                    const ExecObjectInterface &,
+                    vtkm::Id)
+  {  }
+};
+
+template<typename ReturnTag>
+struct WorkletInvokeReturn
+{
+  template<typename ValueInterface, typename ExecObjectInterface>
+  VTKM_EXEC_EXPORT
+  static void Store(const ValueInterface &values,
+                    const ExecObjectInterface &execObjects,
+                    vtkm::Id index)
+  {
+    WorkletInvokeFetch<ReturnTag,ExecObjectInterface>::Store(
+          execObjects, index, values.GetReturnValue());
+  }
+};
+
+template<>
+struct WorkletInvokeReturn<void>
+{
+  template<typename ValueInterface, typename ExecObjectInterface>
+  VTKM_EXEC_EXPORT
+  static void Store(const ValueInterface &,
+                    const ExecObjectInterface &,
+                    vtkm::Id)
+  {  }
+};
+
+} // namespace detail
+
+/// \brief Schedulable functor that runs a worklet on one instance.
+///
+/// \c ExecObjectInterface is a vtkm::internal::FunctionInterface holding one
+/// execution object (see ExecutionField.h) for each argument in the worklet's
+/// \c ControlSignature. When invoked with an index, the functor loads the
+/// values named by the worklet's \c ExecutionSignature, calls the worklet, and
+/// stores the output values and return value back through the execution
+/// objects. Dispatchers create this functor and pass it to
+/// DeviceAdapterAlgorithm::Schedule.
+///
+template<typename WorkletType, typename ExecObjectInterface>
+class WorkletInvokeFunctor
+{
+  typedef typename WorkletType::ExecutionSignature ExecutionSignature;
+  typedef vtkm::internal::FunctionInterface<
+      typename detail::WorkletInvokeValueSignature<
+        ExecutionSignature,ExecObjectInterface>::type> ValueInterface;
+  typedef detail::WorkletInvokeParameters<
+      ExecutionSignature,
+      boost::function_types::function_arity<ExecutionSignature>::value>
+      ParametersType;
+  typedef detail::WorkletInvokeReturn<
+      typename boost::function_types::result_type<ExecutionSignature>::type>
+      ReturnType;
+
+public:
+  VTKM_CONT_EXPORT
+  WorkletInvokeFunctor(const WorkletType &worklet,
+                       const ExecObjectInterface &execObjects)
+    : Worklet(worklet), ExecObjects(execObjects) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    ValueInterface values;
+    ParametersType::Load(values, this->ExecObjects, index);
+    values.InvokeExec(this->Worklet);
+    ParametersType::Store(values, this->ExecObjects, index);
+    ReturnType::Store(values, this->ExecObjects, index);
+  }
+
+  VTKM_CONT_EXPORT
+  void SetErrorMessageBuffer(
+      const vtkm::exec::internal::ErrorMessageBuffer &buffer)
+  {
+    this->Worklet.SetErrorMessageBuffer(buffer);
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  const WorkletType &GetWorklet() const { return this->Worklet; }
+
+  VTKM_EXEC_CONT_EXPORT
+  const ExecObjectInterface &GetExecObjects() const
+  {
+    return this->ExecObjects;
+  }
+
+private:
+  WorkletType Worklet;
+  ExecObjectInterface ExecObjects;
+};
+
+}
+}
+} // namespace vtkm::exec::internal
+
+#endif //vtk_m_exec_internal_WorkletInvokeFunctor_h
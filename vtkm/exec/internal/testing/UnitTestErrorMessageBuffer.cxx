@@ -48,11 +48,100 @@ void TestErrorMessageBuffer()
   VTKM_TEST_ASSERT(smallBuffer.IsErrorRaised(), "Error not reported.");
   VTKM_TEST_ASSERT(strcmp(messageBuffer, "Hello Wo") == 0,
                   "Did not record error message.");
+
+  std::cout << "Testing shared error state." << std::endl;
+  messageBuffer[0] = '\0';
+  vtkm::exec::internal::ErrorMessageState state;
+  state.Reset();
+  vtkm::exec::internal::ErrorMessageBuffer
+      sharedBuffer(messageBuffer, 100, &state);
+  VTKM_TEST_ASSERT(!sharedBuffer.IsErrorRaised(), "Message created with error.");
+  VTKM_TEST_ASSERT(sharedBuffer.GetNumberOfErrors() == 0,
+                   "Message created with error.");
+  VTKM_TEST_ASSERT(sharedBuffer.GetErrorInstance() == -1,
+                   "Message created with error instance.");
+
+  // Copies share the same state, as functor copies do on a device.
+  vtkm::exec::internal::ErrorMessageBuffer sharedCopy = sharedBuffer;
+  sharedCopy.RaiseError("First error", 42);
+  VTKM_TEST_ASSERT(sharedBuffer.IsErrorRaised(), "Error not reported.");
+  sharedBuffer.RaiseError("Second error", 7);
+  sharedCopy.RaiseError("Third error");
+  VTKM_TEST_ASSERT(strcmp(messageBuffer, "First error") == 0,
+                   "First error message was not kept.");
+  VTKM_TEST_ASSERT(sharedBuffer.GetNumberOfErrors() == 3,
+                   "Did not count all errors.");
+  VTKM_TEST_ASSERT(sharedBuffer.GetErrorInstance() == 42,
+                   "Did not record first failing instance.");
+
+  sharedBuffer.SetErrorInstanceIfUnknown(3);
+  VTKM_TEST_ASSERT(sharedBuffer.GetErrorInstance() == 42,
+                   "Known failing instance was overwritten.");
+
+  std::cout << "Testing error without instance." << std::endl;
+  messageBuffer[0] = '\0';
+  state.Reset();
+  sharedBuffer.RaiseError("No instance");
+  VTKM_TEST_ASSERT(sharedBuffer.GetErrorInstance() == -1,
+                   "Made up a failing instance.");
+  sharedBuffer.SetErrorInstanceIfUnknown(3);
+  VTKM_TEST_ASSERT(sharedBuffer.GetErrorInstance() == 3,
+                   "Did not fill in failing instance.");
+
+  std::cout << "Testing cancellation." << std::endl;
+  messageBuffer[0] = '\0';
+  state.Reset();
+  VTKM_TEST_ASSERT(!sharedBuffer.IsCancelled(), "State created cancelled.");
+  sharedCopy.Cancel();
+  VTKM_TEST_ASSERT(sharedBuffer.IsCancelled(), "Cancel not reported.");
+  VTKM_TEST_ASSERT(!sharedBuffer.IsErrorRaised(), "Cancel raised an error.");
+
+  state.Reset();
+  sharedBuffer.RaiseError("Error cancels");
+  VTKM_TEST_ASSERT(sharedBuffer.IsCancelled(), "Error did not cancel.");
+
+  VTKM_TEST_ASSERT(!largeBuffer.IsCancelled(),
+                   "Buffer without state reported cancel.");
+}
+
+void TestAtomicOperations()
+{
+  std::cout << "Testing atomic operations." << std::endl;
+  vtkm::Int32 value32 = 5;
+  VTKM_TEST_ASSERT(vtkm::exec::internal::AtomicAdd(&value32, 3) == 5,
+                   "AtomicAdd returned wrong value.");
+  VTKM_TEST_ASSERT(value32 == 8, "AtomicAdd did not add.");
+  VTKM_TEST_ASSERT(
+        vtkm::exec::internal::AtomicCompareAndSwap(&value32, 0, 1) == 8,
+        "AtomicCompareAndSwap returned wrong value.");
+  VTKM_TEST_ASSERT(value32 == 8, "AtomicCompareAndSwap swapped on mismatch.");
+  VTKM_TEST_ASSERT(
+        vtkm::exec::internal::AtomicCompareAndSwap(&value32, 8, 1) == 8,
+        "AtomicCompareAndSwap returned wrong value.");
+  VTKM_TEST_ASSERT(value32 == 1, "AtomicCompareAndSwap did not swap.");
+
+  vtkm::Int64 value64 = 5;
+  VTKM_TEST_ASSERT(vtkm::exec::internal::AtomicAdd(
+                     &value64, static_cast<vtkm::Int64>(3)) == 5,
+                   "AtomicAdd returned wrong value.");
+  VTKM_TEST_ASSERT(value64 == 8, "AtomicAdd did not add.");
+  VTKM_TEST_ASSERT(vtkm::exec::internal::AtomicCompareAndSwap(
+                     &value64,
+                     static_cast<vtkm::Int64>(8),
+                     static_cast<vtkm::Int64>(1)) == 8,
+                   "AtomicCompareAndSwap returned wrong value.");
+  VTKM_TEST_ASSERT(value64 == 1, "AtomicCompareAndSwap did not swap.");
+}
+
+void TestErrorMessageBufferAndAtomics()
+{
+  TestErrorMessageBuffer();
+  TestAtomicOperations();
 }
 
 } // anonymous namespace
 
 int UnitTestErrorMessageBuffer(int, char *[])
 {
-  return (vtkm::testing::Testing::Run(TestErrorMessageBuffer));
+  return (vtkm::testing::Testing::Run(TestErrorMessageBufferAndAtomics));
 }
@@ -0,0 +1,235 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_internal_ConnectivityStructuredInternals_h
+#define vtk_m_internal_ConnectivityStructuredInternals_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/Extent.h>
+#include <vtkm/Types.h>
+
+namespace vtkm {
+namespace internal {
+
+/// \brief Computes the connectivity of a structured grid from its extent.
+///
+/// Structured grids store no connectivity. The points of each cell and the
+/// cells incident on each point follow from the point and cell dimensions
+/// with a few integer operations, which this class implements for both the
+/// control and execution environments. Elements are identified by flat
+/// indices that start at 0 for the element at the minimum of the extent and
+/// increase fastest in the first dimension (as in ExtentPointFlatIndex...).
+///
+/// The points of each cell are listed in the order of the VTK cell shape
+/// (counterclockwise around a quad, then the same for the upper face of a
+/// hexahedron). Cells incident on a point are listed in increasing order.
+///
+template<vtkm::IdComponent Dimensions>
+class ConnectivityStructuredInternals;
+
+template<>
+class ConnectivityStructuredInternals<2>
+{
+public:
+  static const vtkm::IdComponent NUM_POINTS_IN_CELL = 4;
+  static const vtkm::IdComponent MAX_CELLS_ON_POINT = 4;
+
+  typedef vtkm::Vec<vtkm::Id,NUM_POINTS_IN_CELL> PointsOfCellType;
+  typedef vtkm::Vec<vtkm::Id,MAX_CELLS_ON_POINT> CellsOfPointType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityStructuredInternals()
+    : PointDimensions(1), CellDimensions(0) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityStructuredInternals(const vtkm::Extent2 &extent)
+    : Extent(extent),
+      PointDimensions(vtkm::ExtentPointDimensions(extent)),
+      CellDimensions(vtkm::ExtentCellDimensions(extent)) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  const vtkm::Extent2 &GetExtent() const { return this->Extent; }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfPoints() const {
+    return this->PointDimensions[0]*this->PointDimensions[1];
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfCells() const {
+    return this->CellDimensions[0]*this->CellDimensions[1];
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::CellShape GetCellShape() const { return vtkm::CELL_SHAPE_QUAD; }
+
+  VTKM_EXEC_CONT_EXPORT
+  PointsOfCellType GetPointsOfCell(vtkm::Id cellIndex) const
+  {
+    vtkm::Id i = cellIndex % this->CellDimensions[0];
+    vtkm::Id j = cellIndex / this->CellDimensions[0];
+    vtkm::Id firstPoint = i + j*this->PointDimensions[0];
+
+    PointsOfCellType points;
+    points[0] = firstPoint;
+    points[1] = firstPoint + 1;
+    points[2] = firstPoint + 1 + this->PointDimensions[0];
+    points[3] = firstPoint + this->PointDimensions[0];
+    return points;
+  }
+
+  /// Returns the cells incident on the given point. The first \c
+  /// numberOfCells entries are valid and the rest are set to -1.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  CellsOfPointType GetCellsOfPoint(vtkm::Id pointIndex,
+                                   vtkm::IdComponent &numberOfCells) const
+  {
+    vtkm::Id i = pointIndex % this->PointDimensions[0];
+    vtkm::Id j = pointIndex / this->PointDimensions[0];
+
+    CellsOfPointType cells(-1);
+    numberOfCells = 0;
+    for (vtkm::Id cellJ = j-1; cellJ <= j; cellJ++)
+    {
+      if ((cellJ < 0) || (cellJ >= this->CellDimensions[1])) { continue; }
+      for (vtkm::Id cellI = i-1; cellI <= i; cellI++)
+      {
+        if ((cellI < 0) || (cellI >= this->CellDimensions[0])) { continue; }
+        cells[numberOfCells] = cellI + cellJ*this->CellDimensions[0];
+        numberOfCells++;
+      }
+    }
+    return cells;
+  }
+
+private:
+  vtkm::Extent2 Extent;
+  vtkm::Id2 PointDimensions;
+  vtkm::Id2 CellDimensions;
+};
+
+template<>
+class ConnectivityStructuredInternals<3>
+{
+public:
+  static const vtkm::IdComponent NUM_POINTS_IN_CELL = 8;
+  static const vtkm::IdComponent MAX_CELLS_ON_POINT = 8;
+
+  typedef vtkm::Vec<vtkm::Id,NUM_POINTS_IN_CELL> PointsOfCellType;
+  typedef vtkm::Vec<vtkm::Id,MAX_CELLS_ON_POINT> CellsOfPointType;
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityStructuredInternals()
+    : PointDimensions(1), CellDimensions(0) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  ConnectivityStructuredInternals(const vtkm::Extent3 &extent)
+    : Extent(extent),
+      PointDimensions(vtkm::ExtentPointDimensions(extent)),
+      CellDimensions(vtkm::ExtentCellDimensions(extent)) {  }
+
+  VTKM_EXEC_CONT_EXPORT
+  const vtkm::Extent3 &GetExtent() const { return this->Extent; }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfPoints() const {
+    return this->PointDimensions[0]
+        * this->PointDimensions[1]
+        * this->PointDimensions[2];
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfCells() const {
+    return this->CellDimensions[0]
+        * this->CellDimensions[1]
+        * this->CellDimensions[2];
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::CellShape GetCellShape() const { return vtkm::CELL_SHAPE_HEXAHEDRON; }
+
+  VTKM_EXEC_CONT_EXPORT
+  PointsOfCellType GetPointsOfCell(vtkm::Id cellIndex) const
+  {
+    vtkm::Id i = cellIndex % this->CellDimensions[0];
+    vtkm::Id j =
+        (cellIndex / this->CellDimensions[0]) % this->CellDimensions[1];
+    vtkm::Id k = cellIndex / (this->CellDimensions[0]*this->CellDimensions[1]);
+    vtkm::Id pointsPerRow = this->PointDimensions[0];
+    vtkm::Id pointsPerSlice = pointsPerRow*this->PointDimensions[1];
+    vtkm::Id firstPoint = i + j*pointsPerRow + k*pointsPerSlice;
+
+    PointsOfCellType points;
+    points[0] = firstPoint;
+    points[1] = firstPoint + 1;
+    points[2] = firstPoint + 1 + pointsPerRow;
+    points[3] = firstPoint + pointsPerRow;
+    points[4] = points[0] + pointsPerSlice;
+    points[5] = points[1] + pointsPerSlice;
+    points[6] = points[2] + pointsPerSlice;
+    points[7] = points[3] + pointsPerSlice;
+    return points;
+  }
+
+  /// Returns the cells incident on the given point. The first \c
+  /// numberOfCells entries are valid and the rest are set to -1.
+  ///
+  VTKM_EXEC_CONT_EXPORT
+  CellsOfPointType GetCellsOfPoint(vtkm::Id pointIndex,
+                                   vtkm::IdComponent &numberOfCells) const
+  {
+    vtkm::Id i = pointIndex % this->PointDimensions[0];
+    vtkm::Id j = (pointIndex / this->PointDimensions[0])
+        % this->PointDimensions[1];
+    vtkm::Id k = pointIndex
+        / (this->PointDimensions[0]*this->PointDimensions[1]);
+    vtkm::Id cellsPerSlice = this->CellDimensions[0]*this->CellDimensions[1];
+
+    CellsOfPointType cells(-1);
+    numberOfCells = 0;
+    for (vtkm::Id cellK = k-1; cellK <= k; cellK++)
+    {
+      if ((cellK < 0) || (cellK >= this->CellDimensions[2])) { continue; }
+      for (vtkm::Id cellJ = j-1; cellJ <= j; cellJ++)
+      {
+        if ((cellJ < 0) || (cellJ >= this->CellDimensions[1])) { continue; }
+        for (vtkm::Id cellI = i-1; cellI <= i; cellI++)
+        {
+          if ((cellI < 0) || (cellI >= this->CellDimensions[0])) { continue; }
+          cells[numberOfCells] = cellI
+              + cellJ*this->CellDimensions[0]
+              + cellK*cellsPerSlice;
+          numberOfCells++;
+        }
+      }
+    }
+    return cells;
+  }
+
+private:
+  vtkm::Extent3 Extent;
+  vtkm::Id3 PointDimensions;
+  vtkm::Id3 CellDimensions;
+};
+
+}
+} // namespace vtkm::internal
+
+#endif //vtk_m_internal_ConnectivityStructuredInternals_h
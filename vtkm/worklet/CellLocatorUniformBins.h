@@ -0,0 +1,795 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_CellLocatorUniformBins_h
+#define vtk_m_worklet_CellLocatorUniformBins_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/CellShape.h>
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/Types.h>
+#include <vtkm/VecTraits.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/worklet/PointLocatorUniformGrid.h>
+
+#include <limits>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+typedef vtkm::Vec<vtkm::FloatDefault,3> CellLocatorPointType;
+
+// How far outside a cell, in parametric coordinates, a point may be and
+// still be found in it, so points on shared faces are not lost to
+// rounding.
+static const vtkm::FloatDefault CELL_LOCATOR_TOLERANCE =
+    static_cast<vtkm::FloatDefault>(1e-4);
+
+static const vtkm::IdComponent CELL_LOCATOR_MAX_ITERATIONS = 10;
+
+/// Computes the interpolation weights of the points of a cell at
+/// parametric coordinates \p pcoords, and their derivatives with respect
+/// to the parametric coordinates, with the point order and parametric
+/// space of VTK. Returns the number of points of the cell, or 0 if the
+/// shape is not a supported 3D shape: tetrahedron, hexahedron, wedge or
+/// pyramid.
+///
+VTKM_EXEC_EXPORT
+vtkm::IdComponent CellLocatorShapeFunctions(
+    vtkm::CellShape shape,
+    const CellLocatorPointType &pcoords,
+    vtkm::Vec<vtkm::FloatDefault,8> &weights,
+    vtkm::Vec<CellLocatorPointType,8> &derivatives)
+{
+  const vtkm::FloatDefault one = vtkm::FloatDefault(1);
+  const vtkm::FloatDefault zero = vtkm::FloatDefault(0);
+  const vtkm::FloatDefault r = pcoords[0];
+  const vtkm::FloatDefault s = pcoords[1];
+  const vtkm::FloatDefault t = pcoords[2];
+  switch (shape)
+  {
+    case vtkm::CELL_SHAPE_TETRA:
+      weights[0] = one - r - s - t;
+      weights[1] = r;
+      weights[2] = s;
+      weights[3] = t;
+      derivatives[0] = CellLocatorPointType(-one, -one, -one);
+      derivatives[1] = CellLocatorPointType(one, zero, zero);
+      derivatives[2] = CellLocatorPointType(zero, one, zero);
+      derivatives[3] = CellLocatorPointType(zero, zero, one);
+      return 4;
+
+    case vtkm::CELL_SHAPE_HEXAHEDRON:
+    case vtkm::CELL_SHAPE_PYRAMID:
+    {
+      // The base of a pyramid is the bottom of a hexahedron shrunk toward
+      // the apex.
+      vtkm::IdComponent numCorners =
+          (shape == vtkm::CELL_SHAPE_HEXAHEDRON) ? 8 : 4;
+      for (vtkm::IdComponent corner = 0; corner < numCorners; corner++)
+      {
+        bool highR = ((corner & 3) == 1) || ((corner & 3) == 2);
+        bool highS = ((corner & 3) == 2) || ((corner & 3) == 3);
+        bool highT = (corner >= 4);
+        vtkm::FloatDefault fr = highR ? r : one - r;
+        vtkm::FloatDefault fs = highS ? s : one - s;
+        vtkm::FloatDefault ft = highT ? t : one - t;
+        vtkm::FloatDefault dr = highR ? one : -one;
+        vtkm::FloatDefault ds = highS ? one : -one;
+        vtkm::FloatDefault dt = highT ? one : -one;
+        weights[corner] = fr*fs*ft;
+        derivatives[corner] =
+            CellLocatorPointType(dr*fs*ft, fr*ds*ft, fr*fs*dt);
+      }
+      if (shape == vtkm::CELL_SHAPE_HEXAHEDRON)
+      {
+        return 8;
+      }
+      weights[4] = t;
+      derivatives[4] = CellLocatorPointType(zero, zero, one);
+      return 5;
+    }
+
+    case vtkm::CELL_SHAPE_WEDGE:
+    {
+      const vtkm::FloatDefault triangle[3] = { one - r - s, r, s };
+      const CellLocatorPointType triangleDerivatives[3] = {
+        CellLocatorPointType(-one, -one, zero),
+        CellLocatorPointType(one, zero, zero),
+        CellLocatorPointType(zero, one, zero) };
+      for (vtkm::IdComponent corner = 0; corner < 3; corner++)
+      {
+        weights[corner] = triangle[corner]*(one - t);
+        weights[corner + 3] = triangle[corner]*t;
+        derivatives[corner] = triangleDerivatives[corner]*(one - t);
+        derivatives[corner][2] = -triangle[corner];
+        derivatives[corner + 3] = triangleDerivatives[corner]*t;
+        derivatives[corner + 3][2] = triangle[corner];
+      }
+      return 6;
+    }
+
+    default:
+      return 0;
+  }
+}
+
+/// Whether parametric coordinates are inside a cell of the given shape,
+/// within CELL_LOCATOR_TOLERANCE.
+///
+VTKM_EXEC_EXPORT
+bool CellLocatorIsInside(vtkm::CellShape shape,
+                         const CellLocatorPointType &pcoords)
+{
+  const vtkm::FloatDefault low = -CELL_LOCATOR_TOLERANCE;
+  const vtkm::FloatDefault high =
+      vtkm::FloatDefault(1) + CELL_LOCATOR_TOLERANCE;
+  for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+  {
+    if ((pcoords[axis] < low) || (pcoords[axis] > high))
+    {
+      return false;
+    }
+  }
+  switch (shape)
+  {
+    case vtkm::CELL_SHAPE_TETRA:
+      return !(pcoords[0] + pcoords[1] + pcoords[2] > high);
+    case vtkm::CELL_SHAPE_WEDGE:
+      return !(pcoords[0] + pcoords[1] > high);
+    default:
+      return true;
+  }
+}
+
+/// Finds the parametric coordinates of \p point in a cell whose points are
+/// \p cellPoints with Newton's method, which takes a single step for
+/// tetrahedra. Returns false if the iteration meets a singular Jacobian or
+/// does not converge.
+///
+VTKM_EXEC_EXPORT
+bool CellLocatorParametricCoordinates(
+    vtkm::CellShape shape,
+    const vtkm::Vec<CellLocatorPointType,8> &cellPoints,
+    const CellLocatorPointType &point,
+    CellLocatorPointType &pcoords)
+{
+  const vtkm::FloatDefault third =
+      vtkm::FloatDefault(1)/vtkm::FloatDefault(3);
+  switch (shape)
+  {
+    case vtkm::CELL_SHAPE_TETRA:
+      pcoords = CellLocatorPointType(vtkm::FloatDefault(0.25));
+      break;
+    case vtkm::CELL_SHAPE_WEDGE:
+      pcoords = CellLocatorPointType(third, third, vtkm::FloatDefault(0.5));
+      break;
+    case vtkm::CELL_SHAPE_PYRAMID:
+      pcoords = CellLocatorPointType(vtkm::FloatDefault(0.5),
+                                     vtkm::FloatDefault(0.5),
+                                     vtkm::FloatDefault(0.2));
+      break;
+    default:
+      pcoords = CellLocatorPointType(vtkm::FloatDefault(0.5));
+      break;
+  }
+
+  vtkm::Vec<vtkm::FloatDefault,8> weights;
+  vtkm::Vec<CellLocatorPointType,8> derivatives;
+  for (vtkm::IdComponent iteration = 0;
+       iteration < CELL_LOCATOR_MAX_ITERATIONS;
+       iteration++)
+  {
+    vtkm::IdComponent numPoints =
+        CellLocatorShapeFunctions(shape, pcoords, weights, derivatives);
+    if (numPoints == 0)
+    {
+      return false;
+    }
+
+    // The residual and the Jacobian, whose columns are the derivatives of
+    // the position along each parametric axis.
+    CellLocatorPointType residual = point*vtkm::FloatDefault(-1);
+    CellLocatorPointType columns[3] = {
+      CellLocatorPointType(vtkm::FloatDefault(0)),
+      CellLocatorPointType(vtkm::FloatDefault(0)),
+      CellLocatorPointType(vtkm::FloatDefault(0)) };
+    for (vtkm::IdComponent index = 0; index < numPoints; index++)
+    {
+      residual = residual + cellPoints[index]*weights[index];
+      for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+      {
+        columns[axis] =
+            columns[axis] + cellPoints[index]*derivatives[index][axis];
+      }
+    }
+
+    // Solves the 3x3 system with Cramer's rule.
+    CellLocatorPointType cross12(
+          columns[1][1]*columns[2][2] - columns[1][2]*columns[2][1],
+          columns[1][2]*columns[2][0] - columns[1][0]*columns[2][2],
+          columns[1][0]*columns[2][1] - columns[1][1]*columns[2][0]);
+    vtkm::FloatDefault determinant = vtkm::dot(columns[0], cross12);
+    if (determinant == vtkm::FloatDefault(0))
+    {
+      return false;
+    }
+    CellLocatorPointType crossR2(
+          residual[1]*columns[2][2] - residual[2]*columns[2][1],
+          residual[2]*columns[2][0] - residual[0]*columns[2][2],
+          residual[0]*columns[2][1] - residual[1]*columns[2][0]);
+    CellLocatorPointType cross1R(
+          columns[1][1]*residual[2] - columns[1][2]*residual[1],
+          columns[1][2]*residual[0] - columns[1][0]*residual[2],
+          columns[1][0]*residual[1] - columns[1][1]*residual[0]);
+    CellLocatorPointType step(vtkm::dot(residual, cross12),
+                              vtkm::dot(columns[0], crossR2),
+                              vtkm::dot(columns[0], cross1R));
+    step = step*(vtkm::FloatDefault(1)/determinant);
+    pcoords = pcoords - step;
+    if (shape == vtkm::CELL_SHAPE_TETRA)
+    {
+      // The map of a tetrahedron is linear, so one step solves it.
+      return true;
+    }
+
+    vtkm::FloatDefault largest = vtkm::FloatDefault(0);
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      vtkm::FloatDefault size = (step[axis] < 0) ? -step[axis] : step[axis];
+      if (size > largest) { largest = size; }
+    }
+    // Rounding keeps steps from getting much smaller than this near the
+    // apex of a pyramid, where the parametric space is stretched.
+    if (largest < CELL_LOCATOR_TOLERANCE*vtkm::FloatDefault(0.1))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// The execution side of CellLocatorUniformBins. Each bin lists the cells
+/// whose bounding boxes overlap it, and finding a cell tests the cells of
+/// the bin holding the point.
+///
+template<typename ConnectivityType,
+         typename PointPortalType,
+         typename IdPortalType>
+struct CellLocatorUniformBinsExec
+{
+  PointLocatorGrid Grid;
+  vtkm::Bounds Bounds;
+  ConnectivityType Connectivity;
+  PointPortalType Points;
+  IdPortalType BinCellIds;
+  IdPortalType BinStarts;
+  IdPortalType BinEnds;
+
+  VTKM_CONT_EXPORT
+  CellLocatorUniformBinsExec(const PointLocatorGrid &grid,
+                             const vtkm::Bounds &bounds,
+                             const ConnectivityType &connectivity,
+                             const PointPortalType &points,
+                             const IdPortalType &binCellIds,
+                             const IdPortalType &binStarts,
+                             const IdPortalType &binEnds)
+    : Grid(grid),
+      Bounds(bounds),
+      Connectivity(connectivity),
+      Points(points),
+      BinCellIds(binCellIds),
+      BinStarts(binStarts),
+      BinEnds(binEnds) {  }
+
+  /// Returns the cell containing \p queryPoint and its parametric
+  /// coordinates in that cell, or -1 if no cell contains it. A point on a
+  /// face shared by cells is found in the one with the smallest id.
+  ///
+  template<typename T>
+  VTKM_EXEC_EXPORT
+  vtkm::Id FindCell(const vtkm::Vec<T,3> &queryPoint,
+                    CellLocatorPointType &pcoords) const
+  {
+    const CellLocatorPointType point = PointLocatorToPoint(queryPoint);
+    if (!this->Bounds.Contains(point))
+    {
+      return -1;
+    }
+
+    const vtkm::Id3 bin = this->Grid.GetBinIndex(point);
+    const vtkm::Id flatBin = this->Grid.GetFlatIndex(bin[0], bin[1], bin[2]);
+    vtkm::Id end = this->BinEnds.Get(flatBin);
+    for (vtkm::Id entry = this->BinStarts.Get(flatBin); entry < end; entry++)
+    {
+      vtkm::Id cellId = this->BinCellIds.Get(entry);
+      vtkm::CellShape shape = this->Connectivity.GetCellShape(cellId);
+      vtkm::IdComponent numPoints = vtkm::CellShapeNumberOfPoints(shape);
+
+      // Only cells of supported shapes are put in bins, so the cell has at
+      // least four points.
+      vtkm::Vec<CellLocatorPointType,8> cellPoints;
+      cellPoints[0] = this->Points.Get(this->Connectivity.GetIndex(cellId, 0));
+      CellLocatorPointType lower = cellPoints[0];
+      CellLocatorPointType upper = cellPoints[0];
+      for (vtkm::IdComponent index = 1; index < numPoints; index++)
+      {
+        cellPoints[index] = this->Points.Get(
+              this->Connectivity.GetIndex(cellId, index));
+        for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+        {
+          if (cellPoints[index][axis] < lower[axis])
+          {
+            lower[axis] = cellPoints[index][axis];
+          }
+          if (cellPoints[index][axis] > upper[axis])
+          {
+            upper[axis] = cellPoints[index][axis];
+          }
+        }
+      }
+      if ((point[0] < lower[0]) || (point[0] > upper[0])
+          || (point[1] < lower[1]) || (point[1] > upper[1])
+          || (point[2] < lower[2]) || (point[2] > upper[2]))
+      {
+        continue;
+      }
+
+      if (CellLocatorParametricCoordinates(shape, cellPoints, point, pcoords)
+          && CellLocatorIsInside(shape, pcoords))
+      {
+        return cellId;
+      }
+    }
+    return -1;
+  }
+
+  /// Interpolates a point field to parametric coordinates \p pcoords of
+  /// cell \p cellId.
+  ///
+  template<typename FieldPortalType>
+  VTKM_EXEC_EXPORT
+  typename FieldPortalType::ValueType
+  Interpolate(vtkm::Id cellId,
+              const CellLocatorPointType &pcoords,
+              const FieldPortalType &field) const
+  {
+    typedef typename FieldPortalType::ValueType ValueType;
+    typedef typename vtkm::VecTraits<ValueType>::ComponentType ComponentType;
+
+    vtkm::Vec<vtkm::FloatDefault,8> weights;
+    vtkm::Vec<CellLocatorPointType,8> derivatives;
+    vtkm::IdComponent numPoints =
+        CellLocatorShapeFunctions(this->Connectivity.GetCellShape(cellId),
+                                  pcoords,
+                                  weights,
+                                  derivatives);
+    ValueType sum = ValueType(static_cast<ComponentType>(0));
+    for (vtkm::IdComponent index = 0; index < numPoints; index++)
+    {
+      sum = sum + field.Get(this->Connectivity.GetIndex(cellId, index))
+          * static_cast<ComponentType>(weights[index]);
+    }
+    return sum;
+  }
+};
+
+template<typename InputPortalType, typename PointPortalType>
+struct CellLocatorPointKernel : public vtkm::exec::FunctorBase
+{
+  InputPortalType Input;
+  PointPortalType Points;
+
+  VTKM_CONT_EXPORT
+  CellLocatorPointKernel(const InputPortalType &input,
+                         const PointPortalType &points)
+    : Input(input), Points(points) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    this->Points.Set(index, PointLocatorToPoint(this->Input.Get(index)));
+  }
+};
+
+// Finds the range of bins overlapped by the bounding box of a cell. Cells
+// of unsupported shapes overlap no bins.
+template<typename ConnectivityType, typename PointPortalType>
+VTKM_EXEC_EXPORT
+vtkm::Id CellLocatorBinRange(const PointLocatorGrid &grid,
+                             const ConnectivityType &connectivity,
+                             const PointPortalType &points,
+                             vtkm::Id cellId,
+                             vtkm::Id3 &first,
+                             vtkm::Id3 &last)
+{
+  vtkm::CellShape shape = connectivity.GetCellShape(cellId);
+  vtkm::Vec<vtkm::FloatDefault,8> weights;
+  vtkm::Vec<CellLocatorPointType,8> derivatives;
+  vtkm::IdComponent numPoints = CellLocatorShapeFunctions(
+        shape, CellLocatorPointType(vtkm::FloatDefault(0)),
+        weights, derivatives);
+  if ((numPoints == 0)
+      || (connectivity.GetNumberOfIndices(cellId) != numPoints))
+  {
+    return 0;
+  }
+
+  CellLocatorPointType lower = points.Get(connectivity.GetIndex(cellId, 0));
+  CellLocatorPointType upper = lower;
+  for (vtkm::IdComponent index = 1; index < numPoints; index++)
+  {
+    CellLocatorPointType point =
+        points.Get(connectivity.GetIndex(cellId, index));
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      if (point[axis] < lower[axis]) { lower[axis] = point[axis]; }
+      if (point[axis] > upper[axis]) { upper[axis] = point[axis]; }
+    }
+  }
+  first = grid.GetBinIndex(lower);
+  last = grid.GetBinIndex(upper);
+  return (last[0] - first[0] + 1)
+      * (last[1] - first[1] + 1)
+      * (last[2] - first[2] + 1);
+}
+
+template<typename ConnectivityType,
+         typename PointPortalType,
+         typename CountPortalType>
+struct CellLocatorCountKernel : public vtkm::exec::FunctorBase
+{
+  PointLocatorGrid Grid;
+  ConnectivityType Connectivity;
+  PointPortalType Points;
+  CountPortalType Counts;
+
+  VTKM_CONT_EXPORT
+  CellLocatorCountKernel(const PointLocatorGrid &grid,
+                         const ConnectivityType &connectivity,
+                         const PointPortalType &points,
+                         const CountPortalType &counts)
+    : Grid(grid), Connectivity(connectivity), Points(points), Counts(counts)
+  {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellId) const
+  {
+    vtkm::Id numPoints = this->Points.GetNumberOfValues();
+    vtkm::IdComponent numIndices =
+        this->Connectivity.GetNumberOfIndices(cellId);
+    for (vtkm::IdComponent index = 0; index < numIndices; index++)
+    {
+      vtkm::Id pointIndex = this->Connectivity.GetIndex(cellId, index);
+      if ((pointIndex < 0) || (pointIndex >= numPoints))
+      {
+        this->RaiseError("Cell references a point index out of range.");
+        this->Counts.Set(cellId, 0);
+        return;
+      }
+    }
+
+    vtkm::Id3 first;
+    vtkm::Id3 last;
+    this->Counts.Set(cellId, CellLocatorBinRange(this->Grid,
+                                                 this->Connectivity,
+                                                 this->Points,
+                                                 cellId,
+                                                 first,
+                                                 last));
+  }
+};
+
+// Writes a key for each bin a cell overlaps that sorts by bin and then by
+// cell.
+template<typename ConnectivityType,
+         typename PointPortalType,
+         typename OffsetPortalType,
+         typename KeyPortalType>
+struct CellLocatorKeyKernel : public vtkm::exec::FunctorBase
+{
+  PointLocatorGrid Grid;
+  ConnectivityType Connectivity;
+  PointPortalType Points;
+  OffsetPortalType Offsets;
+  KeyPortalType Keys;
+
+  VTKM_CONT_EXPORT
+  CellLocatorKeyKernel(const PointLocatorGrid &grid,
+                       const ConnectivityType &connectivity,
+                       const PointPortalType &points,
+                       const OffsetPortalType &offsets,
+                       const KeyPortalType &keys)
+    : Grid(grid),
+      Connectivity(connectivity),
+      Points(points),
+      Offsets(offsets),
+      Keys(keys) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellId) const
+  {
+    vtkm::Id3 first;
+    vtkm::Id3 last;
+    if (CellLocatorBinRange(this->Grid,
+                            this->Connectivity,
+                            this->Points,
+                            cellId,
+                            first,
+                            last) == 0)
+    {
+      return;
+    }
+
+    vtkm::Int64 numCells =
+        static_cast<vtkm::Int64>(this->Connectivity.GetNumberOfElements());
+    vtkm::Id entry = this->Offsets.Get(cellId);
+    for (vtkm::Id k = first[2]; k <= last[2]; k++)
+    {
+      for (vtkm::Id j = first[1]; j <= last[1]; j++)
+      {
+        for (vtkm::Id i = first[0]; i <= last[0]; i++)
+        {
+          this->Keys.Set(entry,
+                         static_cast<vtkm::Int64>(
+                           this->Grid.GetFlatIndex(i, j, k))*numCells
+                         + cellId);
+          entry++;
+        }
+      }
+    }
+  }
+};
+
+template<typename KeyPortalType, typename IdPortalType>
+struct CellLocatorSplitKernel : public vtkm::exec::FunctorBase
+{
+  KeyPortalType Keys;
+  vtkm::Int64 NumberOfCells;
+  IdPortalType BinIds;
+  IdPortalType CellIds;
+
+  VTKM_CONT_EXPORT
+  CellLocatorSplitKernel(const KeyPortalType &keys,
+                         vtkm::Id numberOfCells,
+                         const IdPortalType &binIds,
+                         const IdPortalType &cellIds)
+    : Keys(keys),
+      NumberOfCells(static_cast<vtkm::Int64>(numberOfCells)),
+      BinIds(binIds),
+      CellIds(cellIds) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Int64 key = this->Keys.Get(index);
+    this->BinIds.Set(index, static_cast<vtkm::Id>(key/this->NumberOfCells));
+    this->CellIds.Set(index, static_cast<vtkm::Id>(key%this->NumberOfCells));
+  }
+};
+
+} // namespace internal
+
+/// \brief Finds the cell of an unstructured mesh containing a point, using
+/// a uniform grid of bins.
+///
+/// Build divides the bounds of the mesh into bins and lists in each bin the
+/// cells whose bounding boxes overlap it. A count pass and an exclusive scan
+/// size a list of 64-bit keys made of the bin and the cell, one for each
+/// bin a cell overlaps, and a single sort of the keys groups the cells by
+/// bin. LowerBounds and UpperBounds then give the range of each bin, as in
+/// PointLocatorUniformGrid.
+///
+/// Finding a cell tests the cells of the bin holding the point, inverting
+/// the interpolation of each cell with Newton's method to get the
+/// parametric coordinates of the point. Tetrahedra, hexahedra, wedges and
+/// pyramids are supported; cells of other shapes are never found. The
+/// locator shares the connectivity arrays of the cell set and keeps a copy
+/// of the points, so a locator built once serves every time step of a mesh
+/// that does not change. PrepareForInput gives the execution object, which
+/// can also interpolate point fields in the cells it finds.
+///
+template<typename DeviceAdapterTag,
+         typename CellSetType = vtkm::cont::CellSetExplicit<> >
+class CellLocatorUniformBins
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+  typedef typename CellSetType::template ExecutionTypes<
+      DeviceAdapterTag,
+      vtkm::TopologyElementTagPoint,
+      vtkm::TopologyElementTagCell>::ExecObjectType ConnectivityType;
+  typedef internal::CellLocatorUniformBinsExec<
+      ConnectivityType,
+      typename vtkm::cont::ArrayHandle<PointType>
+          ::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
+      typename vtkm::cont::ArrayHandle<vtkm::Id>
+          ::template ExecutionTypes<DeviceAdapterTag>::PortalConst>
+      ExecObjectType;
+
+  VTKM_CONT_EXPORT
+  CellLocatorUniformBins(const vtkm::Id3 &divisions)
+    : Divisions(divisions) {  }
+
+  VTKM_CONT_EXPORT
+  const vtkm::Id3 &GetDivisions() const { return this->Divisions; }
+
+  /// The number of points of the mesh from the last Build.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::Id GetNumberOfPoints() const
+  {
+    return this->Points.GetNumberOfValues();
+  }
+
+  /// Bins the cells of \p cellSet, whose points are \p points. Throws
+  /// vtkm::cont::ErrorExecution if a cell references a point that is not in
+  /// \p points.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Build(const CellSetType &cellSet,
+             const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &points)
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        InputPointPortalType;
+    typedef typename vtkm::cont::ArrayHandle<PointType>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal PointPortalType;
+    typedef typename vtkm::cont::ArrayHandle<PointType>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        PointPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Int64>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal KeyPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Int64>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        KeyPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+
+    if ((this->Divisions[0] < 1)
+        || (this->Divisions[1] < 1)
+        || (this->Divisions[2] < 1))
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Cell locator needs at least one division on each axis.");
+    }
+
+    vtkm::Id numPoints = points.GetNumberOfValues();
+    Algorithm::Schedule(
+          internal::CellLocatorPointKernel<
+              InputPointPortalType,PointPortalType>(
+            points.PrepareForInput(DeviceAdapterTag()),
+            this->Points.PrepareForOutput(numPoints, DeviceAdapterTag())),
+          numPoints);
+    this->CellSet = cellSet;
+    this->Bounds = vtkm::cont::ComputeBounds(this->Points, DeviceAdapterTag());
+    this->Grid = internal::PointLocatorGrid(this->Divisions, this->Bounds);
+
+    vtkm::Id numCells = cellSet.GetNumberOfCells();
+    vtkm::Id numBins = this->Grid.GetNumberOfBins();
+    if ((numCells > 0)
+        && (static_cast<vtkm::Int64>(numBins)
+            > std::numeric_limits<vtkm::Int64>::max()/numCells))
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Too many cell locator bins for the number of cells.");
+    }
+
+    ConnectivityType connectivity = this->PrepareConnectivity();
+    vtkm::cont::ArrayHandle<vtkm::Id> counts;
+    Algorithm::Schedule(
+          internal::CellLocatorCountKernel<
+              ConnectivityType,PointPortalConstType,IdPortalType>(
+            this->Grid,
+            connectivity,
+            this->Points.PrepareForInput(DeviceAdapterTag()),
+            counts.PrepareForOutput(numCells, DeviceAdapterTag())),
+          numCells);
+    vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+    vtkm::Id numEntries = Algorithm::ScanExclusive(counts, offsets);
+    counts.ReleaseResources();
+
+    vtkm::cont::ArrayHandle<vtkm::Int64> keys;
+    Algorithm::Schedule(
+          internal::CellLocatorKeyKernel<
+              ConnectivityType,
+              PointPortalConstType,
+              IdPortalConstType,
+              KeyPortalType>(
+            this->Grid,
+            connectivity,
+            this->Points.PrepareForInput(DeviceAdapterTag()),
+            offsets.PrepareForInput(DeviceAdapterTag()),
+            keys.PrepareForOutput(numEntries, DeviceAdapterTag())),
+          numCells);
+    offsets.ReleaseResources();
+    Algorithm::Sort(keys);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> binIds;
+    Algorithm::Schedule(
+          internal::CellLocatorSplitKernel<KeyPortalConstType,IdPortalType>(
+            keys.PrepareForInput(DeviceAdapterTag()),
+            numCells,
+            binIds.PrepareForOutput(numEntries, DeviceAdapterTag()),
+            this->BinCellIds.PrepareForOutput(numEntries,
+                                              DeviceAdapterTag())),
+          numEntries);
+    keys.ReleaseResources();
+
+    vtkm::cont::ArrayHandleCounting<vtkm::Id> bins =
+        vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), numBins);
+    Algorithm::LowerBounds(binIds, bins, this->BinStarts);
+    Algorithm::UpperBounds(binIds, bins, this->BinEnds);
+  }
+
+  /// Returns an object that finds cells in the execution environment.
+  ///
+  VTKM_CONT_EXPORT
+  ExecObjectType PrepareForInput() const
+  {
+    return ExecObjectType(
+          this->Grid,
+          this->Bounds,
+          this->PrepareConnectivity(),
+          this->Points.PrepareForInput(DeviceAdapterTag()),
+          this->BinCellIds.PrepareForInput(DeviceAdapterTag()),
+          this->BinStarts.PrepareForInput(DeviceAdapterTag()),
+          this->BinEnds.PrepareForInput(DeviceAdapterTag()));
+  }
+
+private:
+  vtkm::Id3 Divisions;
+  internal::PointLocatorGrid Grid;
+  vtkm::Bounds Bounds;
+  CellSetType CellSet;
+  vtkm::cont::ArrayHandle<PointType> Points;
+  vtkm::cont::ArrayHandle<vtkm::Id> BinCellIds;
+  vtkm::cont::ArrayHandle<vtkm::Id> BinStarts;
+  vtkm::cont::ArrayHandle<vtkm::Id> BinEnds;
+
+  VTKM_CONT_EXPORT
+  ConnectivityType PrepareConnectivity() const
+  {
+    return this->CellSet.PrepareForInput(DeviceAdapterTag(),
+                                         vtkm::TopologyElementTagPoint(),
+                                         vtkm::TopologyElementTagCell());
+  }
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_CellLocatorUniformBins_h
@@ -0,0 +1,737 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_ExternalFaces_h
+#define vtk_m_worklet_ExternalFaces_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/internal/ArrayPortalAtomic.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <boost/smart_ptr/shared_ptr.hpp>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+// The faces of the 3D cell shapes, numbered like those of VTK so that they
+// point out of the cell. Each row is the number of points of the face
+// followed by the points of the cell that form it. The shapes are the
+// tetrahedron, hexahedron, wedge, and pyramid.
+
+const vtkm::IdComponent ExternalFacesNumberOfFacesTable[4] = { 4, 6, 5, 5 };
+
+const vtkm::IdComponent ExternalFacesTable[4][6][5] = {
+  { { 3, 0, 1, 3, -1 }, { 3, 1, 2, 3, -1 }, { 3, 2, 0, 3, -1 },
+    { 3, 0, 2, 1, -1 }, { 0, -1, -1, -1, -1 }, { 0, -1, -1, -1, -1 } },
+  { { 4, 0, 4, 7, 3 }, { 4, 1, 2, 6, 5 }, { 4, 0, 1, 5, 4 },
+    { 4, 3, 7, 6, 2 }, { 4, 0, 3, 2, 1 }, { 4, 4, 5, 6, 7 } },
+  { { 3, 0, 1, 2, -1 }, { 3, 3, 5, 4, -1 }, { 4, 0, 3, 4, 1 },
+    { 4, 1, 4, 5, 2 }, { 4, 2, 5, 3, 0 }, { 0, -1, -1, -1, -1 } },
+  { { 4, 0, 3, 2, 1 }, { 3, 0, 1, 4, -1 }, { 3, 1, 2, 4, -1 },
+    { 3, 2, 3, 4, -1 }, { 3, 3, 0, 4, -1 }, { 0, -1, -1, -1, -1 } }
+};
+
+VTKM_EXEC_CONT_EXPORT
+vtkm::IdComponent ExternalFacesShapeIndex(vtkm::CellShape shape)
+{
+  switch (shape)
+  {
+    case vtkm::CELL_SHAPE_TETRA: return 0;
+    case vtkm::CELL_SHAPE_HEXAHEDRON: return 1;
+    case vtkm::CELL_SHAPE_WEDGE: return 2;
+    case vtkm::CELL_SHAPE_PYRAMID: return 3;
+    default: return -1;
+  }
+}
+
+/// The number of faces of a cell shape. Shapes that are not 3D have none.
+///
+VTKM_EXEC_CONT_EXPORT
+vtkm::IdComponent ExternalFacesNumberOfFaces(vtkm::CellShape shape)
+{
+  vtkm::IdComponent shapeIndex = ExternalFacesShapeIndex(shape);
+  return (shapeIndex < 0) ? 0 : ExternalFacesNumberOfFacesTable[shapeIndex];
+}
+
+/// Gets the points of a face of a cell, in the order that makes the face
+/// point out of the cell, and returns the number of points. Unused entries
+/// of \p points are -1.
+///
+template<typename ConnectivityType>
+VTKM_EXEC_EXPORT
+vtkm::IdComponent ExternalFacesGetFace(const ConnectivityType &connectivity,
+                                       vtkm::Id cellIndex,
+                                       vtkm::IdComponent faceIndex,
+                                       vtkm::Vec<vtkm::Id,4> &points)
+{
+  const vtkm::IdComponent *face = ExternalFacesTable[
+      ExternalFacesShapeIndex(connectivity.GetCellShape(cellIndex))][faceIndex];
+  for (vtkm::IdComponent pointInFace = 0; pointInFace < 4; pointInFace++)
+  {
+    points[pointInFace] = (pointInFace < face[0])
+        ? connectivity.GetIndex(cellIndex, face[pointInFace+1]) : -1;
+  }
+  return face[0];
+}
+
+/// Sorts the points of a face so that faces with the same points compare
+/// equal. The unused entries stay at the end.
+///
+VTKM_EXEC_EXPORT
+void ExternalFacesSortFace(vtkm::Vec<vtkm::Id,4> &points,
+                           vtkm::IdComponent numPoints)
+{
+  for (vtkm::IdComponent i = 1; i < numPoints; i++)
+  {
+    vtkm::Id point = points[i];
+    vtkm::IdComponent j = i;
+    for (; (j > 0) && (point < points[j-1]); j--)
+    {
+      points[j] = points[j-1];
+    }
+    points[j] = point;
+  }
+}
+
+template<typename ConnectivityType, typename CountPortalType>
+struct ExternalFacesCountKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  CountPortalType Counts;
+
+  VTKM_CONT_EXPORT
+  ExternalFacesCountKernel(const ConnectivityType &connectivity,
+                           const CountPortalType &counts)
+    : Connectivity(connectivity), Counts(counts) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    this->Counts.Set(cellIndex, ExternalFacesNumberOfFaces(
+                       this->Connectivity.GetCellShape(cellIndex)));
+  }
+};
+
+/// Hashes the sorted points of a face. The points are combined and then
+/// mixed with the finalizer of MurmurHash3 so that the low bits, which pick
+/// the slot of the table, depend on all the points.
+///
+VTKM_EXEC_EXPORT
+vtkm::UInt64 ExternalFacesHash(const vtkm::Vec<vtkm::Id,4> &face)
+{
+  const vtkm::UInt64 multiplier1 =
+      (static_cast<vtkm::UInt64>(0xff51afd7) << 32) | 0xed558ccd;
+  const vtkm::UInt64 multiplier2 =
+      (static_cast<vtkm::UInt64>(0xc4ceb9fe) << 32) | 0x1a85ec53;
+  vtkm::UInt64 hash = 0;
+  for (vtkm::IdComponent pointInFace = 0; pointInFace < 4; pointInFace++)
+  {
+    hash = (hash ^ static_cast<vtkm::UInt64>(face[pointInFace] + 1))
+        * multiplier1;
+    hash ^= hash >> 33;
+  }
+  hash *= multiplier2;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Inserts every face of a cell into an open addressing hash table keyed by
+// the sorted points of the face. The table is two arrays with an entry per
+// slot. An entry is -1 while the slot is empty and -2 while a face is being
+// written to it. Otherwise it holds the cell and local index of the first
+// face inserted with the key, shifted left by one, and its low bit is set
+// once a second face with the same key is inserted. The sorted points of
+// the face are kept in the other array so that probing does not go back to
+// the connectivity. Slots are claimed with an atomic compare and swap, so
+// the cells can be handled in parallel.
+template<typename ConnectivityType,
+         typename EntryPortalType,
+         typename FacePortalType>
+struct ExternalFacesHashInsertKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  EntryPortalType Entries;
+  FacePortalType Faces;
+  vtkm::UInt64 Mask;
+  vtkm::Float64 SlotsPerPoint;
+  vtkm::UInt64 Spread;
+
+  VTKM_CONT_EXPORT
+  ExternalFacesHashInsertKernel(const ConnectivityType &connectivity,
+                                const EntryPortalType &entries,
+                                const FacePortalType &faces,
+                                vtkm::Id numberOfPoints)
+    : Connectivity(connectivity),
+      Entries(entries),
+      Faces(faces),
+      Mask(static_cast<vtkm::UInt64>(entries.GetNumberOfValues() - 1)),
+      SlotsPerPoint(static_cast<vtkm::Float64>(entries.GetNumberOfValues())
+                    / static_cast<vtkm::Float64>(numberOfPoints)),
+      Spread(static_cast<vtkm::UInt64>(
+               entries.GetNumberOfValues()/numberOfPoints) + 1) {  }
+
+  VTKM_EXEC_EXPORT
+  void Insert(vtkm::Int64 entry, const vtkm::Vec<vtkm::Id,4> &face) const
+  {
+    // The first slot tried is in a range set by the smallest point of the
+    // face, so the faces of nearby cells are near each other in the table.
+    vtkm::UInt64 slot =
+        (static_cast<vtkm::UInt64>(
+           static_cast<vtkm::Float64>(face[0])*this->SlotsPerPoint)
+         + ExternalFacesHash(face) % this->Spread) & this->Mask;
+    while (true)
+    {
+      vtkm::Id slotIndex = static_cast<vtkm::Id>(slot);
+      vtkm::Int64 current = this->Entries.Get(slotIndex);
+      if (current == -1)
+      {
+        current = this->Entries.CompareAndSwap(slotIndex, -1, -2);
+        if (current == -1)
+        {
+          this->Faces.Set(slotIndex, face);
+          this->Entries.CompareAndSwap(slotIndex, -2, entry);
+          return;
+        }
+      }
+      while (current == -2)
+      {
+        current = this->Entries.Add(slotIndex, 0);
+      }
+
+      if (this->Faces.Get(slotIndex) == face)
+      {
+        // Only the low bit can change once a slot is written, so a failed
+        // swap means another face already set it.
+        if ((current & 1) == 0)
+        {
+          this->Entries.CompareAndSwap(slotIndex, current, current | 1);
+        }
+        return;
+      }
+      slot = (slot + 1) & this->Mask;
+    }
+  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    vtkm::IdComponent numFaces = ExternalFacesNumberOfFaces(
+          this->Connectivity.GetCellShape(cellIndex));
+    for (vtkm::IdComponent faceIndex = 0; faceIndex < numFaces; faceIndex++)
+    {
+      vtkm::Vec<vtkm::Id,4> face;
+      vtkm::IdComponent numPoints = ExternalFacesGetFace(this->Connectivity,
+                                                         cellIndex,
+                                                         faceIndex,
+                                                         face);
+      ExternalFacesSortFace(face, numPoints);
+      this->Insert(((static_cast<vtkm::Int64>(cellIndex) << 3) | faceIndex)
+                   << 1,
+                   face);
+    }
+  }
+};
+
+// Flags the face of each slot of the hash table that was inserted only
+// once.
+template<typename EntryPortalType,
+         typename OffsetPortalType,
+         typename FlagPortalType>
+struct ExternalFacesHashFlagKernel : public vtkm::exec::FunctorBase
+{
+  EntryPortalType Entries;
+  OffsetPortalType FaceOffsets;
+  FlagPortalType Flags;
+
+  VTKM_CONT_EXPORT
+  ExternalFacesHashFlagKernel(const EntryPortalType &entries,
+                              const OffsetPortalType &faceOffsets,
+                              const FlagPortalType &flags)
+    : Entries(entries), FaceOffsets(faceOffsets), Flags(flags) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id slot) const
+  {
+    vtkm::Int64 entry = this->Entries.Get(slot);
+    if ((entry < 0) || ((entry & 1) != 0)) { return; }
+    vtkm::Id cellIndex = static_cast<vtkm::Id>(entry >> 4);
+    vtkm::Id faceIndex = static_cast<vtkm::Id>((entry >> 1) & 7);
+    this->Flags.Set(this->FaceOffsets.Get(cellIndex) + faceIndex, 1);
+  }
+};
+
+/// The sorted points of a face followed by the index of the face, used by
+/// the sorting method.
+///
+typedef vtkm::Vec<vtkm::Id,5> ExternalFacesKey;
+
+template<typename ConnectivityType,
+         typename OffsetPortalType,
+         typename KeyPortalType>
+struct ExternalFacesKeyKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  OffsetPortalType FaceOffsets;
+  KeyPortalType Keys;
+
+  VTKM_CONT_EXPORT
+  ExternalFacesKeyKernel(const ConnectivityType &connectivity,
+                         const OffsetPortalType &faceOffsets,
+                         const KeyPortalType &keys)
+    : Connectivity(connectivity), FaceOffsets(faceOffsets), Keys(keys) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    vtkm::Id offset = this->FaceOffsets.Get(cellIndex);
+    vtkm::IdComponent numFaces = ExternalFacesNumberOfFaces(
+          this->Connectivity.GetCellShape(cellIndex));
+    for (vtkm::IdComponent faceIndex = 0; faceIndex < numFaces; faceIndex++)
+    {
+      vtkm::Vec<vtkm::Id,4> face;
+      vtkm::IdComponent numPoints = ExternalFacesGetFace(this->Connectivity,
+                                                         cellIndex,
+                                                         faceIndex,
+                                                         face);
+      ExternalFacesSortFace(face, numPoints);
+      ExternalFacesKey key;
+      for (vtkm::IdComponent pointInFace = 0; pointInFace < 4; pointInFace++)
+      {
+        key[pointInFace] = face[pointInFace];
+      }
+      key[4] = offset + faceIndex;
+      this->Keys.Set(offset + faceIndex, key);
+    }
+  }
+};
+
+// Flags the faces whose sorted keys differ from both neighbors. The flags
+// are scattered back to the order of the faces.
+template<typename KeyPortalType, typename FlagPortalType>
+struct ExternalFacesSortedFlagKernel : public vtkm::exec::FunctorBase
+{
+  KeyPortalType Keys;
+  FlagPortalType Flags;
+
+  VTKM_CONT_EXPORT
+  ExternalFacesSortedFlagKernel(const KeyPortalType &keys,
+                                const FlagPortalType &flags)
+    : Keys(keys), Flags(flags) {  }
+
+  VTKM_EXEC_EXPORT
+  static bool SameFace(const ExternalFacesKey &a, const ExternalFacesKey &b)
+  {
+    return ((a[0] == b[0]) && (a[1] == b[1])
+            && (a[2] == b[2]) && (a[3] == b[3]));
+  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    ExternalFacesKey key = this->Keys.Get(index);
+    bool shared =
+        ((index > 0) && SameFace(key, this->Keys.Get(index-1)))
+        || ((index+1 < this->Keys.GetNumberOfValues())
+            && SameFace(key, this->Keys.Get(index+1)));
+    this->Flags.Set(key[4], shared ? 0 : 1);
+  }
+};
+
+// Writes the number of points of each external face and zero for the
+// others, so that a scan gives the connectivity offsets of the output.
+template<typename ConnectivityType,
+         typename OffsetPortalType,
+         typename FlagPortalType,
+         typename SizePortalType>
+struct ExternalFacesSizeKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  OffsetPortalType FaceOffsets;
+  FlagPortalType Flags;
+  SizePortalType Sizes;
+
+  VTKM_CONT_EXPORT
+  ExternalFacesSizeKernel(const ConnectivityType &connectivity,
+                          const OffsetPortalType &faceOffsets,
+                          const FlagPortalType &flags,
+                          const SizePortalType &sizes)
+    : Connectivity(connectivity),
+      FaceOffsets(faceOffsets),
+      Flags(flags),
+      Sizes(sizes) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    vtkm::IdComponent shapeIndex =
+        ExternalFacesShapeIndex(this->Connectivity.GetCellShape(cellIndex));
+    if (shapeIndex < 0) { return; }
+    vtkm::Id offset = this->FaceOffsets.Get(cellIndex);
+    for (vtkm::IdComponent faceIndex = 0;
+         faceIndex < ExternalFacesNumberOfFacesTable[shapeIndex];
+         faceIndex++)
+    {
+      this->Sizes.Set(offset + faceIndex,
+                      (this->Flags.Get(offset + faceIndex) != 0)
+                      ? ExternalFacesTable[shapeIndex][faceIndex][0] : 0);
+    }
+  }
+};
+
+template<typename ConnectivityType,
+         typename IdPortalType,
+         typename ShapePortalType,
+         typename NumIndicesPortalType,
+         typename OutputIdPortalType>
+struct ExternalFacesOutputKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  IdPortalType FaceOffsets;
+  IdPortalType Flags;
+  IdPortalType OutputFaceIndices;
+  IdPortalType OutputConnectivityOffsets;
+  ShapePortalType Shapes;
+  NumIndicesPortalType NumIndices;
+  OutputIdPortalType OutputConnectivity;
+  OutputIdPortalType FaceCellIds;
+
+  VTKM_CONT_EXPORT
+  ExternalFacesOutputKernel(const ConnectivityType &connectivity,
+                            const IdPortalType &faceOffsets,
+                            const IdPortalType &flags,
+                            const IdPortalType &outputFaceIndices,
+                            const IdPortalType &outputConnectivityOffsets,
+                            const ShapePortalType &shapes,
+                            const NumIndicesPortalType &numIndices,
+                            const OutputIdPortalType &outputConnectivity,
+                            const OutputIdPortalType &faceCellIds)
+    : Connectivity(connectivity),
+      FaceOffsets(faceOffsets),
+      Flags(flags),
+      OutputFaceIndices(outputFaceIndices),
+      OutputConnectivityOffsets(outputConnectivityOffsets),
+      Shapes(shapes),
+      NumIndices(numIndices),
+      OutputConnectivity(outputConnectivity),
+      FaceCellIds(faceCellIds) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    vtkm::Id offset = this->FaceOffsets.Get(cellIndex);
+    vtkm::IdComponent numFaces = ExternalFacesNumberOfFaces(
+          this->Connectivity.GetCellShape(cellIndex));
+    for (vtkm::IdComponent faceIndex = 0; faceIndex < numFaces; faceIndex++)
+    {
+      if (this->Flags.Get(offset + faceIndex) == 0) { continue; }
+      vtkm::Vec<vtkm::Id,4> face;
+      vtkm::IdComponent numPoints = ExternalFacesGetFace(this->Connectivity,
+                                                         cellIndex,
+                                                         faceIndex,
+                                                         face);
+      vtkm::Id outputIndex = this->OutputFaceIndices.Get(offset + faceIndex);
+      vtkm::Id connectivityOffset =
+          this->OutputConnectivityOffsets.Get(offset + faceIndex);
+      this->Shapes.Set(outputIndex, static_cast<vtkm::UInt8>(
+                         (numPoints == 3)
+                         ? vtkm::CELL_SHAPE_TRIANGLE : vtkm::CELL_SHAPE_QUAD));
+      this->NumIndices.Set(outputIndex, numPoints);
+      this->FaceCellIds.Set(outputIndex, cellIndex);
+      for (vtkm::IdComponent pointInFace = 0;
+           pointInFace < numPoints;
+           pointInFace++)
+      {
+        this->OutputConnectivity.Set(connectivityOffset + pointInFace,
+                                     face[pointInFace]);
+      }
+    }
+  }
+};
+
+} // namespace internal
+
+/// \brief Extracts the faces of 3D cells that are not shared by two cells.
+///
+/// The faces of every tetrahedron, hexahedron, wedge, and pyramid are
+/// numbered with a scan of the number of faces of each cell, and each face
+/// is flagged if no other cell has the same points. The flagged faces are
+/// written, pointing out of their cells, to a CellSetExplicit of triangles
+/// and quads that uses the points of the input. Cells of other shapes have
+/// no faces.
+///
+/// By default the faces are counted with a hash table keyed by their sorted
+/// points. Each face is inserted once, claiming an empty slot with an atomic
+/// compare and swap or marking the slot of an equal key as shared, and a
+/// pass over the table flags the faces that were never matched. This takes
+/// time linear in the number of faces. Faces are placed in the table near a
+/// position proportional to their smallest point, so cells that are close
+/// in the connectivity work on the same part of the table.
+///
+/// SetUseSorting switches to the classic method of sorting a key of every
+/// face and keeping the keys that appear once, which needs no atomic
+/// operations. Both methods give the same output.
+///
+template<typename DeviceAdapterTag>
+class ExternalFaces
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef vtkm::cont::CellSetExplicit<> OutputCellSetType;
+
+  VTKM_CONT_EXPORT
+  ExternalFaces()
+    : UseSorting(false), OutputCellSet(new OutputCellSetType) {  }
+
+  VTKM_CONT_EXPORT
+  bool GetUseSorting() const { return this->UseSorting; }
+
+  VTKM_CONT_EXPORT
+  void SetUseSorting(bool useSorting) { this->UseSorting = useSorting; }
+
+  /// Finds the external faces of \p cellSet. Any cell set whose point to
+  /// cell connectivity gives GetCellShape and GetIndex can be used. The
+  /// result is available from GetOutputCellSet and GetFaceCellIds.
+  ///
+  template<typename CellSetType>
+  VTKM_CONT_EXPORT
+  void Run(const CellSetType &cellSet)
+  {
+    typedef typename CellSetType::template ExecutionTypes<
+        DeviceAdapterTag,
+        vtkm::TopologyElementTagPoint,
+        vtkm::TopologyElementTagCell>::ExecObjectType PointToCellType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+
+    vtkm::Id numCells = cellSet.GetNumberOfCells();
+    PointToCellType pointsOfCells =
+        cellSet.PrepareForInput(DeviceAdapterTag(),
+                                vtkm::TopologyElementTagPoint(),
+                                vtkm::TopologyElementTagCell());
+
+    vtkm::cont::ArrayHandle<vtkm::Id> faceCounts;
+    Algorithm::Schedule(
+          internal::ExternalFacesCountKernel<PointToCellType,IdPortalType>(
+            pointsOfCells,
+            faceCounts.PrepareForOutput(numCells, DeviceAdapterTag())),
+          numCells);
+    vtkm::cont::ArrayHandle<vtkm::Id> faceOffsets;
+    vtkm::Id numFaces = Algorithm::ScanExclusive(faceCounts, faceOffsets);
+    faceCounts.ReleaseResources();
+
+    vtkm::cont::ArrayHandle<vtkm::Id> flags;
+    if (this->UseSorting)
+    {
+      this->FlagFacesBySorting(pointsOfCells, faceOffsets, numFaces, flags);
+    }
+    else
+    {
+      this->FlagFacesByHashing(pointsOfCells,
+                               faceOffsets,
+                               cellSet.GetNumberOfPoints(),
+                               numFaces,
+                               flags);
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Id> sizes;
+    Algorithm::Schedule(
+          internal::ExternalFacesSizeKernel<
+            PointToCellType,IdPortalConstType,IdPortalConstType,IdPortalType>(
+            pointsOfCells,
+            faceOffsets.PrepareForInput(DeviceAdapterTag()),
+            flags.PrepareForInput(DeviceAdapterTag()),
+            sizes.PrepareForOutput(numFaces, DeviceAdapterTag())),
+          numCells);
+    vtkm::cont::ArrayHandle<vtkm::Id> outputFaceIndices;
+    vtkm::Id numOutputFaces =
+        Algorithm::ScanExclusive(flags, outputFaceIndices);
+    vtkm::cont::ArrayHandle<vtkm::Id> connectivityOffsets;
+    vtkm::Id connectivityLength =
+        Algorithm::ScanExclusive(sizes, connectivityOffsets);
+    sizes.ReleaseResources();
+
+    typename OutputCellSetType::ShapeArrayType shapes;
+    typename OutputCellSetType::NumIndicesArrayType numIndices;
+    typename OutputCellSetType::ConnectivityArrayType connectivity;
+    Algorithm::Schedule(
+          internal::ExternalFacesOutputKernel<
+            PointToCellType,
+            IdPortalConstType,
+            typename OutputCellSetType::ShapeArrayType
+              ::template ExecutionTypes<DeviceAdapterTag>::Portal,
+            typename OutputCellSetType::NumIndicesArrayType
+              ::template ExecutionTypes<DeviceAdapterTag>::Portal,
+            IdPortalType>(
+            pointsOfCells,
+            faceOffsets.PrepareForInput(DeviceAdapterTag()),
+            flags.PrepareForInput(DeviceAdapterTag()),
+            outputFaceIndices.PrepareForInput(DeviceAdapterTag()),
+            connectivityOffsets.PrepareForInput(DeviceAdapterTag()),
+            shapes.PrepareForOutput(numOutputFaces, DeviceAdapterTag()),
+            numIndices.PrepareForOutput(numOutputFaces, DeviceAdapterTag()),
+            connectivity.PrepareForOutput(connectivityLength,
+                                          DeviceAdapterTag()),
+            this->FaceCellIds.PrepareForOutput(numOutputFaces,
+                                               DeviceAdapterTag())),
+          numCells);
+
+    this->OutputCellSet.reset(
+          new OutputCellSetType(cellSet.GetName(),
+                                cellSet.GetNumberOfPoints(),
+                                2));
+    this->OutputCellSet->Fill(shapes, numIndices, connectivity);
+  }
+
+  VTKM_CONT_EXPORT
+  boost::shared_ptr<OutputCellSetType> GetOutputCellSet() const
+  {
+    return this->OutputCellSet;
+  }
+
+  /// The input cell of each output face.
+  ///
+  VTKM_CONT_EXPORT
+  const vtkm::cont::ArrayHandle<vtkm::Id> &GetFaceCellIds() const
+  {
+    return this->FaceCellIds;
+  }
+
+private:
+  bool UseSorting;
+  boost::shared_ptr<OutputCellSetType> OutputCellSet;
+  vtkm::cont::ArrayHandle<vtkm::Id> FaceCellIds;
+
+  template<typename PointToCellType>
+  VTKM_CONT_EXPORT
+  void FlagFacesByHashing(const PointToCellType &pointsOfCells,
+                          const vtkm::cont::ArrayHandle<vtkm::Id> &faceOffsets,
+                          vtkm::Id numPoints,
+                          vtkm::Id numFaces,
+                          vtkm::cont::ArrayHandle<vtkm::Id> &flags) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+    typedef vtkm::cont::internal::ArrayPortalAtomic<
+        vtkm::Int64,DeviceAdapterTag> EntryPortalType;
+    typedef vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Id,4> > FaceArrayType;
+
+    Algorithm::Copy(vtkm::cont::make_ArrayHandleConstant(vtkm::Id(0),
+                                                         numFaces),
+                    flags);
+    if (numFaces < 1) { return; }
+
+    // The table has more slots than there are faces, so it cannot fill up.
+    // Each interior face shares a key with its neighbor, so a volume mesh
+    // fills less than half of it.
+    vtkm::Id tableSize = 1;
+    while (tableSize <= numFaces) { tableSize *= 2; }
+
+    // Faces start near a slot proportional to their smallest point. A cell
+    // set that does not know its number of points gets no locality, but
+    // the faces are still spread over the table by their hash.
+    if (numPoints < 1) { numPoints = 1; }
+
+    vtkm::cont::ArrayHandle<vtkm::Int64> entries;
+    Algorithm::Copy(vtkm::cont::make_ArrayHandleConstant(vtkm::Int64(-1),
+                                                         tableSize),
+                    entries);
+    FaceArrayType faces;
+    Algorithm::Schedule(
+          internal::ExternalFacesHashInsertKernel<
+            PointToCellType,
+            EntryPortalType,
+            typename FaceArrayType::template ExecutionTypes<DeviceAdapterTag>
+              ::Portal>(
+            pointsOfCells,
+            EntryPortalType(entries),
+            faces.PrepareForOutput(tableSize, DeviceAdapterTag()),
+            numPoints),
+          faceOffsets.GetNumberOfValues());
+    faces.ReleaseResources();
+
+    Algorithm::Schedule(
+          internal::ExternalFacesHashFlagKernel<
+            typename vtkm::cont::ArrayHandle<vtkm::Int64>
+              ::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
+            IdPortalConstType,
+            IdPortalType>(
+            entries.PrepareForInput(DeviceAdapterTag()),
+            faceOffsets.PrepareForInput(DeviceAdapterTag()),
+            flags.PrepareForInPlace(DeviceAdapterTag())),
+          tableSize);
+  }
+
+  template<typename PointToCellType>
+  VTKM_CONT_EXPORT
+  void FlagFacesBySorting(const PointToCellType &pointsOfCells,
+                          const vtkm::cont::ArrayHandle<vtkm::Id> &faceOffsets,
+                          vtkm::Id numFaces,
+                          vtkm::cont::ArrayHandle<vtkm::Id> &flags) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+    typedef vtkm::cont::ArrayHandle<internal::ExternalFacesKey> KeyArrayType;
+
+    KeyArrayType keys;
+    Algorithm::Schedule(
+          internal::ExternalFacesKeyKernel<
+            PointToCellType,
+            IdPortalConstType,
+            typename KeyArrayType::template ExecutionTypes<DeviceAdapterTag>
+              ::Portal>(
+            pointsOfCells,
+            faceOffsets.PrepareForInput(DeviceAdapterTag()),
+            keys.PrepareForOutput(numFaces, DeviceAdapterTag())),
+          faceOffsets.GetNumberOfValues());
+    Algorithm::Sort(keys);
+    Algorithm::Schedule(
+          internal::ExternalFacesSortedFlagKernel<
+            typename KeyArrayType::template ExecutionTypes<DeviceAdapterTag>
+              ::PortalConst,
+            IdPortalType>(
+            keys.PrepareForInput(DeviceAdapterTag()),
+            flags.PrepareForOutput(numFaces, DeviceAdapterTag())),
+          numFaces);
+  }
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_ExternalFaces_h
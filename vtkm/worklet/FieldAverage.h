@@ -0,0 +1,496 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_FieldAverage_h
+#define vtk_m_worklet_FieldAverage_h
+
+#include <vtkm/Extent.h>
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/Types.h>
+#include <vtkm/VecTraits.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+// The number of rows of a structured grid that one task of the tiled
+// averaging kernels walks through together.
+static const vtkm::IdComponent FIELD_AVERAGE_TILE_ROWS = 8;
+
+// Treats a structured grid of any dimension as 3D. An axis with one point
+// has one cell and a step of 0 between points, so both points of the cell
+// on that axis are the same point and the averages stay correct.
+struct FieldAverageGrid
+{
+  vtkm::Id3 CellDimensions;
+  vtkm::Id3 PointSteps;
+
+  VTKM_CONT_EXPORT
+  FieldAverageGrid(const vtkm::Id3 &pointDimensions)
+  {
+    vtkm::Id step = 1;
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      bool flat = (pointDimensions[axis] < 2);
+      this->CellDimensions[axis] = flat ? 1 : pointDimensions[axis] - 1;
+      this->PointSteps[axis] = flat ? 0 : step;
+      step *= pointDimensions[axis];
+    }
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfTiles() const
+  {
+    return this->CellDimensions[2]
+        * ((this->CellDimensions[1] + FIELD_AVERAGE_TILE_ROWS - 1)
+           / FIELD_AVERAGE_TILE_ROWS);
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetPointIndex(vtkm::Id i, vtkm::Id j, vtkm::Id k) const
+  {
+    return i*this->PointSteps[0] + j*this->PointSteps[1]
+        + k*this->PointSteps[2];
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetCellIndex(vtkm::Id i, vtkm::Id j, vtkm::Id k) const
+  {
+    return (k*this->CellDimensions[1] + j)*this->CellDimensions[0] + i;
+  }
+};
+
+VTKM_CONT_EXPORT
+vtkm::Id3 FieldAveragePointDimensions(const vtkm::Extent3 &extent)
+{
+  return vtkm::ExtentPointDimensions(extent);
+}
+
+VTKM_CONT_EXPORT
+vtkm::Id3 FieldAveragePointDimensions(const vtkm::Extent2 &extent)
+{
+  vtkm::Id2 dims = vtkm::ExtentPointDimensions(extent);
+  return vtkm::Id3(dims[0], dims[1], 1);
+}
+
+// Each task averages a tile of FIELD_AVERAGE_TILE_ROWS rows of cells in one
+// layer, walking along x. The points of a column across the tile are summed
+// in pairs along z once, and each cell adds the pair sums of the two columns
+// and two rows at its corners, so every point of the tile is loaded once
+// rather than once for each of its cells.
+template<typename InPortalType, typename OutPortalType>
+struct PointToCellAverageStructuredKernel : public vtkm::exec::FunctorBase
+{
+  typedef typename OutPortalType::ValueType ValueType;
+  typedef typename vtkm::VecTraits<ValueType>::ComponentType ComponentType;
+
+  InPortalType Input;
+  OutPortalType Output;
+  FieldAverageGrid Grid;
+
+  VTKM_CONT_EXPORT
+  PointToCellAverageStructuredKernel(const InPortalType &input,
+                                     const OutPortalType &output,
+                                     const FieldAverageGrid &grid)
+    : Input(input), Output(output), Grid(grid) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id tile) const
+  {
+    const vtkm::Id3 &cellDims = this->Grid.CellDimensions;
+    vtkm::Id tilesPerLayer =
+        (cellDims[1] + FIELD_AVERAGE_TILE_ROWS - 1) / FIELD_AVERAGE_TILE_ROWS;
+    vtkm::Id k = tile / tilesPerLayer;
+    vtkm::Id j0 = (tile % tilesPerLayer) * FIELD_AVERAGE_TILE_ROWS;
+    vtkm::Id numRows = cellDims[1] - j0;
+    if (numRows > FIELD_AVERAGE_TILE_ROWS)
+    {
+      numRows = FIELD_AVERAGE_TILE_ROWS;
+    }
+    vtkm::Id stepZ = this->Grid.PointSteps[2];
+    ComponentType scale =
+        static_cast<ComponentType>(1) / static_cast<ComponentType>(8);
+
+    ValueType previous[FIELD_AVERAGE_TILE_ROWS+1];
+    ValueType current[FIELD_AVERAGE_TILE_ROWS+1];
+    for (vtkm::Id i = 0; i <= cellDims[0]; i++)
+    {
+      for (vtkm::Id row = 0; row <= numRows; row++)
+      {
+        vtkm::Id pointIndex = this->Grid.GetPointIndex(i, j0 + row, k);
+        current[row] = this->Input.Get(pointIndex)
+            + this->Input.Get(pointIndex + stepZ);
+      }
+      if (i > 0)
+      {
+        vtkm::Id cellIndex = this->Grid.GetCellIndex(i - 1, j0, k);
+        for (vtkm::Id row = 0; row < numRows; row++)
+        {
+          this->Output.Set(cellIndex,
+                           (previous[row] + previous[row+1]
+                            + current[row] + current[row+1]) * scale);
+          cellIndex += cellDims[0];
+        }
+      }
+      for (vtkm::Id row = 0; row <= numRows; row++)
+      {
+        previous[row] = current[row];
+      }
+    }
+  }
+};
+
+// Each task averages a tile of FIELD_AVERAGE_TILE_ROWS rows of points in one
+// layer, walking along x. For each column of cells, the cells of the rows
+// around the tile are summed over the layers next to the points once, and
+// each point adds the sums of the cells at its corners and divides by how
+// many there are. Cells past the boundary count as zero.
+template<typename InPortalType, typename OutPortalType>
+struct CellToPointAverageStructuredKernel : public vtkm::exec::FunctorBase
+{
+  typedef typename OutPortalType::ValueType ValueType;
+  typedef typename vtkm::VecTraits<ValueType>::ComponentType ComponentType;
+
+  InPortalType Input;
+  OutPortalType Output;
+  FieldAverageGrid Grid;
+  vtkm::Id3 PointDimensions;
+
+  VTKM_CONT_EXPORT
+  CellToPointAverageStructuredKernel(const InPortalType &input,
+                                     const OutPortalType &output,
+                                     const FieldAverageGrid &grid,
+                                     const vtkm::Id3 &pointDimensions)
+    : Input(input),
+      Output(output),
+      Grid(grid),
+      PointDimensions(pointDimensions) {  }
+
+  VTKM_EXEC_EXPORT
+  static vtkm::Id CountCells(vtkm::Id point, vtkm::Id numCells)
+  {
+    return ((point > 0) ? 1 : 0) + ((point < numCells) ? 1 : 0);
+  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id tile) const
+  {
+    const vtkm::Id3 &cellDims = this->Grid.CellDimensions;
+    const vtkm::Id3 &pointDims = this->PointDimensions;
+    vtkm::Id tilesPerLayer =
+        (pointDims[1] + FIELD_AVERAGE_TILE_ROWS - 1) / FIELD_AVERAGE_TILE_ROWS;
+    vtkm::Id k = tile / tilesPerLayer;
+    vtkm::Id j0 = (tile % tilesPerLayer) * FIELD_AVERAGE_TILE_ROWS;
+    vtkm::Id numRows = pointDims[1] - j0;
+    if (numRows > FIELD_AVERAGE_TILE_ROWS)
+    {
+      numRows = FIELD_AVERAGE_TILE_ROWS;
+    }
+    const ValueType zero = ValueType(static_cast<ComponentType>(0));
+    vtkm::Id countZ = CountCells(k, cellDims[2]);
+
+    // Entry q holds cell row j0 + q - 1.
+    ValueType previous[FIELD_AVERAGE_TILE_ROWS+1];
+    ValueType current[FIELD_AVERAGE_TILE_ROWS+1];
+    for (vtkm::Id row = 0; row <= numRows; row++)
+    {
+      previous[row] = zero;
+    }
+    for (vtkm::Id i = 0; i < pointDims[0]; i++)
+    {
+      for (vtkm::Id row = 0; row <= numRows; row++)
+      {
+        vtkm::Id cellRow = j0 + row - 1;
+        current[row] = zero;
+        if ((i < cellDims[0]) && (cellRow >= 0) && (cellRow < cellDims[1]))
+        {
+          if (k > 0)
+          {
+            current[row] = current[row]
+                + this->Input.Get(this->Grid.GetCellIndex(i, cellRow, k-1));
+          }
+          if (k < cellDims[2])
+          {
+            current[row] = current[row]
+                + this->Input.Get(this->Grid.GetCellIndex(i, cellRow, k));
+          }
+        }
+      }
+      vtkm::Id countXZ = CountCells(i, cellDims[0]) * countZ;
+      vtkm::Id pointIndex = (k*pointDims[1] + j0)*pointDims[0] + i;
+      for (vtkm::Id row = 0; row < numRows; row++)
+      {
+        ComponentType scale = static_cast<ComponentType>(1)
+            / static_cast<ComponentType>(
+              countXZ * CountCells(j0 + row, cellDims[1]));
+        this->Output.Set(pointIndex,
+                         (previous[row] + previous[row+1]
+                          + current[row] + current[row+1]) * scale);
+        pointIndex += pointDims[0];
+      }
+      for (vtkm::Id row = 0; row <= numRows; row++)
+      {
+        previous[row] = current[row];
+      }
+    }
+  }
+};
+
+// Averages the values of the elements incident on each element through an
+// explicit connectivity: the points of each cell for point to cell, or the
+// cells of each point for cell to point. Elements with nothing incident get
+// zero.
+template<typename ConnectivityType,
+         typename InPortalType,
+         typename OutPortalType>
+struct FieldAverageExplicitKernel : public vtkm::exec::FunctorBase
+{
+  typedef typename OutPortalType::ValueType ValueType;
+  typedef typename vtkm::VecTraits<ValueType>::ComponentType ComponentType;
+
+  ConnectivityType Connectivity;
+  InPortalType Input;
+  OutPortalType Output;
+
+  VTKM_CONT_EXPORT
+  FieldAverageExplicitKernel(const ConnectivityType &connectivity,
+                             const InPortalType &input,
+                             const OutPortalType &output)
+    : Connectivity(connectivity), Input(input), Output(output) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::IdComponent numIndices =
+        this->Connectivity.GetNumberOfIndices(index);
+    ValueType sum = ValueType(static_cast<ComponentType>(0));
+    for (vtkm::IdComponent which = 0; which < numIndices; which++)
+    {
+      sum = sum + this->Input.Get(this->Connectivity.GetIndex(index, which));
+    }
+    if (numIndices > 0)
+    {
+      sum = sum * (static_cast<ComponentType>(1)
+                   / static_cast<ComponentType>(numIndices));
+    }
+    this->Output.Set(index, sum);
+  }
+};
+
+template<typename FromTopology,
+         typename ToTopology,
+         typename DeviceAdapterTag,
+         typename CellSetType,
+         typename ValueType,
+         typename InStorage,
+         typename OutStorage>
+VTKM_CONT_EXPORT
+void FieldAverageExplicit(
+    const CellSetType &cellSet,
+    const vtkm::cont::ArrayHandle<ValueType,InStorage> &input,
+    vtkm::cont::ArrayHandle<ValueType,OutStorage> &output,
+    vtkm::Id numberOfOutputValues,
+    DeviceAdapterTag)
+{
+  typedef typename CellSetType::template ExecutionTypes<
+      DeviceAdapterTag,FromTopology,ToTopology>::ExecObjectType
+      ConnectivityType;
+  typedef typename vtkm::cont::ArrayHandle<ValueType,InStorage>
+      ::template ExecutionTypes<DeviceAdapterTag>::PortalConst InPortalType;
+  typedef typename vtkm::cont::ArrayHandle<ValueType,OutStorage>
+      ::template ExecutionTypes<DeviceAdapterTag>::Portal OutPortalType;
+
+  ConnectivityType connectivity =
+      cellSet.PrepareForInput(DeviceAdapterTag(), FromTopology(), ToTopology());
+  vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+        FieldAverageExplicitKernel<ConnectivityType,InPortalType,OutPortalType>(
+          connectivity,
+          input.PrepareForInput(DeviceAdapterTag()),
+          output.PrepareForOutput(numberOfOutputValues, DeviceAdapterTag())),
+        numberOfOutputValues);
+}
+
+template<typename ArrayHandleType>
+VTKM_CONT_EXPORT
+void FieldAverageCheckSize(const ArrayHandleType &array, vtkm::Id size)
+{
+  if (array.GetNumberOfValues() != size)
+  {
+    throw vtkm::cont::ErrorControlBadValue(
+          "Field to average does not match the size of the cell set.");
+  }
+}
+
+} // namespace internal
+
+/// \brief Averages a point field to the cells.
+///
+/// The value of each cell is the mean of the values of its points. On a
+/// structured cell set the 2D or 3D stencil is computed from the extent.
+/// Each task takes a tile of rows of cells and walks it along x, summing the
+/// points of each column of the tile once and sharing the sums with the
+/// cells on either side, so each point is loaded about twice rather than
+/// once for each of its 8 cells. Other cell sets use their point to cell
+/// connectivity.
+///
+/// The field should have floating point components, since the mean is
+/// computed in the type of the field.
+///
+template<typename DeviceAdapterTag>
+class PointToCellAverage
+{
+public:
+  template<vtkm::IdComponent Dimensions,
+           typename ValueType,
+           typename InStorage,
+           typename OutStorage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::CellSetStructured<Dimensions> &cellSet,
+           const vtkm::cont::ArrayHandle<ValueType,InStorage> &pointField,
+           vtkm::cont::ArrayHandle<ValueType,OutStorage> &cellField) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<ValueType,InStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst InPortalType;
+    typedef typename vtkm::cont::ArrayHandle<ValueType,OutStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal OutPortalType;
+
+    internal::FieldAverageCheckSize(pointField, cellSet.GetNumberOfPoints());
+    vtkm::Id numCells = cellSet.GetNumberOfCells();
+    internal::FieldAverageGrid grid(
+          internal::FieldAveragePointDimensions(cellSet.GetExtent()));
+    vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          internal::PointToCellAverageStructuredKernel<
+              InPortalType,OutPortalType>(
+            pointField.PrepareForInput(DeviceAdapterTag()),
+            cellField.PrepareForOutput(numCells, DeviceAdapterTag()),
+            grid),
+          (numCells > 0) ? grid.GetNumberOfTiles() : 0);
+  }
+
+  template<typename CellSetType,
+           typename ValueType,
+           typename InStorage,
+           typename OutStorage>
+  VTKM_CONT_EXPORT
+  void Run(const CellSetType &cellSet,
+           const vtkm::cont::ArrayHandle<ValueType,InStorage> &pointField,
+           vtkm::cont::ArrayHandle<ValueType,OutStorage> &cellField) const
+  {
+    internal::FieldAverageCheckSize(pointField, cellSet.GetNumberOfPoints());
+    internal::FieldAverageExplicit<vtkm::TopologyElementTagPoint,
+                                   vtkm::TopologyElementTagCell>(
+          cellSet,
+          pointField,
+          cellField,
+          cellSet.GetNumberOfCells(),
+          DeviceAdapterTag());
+  }
+};
+
+/// \brief Averages a cell field to the points.
+///
+/// The value of each point is the mean of the values of the cells that use
+/// it, and zero for points that no cell uses. On a structured cell set the
+/// cells are found from the extent, tiled the same way as
+/// PointToCellAverage so that each cell is loaded about twice rather than
+/// once for each of its 8 points. Other cell sets use their cell to point
+/// connectivity, which lists the cells of each point, so each point gathers
+/// its own value without atomic operations.
+///
+/// The field should have floating point components, since the mean is
+/// computed in the type of the field.
+///
+template<typename DeviceAdapterTag>
+class CellToPointAverage
+{
+public:
+  template<vtkm::IdComponent Dimensions,
+           typename ValueType,
+           typename InStorage,
+           typename OutStorage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::CellSetStructured<Dimensions> &cellSet,
+           const vtkm::cont::ArrayHandle<ValueType,InStorage> &cellField,
+           vtkm::cont::ArrayHandle<ValueType,OutStorage> &pointField) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<ValueType,InStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst InPortalType;
+    typedef typename vtkm::cont::ArrayHandle<ValueType,OutStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal OutPortalType;
+
+    internal::FieldAverageCheckSize(cellField, cellSet.GetNumberOfCells());
+    vtkm::Id numPoints = cellSet.GetNumberOfPoints();
+    if (cellSet.GetNumberOfCells() < 1)
+    {
+      typedef typename vtkm::VecTraits<ValueType>::ComponentType
+          ComponentType;
+      vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Copy(
+            vtkm::cont::make_ArrayHandleConstant(
+              ValueType(static_cast<ComponentType>(0)), numPoints),
+            pointField);
+      return;
+    }
+    vtkm::Id3 pointDims =
+        internal::FieldAveragePointDimensions(cellSet.GetExtent());
+    vtkm::Id numTiles = pointDims[2]
+        * ((pointDims[1] + internal::FIELD_AVERAGE_TILE_ROWS - 1)
+           / internal::FIELD_AVERAGE_TILE_ROWS);
+    vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          internal::CellToPointAverageStructuredKernel<
+              InPortalType,OutPortalType>(
+            cellField.PrepareForInput(DeviceAdapterTag()),
+            pointField.PrepareForOutput(numPoints, DeviceAdapterTag()),
+            internal::FieldAverageGrid(pointDims),
+            pointDims),
+          numTiles);
+  }
+
+  template<typename CellSetType,
+           typename ValueType,
+           typename InStorage,
+           typename OutStorage>
+  VTKM_CONT_EXPORT
+  void Run(const CellSetType &cellSet,
+           const vtkm::cont::ArrayHandle<ValueType,InStorage> &cellField,
+           vtkm::cont::ArrayHandle<ValueType,OutStorage> &pointField) const
+  {
+    internal::FieldAverageCheckSize(cellField, cellSet.GetNumberOfCells());
+    internal::FieldAverageExplicit<vtkm::TopologyElementTagCell,
+                                   vtkm::TopologyElementTagPoint>(
+          cellSet,
+          cellField,
+          pointField,
+          cellSet.GetNumberOfPoints(),
+          DeviceAdapterTag());
+  }
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_FieldAverage_h
@@ -0,0 +1,589 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_Gradient_h
+#define vtk_m_worklet_Gradient_h
+
+#include <vtkm/Types.h>
+#include <vtkm/VecTraits.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+// The distances between points of a uniform grid.
+struct GradientUniformAxes
+{
+  vtkm::Vec<vtkm::FloatDefault,3> Spacing;
+
+  VTKM_CONT_EXPORT
+  GradientUniformAxes(const vtkm::Vec<vtkm::FloatDefault,3> &spacing)
+    : Spacing(spacing) {  }
+
+  VTKM_EXEC_EXPORT
+  vtkm::Float64 GetDistance(vtkm::IdComponent axis,
+                            vtkm::Id low,
+                            vtkm::Id high) const
+  {
+    return static_cast<vtkm::Float64>(this->Spacing[axis])
+        * static_cast<vtkm::Float64>(high - low);
+  }
+};
+
+// The distances between points of a rectilinear grid, whose coordinates
+// along each axis are given by an array.
+template<typename XPortalType, typename YPortalType, typename ZPortalType>
+struct GradientRectilinearAxes
+{
+  XPortalType X;
+  YPortalType Y;
+  ZPortalType Z;
+
+  VTKM_CONT_EXPORT
+  GradientRectilinearAxes(const XPortalType &x,
+                          const YPortalType &y,
+                          const ZPortalType &z)
+    : X(x), Y(y), Z(z) {  }
+
+  VTKM_EXEC_EXPORT
+  vtkm::Float64 GetDistance(vtkm::IdComponent axis,
+                            vtkm::Id low,
+                            vtkm::Id high) const
+  {
+    switch (axis)
+    {
+      case 0:
+        return static_cast<vtkm::Float64>(this->X.Get(high))
+            - static_cast<vtkm::Float64>(this->X.Get(low));
+      case 1:
+        return static_cast<vtkm::Float64>(this->Y.Get(high))
+            - static_cast<vtkm::Float64>(this->Y.Get(low));
+      default:
+        return static_cast<vtkm::Float64>(this->Z.Get(high))
+            - static_cast<vtkm::Float64>(this->Z.Get(low));
+    }
+  }
+};
+
+// Writes the gradient of each point.
+template<typename GradientPortalType>
+struct GradientStore
+{
+  GradientPortalType Gradient;
+
+  VTKM_CONT_EXPORT
+  GradientStore(const GradientPortalType &gradient) : Gradient(gradient) {  }
+
+  template<typename GradientType>
+  VTKM_EXEC_EXPORT
+  void Store(vtkm::Id index, const GradientType &gradient) const
+  {
+    this->Gradient.Set(index, gradient);
+  }
+};
+
+// Writes the gradient of a 3D vector field and the quantities derived from
+// it that were asked for. Entry [a][c] of the gradient is the derivative of
+// component c along axis a.
+template<typename GradientPortalType,
+         typename VorticityPortalType,
+         typename ScalarPortalType>
+struct GradientVectorStore
+{
+  typedef typename ScalarPortalType::ValueType ComponentType;
+
+  GradientPortalType Gradient;
+  VorticityPortalType Vorticity;
+  ScalarPortalType Divergence;
+  ScalarPortalType QCriterion;
+  bool StoreGradient;
+  bool StoreVorticity;
+  bool StoreDivergence;
+  bool StoreQCriterion;
+
+  VTKM_CONT_EXPORT
+  GradientVectorStore(const GradientPortalType &gradient,
+                      const VorticityPortalType &vorticity,
+                      const ScalarPortalType &divergence,
+                      const ScalarPortalType &qCriterion,
+                      bool storeGradient,
+                      bool storeVorticity,
+                      bool storeDivergence,
+                      bool storeQCriterion)
+    : Gradient(gradient),
+      Vorticity(vorticity),
+      Divergence(divergence),
+      QCriterion(qCriterion),
+      StoreGradient(storeGradient),
+      StoreVorticity(storeVorticity),
+      StoreDivergence(storeDivergence),
+      StoreQCriterion(storeQCriterion) {  }
+
+  VTKM_EXEC_EXPORT
+  void Store(vtkm::Id index,
+             const vtkm::Vec<vtkm::Vec<ComponentType,3>,3> &gradient) const
+  {
+    if (this->StoreGradient)
+    {
+      this->Gradient.Set(index, gradient);
+    }
+    if (this->StoreVorticity)
+    {
+      this->Vorticity.Set(index, vtkm::Vec<ComponentType,3>(
+                            gradient[1][2] - gradient[2][1],
+                            gradient[2][0] - gradient[0][2],
+                            gradient[0][1] - gradient[1][0]));
+    }
+    if (this->StoreDivergence)
+    {
+      this->Divergence.Set(index,
+                           gradient[0][0] + gradient[1][1] + gradient[2][2]);
+    }
+    if (this->StoreQCriterion)
+    {
+      // Half the difference of the squared norms of the rotation and strain
+      // rate tensors, which reduces to -1/2 of the sum of J_ij*J_ji.
+      ComponentType sum = static_cast<ComponentType>(0);
+      for (vtkm::IdComponent i = 0; i < 3; i++)
+      {
+        for (vtkm::IdComponent j = 0; j < 3; j++)
+        {
+          sum += gradient[i][j]*gradient[j][i];
+        }
+      }
+      this->QCriterion.Set(index, static_cast<ComponentType>(-0.5)*sum);
+    }
+  }
+};
+
+// Each task computes the gradients of one row of points along x, keeping
+// the previous, current, and next values of the row so that each value on
+// the row is loaded once. Interior points use central differences and
+// boundary points one-sided differences. An axis with a single point has a
+// derivative of zero.
+template<typename FieldPortalType, typename AxesType, typename StoreType>
+struct GradientKernel : public vtkm::exec::FunctorBase
+{
+  typedef typename FieldPortalType::ValueType ValueType;
+  typedef typename vtkm::VecTraits<ValueType>::ComponentType ComponentType;
+
+  FieldPortalType Field;
+  AxesType Axes;
+  vtkm::Id3 Dimensions;
+  StoreType Output;
+
+  VTKM_CONT_EXPORT
+  GradientKernel(const FieldPortalType &field,
+                 const AxesType &axes,
+                 const vtkm::Id3 &dimensions,
+                 const StoreType &output)
+    : Field(field), Axes(axes), Dimensions(dimensions), Output(output) {  }
+
+  // Finds the neighbors of a point along an axis and the reciprocal of the
+  // distance between them.
+  VTKM_EXEC_EXPORT
+  void GetStencil(vtkm::IdComponent axis,
+                  vtkm::Id index,
+                  vtkm::Id &low,
+                  vtkm::Id &high,
+                  ComponentType &scale) const
+  {
+    low = (index > 0) ? index - 1 : index;
+    high = (index < this->Dimensions[axis] - 1) ? index + 1 : index;
+    scale = (high > low)
+        ? static_cast<ComponentType>(
+            1.0/this->Axes.GetDistance(axis, low, high))
+        : static_cast<ComponentType>(0);
+  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id row) const
+  {
+    const vtkm::Id3 &dims = this->Dimensions;
+    vtkm::Id j = row % dims[1];
+    vtkm::Id k = row / dims[1];
+    vtkm::Id rowStart = row*dims[0];
+
+    vtkm::Id jLow, jHigh, kLow, kHigh;
+    ComponentType yScale, zScale;
+    this->GetStencil(1, j, jLow, jHigh, yScale);
+    this->GetStencil(2, k, kLow, kHigh, zScale);
+    vtkm::Id yLow = rowStart + (jLow - j)*dims[0];
+    vtkm::Id yHigh = rowStart + (jHigh - j)*dims[0];
+    vtkm::Id zLow = rowStart + (kLow - k)*dims[0]*dims[1];
+    vtkm::Id zHigh = rowStart + (kHigh - k)*dims[0]*dims[1];
+
+    ValueType previous = this->Field.Get(rowStart);
+    ValueType current = previous;
+    for (vtkm::Id i = 0; i < dims[0]; i++)
+    {
+      ValueType next =
+          (i + 1 < dims[0]) ? this->Field.Get(rowStart + i + 1) : current;
+      vtkm::Id iLow, iHigh;
+      ComponentType xScale;
+      this->GetStencil(0, i, iLow, iHigh, xScale);
+
+      vtkm::Vec<ValueType,3> gradient;
+      gradient[0] = (next - previous)*xScale;
+      gradient[1] =
+          (this->Field.Get(yHigh + i) - this->Field.Get(yLow + i))*yScale;
+      gradient[2] =
+          (this->Field.Get(zHigh + i) - this->Field.Get(zLow + i))*zScale;
+      this->Output.Store(rowStart + i, gradient);
+
+      previous = current;
+      current = next;
+    }
+  }
+};
+
+} // namespace internal
+
+/// \brief Computes the gradient of a point field on a uniform or rectilinear
+/// grid.
+///
+/// Derivatives are central differences inside the grid and one-sided
+/// differences on its boundary. A scalar field has a Vec of 3 derivatives
+/// per point, and a Vec field a Vec of 3 Vecs, all components being
+/// differenced together. Each task walks one row of points along x, so each
+/// value is loaded once for the x derivative and once more for each of its
+/// neighbors in y and z.
+///
+/// For 3D vector fields such as velocity, the vorticity, divergence, and
+/// Q-criterion can be computed in the same pass from the gradient of each
+/// point, without storing the gradient. Which outputs are written is chosen
+/// with the Set methods; the arrays of outputs that are not asked for are
+/// left untouched. The field should have floating point components.
+///
+template<typename DeviceAdapterTag>
+class Gradient
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  VTKM_CONT_EXPORT
+  Gradient()
+    : ComputeGradient(true),
+      ComputeVorticity(false),
+      ComputeDivergence(false),
+      ComputeQCriterion(false) {  }
+
+  VTKM_CONT_EXPORT
+  bool GetComputeGradient() const { return this->ComputeGradient; }
+  VTKM_CONT_EXPORT
+  void SetComputeGradient(bool compute) { this->ComputeGradient = compute; }
+
+  VTKM_CONT_EXPORT
+  bool GetComputeVorticity() const { return this->ComputeVorticity; }
+  VTKM_CONT_EXPORT
+  void SetComputeVorticity(bool compute) { this->ComputeVorticity = compute; }
+
+  VTKM_CONT_EXPORT
+  bool GetComputeDivergence() const { return this->ComputeDivergence; }
+  VTKM_CONT_EXPORT
+  void SetComputeDivergence(bool compute)
+  {
+    this->ComputeDivergence = compute;
+  }
+
+  VTKM_CONT_EXPORT
+  bool GetComputeQCriterion() const { return this->ComputeQCriterion; }
+  VTKM_CONT_EXPORT
+  void SetComputeQCriterion(bool compute)
+  {
+    this->ComputeQCriterion = compute;
+  }
+
+  /// Computes the gradient of \p field, which has a value for each point
+  /// of \p coordinates.
+  ///
+  template<typename ValueType, typename Storage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::ArrayHandleUniformPointCoordinates &coordinates,
+           const vtkm::cont::ArrayHandle<ValueType,Storage> &field,
+           vtkm::cont::ArrayHandle<vtkm::Vec<ValueType,3> > &gradient) const
+  {
+    this->RunField(UniformAxes(coordinates),
+                   UniformDimensions(coordinates),
+                   field,
+                   gradient);
+  }
+
+  /// Computes the gradient of \p field on the rectilinear grid whose points
+  /// have the coordinates in \p xCoordinates, \p yCoordinates, and
+  /// \p zCoordinates along each axis, with x varying fastest.
+  ///
+  template<typename CoordinateType,
+           typename CoordinateStorage,
+           typename ValueType,
+           typename Storage>
+  VTKM_CONT_EXPORT
+  void Run(
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage>
+          &xCoordinates,
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage>
+          &yCoordinates,
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage>
+          &zCoordinates,
+      const vtkm::cont::ArrayHandle<ValueType,Storage> &field,
+      vtkm::cont::ArrayHandle<vtkm::Vec<ValueType,3> > &gradient) const
+  {
+    this->RunField(RectilinearAxes(xCoordinates, yCoordinates, zCoordinates),
+                   RectilinearDimensions(xCoordinates,
+                                         yCoordinates,
+                                         zCoordinates),
+                   field,
+                   gradient);
+  }
+
+  /// Computes the gradient of the 3D vector \p field and the vorticity,
+  /// divergence, and Q-criterion, writing those asked for.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Run(
+      const vtkm::cont::ArrayHandleUniformPointCoordinates &coordinates,
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &field,
+      vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec<T,3>,3> > &gradient,
+      vtkm::cont::ArrayHandle<vtkm::Vec<T,3> > &vorticity,
+      vtkm::cont::ArrayHandle<T> &divergence,
+      vtkm::cont::ArrayHandle<T> &qCriterion) const
+  {
+    this->RunVectorField(UniformAxes(coordinates),
+                         UniformDimensions(coordinates),
+                         field,
+                         gradient,
+                         vorticity,
+                         divergence,
+                         qCriterion);
+  }
+
+  /// Computes the gradient of the 3D vector \p field on a rectilinear grid
+  /// and the vorticity, divergence, and Q-criterion, writing those asked
+  /// for.
+  ///
+  template<typename CoordinateType,
+           typename CoordinateStorage,
+           typename T,
+           typename Storage>
+  VTKM_CONT_EXPORT
+  void Run(
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage>
+          &xCoordinates,
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage>
+          &yCoordinates,
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage>
+          &zCoordinates,
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &field,
+      vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec<T,3>,3> > &gradient,
+      vtkm::cont::ArrayHandle<vtkm::Vec<T,3> > &vorticity,
+      vtkm::cont::ArrayHandle<T> &divergence,
+      vtkm::cont::ArrayHandle<T> &qCriterion) const
+  {
+    this->RunVectorField(
+          RectilinearAxes(xCoordinates, yCoordinates, zCoordinates),
+          RectilinearDimensions(xCoordinates, yCoordinates, zCoordinates),
+          field,
+          gradient,
+          vorticity,
+          divergence,
+          qCriterion);
+  }
+
+private:
+  bool ComputeGradient;
+  bool ComputeVorticity;
+  bool ComputeDivergence;
+  bool ComputeQCriterion;
+
+  VTKM_CONT_EXPORT
+  static internal::GradientUniformAxes UniformAxes(
+      const vtkm::cont::ArrayHandleUniformPointCoordinates &coordinates)
+  {
+    return internal::GradientUniformAxes(
+          coordinates.PrepareForInput(DeviceAdapterTag()).GetSpacing());
+  }
+
+  VTKM_CONT_EXPORT
+  static vtkm::Id3 UniformDimensions(
+      const vtkm::cont::ArrayHandleUniformPointCoordinates &coordinates)
+  {
+    return coordinates.PrepareForInput(DeviceAdapterTag()).GetRange3();
+  }
+
+  template<typename CoordinateType, typename CoordinateStorage>
+  struct RectilinearAxesType
+  {
+    typedef typename vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst PortalType;
+    typedef internal::GradientRectilinearAxes<
+        PortalType,PortalType,PortalType> Type;
+  };
+
+  template<typename CoordinateType, typename CoordinateStorage>
+  VTKM_CONT_EXPORT
+  static typename RectilinearAxesType<CoordinateType,CoordinateStorage>::Type
+  RectilinearAxes(
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage> &x,
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage> &y,
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage> &z)
+  {
+    typedef typename RectilinearAxesType<CoordinateType,CoordinateStorage>
+        ::Type AxesType;
+    return AxesType(x.PrepareForInput(DeviceAdapterTag()),
+                    y.PrepareForInput(DeviceAdapterTag()),
+                    z.PrepareForInput(DeviceAdapterTag()));
+  }
+
+  template<typename CoordinateType, typename CoordinateStorage>
+  VTKM_CONT_EXPORT
+  static vtkm::Id3 RectilinearDimensions(
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage> &x,
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage> &y,
+      const vtkm::cont::ArrayHandle<CoordinateType,CoordinateStorage> &z)
+  {
+    return vtkm::Id3(x.GetNumberOfValues(),
+                     y.GetNumberOfValues(),
+                     z.GetNumberOfValues());
+  }
+
+  template<typename ArrayHandleType>
+  VTKM_CONT_EXPORT
+  static void CheckField(const ArrayHandleType &field,
+                         const vtkm::Id3 &dimensions)
+  {
+    if (field.GetNumberOfValues() !=
+        dimensions[0]*dimensions[1]*dimensions[2])
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Gradient field does not have a value for every point.");
+    }
+  }
+
+  template<typename AxesType,
+           typename ValueType,
+           typename Storage,
+           typename StoreType>
+  VTKM_CONT_EXPORT
+  static void Schedule(const AxesType &axes,
+                       const vtkm::Id3 &dimensions,
+                       const vtkm::cont::ArrayHandle<ValueType,Storage> &field,
+                       const StoreType &store)
+  {
+    typedef typename vtkm::cont::ArrayHandle<ValueType,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        FieldPortalType;
+
+    vtkm::Id numRows = (dimensions[0] > 0)
+        ? dimensions[1]*dimensions[2] : 0;
+    Algorithm::Schedule(
+          internal::GradientKernel<FieldPortalType,AxesType,StoreType>(
+            field.PrepareForInput(DeviceAdapterTag()),
+            axes,
+            dimensions,
+            store),
+          numRows);
+  }
+
+  template<typename AxesType, typename ValueType, typename Storage>
+  VTKM_CONT_EXPORT
+  void RunField(
+      const AxesType &axes,
+      const vtkm::Id3 &dimensions,
+      const vtkm::cont::ArrayHandle<ValueType,Storage> &field,
+      vtkm::cont::ArrayHandle<vtkm::Vec<ValueType,3> > &gradient) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<ValueType,3> >
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal GradientPortalType;
+
+    CheckField(field, dimensions);
+    vtkm::Id numPoints = field.GetNumberOfValues();
+    Schedule(axes,
+             dimensions,
+             field,
+             internal::GradientStore<GradientPortalType>(
+               gradient.PrepareForOutput(numPoints, DeviceAdapterTag())));
+  }
+
+  template<typename AxesType, typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void RunVectorField(
+      const AxesType &axes,
+      const vtkm::Id3 &dimensions,
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &field,
+      vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec<T,3>,3> > &gradient,
+      vtkm::cont::ArrayHandle<vtkm::Vec<T,3> > &vorticity,
+      vtkm::cont::ArrayHandle<T> &divergence,
+      vtkm::cont::ArrayHandle<T> &qCriterion) const
+  {
+    typedef vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Vec<T,3>,3> >
+        GradientArrayType;
+    typedef vtkm::cont::ArrayHandle<vtkm::Vec<T,3> > VorticityArrayType;
+    typedef vtkm::cont::ArrayHandle<T> ScalarArrayType;
+    typedef internal::GradientVectorStore<
+        typename GradientArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::Portal,
+        typename VorticityArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::Portal,
+        typename ScalarArrayType::template ExecutionTypes<DeviceAdapterTag>
+            ::Portal> StoreType;
+
+    CheckField(field, dimensions);
+
+    // Outputs that are not asked for get an empty array of their own.
+    GradientArrayType unusedGradient;
+    VorticityArrayType unusedVorticity;
+    ScalarArrayType unusedDivergence;
+    ScalarArrayType unusedQCriterion;
+    vtkm::Id numPoints = field.GetNumberOfValues();
+    Schedule(axes,
+             dimensions,
+             field,
+             StoreType(
+               (this->ComputeGradient ? gradient : unusedGradient)
+                 .PrepareForOutput(this->ComputeGradient ? numPoints : 0,
+                                   DeviceAdapterTag()),
+               (this->ComputeVorticity ? vorticity : unusedVorticity)
+                 .PrepareForOutput(this->ComputeVorticity ? numPoints : 0,
+                                   DeviceAdapterTag()),
+               (this->ComputeDivergence ? divergence : unusedDivergence)
+                 .PrepareForOutput(this->ComputeDivergence ? numPoints : 0,
+                                   DeviceAdapterTag()),
+               (this->ComputeQCriterion ? qCriterion : unusedQCriterion)
+                 .PrepareForOutput(this->ComputeQCriterion ? numPoints : 0,
+                                   DeviceAdapterTag()),
+               this->ComputeGradient,
+               this->ComputeVorticity,
+               this->ComputeDivergence,
+               this->ComputeQCriterion));
+  }
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_Gradient_h
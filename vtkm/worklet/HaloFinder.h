@@ -0,0 +1,422 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_HaloFinder_h
+#define vtk_m_worklet_HaloFinder_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/ArrayPortalAtomic.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/worklet/PointLocatorUniformGrid.h>
+
+#include <limits>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+/// Finds the root of the tree holding \p point in a union-find forest,
+/// halving the path on the way. Only roots are changed by linking, so
+/// pointing a node at its grandparent is safe while other threads link.
+///
+template<typename ParentPortalType>
+VTKM_EXEC_EXPORT
+vtkm::Id HaloFinderFindRoot(const ParentPortalType &parents, vtkm::Id point)
+{
+  vtkm::Id parent = parents.Get(point);
+  while (parent != point)
+  {
+    vtkm::Id grandparent = parents.Get(parent);
+    if (grandparent != parent)
+    {
+      parents.Set(point, grandparent);
+    }
+    point = grandparent;
+    parent = parents.Get(point);
+  }
+  return point;
+}
+
+/// Joins the trees holding \p point1 and \p point2. The root with the
+/// larger id is linked under the other with a compare and swap, which is
+/// tried again from the new roots if another thread linked first, so the
+/// root of each tree is its smallest point id.
+///
+template<typename ParentPortalType>
+VTKM_EXEC_EXPORT
+void HaloFinderUnion(const ParentPortalType &parents,
+                     vtkm::Id point1,
+                     vtkm::Id point2)
+{
+  while (true)
+  {
+    point1 = HaloFinderFindRoot(parents, point1);
+    point2 = HaloFinderFindRoot(parents, point2);
+    if (point1 == point2)
+    {
+      return;
+    }
+    if (point1 < point2)
+    {
+      vtkm::Id swap = point1;
+      point1 = point2;
+      point2 = swap;
+    }
+    if (parents.CompareAndSwap(point1, point1, point2) == point1)
+    {
+      return;
+    }
+  }
+}
+
+template<typename ParentPortalType>
+struct HaloFinderUnionVisitor
+{
+  ParentPortalType Parents;
+  vtkm::Id PointId;
+
+  VTKM_EXEC_EXPORT
+  HaloFinderUnionVisitor(const ParentPortalType &parents, vtkm::Id pointId)
+    : Parents(parents), PointId(pointId) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id neighborId, vtkm::FloatDefault)
+  {
+    // Each pair is seen from both points, so link it from one.
+    if (neighborId > this->PointId)
+    {
+      HaloFinderUnion(this->Parents, this->PointId, neighborId);
+    }
+  }
+};
+
+// Links each particle with its friends. The particles are visited in the
+// order of the locator's bins, so neighboring particles are handled
+// together.
+template<typename LocatorType, typename ParentPortalType>
+struct HaloFinderUnionKernel : public vtkm::exec::FunctorBase
+{
+  LocatorType Locator;
+  ParentPortalType Parents;
+  vtkm::FloatDefault LinkingLength;
+
+  VTKM_CONT_EXPORT
+  HaloFinderUnionKernel(const LocatorType &locator,
+                        const ParentPortalType &parents,
+                        vtkm::FloatDefault linkingLength)
+    : Locator(locator), Parents(parents), LinkingLength(linkingLength) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id position) const
+  {
+    HaloFinderUnionVisitor<ParentPortalType> visitor(
+          this->Parents, this->Locator.SortedPointIds.Get(position));
+    this->Locator.VisitInRadius(this->Locator.SortedPoints.Get(position),
+                                this->LinkingLength,
+                                visitor);
+  }
+};
+
+// Points each particle at its grandparent and flags the particles that
+// moved. Repeating this until nothing moves points every particle at its
+// root.
+template<typename ParentPortalType, typename FlagPortalType>
+struct HaloFinderJumpKernel : public vtkm::exec::FunctorBase
+{
+  ParentPortalType Parents;
+  FlagPortalType Moved;
+
+  VTKM_CONT_EXPORT
+  HaloFinderJumpKernel(const ParentPortalType &parents,
+                       const FlagPortalType &moved)
+    : Parents(parents), Moved(moved) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id parent = this->Parents.Get(index);
+    vtkm::Id grandparent = this->Parents.Get(parent);
+    if (grandparent != parent)
+    {
+      this->Parents.Set(index, grandparent);
+      this->Moved.Set(index, 1);
+    }
+    else
+    {
+      this->Moved.Set(index, 0);
+    }
+  }
+};
+
+template<typename IdPortalConstType, typename IdPortalType>
+struct HaloFinderCountKernel : public vtkm::exec::FunctorBase
+{
+  IdPortalConstType Starts;
+  IdPortalConstType Ends;
+  IdPortalType Counts;
+  vtkm::Id MinimumHaloSize;
+
+  VTKM_CONT_EXPORT
+  HaloFinderCountKernel(const IdPortalConstType &starts,
+                        const IdPortalConstType &ends,
+                        const IdPortalType &counts,
+                        vtkm::Id minimumHaloSize)
+    : Starts(starts),
+      Ends(ends),
+      Counts(counts),
+      MinimumHaloSize(minimumHaloSize) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id count = this->Ends.Get(index) - this->Starts.Get(index);
+    this->Counts.Set(index, (count < this->MinimumHaloSize) ? 0 : count);
+  }
+};
+
+// Replaces the position of each particle's root among the halo roots with
+// -1 if the root is not a halo.
+template<typename IdPortalConstType, typename IdPortalType>
+struct HaloFinderLabelKernel : public vtkm::exec::FunctorBase
+{
+  IdPortalConstType Roots;
+  IdPortalConstType HaloRoots;
+  IdPortalType HaloIds;
+
+  VTKM_CONT_EXPORT
+  HaloFinderLabelKernel(const IdPortalConstType &roots,
+                        const IdPortalConstType &haloRoots,
+                        const IdPortalType &haloIds)
+    : Roots(roots), HaloRoots(haloRoots), HaloIds(haloIds) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id haloId = this->HaloIds.Get(index);
+    if ((haloId >= this->HaloRoots.GetNumberOfValues())
+        || (this->HaloRoots.Get(haloId) != this->Roots.Get(index)))
+    {
+      this->HaloIds.Set(index, -1);
+    }
+  }
+};
+
+} // namespace internal
+
+/// \brief Groups particles into halos with the friends-of-friends method.
+///
+/// Two particles are friends if they are no farther apart than the linking
+/// length, and a halo is a group of particles joined by chains of friends.
+/// The particles are first binned with a PointLocatorUniformGrid whose bins
+/// are at least the linking length wide, so each particle only looks for
+/// friends in the bins next to its own. Each pair of friends is then joined
+/// in a lock-free union-find forest: trees are linked at their roots with
+/// an atomic compare and swap, so all particles can be handled in
+/// parallel. Pointer jumping passes then point every particle straight at
+/// its root.
+///
+/// The roots are grouped by sorting them, with Unique and LowerBounds and
+/// UpperBounds giving the size of each group. Halos are numbered in the
+/// order of their smallest particle id. Groups with fewer particles than
+/// the minimum halo size are not halos, and their particles get a halo id
+/// of -1.
+///
+template<typename DeviceAdapterTag>
+class HaloFinder
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  VTKM_CONT_EXPORT
+  HaloFinder() : MinimumHaloSize(1) {  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetMinimumHaloSize() const { return this->MinimumHaloSize; }
+
+  /// Sets the fewest particles a halo can have.
+  ///
+  VTKM_CONT_EXPORT
+  void SetMinimumHaloSize(vtkm::Id size) { this->MinimumHaloSize = size; }
+
+  /// Finds the halos of \p points. \p haloIds gets the halo of each
+  /// particle, and \p haloCounts the number of particles in each halo.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &points,
+           vtkm::FloatDefault linkingLength,
+           vtkm::cont::ArrayHandle<vtkm::Id> &haloIds,
+           vtkm::cont::ArrayHandle<vtkm::Id> &haloCounts) const
+  {
+    typedef vtkm::worklet::PointLocatorUniformGrid<DeviceAdapterTag>
+        LocatorType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+    typedef vtkm::cont::internal::ArrayPortalAtomic<
+        vtkm::Id,DeviceAdapterTag> ParentPortalType;
+
+    if (linkingLength < 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Halo finder linking length is negative.");
+    }
+
+    vtkm::Id numPoints = points.GetNumberOfValues();
+    vtkm::cont::ArrayHandle<vtkm::Id> roots;
+    Algorithm::Copy(vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0),
+                                                         numPoints),
+                    roots);
+    if (numPoints > 0)
+    {
+      vtkm::Bounds bounds =
+          vtkm::cont::ComputeBounds(points, DeviceAdapterTag());
+      LocatorType locator(ChooseDivisions(bounds, linkingLength, numPoints));
+      locator.Build(points, bounds);
+
+      Algorithm::Schedule(
+            internal::HaloFinderUnionKernel<
+                typename LocatorType::ExecObjectType,ParentPortalType>(
+              locator.PrepareForInput(),
+              ParentPortalType(roots),
+              linkingLength),
+            numPoints);
+
+      vtkm::cont::ArrayHandle<vtkm::Id> moved;
+      do
+      {
+        Algorithm::Schedule(
+              internal::HaloFinderJumpKernel<ParentPortalType,IdPortalType>(
+                ParentPortalType(roots),
+                moved.PrepareForOutput(numPoints, DeviceAdapterTag())),
+              numPoints);
+      }
+      while (Algorithm::Reduce(moved, vtkm::Id(0)) > 0);
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Id> sortedRoots;
+    Algorithm::Copy(roots, sortedRoots);
+    Algorithm::Sort(sortedRoots);
+    vtkm::cont::ArrayHandle<vtkm::Id> groupRoots;
+    Algorithm::Copy(sortedRoots, groupRoots);
+    Algorithm::Unique(groupRoots);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> starts;
+    vtkm::cont::ArrayHandle<vtkm::Id> ends;
+    Algorithm::LowerBounds(sortedRoots, groupRoots, starts);
+    Algorithm::UpperBounds(sortedRoots, groupRoots, ends);
+    sortedRoots.ReleaseResources();
+    vtkm::Id numGroups = groupRoots.GetNumberOfValues();
+    vtkm::cont::ArrayHandle<vtkm::Id> groupCounts;
+    Algorithm::Schedule(
+          internal::HaloFinderCountKernel<IdPortalConstType,IdPortalType>(
+            starts.PrepareForInput(DeviceAdapterTag()),
+            ends.PrepareForInput(DeviceAdapterTag()),
+            groupCounts.PrepareForOutput(numGroups, DeviceAdapterTag()),
+            this->MinimumHaloSize),
+          numGroups);
+
+    // Groups too small to be halos have a count of 0 and are dropped.
+    vtkm::cont::ArrayHandle<vtkm::Id> haloRoots;
+    Algorithm::StreamCompact(groupRoots, groupCounts, haloRoots);
+    Algorithm::StreamCompact(groupCounts, groupCounts, haloCounts);
+
+    Algorithm::LowerBounds(haloRoots, roots, haloIds);
+    Algorithm::Schedule(
+          internal::HaloFinderLabelKernel<IdPortalConstType,IdPortalType>(
+            roots.PrepareForInput(DeviceAdapterTag()),
+            haloRoots.PrepareForInput(DeviceAdapterTag()),
+            haloIds.PrepareForInPlace(DeviceAdapterTag())),
+          numPoints);
+  }
+
+private:
+  vtkm::Id MinimumHaloSize;
+
+  // Bins at least the linking length wide, with no more bins than points.
+  // The point locator packs a bin and a point index into one Int64 key, so
+  // the number of bins times the number of points must also fit in an Int64.
+  VTKM_CONT_EXPORT
+  static vtkm::Id3 ChooseDivisions(const vtkm::Bounds &bounds,
+                                   vtkm::FloatDefault linkingLength,
+                                   vtkm::Id numPoints)
+  {
+    const vtkm::Range *ranges[3] = { &bounds.X, &bounds.Y, &bounds.Z };
+    vtkm::Id maxBins = (numPoints > 1) ? numPoints : 1;
+    const vtkm::Int64 maxKeyBins =
+        std::numeric_limits<vtkm::Int64>::max()
+        / static_cast<vtkm::Int64>(maxBins);
+    if (static_cast<vtkm::Int64>(maxBins) > maxKeyBins)
+    {
+      maxBins = static_cast<vtkm::Id>(maxKeyBins);
+    }
+    vtkm::Id3 divisions(1, 1, 1);
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      vtkm::Float64 length =
+          ranges[axis]->IsNonEmpty() ? ranges[axis]->Length() : 0.0;
+      vtkm::Float64 bins = static_cast<vtkm::Float64>(maxBins);
+      if (linkingLength > 0)
+      {
+        bins = length/static_cast<vtkm::Float64>(linkingLength);
+      }
+      else if (!(length > 0.0))
+      {
+        bins = 1.0;
+      }
+      if (bins >= static_cast<vtkm::Float64>(maxBins))
+      {
+        divisions[axis] = maxBins;
+      }
+      else if (bins > 1.0)
+      {
+        divisions[axis] = static_cast<vtkm::Id>(bins);
+      }
+    }
+
+    while (static_cast<vtkm::Float64>(divisions[0])
+           * static_cast<vtkm::Float64>(divisions[1])
+           * static_cast<vtkm::Float64>(divisions[2])
+           > static_cast<vtkm::Float64>(maxBins))
+    {
+      vtkm::IdComponent largest = 0;
+      if (divisions[1] > divisions[largest]) { largest = 1; }
+      if (divisions[2] > divisions[largest]) { largest = 2; }
+      divisions[largest] = (divisions[largest] + 1)/2;
+    }
+    return divisions;
+  }
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_HaloFinder_h
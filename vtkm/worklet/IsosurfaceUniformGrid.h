@@ -0,0 +1,453 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_IsosurfaceUniformGrid_h
+#define vtk_m_worklet_IsosurfaceUniformGrid_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/worklet/internal/MarchingCubesDataTables.h>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+// Reads the field at the corners of a cell of a uniform grid and finds the
+// marching cubes case of the cell for an isovalue.
+template<typename FieldPortalType>
+struct IsosurfaceCell
+{
+  typedef typename FieldPortalType::ValueType FieldType;
+
+  vtkm::Id PointIds[8];
+  FieldType Values[8];
+
+  VTKM_EXEC_EXPORT
+  IsosurfaceCell(const FieldPortalType &field,
+                 const vtkm::Id3 &pointDimensions,
+                 vtkm::Id cellIndex)
+  {
+    vtkm::Id cellsInX = pointDimensions[0] - 1;
+    vtkm::Id cellsInY = pointDimensions[1] - 1;
+    vtkm::Id i = cellIndex % cellsInX;
+    vtkm::Id j = (cellIndex / cellsInX) % cellsInY;
+    vtkm::Id k = cellIndex / (cellsInX*cellsInY);
+    vtkm::Id lowestPoint =
+        i + pointDimensions[0]*(j + pointDimensions[1]*k);
+
+    for (vtkm::IdComponent corner = 0; corner < 8; corner++)
+    {
+      const vtkm::IdComponent *offset = CornerOffsetTable + 3*corner;
+      this->PointIds[corner] =
+          lowestPoint + offset[0]
+          + pointDimensions[0]*(offset[1] + pointDimensions[1]*offset[2]);
+      this->Values[corner] = field.Get(this->PointIds[corner]);
+    }
+  }
+
+  VTKM_EXEC_EXPORT
+  vtkm::IdComponent GetCase(const FieldType &isoValue) const
+  {
+    vtkm::IdComponent caseNumber = 0;
+    for (vtkm::IdComponent corner = 0; corner < 8; corner++)
+    {
+      if (!(this->Values[corner] < isoValue))
+      {
+        caseNumber |= (1 << corner);
+      }
+    }
+    return caseNumber;
+  }
+};
+
+// Counts the triangles each cell generates for each isovalue.
+template<typename FieldPortalType,
+         typename IsoValuePortalType,
+         typename CountPortalType>
+struct IsosurfaceClassifyKernel : public vtkm::exec::FunctorBase
+{
+  FieldPortalType Field;
+  IsoValuePortalType IsoValues;
+  CountPortalType Counts;
+  vtkm::Id3 PointDimensions;
+
+  VTKM_CONT_EXPORT
+  IsosurfaceClassifyKernel(const FieldPortalType &field,
+                           const IsoValuePortalType &isoValues,
+                           const CountPortalType &counts,
+                           const vtkm::Id3 &pointDimensions)
+    : Field(field),
+      IsoValues(isoValues),
+      Counts(counts),
+      PointDimensions(pointDimensions) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    IsosurfaceCell<FieldPortalType> cell(this->Field,
+                                         this->PointDimensions,
+                                         cellIndex);
+    vtkm::Id numIsoValues = this->IsoValues.GetNumberOfValues();
+    for (vtkm::Id isoIndex = 0; isoIndex < numIsoValues; isoIndex++)
+    {
+      vtkm::IdComponent caseNumber =
+          cell.GetCase(this->IsoValues.Get(isoIndex));
+      this->Counts.Set(cellIndex*numIsoValues + isoIndex,
+                       NumTrianglesTable[caseNumber]);
+    }
+  }
+};
+
+// Writes the triangles of each cell at the offsets found by scanning the
+// counts. Every triangle vertex is written separately along with a key that
+// identifies the grid edge it lies on, so that shared vertices can be merged
+// afterward.
+template<typename FieldPortalType,
+         typename CoordinatesPortalType,
+         typename IsoValuePortalType,
+         typename OffsetPortalType,
+         typename PointPortalType,
+         typename EdgeKeyPortalType,
+         typename IsoIndexPortalType>
+struct IsosurfaceGenerateKernel : public vtkm::exec::FunctorBase
+{
+  typedef typename PointPortalType::ValueType PointType;
+  typedef typename PointType::ComponentType CoordinateType;
+
+  FieldPortalType Field;
+  CoordinatesPortalType Coordinates;
+  IsoValuePortalType IsoValues;
+  OffsetPortalType Offsets;
+  PointPortalType Points;
+  EdgeKeyPortalType EdgeKeys;
+  IsoIndexPortalType IsoIndices;
+  vtkm::Id3 PointDimensions;
+
+  VTKM_CONT_EXPORT
+  IsosurfaceGenerateKernel(const FieldPortalType &field,
+                           const CoordinatesPortalType &coordinates,
+                           const IsoValuePortalType &isoValues,
+                           const OffsetPortalType &offsets,
+                           const PointPortalType &points,
+                           const EdgeKeyPortalType &edgeKeys,
+                           const IsoIndexPortalType &isoIndices)
+    : Field(field),
+      Coordinates(coordinates),
+      IsoValues(isoValues),
+      Offsets(offsets),
+      Points(points),
+      EdgeKeys(edgeKeys),
+      IsoIndices(isoIndices),
+      PointDimensions(coordinates.GetRange3()) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    IsosurfaceCell<FieldPortalType> cell(this->Field,
+                                         this->PointDimensions,
+                                         cellIndex);
+    vtkm::Id numIsoValues = this->IsoValues.GetNumberOfValues();
+    vtkm::Id numPoints = this->Field.GetNumberOfValues();
+    for (vtkm::Id isoIndex = 0; isoIndex < numIsoValues; isoIndex++)
+    {
+      typename IsoValuePortalType::ValueType isoValue =
+          this->IsoValues.Get(isoIndex);
+      vtkm::IdComponent caseNumber = cell.GetCase(isoValue);
+      vtkm::IdComponent numTriangles = NumTrianglesTable[caseNumber];
+      if (numTriangles == 0) { continue; }
+
+      vtkm::Id triangleIndex =
+          this->Offsets.Get(cellIndex*numIsoValues + isoIndex);
+      const vtkm::IdComponent *edges = TriangleTable + 15*caseNumber;
+      for (vtkm::IdComponent vertex = 0; vertex < 3*numTriangles; vertex++)
+      {
+        vtkm::IdComponent edge = edges[vertex];
+        vtkm::IdComponent corner0 = EdgeCornerTable[2*edge];
+        vtkm::IdComponent corner1 = EdgeCornerTable[2*edge + 1];
+
+        // Both cells sharing an edge interpolate from its lower point, so
+        // they compute exactly the same vertex.
+        vtkm::Float64 value0 =
+            static_cast<vtkm::Float64>(cell.Values[corner0]);
+        vtkm::Float64 value1 =
+            static_cast<vtkm::Float64>(cell.Values[corner1]);
+        CoordinateType weight = static_cast<CoordinateType>(
+              (static_cast<vtkm::Float64>(isoValue) - value0)
+              / (value1 - value0));
+        PointType point0 = this->Coordinates.Get(cell.PointIds[corner0]);
+        PointType point1 = this->Coordinates.Get(cell.PointIds[corner1]);
+        PointType point;
+        for (vtkm::IdComponent component = 0; component < 3; component++)
+        {
+          point[component] = point0[component]
+              + weight*(point1[component] - point0[component]);
+        }
+
+        vtkm::Id outIndex = 3*triangleIndex + vertex;
+        this->Points.Set(outIndex, point);
+        this->EdgeKeys.Set(
+              outIndex,
+              3*(static_cast<vtkm::Int64>(isoIndex)*numPoints
+                 + cell.PointIds[corner0])
+              + EdgeAxisTable[edge]);
+      }
+      for (vtkm::IdComponent triangle = 0;
+           triangle < numTriangles;
+           triangle++)
+      {
+        this->IsoIndices.Set(triangleIndex + triangle,
+                             static_cast<vtkm::IdComponent>(isoIndex));
+      }
+    }
+  }
+};
+
+// Moves every triangle vertex to its place in the merged point list.
+// Vertices that were merged have the same coordinates, so the order of the
+// writes does not matter.
+template<typename PointPortalType,
+         typename ConnectivityPortalType,
+         typename MergedPointPortalType>
+struct IsosurfaceMergePointsKernel : public vtkm::exec::FunctorBase
+{
+  PointPortalType Points;
+  ConnectivityPortalType Connectivity;
+  MergedPointPortalType MergedPoints;
+
+  VTKM_CONT_EXPORT
+  IsosurfaceMergePointsKernel(const PointPortalType &points,
+                              const ConnectivityPortalType &connectivity,
+                              const MergedPointPortalType &mergedPoints)
+    : Points(points),
+      Connectivity(connectivity),
+      MergedPoints(mergedPoints) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    this->MergedPoints.Set(this->Connectivity.Get(index),
+                           this->Points.Get(index));
+  }
+};
+
+} // namespace internal
+
+/// \brief Extracts isosurfaces of a point field on a uniform grid.
+///
+/// Uses marching cubes. A first pass classifies every cell against every
+/// isovalue and counts the triangles it generates, an exclusive scan of the
+/// counts gives each cell its place in the output, and a second pass writes
+/// the triangles into arrays allocated to the exact size. Both passes read
+/// the field at the corners of a cell once for all the isovalues, and all
+/// per-cell work uses fixed-size storage.
+///
+/// The output is a list of triangles given as three point indices each. By
+/// default, vertices that lie on the same grid edge are merged so that the
+/// surface is connected. The triangle vertices are keyed by grid edge (as a
+/// 64-bit integer, so large grids with many isovalues do not overflow), and
+/// the keys are sorted and made unique; the index of each vertex is then
+/// found with LowerBounds. Turning merging off skips these steps and leaves
+/// three points per triangle.
+///
+template<typename DeviceAdapterTag>
+class IsosurfaceUniformGrid
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+
+  VTKM_CONT_EXPORT
+  IsosurfaceUniformGrid() : MergeDuplicatePoints(true) {  }
+
+  VTKM_CONT_EXPORT
+  bool GetMergeDuplicatePoints() const { return this->MergeDuplicatePoints; }
+
+  VTKM_CONT_EXPORT
+  void SetMergeDuplicatePoints(bool merge)
+  {
+    this->MergeDuplicatePoints = merge;
+  }
+
+  /// Extracts the isosurface of \p field for each value in \p isoValues.
+  /// \p field holds a value for each point of \p coordinates. Each output
+  /// triangle is three consecutive indices of \p connectivity into
+  /// \p points, and \p isoValueIndices holds the index of the isovalue of
+  /// each triangle. Triangles are grouped by cell, and those of a cell are
+  /// ordered by isovalue.
+  ///
+  template<typename FieldType, typename FieldStorage, typename IsoValueStorage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::ArrayHandleUniformPointCoordinates &coordinates,
+           const vtkm::cont::ArrayHandle<FieldType,FieldStorage> &field,
+           const vtkm::cont::ArrayHandle<FieldType,IsoValueStorage> &isoValues,
+           vtkm::cont::ArrayHandle<PointType> &points,
+           vtkm::cont::ArrayHandle<vtkm::Id> &connectivity,
+           vtkm::cont::ArrayHandle<vtkm::IdComponent> &isoValueIndices) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<FieldType,FieldStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        FieldPortalType;
+    typedef typename vtkm::cont::ArrayHandle<FieldType,IsoValueStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IsoValuePortalType;
+    typedef typename vtkm::cont::ArrayHandleUniformPointCoordinates
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        CoordinatesPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Int64>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal EdgeKeyPortalType;
+    typedef typename vtkm::cont::ArrayHandle<PointType>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal PointPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::IdComponent>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal
+        IsoIndexPortalType;
+
+    if (field.GetNumberOfValues() != coordinates.GetNumberOfValues())
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Isosurface field does not have a value for every point.");
+    }
+
+    CoordinatesPortalType coordinatesPortal =
+        coordinates.PrepareForInput(DeviceAdapterTag());
+    vtkm::Id3 pointDimensions = coordinatesPortal.GetRange3();
+    vtkm::Id numCells = 0;
+    if ((pointDimensions[0] > 1) &&
+        (pointDimensions[1] > 1) &&
+        (pointDimensions[2] > 1))
+    {
+      numCells = (pointDimensions[0] - 1)
+          * (pointDimensions[1] - 1)
+          * (pointDimensions[2] - 1);
+    }
+    vtkm::Id numIsoValues = isoValues.GetNumberOfValues();
+
+    FieldPortalType fieldPortal = field.PrepareForInput(DeviceAdapterTag());
+    IsoValuePortalType isoValuePortal =
+        isoValues.PrepareForInput(DeviceAdapterTag());
+
+    vtkm::cont::ArrayHandle<vtkm::Id> triangleCounts;
+    Algorithm::Schedule(
+          internal::IsosurfaceClassifyKernel<
+            FieldPortalType,IsoValuePortalType,IdPortalType>(
+            fieldPortal,
+            isoValuePortal,
+            triangleCounts.PrepareForOutput(numCells*numIsoValues,
+                                            DeviceAdapterTag()),
+            pointDimensions),
+          numCells);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> triangleOffsets;
+    vtkm::Id numTriangles =
+        Algorithm::ScanExclusive(triangleCounts, triangleOffsets);
+    triangleCounts.ReleaseResources();
+
+    vtkm::cont::ArrayHandle<PointType> vertices;
+    vtkm::cont::ArrayHandle<vtkm::Int64> edgeKeys;
+    Algorithm::Schedule(
+          internal::IsosurfaceGenerateKernel<
+            FieldPortalType,
+            CoordinatesPortalType,
+            IsoValuePortalType,
+            IdPortalConstType,
+            PointPortalType,
+            EdgeKeyPortalType,
+            IsoIndexPortalType>(
+            fieldPortal,
+            coordinatesPortal,
+            isoValuePortal,
+            triangleOffsets.PrepareForInput(DeviceAdapterTag()),
+            vertices.PrepareForOutput(3*numTriangles, DeviceAdapterTag()),
+            edgeKeys.PrepareForOutput(3*numTriangles, DeviceAdapterTag()),
+            isoValueIndices.PrepareForOutput(numTriangles,
+                                             DeviceAdapterTag())),
+          numCells);
+    triangleOffsets.ReleaseResources();
+
+    if (!this->MergeDuplicatePoints)
+    {
+      points = vertices;
+      Algorithm::Copy(
+            vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), 3*numTriangles),
+            connectivity);
+      return;
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Int64> uniqueEdgeKeys;
+    Algorithm::Copy(edgeKeys, uniqueEdgeKeys);
+    Algorithm::Sort(uniqueEdgeKeys);
+    Algorithm::Unique(uniqueEdgeKeys);
+    Algorithm::LowerBounds(uniqueEdgeKeys, edgeKeys, connectivity);
+    vtkm::Id numMergedPoints = uniqueEdgeKeys.GetNumberOfValues();
+    uniqueEdgeKeys.ReleaseResources();
+    edgeKeys.ReleaseResources();
+
+    typedef typename vtkm::cont::ArrayHandle<PointType>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        PointPortalConstType;
+    Algorithm::Schedule(
+          internal::IsosurfaceMergePointsKernel<
+            PointPortalConstType,IdPortalConstType,PointPortalType>(
+            vertices.PrepareForInput(DeviceAdapterTag()),
+            connectivity.PrepareForInput(DeviceAdapterTag()),
+            points.PrepareForOutput(numMergedPoints, DeviceAdapterTag())),
+          3*numTriangles);
+  }
+
+  /// Extracts the isosurface of \p field for a single isovalue.
+  ///
+  template<typename FieldType, typename FieldStorage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::ArrayHandleUniformPointCoordinates &coordinates,
+           const vtkm::cont::ArrayHandle<FieldType,FieldStorage> &field,
+           FieldType isoValue,
+           vtkm::cont::ArrayHandle<PointType> &points,
+           vtkm::cont::ArrayHandle<vtkm::Id> &connectivity) const
+  {
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> isoValueIndices;
+    this->Run(coordinates,
+              field,
+              vtkm::cont::make_ArrayHandle(&isoValue, 1),
+              points,
+              connectivity,
+              isoValueIndices);
+  }
+
+private:
+  bool MergeDuplicatePoints;
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_IsosurfaceUniformGrid_h
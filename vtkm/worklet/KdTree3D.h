@@ -0,0 +1,970 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_KdTree3D_h
+#define vtk_m_worklet_KdTree3D_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/worklet/internal/PointDistance.h>
+#include <vtkm/worklet/internal/PointLocatorRadius.h>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+typedef vtkm::Vec<vtkm::FloatDefault,3> KdTreePointType;
+
+// The most levels a tree can have. Each level halves the points, so this
+// is more than enough for any vtkm::Id.
+static const vtkm::IdComponent KD_TREE_MAX_DEPTH = 64;
+
+template<typename T>
+VTKM_EXEC_EXPORT
+KdTreePointType KdTreeToPoint(const vtkm::Vec<T,3> &point)
+{
+  return KdTreePointType(static_cast<vtkm::FloatDefault>(point[0]),
+                         static_cast<vtkm::FloatDefault>(point[1]),
+                         static_cast<vtkm::FloatDefault>(point[2]));
+}
+
+/// The node of a level of the tree that holds the point at \p position of
+/// the sorted points, and the range of positions of that node. A node over
+/// positions [low, high) splits them at low + (high - low)/2, its left
+/// child being 2*node + 1 and its right child 2*node + 2.
+///
+VTKM_EXEC_EXPORT
+vtkm::Id KdTreeFindNode(vtkm::Id position,
+                        vtkm::IdComponent level,
+                        vtkm::Id &low,
+                        vtkm::Id &high)
+{
+  vtkm::Id node = 0;
+  for (vtkm::IdComponent depth = 0; depth < level; depth++)
+  {
+    vtkm::Id middle = low + (high - low)/2;
+    if (position < middle)
+    {
+      node = 2*node + 1;
+      high = middle;
+    }
+    else
+    {
+      node = 2*node + 2;
+      low = middle;
+    }
+  }
+  return node;
+}
+
+// Sorts the points of each node of a level along the axis that node splits.
+struct KdTreeSortKey
+{
+  vtkm::Id Node;
+  vtkm::FloatDefault Value;
+  vtkm::Id PointId;
+
+  VTKM_EXEC_CONT_EXPORT
+  bool operator<(const KdTreeSortKey &other) const
+  {
+    if (this->Node != other.Node) { return this->Node < other.Node; }
+    if (this->Value != other.Value) { return this->Value < other.Value; }
+    return this->PointId < other.PointId;
+  }
+};
+
+// Chooses the split axis of each node of a level as the longest side of its
+// box. The box is the bounds of the points cut by the splits of the nodes
+// above it.
+template<typename AxisPortalType, typename ValuePortalType>
+struct KdTreeAxisKernel : public vtkm::exec::FunctorBase
+{
+  AxisPortalType Axes;
+  ValuePortalType Values;
+  KdTreePointType Lower;
+  KdTreePointType Upper;
+  vtkm::IdComponent Level;
+
+  VTKM_CONT_EXPORT
+  KdTreeAxisKernel(const AxisPortalType &axes,
+                   const ValuePortalType &values,
+                   const KdTreePointType &lower,
+                   const KdTreePointType &upper,
+                   vtkm::IdComponent level)
+    : Axes(axes), Values(values), Lower(lower), Upper(upper), Level(level) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id node = (vtkm::Id(1) << this->Level) - 1 + index;
+    KdTreePointType lower = this->Lower;
+    KdTreePointType upper = this->Upper;
+    vtkm::Id parent = 0;
+    for (vtkm::IdComponent depth = this->Level - 1; depth >= 0; depth--)
+    {
+      vtkm::IdComponent axis = this->Axes.Get(parent);
+      vtkm::FloatDefault split = this->Values.Get(parent);
+      if ((((node + 1) >> depth) & 1) == 0)
+      {
+        upper[axis] = split;
+        parent = 2*parent + 1;
+      }
+      else
+      {
+        lower[axis] = split;
+        parent = 2*parent + 2;
+      }
+    }
+
+    KdTreePointType size = upper - lower;
+    vtkm::IdComponent axis = 0;
+    if (size[1] > size[axis]) { axis = 1; }
+    if (size[2] > size[axis]) { axis = 2; }
+    this->Axes.Set(node, axis);
+  }
+};
+
+template<typename PointPortalType,
+         typename IdPortalType,
+         typename AxisPortalType,
+         typename KeyPortalType>
+struct KdTreeKeyKernel : public vtkm::exec::FunctorBase
+{
+  PointPortalType Points;
+  IdPortalType PointIds;
+  AxisPortalType Axes;
+  KeyPortalType Keys;
+  vtkm::IdComponent Level;
+
+  VTKM_CONT_EXPORT
+  KdTreeKeyKernel(const PointPortalType &points,
+                  const IdPortalType &pointIds,
+                  const AxisPortalType &axes,
+                  const KeyPortalType &keys,
+                  vtkm::IdComponent level)
+    : Points(points),
+      PointIds(pointIds),
+      Axes(axes),
+      Keys(keys),
+      Level(level) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id position) const
+  {
+    vtkm::Id low = 0;
+    vtkm::Id high = this->PointIds.GetNumberOfValues();
+    KdTreeSortKey key;
+    key.Node = KdTreeFindNode(position, this->Level, low, high);
+    key.PointId = this->PointIds.Get(position);
+    key.Value = this->Points.Get(key.PointId)[this->Axes.Get(key.Node)];
+    this->Keys.Set(position, key);
+  }
+};
+
+template<typename KeyPortalType, typename IdPortalType>
+struct KdTreeReorderKernel : public vtkm::exec::FunctorBase
+{
+  KeyPortalType Keys;
+  IdPortalType PointIds;
+
+  VTKM_CONT_EXPORT
+  KdTreeReorderKernel(const KeyPortalType &keys,
+                      const IdPortalType &pointIds)
+    : Keys(keys), PointIds(pointIds) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id position) const
+  {
+    this->PointIds.Set(position, this->Keys.Get(position).PointId);
+  }
+};
+
+// The split value of a node is the coordinate of the first point of its
+// right half, so points on the left are no greater and points on the right
+// no less.
+template<typename KeyPortalType, typename ValuePortalType>
+struct KdTreeSplitKernel : public vtkm::exec::FunctorBase
+{
+  KeyPortalType Keys;
+  ValuePortalType Values;
+  vtkm::IdComponent Level;
+
+  VTKM_CONT_EXPORT
+  KdTreeSplitKernel(const KeyPortalType &keys,
+                    const ValuePortalType &values,
+                    vtkm::IdComponent level)
+    : Keys(keys), Values(values), Level(level) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id node = (vtkm::Id(1) << this->Level) - 1 + index;
+    vtkm::Id low = 0;
+    vtkm::Id high = this->Keys.GetNumberOfValues();
+    for (vtkm::IdComponent depth = this->Level - 1; depth >= 0; depth--)
+    {
+      vtkm::Id middle = low + (high - low)/2;
+      if ((((node + 1) >> depth) & 1) == 0) { high = middle; }
+      else { low = middle; }
+    }
+    this->Values.Set(node, this->Keys.Get(low + (high - low)/2).Value);
+  }
+};
+
+template<typename InputPortalType,
+         typename IdPortalType,
+         typename PointPortalType>
+struct KdTreeGatherKernel : public vtkm::exec::FunctorBase
+{
+  InputPortalType Input;
+  IdPortalType PointIds;
+  PointPortalType Points;
+
+  VTKM_CONT_EXPORT
+  KdTreeGatherKernel(const InputPortalType &input,
+                     const IdPortalType &pointIds,
+                     const PointPortalType &points)
+    : Input(input), PointIds(pointIds), Points(points) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id position) const
+  {
+    this->Points.Set(position,
+                     KdTreeToPoint(this->Input.Get(
+                                     this->PointIds.Get(position))));
+  }
+};
+
+/// The execution side of KdTree3D. The points are stored in tree order, so
+/// the points of a node are a contiguous range of SortedPoints, and each
+/// inner node has a split axis and value.
+///
+template<typename PointPortalType,
+         typename IdPortalType,
+         typename AxisPortalType,
+         typename ValuePortalType>
+struct KdTree3DExec
+{
+  PointPortalType SortedPoints;
+  IdPortalType SortedPointIds;
+  AxisPortalType SplitAxes;
+  ValuePortalType SplitValues;
+
+  VTKM_CONT_EXPORT
+  KdTree3DExec(const PointPortalType &sortedPoints,
+               const IdPortalType &sortedPointIds,
+               const AxisPortalType &splitAxes,
+               const ValuePortalType &splitValues)
+    : SortedPoints(sortedPoints),
+      SortedPointIds(sortedPointIds),
+      SplitAxes(splitAxes),
+      SplitValues(splitValues) {  }
+
+  struct StackEntry
+  {
+    vtkm::Id Node;
+    vtkm::Id Low;
+    vtkm::Id High;
+    vtkm::FloatDefault Bound;
+  };
+
+  /// Walks the nodes that may hold points within the squared distance given
+  /// by \p visitor, nearer children first. The visitor is called with each
+  /// point of those leaves and returns the squared distance beyond which it
+  /// no longer needs points, which it may shrink as points are found.
+  ///
+  template<typename VisitorType>
+  VTKM_EXEC_EXPORT
+  void Walk(const KdTreePointType &query, VisitorType &visitor) const
+  {
+    vtkm::Id numInnerNodes = this->SplitAxes.GetNumberOfValues();
+    StackEntry stack[KD_TREE_MAX_DEPTH + 1];
+    vtkm::IdComponent top = 0;
+    stack[0].Node = 0;
+    stack[0].Low = 0;
+    stack[0].High = this->SortedPoints.GetNumberOfValues();
+    stack[0].Bound = vtkm::FloatDefault(0);
+    top = 1;
+
+    while (top > 0)
+    {
+      top--;
+      StackEntry entry = stack[top];
+      if (!visitor.Reaches(entry.Bound)) { continue; }
+
+      if (entry.Node >= numInnerNodes)
+      {
+        for (vtkm::Id position = entry.Low; position < entry.High; position++)
+        {
+          visitor(this->SortedPointIds.Get(position),
+                  Distance2(query, this->SortedPoints.Get(position)));
+        }
+        continue;
+      }
+
+      vtkm::IdComponent axis = this->SplitAxes.Get(entry.Node);
+      vtkm::FloatDefault difference =
+          query[axis] - this->SplitValues.Get(entry.Node);
+      vtkm::Id middle = entry.Low + (entry.High - entry.Low)/2;
+      StackEntry left;
+      left.Node = 2*entry.Node + 1;
+      left.Low = entry.Low;
+      left.High = middle;
+      StackEntry right;
+      right.Node = 2*entry.Node + 2;
+      right.Low = middle;
+      right.High = entry.High;
+
+      // The far child goes on the stack first so the near one is walked
+      // first. Its points are at least as far as the split plane.
+      vtkm::FloatDefault planeDistance2 = difference*difference;
+      vtkm::FloatDefault farBound = (planeDistance2 > entry.Bound)
+          ? planeDistance2 : entry.Bound;
+      if (difference < 0)
+      {
+        right.Bound = farBound;
+        left.Bound = entry.Bound;
+        stack[top++] = right;
+        stack[top++] = left;
+      }
+      else
+      {
+        left.Bound = farBound;
+        right.Bound = entry.Bound;
+        stack[top++] = left;
+        stack[top++] = right;
+      }
+    }
+  }
+
+  // Keeps the k nearest points found so far in a slice of the output
+  // arrays, sorted by distance and then by id.
+  template<typename IdOutPortalType, typename DistanceOutPortalType>
+  struct NearestVisitor
+  {
+    IdOutPortalType Ids;
+    DistanceOutPortalType Distances2;
+    vtkm::Id Start;
+    vtkm::IdComponent K;
+    vtkm::IdComponent Count;
+
+    VTKM_EXEC_EXPORT
+    NearestVisitor(const IdOutPortalType &ids,
+                   const DistanceOutPortalType &distances2,
+                   vtkm::Id start,
+                   vtkm::IdComponent k)
+      : Ids(ids), Distances2(distances2), Start(start), K(k), Count(0) {  }
+
+    VTKM_EXEC_EXPORT
+    bool Reaches(vtkm::FloatDefault bound) const
+    {
+      return (this->Count < this->K)
+          || !(bound > this->Distances2.Get(this->Start + this->K - 1));
+    }
+
+    VTKM_EXEC_EXPORT
+    bool Before(vtkm::FloatDefault distance2,
+                vtkm::Id pointId,
+                vtkm::Id slot) const
+    {
+      vtkm::FloatDefault other = this->Distances2.Get(this->Start + slot);
+      return (distance2 < other)
+          || ((distance2 == other) && (pointId < this->Ids.Get(this->Start
+                                                               + slot)));
+    }
+
+    VTKM_EXEC_EXPORT
+    void operator()(vtkm::Id pointId, vtkm::FloatDefault distance2)
+    {
+      vtkm::Id slot = this->Count;
+      if (this->Count < this->K)
+      {
+        this->Count++;
+      }
+      else if (!this->Before(distance2, pointId, this->K - 1))
+      {
+        return;
+      }
+      else
+      {
+        slot = this->K - 1;
+      }
+      while ((slot > 0) && this->Before(distance2, pointId, slot - 1))
+      {
+        this->Ids.Set(this->Start + slot, this->Ids.Get(this->Start+slot-1));
+        this->Distances2.Set(this->Start + slot,
+                             this->Distances2.Get(this->Start + slot - 1));
+        slot--;
+      }
+      this->Ids.Set(this->Start + slot, pointId);
+      this->Distances2.Set(this->Start + slot, distance2);
+    }
+  };
+
+  /// Writes the ids and squared distances of the \p k points nearest to
+  /// \p queryPoint to entries \p start to \p start + \p k of \p ids and
+  /// \p distances2, nearest first. Ties go to the smaller id. If there are
+  /// fewer than \p k points, the remaining ids are -1.
+  ///
+  template<typename T, typename IdOutPortalType, typename DistanceOutPortalType>
+  VTKM_EXEC_EXPORT
+  void FindNearestNeighbors(const vtkm::Vec<T,3> &queryPoint,
+                            vtkm::IdComponent k,
+                            const IdOutPortalType &ids,
+                            const DistanceOutPortalType &distances2,
+                            vtkm::Id start) const
+  {
+    NearestVisitor<IdOutPortalType,DistanceOutPortalType>
+        visitor(ids, distances2, start, k);
+    this->Walk(KdTreeToPoint(queryPoint), visitor);
+    for (vtkm::IdComponent slot = visitor.Count; slot < k; slot++)
+    {
+      ids.Set(start + slot, -1);
+      distances2.Set(start + slot, vtkm::FloatDefault(0));
+    }
+  }
+
+  // Passes on the points within a radius.
+  template<typename VisitorType>
+  struct RadiusVisitor
+  {
+    VisitorType &Visitor;
+    vtkm::FloatDefault Radius2;
+
+    VTKM_EXEC_EXPORT
+    RadiusVisitor(VisitorType &visitor, vtkm::FloatDefault radius2)
+      : Visitor(visitor), Radius2(radius2) {  }
+
+    VTKM_EXEC_EXPORT
+    bool Reaches(vtkm::FloatDefault bound) const
+    {
+      return !(bound > this->Radius2);
+    }
+
+    VTKM_EXEC_EXPORT
+    void operator()(vtkm::Id pointId, vtkm::FloatDefault distance2)
+    {
+      if (!(distance2 > this->Radius2))
+      {
+        this->Visitor(pointId, distance2);
+      }
+    }
+  };
+
+  /// Calls \p visitor with the id and squared distance of each point within
+  /// \p radius of \p queryPoint.
+  ///
+  template<typename T, typename VisitorType>
+  VTKM_EXEC_EXPORT
+  void VisitInRadius(const vtkm::Vec<T,3> &queryPoint,
+                     vtkm::FloatDefault radius,
+                     VisitorType &visitor) const
+  {
+    RadiusVisitor<VisitorType> radiusVisitor(visitor, radius*radius);
+    this->Walk(KdTreeToPoint(queryPoint), radiusVisitor);
+  }
+};
+
+// Writes the Morton code of each query in the bounds of the tree, with the
+// query index, so that sorting them orders the queries along a space
+// filling curve.
+template<typename QueryPortalType, typename OrderPortalType>
+struct KdTreeMortonKernel : public vtkm::exec::FunctorBase
+{
+  QueryPortalType Queries;
+  OrderPortalType Order;
+  KdTreePointType Origin;
+  KdTreePointType Scale;
+
+  VTKM_CONT_EXPORT
+  KdTreeMortonKernel(const QueryPortalType &queries,
+                     const OrderPortalType &order,
+                     const KdTreePointType &origin,
+                     const KdTreePointType &scale)
+    : Queries(queries), Order(order), Origin(origin), Scale(scale) {  }
+
+  // Spreads the low 10 bits of a value to every third bit.
+  VTKM_EXEC_EXPORT
+  static vtkm::UInt32 Spread(vtkm::UInt32 bits)
+  {
+    bits &= 0x3FF;
+    bits = (bits | (bits << 16)) & 0x030000FF;
+    bits = (bits | (bits << 8)) & 0x0300F00F;
+    bits = (bits | (bits << 4)) & 0x030C30C3;
+    bits = (bits | (bits << 2)) & 0x09249249;
+    return bits;
+  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    KdTreePointType query = KdTreeToPoint(this->Queries.Get(index));
+    vtkm::UInt32 code = 0;
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      vtkm::FloatDefault offset =
+          (query[axis] - this->Origin[axis])*this->Scale[axis];
+      vtkm::UInt32 cell = 0;
+      if (offset > vtkm::FloatDefault(1023)) { cell = 1023; }
+      else if (offset > 0) { cell = static_cast<vtkm::UInt32>(offset); }
+      code |= Spread(cell) << axis;
+    }
+    this->Order.Set(index, vtkm::Vec<vtkm::Id,2>(
+                      static_cast<vtkm::Id>(code), index));
+  }
+};
+
+template<typename OrderPortalType, typename IdPortalType>
+struct KdTreeOrderKernel : public vtkm::exec::FunctorBase
+{
+  OrderPortalType Order;
+  IdPortalType QueryIds;
+
+  VTKM_CONT_EXPORT
+  KdTreeOrderKernel(const OrderPortalType &order,
+                    const IdPortalType &queryIds)
+    : Order(order), QueryIds(queryIds) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    this->QueryIds.Set(index, this->Order.Get(index)[1]);
+  }
+};
+
+template<typename TreeType,
+         typename QueryPortalType,
+         typename OrderPortalType,
+         typename IdPortalType,
+         typename DistancePortalType>
+struct KdTreeNearestKernel : public vtkm::exec::FunctorBase
+{
+  TreeType Tree;
+  QueryPortalType Queries;
+  OrderPortalType Order;
+  vtkm::IdComponent K;
+  IdPortalType Ids;
+  DistancePortalType Distances2;
+
+  VTKM_CONT_EXPORT
+  KdTreeNearestKernel(const TreeType &tree,
+                      const QueryPortalType &queries,
+                      const OrderPortalType &order,
+                      vtkm::IdComponent k,
+                      const IdPortalType &ids,
+                      const DistancePortalType &distances2)
+    : Tree(tree),
+      Queries(queries),
+      Order(order),
+      K(k),
+      Ids(ids),
+      Distances2(distances2) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id query = this->Order.Get(index);
+    this->Tree.FindNearestNeighbors(this->Queries.Get(query),
+                                    this->K,
+                                    this->Ids,
+                                    this->Distances2,
+                                    query*this->K);
+  }
+};
+
+} // namespace internal
+
+/// \brief A k-d tree over 3D points for k-nearest neighbor and radius
+/// queries.
+///
+/// The tree is balanced and stored in flat arrays with implicit child
+/// indexing: node n splits its range of points in half, and its children
+/// are 2n+1 and 2n+2, so there is no per-node allocation. Nodes with no
+/// more than the leaf size points are leaves. The tree is built one level
+/// at a time, all nodes of a level together: a single Sort of keys made of
+/// the node, the coordinate along the node's split axis, and the point
+/// orders the points of every node at once, and the middle point of each
+/// node gives its split value. Each node splits the longest side of its
+/// box. A build is a Sort for each level, O(n log^2 n) in all.
+///
+/// Queries are batched and run through Schedule. By default they are first
+/// sorted by the Morton code of their position, so queries that run
+/// together walk the same nodes; the results are still written in the
+/// order of the queries. PrepareForInput gives the execution object so
+/// other kernels can query the tree themselves.
+///
+/// Points are stored with vtkm::FloatDefault components, and distances are
+/// returned squared.
+///
+template<typename DeviceAdapterTag>
+class KdTree3D
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+  typedef internal::KdTree3DExec<
+      typename vtkm::cont::ArrayHandle<PointType>
+          ::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
+      typename vtkm::cont::ArrayHandle<vtkm::Id>
+          ::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
+      typename vtkm::cont::ArrayHandle<vtkm::IdComponent>
+          ::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
+      typename vtkm::cont::ArrayHandle<vtkm::FloatDefault>
+          ::template ExecutionTypes<DeviceAdapterTag>::PortalConst>
+      ExecObjectType;
+
+  VTKM_CONT_EXPORT
+  KdTree3D() : LeafSize(8), SortQueries(true), Depth(0) {  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Id GetLeafSize() const { return this->LeafSize; }
+
+  /// Sets the most points a leaf holds. Smaller leaves make a deeper tree.
+  ///
+  VTKM_CONT_EXPORT
+  void SetLeafSize(vtkm::Id leafSize) { this->LeafSize = leafSize; }
+
+  VTKM_CONT_EXPORT
+  bool GetSortQueries() const { return this->SortQueries; }
+
+  VTKM_CONT_EXPORT
+  void SetSortQueries(bool sortQueries) { this->SortQueries = sortQueries; }
+
+  /// The number of levels of inner nodes of the tree from the last Build.
+  ///
+  VTKM_CONT_EXPORT
+  vtkm::IdComponent GetDepth() const { return this->Depth; }
+
+  /// Builds the tree over \p points.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Build(const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &points)
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        InputPortalType;
+    typedef vtkm::cont::ArrayHandle<internal::KdTreeSortKey> KeyArrayType;
+    typedef typename KeyArrayType
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal KeyPortalType;
+    typedef typename KeyArrayType
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        KeyPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::IdComponent>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal AxisPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::IdComponent>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        AxisPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::FloatDefault>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal ValuePortalType;
+    typedef typename vtkm::cont::ArrayHandle<PointType>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal PointPortalType;
+
+    if (this->LeafSize < 1)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "K-d tree leaves must hold at least one point.");
+    }
+
+    vtkm::Id numPoints = points.GetNumberOfValues();
+    this->Depth = 0;
+    while ((numPoints >> this->Depth)
+           + (((numPoints >> this->Depth) << this->Depth) != numPoints)
+           > this->LeafSize)
+    {
+      this->Depth++;
+    }
+    vtkm::Id numInnerNodes = (vtkm::Id(1) << this->Depth) - 1;
+
+    this->Bounds = vtkm::cont::ComputeBounds(points, DeviceAdapterTag());
+    PointType lower(static_cast<vtkm::FloatDefault>(this->Bounds.X.Min),
+                    static_cast<vtkm::FloatDefault>(this->Bounds.Y.Min),
+                    static_cast<vtkm::FloatDefault>(this->Bounds.Z.Min));
+    PointType upper(static_cast<vtkm::FloatDefault>(this->Bounds.X.Max),
+                    static_cast<vtkm::FloatDefault>(this->Bounds.Y.Max),
+                    static_cast<vtkm::FloatDefault>(this->Bounds.Z.Max));
+
+    Algorithm::Copy(vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0),
+                                                         numPoints),
+                    this->SortedPointIds);
+    this->SplitAxes.PrepareForOutput(numInnerNodes, DeviceAdapterTag());
+    this->SplitValues.PrepareForOutput(numInnerNodes, DeviceAdapterTag());
+
+    KeyArrayType keys;
+    for (vtkm::IdComponent level = 0; level < this->Depth; level++)
+    {
+      vtkm::Id numLevelNodes = vtkm::Id(1) << level;
+      Algorithm::Schedule(
+            internal::KdTreeAxisKernel<AxisPortalType,ValuePortalType>(
+              this->SplitAxes.PrepareForInPlace(DeviceAdapterTag()),
+              this->SplitValues.PrepareForInPlace(DeviceAdapterTag()),
+              lower,
+              upper,
+              level),
+            numLevelNodes);
+      Algorithm::Schedule(
+            internal::KdTreeKeyKernel<
+                InputPortalType,
+                IdPortalConstType,
+                AxisPortalConstType,
+                KeyPortalType>(
+              points.PrepareForInput(DeviceAdapterTag()),
+              this->SortedPointIds.PrepareForInput(DeviceAdapterTag()),
+              this->SplitAxes.PrepareForInput(DeviceAdapterTag()),
+              keys.PrepareForOutput(numPoints, DeviceAdapterTag()),
+              level),
+            numPoints);
+      Algorithm::Sort(keys);
+      Algorithm::Schedule(
+            internal::KdTreeReorderKernel<KeyPortalConstType,IdPortalType>(
+              keys.PrepareForInput(DeviceAdapterTag()),
+              this->SortedPointIds.PrepareForInPlace(DeviceAdapterTag())),
+            numPoints);
+      Algorithm::Schedule(
+            internal::KdTreeSplitKernel<KeyPortalConstType,ValuePortalType>(
+              keys.PrepareForInput(DeviceAdapterTag()),
+              this->SplitValues.PrepareForInPlace(DeviceAdapterTag()),
+              level),
+            numLevelNodes);
+    }
+    keys.ReleaseResources();
+
+    Algorithm::Schedule(
+          internal::KdTreeGatherKernel<
+              InputPortalType,IdPortalConstType,PointPortalType>(
+            points.PrepareForInput(DeviceAdapterTag()),
+            this->SortedPointIds.PrepareForInput(DeviceAdapterTag()),
+            this->SortedPoints.PrepareForOutput(numPoints,
+                                                DeviceAdapterTag())),
+          numPoints);
+  }
+
+  /// Returns an object that answers queries in the execution environment.
+  ///
+  VTKM_CONT_EXPORT
+  ExecObjectType PrepareForInput() const
+  {
+    return ExecObjectType(
+          this->SortedPoints.PrepareForInput(DeviceAdapterTag()),
+          this->SortedPointIds.PrepareForInput(DeviceAdapterTag()),
+          this->SplitAxes.PrepareForInput(DeviceAdapterTag()),
+          this->SplitValues.PrepareForInput(DeviceAdapterTag()));
+  }
+
+  /// Finds the \p k nearest points to each of \p queryPoints. The neighbors
+  /// of query q are entries q*k to q*k+k of \p nearestIds and
+  /// \p distances2, nearest first. When there are fewer than \p k points
+  /// the remaining entries have an id of -1 and a distance of 0.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void FindNearestNeighbors(
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &queryPoints,
+      vtkm::IdComponent k,
+      vtkm::cont::ArrayHandle<vtkm::Id> &nearestIds,
+      vtkm::cont::ArrayHandle<vtkm::FloatDefault> &distances2) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        QueryPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        OrderPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::FloatDefault>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal
+        DistancePortalType;
+
+    if (k < 1)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "K-d tree queries need at least one neighbor.");
+    }
+
+    vtkm::Id numQueries = queryPoints.GetNumberOfValues();
+    vtkm::cont::ArrayHandle<vtkm::Id> order;
+    this->OrderQueries(queryPoints, order);
+    Algorithm::Schedule(
+          internal::KdTreeNearestKernel<
+              ExecObjectType,
+              QueryPortalType,
+              OrderPortalType,
+              IdPortalType,
+              DistancePortalType>(
+            this->PrepareForInput(),
+            queryPoints.PrepareForInput(DeviceAdapterTag()),
+            order.PrepareForInput(DeviceAdapterTag()),
+            k,
+            nearestIds.PrepareForOutput(numQueries*k, DeviceAdapterTag()),
+            distances2.PrepareForOutput(numQueries*k, DeviceAdapterTag())),
+          numQueries);
+  }
+
+  /// Finds the points within \p radius of each of \p queryPoints. The
+  /// neighbors of query q are entries offsets[q] to offsets[q]+counts[q] of
+  /// \p neighborIds. The points are counted in a first pass and written in
+  /// a second, after an exclusive scan of the counts.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void FindInRadius(
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &queryPoints,
+      vtkm::FloatDefault radius,
+      vtkm::cont::ArrayHandle<vtkm::Id> &counts,
+      vtkm::cont::ArrayHandle<vtkm::Id> &offsets,
+      vtkm::cont::ArrayHandle<vtkm::Id> &neighborIds) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        QueryPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+
+    if (radius < 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "K-d tree search radius is negative.");
+    }
+
+    vtkm::Id numQueries = queryPoints.GetNumberOfValues();
+    vtkm::cont::ArrayHandle<vtkm::Id> order;
+    this->OrderQueries(queryPoints, order);
+    ExecObjectType tree = this->PrepareForInput();
+    Algorithm::Schedule(
+          internal::PointLocatorRadiusCountKernel<
+              ExecObjectType,QueryPortalType,IdPortalConstType,IdPortalType>(
+            tree,
+            queryPoints.PrepareForInput(DeviceAdapterTag()),
+            order.PrepareForInput(DeviceAdapterTag()),
+            radius,
+            counts.PrepareForOutput(numQueries, DeviceAdapterTag())),
+          numQueries);
+    vtkm::Id numNeighbors = Algorithm::ScanExclusive(counts, offsets);
+
+    Algorithm::Schedule(
+          internal::PointLocatorRadiusKernel<
+              ExecObjectType,
+              QueryPortalType,
+              IdPortalConstType,
+              IdPortalConstType,
+              IdPortalType>(
+            tree,
+            queryPoints.PrepareForInput(DeviceAdapterTag()),
+            order.PrepareForInput(DeviceAdapterTag()),
+            radius,
+            offsets.PrepareForInput(DeviceAdapterTag()),
+            neighborIds.PrepareForOutput(numNeighbors, DeviceAdapterTag())),
+          numQueries);
+  }
+
+private:
+  vtkm::Id LeafSize;
+  bool SortQueries;
+  vtkm::IdComponent Depth;
+  vtkm::Bounds Bounds;
+  vtkm::cont::ArrayHandle<PointType> SortedPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> SortedPointIds;
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> SplitAxes;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> SplitValues;
+
+  // The order to run the queries in: sorted along a Morton curve over the
+  // bounds of the points, or as given.
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void OrderQueries(
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &queryPoints,
+      vtkm::cont::ArrayHandle<vtkm::Id> &order) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        QueryPortalType;
+    typedef vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Id,2> > CodeArrayType;
+
+    vtkm::Id numQueries = queryPoints.GetNumberOfValues();
+    if (!this->SortQueries)
+    {
+      Algorithm::Copy(vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0),
+                                                           numQueries),
+                      order);
+      return;
+    }
+
+    const vtkm::Range *ranges[3] =
+        { &this->Bounds.X, &this->Bounds.Y, &this->Bounds.Z };
+    PointType origin;
+    PointType scale;
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      vtkm::Float64 length = ranges[axis]->Length();
+      origin[axis] = ranges[axis]->IsNonEmpty()
+          ? static_cast<vtkm::FloatDefault>(ranges[axis]->Min)
+          : vtkm::FloatDefault(0);
+      scale[axis] = (length > 0.0)
+          ? static_cast<vtkm::FloatDefault>(1024.0/length)
+          : vtkm::FloatDefault(0);
+    }
+
+    CodeArrayType codes;
+    Algorithm::Schedule(
+          internal::KdTreeMortonKernel<
+              QueryPortalType,
+              typename CodeArrayType
+                  ::template ExecutionTypes<DeviceAdapterTag>::Portal>(
+            queryPoints.PrepareForInput(DeviceAdapterTag()),
+            codes.PrepareForOutput(numQueries, DeviceAdapterTag()),
+            origin,
+            scale),
+          numQueries);
+    Algorithm::Sort(codes);
+    Algorithm::Schedule(
+          internal::KdTreeOrderKernel<
+              typename CodeArrayType
+                  ::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
+              typename vtkm::cont::ArrayHandle<vtkm::Id>
+                  ::template ExecutionTypes<DeviceAdapterTag>::Portal>(
+            codes.PrepareForInput(DeviceAdapterTag()),
+            order.PrepareForOutput(numQueries, DeviceAdapterTag())),
+          numQueries);
+  }
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_KdTree3D_h
@@ -0,0 +1,706 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_PointLocatorUniformGrid_h
+#define vtk_m_worklet_PointLocatorUniformGrid_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/worklet/internal/PointDistance.h>
+#include <vtkm/worklet/internal/PointLocatorRadius.h>
+
+#include <limits>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+/// The bins of a point locator: a uniform grid over the bounds of the
+/// points, numbered with x varying fastest. An axis along which the bounds
+/// have no length gets a single bin. Positions outside the bounds belong to
+/// the nearest bin.
+///
+struct PointLocatorGrid
+{
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+
+  vtkm::Id3 Divisions;
+  PointType Origin;
+  PointType Spacing;
+  PointType InverseSpacing;
+
+  VTKM_EXEC_CONT_EXPORT
+  PointLocatorGrid()
+    : Divisions(1),
+      Origin(vtkm::FloatDefault(0)),
+      Spacing(vtkm::FloatDefault(0)),
+      InverseSpacing(vtkm::FloatDefault(0)) {  }
+
+  VTKM_CONT_EXPORT
+  PointLocatorGrid(const vtkm::Id3 &divisions, const vtkm::Bounds &bounds)
+  {
+    const vtkm::Range *ranges[3] = { &bounds.X, &bounds.Y, &bounds.Z };
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      vtkm::Float64 length = ranges[axis]->Length();
+      bool flat = !(length > 0.0);
+      this->Divisions[axis] = flat ? 1 : divisions[axis];
+      this->Origin[axis] = ranges[axis]->IsNonEmpty()
+          ? static_cast<vtkm::FloatDefault>(ranges[axis]->Min)
+          : vtkm::FloatDefault(0);
+      this->Spacing[axis] = flat ? vtkm::FloatDefault(0)
+          : static_cast<vtkm::FloatDefault>(
+              length/static_cast<vtkm::Float64>(divisions[axis]));
+      this->InverseSpacing[axis] = flat ? vtkm::FloatDefault(0)
+          : static_cast<vtkm::FloatDefault>(
+              static_cast<vtkm::Float64>(divisions[axis])/length);
+    }
+  }
+
+  VTKM_EXEC_CONT_EXPORT
+  vtkm::Id GetNumberOfBins() const
+  {
+    return this->Divisions[0]*this->Divisions[1]*this->Divisions[2];
+  }
+
+  VTKM_EXEC_EXPORT
+  vtkm::Id3 GetBinIndex(const PointType &point) const
+  {
+    vtkm::Id3 bin;
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      vtkm::FloatDefault offset =
+          (point[axis] - this->Origin[axis])*this->InverseSpacing[axis];
+      bin[axis] = (offset > 0) ? static_cast<vtkm::Id>(offset) : 0;
+      if (bin[axis] >= this->Divisions[axis])
+      {
+        bin[axis] = this->Divisions[axis] - 1;
+      }
+    }
+    return bin;
+  }
+
+  VTKM_EXEC_EXPORT
+  vtkm::Id GetFlatIndex(vtkm::Id i, vtkm::Id j, vtkm::Id k) const
+  {
+    return (k*this->Divisions[1] + j)*this->Divisions[0] + i;
+  }
+
+  /// The position of the lower side of a bin along an axis.
+  ///
+  VTKM_EXEC_EXPORT
+  vtkm::FloatDefault GetBinEdge(vtkm::IdComponent axis, vtkm::Id bin) const
+  {
+    return this->Origin[axis]
+        + static_cast<vtkm::FloatDefault>(bin)*this->Spacing[axis];
+  }
+
+  /// The distance along an axis from \p value to bins \p first through
+  /// \p last, which is 0 inside them. The first and last bins of the grid
+  /// reach out to infinity, since they hold the points outside the bounds.
+  ///
+  VTKM_EXEC_EXPORT
+  vtkm::FloatDefault GetGap(vtkm::IdComponent axis,
+                            vtkm::Id first,
+                            vtkm::Id last,
+                            vtkm::FloatDefault value) const
+  {
+    if (first > 0)
+    {
+      vtkm::FloatDefault lower = this->GetBinEdge(axis, first);
+      if (value < lower) { return lower - value; }
+    }
+    if (last < this->Divisions[axis] - 1)
+    {
+      vtkm::FloatDefault upper = this->GetBinEdge(axis, last + 1);
+      if (value > upper) { return value - upper; }
+    }
+    return vtkm::FloatDefault(0);
+  }
+};
+
+template<typename T>
+VTKM_EXEC_EXPORT
+vtkm::Vec<vtkm::FloatDefault,3> PointLocatorToPoint(const vtkm::Vec<T,3> &point)
+{
+  return vtkm::Vec<vtkm::FloatDefault,3>(
+        static_cast<vtkm::FloatDefault>(point[0]),
+        static_cast<vtkm::FloatDefault>(point[1]),
+        static_cast<vtkm::FloatDefault>(point[2]));
+}
+
+/// The execution side of PointLocatorUniformGrid. The points are stored
+/// sorted by bin, and the points of bin b are entries BinStarts[b] up to
+/// BinEnds[b] of SortedPoints and SortedPointIds.
+///
+template<typename PointPortalType, typename IdPortalType>
+struct PointLocatorUniformGridExec
+{
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+
+  PointLocatorGrid Grid;
+  PointPortalType SortedPoints;
+  IdPortalType SortedPointIds;
+  IdPortalType BinStarts;
+  IdPortalType BinEnds;
+
+  VTKM_CONT_EXPORT
+  PointLocatorUniformGridExec(const PointLocatorGrid &grid,
+                              const PointPortalType &sortedPoints,
+                              const IdPortalType &sortedPointIds,
+                              const IdPortalType &binStarts,
+                              const IdPortalType &binEnds)
+    : Grid(grid),
+      SortedPoints(sortedPoints),
+      SortedPointIds(sortedPointIds),
+      BinStarts(binStarts),
+      BinEnds(binEnds) {  }
+
+  // Searches bins first through last of row (j,k), whose points are
+  // consecutive in the sorted order, unless the row is farther away than the
+  // nearest point found. gapYZ2 is the squared distance to the row in y and
+  // z.
+  VTKM_EXEC_EXPORT
+  void SearchRow(vtkm::Id first,
+                 vtkm::Id last,
+                 vtkm::Id j,
+                 vtkm::Id k,
+                 vtkm::FloatDefault gapYZ2,
+                 const PointType &query,
+                 vtkm::Id &nearestId,
+                 vtkm::FloatDefault &nearestDistance2) const
+  {
+    vtkm::FloatDefault gapX = this->Grid.GetGap(0, first, last, query[0]);
+    if ((nearestId >= 0) && (gapX*gapX + gapYZ2 > nearestDistance2))
+    {
+      return;
+    }
+    vtkm::Id end = this->BinEnds.Get(this->Grid.GetFlatIndex(last, j, k));
+    for (vtkm::Id entry =
+           this->BinStarts.Get(this->Grid.GetFlatIndex(first, j, k));
+         entry < end;
+         entry++)
+    {
+      vtkm::FloatDefault distance2 =
+          Distance2(query, this->SortedPoints.Get(entry));
+      vtkm::Id pointId = this->SortedPointIds.Get(entry);
+      if ((nearestId < 0)
+          || (distance2 < nearestDistance2)
+          || ((distance2 == nearestDistance2) && (pointId < nearestId)))
+      {
+        nearestId = pointId;
+        nearestDistance2 = distance2;
+      }
+    }
+  }
+
+  /// Finds the point nearest to \p queryPoint, giving the smallest index
+  /// among points at the same distance. The bins are searched in shells of
+  /// growing size around the bin of the query, stopping when the nearest
+  /// point found is closer than the sides of the searched block. Rows of
+  /// bins farther than the nearest point so far are skipped. The id is -1
+  /// if there are no points.
+  ///
+  template<typename T>
+  VTKM_EXEC_EXPORT
+  void FindNearestNeighbor(const vtkm::Vec<T,3> &queryPoint,
+                           vtkm::Id &nearestId,
+                           vtkm::FloatDefault &nearestDistance2) const
+  {
+    const PointType query = PointLocatorToPoint(queryPoint);
+    const vtkm::Id3 &divisions = this->Grid.Divisions;
+    const vtkm::Id3 center = this->Grid.GetBinIndex(query);
+    nearestId = -1;
+    nearestDistance2 = vtkm::FloatDefault(0);
+    if (this->SortedPoints.GetNumberOfValues() < 1)
+    {
+      return;
+    }
+
+    for (vtkm::Id shell = 0; ; shell++)
+    {
+      vtkm::Id3 low = center - vtkm::Id3(shell);
+      vtkm::Id3 high = center + vtkm::Id3(shell);
+      vtkm::Id3 first;
+      vtkm::Id3 last;
+      for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+      {
+        first[axis] = (low[axis] > 0) ? low[axis] : 0;
+        last[axis] = (high[axis] < divisions[axis] - 1)
+            ? high[axis] : divisions[axis] - 1;
+      }
+
+      for (vtkm::Id k = first[2]; k <= last[2]; k++)
+      {
+        vtkm::FloatDefault gapZ = this->Grid.GetGap(2, k, k, query[2]);
+        for (vtkm::Id j = first[1]; j <= last[1]; j++)
+        {
+          vtkm::FloatDefault gapY = this->Grid.GetGap(1, j, j, query[1]);
+          vtkm::FloatDefault gapYZ2 = gapY*gapY + gapZ*gapZ;
+          if ((k == low[2]) || (k == high[2]) ||
+              (j == low[1]) || (j == high[1]))
+          {
+            this->SearchRow(first[0], last[0], j, k, gapYZ2,
+                            query, nearestId, nearestDistance2);
+          }
+          else
+          {
+            // Inside the shell in y and z, so only its two x sides.
+            if (low[0] >= 0)
+            {
+              this->SearchRow(low[0], low[0], j, k, gapYZ2,
+                              query, nearestId, nearestDistance2);
+            }
+            if (high[0] < divisions[0])
+            {
+              this->SearchRow(high[0], high[0], j, k, gapYZ2,
+                              query, nearestId, nearestDistance2);
+            }
+          }
+        }
+      }
+
+      // Points in bins not yet searched are beyond a side of the block.
+      bool allSearched = true;
+      vtkm::FloatDefault gap = vtkm::FloatDefault(0);
+      for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+      {
+        if (low[axis] > 0)
+        {
+          vtkm::FloatDefault sideGap =
+              query[axis] - this->Grid.GetBinEdge(axis, low[axis]);
+          gap = (allSearched || (sideGap < gap)) ? sideGap : gap;
+          allSearched = false;
+        }
+        if (high[axis] < divisions[axis] - 1)
+        {
+          vtkm::FloatDefault sideGap =
+              this->Grid.GetBinEdge(axis, high[axis] + 1) - query[axis];
+          gap = (allSearched || (sideGap < gap)) ? sideGap : gap;
+          allSearched = false;
+        }
+      }
+      if (allSearched ||
+          ((nearestId >= 0) && (gap > 0) && (gap*gap > nearestDistance2)))
+      {
+        return;
+      }
+    }
+  }
+
+  /// Calls \p visitor with the id and squared distance of each point within
+  /// \p radius of \p queryPoint. Only the rows of bins overlapping the
+  /// sphere are searched. Points are visited in bin order.
+  ///
+  template<typename T, typename VisitorType>
+  VTKM_EXEC_EXPORT
+  void VisitInRadius(const vtkm::Vec<T,3> &queryPoint,
+                     vtkm::FloatDefault radius,
+                     VisitorType &visitor) const
+  {
+    const PointType query = PointLocatorToPoint(queryPoint);
+    const vtkm::Id3 first = this->Grid.GetBinIndex(query - PointType(radius));
+    const vtkm::Id3 last = this->Grid.GetBinIndex(query + PointType(radius));
+    const vtkm::FloatDefault radius2 = radius*radius;
+    for (vtkm::Id k = first[2]; k <= last[2]; k++)
+    {
+      vtkm::FloatDefault gapZ = this->Grid.GetGap(2, k, k, query[2]);
+      for (vtkm::Id j = first[1]; j <= last[1]; j++)
+      {
+        vtkm::FloatDefault gapY = this->Grid.GetGap(1, j, j, query[1]);
+        if (gapY*gapY + gapZ*gapZ > radius2)
+        {
+          continue;
+        }
+        // The points of the bins along a row are consecutive.
+        vtkm::Id end =
+            this->BinEnds.Get(this->Grid.GetFlatIndex(last[0], j, k));
+        for (vtkm::Id entry =
+               this->BinStarts.Get(this->Grid.GetFlatIndex(first[0], j, k));
+             entry < end;
+             entry++)
+        {
+          vtkm::FloatDefault distance2 =
+              Distance2(query, this->SortedPoints.Get(entry));
+          if (distance2 <= radius2)
+          {
+            visitor(this->SortedPointIds.Get(entry), distance2);
+          }
+        }
+      }
+    }
+  }
+};
+
+// Writes a key for each point that sorts by bin and then by point index.
+template<typename PointPortalType, typename KeyPortalType>
+struct PointLocatorKeyKernel : public vtkm::exec::FunctorBase
+{
+  PointPortalType Points;
+  KeyPortalType Keys;
+  PointLocatorGrid Grid;
+
+  VTKM_CONT_EXPORT
+  PointLocatorKeyKernel(const PointPortalType &points,
+                        const KeyPortalType &keys,
+                        const PointLocatorGrid &grid)
+    : Points(points), Keys(keys), Grid(grid) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id3 bin =
+        this->Grid.GetBinIndex(PointLocatorToPoint(this->Points.Get(index)));
+    vtkm::Int64 numPoints =
+        static_cast<vtkm::Int64>(this->Points.GetNumberOfValues());
+    this->Keys.Set(index,
+                   static_cast<vtkm::Int64>(
+                     this->Grid.GetFlatIndex(bin[0], bin[1], bin[2]))
+                   *numPoints + static_cast<vtkm::Int64>(index));
+  }
+};
+
+// Splits the sorted keys into the bin and the index of each point, and
+// gathers the points in that order.
+template<typename KeyPortalType,
+         typename InputPointPortalType,
+         typename IdPortalType,
+         typename PointPortalType>
+struct PointLocatorSplitKernel : public vtkm::exec::FunctorBase
+{
+  KeyPortalType Keys;
+  InputPointPortalType InputPoints;
+  IdPortalType BinIds;
+  IdPortalType PointIds;
+  PointPortalType Points;
+
+  VTKM_CONT_EXPORT
+  PointLocatorSplitKernel(const KeyPortalType &keys,
+                          const InputPointPortalType &inputPoints,
+                          const IdPortalType &binIds,
+                          const IdPortalType &pointIds,
+                          const PointPortalType &points)
+    : Keys(keys),
+      InputPoints(inputPoints),
+      BinIds(binIds),
+      PointIds(pointIds),
+      Points(points) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Int64 numPoints =
+        static_cast<vtkm::Int64>(this->Keys.GetNumberOfValues());
+    vtkm::Int64 key = this->Keys.Get(index);
+    vtkm::Id pointId = static_cast<vtkm::Id>(key % numPoints);
+    this->BinIds.Set(index, static_cast<vtkm::Id>(key / numPoints));
+    this->PointIds.Set(index, pointId);
+    this->Points.Set(index,
+                     PointLocatorToPoint(this->InputPoints.Get(pointId)));
+  }
+};
+
+template<typename LocatorType,
+         typename QueryPortalType,
+         typename IdPortalType,
+         typename DistancePortalType>
+struct PointLocatorNearestKernel : public vtkm::exec::FunctorBase
+{
+  LocatorType Locator;
+  QueryPortalType Queries;
+  IdPortalType NearestIds;
+  DistancePortalType Distances2;
+
+  VTKM_CONT_EXPORT
+  PointLocatorNearestKernel(const LocatorType &locator,
+                            const QueryPortalType &queries,
+                            const IdPortalType &nearestIds,
+                            const DistancePortalType &distances2)
+    : Locator(locator),
+      Queries(queries),
+      NearestIds(nearestIds),
+      Distances2(distances2) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id nearestId;
+    vtkm::FloatDefault distance2;
+    this->Locator.FindNearestNeighbor(this->Queries.Get(index),
+                                      nearestId,
+                                      distance2);
+    this->NearestIds.Set(index, nearestId);
+    this->Distances2.Set(index, distance2);
+  }
+};
+
+} // namespace internal
+
+/// \brief Finds points near query positions using a uniform grid of bins.
+///
+/// Build divides the bounds of the points into bins and sorts the points by
+/// bin with a single sort of 64-bit keys made of the bin and the point
+/// index. LowerBounds and UpperBounds of the sorted bins against a counting
+/// array give the range of each bin, including empty ones, so construction
+/// is the O(n log n) device sort plus linear passes. The points are kept in
+/// sorted order so that the points of a bin are contiguous.
+///
+/// Queries run in parallel with Schedule and look only at the bins near the
+/// query: nearest neighbor searches shells of bins until no unsearched bin
+/// can hold a closer point, and radius searches visit the bins overlapping
+/// the box around the sphere. PrepareForInput gives the execution object
+/// so other kernels can make these queries themselves.
+///
+/// Points are stored with vtkm::FloatDefault components, and distances are
+/// returned squared.
+///
+template<typename DeviceAdapterTag>
+class PointLocatorUniformGrid
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+  typedef internal::PointLocatorUniformGridExec<
+      typename vtkm::cont::ArrayHandle<PointType>
+          ::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
+      typename vtkm::cont::ArrayHandle<vtkm::Id>
+          ::template ExecutionTypes<DeviceAdapterTag>::PortalConst>
+      ExecObjectType;
+
+  VTKM_CONT_EXPORT
+  PointLocatorUniformGrid(const vtkm::Id3 &divisions)
+    : Divisions(divisions) {  }
+
+  VTKM_CONT_EXPORT
+  const vtkm::Id3 &GetDivisions() const { return this->Divisions; }
+
+  /// Bins \p points over \p bounds. Points outside the bounds are put in
+  /// the nearest bin.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Build(const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &points,
+             const vtkm::Bounds &bounds)
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        InputPointPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Int64>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal KeyPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Int64>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        KeyPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<PointType>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal PointPortalType;
+
+    if ((this->Divisions[0] < 1)
+        || (this->Divisions[1] < 1)
+        || (this->Divisions[2] < 1))
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Point locator needs at least one division on each axis.");
+    }
+
+    vtkm::Id numPoints = points.GetNumberOfValues();
+    this->Grid = internal::PointLocatorGrid(this->Divisions, bounds);
+    vtkm::Id numBins = this->Grid.GetNumberOfBins();
+    if ((numPoints > 0)
+        && (static_cast<vtkm::Int64>(numBins)
+            > std::numeric_limits<vtkm::Int64>::max()/numPoints))
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Too many point locator bins for the number of points.");
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Int64> keys;
+    Algorithm::Schedule(
+          internal::PointLocatorKeyKernel<InputPointPortalType,KeyPortalType>(
+            points.PrepareForInput(DeviceAdapterTag()),
+            keys.PrepareForOutput(numPoints, DeviceAdapterTag()),
+            this->Grid),
+          numPoints);
+    Algorithm::Sort(keys);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> binIds;
+    Algorithm::Schedule(
+          internal::PointLocatorSplitKernel<
+              KeyPortalConstType,
+              InputPointPortalType,
+              IdPortalType,
+              PointPortalType>(
+            keys.PrepareForInput(DeviceAdapterTag()),
+            points.PrepareForInput(DeviceAdapterTag()),
+            binIds.PrepareForOutput(numPoints, DeviceAdapterTag()),
+            this->SortedPointIds.PrepareForOutput(numPoints,
+                                                  DeviceAdapterTag()),
+            this->SortedPoints.PrepareForOutput(numPoints,
+                                                DeviceAdapterTag())),
+          numPoints);
+    keys.ReleaseResources();
+
+    vtkm::cont::ArrayHandleCounting<vtkm::Id> bins =
+        vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), numBins);
+    Algorithm::LowerBounds(binIds, bins, this->BinStarts);
+    Algorithm::UpperBounds(binIds, bins, this->BinEnds);
+  }
+
+  /// Bins \p points over their own bounds.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Build(const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &points)
+  {
+    this->Build(points, vtkm::cont::ComputeBounds(points, DeviceAdapterTag()));
+  }
+
+  /// Returns an object that answers queries in the execution environment.
+  ///
+  VTKM_CONT_EXPORT
+  ExecObjectType PrepareForInput() const
+  {
+    return ExecObjectType(
+          this->Grid,
+          this->SortedPoints.PrepareForInput(DeviceAdapterTag()),
+          this->SortedPointIds.PrepareForInput(DeviceAdapterTag()),
+          this->BinStarts.PrepareForInput(DeviceAdapterTag()),
+          this->BinEnds.PrepareForInput(DeviceAdapterTag()));
+  }
+
+  /// Finds the nearest point to each of \p queryPoints and the squared
+  /// distance to it. The id is -1 if the locator has no points.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void FindNearestNeighbor(
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &queryPoints,
+      vtkm::cont::ArrayHandle<vtkm::Id> &nearestIds,
+      vtkm::cont::ArrayHandle<vtkm::FloatDefault> &distances2) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        QueryPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::FloatDefault>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal
+        DistancePortalType;
+
+    vtkm::Id numQueries = queryPoints.GetNumberOfValues();
+    Algorithm::Schedule(
+          internal::PointLocatorNearestKernel<
+              ExecObjectType,
+              QueryPortalType,
+              IdPortalType,
+              DistancePortalType>(
+            this->PrepareForInput(),
+            queryPoints.PrepareForInput(DeviceAdapterTag()),
+            nearestIds.PrepareForOutput(numQueries, DeviceAdapterTag()),
+            distances2.PrepareForOutput(numQueries, DeviceAdapterTag())),
+          numQueries);
+  }
+
+  /// Finds the points within \p radius of each of \p queryPoints. The
+  /// neighbors of query q are entries offsets[q] to offsets[q]+counts[q] of
+  /// \p neighborIds. The points are counted in a first pass and written in
+  /// a second, after an exclusive scan of the counts.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void FindInRadius(
+      const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &queryPoints,
+      vtkm::FloatDefault radius,
+      vtkm::cont::ArrayHandle<vtkm::Id> &counts,
+      vtkm::cont::ArrayHandle<vtkm::Id> &offsets,
+      vtkm::cont::ArrayHandle<vtkm::Id> &neighborIds) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        QueryPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+    typedef typename vtkm::cont::ArrayHandleCounting<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        OrderPortalType;
+
+    if (radius < 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Point locator search radius is negative.");
+    }
+
+    vtkm::Id numQueries = queryPoints.GetNumberOfValues();
+    vtkm::cont::ArrayHandleCounting<vtkm::Id> order =
+        vtkm::cont::make_ArrayHandleCounting(vtkm::Id(0), numQueries);
+    ExecObjectType locator = this->PrepareForInput();
+    Algorithm::Schedule(
+          internal::PointLocatorRadiusCountKernel<
+              ExecObjectType,QueryPortalType,OrderPortalType,IdPortalType>(
+            locator,
+            queryPoints.PrepareForInput(DeviceAdapterTag()),
+            order.PrepareForInput(DeviceAdapterTag()),
+            radius,
+            counts.PrepareForOutput(numQueries, DeviceAdapterTag())),
+          numQueries);
+    vtkm::Id numNeighbors = Algorithm::ScanExclusive(counts, offsets);
+
+    Algorithm::Schedule(
+          internal::PointLocatorRadiusKernel<
+              ExecObjectType,
+              QueryPortalType,
+              OrderPortalType,
+              IdPortalConstType,
+              IdPortalType>(
+            locator,
+            queryPoints.PrepareForInput(DeviceAdapterTag()),
+            order.PrepareForInput(DeviceAdapterTag()),
+            radius,
+            offsets.PrepareForInput(DeviceAdapterTag()),
+            neighborIds.PrepareForOutput(numNeighbors, DeviceAdapterTag())),
+          numQueries);
+  }
+
+private:
+  vtkm::Id3 Divisions;
+  internal::PointLocatorGrid Grid;
+  vtkm::cont::ArrayHandle<PointType> SortedPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> SortedPointIds;
+  vtkm::cont::ArrayHandle<vtkm::Id> BinStarts;
+  vtkm::cont::ArrayHandle<vtkm::Id> BinEnds;
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_PointLocatorUniformGrid_h
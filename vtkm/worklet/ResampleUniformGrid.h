@@ -0,0 +1,252 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_ResampleUniformGrid_h
+#define vtk_m_worklet_ResampleUniformGrid_h
+
+#include <vtkm/Types.h>
+#include <vtkm/VecTraits.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <vtkm/worklet/CellLocatorUniformBins.h>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+template<typename LocatorType,
+         typename TargetPortalType,
+         typename IdPortalType,
+         typename ParametricPortalType>
+struct ResampleLocateKernel : public vtkm::exec::FunctorBase
+{
+  LocatorType Locator;
+  TargetPortalType Targets;
+  IdPortalType CellIds;
+  ParametricPortalType ParametricCoordinates;
+
+  VTKM_CONT_EXPORT
+  ResampleLocateKernel(const LocatorType &locator,
+                       const TargetPortalType &targets,
+                       const IdPortalType &cellIds,
+                       const ParametricPortalType &parametricCoordinates)
+    : Locator(locator),
+      Targets(targets),
+      CellIds(cellIds),
+      ParametricCoordinates(parametricCoordinates) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    CellLocatorPointType pcoords(vtkm::FloatDefault(0));
+    this->CellIds.Set(index,
+                      this->Locator.FindCell(this->Targets.Get(index),
+                                             pcoords));
+    this->ParametricCoordinates.Set(index, pcoords);
+  }
+};
+
+template<typename LocatorType,
+         typename IdPortalType,
+         typename ParametricPortalType,
+         typename FieldPortalType,
+         typename OutputPortalType>
+struct ResampleInterpolateKernel : public vtkm::exec::FunctorBase
+{
+  typedef typename FieldPortalType::ValueType ValueType;
+
+  LocatorType Locator;
+  IdPortalType CellIds;
+  ParametricPortalType ParametricCoordinates;
+  FieldPortalType Field;
+  ValueType FillValue;
+  OutputPortalType Output;
+
+  VTKM_CONT_EXPORT
+  ResampleInterpolateKernel(const LocatorType &locator,
+                            const IdPortalType &cellIds,
+                            const ParametricPortalType &parametricCoordinates,
+                            const FieldPortalType &field,
+                            const ValueType &fillValue,
+                            const OutputPortalType &output)
+    : Locator(locator),
+      CellIds(cellIds),
+      ParametricCoordinates(parametricCoordinates),
+      Field(field),
+      FillValue(fillValue),
+      Output(output) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id cellId = this->CellIds.Get(index);
+    if (cellId < 0)
+    {
+      this->Output.Set(index, this->FillValue);
+      return;
+    }
+    this->Output.Set(index,
+                     this->Locator.Interpolate(
+                       cellId,
+                       this->ParametricCoordinates.Get(index),
+                       this->Field));
+  }
+};
+
+} // namespace internal
+
+/// \brief Resamples point fields of an unstructured mesh onto the points of
+/// a uniform grid.
+///
+/// Run finds the cell of the mesh containing each target point with a
+/// CellLocatorUniformBins and keeps the cell and the parametric coordinates
+/// of the point in it. Interpolate then evaluates a point field at every
+/// target point from the kept cells alone, so the locator is searched once
+/// no matter how many fields are resampled. For a mesh that does not move,
+/// both the locator and the located points can be kept across time steps,
+/// and each step only interpolates. Target points outside the mesh get a
+/// fill value.
+///
+template<typename DeviceAdapterTag,
+         typename CellSetType = vtkm::cont::CellSetExplicit<> >
+class ResampleUniformGrid
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef vtkm::worklet::CellLocatorUniformBins<DeviceAdapterTag,CellSetType>
+      CellLocatorType;
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+
+  VTKM_CONT_EXPORT
+  ResampleUniformGrid(const CellLocatorType &locator) : Locator(locator) {  }
+
+  /// Finds the cells holding \p targetPoints, which are usually a
+  /// vtkm::cont::ArrayHandleUniformPointCoordinates.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage> &targetPoints)
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        TargetPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<PointType>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal
+        ParametricPortalType;
+
+    vtkm::Id numTargets = targetPoints.GetNumberOfValues();
+    Algorithm::Schedule(
+          internal::ResampleLocateKernel<
+              typename CellLocatorType::ExecObjectType,
+              TargetPortalType,
+              IdPortalType,
+              ParametricPortalType>(
+            this->Locator.PrepareForInput(),
+            targetPoints.PrepareForInput(DeviceAdapterTag()),
+            this->CellIds.PrepareForOutput(numTargets, DeviceAdapterTag()),
+            this->ParametricCoordinates.PrepareForOutput(numTargets,
+                                                         DeviceAdapterTag())),
+          numTargets);
+  }
+
+  /// The cell holding each target point from the last Run, or -1 for
+  /// points outside the mesh.
+  ///
+  VTKM_CONT_EXPORT
+  const vtkm::cont::ArrayHandle<vtkm::Id> &GetCellIds() const
+  {
+    return this->CellIds;
+  }
+
+  /// Interpolates the point field \p field of the mesh to the target points
+  /// of the last Run. Target points outside the mesh get \p fillValue.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Interpolate(const vtkm::cont::ArrayHandle<T,Storage> &field,
+                   const T &fillValue,
+                   vtkm::cont::ArrayHandle<T> &output) const
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<PointType>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        ParametricPortalType;
+    typedef typename vtkm::cont::ArrayHandle<T,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        FieldPortalType;
+    typedef typename vtkm::cont::ArrayHandle<T>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal OutputPortalType;
+
+    if (field.GetNumberOfValues() != this->Locator.GetNumberOfPoints())
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Resampled field does not have a value for each point.");
+    }
+
+    vtkm::Id numTargets = this->CellIds.GetNumberOfValues();
+    Algorithm::Schedule(
+          internal::ResampleInterpolateKernel<
+              typename CellLocatorType::ExecObjectType,
+              IdPortalType,
+              ParametricPortalType,
+              FieldPortalType,
+              OutputPortalType>(
+            this->Locator.PrepareForInput(),
+            this->CellIds.PrepareForInput(DeviceAdapterTag()),
+            this->ParametricCoordinates.PrepareForInput(DeviceAdapterTag()),
+            field.PrepareForInput(DeviceAdapterTag()),
+            fillValue,
+            output.PrepareForOutput(numTargets, DeviceAdapterTag())),
+          numTargets);
+  }
+
+  /// Interpolates \p field as above, with 0 at target points outside the
+  /// mesh.
+  ///
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void Interpolate(const vtkm::cont::ArrayHandle<T,Storage> &field,
+                   vtkm::cont::ArrayHandle<T> &output) const
+  {
+    typedef typename vtkm::VecTraits<T>::ComponentType ComponentType;
+    this->Interpolate(field, T(static_cast<ComponentType>(0)), output);
+  }
+
+private:
+  CellLocatorType Locator;
+  vtkm::cont::ArrayHandle<vtkm::Id> CellIds;
+  vtkm::cont::ArrayHandle<PointType> ParametricCoordinates;
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_ResampleUniformGrid_h
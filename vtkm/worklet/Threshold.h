@@ -0,0 +1,816 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_Threshold_h
+#define vtk_m_worklet_Threshold_h
+
+#include <vtkm/TopologyElementTag.h>
+#include <vtkm/TypeListTag.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DynamicArrayHandle.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/Field.h>
+#include <vtkm/cont/StorageBasic.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+#include <vtkm/cont/internal/ReverseConnectivity.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <string>
+#include <vector>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+// Whether a scalar is in the closed range of a threshold.
+struct ThresholdRange
+{
+  vtkm::Float64 Lower;
+  vtkm::Float64 Upper;
+
+  VTKM_EXEC_CONT_EXPORT
+  ThresholdRange(vtkm::Float64 lower, vtkm::Float64 upper)
+    : Lower(lower), Upper(upper) {  }
+
+  template<typename T>
+  VTKM_EXEC_CONT_EXPORT
+  bool operator()(const T &value) const
+  {
+    vtkm::Float64 scalar = static_cast<vtkm::Float64>(value);
+    return (this->Lower <= scalar) && (scalar <= this->Upper);
+  }
+};
+
+// Whether the point indices of a cell set have to be checked before they
+// index arrays of points. Structured cell sets compute their indices from
+// the extent, so they are always in range.
+template<typename CellSetType>
+struct ThresholdCheckPointIndices : boost::true_type {  };
+
+template<vtkm::IdComponent Dimensions>
+struct ThresholdCheckPointIndices<vtkm::cont::CellSetStructured<Dimensions> >
+    : boost::false_type {  };
+
+// A cell passes if its value is in the range.
+template<typename FieldPortalType, typename PassPortalType>
+struct ThresholdClassifyByCellKernel : public vtkm::exec::FunctorBase
+{
+  FieldPortalType Field;
+  PassPortalType Pass;
+  ThresholdRange Range;
+
+  VTKM_CONT_EXPORT
+  ThresholdClassifyByCellKernel(const FieldPortalType &field,
+                                const PassPortalType &pass,
+                                const ThresholdRange &range)
+    : Field(field), Pass(pass), Range(range) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    this->Pass.Set(cellIndex, this->Range(this->Field.Get(cellIndex)) ? 1 : 0);
+  }
+};
+
+// A cell passes if the values of all its points are in the range. When
+// CheckPoints is set, a point index that is not a point of the cell set
+// raises an error instead of being read.
+template<typename ConnectivityType,
+         typename FieldPortalType,
+         typename PassPortalType>
+struct ThresholdClassifyByPointKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  FieldPortalType Field;
+  PassPortalType Pass;
+  ThresholdRange Range;
+  bool CheckPoints;
+
+  VTKM_CONT_EXPORT
+  ThresholdClassifyByPointKernel(const ConnectivityType &connectivity,
+                                 const FieldPortalType &field,
+                                 const PassPortalType &pass,
+                                 const ThresholdRange &range,
+                                 bool checkPoints)
+    : Connectivity(connectivity),
+      Field(field),
+      Pass(pass),
+      Range(range),
+      CheckPoints(checkPoints) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id cellIndex) const
+  {
+    vtkm::IdComponent numPoints =
+        this->Connectivity.GetNumberOfIndices(cellIndex);
+    vtkm::Id pass = 1;
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < numPoints;
+         pointInCell++)
+    {
+      vtkm::Id pointIndex =
+          this->Connectivity.GetIndex(cellIndex, pointInCell);
+      if (this->CheckPoints
+          && ((pointIndex < 0)
+              || (pointIndex >= this->Field.GetNumberOfValues())))
+      {
+        this->RaiseError("Cell references a point index out of range.");
+        return;
+      }
+      if (!this->Range(this->Field.Get(pointIndex)))
+      {
+        pass = 0;
+        break;
+      }
+    }
+    this->Pass.Set(cellIndex, pass);
+  }
+};
+
+// Marks the points used by the cells that passed. Points shared by several
+// cells are marked by each of them with the same value. Only the points of
+// the cells that passed are used later, so when CheckPoints is set this is
+// where their indices are checked.
+template<typename ConnectivityType,
+         typename CellIdPortalType,
+         typename MaskPortalType>
+struct ThresholdMarkPointsKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  CellIdPortalType CellIds;
+  MaskPortalType PointMask;
+  bool CheckPoints;
+
+  VTKM_CONT_EXPORT
+  ThresholdMarkPointsKernel(const ConnectivityType &connectivity,
+                            const CellIdPortalType &cellIds,
+                            const MaskPortalType &pointMask,
+                            bool checkPoints)
+    : Connectivity(connectivity),
+      CellIds(cellIds),
+      PointMask(pointMask),
+      CheckPoints(checkPoints) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id cellIndex = this->CellIds.Get(index);
+    vtkm::IdComponent numPoints =
+        this->Connectivity.GetNumberOfIndices(cellIndex);
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < numPoints;
+         pointInCell++)
+    {
+      vtkm::Id pointIndex =
+          this->Connectivity.GetIndex(cellIndex, pointInCell);
+      if (this->CheckPoints
+          && ((pointIndex < 0)
+              || (pointIndex >= this->PointMask.GetNumberOfValues())))
+      {
+        this->RaiseError("Cell references a point index out of range.");
+        return;
+      }
+      this->PointMask.Set(pointIndex, 1);
+    }
+  }
+};
+
+// Copies the shape and number of points of each cell that passed.
+template<typename ConnectivityType,
+         typename CellIdPortalType,
+         typename ShapePortalType,
+         typename NumIndicesPortalType>
+struct ThresholdCellShapesKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  CellIdPortalType CellIds;
+  ShapePortalType Shapes;
+  NumIndicesPortalType NumIndices;
+
+  VTKM_CONT_EXPORT
+  ThresholdCellShapesKernel(const ConnectivityType &connectivity,
+                            const CellIdPortalType &cellIds,
+                            const ShapePortalType &shapes,
+                            const NumIndicesPortalType &numIndices)
+    : Connectivity(connectivity),
+      CellIds(cellIds),
+      Shapes(shapes),
+      NumIndices(numIndices) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id cellIndex = this->CellIds.Get(index);
+    this->Shapes.Set(index, static_cast<vtkm::UInt8>(
+                       this->Connectivity.GetCellShape(cellIndex)));
+    this->NumIndices.Set(index,
+                         this->Connectivity.GetNumberOfIndices(cellIndex));
+  }
+};
+
+// Writes the points of each cell that passed, renumbered to the points that
+// are kept.
+template<typename ConnectivityType,
+         typename CellIdPortalType,
+         typename OffsetPortalType,
+         typename PointMapPortalType,
+         typename OutputPortalType>
+struct ThresholdConnectivityKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityType Connectivity;
+  CellIdPortalType CellIds;
+  OffsetPortalType Offsets;
+  PointMapPortalType PointMap;
+  OutputPortalType Output;
+
+  VTKM_CONT_EXPORT
+  ThresholdConnectivityKernel(const ConnectivityType &connectivity,
+                              const CellIdPortalType &cellIds,
+                              const OffsetPortalType &offsets,
+                              const PointMapPortalType &pointMap,
+                              const OutputPortalType &output)
+    : Connectivity(connectivity),
+      CellIds(cellIds),
+      Offsets(offsets),
+      PointMap(pointMap),
+      Output(output) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id cellIndex = this->CellIds.Get(index);
+    vtkm::Id offset = this->Offsets.Get(index);
+    vtkm::IdComponent numPoints =
+        this->Connectivity.GetNumberOfIndices(cellIndex);
+    for (vtkm::IdComponent pointInCell = 0;
+         pointInCell < numPoints;
+         pointInCell++)
+    {
+      this->Output.Set(offset + pointInCell,
+                       this->PointMap.Get(
+                         this->Connectivity.GetIndex(cellIndex, pointInCell)));
+    }
+  }
+};
+
+/// Storage tried when resolving coordinate systems, which are often uniform.
+///
+struct ThresholdCoordinatesStorageList
+    : vtkm::ListTagBase<
+        vtkm::cont::StorageTagBasic,
+        vtkm::cont::ArrayHandleUniformPointCoordinates::StorageTag>
+{  };
+
+/// One array gathered by ThresholdFieldGather: the execution portals of the
+/// input array and of the output array it is gathered into.
+///
+template<typename T, typename DeviceAdapterTag>
+struct ThresholdGatherEntry
+{
+  typedef typename vtkm::cont::ArrayHandle<T>
+      ::template ExecutionTypes<DeviceAdapterTag>::PortalConst InputPortalType;
+  typedef typename vtkm::cont::ArrayHandle<T>
+      ::template ExecutionTypes<DeviceAdapterTag>::Portal OutputPortalType;
+
+  InputPortalType Input;
+  OutputPortalType Output;
+
+  VTKM_EXEC_CONT_EXPORT
+  ThresholdGatherEntry() {  }
+
+  VTKM_CONT_EXPORT
+  ThresholdGatherEntry(const InputPortalType &input,
+                       const OutputPortalType &output)
+    : Input(input), Output(output) {  }
+};
+
+// Copies the values at the given indices of every array of a batch. Each
+// instance reads its index once for all the arrays.
+template<typename IdPortalType, typename EntryPortalType>
+struct ThresholdGatherKernel : public vtkm::exec::FunctorBase
+{
+  IdPortalType Ids;
+  EntryPortalType Entries;
+
+  VTKM_CONT_EXPORT
+  ThresholdGatherKernel(const IdPortalType &ids,
+                        const EntryPortalType &entries)
+    : Ids(ids), Entries(entries) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id sourceIndex = this->Ids.Get(index);
+    vtkm::Id numEntries = this->Entries.GetNumberOfValues();
+    for (vtkm::Id entryIndex = 0; entryIndex < numEntries; entryIndex++)
+    {
+      typename EntryPortalType::ValueType entry =
+          this->Entries.Get(entryIndex);
+      entry.Output.Set(index, entry.Input.Get(sourceIndex));
+    }
+  }
+};
+
+// The arrays of one value type that ThresholdFieldGather fills together.
+template<typename DeviceAdapterTag>
+struct ThresholdGatherBatchBase
+{
+  virtual ~ThresholdGatherBatchBase() {  }
+  virtual void Execute(const vtkm::cont::ArrayHandle<vtkm::Id> &ids) = 0;
+};
+
+template<typename T, typename DeviceAdapterTag>
+struct ThresholdGatherBatch : public ThresholdGatherBatchBase<DeviceAdapterTag>
+{
+  typedef ThresholdGatherEntry<T,DeviceAdapterTag> EntryType;
+
+  std::vector<EntryType> Entries;
+
+  VTKM_CONT_EXPORT
+  virtual void Execute(const vtkm::cont::ArrayHandle<vtkm::Id> &ids)
+  {
+    vtkm::Id numIds = ids.GetNumberOfValues();
+    if (this->Entries.empty() || (numIds < 1)) { return; }
+
+    vtkm::cont::ArrayHandle<EntryType> entries =
+        vtkm::cont::make_ArrayHandle(this->Entries);
+    vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          ThresholdGatherKernel<
+            typename vtkm::cont::ArrayHandle<vtkm::Id>
+              ::template ExecutionTypes<DeviceAdapterTag>::PortalConst,
+            typename vtkm::cont::ArrayHandle<EntryType>
+              ::template ExecutionTypes<DeviceAdapterTag>::PortalConst>(
+            ids.PrepareForInput(DeviceAdapterTag()),
+            entries.PrepareForInput(DeviceAdapterTag())),
+          numIds);
+    this->Entries.clear();
+  }
+};
+
+/// \brief Gathers the values at a list of indices from many arrays at once.
+///
+/// Arrays are added one at a time, and each Add returns the (not yet filled)
+/// output array. Execute then fills the arrays in basic storage with one
+/// pass over the indices for each value type, which copies the values of
+/// every array of that type. Arrays in other storage (such as implicit
+/// coordinates) are gathered through an ArrayHandlePermutation when they
+/// are added.
+///
+template<typename DeviceAdapterTag>
+class ThresholdFieldGather
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+  typedef boost::shared_ptr<ThresholdGatherBatchBase<DeviceAdapterTag> >
+      BatchPointer;
+
+public:
+  VTKM_CONT_EXPORT
+  ThresholdFieldGather(const vtkm::cont::ArrayHandle<vtkm::Id> &ids)
+    : Ids(ids) {  }
+
+  template<typename TypeList, typename StorageList>
+  VTKM_CONT_EXPORT
+  vtkm::cont::DynamicArrayHandle
+  Add(const vtkm::cont::DynamicArrayHandle &array, TypeList, StorageList)
+  {
+    vtkm::cont::DynamicArrayHandle result;
+    array.CastAndCall(AddFunctor(this, &result), TypeList(), StorageList());
+    return result;
+  }
+
+  VTKM_CONT_EXPORT
+  void Execute()
+  {
+    for (std::size_t index = 0; index < this->Batches.size(); index++)
+    {
+      this->Batches[index]->Execute(this->Ids);
+    }
+    this->Batches.clear();
+  }
+
+private:
+  vtkm::cont::ArrayHandle<vtkm::Id> Ids;
+  std::vector<BatchPointer> Batches;
+
+  template<typename T>
+  VTKM_CONT_EXPORT
+  ThresholdGatherBatch<T,DeviceAdapterTag> &GetBatch()
+  {
+    for (std::size_t index = 0; index < this->Batches.size(); index++)
+    {
+      ThresholdGatherBatch<T,DeviceAdapterTag> *batch =
+          dynamic_cast<ThresholdGatherBatch<T,DeviceAdapterTag> *>(
+            this->Batches[index].get());
+      if (batch != NULL) { return *batch; }
+    }
+    ThresholdGatherBatch<T,DeviceAdapterTag> *batch =
+        new ThresholdGatherBatch<T,DeviceAdapterTag>;
+    this->Batches.push_back(BatchPointer(batch));
+    return *batch;
+  }
+
+  struct AddFunctor
+  {
+    ThresholdFieldGather *Self;
+    vtkm::cont::DynamicArrayHandle *Result;
+
+    VTKM_CONT_EXPORT
+    AddFunctor(ThresholdFieldGather *self,
+               vtkm::cont::DynamicArrayHandle *result)
+      : Self(self), Result(result) {  }
+
+    template<typename T>
+    VTKM_CONT_EXPORT
+    void operator()(
+        const vtkm::cont::ArrayHandle<T,vtkm::cont::StorageTagBasic> &array)
+        const
+    {
+      vtkm::Id numIds = this->Self->Ids.GetNumberOfValues();
+      vtkm::cont::ArrayHandle<T> output;
+      typename ThresholdGatherEntry<T,DeviceAdapterTag>::OutputPortalType
+          outputPortal = output.PrepareForOutput(numIds, DeviceAdapterTag());
+      *this->Result = vtkm::cont::DynamicArrayHandle(output);
+      if (numIds < 1) { return; }
+
+      this->Self->template GetBatch<T>().Entries.push_back(
+            ThresholdGatherEntry<T,DeviceAdapterTag>(
+              array.PrepareForInput(DeviceAdapterTag()), outputPortal));
+    }
+
+    template<typename T, typename Storage>
+    VTKM_CONT_EXPORT
+    void operator()(const vtkm::cont::ArrayHandle<T,Storage> &array) const
+    {
+      vtkm::cont::ArrayHandle<T> output;
+      Algorithm::Copy(
+            vtkm::cont::make_ArrayHandlePermutation(this->Self->Ids, array),
+            output);
+      *this->Result = vtkm::cont::DynamicArrayHandle(output);
+    }
+  };
+};
+
+template<typename ThresholdType, typename CellSetType>
+struct ThresholdRunFunctor
+{
+  ThresholdType *Self;
+  const CellSetType *CellSet;
+  vtkm::cont::Field::AssociationEnum Association;
+
+  VTKM_CONT_EXPORT
+  ThresholdRunFunctor(ThresholdType *self,
+                      const CellSetType *cellSet,
+                      vtkm::cont::Field::AssociationEnum association)
+    : Self(self), CellSet(cellSet), Association(association) {  }
+
+  template<typename T, typename Storage>
+  VTKM_CONT_EXPORT
+  void operator()(const vtkm::cont::ArrayHandle<T,Storage> &field) const
+  {
+    this->Self->Run(*this->CellSet, field, this->Association);
+  }
+};
+
+} // namespace internal
+
+/// \brief Extracts the cells whose scalar values are in a range.
+///
+/// A cell passes when its value (for a cell field) or the values of all its
+/// points (for a point field) are in the closed range [lower, upper]. The
+/// cells are classified in one pass, and the indices of the cells that pass
+/// are found with StreamCompact. A second pass marks the points those cells
+/// use; an exclusive scan of the marks renumbers the points that are kept,
+/// and StreamCompact of the marks lists them. The output is a
+/// CellSetExplicit that refers to the kept points by their new indices.
+///
+/// The lists of kept cells and kept points map the output back to the
+/// input, so any array can be carried over. The version of Run that takes a
+/// DataSet does this for all its coordinate systems and fields.
+///
+template<typename DeviceAdapterTag>
+class Threshold
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  typedef vtkm::cont::CellSetExplicit<> OutputCellSetType;
+
+  VTKM_CONT_EXPORT
+  Threshold(vtkm::Float64 lower, vtkm::Float64 upper)
+    : Lower(lower), Upper(upper), OutputCellSet(new OutputCellSetType) {  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetLower() const { return this->Lower; }
+
+  VTKM_CONT_EXPORT
+  vtkm::Float64 GetUpper() const { return this->Upper; }
+
+  /// Thresholds \p cellSet by the scalar \p field, which is associated with
+  /// either its points (ASSOC_POINTS) or its cells (ASSOC_CELL_SET). Any cell
+  /// set whose point to cell connectivity gives GetCellShape,
+  /// GetNumberOfIndices, and GetIndex can be used. The result is available
+  /// from GetOutputCellSet, GetValidCellIds, and GetValidPointIds. Throws
+  /// ErrorExecution if a cell that is classified by its points, or that
+  /// passes, uses a point index that is not a point of \p cellSet. The
+  /// indices of a CellSetStructured are always in range and are not checked.
+  ///
+  template<typename CellSetType, typename ValueType, typename Storage>
+  VTKM_CONT_EXPORT
+  void Run(const CellSetType &cellSet,
+           const vtkm::cont::ArrayHandle<ValueType,Storage> &field,
+           vtkm::cont::Field::AssociationEnum association)
+  {
+    typedef typename CellSetType::template ExecutionTypes<
+        DeviceAdapterTag,
+        vtkm::TopologyElementTagPoint,
+        vtkm::TopologyElementTagCell>::ExecObjectType ConnectivityType;
+    typedef typename vtkm::cont::ArrayHandle<ValueType,Storage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        FieldPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+
+    vtkm::Id numCells = cellSet.GetNumberOfCells();
+    vtkm::Id numPoints = cellSet.GetNumberOfPoints();
+    ConnectivityType connectivity =
+        cellSet.PrepareForInput(DeviceAdapterTag(),
+                                vtkm::TopologyElementTagPoint(),
+                                vtkm::TopologyElementTagCell());
+    const bool checkPoints =
+        internal::ThresholdCheckPointIndices<CellSetType>::value;
+    internal::ThresholdRange range(this->Lower, this->Upper);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> passFlags;
+    if (association == vtkm::cont::Field::ASSOC_CELL_SET)
+    {
+      if (field.GetNumberOfValues() != numCells)
+      {
+        throw vtkm::cont::ErrorControlBadValue(
+              "Threshold cell field does not have a value for every cell.");
+      }
+      Algorithm::Schedule(
+            internal::ThresholdClassifyByCellKernel<
+              FieldPortalType,IdPortalType>(
+              field.PrepareForInput(DeviceAdapterTag()),
+              passFlags.PrepareForOutput(numCells, DeviceAdapterTag()),
+              range),
+            numCells);
+    }
+    else if (association == vtkm::cont::Field::ASSOC_POINTS)
+    {
+      if (field.GetNumberOfValues() != numPoints)
+      {
+        throw vtkm::cont::ErrorControlBadValue(
+              "Threshold point field does not have a value for every point.");
+      }
+      Algorithm::Schedule(
+            internal::ThresholdClassifyByPointKernel<
+              ConnectivityType,FieldPortalType,IdPortalType>(
+              connectivity,
+              field.PrepareForInput(DeviceAdapterTag()),
+              passFlags.PrepareForOutput(numCells, DeviceAdapterTag()),
+              range,
+              checkPoints),
+            numCells);
+    }
+    else
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Threshold field must be associated with points or cells.");
+    }
+
+    Algorithm::StreamCompact(passFlags, this->ValidCellIds);
+    passFlags.ReleaseResources();
+    vtkm::Id numValidCells = this->ValidCellIds.GetNumberOfValues();
+
+    vtkm::cont::ArrayHandle<vtkm::Id> pointMask;
+    Algorithm::Copy(vtkm::cont::make_ArrayHandleConstant(vtkm::Id(0),
+                                                         numPoints),
+                    pointMask);
+    Algorithm::Schedule(
+          internal::ThresholdMarkPointsKernel<
+            ConnectivityType,IdPortalConstType,IdPortalType>(
+            connectivity,
+            this->ValidCellIds.PrepareForInput(DeviceAdapterTag()),
+            pointMask.PrepareForInPlace(DeviceAdapterTag()),
+            checkPoints),
+          numValidCells);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> pointMap;
+    vtkm::Id numValidPoints = Algorithm::ScanExclusive(pointMask, pointMap);
+    Algorithm::StreamCompact(pointMask, this->ValidPointIds);
+    pointMask.ReleaseResources();
+
+    typename OutputCellSetType::ShapeArrayType shapes;
+    typename OutputCellSetType::NumIndicesArrayType numIndices;
+    Algorithm::Schedule(
+          internal::ThresholdCellShapesKernel<
+            ConnectivityType,
+            IdPortalConstType,
+            typename OutputCellSetType::ShapeArrayType
+              ::template ExecutionTypes<DeviceAdapterTag>::Portal,
+            typename OutputCellSetType::NumIndicesArrayType
+              ::template ExecutionTypes<DeviceAdapterTag>::Portal>(
+            connectivity,
+            this->ValidCellIds.PrepareForInput(DeviceAdapterTag()),
+            shapes.PrepareForOutput(numValidCells, DeviceAdapterTag()),
+            numIndices.PrepareForOutput(numValidCells, DeviceAdapterTag())),
+          numValidCells);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+    vtkm::Id connectivityLength = Algorithm::ScanExclusive(
+          vtkm::cont::make_ArrayHandleTransform<vtkm::Id>(
+            numIndices, vtkm::cont::internal::ConnectivityNumIndicesToId()),
+          offsets);
+    typename OutputCellSetType::ConnectivityArrayType outputConnectivity;
+    Algorithm::Schedule(
+          internal::ThresholdConnectivityKernel<
+            ConnectivityType,
+            IdPortalConstType,
+            IdPortalConstType,
+            IdPortalConstType,
+            IdPortalType>(
+            connectivity,
+            this->ValidCellIds.PrepareForInput(DeviceAdapterTag()),
+            offsets.PrepareForInput(DeviceAdapterTag()),
+            pointMap.PrepareForInput(DeviceAdapterTag()),
+            outputConnectivity.PrepareForOutput(connectivityLength,
+                                                DeviceAdapterTag())),
+          numValidCells);
+
+    this->OutputCellSet.reset(
+          new OutputCellSetType(cellSet.GetName(),
+                                numValidPoints,
+                                cellSet.GetDimensionality()));
+    this->OutputCellSet->Fill(shapes, numIndices, outputConnectivity);
+  }
+
+  /// Thresholds \p cellSet, which must be a cell set of \p input, by the
+  /// field of \p input named \p fieldName and returns a data set with the
+  /// cells that pass. The coordinate systems and point fields are carried
+  /// over to the kept points, and the fields of \p cellSet to the kept
+  /// cells. Whole mesh fields are passed through, and fields of other cell
+  /// sets are dropped.
+  ///
+  template<typename CellSetType>
+  VTKM_CONT_EXPORT
+  vtkm::cont::DataSet Run(const vtkm::cont::DataSet &input,
+                          const CellSetType &cellSet,
+                          const std::string &fieldName)
+  {
+    const vtkm::cont::Field &thresholdField = input.GetField(fieldName);
+    if ((thresholdField.GetAssociation() == vtkm::cont::Field::ASSOC_CELL_SET)
+        && (thresholdField.GetAssocCellSet() != cellSet.GetName()))
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Threshold field is associated with a different cell set.");
+    }
+    thresholdField.GetData().CastAndCall(
+          internal::ThresholdRunFunctor<Threshold,CellSetType>(
+            this, &cellSet, thresholdField.GetAssociation()),
+          vtkm::TypeListTagScalarAll(),
+          VTKM_DEFAULT_STORAGE_LIST_TAG());
+
+    vtkm::cont::DataSet output;
+    output.AddCellSet(this->OutputCellSet);
+
+    vtkm::Id numPoints = cellSet.GetNumberOfPoints();
+    vtkm::Id numCells = cellSet.GetNumberOfCells();
+    internal::ThresholdFieldGather<DeviceAdapterTag>
+        pointGather(this->ValidPointIds);
+    internal::ThresholdFieldGather<DeviceAdapterTag>
+        cellGather(this->ValidCellIds);
+
+    for (vtkm::Id index = 0;
+         index < input.GetNumberOfCoordinateSystems();
+         index++)
+    {
+      const vtkm::cont::CoordinateSystem &coordinates =
+          input.GetCoordinateSystem(index);
+      CheckSize(coordinates, numPoints);
+      output.AddCoordinateSystem(
+            vtkm::cont::CoordinateSystem(
+              coordinates.GetName(),
+              pointGather.Add(
+                coordinates.GetData(),
+                vtkm::TypeListTagFieldVec3(),
+                internal::ThresholdCoordinatesStorageList())));
+    }
+
+    for (vtkm::Id index = 0; index < input.GetNumberOfFields(); index++)
+    {
+      const vtkm::cont::Field &field = input.GetField(index);
+      switch (field.GetAssociation())
+      {
+        case vtkm::cont::Field::ASSOC_POINTS:
+          CheckSize(field, numPoints);
+          output.AddField(
+                vtkm::cont::Field(field.GetName(),
+                                  vtkm::cont::Field::ASSOC_POINTS,
+                                  pointGather.Add(
+                                    field.GetData(),
+                                    VTKM_DEFAULT_TYPE_LIST_TAG(),
+                                    VTKM_DEFAULT_STORAGE_LIST_TAG())));
+          break;
+        case vtkm::cont::Field::ASSOC_CELL_SET:
+          if (field.GetAssocCellSet() == cellSet.GetName())
+          {
+            CheckSize(field, numCells);
+            output.AddField(
+                  vtkm::cont::Field(field.GetName(),
+                                    field.GetAssocCellSet(),
+                                    cellGather.Add(
+                                      field.GetData(),
+                                      VTKM_DEFAULT_TYPE_LIST_TAG(),
+                                      VTKM_DEFAULT_STORAGE_LIST_TAG())));
+          }
+          break;
+        default:
+          output.AddField(field);
+          break;
+      }
+    }
+    pointGather.Execute();
+    cellGather.Execute();
+
+    return output;
+  }
+
+  VTKM_CONT_EXPORT
+  boost::shared_ptr<OutputCellSetType> GetOutputCellSet() const
+  {
+    return this->OutputCellSet;
+  }
+
+  /// The index in the input of each output cell.
+  ///
+  VTKM_CONT_EXPORT
+  const vtkm::cont::ArrayHandle<vtkm::Id> &GetValidCellIds() const
+  {
+    return this->ValidCellIds;
+  }
+
+  /// The index in the input of each output point.
+  ///
+  VTKM_CONT_EXPORT
+  const vtkm::cont::ArrayHandle<vtkm::Id> &GetValidPointIds() const
+  {
+    return this->ValidPointIds;
+  }
+
+private:
+  vtkm::Float64 Lower;
+  vtkm::Float64 Upper;
+  boost::shared_ptr<OutputCellSetType> OutputCellSet;
+  vtkm::cont::ArrayHandle<vtkm::Id> ValidCellIds;
+  vtkm::cont::ArrayHandle<vtkm::Id> ValidPointIds;
+
+  static VTKM_CONT_EXPORT
+  void CheckSize(const vtkm::cont::Field &field, vtkm::Id expectedSize)
+  {
+    if (field.GetData().GetNumberOfValues() != expectedSize)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Field " + field.GetName() + " does not match the cell set.");
+    }
+  }
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_Threshold_h
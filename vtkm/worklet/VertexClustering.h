@@ -0,0 +1,467 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_VertexClustering_h
+#define vtk_m_worklet_VertexClustering_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/internal/DeviceAdapterAlgorithm.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+#include <limits>
+
+namespace vtkm {
+namespace worklet {
+
+namespace internal {
+
+/// The uniform grid of bins that points are clustered into. This is the
+/// inverse of the mapping of ArrayHandleUniformPointCoordinates: it finds
+/// the bin containing a point rather than the point at an index.
+///
+struct VertexClusteringGrid
+{
+  vtkm::Id3 Divisions;
+  vtkm::Vec<vtkm::Float64,3> Origin;
+  vtkm::Vec<vtkm::Float64,3> InverseSpacing;
+
+  VTKM_CONT_EXPORT
+  VertexClusteringGrid(const vtkm::Id3 &divisions, const vtkm::Bounds &bounds)
+    : Divisions(divisions),
+      Origin(bounds.X.Min, bounds.Y.Min, bounds.Z.Min)
+  {
+    const vtkm::Range *ranges[3] = { &bounds.X, &bounds.Y, &bounds.Z };
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      vtkm::Float64 length = ranges[axis]->Length();
+      this->InverseSpacing[axis] = (length > 0.0)
+          ? static_cast<vtkm::Float64>(divisions[axis])/length : 0.0;
+    }
+  }
+
+  VTKM_CONT_EXPORT
+  vtkm::Int64 GetNumberOfBins() const
+  {
+    return static_cast<vtkm::Int64>(this->Divisions[0])
+        * static_cast<vtkm::Int64>(this->Divisions[1])
+        * static_cast<vtkm::Int64>(this->Divisions[2]);
+  }
+
+  template<typename T>
+  VTKM_EXEC_EXPORT
+  vtkm::Int64 GetBin(const vtkm::Vec<T,3> &point) const
+  {
+    vtkm::Int64 bin = 0;
+    for (vtkm::IdComponent axis = 2; axis >= 0; axis--)
+    {
+      vtkm::Float64 offset =
+          (static_cast<vtkm::Float64>(point[axis]) - this->Origin[axis])
+          * this->InverseSpacing[axis];
+      vtkm::Int64 maxIndex =
+          static_cast<vtkm::Int64>(this->Divisions[axis]) - 1;
+      // Points on or outside the bounds go to the nearest bin, and NaN to
+      // the first. The offset is clamped before it is converted because
+      // converting a value that does not fit in an Int64 is undefined.
+      vtkm::Int64 index = 0;
+      if (offset >= static_cast<vtkm::Float64>(maxIndex))
+      {
+        index = maxIndex;
+      }
+      else if (offset > 0.0)
+      {
+        index = static_cast<vtkm::Int64>(offset);
+      }
+      bin = bin*static_cast<vtkm::Int64>(this->Divisions[axis]) + index;
+    }
+    return bin;
+  }
+};
+
+// Writes a key for each point that sorts by bin and then by point index.
+template<typename PointPortalType, typename KeyPortalType>
+struct VertexClusteringKeyKernel : public vtkm::exec::FunctorBase
+{
+  PointPortalType Points;
+  KeyPortalType Keys;
+  VertexClusteringGrid Grid;
+
+  VTKM_CONT_EXPORT
+  VertexClusteringKeyKernel(const PointPortalType &points,
+                            const KeyPortalType &keys,
+                            const VertexClusteringGrid &grid)
+    : Points(points), Keys(keys), Grid(grid) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Int64 numPoints =
+        static_cast<vtkm::Int64>(this->Points.GetNumberOfValues());
+    this->Keys.Set(index,
+                   this->Grid.GetBin(this->Points.Get(index))*numPoints
+                   + static_cast<vtkm::Int64>(index));
+  }
+};
+
+// Flags the first point of each bin in the sorted keys.
+template<typename KeyPortalType, typename FlagPortalType>
+struct VertexClusteringFlagKernel : public vtkm::exec::FunctorBase
+{
+  KeyPortalType Keys;
+  FlagPortalType Flags;
+
+  VTKM_CONT_EXPORT
+  VertexClusteringFlagKernel(const KeyPortalType &keys,
+                             const FlagPortalType &flags)
+    : Keys(keys), Flags(flags) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Int64 numPoints =
+        static_cast<vtkm::Int64>(this->Keys.GetNumberOfValues());
+    bool first = (index == 0)
+        || ((this->Keys.Get(index)/numPoints)
+            != (this->Keys.Get(index-1)/numPoints));
+    this->Flags.Set(index, first ? 1 : 0);
+  }
+};
+
+// Scatters the output point of each sorted key to its input point. The bin
+// numbers are the inclusive scan of the flags, so they start at one.
+template<typename KeyPortalType,
+         typename BinPortalType,
+         typename PointMapPortalType>
+struct VertexClusteringPointMapKernel : public vtkm::exec::FunctorBase
+{
+  KeyPortalType Keys;
+  BinPortalType BinNumbers;
+  PointMapPortalType PointMap;
+
+  VTKM_CONT_EXPORT
+  VertexClusteringPointMapKernel(const KeyPortalType &keys,
+                                 const BinPortalType &binNumbers,
+                                 const PointMapPortalType &pointMap)
+    : Keys(keys), BinNumbers(binNumbers), PointMap(pointMap) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Int64 numPoints =
+        static_cast<vtkm::Int64>(this->Keys.GetNumberOfValues());
+    vtkm::Id pointIndex =
+        static_cast<vtkm::Id>(this->Keys.Get(index) % numPoints);
+    this->PointMap.Set(pointIndex, this->BinNumbers.Get(index) - 1);
+  }
+};
+
+// Averages the points of each occupied bin, which are consecutive in the
+// sorted keys.
+template<typename KeyPortalType,
+         typename StartPortalType,
+         typename PointPortalType,
+         typename OutputPortalType>
+struct VertexClusteringAverageKernel : public vtkm::exec::FunctorBase
+{
+  KeyPortalType Keys;
+  StartPortalType BinStarts;
+  PointPortalType Points;
+  OutputPortalType Output;
+
+  VTKM_CONT_EXPORT
+  VertexClusteringAverageKernel(const KeyPortalType &keys,
+                                const StartPortalType &binStarts,
+                                const PointPortalType &points,
+                                const OutputPortalType &output)
+    : Keys(keys), BinStarts(binStarts), Points(points), Output(output) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id bin) const
+  {
+    typedef typename OutputPortalType::ValueType OutputType;
+    typedef typename OutputType::ComponentType ComponentType;
+
+    vtkm::Id numKeys = this->Keys.GetNumberOfValues();
+    vtkm::Int64 numPoints = static_cast<vtkm::Int64>(numKeys);
+    vtkm::Id start = this->BinStarts.Get(bin);
+    vtkm::Id end = (bin+1 < this->BinStarts.GetNumberOfValues())
+        ? this->BinStarts.Get(bin+1) : numKeys;
+
+    vtkm::Vec<vtkm::Float64,3> sum(0.0);
+    for (vtkm::Id index = start; index < end; index++)
+    {
+      vtkm::Id pointIndex =
+          static_cast<vtkm::Id>(this->Keys.Get(index) % numPoints);
+      typename PointPortalType::ValueType point =
+          this->Points.Get(pointIndex);
+      sum[0] += static_cast<vtkm::Float64>(point[0]);
+      sum[1] += static_cast<vtkm::Float64>(point[1]);
+      sum[2] += static_cast<vtkm::Float64>(point[2]);
+    }
+    vtkm::Float64 scale = 1.0/static_cast<vtkm::Float64>(end - start);
+    this->Output.Set(bin, OutputType(static_cast<ComponentType>(sum[0]*scale),
+                                     static_cast<ComponentType>(sum[1]*scale),
+                                     static_cast<ComponentType>(sum[2]*scale)));
+  }
+};
+
+// Renumbers the points of each triangle and flags the triangles whose points
+// are all in different bins. The flag is written for each of the three
+// indices so that the connectivity can be compacted directly.
+template<typename ConnectivityPortalType,
+         typename PointMapPortalType,
+         typename OutputPortalType,
+         typename FlagPortalType>
+struct VertexClusteringTriangleKernel : public vtkm::exec::FunctorBase
+{
+  ConnectivityPortalType Connectivity;
+  PointMapPortalType PointMap;
+  OutputPortalType Output;
+  FlagPortalType Flags;
+
+  VTKM_CONT_EXPORT
+  VertexClusteringTriangleKernel(const ConnectivityPortalType &connectivity,
+                                 const PointMapPortalType &pointMap,
+                                 const OutputPortalType &output,
+                                 const FlagPortalType &flags)
+    : Connectivity(connectivity),
+      PointMap(pointMap),
+      Output(output),
+      Flags(flags) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id triangle) const
+  {
+    vtkm::Id numPoints = this->PointMap.GetNumberOfValues();
+    vtkm::Id3 points;
+    for (vtkm::IdComponent pointInTriangle = 0;
+         pointInTriangle < 3;
+         pointInTriangle++)
+    {
+      vtkm::Id pointIndex =
+          this->Connectivity.Get(3*triangle + pointInTriangle);
+      if ((pointIndex < 0) || (pointIndex >= numPoints))
+      {
+        this->RaiseError("Triangle references a point index out of range.");
+        return;
+      }
+      points[pointInTriangle] = this->PointMap.Get(pointIndex);
+    }
+    vtkm::Id keep = ((points[0] != points[1])
+                     && (points[1] != points[2])
+                     && (points[2] != points[0])) ? 1 : 0;
+    for (vtkm::IdComponent pointInTriangle = 0;
+         pointInTriangle < 3;
+         pointInTriangle++)
+    {
+      this->Output.Set(3*triangle + pointInTriangle, points[pointInTriangle]);
+      this->Flags.Set(3*triangle + pointInTriangle, keep);
+    }
+  }
+};
+
+} // namespace internal
+
+/// \brief Simplifies a triangle mesh by clustering its points.
+///
+/// The bounds of the mesh are divided into a uniform grid of bins, and all
+/// the points in a bin are replaced by their average. Triangles whose points
+/// fall in fewer than three bins are dropped.
+///
+/// The points are grouped with a single sort of 64-bit keys made of the bin
+/// and the point index. The first key of each bin is flagged, an inclusive
+/// scan of the flags numbers the occupied bins, and StreamCompact of the
+/// flags gives where each bin starts in the sorted keys. Each bin is then
+/// averaged independently, and the triangles are renumbered and compacted.
+///
+template<typename DeviceAdapterTag>
+class VertexClustering
+{
+  typedef vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+public:
+  VTKM_CONT_EXPORT
+  VertexClustering(const vtkm::Id3 &divisions) : Divisions(divisions) {  }
+
+  VTKM_CONT_EXPORT
+  const vtkm::Id3 &GetDivisions() const { return this->Divisions; }
+
+  /// Clusters \p points into the bins of \p bounds. Each triangle is three
+  /// consecutive indices of \p connectivity. The output points are the
+  /// averages of the occupied bins, ordered by bin. Throws
+  /// vtkm::cont::ErrorExecution if a triangle references a point that does
+  /// not exist.
+  ///
+  template<typename T, typename PointStorage, typename ConnectivityStorage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,PointStorage> &points,
+           const vtkm::cont::ArrayHandle<vtkm::Id,ConnectivityStorage>
+               &connectivity,
+           const vtkm::Bounds &bounds,
+           vtkm::cont::ArrayHandle<vtkm::Vec<T,3> > &outputPoints,
+           vtkm::cont::ArrayHandle<vtkm::Id> &outputConnectivity)
+  {
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,PointStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        PointPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Vec<T,3> >
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal
+        OutputPointPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id,ConnectivityStorage>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        ConnectivityPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Int64>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal KeyPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Int64>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        KeyPortalConstType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::Portal IdPortalType;
+    typedef typename vtkm::cont::ArrayHandle<vtkm::Id>
+        ::template ExecutionTypes<DeviceAdapterTag>::PortalConst
+        IdPortalConstType;
+
+    if ((this->Divisions[0] < 1)
+        || (this->Divisions[1] < 1)
+        || (this->Divisions[2] < 1))
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Vertex clustering needs at least one division on each axis.");
+    }
+    if (connectivity.GetNumberOfValues() % 3 != 0)
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Vertex clustering connectivity is not a list of triangles.");
+    }
+
+    vtkm::Id numPoints = points.GetNumberOfValues();
+    internal::VertexClusteringGrid grid(this->Divisions, bounds);
+    if ((numPoints > 0)
+        && (grid.GetNumberOfBins()
+            > std::numeric_limits<vtkm::Int64>::max()/numPoints))
+    {
+      throw vtkm::cont::ErrorControlBadValue(
+            "Too many vertex clustering bins for the number of points.");
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Int64> keys;
+    Algorithm::Schedule(
+          internal::VertexClusteringKeyKernel<PointPortalType,KeyPortalType>(
+            points.PrepareForInput(DeviceAdapterTag()),
+            keys.PrepareForOutput(numPoints, DeviceAdapterTag()),
+            grid),
+          numPoints);
+    Algorithm::Sort(keys);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> binFlags;
+    Algorithm::Schedule(
+          internal::VertexClusteringFlagKernel<
+            KeyPortalConstType,IdPortalType>(
+            keys.PrepareForInput(DeviceAdapterTag()),
+            binFlags.PrepareForOutput(numPoints, DeviceAdapterTag())),
+          numPoints);
+    vtkm::cont::ArrayHandle<vtkm::Id> binStarts;
+    Algorithm::StreamCompact(binFlags, binStarts);
+    vtkm::Id numBins = binStarts.GetNumberOfValues();
+
+    vtkm::cont::ArrayHandle<vtkm::Id> binNumbers;
+    Algorithm::ScanInclusive(binFlags, binNumbers);
+    binFlags.ReleaseResources();
+    Algorithm::Schedule(
+          internal::VertexClusteringPointMapKernel<
+            KeyPortalConstType,IdPortalConstType,IdPortalType>(
+            keys.PrepareForInput(DeviceAdapterTag()),
+            binNumbers.PrepareForInput(DeviceAdapterTag()),
+            this->PointMap.PrepareForOutput(numPoints, DeviceAdapterTag())),
+          numPoints);
+    binNumbers.ReleaseResources();
+
+    Algorithm::Schedule(
+          internal::VertexClusteringAverageKernel<
+            KeyPortalConstType,
+            IdPortalConstType,
+            PointPortalType,
+            OutputPointPortalType>(
+            keys.PrepareForInput(DeviceAdapterTag()),
+            binStarts.PrepareForInput(DeviceAdapterTag()),
+            points.PrepareForInput(DeviceAdapterTag()),
+            outputPoints.PrepareForOutput(numBins, DeviceAdapterTag())),
+          numBins);
+    keys.ReleaseResources();
+
+    vtkm::Id numTriangles = connectivity.GetNumberOfValues()/3;
+    vtkm::cont::ArrayHandle<vtkm::Id> mappedConnectivity;
+    vtkm::cont::ArrayHandle<vtkm::Id> keepFlags;
+    Algorithm::Schedule(
+          internal::VertexClusteringTriangleKernel<
+            ConnectivityPortalType,
+            IdPortalConstType,
+            IdPortalType,
+            IdPortalType>(
+            connectivity.PrepareForInput(DeviceAdapterTag()),
+            this->PointMap.PrepareForInput(DeviceAdapterTag()),
+            mappedConnectivity.PrepareForOutput(3*numTriangles,
+                                                DeviceAdapterTag()),
+            keepFlags.PrepareForOutput(3*numTriangles, DeviceAdapterTag())),
+          numTriangles);
+    Algorithm::StreamCompact(mappedConnectivity,
+                             keepFlags,
+                             outputConnectivity);
+  }
+
+  /// Clusters \p points into the bins of their own bounds.
+  ///
+  template<typename T, typename PointStorage, typename ConnectivityStorage>
+  VTKM_CONT_EXPORT
+  void Run(const vtkm::cont::ArrayHandle<vtkm::Vec<T,3>,PointStorage> &points,
+           const vtkm::cont::ArrayHandle<vtkm::Id,ConnectivityStorage>
+               &connectivity,
+           vtkm::cont::ArrayHandle<vtkm::Vec<T,3> > &outputPoints,
+           vtkm::cont::ArrayHandle<vtkm::Id> &outputConnectivity)
+  {
+    this->Run(points,
+              connectivity,
+              vtkm::cont::ComputeBounds(points, DeviceAdapterTag()),
+              outputPoints,
+              outputConnectivity);
+  }
+
+  /// The output point of each input point from the last run. This can be
+  /// used to carry point fields over to the output.
+  ///
+  VTKM_CONT_EXPORT
+  const vtkm::cont::ArrayHandle<vtkm::Id> &GetPointMap() const
+  {
+    return this->PointMap;
+  }
+
+private:
+  vtkm::Id3 Divisions;
+  vtkm::cont::ArrayHandle<vtkm::Id> PointMap;
+};
+
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_VertexClustering_h
@@ -0,0 +1,360 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_internal_MarchingCubesDataTables_h
+#define vtk_m_worklet_internal_MarchingCubesDataTables_h
+
+#include <vtkm/Types.h>
+
+namespace vtkm {
+namespace worklet {
+namespace internal {
+
+// The corners of a hexahedron are numbered like those of VTK_HEXAHEDRON:
+// 0-3 counterclockwise around the bottom face, 4-7 above them. A case
+// number has bit i set when the field at corner i is at or above the
+// isovalue.
+
+/// Offset of each corner from the lowest corner of the cell.
+///
+const vtkm::IdComponent CornerOffsetTable[8*3] = {
+  0, 0, 0,
+  1, 0, 0,
+  1, 1, 0,
+  0, 1, 0,
+  0, 0, 1,
+  1, 0, 1,
+  1, 1, 1,
+  0, 1, 1
+};
+
+/// The two corners of each edge of the cell. The first corner is the one
+/// with the lower coordinate along the edge.
+///
+const vtkm::IdComponent EdgeCornerTable[12*2] = {
+  0, 1,
+  1, 2,
+  3, 2,
+  0, 3,
+  4, 5,
+  5, 6,
+  7, 6,
+  4, 7,
+  0, 4,
+  1, 5,
+  2, 6,
+  3, 7
+};
+
+const vtkm::IdComponent EdgeAxisTable[12] = {
+  0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2
+};
+
+/// The number of triangles generated for each case.
+///
+const vtkm::IdComponent NumTrianglesTable[256] = {
+  0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 2,
+  1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 3,
+  1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 3,
+  2, 3, 3, 2, 3, 4, 4, 3, 3, 4, 4, 3, 4, 5, 5, 2,
+  1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 3,
+  2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 4,
+  2, 3, 3, 4, 3, 4, 2, 3, 3, 4, 4, 5, 4, 5, 3, 2,
+  3, 4, 4, 3, 4, 5, 3, 2, 4, 5, 5, 4, 5, 2, 4, 1,
+  1, 2, 2, 3, 2, 3, 3, 4, 2, 3, 3, 4, 3, 4, 4, 3,
+  2, 3, 3, 4, 3, 4, 4, 5, 3, 2, 4, 3, 4, 3, 5, 2,
+  2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 4, 5, 5, 4,
+  3, 4, 4, 3, 4, 5, 5, 4, 4, 3, 5, 2, 5, 4, 2, 1,
+  2, 3, 3, 4, 3, 4, 4, 5, 3, 4, 4, 5, 2, 3, 3, 2,
+  3, 4, 4, 5, 4, 5, 5, 2, 4, 3, 5, 4, 3, 2, 4, 1,
+  3, 4, 4, 5, 4, 5, 3, 4, 4, 5, 5, 2, 3, 4, 2, 1,
+  2, 3, 3, 2, 3, 4, 2, 1, 3, 2, 4, 1, 2, 1, 1, 0
+};
+
+/// The edges holding the vertices of the triangles of each case, 15 entries
+/// (room for 5 triangles) per case. Triangles are wound so that their
+/// normals point toward lower field values. Each face of the cell is split
+/// the same way whichever of its two cells looks at it (the corners at or
+/// above the isovalue are kept apart on ambiguous faces), so the surfaces of
+/// neighboring cells meet without cracks.
+///
+const vtkm::IdComponent TriangleTable[256*15] = {
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 0
+   0,  3,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 1
+   0,  9,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 2
+   1,  8,  9,  1,  3,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 3
+   1, 10,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 4
+   0,  3,  8,  1, 10,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 5
+   0, 10,  2,  0,  9, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 6
+   2,  9, 10,  2,  8,  9,  2,  3,  8,  0,  0,  0,  0,  0,  0,  // 7
+   2, 11,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 8
+   0, 11,  8,  0,  2, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 9
+   0,  9,  1,  2, 11,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 10
+   1,  8,  9,  1, 11,  8,  1,  2, 11,  0,  0,  0,  0,  0,  0,  // 11
+   1, 11,  3,  1, 10, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 12
+   0, 11,  8,  0, 10, 11,  0,  1, 10,  0,  0,  0,  0,  0,  0,  // 13
+   0, 11,  3,  0, 10, 11,  0,  9, 10,  0,  0,  0,  0,  0,  0,  // 14
+   8, 10, 11,  8,  9, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 15
+   4,  8,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 16
+   0,  7,  4,  0,  3,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 17
+   0,  9,  1,  4,  8,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 18
+   1,  4,  9,  1,  7,  4,  1,  3,  7,  0,  0,  0,  0,  0,  0,  // 19
+   1, 10,  2,  4,  8,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 20
+   0,  7,  4,  0,  3,  7,  1, 10,  2,  0,  0,  0,  0,  0,  0,  // 21
+   0, 10,  2,  0,  9, 10,  4,  8,  7,  0,  0,  0,  0,  0,  0,  // 22
+   2,  9, 10,  2,  4,  9,  2,  7,  4,  2,  3,  7,  0,  0,  0,  // 23
+   2, 11,  3,  4,  8,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 24
+   0,  7,  4,  0, 11,  7,  0,  2, 11,  0,  0,  0,  0,  0,  0,  // 25
+   0,  9,  1,  2, 11,  3,  4,  8,  7,  0,  0,  0,  0,  0,  0,  // 26
+   1,  4,  9,  1,  7,  4,  1, 11,  7,  1,  2, 11,  0,  0,  0,  // 27
+   1, 11,  3,  1, 10, 11,  4,  8,  7,  0,  0,  0,  0,  0,  0,  // 28
+   0,  7,  4,  0, 11,  7,  0, 10, 11,  0,  1, 10,  0,  0,  0,  // 29
+   0, 11,  3,  0, 10, 11,  0,  9, 10,  4,  8,  7,  0,  0,  0,  // 30
+   4, 11,  7,  4, 10, 11,  4,  9, 10,  0,  0,  0,  0,  0,  0,  // 31
+   4,  5,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 32
+   0,  3,  8,  4,  5,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 33
+   0,  5,  1,  0,  4,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 34
+   1,  4,  5,  1,  8,  4,  1,  3,  8,  0,  0,  0,  0,  0,  0,  // 35
+   1, 10,  2,  4,  5,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 36
+   0,  3,  8,  1, 10,  2,  4,  5,  9,  0,  0,  0,  0,  0,  0,  // 37
+   0, 10,  2,  0,  5, 10,  0,  4,  5,  0,  0,  0,  0,  0,  0,  // 38
+   2,  5, 10,  2,  4,  5,  2,  8,  4,  2,  3,  8,  0,  0,  0,  // 39
+   2, 11,  3,  4,  5,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 40
+   0, 11,  8,  0,  2, 11,  4,  5,  9,  0,  0,  0,  0,  0,  0,  // 41
+   0,  5,  1,  0,  4,  5,  2, 11,  3,  0,  0,  0,  0,  0,  0,  // 42
+   1,  4,  5,  1,  8,  4,  1, 11,  8,  1,  2, 11,  0,  0,  0,  // 43
+   1, 11,  3,  1, 10, 11,  4,  5,  9,  0,  0,  0,  0,  0,  0,  // 44
+   0, 11,  8,  0, 10, 11,  0,  1, 10,  4,  5,  9,  0,  0,  0,  // 45
+   0, 11,  3,  0, 10, 11,  0,  5, 10,  0,  4,  5,  0,  0,  0,  // 46
+   4, 11,  8,  4, 10, 11,  4,  5, 10,  0,  0,  0,  0,  0,  0,  // 47
+   5,  8,  7,  5,  9,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 48
+   0,  5,  9,  0,  7,  5,  0,  3,  7,  0,  0,  0,  0,  0,  0,  // 49
+   0,  5,  1,  0,  7,  5,  0,  8,  7,  0,  0,  0,  0,  0,  0,  // 50
+   1,  7,  5,  1,  3,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 51
+   1, 10,  2,  5,  8,  7,  5,  9,  8,  0,  0,  0,  0,  0,  0,  // 52
+   0,  5,  9,  0,  7,  5,  0,  3,  7,  1, 10,  2,  0,  0,  0,  // 53
+   0, 10,  2,  0,  5, 10,  0,  7,  5,  0,  8,  7,  0,  0,  0,  // 54
+   2,  5, 10,  2,  7,  5,  2,  3,  7,  0,  0,  0,  0,  0,  0,  // 55
+   2, 11,  3,  5,  8,  7,  5,  9,  8,  0,  0,  0,  0,  0,  0,  // 56
+   0,  5,  9,  0,  7,  5,  0, 11,  7,  0,  2, 11,  0,  0,  0,  // 57
+   0,  5,  1,  0,  7,  5,  0,  8,  7,  2, 11,  3,  0,  0,  0,  // 58
+   1,  7,  5,  1, 11,  7,  1,  2, 11,  0,  0,  0,  0,  0,  0,  // 59
+   1, 11,  3,  1, 10, 11,  5,  8,  7,  5,  9,  8,  0,  0,  0,  // 60
+   0,  5,  9,  0,  7,  5,  0, 11,  7,  0, 10, 11,  0,  1, 10,  // 61
+   0, 11,  3,  0, 10, 11,  0,  5, 10,  0,  7,  5,  0,  8,  7,  // 62
+   5, 11,  7,  5, 10, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 63
+   5,  6, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 64
+   0,  3,  8,  5,  6, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 65
+   0,  9,  1,  5,  6, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 66
+   1,  8,  9,  1,  3,  8,  5,  6, 10,  0,  0,  0,  0,  0,  0,  // 67
+   1,  6,  2,  1,  5,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 68
+   0,  3,  8,  1,  6,  2,  1,  5,  6,  0,  0,  0,  0,  0,  0,  // 69
+   0,  6,  2,  0,  5,  6,  0,  9,  5,  0,  0,  0,  0,  0,  0,  // 70
+   2,  5,  6,  2,  9,  5,  2,  8,  9,  2,  3,  8,  0,  0,  0,  // 71
+   2, 11,  3,  5,  6, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 72
+   0, 11,  8,  0,  2, 11,  5,  6, 10,  0,  0,  0,  0,  0,  0,  // 73
+   0,  9,  1,  2, 11,  3,  5,  6, 10,  0,  0,  0,  0,  0,  0,  // 74
+   1,  8,  9,  1, 11,  8,  1,  2, 11,  5,  6, 10,  0,  0,  0,  // 75
+   1, 11,  3,  1,  6, 11,  1,  5,  6,  0,  0,  0,  0,  0,  0,  // 76
+   0, 11,  8,  0,  6, 11,  0,  5,  6,  0,  1,  5,  0,  0,  0,  // 77
+   0, 11,  3,  0,  6, 11,  0,  5,  6,  0,  9,  5,  0,  0,  0,  // 78
+   5,  8,  9,  5, 11,  8,  5,  6, 11,  0,  0,  0,  0,  0,  0,  // 79
+   4,  8,  7,  5,  6, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 80
+   0,  7,  4,  0,  3,  7,  5,  6, 10,  0,  0,  0,  0,  0,  0,  // 81
+   0,  9,  1,  4,  8,  7,  5,  6, 10,  0,  0,  0,  0,  0,  0,  // 82
+   1,  4,  9,  1,  7,  4,  1,  3,  7,  5,  6, 10,  0,  0,  0,  // 83
+   1,  6,  2,  1,  5,  6,  4,  8,  7,  0,  0,  0,  0,  0,  0,  // 84
+   0,  7,  4,  0,  3,  7,  1,  6,  2,  1,  5,  6,  0,  0,  0,  // 85
+   0,  6,  2,  0,  5,  6,  0,  9,  5,  4,  8,  7,  0,  0,  0,  // 86
+   2,  5,  6,  2,  9,  5,  2,  4,  9,  2,  7,  4,  2,  3,  7,  // 87
+   2, 11,  3,  4,  8,  7,  5,  6, 10,  0,  0,  0,  0,  0,  0,  // 88
+   0,  7,  4,  0, 11,  7,  0,  2, 11,  5,  6, 10,  0,  0,  0,  // 89
+   0,  9,  1,  2, 11,  3,  4,  8,  7,  5,  6, 10,  0,  0,  0,  // 90
+   1,  4,  9,  1,  7,  4,  1, 11,  7,  1,  2, 11,  5,  6, 10,  // 91
+   1, 11,  3,  1,  6, 11,  1,  5,  6,  4,  8,  7,  0,  0,  0,  // 92
+   0,  7,  4,  0, 11,  7,  0,  6, 11,  0,  5,  6,  0,  1,  5,  // 93
+   0, 11,  3,  0,  6, 11,  0,  5,  6,  0,  9,  5,  4,  8,  7,  // 94
+   4, 11,  7,  4,  6, 11,  4,  5,  6,  4,  9,  5,  0,  0,  0,  // 95
+   4, 10,  9,  4,  6, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 96
+   0,  3,  8,  4, 10,  9,  4,  6, 10,  0,  0,  0,  0,  0,  0,  // 97
+   0, 10,  1,  0,  6, 10,  0,  4,  6,  0,  0,  0,  0,  0,  0,  // 98
+   1,  6, 10,  1,  4,  6,  1,  8,  4,  1,  3,  8,  0,  0,  0,  // 99
+   1,  6,  2,  1,  4,  6,  1,  9,  4,  0,  0,  0,  0,  0,  0,  // 100
+   0,  3,  8,  1,  6,  2,  1,  4,  6,  1,  9,  4,  0,  0,  0,  // 101
+   0,  6,  2,  0,  4,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 102
+   2,  4,  6,  2,  8,  4,  2,  3,  8,  0,  0,  0,  0,  0,  0,  // 103
+   2, 11,  3,  4, 10,  9,  4,  6, 10,  0,  0,  0,  0,  0,  0,  // 104
+   0, 11,  8,  0,  2, 11,  4, 10,  9,  4,  6, 10,  0,  0,  0,  // 105
+   0, 10,  1,  0,  6, 10,  0,  4,  6,  2, 11,  3,  0,  0,  0,  // 106
+   1,  6, 10,  1,  4,  6,  1,  8,  4,  1, 11,  8,  1,  2, 11,  // 107
+   1, 11,  3,  1,  6, 11,  1,  4,  6,  1,  9,  4,  0,  0,  0,  // 108
+   0, 11,  8,  0,  6, 11,  0,  4,  6,  0,  9,  4,  0,  1,  9,  // 109
+   0, 11,  3,  0,  6, 11,  0,  4,  6,  0,  0,  0,  0,  0,  0,  // 110
+   4, 11,  8,  4,  6, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 111
+   6,  8,  7,  6,  9,  8,  6, 10,  9,  0,  0,  0,  0,  0,  0,  // 112
+   0, 10,  9,  0,  6, 10,  0,  7,  6,  0,  3,  7,  0,  0,  0,  // 113
+   0, 10,  1,  0,  6, 10,  0,  7,  6,  0,  8,  7,  0,  0,  0,  // 114
+   1,  6, 10,  1,  7,  6,  1,  3,  7,  0,  0,  0,  0,  0,  0,  // 115
+   1,  6,  2,  1,  7,  6,  1,  8,  7,  1,  9,  8,  0,  0,  0,  // 116
+   0,  1,  9,  0,  2,  1,  0,  6,  2,  0,  7,  6,  0,  3,  7,  // 117
+   0,  6,  2,  0,  7,  6,  0,  8,  7,  0,  0,  0,  0,  0,  0,  // 118
+   2,  7,  6,  2,  3,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 119
+   2, 11,  3,  6,  8,  7,  6,  9,  8,  6, 10,  9,  0,  0,  0,  // 120
+   0, 10,  9,  0,  6, 10,  0,  7,  6,  0, 11,  7,  0,  2, 11,  // 121
+   0, 10,  1,  0,  6, 10,  0,  7,  6,  0,  8,  7,  2, 11,  3,  // 122
+   1,  6, 10,  1,  7,  6,  1, 11,  7,  1,  2, 11,  0,  0,  0,  // 123
+   1, 11,  3,  1,  6, 11,  1,  7,  6,  1,  8,  7,  1,  9,  8,  // 124
+   0,  1,  9,  6, 11,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 125
+   0, 11,  3,  0,  6, 11,  0,  7,  6,  0,  8,  7,  0,  0,  0,  // 126
+   6, 11,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 127
+   6,  7, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 128
+   0,  3,  8,  6,  7, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 129
+   0,  9,  1,  6,  7, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 130
+   1,  8,  9,  1,  3,  8,  6,  7, 11,  0,  0,  0,  0,  0,  0,  // 131
+   1, 10,  2,  6,  7, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 132
+   0,  3,  8,  1, 10,  2,  6,  7, 11,  0,  0,  0,  0,  0,  0,  // 133
+   0, 10,  2,  0,  9, 10,  6,  7, 11,  0,  0,  0,  0,  0,  0,  // 134
+   2,  9, 10,  2,  8,  9,  2,  3,  8,  6,  7, 11,  0,  0,  0,  // 135
+   2,  7,  3,  2,  6,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 136
+   0,  7,  8,  0,  6,  7,  0,  2,  6,  0,  0,  0,  0,  0,  0,  // 137
+   0,  9,  1,  2,  7,  3,  2,  6,  7,  0,  0,  0,  0,  0,  0,  // 138
+   1,  8,  9,  1,  7,  8,  1,  6,  7,  1,  2,  6,  0,  0,  0,  // 139
+   1,  7,  3,  1,  6,  7,  1, 10,  6,  0,  0,  0,  0,  0,  0,  // 140
+   0,  7,  8,  0,  6,  7,  0, 10,  6,  0,  1, 10,  0,  0,  0,  // 141
+   0,  7,  3,  0,  6,  7,  0, 10,  6,  0,  9, 10,  0,  0,  0,  // 142
+   6,  9, 10,  6,  8,  9,  6,  7,  8,  0,  0,  0,  0,  0,  0,  // 143
+   4, 11,  6,  4,  8, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 144
+   0,  6,  4,  0, 11,  6,  0,  3, 11,  0,  0,  0,  0,  0,  0,  // 145
+   0,  9,  1,  4, 11,  6,  4,  8, 11,  0,  0,  0,  0,  0,  0,  // 146
+   1,  4,  9,  1,  6,  4,  1, 11,  6,  1,  3, 11,  0,  0,  0,  // 147
+   1, 10,  2,  4, 11,  6,  4,  8, 11,  0,  0,  0,  0,  0,  0,  // 148
+   0,  6,  4,  0, 11,  6,  0,  3, 11,  1, 10,  2,  0,  0,  0,  // 149
+   0, 10,  2,  0,  9, 10,  4, 11,  6,  4,  8, 11,  0,  0,  0,  // 150
+   2,  9, 10,  2,  4,  9,  2,  6,  4,  2, 11,  6,  2,  3, 11,  // 151
+   2,  8,  3,  2,  4,  8,  2,  6,  4,  0,  0,  0,  0,  0,  0,  // 152
+   0,  6,  4,  0,  2,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 153
+   0,  9,  1,  2,  8,  3,  2,  4,  8,  2,  6,  4,  0,  0,  0,  // 154
+   1,  4,  9,  1,  6,  4,  1,  2,  6,  0,  0,  0,  0,  0,  0,  // 155
+   1,  8,  3,  1,  4,  8,  1,  6,  4,  1, 10,  6,  0,  0,  0,  // 156
+   0,  6,  4,  0, 10,  6,  0,  1, 10,  0,  0,  0,  0,  0,  0,  // 157
+   0,  8,  3,  0,  4,  8,  0,  6,  4,  0, 10,  6,  0,  9, 10,  // 158
+   4, 10,  6,  4,  9, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 159
+   4,  5,  9,  6,  7, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 160
+   0,  3,  8,  4,  5,  9,  6,  7, 11,  0,  0,  0,  0,  0,  0,  // 161
+   0,  5,  1,  0,  4,  5,  6,  7, 11,  0,  0,  0,  0,  0,  0,  // 162
+   1,  4,  5,  1,  8,  4,  1,  3,  8,  6,  7, 11,  0,  0,  0,  // 163
+   1, 10,  2,  4,  5,  9,  6,  7, 11,  0,  0,  0,  0,  0,  0,  // 164
+   0,  3,  8,  1, 10,  2,  4,  5,  9,  6,  7, 11,  0,  0,  0,  // 165
+   0, 10,  2,  0,  5, 10,  0,  4,  5,  6,  7, 11,  0,  0,  0,  // 166
+   2,  5, 10,  2,  4,  5,  2,  8,  4,  2,  3,  8,  6,  7, 11,  // 167
+   2,  7,  3,  2,  6,  7,  4,  5,  9,  0,  0,  0,  0,  0,  0,  // 168
+   0,  7,  8,  0,  6,  7,  0,  2,  6,  4,  5,  9,  0,  0,  0,  // 169
+   0,  5,  1,  0,  4,  5,  2,  7,  3,  2,  6,  7,  0,  0,  0,  // 170
+   1,  4,  5,  1,  8,  4,  1,  7,  8,  1,  6,  7,  1,  2,  6,  // 171
+   1,  7,  3,  1,  6,  7,  1, 10,  6,  4,  5,  9,  0,  0,  0,  // 172
+   0,  7,  8,  0,  6,  7,  0, 10,  6,  0,  1, 10,  4,  5,  9,  // 173
+   0,  7,  3,  0,  6,  7,  0, 10,  6,  0,  5, 10,  0,  4,  5,  // 174
+   4,  7,  8,  4,  6,  7,  4, 10,  6,  4,  5, 10,  0,  0,  0,  // 175
+   5, 11,  6,  5,  8, 11,  5,  9,  8,  0,  0,  0,  0,  0,  0,  // 176
+   0,  5,  9,  0,  6,  5,  0, 11,  6,  0,  3, 11,  0,  0,  0,  // 177
+   0,  5,  1,  0,  6,  5,  0, 11,  6,  0,  8, 11,  0,  0,  0,  // 178
+   1,  6,  5,  1, 11,  6,  1,  3, 11,  0,  0,  0,  0,  0,  0,  // 179
+   1, 10,  2,  5, 11,  6,  5,  8, 11,  5,  9,  8,  0,  0,  0,  // 180
+   0,  5,  9,  0,  6,  5,  0, 11,  6,  0,  3, 11,  1, 10,  2,  // 181
+   0, 10,  2,  0,  5, 10,  0,  6,  5,  0, 11,  6,  0,  8, 11,  // 182
+   2,  5, 10,  2,  6,  5,  2, 11,  6,  2,  3, 11,  0,  0,  0,  // 183
+   2,  8,  3,  2,  9,  8,  2,  5,  9,  2,  6,  5,  0,  0,  0,  // 184
+   0,  5,  9,  0,  6,  5,  0,  2,  6,  0,  0,  0,  0,  0,  0,  // 185
+   0,  5,  1,  0,  6,  5,  0,  2,  6,  0,  3,  2,  0,  8,  3,  // 186
+   1,  6,  5,  1,  2,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 187
+   1,  8,  3,  1,  9,  8,  1,  5,  9,  1,  6,  5,  1, 10,  6,  // 188
+   0,  5,  9,  0,  6,  5,  0, 10,  6,  0,  1, 10,  0,  0,  0,  // 189
+   0,  8,  3,  5, 10,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 190
+   5, 10,  6,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 191
+   5, 11, 10,  5,  7, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 192
+   0,  3,  8,  5, 11, 10,  5,  7, 11,  0,  0,  0,  0,  0,  0,  // 193
+   0,  9,  1,  5, 11, 10,  5,  7, 11,  0,  0,  0,  0,  0,  0,  // 194
+   1,  8,  9,  1,  3,  8,  5, 11, 10,  5,  7, 11,  0,  0,  0,  // 195
+   1, 11,  2,  1,  7, 11,  1,  5,  7,  0,  0,  0,  0,  0,  0,  // 196
+   0,  3,  8,  1, 11,  2,  1,  7, 11,  1,  5,  7,  0,  0,  0,  // 197
+   0, 11,  2,  0,  7, 11,  0,  5,  7,  0,  9,  5,  0,  0,  0,  // 198
+   2,  7, 11,  2,  5,  7,  2,  9,  5,  2,  8,  9,  2,  3,  8,  // 199
+   2,  7,  3,  2,  5,  7,  2, 10,  5,  0,  0,  0,  0,  0,  0,  // 200
+   0,  7,  8,  0,  5,  7,  0, 10,  5,  0,  2, 10,  0,  0,  0,  // 201
+   0,  9,  1,  2,  7,  3,  2,  5,  7,  2, 10,  5,  0,  0,  0,  // 202
+   1,  8,  9,  1,  7,  8,  1,  5,  7,  1, 10,  5,  1,  2, 10,  // 203
+   1,  7,  3,  1,  5,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 204
+   0,  7,  8,  0,  5,  7,  0,  1,  5,  0,  0,  0,  0,  0,  0,  // 205
+   0,  7,  3,  0,  5,  7,  0,  9,  5,  0,  0,  0,  0,  0,  0,  // 206
+   5,  8,  9,  5,  7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 207
+   4, 10,  5,  4, 11, 10,  4,  8, 11,  0,  0,  0,  0,  0,  0,  // 208
+   0,  5,  4,  0, 10,  5,  0, 11, 10,  0,  3, 11,  0,  0,  0,  // 209
+   0,  9,  1,  4, 10,  5,  4, 11, 10,  4,  8, 11,  0,  0,  0,  // 210
+   1,  4,  9,  1,  5,  4,  1, 10,  5,  1, 11, 10,  1,  3, 11,  // 211
+   1, 11,  2,  1,  8, 11,  1,  4,  8,  1,  5,  4,  0,  0,  0,  // 212
+   0,  5,  4,  0,  1,  5,  0,  2,  1,  0, 11,  2,  0,  3, 11,  // 213
+   0, 11,  2,  0,  8, 11,  0,  4,  8,  0,  5,  4,  0,  9,  5,  // 214
+   2,  3, 11,  4,  9,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 215
+   2,  8,  3,  2,  4,  8,  2,  5,  4,  2, 10,  5,  0,  0,  0,  // 216
+   0,  5,  4,  0, 10,  5,  0,  2, 10,  0,  0,  0,  0,  0,  0,  // 217
+   0,  9,  1,  2,  8,  3,  2,  4,  8,  2,  5,  4,  2, 10,  5,  // 218
+   1,  4,  9,  1,  5,  4,  1, 10,  5,  1,  2, 10,  0,  0,  0,  // 219
+   1,  8,  3,  1,  4,  8,  1,  5,  4,  0,  0,  0,  0,  0,  0,  // 220
+   0,  5,  4,  0,  1,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 221
+   0,  8,  3,  0,  4,  8,  0,  5,  4,  0,  9,  5,  0,  0,  0,  // 222
+   4,  9,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 223
+   4, 10,  9,  4, 11, 10,  4,  7, 11,  0,  0,  0,  0,  0,  0,  // 224
+   0,  3,  8,  4, 10,  9,  4, 11, 10,  4,  7, 11,  0,  0,  0,  // 225
+   0, 10,  1,  0, 11, 10,  0,  7, 11,  0,  4,  7,  0,  0,  0,  // 226
+   1, 11, 10,  1,  7, 11,  1,  4,  7,  1,  8,  4,  1,  3,  8,  // 227
+   1, 11,  2,  1,  7, 11,  1,  4,  7,  1,  9,  4,  0,  0,  0,  // 228
+   0,  3,  8,  1, 11,  2,  1,  7, 11,  1,  4,  7,  1,  9,  4,  // 229
+   0, 11,  2,  0,  7, 11,  0,  4,  7,  0,  0,  0,  0,  0,  0,  // 230
+   2,  7, 11,  2,  4,  7,  2,  8,  4,  2,  3,  8,  0,  0,  0,  // 231
+   2,  7,  3,  2,  4,  7,  2,  9,  4,  2, 10,  9,  0,  0,  0,  // 232
+   0,  7,  8,  0,  4,  7,  0,  9,  4,  0, 10,  9,  0,  2, 10,  // 233
+   0, 10,  1,  0,  2, 10,  0,  3,  2,  0,  7,  3,  0,  4,  7,  // 234
+   1,  2, 10,  4,  7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 235
+   1,  7,  3,  1,  4,  7,  1,  9,  4,  0,  0,  0,  0,  0,  0,  // 236
+   0,  7,  8,  0,  4,  7,  0,  9,  4,  0,  1,  9,  0,  0,  0,  // 237
+   0,  7,  3,  0,  4,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 238
+   4,  7,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 239
+   8, 10,  9,  8, 11, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 240
+   0, 10,  9,  0, 11, 10,  0,  3, 11,  0,  0,  0,  0,  0,  0,  // 241
+   0, 10,  1,  0, 11, 10,  0,  8, 11,  0,  0,  0,  0,  0,  0,  // 242
+   1, 11, 10,  1,  3, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 243
+   1, 11,  2,  1,  8, 11,  1,  9,  8,  0,  0,  0,  0,  0,  0,  // 244
+   0,  1,  9,  0,  2,  1,  0, 11,  2,  0,  3, 11,  0,  0,  0,  // 245
+   0, 11,  2,  0,  8, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 246
+   2,  3, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 247
+   2,  8,  3,  2,  9,  8,  2, 10,  9,  0,  0,  0,  0,  0,  0,  // 248
+   0, 10,  9,  0,  2, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 249
+   0, 10,  1,  0,  2, 10,  0,  3,  2,  0,  8,  3,  0,  0,  0,  // 250
+   1,  2, 10,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 251
+   1,  8,  3,  1,  9,  8,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 252
+   0,  1,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 253
+   0,  8,  3,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 254
+   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0  // 255
+};
+
+}
+}
+} // namespace vtkm::worklet::internal
+
+#endif //vtk_m_worklet_internal_MarchingCubesDataTables_h
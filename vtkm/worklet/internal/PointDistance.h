@@ -0,0 +1,44 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_internal_PointDistance_h
+#define vtk_m_worklet_internal_PointDistance_h
+
+#include <vtkm/Types.h>
+
+namespace vtkm {
+namespace worklet {
+namespace internal {
+
+/// The squared distance between two points. Point locators compare squared
+/// distances so that no square root is needed.
+///
+template<typename T>
+VTKM_EXEC_CONT_EXPORT
+T Distance2(const vtkm::Vec<T,3> &point1, const vtkm::Vec<T,3> &point2)
+{
+  vtkm::Vec<T,3> difference = point1 - point2;
+  return vtkm::dot(difference, difference);
+}
+
+}
+}
+} // namespace vtkm::worklet::internal
+
+#endif //vtk_m_worklet_internal_PointDistance_h
@@ -0,0 +1,147 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_internal_PointLocatorRadius_h
+#define vtk_m_worklet_internal_PointLocatorRadius_h
+
+#include <vtkm/Types.h>
+
+#include <vtkm/exec/FunctorBase.h>
+
+namespace vtkm {
+namespace worklet {
+namespace internal {
+
+// Kernels for radius queries that work with the execution object of any
+// point locator with a VisitInRadius method. The points are counted in one
+// pass and written in a second, after the counts are scanned into offsets.
+// Index i of the schedule runs query order[i], so a locator can run the
+// queries in an order that suits it and still write results in the order
+// of the queries.
+
+struct PointLocatorCountVisitor
+{
+  vtkm::Id Count;
+
+  VTKM_EXEC_EXPORT
+  PointLocatorCountVisitor() : Count(0) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id, vtkm::FloatDefault) { this->Count++; }
+};
+
+template<typename IdPortalType>
+struct PointLocatorWriteVisitor
+{
+  IdPortalType Ids;
+  vtkm::Id Next;
+
+  VTKM_EXEC_EXPORT
+  PointLocatorWriteVisitor(const IdPortalType &ids, vtkm::Id start)
+    : Ids(ids), Next(start) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id pointId, vtkm::FloatDefault)
+  {
+    this->Ids.Set(this->Next, pointId);
+    this->Next++;
+  }
+};
+
+template<typename LocatorType,
+         typename QueryPortalType,
+         typename OrderPortalType,
+         typename CountPortalType>
+struct PointLocatorRadiusCountKernel : public vtkm::exec::FunctorBase
+{
+  LocatorType Locator;
+  QueryPortalType Queries;
+  OrderPortalType Order;
+  vtkm::FloatDefault Radius;
+  CountPortalType Counts;
+
+  VTKM_CONT_EXPORT
+  PointLocatorRadiusCountKernel(const LocatorType &locator,
+                                const QueryPortalType &queries,
+                                const OrderPortalType &order,
+                                vtkm::FloatDefault radius,
+                                const CountPortalType &counts)
+    : Locator(locator),
+      Queries(queries),
+      Order(order),
+      Radius(radius),
+      Counts(counts) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id query = this->Order.Get(index);
+    PointLocatorCountVisitor visitor;
+    this->Locator.VisitInRadius(this->Queries.Get(query),
+                                this->Radius,
+                                visitor);
+    this->Counts.Set(query, visitor.Count);
+  }
+};
+
+template<typename LocatorType,
+         typename QueryPortalType,
+         typename OrderPortalType,
+         typename OffsetPortalType,
+         typename IdPortalType>
+struct PointLocatorRadiusKernel : public vtkm::exec::FunctorBase
+{
+  LocatorType Locator;
+  QueryPortalType Queries;
+  OrderPortalType Order;
+  vtkm::FloatDefault Radius;
+  OffsetPortalType Offsets;
+  IdPortalType NeighborIds;
+
+  VTKM_CONT_EXPORT
+  PointLocatorRadiusKernel(const LocatorType &locator,
+                           const QueryPortalType &queries,
+                           const OrderPortalType &order,
+                           vtkm::FloatDefault radius,
+                           const OffsetPortalType &offsets,
+                           const IdPortalType &neighborIds)
+    : Locator(locator),
+      Queries(queries),
+      Order(order),
+      Radius(radius),
+      Offsets(offsets),
+      NeighborIds(neighborIds) {  }
+
+  VTKM_EXEC_EXPORT
+  void operator()(vtkm::Id index) const
+  {
+    vtkm::Id query = this->Order.Get(index);
+    PointLocatorWriteVisitor<IdPortalType>
+        visitor(this->NeighborIds, this->Offsets.Get(query));
+    this->Locator.VisitInRadius(this->Queries.Get(query),
+                                this->Radius,
+                                visitor);
+  }
+};
+
+}
+}
+} // namespace vtkm::worklet::internal
+
+#endif //vtk_m_worklet_internal_PointLocatorRadius_h
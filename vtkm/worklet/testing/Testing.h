@@ -0,0 +1,89 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#ifndef vtk_m_worklet_testing_Testing_h
+#define vtk_m_worklet_testing_Testing_h
+
+#include <vtkm/CellShape.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellSetExplicit.h>
+
+#include <vector>
+
+namespace vtkm {
+namespace worklet {
+namespace testing {
+
+/// A small linear congruential generator so the test points are the same on
+/// every platform. Each generator starts from the same seed.
+///
+struct Random
+{
+  vtkm::UInt32 State;
+
+  Random() : State(12345) {  }
+
+  /// Returns a value in [0,1].
+  ///
+  vtkm::Float32 Next()
+  {
+    this->State = this->State*1103515245u + 12345u;
+    return static_cast<vtkm::Float32>((this->State >> 8) & 0xFFFF)/65535.0f;
+  }
+};
+
+/// Cells collected on the host before they are put in a cell set.
+///
+template<typename PointType>
+struct Mesh
+{
+  std::vector<PointType> Points;
+  std::vector<vtkm::UInt8> Shapes;
+  std::vector<vtkm::IdComponent> NumIndices;
+  std::vector<vtkm::Id> Connectivity;
+
+  void AddCell(vtkm::CellShape shape,
+               const vtkm::Id *points,
+               vtkm::IdComponent numPoints)
+  {
+    this->Shapes.push_back(static_cast<vtkm::UInt8>(shape));
+    this->NumIndices.push_back(numPoints);
+    this->Connectivity.insert(this->Connectivity.end(),
+                              points,
+                              points + numPoints);
+  }
+
+  vtkm::cont::CellSetExplicit<> MakeCellSet() const
+  {
+    vtkm::cont::CellSetExplicit<> cellSet(
+          "cells", static_cast<vtkm::Id>(this->Points.size()));
+    cellSet.Fill(vtkm::cont::make_ArrayHandle(this->Shapes),
+                 vtkm::cont::make_ArrayHandle(this->NumIndices),
+                 vtkm::cont::make_ArrayHandle(this->Connectivity));
+    return cellSet;
+  }
+};
+
+}
+}
+} // namespace vtkm::worklet::testing
+
+#endif //vtk_m_worklet_testing_Testing_h
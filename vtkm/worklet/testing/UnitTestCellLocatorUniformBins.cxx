@@ -0,0 +1,293 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/CellLocatorUniformBins.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/ErrorExecution.h>
+
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::CellLocatorUniformBins<Device> LocatorType;
+typedef vtkm::Vec<vtkm::FloatDefault,3> Vec3;
+using vtkm::worklet::testing::Random;
+typedef vtkm::worklet::testing::Mesh<Vec3> Mesh;
+
+const vtkm::Id MESH_CELLS = 5;
+const vtkm::Id NUMBER_OF_QUERIES = 500;
+
+// Fills the unit cube with cells of the given shape, made by splitting
+// the cells of a grid whose inner points are moved at random. Pyramids
+// need a point at the center of each grid cell.
+Mesh MakeMesh(vtkm::CellShape shape, Random &random)
+{
+  const vtkm::Id numPoints = MESH_CELLS + 1;
+  const vtkm::FloatDefault spacing =
+      vtkm::FloatDefault(1)/static_cast<vtkm::FloatDefault>(MESH_CELLS);
+  Mesh mesh;
+  for (vtkm::Id k = 0; k < numPoints; k++)
+  {
+    for (vtkm::Id j = 0; j < numPoints; j++)
+    {
+      for (vtkm::Id i = 0; i < numPoints; i++)
+      {
+        vtkm::Id3 ijk(i, j, k);
+        Vec3 point;
+        for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+        {
+          point[axis] = spacing*static_cast<vtkm::FloatDefault>(ijk[axis]);
+          if ((ijk[axis] > 0) && (ijk[axis] < MESH_CELLS))
+          {
+            point[axis] += spacing*vtkm::FloatDefault(0.3)
+                *(random.Next() - vtkm::FloatDefault(0.5));
+          }
+        }
+        mesh.Points.push_back(point);
+      }
+    }
+  }
+
+  for (vtkm::Id k = 0; k < MESH_CELLS; k++)
+  {
+    for (vtkm::Id j = 0; j < MESH_CELLS; j++)
+    {
+      for (vtkm::Id i = 0; i < MESH_CELLS; i++)
+      {
+        vtkm::Id base = (k*numPoints + j)*numPoints + i;
+        // Corners in the order of a hexahedron, and by bits of the offset.
+        vtkm::Id hex[8] = {
+          base, base + 1, base + numPoints + 1, base + numPoints,
+          base + numPoints*numPoints,
+          base + numPoints*numPoints + 1,
+          base + numPoints*numPoints + numPoints + 1,
+          base + numPoints*numPoints + numPoints };
+        vtkm::Id bits[8] = {
+          hex[0], hex[1], hex[3], hex[2], hex[4], hex[5], hex[7], hex[6] };
+
+        if (shape == vtkm::CELL_SHAPE_HEXAHEDRON)
+        {
+          mesh.AddCell(vtkm::CELL_SHAPE_HEXAHEDRON, hex, 8);
+        }
+        else if (shape == vtkm::CELL_SHAPE_TETRA)
+        {
+          // Six tetrahedra around the diagonal from corner 0 to corner 7.
+          const int axes[6][2] = {
+            {1, 2}, {1, 4}, {2, 1}, {2, 4}, {4, 1}, {4, 2} };
+          for (int tet = 0; tet < 6; tet++)
+          {
+            vtkm::Id points[4] = {
+              bits[0],
+              bits[axes[tet][0]],
+              bits[axes[tet][0] | axes[tet][1]],
+              bits[7] };
+            mesh.AddCell(vtkm::CELL_SHAPE_TETRA, points, 4);
+          }
+        }
+        else if (shape == vtkm::CELL_SHAPE_WEDGE)
+        {
+          vtkm::Id wedge1[6] = {
+            hex[0], hex[1], hex[3], hex[4], hex[5], hex[7] };
+          vtkm::Id wedge2[6] = {
+            hex[1], hex[2], hex[3], hex[5], hex[6], hex[7] };
+          mesh.AddCell(vtkm::CELL_SHAPE_WEDGE, wedge1, 6);
+          mesh.AddCell(vtkm::CELL_SHAPE_WEDGE, wedge2, 6);
+        }
+        else
+        {
+          Vec3 center(vtkm::FloatDefault(0));
+          for (int corner = 0; corner < 8; corner++)
+          {
+            center = center + mesh.Points[static_cast<std::size_t>(
+                                            hex[corner])];
+          }
+          vtkm::Id apex = static_cast<vtkm::Id>(mesh.Points.size());
+          mesh.Points.push_back(center*vtkm::FloatDefault(0.125));
+          const int faces[6][4] = {
+            {0, 1, 2, 3}, {4, 7, 6, 5}, {0, 4, 5, 1},
+            {1, 5, 6, 2}, {2, 6, 7, 3}, {3, 7, 4, 0} };
+          for (int face = 0; face < 6; face++)
+          {
+            vtkm::Id points[5] = {
+              hex[faces[face][0]], hex[faces[face][1]],
+              hex[faces[face][2]], hex[faces[face][3]], apex };
+            mesh.AddCell(vtkm::CELL_SHAPE_PYRAMID, points, 5);
+          }
+        }
+      }
+    }
+  }
+  return mesh;
+}
+
+void CheckLocator(vtkm::CellShape shape, const vtkm::Id3 &divisions)
+{
+  Random random;
+  Mesh mesh = MakeMesh(shape, random);
+  vtkm::cont::ArrayHandle<Vec3> points =
+      vtkm::cont::make_ArrayHandle(mesh.Points);
+  LocatorType locator(divisions);
+  locator.Build(mesh.MakeCellSet(), points);
+  VTKM_TEST_ASSERT(locator.GetNumberOfPoints() ==
+                   static_cast<vtkm::Id>(mesh.Points.size()),
+                   "Wrong number of points in locator.");
+
+  LocatorType::ExecObjectType finder = locator.PrepareForInput();
+  vtkm::Id numFound = 0;
+  for (vtkm::Id query = 0; query < NUMBER_OF_QUERIES; query++)
+  {
+    // Points in a box around the mesh, kept away from its surface.
+    Vec3 point;
+    bool inside = true;
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      point[axis] = vtkm::FloatDefault(1.4)*random.Next()
+          - vtkm::FloatDefault(0.2);
+      if ((point[axis] > vtkm::FloatDefault(-0.001))
+          && (point[axis] < vtkm::FloatDefault(0.001)))
+      {
+        point[axis] = vtkm::FloatDefault(0.01);
+      }
+      if ((point[axis] > vtkm::FloatDefault(0.999))
+          && (point[axis] < vtkm::FloatDefault(1.001)))
+      {
+        point[axis] = vtkm::FloatDefault(0.99);
+      }
+      inside = inside && (point[axis] > 0) && (point[axis] < 1);
+    }
+
+    Vec3 pcoords;
+    vtkm::Id cellId = finder.FindCell(point, pcoords);
+    if (!inside)
+    {
+      VTKM_TEST_ASSERT(cellId == -1, "Found a cell for a point outside.");
+      continue;
+    }
+    VTKM_TEST_ASSERT(cellId >= 0, "Did not find a cell for a point inside.");
+    VTKM_TEST_ASSERT(finder.Connectivity.GetCellShape(cellId) == shape,
+                     "Found cell has the wrong shape.");
+    VTKM_TEST_ASSERT(test_equal(finder.Interpolate(cellId,
+                                                   pcoords,
+                                                   finder.Points),
+                                point,
+                                0.0001),
+                     "Parametric coordinates do not give the point.");
+    numFound++;
+  }
+  std::cout << "  found " << numFound << " of " << NUMBER_OF_QUERIES
+            << " points" << std::endl;
+}
+
+void TestShapes()
+{
+  std::cout << "Tetrahedra" << std::endl;
+  CheckLocator(vtkm::CELL_SHAPE_TETRA, vtkm::Id3(6, 6, 6));
+  std::cout << "Hexahedra" << std::endl;
+  CheckLocator(vtkm::CELL_SHAPE_HEXAHEDRON, vtkm::Id3(4, 5, 6));
+  std::cout << "Wedges" << std::endl;
+  CheckLocator(vtkm::CELL_SHAPE_WEDGE, vtkm::Id3(8, 8, 8));
+  std::cout << "Pyramids" << std::endl;
+  CheckLocator(vtkm::CELL_SHAPE_PYRAMID, vtkm::Id3(5, 5, 5));
+  std::cout << "One bin" << std::endl;
+  CheckLocator(vtkm::CELL_SHAPE_TETRA, vtkm::Id3(1, 1, 1));
+  std::cout << "More bins than cells" << std::endl;
+  CheckLocator(vtkm::CELL_SHAPE_HEXAHEDRON, vtkm::Id3(30, 30, 30));
+}
+
+void TestUnsupportedShapes()
+{
+  std::cout << "Unsupported shapes" << std::endl;
+  Mesh mesh;
+  mesh.Points.push_back(Vec3(0, 0, 0));
+  mesh.Points.push_back(Vec3(1, 0, 0));
+  mesh.Points.push_back(Vec3(0, 1, 0));
+  mesh.Points.push_back(Vec3(0, 0, 1));
+  vtkm::Id triangle[3] = { 0, 1, 2 };
+  mesh.AddCell(vtkm::CELL_SHAPE_TRIANGLE, triangle, 3);
+  vtkm::Id tet[4] = { 0, 1, 2, 3 };
+  mesh.AddCell(vtkm::CELL_SHAPE_TETRA, tet, 4);
+
+  LocatorType locator(vtkm::Id3(2, 2, 2));
+  locator.Build(mesh.MakeCellSet(), vtkm::cont::make_ArrayHandle(mesh.Points));
+  LocatorType::ExecObjectType finder = locator.PrepareForInput();
+  Vec3 pcoords;
+  VTKM_TEST_ASSERT(finder.FindCell(Vec3(0.2f, 0.2f, 0.0f), pcoords) == 1,
+                   "Point on the triangle should be in the tetrahedron.");
+  VTKM_TEST_ASSERT(test_equal(pcoords, Vec3(0.2f, 0.2f, 0.0f)),
+                   "Wrong parametric coordinates in tetrahedron.");
+  VTKM_TEST_ASSERT(finder.FindCell(Vec3(0.5f, 0.5f, 0.5f), pcoords) == -1,
+                   "Point outside the tetrahedron was found.");
+}
+
+void TestBadInput()
+{
+  std::cout << "Bad input" << std::endl;
+  Random random;
+  Mesh mesh = MakeMesh(vtkm::CELL_SHAPE_TETRA, random);
+  LocatorType locator(vtkm::Id3(2, 0, 2));
+  try
+  {
+    locator.Build(mesh.MakeCellSet(),
+                  vtkm::cont::make_ArrayHandle(mesh.Points));
+    VTKM_TEST_FAIL("Did not catch zero divisions.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  Mesh badMesh = mesh;
+  badMesh.Connectivity[5] = static_cast<vtkm::Id>(badMesh.Points.size());
+  LocatorType badLocator(vtkm::Id3(2, 2, 2));
+  try
+  {
+    badLocator.Build(badMesh.MakeCellSet(),
+                     vtkm::cont::make_ArrayHandle(badMesh.Points));
+    VTKM_TEST_FAIL("Did not catch point index out of range.");
+  }
+  catch (vtkm::cont::ErrorExecution &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestCellLocatorUniformBins()
+{
+  TestShapes();
+  TestUnsupportedShapes();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestCellLocatorUniformBins(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestCellLocatorUniformBins);
+}
@@ -0,0 +1,325 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/ExternalFaces.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/DeviceAdapter.h>
+
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::ExternalFaces<Device> ExternalFacesType;
+typedef vtkm::Vec<vtkm::Float64,3> Vec3;
+typedef vtkm::worklet::testing::Mesh<Vec3> Mesh;
+
+Vec3 Cross(const Vec3 &a, const Vec3 &b)
+{
+  return Vec3(a[1]*b[2] - a[2]*b[1],
+              a[2]*b[0] - a[0]*b[2],
+              a[0]*b[1] - a[1]*b[0]);
+}
+
+vtkm::Float64 Dot(const Vec3 &a, const Vec3 &b)
+{
+  return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+// A grid of dimension^3 unit cubes with dimension+1 points on each side.
+void MakeGridPoints(vtkm::Id dimension, Mesh &mesh)
+{
+  for (vtkm::Id k = 0; k <= dimension; k++)
+  {
+    for (vtkm::Id j = 0; j <= dimension; j++)
+    {
+      for (vtkm::Id i = 0; i <= dimension; i++)
+      {
+        mesh.Points.push_back(Vec3(static_cast<vtkm::Float64>(i),
+                                   static_cast<vtkm::Float64>(j),
+                                   static_cast<vtkm::Float64>(k)));
+      }
+    }
+  }
+}
+
+void GetCubeCorners(vtkm::Id dimension,
+                    vtkm::Id i, vtkm::Id j, vtkm::Id k,
+                    vtkm::Id corners[8])
+{
+  vtkm::Id side = dimension + 1;
+  vtkm::Id first = (k*side + j)*side + i;
+  corners[0] = first;
+  corners[1] = first + 1;
+  corners[2] = first + side + 1;
+  corners[3] = first + side;
+  for (vtkm::IdComponent corner = 0; corner < 4; corner++)
+  {
+    corners[corner+4] = corners[corner] + side*side;
+  }
+}
+
+Mesh MakeHexahedra(vtkm::Id dimension)
+{
+  Mesh mesh;
+  MakeGridPoints(dimension, mesh);
+  for (vtkm::Id k = 0; k < dimension; k++)
+  {
+    for (vtkm::Id j = 0; j < dimension; j++)
+    {
+      for (vtkm::Id i = 0; i < dimension; i++)
+      {
+        vtkm::Id corners[8];
+        GetCubeCorners(dimension, i, j, k, corners);
+        mesh.AddCell(vtkm::CELL_SHAPE_HEXAHEDRON, corners, 8);
+      }
+    }
+  }
+  return mesh;
+}
+
+// Splits each cube into the six tetrahedra around its diagonal from corner
+// 0 to corner 6. The split is the same in every cube, so the faces match.
+Mesh MakeTetrahedra(vtkm::Id dimension)
+{
+  const vtkm::IdComponent paths[6][2] = {
+    { 1, 2 }, { 1, 5 }, { 4, 5 }, { 4, 7 }, { 3, 7 }, { 3, 2 } };
+  Mesh mesh;
+  MakeGridPoints(dimension, mesh);
+  for (vtkm::Id k = 0; k < dimension; k++)
+  {
+    for (vtkm::Id j = 0; j < dimension; j++)
+    {
+      for (vtkm::Id i = 0; i < dimension; i++)
+      {
+        vtkm::Id corners[8];
+        GetCubeCorners(dimension, i, j, k, corners);
+        for (vtkm::IdComponent tet = 0; tet < 6; tet++)
+        {
+          vtkm::Id points[4] = { corners[0],
+                                 corners[paths[tet][0]],
+                                 corners[paths[tet][1]],
+                                 corners[6] };
+          // Order the points so that the faces point out.
+          Vec3 p0 = mesh.Points[static_cast<std::size_t>(points[0])];
+          Vec3 p1 = mesh.Points[static_cast<std::size_t>(points[1])];
+          Vec3 p2 = mesh.Points[static_cast<std::size_t>(points[2])];
+          Vec3 p3 = mesh.Points[static_cast<std::size_t>(points[3])];
+          if (Dot(Cross(p1 - p0, p2 - p0), p3 - p0) < 0.0)
+          {
+            std::swap(points[1], points[2]);
+          }
+          mesh.AddCell(vtkm::CELL_SHAPE_TETRA, points, 4);
+        }
+      }
+    }
+  }
+  return mesh;
+}
+
+// Checks that each face points away from the center of a convex mesh.
+void CheckOrientation(const Mesh &mesh,
+                      const ExternalFacesType::OutputCellSetType &faces)
+{
+  Vec3 center(0.0);
+  for (std::size_t index = 0; index < mesh.Points.size(); index++)
+  {
+    center = center + mesh.Points[index];
+  }
+  center = center * (1.0/static_cast<vtkm::Float64>(mesh.Points.size()));
+
+  vtkm::Id offset = 0;
+  for (vtkm::Id face = 0; face < faces.GetNumberOfCells(); face++)
+  {
+    vtkm::IdComponent numPoints =
+        faces.GetNumIndicesArray().GetPortalConstControl().Get(face);
+    std::vector<Vec3> points;
+    Vec3 faceCenter(0.0);
+    for (vtkm::IdComponent pointInFace = 0;
+         pointInFace < numPoints;
+         pointInFace++)
+    {
+      vtkm::Id pointIndex = faces.GetConnectivityArray()
+          .GetPortalConstControl().Get(offset + pointInFace);
+      points.push_back(mesh.Points[static_cast<std::size_t>(pointIndex)]);
+      faceCenter = faceCenter + points.back();
+    }
+    faceCenter = faceCenter * (1.0/static_cast<vtkm::Float64>(numPoints));
+    Vec3 normal = Cross(points[1] - points[0],
+                        points[static_cast<std::size_t>(numPoints-1)]
+                        - points[0]);
+    VTKM_TEST_ASSERT(Dot(normal, faceCenter - center) > 0.0,
+                     "Face points into the mesh.");
+    offset += numPoints;
+  }
+}
+
+// Runs both methods and checks that they agree.
+template<typename CellSetType>
+boost::shared_ptr<ExternalFacesType::OutputCellSetType>
+RunExternalFaces(const CellSetType &cellSet, vtkm::Id expectedFaces)
+{
+  ExternalFacesType externalFaces;
+  externalFaces.Run(cellSet);
+  boost::shared_ptr<ExternalFacesType::OutputCellSetType> faces =
+      externalFaces.GetOutputCellSet();
+  VTKM_TEST_ASSERT(faces->GetNumberOfCells() == expectedFaces,
+                   "Wrong number of faces.");
+  VTKM_TEST_ASSERT(faces->GetNumberOfPoints() == cellSet.GetNumberOfPoints(),
+                   "Wrong number of points.");
+  VTKM_TEST_ASSERT(faces->GetDimensionality() == 2, "Wrong dimensionality.");
+  VTKM_TEST_ASSERT(externalFaces.GetFaceCellIds().GetNumberOfValues()
+                   == expectedFaces,
+                   "Wrong number of face cells.");
+
+  std::cout << "  Comparing with sorting method." << std::endl;
+  ExternalFacesType sortedFaces;
+  sortedFaces.SetUseSorting(true);
+  sortedFaces.Run(cellSet);
+  VTKM_TEST_ASSERT(sortedFaces.GetOutputCellSet()->GetNumberOfCells()
+                   == expectedFaces,
+                   "Wrong number of sorted faces.");
+  const ExternalFacesType::OutputCellSetType::ConnectivityArrayType
+      &connectivity = faces->GetConnectivityArray();
+  const ExternalFacesType::OutputCellSetType::ConnectivityArrayType
+      &sortedConnectivity =
+      sortedFaces.GetOutputCellSet()->GetConnectivityArray();
+  VTKM_TEST_ASSERT(connectivity.GetNumberOfValues()
+                   == sortedConnectivity.GetNumberOfValues(),
+                   "Methods give different connectivity.");
+  for (vtkm::Id index = 0; index < connectivity.GetNumberOfValues(); index++)
+  {
+    VTKM_TEST_ASSERT(connectivity.GetPortalConstControl().Get(index)
+                     == sortedConnectivity.GetPortalConstControl().Get(index),
+                     "Methods give different faces.");
+  }
+  return faces;
+}
+
+void TestHexahedra()
+{
+  std::cout << "Testing external faces of hexahedra." << std::endl;
+  Mesh mesh = MakeHexahedra(2);
+  boost::shared_ptr<ExternalFacesType::OutputCellSetType> faces =
+      RunExternalFaces(mesh.MakeCellSet(), 24);
+  for (vtkm::Id face = 0; face < 24; face++)
+  {
+    VTKM_TEST_ASSERT(faces->GetShapesArray().GetPortalConstControl().Get(face)
+                     == vtkm::CELL_SHAPE_QUAD,
+                     "Wrong face shape.");
+  }
+  CheckOrientation(mesh, *faces);
+}
+
+void TestTetrahedra()
+{
+  std::cout << "Testing external faces of tetrahedra." << std::endl;
+  Mesh mesh = MakeTetrahedra(2);
+  boost::shared_ptr<ExternalFacesType::OutputCellSetType> faces =
+      RunExternalFaces(mesh.MakeCellSet(), 48);
+  for (vtkm::Id face = 0; face < 48; face++)
+  {
+    VTKM_TEST_ASSERT(faces->GetShapesArray().GetPortalConstControl().Get(face)
+                     == vtkm::CELL_SHAPE_TRIANGLE,
+                     "Wrong face shape.");
+  }
+  CheckOrientation(mesh, *faces);
+}
+
+void TestMixedShapes()
+{
+  std::cout << "Testing external faces of mixed shapes." << std::endl;
+  // A cube with a pyramid on top, a wedge beside it, and a triangle that
+  // has no faces.
+  Mesh mesh = MakeHexahedra(1);
+  mesh.Points.push_back(Vec3(0.5, 0.5, 1.5));
+  mesh.Points.push_back(Vec3(2.0, 0.0, 0.0));
+  mesh.Points.push_back(Vec3(2.0, 0.0, 1.0));
+  const vtkm::Id pyramid[5] = { 4, 5, 7, 6, 8 };
+  mesh.AddCell(vtkm::CELL_SHAPE_PYRAMID, pyramid, 5);
+  const vtkm::Id wedge[6] = { 1, 3, 9, 5, 7, 10 };
+  mesh.AddCell(vtkm::CELL_SHAPE_WEDGE, wedge, 6);
+  const vtkm::Id triangle[3] = { 0, 1, 2 };
+  mesh.AddCell(vtkm::CELL_SHAPE_TRIANGLE, triangle, 3);
+
+  RunExternalFaces(mesh.MakeCellSet(), 4 + 4 + 4);
+  vtkm::Id facesOfCell[3] = { 0, 0, 0 };
+  ExternalFacesType cellIds;
+  cellIds.Run(mesh.MakeCellSet());
+  for (vtkm::Id face = 0; face < 12; face++)
+  {
+    facesOfCell[cellIds.GetFaceCellIds().GetPortalConstControl().Get(face)]++;
+  }
+  VTKM_TEST_ASSERT((facesOfCell[0] == 4)
+                   && (facesOfCell[1] == 4)
+                   && (facesOfCell[2] == 4),
+                   "Wrong faces of each cell.");
+}
+
+void TestStructured()
+{
+  std::cout << "Testing external faces of structured cells." << std::endl;
+  vtkm::cont::CellSetStructured<3> cellSet(
+        "cells", vtkm::Extent3(vtkm::Id3(0, 0, 0), vtkm::Id3(3, 3, 3)));
+  RunExternalFaces(cellSet, 6*9);
+}
+
+void TestUnknownNumberOfPoints()
+{
+  std::cout << "Testing external faces of cells without a point count."
+            << std::endl;
+  Mesh mesh = MakeHexahedra(2);
+  vtkm::cont::CellSetExplicit<> cellSet;
+  cellSet.Fill(vtkm::cont::make_ArrayHandle(mesh.Shapes),
+               vtkm::cont::make_ArrayHandle(mesh.NumIndices),
+               vtkm::cont::make_ArrayHandle(mesh.Connectivity));
+  RunExternalFaces(cellSet, 24);
+}
+
+void TestEmpty()
+{
+  std::cout << "Testing external faces of no cells." << std::endl;
+  Mesh mesh = MakeHexahedra(0);
+  RunExternalFaces(mesh.MakeCellSet(), 0);
+}
+
+void TestExternalFaces()
+{
+  TestHexahedra();
+  TestTetrahedra();
+  TestMixedShapes();
+  TestStructured();
+  TestUnknownNumberOfPoints();
+  TestEmpty();
+}
+
+} // anonymous namespace
+
+int UnitTestExternalFaces(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestExternalFaces);
+}
@@ -0,0 +1,262 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/FieldAverage.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::Vec<vtkm::Float32,3> Vec3;
+
+vtkm::Float64 PointValue(vtkm::Id i, vtkm::Id j, vtkm::Id k)
+{
+  return static_cast<vtkm::Float64>(i*i + 3*j + 7*j*k + 11*k);
+}
+
+// Computes the averages of a structured grid with the given point
+// dimensions (1 for the unused axes) one cell and one point at a time.
+void ComputeExpected(const vtkm::Id3 &pointDims,
+                     std::vector<vtkm::Float64> &pointValues,
+                     std::vector<vtkm::Float64> &cellAverages,
+                     std::vector<vtkm::Float64> &cellValues,
+                     std::vector<vtkm::Float64> &pointAverages)
+{
+  vtkm::Id3 cellDims;
+  vtkm::Id3 offset;
+  for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+  {
+    cellDims[axis] = (pointDims[axis] > 1) ? pointDims[axis] - 1 : 1;
+    offset[axis] = (pointDims[axis] > 1) ? 1 : 0;
+  }
+  vtkm::Id numPoints = pointDims[0]*pointDims[1]*pointDims[2];
+  vtkm::Id numCells = cellDims[0]*cellDims[1]*cellDims[2];
+
+  pointValues.resize(static_cast<std::size_t>(numPoints));
+  for (vtkm::Id k = 0; k < pointDims[2]; k++)
+  {
+    for (vtkm::Id j = 0; j < pointDims[1]; j++)
+    {
+      for (vtkm::Id i = 0; i < pointDims[0]; i++)
+      {
+        pointValues[static_cast<std::size_t>(
+              (k*pointDims[1] + j)*pointDims[0] + i)] = PointValue(i, j, k);
+      }
+    }
+  }
+
+  cellAverages.assign(static_cast<std::size_t>(numCells), 0.0);
+  cellValues.resize(static_cast<std::size_t>(numCells));
+  std::vector<vtkm::Float64> sums(static_cast<std::size_t>(numPoints), 0.0);
+  std::vector<vtkm::Id> counts(static_cast<std::size_t>(numPoints), 0);
+  for (vtkm::Id k = 0; k < cellDims[2]; k++)
+  {
+    for (vtkm::Id j = 0; j < cellDims[1]; j++)
+    {
+      for (vtkm::Id i = 0; i < cellDims[0]; i++)
+      {
+        std::size_t cell = static_cast<std::size_t>(
+              (k*cellDims[1] + j)*cellDims[0] + i);
+        cellValues[cell] = PointValue(j, k, i) + 0.5;
+
+        // Collect the distinct points of the cell.
+        std::vector<vtkm::Id> points;
+        for (vtkm::Id corner = 0; corner < 8; corner++)
+        {
+          vtkm::Id point =
+              ((k + offset[2]*((corner/4)%2))*pointDims[1]
+               + j + offset[1]*((corner/2)%2))*pointDims[0]
+              + i + offset[0]*(corner%2);
+          bool found = false;
+          for (std::size_t p = 0; p < points.size(); p++)
+          {
+            found = found || (points[p] == point);
+          }
+          if (!found) { points.push_back(point); }
+        }
+        for (std::size_t p = 0; p < points.size(); p++)
+        {
+          std::size_t point = static_cast<std::size_t>(points[p]);
+          cellAverages[cell] += pointValues[point]/
+              static_cast<vtkm::Float64>(points.size());
+          sums[point] += cellValues[cell];
+          counts[point]++;
+        }
+      }
+    }
+  }
+
+  pointAverages.resize(static_cast<std::size_t>(numPoints));
+  for (std::size_t point = 0; point < sums.size(); point++)
+  {
+    pointAverages[point] =
+        sums[point]/static_cast<vtkm::Float64>(counts[point]);
+  }
+}
+
+template<typename T, typename Storage>
+void CheckValues(const vtkm::cont::ArrayHandle<T,Storage> &result,
+                 const std::vector<vtkm::Float64> &expected)
+{
+  VTKM_TEST_ASSERT(result.GetNumberOfValues() ==
+                   static_cast<vtkm::Id>(expected.size()),
+                   "Wrong number of averaged values.");
+  for (vtkm::Id index = 0; index < result.GetNumberOfValues(); index++)
+  {
+    VTKM_TEST_ASSERT(
+          test_equal(result.GetPortalConstControl().Get(index),
+                     T(static_cast<typename vtkm::VecTraits<T>::ComponentType>(
+                         expected[static_cast<std::size_t>(index)]))),
+          "Wrong average.");
+  }
+}
+
+template<vtkm::IdComponent Dimensions>
+void TestStructured(const vtkm::cont::CellSetStructured<Dimensions> &cellSet,
+                    const vtkm::Id3 &pointDims)
+{
+  std::vector<vtkm::Float64> pointValues;
+  std::vector<vtkm::Float64> cellAverages;
+  std::vector<vtkm::Float64> cellValues;
+  std::vector<vtkm::Float64> pointAverages;
+  ComputeExpected(pointDims, pointValues, cellAverages, cellValues,
+                  pointAverages);
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> cellResult;
+  vtkm::worklet::PointToCellAverage<Device>().Run(
+        cellSet, vtkm::cont::make_ArrayHandle(pointValues), cellResult);
+  CheckValues(cellResult, cellAverages);
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> pointResult;
+  vtkm::worklet::CellToPointAverage<Device>().Run(
+        cellSet, vtkm::cont::make_ArrayHandle(cellValues), pointResult);
+  CheckValues(pointResult, pointAverages);
+
+  // Averages of vectors are taken component by component.
+  std::vector<Vec3> pointVectors;
+  for (std::size_t index = 0; index < pointValues.size(); index++)
+  {
+    pointVectors.push_back(
+          Vec3(static_cast<vtkm::Float32>(pointValues[index])));
+  }
+  vtkm::cont::ArrayHandle<Vec3> vectorResult;
+  vtkm::worklet::PointToCellAverage<Device>().Run(
+        cellSet, vtkm::cont::make_ArrayHandle(pointVectors), vectorResult);
+  CheckValues(vectorResult, cellAverages);
+}
+
+void TestStructured3D()
+{
+  std::cout << "Structured 3D" << std::endl;
+  // More rows than fit in one tile, and a partial last tile.
+  vtkm::Extent3 extent(vtkm::Id3(-2, 0, 1), vtkm::Id3(4, 18, 4));
+  TestStructured(vtkm::cont::CellSetStructured<3>("cells", extent),
+                 vtkm::Id3(7, 19, 4));
+}
+
+void TestStructured2D()
+{
+  std::cout << "Structured 2D" << std::endl;
+  vtkm::Extent2 extent(vtkm::Id2(0, 0), vtkm::Id2(4, 8));
+  TestStructured(vtkm::cont::CellSetStructured<2>("cells", extent),
+                 vtkm::Id3(5, 9, 1));
+}
+
+void TestExplicit()
+{
+  std::cout << "Explicit" << std::endl;
+  // A triangle, a quad, and a triangle in a strip, and a point no cell uses.
+  const vtkm::Id numPoints = 7;
+  const vtkm::Float64 pointValues[numPoints] = { 1, 2, 3, 4, 5, 6, 100 };
+  const vtkm::UInt8 shapes[3] = {
+    vtkm::CELL_SHAPE_TRIANGLE, vtkm::CELL_SHAPE_QUAD, vtkm::CELL_SHAPE_TRIANGLE
+  };
+  const vtkm::IdComponent numIndices[3] = { 3, 4, 3 };
+  const vtkm::Id connectivity[10] = { 0, 1, 2,  1, 3, 4, 2,  3, 5, 4 };
+  const vtkm::Float64 cellValues[3] = { 3, 6, 12 };
+
+  vtkm::cont::CellSetExplicit<> cellSet("cells", numPoints, 2);
+  cellSet.Fill(vtkm::cont::make_ArrayHandle(shapes, 3),
+               vtkm::cont::make_ArrayHandle(numIndices, 3),
+               vtkm::cont::make_ArrayHandle(connectivity, 10));
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> cellResult;
+  vtkm::worklet::PointToCellAverage<Device>().Run(
+        cellSet, vtkm::cont::make_ArrayHandle(pointValues, numPoints),
+        cellResult);
+  std::vector<vtkm::Float64> expected;
+  expected.push_back(2.0);
+  expected.push_back(3.5);
+  expected.push_back(5.0);
+  CheckValues(cellResult, expected);
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> pointResult;
+  vtkm::worklet::CellToPointAverage<Device>().Run(
+        cellSet, vtkm::cont::make_ArrayHandle(cellValues, 3), pointResult);
+  const vtkm::Float64 pointAverages[numPoints] = {
+    3.0, 4.5, 4.5, 9.0, 9.0, 12.0, 0.0 };
+  expected.assign(pointAverages, pointAverages + numPoints);
+  CheckValues(pointResult, expected);
+}
+
+void TestBadInput()
+{
+  std::cout << "Bad input" << std::endl;
+  vtkm::Extent3 extent(vtkm::Id3(0, 0, 0), vtkm::Id3(2, 2, 2));
+  vtkm::cont::CellSetStructured<3> cellSet("cells", extent);
+  std::vector<vtkm::Float64> values(8, 1.0);
+  vtkm::cont::ArrayHandle<vtkm::Float64> result;
+  try
+  {
+    vtkm::worklet::PointToCellAverage<Device>().Run(
+          cellSet, vtkm::cont::make_ArrayHandle(values), result);
+    VTKM_TEST_FAIL("Did not catch point field of the wrong size.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestFieldAverage()
+{
+  TestStructured3D();
+  TestStructured2D();
+  TestExplicit();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestFieldAverage(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestFieldAverage);
+}
@@ -0,0 +1,276 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/Gradient.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::Gradient<Device> GradientType;
+typedef vtkm::Vec<vtkm::Float64,3> Vec3;
+typedef vtkm::Vec<Vec3,3> Tensor;
+
+const vtkm::Id3 DIMENSIONS(6, 5, 4);
+const vtkm::Id NUMBER_OF_POINTS = 120;
+const Vec3 SPACING(0.5, 2.0, 0.25);
+
+// Entry [a][c] is the derivative of component c of VectorValue along a.
+const Tensor JACOBIAN(Vec3(2.0, 0.0, 4.0),
+                      Vec3(3.0, -1.0, 0.0),
+                      Vec3(0.0, 5.0, 1.5));
+
+vtkm::cont::ArrayHandleUniformPointCoordinates MakeCoordinates()
+{
+  typedef vtkm::Vec<vtkm::FloatDefault,3> PointType;
+  return vtkm::cont::ArrayHandleUniformPointCoordinates(
+        vtkm::Extent3(vtkm::Id3(0), DIMENSIONS - vtkm::Id3(1)),
+        PointType(1.0f, -2.0f, 0.0f),
+        PointType(static_cast<vtkm::FloatDefault>(SPACING[0]),
+                  static_cast<vtkm::FloatDefault>(SPACING[1]),
+                  static_cast<vtkm::FloatDefault>(SPACING[2])));
+}
+
+Vec3 GetPoint(vtkm::Id index)
+{
+  vtkm::Id i = index % DIMENSIONS[0];
+  vtkm::Id j = (index / DIMENSIONS[0]) % DIMENSIONS[1];
+  vtkm::Id k = index / (DIMENSIONS[0]*DIMENSIONS[1]);
+  return Vec3(1.0 + SPACING[0]*static_cast<vtkm::Float64>(i),
+              -2.0 + SPACING[1]*static_cast<vtkm::Float64>(j),
+              SPACING[2]*static_cast<vtkm::Float64>(k));
+}
+
+bool TensorEqual(const Tensor &tensor1, const Tensor &tensor2)
+{
+  return test_equal(tensor1[0], tensor2[0])
+      && test_equal(tensor1[1], tensor2[1])
+      && test_equal(tensor1[2], tensor2[2]);
+}
+
+Vec3 VectorValue(const Vec3 &point)
+{
+  Vec3 value(0.0);
+  for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+  {
+    value = value + JACOBIAN[axis]*point[axis];
+  }
+  return value;
+}
+
+void TestScalarUniform()
+{
+  std::cout << "Scalar field on a uniform grid" << std::endl;
+  // x^2 + 3y - z, whose central differences are exact inside the grid.
+  std::vector<vtkm::Float64> values;
+  for (vtkm::Id index = 0; index < NUMBER_OF_POINTS; index++)
+  {
+    Vec3 point = GetPoint(index);
+    values.push_back(point[0]*point[0] + 3.0*point[1] - point[2]);
+  }
+
+  vtkm::cont::ArrayHandle<Vec3> gradient;
+  GradientType().Run(MakeCoordinates(),
+                     vtkm::cont::make_ArrayHandle(values),
+                     gradient);
+  VTKM_TEST_ASSERT(gradient.GetNumberOfValues() == NUMBER_OF_POINTS,
+                   "Wrong number of gradients.");
+
+  for (vtkm::Id index = 0; index < NUMBER_OF_POINTS; index++)
+  {
+    Vec3 point = GetPoint(index);
+    vtkm::Id i = index % DIMENSIONS[0];
+    // One-sided differences of x^2 give the derivative half a step in.
+    vtkm::Float64 dx = 2.0*point[0];
+    if (i == 0) { dx += SPACING[0]; }
+    if (i == DIMENSIONS[0] - 1) { dx -= SPACING[0]; }
+    VTKM_TEST_ASSERT(
+          test_equal(gradient.GetPortalConstControl().Get(index),
+                     Vec3(dx, 3.0, -1.0)),
+          "Wrong gradient of scalar field.");
+  }
+}
+
+void TestVectorUniform()
+{
+  std::cout << "Vector field on a uniform grid" << std::endl;
+  std::vector<Vec3> values;
+  for (vtkm::Id index = 0; index < NUMBER_OF_POINTS; index++)
+  {
+    values.push_back(VectorValue(GetPoint(index)));
+  }
+  vtkm::cont::ArrayHandle<Vec3> field = vtkm::cont::make_ArrayHandle(values);
+
+  const Vec3 expectedVorticity(JACOBIAN[1][2] - JACOBIAN[2][1],
+                               JACOBIAN[2][0] - JACOBIAN[0][2],
+                               JACOBIAN[0][1] - JACOBIAN[1][0]);
+  const vtkm::Float64 expectedDivergence =
+      JACOBIAN[0][0] + JACOBIAN[1][1] + JACOBIAN[2][2];
+  // Q = (|Omega|^2 - |S|^2)/2 with S and Omega the symmetric and
+  // antisymmetric parts of the velocity gradient.
+  vtkm::Float64 strain = 0.0;
+  vtkm::Float64 rotation = 0.0;
+  for (vtkm::IdComponent i = 0; i < 3; i++)
+  {
+    for (vtkm::IdComponent j = 0; j < 3; j++)
+    {
+      vtkm::Float64 s = 0.5*(JACOBIAN[i][j] + JACOBIAN[j][i]);
+      vtkm::Float64 o = 0.5*(JACOBIAN[i][j] - JACOBIAN[j][i]);
+      strain += s*s;
+      rotation += o*o;
+    }
+  }
+  const vtkm::Float64 expectedQCriterion = 0.5*(rotation - strain);
+
+  GradientType gradientFilter;
+  gradientFilter.SetComputeVorticity(true);
+  gradientFilter.SetComputeDivergence(true);
+  gradientFilter.SetComputeQCriterion(true);
+  vtkm::cont::ArrayHandle<Tensor> gradient;
+  vtkm::cont::ArrayHandle<Vec3> vorticity;
+  vtkm::cont::ArrayHandle<vtkm::Float64> divergence;
+  vtkm::cont::ArrayHandle<vtkm::Float64> qCriterion;
+  gradientFilter.Run(MakeCoordinates(), field,
+                     gradient, vorticity, divergence, qCriterion);
+  VTKM_TEST_ASSERT(qCriterion.GetNumberOfValues() == NUMBER_OF_POINTS,
+                   "Wrong number of Q-criterion values.");
+  for (vtkm::Id index = 0; index < NUMBER_OF_POINTS; index++)
+  {
+    VTKM_TEST_ASSERT(TensorEqual(gradient.GetPortalConstControl().Get(index),
+                                 JACOBIAN),
+                     "Wrong gradient of vector field.");
+    VTKM_TEST_ASSERT(test_equal(vorticity.GetPortalConstControl().Get(index),
+                                expectedVorticity),
+                     "Wrong vorticity.");
+    VTKM_TEST_ASSERT(
+          test_equal(divergence.GetPortalConstControl().Get(index),
+                     expectedDivergence),
+          "Wrong divergence.");
+    VTKM_TEST_ASSERT(
+          test_equal(qCriterion.GetPortalConstControl().Get(index),
+                     expectedQCriterion),
+          "Wrong Q-criterion.");
+  }
+
+  std::cout << "Only the Q-criterion" << std::endl;
+  gradientFilter.SetComputeGradient(false);
+  gradientFilter.SetComputeVorticity(false);
+  gradientFilter.SetComputeDivergence(false);
+  vtkm::cont::ArrayHandle<Tensor> unusedGradient;
+  vtkm::cont::ArrayHandle<Vec3> unusedVorticity;
+  vtkm::cont::ArrayHandle<vtkm::Float64> unusedDivergence;
+  gradientFilter.Run(MakeCoordinates(), field,
+                     unusedGradient, unusedVorticity, unusedDivergence,
+                     qCriterion);
+  VTKM_TEST_ASSERT(unusedGradient.GetNumberOfValues() == 0,
+                   "Gradient was written without being asked for.");
+  VTKM_TEST_ASSERT(unusedDivergence.GetNumberOfValues() == 0,
+                   "Divergence was written without being asked for.");
+  VTKM_TEST_ASSERT(qCriterion.GetNumberOfValues() == NUMBER_OF_POINTS,
+                   "Wrong number of Q-criterion values.");
+  VTKM_TEST_ASSERT(test_equal(qCriterion.GetPortalConstControl().Get(7),
+                              expectedQCriterion),
+                   "Wrong Q-criterion.");
+
+  // The three argument version gives the same gradient.
+  vtkm::cont::ArrayHandle<Tensor> plainGradient;
+  GradientType().Run(MakeCoordinates(), field, plainGradient);
+  VTKM_TEST_ASSERT(
+        TensorEqual(plainGradient.GetPortalConstControl().Get(33), JACOBIAN),
+        "Wrong gradient of vector field.");
+}
+
+void TestRectilinear()
+{
+  std::cout << "Rectilinear grid" << std::endl;
+  const vtkm::Float32 xCoordinates[5] = { 0.0f, 1.0f, 3.0f, 6.0f, 10.0f };
+  const vtkm::Float32 yCoordinates[2] = { 0.0f, 0.5f };
+  const vtkm::Float32 zCoordinates[1] = { 4.0f };
+
+  // A linear field has exact differences however the points are spaced.
+  std::vector<vtkm::Float32> values;
+  for (vtkm::Id j = 0; j < 2; j++)
+  {
+    for (vtkm::Id i = 0; i < 5; i++)
+    {
+      values.push_back(3.0f*xCoordinates[i] - 2.0f*yCoordinates[j]);
+    }
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Float32,3> > gradient;
+  GradientType().Run(vtkm::cont::make_ArrayHandle(xCoordinates, 5),
+                     vtkm::cont::make_ArrayHandle(yCoordinates, 2),
+                     vtkm::cont::make_ArrayHandle(zCoordinates, 1),
+                     vtkm::cont::make_ArrayHandle(values),
+                     gradient);
+  VTKM_TEST_ASSERT(gradient.GetNumberOfValues() == 10,
+                   "Wrong number of gradients.");
+  for (vtkm::Id index = 0; index < 10; index++)
+  {
+    // The grid is flat in z, so that derivative is zero.
+    VTKM_TEST_ASSERT(
+          test_equal(gradient.GetPortalConstControl().Get(index),
+                     vtkm::Vec<vtkm::Float32,3>(3.0f, -2.0f, 0.0f)),
+          "Wrong gradient on rectilinear grid.");
+  }
+}
+
+void TestBadInput()
+{
+  std::cout << "Bad input" << std::endl;
+  std::vector<vtkm::Float64> values(10, 1.0);
+  vtkm::cont::ArrayHandle<Vec3> gradient;
+  try
+  {
+    GradientType().Run(MakeCoordinates(),
+                       vtkm::cont::make_ArrayHandle(values),
+                       gradient);
+    VTKM_TEST_FAIL("Did not catch field of the wrong size.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestGradient()
+{
+  TestScalarUniform();
+  TestVectorUniform();
+  TestRectilinear();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestGradient(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestGradient);
+}
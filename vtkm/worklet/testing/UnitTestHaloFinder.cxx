@@ -0,0 +1,252 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/HaloFinder.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::HaloFinder<Device> HaloFinderType;
+typedef vtkm::Vec<vtkm::Float32,3> Vec3;
+using vtkm::worklet::testing::Random;
+
+// Clumps of particles scattered in a box, with some loose particles.
+std::vector<Vec3> MakeParticles(Random &random)
+{
+  std::vector<Vec3> particles;
+  for (vtkm::Id clump = 0; clump < 12; clump++)
+  {
+    Vec3 center(10.0f*random.Next(), 10.0f*random.Next(),
+                10.0f*random.Next());
+    vtkm::Float32 size = 0.2f + 0.6f*random.Next();
+    for (vtkm::Id index = 0; index < 5 + clump*7; index++)
+    {
+      particles.push_back(center + Vec3(size*(random.Next() - 0.5f),
+                                        size*(random.Next() - 0.5f),
+                                        size*(random.Next() - 0.5f)));
+    }
+  }
+  for (vtkm::Id index = 0; index < 200; index++)
+  {
+    particles.push_back(Vec3(10.0f*random.Next(), 10.0f*random.Next(),
+                             10.0f*random.Next()));
+  }
+  return particles;
+}
+
+vtkm::Id FindRoot(std::vector<vtkm::Id> &parents, vtkm::Id point)
+{
+  while (parents[static_cast<std::size_t>(point)] != point)
+  {
+    point = parents[static_cast<std::size_t>(point)];
+  }
+  return point;
+}
+
+// Groups the particles by checking every pair and numbers the halos by
+// their smallest particle id.
+void FindHalos(const std::vector<Vec3> &particles,
+               vtkm::Float32 linkingLength,
+               vtkm::Id minimumHaloSize,
+               std::vector<vtkm::Id> &haloIds,
+               std::vector<vtkm::Id> &haloCounts)
+{
+  std::size_t numParticles = particles.size();
+  std::vector<vtkm::Id> parents(numParticles);
+  for (std::size_t index = 0; index < numParticles; index++)
+  {
+    parents[index] = static_cast<vtkm::Id>(index);
+  }
+  for (std::size_t index1 = 0; index1 < numParticles; index1++)
+  {
+    for (std::size_t index2 = index1 + 1; index2 < numParticles; index2++)
+    {
+      Vec3 difference = particles[index1] - particles[index2];
+      if (vtkm::dot(difference, difference) <= linkingLength*linkingLength)
+      {
+        vtkm::Id root1 = FindRoot(parents, static_cast<vtkm::Id>(index1));
+        vtkm::Id root2 = FindRoot(parents, static_cast<vtkm::Id>(index2));
+        if (root1 < root2)
+        {
+          parents[static_cast<std::size_t>(root2)] = root1;
+        }
+        else
+        {
+          parents[static_cast<std::size_t>(root1)] = root2;
+        }
+      }
+    }
+  }
+
+  std::vector<vtkm::Id> sizes(numParticles, 0);
+  for (std::size_t index = 0; index < numParticles; index++)
+  {
+    sizes[static_cast<std::size_t>(
+            FindRoot(parents, static_cast<vtkm::Id>(index)))]++;
+  }
+  std::vector<vtkm::Id> rootHalos(numParticles, -1);
+  haloCounts.clear();
+  for (std::size_t index = 0; index < numParticles; index++)
+  {
+    if ((sizes[index] > 0) && (sizes[index] >= minimumHaloSize))
+    {
+      rootHalos[index] = static_cast<vtkm::Id>(haloCounts.size());
+      haloCounts.push_back(sizes[index]);
+    }
+  }
+  haloIds.resize(numParticles);
+  for (std::size_t index = 0; index < numParticles; index++)
+  {
+    haloIds[index] = rootHalos[static_cast<std::size_t>(
+          FindRoot(parents, static_cast<vtkm::Id>(index)))];
+  }
+}
+
+void CheckHalos(const HaloFinderType &haloFinder,
+                const std::vector<Vec3> &particles,
+                vtkm::Float32 linkingLength)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> haloIds;
+  vtkm::cont::ArrayHandle<vtkm::Id> haloCounts;
+  haloFinder.Run(vtkm::cont::make_ArrayHandle(particles),
+                 linkingLength,
+                 haloIds,
+                 haloCounts);
+
+  std::vector<vtkm::Id> expectedIds;
+  std::vector<vtkm::Id> expectedCounts;
+  FindHalos(particles,
+            linkingLength,
+            haloFinder.GetMinimumHaloSize(),
+            expectedIds,
+            expectedCounts);
+  std::cout << "  " << expectedCounts.size() << " halos" << std::endl;
+
+  VTKM_TEST_ASSERT(haloCounts.GetNumberOfValues() ==
+                   static_cast<vtkm::Id>(expectedCounts.size()),
+                   "Wrong number of halos.");
+  for (std::size_t halo = 0; halo < expectedCounts.size(); halo++)
+  {
+    VTKM_TEST_ASSERT(haloCounts.GetPortalConstControl().Get(
+                       static_cast<vtkm::Id>(halo)) == expectedCounts[halo],
+                     "Wrong number of particles in halo.");
+  }
+  VTKM_TEST_ASSERT(haloIds.GetNumberOfValues() ==
+                   static_cast<vtkm::Id>(particles.size()),
+                   "Wrong number of halo ids.");
+  for (std::size_t index = 0; index < particles.size(); index++)
+  {
+    VTKM_TEST_ASSERT(haloIds.GetPortalConstControl().Get(
+                       static_cast<vtkm::Id>(index)) == expectedIds[index],
+                     "Wrong halo id.");
+  }
+}
+
+void TestClumps()
+{
+  std::cout << "Clumps of particles" << std::endl;
+  Random random;
+  std::vector<Vec3> particles = MakeParticles(random);
+  HaloFinderType haloFinder;
+  CheckHalos(haloFinder, particles, 0.1f);
+  CheckHalos(haloFinder, particles, 0.5f);
+
+  std::cout << "Minimum halo size" << std::endl;
+  haloFinder.SetMinimumHaloSize(10);
+  CheckHalos(haloFinder, particles, 0.1f);
+  CheckHalos(haloFinder, particles, 0.5f);
+
+  std::cout << "Linking length larger than the box" << std::endl;
+  CheckHalos(haloFinder, particles, 20.0f);
+}
+
+void TestCoincidentParticles()
+{
+  std::cout << "Coincident particles" << std::endl;
+  // Particles on a line, with every particle twice, so a linking length of
+  // zero only joins the copies.
+  std::vector<Vec3> particles;
+  for (vtkm::Id copy = 0; copy < 2; copy++)
+  {
+    for (vtkm::Id index = 0; index < 50; index++)
+    {
+      particles.push_back(Vec3(static_cast<vtkm::Float32>(index), 0, 0));
+    }
+  }
+  HaloFinderType haloFinder;
+  CheckHalos(haloFinder, particles, 0.0f);
+  CheckHalos(haloFinder, particles, 1.0f);
+}
+
+void TestNoParticles()
+{
+  std::cout << "No particles" << std::endl;
+  std::vector<Vec3> particles;
+  HaloFinderType haloFinder;
+  CheckHalos(haloFinder, particles, 1.0f);
+}
+
+void TestBadInput()
+{
+  std::cout << "Bad input" << std::endl;
+  Random random;
+  std::vector<Vec3> particles = MakeParticles(random);
+  HaloFinderType haloFinder;
+  vtkm::cont::ArrayHandle<vtkm::Id> haloIds;
+  vtkm::cont::ArrayHandle<vtkm::Id> haloCounts;
+  try
+  {
+    haloFinder.Run(vtkm::cont::make_ArrayHandle(particles),
+                   -1.0f,
+                   haloIds,
+                   haloCounts);
+    VTKM_TEST_FAIL("Did not catch negative linking length.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestHaloFinder()
+{
+  TestClumps();
+  TestCoincidentParticles();
+  TestNoParticles();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestHaloFinder(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestHaloFinder);
+}
@@ -0,0 +1,319 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/IsosurfaceUniformGrid.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::IsosurfaceUniformGrid<Device> IsosurfaceType;
+typedef IsosurfaceType::PointType PointType;
+
+const vtkm::Id3 DIMENSIONS(20, 20, 20);
+const PointType CENTER(9.5f, 9.3f, 9.1f);
+const vtkm::Float32 RADIUS = 6.0f;
+
+vtkm::cont::ArrayHandleUniformPointCoordinates MakeCoordinates(
+    const vtkm::Id3 &dimensions)
+{
+  return vtkm::cont::ArrayHandleUniformPointCoordinates(
+        vtkm::Extent3(vtkm::Id3(0, 0, 0), dimensions - vtkm::Id3(1, 1, 1)),
+        PointType(0.0f, 0.0f, 0.0f),
+        PointType(1.0f, 1.0f, 1.0f));
+}
+
+vtkm::Float32 Distance(const PointType &a, const PointType &b)
+{
+  PointType difference = a - b;
+  return static_cast<vtkm::Float32>(std::sqrt(
+        difference[0]*difference[0] +
+        difference[1]*difference[1] +
+        difference[2]*difference[2]));
+}
+
+vtkm::cont::ArrayHandle<vtkm::Float32> MakeSphereField(
+    const vtkm::cont::ArrayHandleUniformPointCoordinates &coordinates)
+{
+  vtkm::Id numPoints = coordinates.GetNumberOfValues();
+  std::vector<vtkm::Float32> values(static_cast<std::size_t>(numPoints));
+  for (vtkm::Id index = 0; index < numPoints; index++)
+  {
+    values[static_cast<std::size_t>(index)] =
+        Distance(coordinates.GetPortalConstControl().Get(index), CENTER);
+  }
+  vtkm::cont::ArrayHandle<vtkm::Float32> field;
+  vtkm::cont::DeviceAdapterAlgorithm<Device>::Copy(
+        vtkm::cont::make_ArrayHandle(values), field);
+  return field;
+}
+
+PointType TriangleNormal(const PointType &p0,
+                         const PointType &p1,
+                         const PointType &p2)
+{
+  PointType a = p1 - p0;
+  PointType b = p2 - p0;
+  return PointType(a[1]*b[2] - a[2]*b[1],
+                   a[2]*b[0] - a[0]*b[2],
+                   a[0]*b[1] - a[1]*b[0]);
+}
+
+void TestSphere()
+{
+  std::cout << "Testing isosurface of a sphere." << std::endl;
+  vtkm::cont::ArrayHandleUniformPointCoordinates coordinates =
+      MakeCoordinates(DIMENSIONS);
+  vtkm::cont::ArrayHandle<vtkm::Float32> field = MakeSphereField(coordinates);
+
+  vtkm::cont::ArrayHandle<PointType> points;
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  IsosurfaceType().Run(coordinates, field, RADIUS, points, connectivity);
+
+  vtkm::Id numTriangles = connectivity.GetNumberOfValues()/3;
+  vtkm::Id numPoints = points.GetNumberOfValues();
+  std::cout << "  " << numTriangles << " triangles, " << numPoints
+            << " points" << std::endl;
+  VTKM_TEST_ASSERT(numTriangles > 0, "No triangles generated.");
+  VTKM_TEST_ASSERT(connectivity.GetNumberOfValues() == 3*numTriangles,
+                   "Connectivity is not made of triangles.");
+
+  vtkm::cont::ArrayHandle<PointType>::PortalConstControl pointPortal =
+      points.GetPortalConstControl();
+  for (vtkm::Id index = 0; index < numPoints; index++)
+  {
+    VTKM_TEST_ASSERT(
+          std::fabs(Distance(pointPortal.Get(index), CENTER) - RADIUS) < 0.1f,
+          "Point is not on the sphere.");
+  }
+
+  std::cout << "Checking that the surface is closed and oriented."
+            << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Id>::PortalConstControl connectivityPortal =
+      connectivity.GetPortalConstControl();
+  std::map<std::pair<vtkm::Id,vtkm::Id>, vtkm::Id> directedEdges;
+  for (vtkm::Id triangle = 0; triangle < numTriangles; triangle++)
+  {
+    vtkm::Id ids[3];
+    for (vtkm::IdComponent vertex = 0; vertex < 3; vertex++)
+    {
+      ids[vertex] = connectivityPortal.Get(3*triangle + vertex);
+      VTKM_TEST_ASSERT((ids[vertex] >= 0) && (ids[vertex] < numPoints),
+                       "Bad point index.");
+    }
+    for (vtkm::IdComponent vertex = 0; vertex < 3; vertex++)
+    {
+      directedEdges[std::make_pair(ids[vertex], ids[(vertex+1)%3])]++;
+    }
+
+    // The field increases away from the center, so the normals point in.
+    PointType normal = TriangleNormal(pointPortal.Get(ids[0]),
+                                      pointPortal.Get(ids[1]),
+                                      pointPortal.Get(ids[2]));
+    PointType outward = pointPortal.Get(ids[0]) - CENTER;
+    VTKM_TEST_ASSERT(vtkm::dot(normal, outward) <= 0.0f,
+                     "Triangle wound the wrong way.");
+  }
+
+  // In a closed, consistently oriented surface, every edge is used once in
+  // each direction.
+  for (std::map<std::pair<vtkm::Id,vtkm::Id>, vtkm::Id>::iterator edge =
+         directedEdges.begin();
+       edge != directedEdges.end();
+       edge++)
+  {
+    VTKM_TEST_ASSERT(edge->second == 1, "Edge used twice in one direction.");
+    VTKM_TEST_ASSERT(directedEdges.count(std::make_pair(edge->first.second,
+                                                        edge->first.first))
+                     == 1,
+                     "Surface has a boundary.");
+  }
+  vtkm::Id numEdges = static_cast<vtkm::Id>(directedEdges.size())/2;
+  VTKM_TEST_ASSERT(numPoints - numEdges + numTriangles == 2,
+                   "Surface is not a sphere.");
+
+  std::cout << "Checking output without merging points." << std::endl;
+  IsosurfaceType noMerge;
+  noMerge.SetMergeDuplicatePoints(false);
+  vtkm::cont::ArrayHandle<PointType> unmergedPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> unmergedConnectivity;
+  noMerge.Run(coordinates,
+              field,
+              RADIUS,
+              unmergedPoints,
+              unmergedConnectivity);
+  VTKM_TEST_ASSERT(unmergedConnectivity.GetNumberOfValues() == 3*numTriangles,
+                   "Merging changed the number of triangles.");
+  VTKM_TEST_ASSERT(unmergedPoints.GetNumberOfValues() == 3*numTriangles,
+                   "Wrong number of unmerged points.");
+  for (vtkm::Id index = 0; index < 3*numTriangles; index++)
+  {
+    VTKM_TEST_ASSERT(
+          unmergedConnectivity.GetPortalConstControl().Get(index) == index,
+          "Unmerged connectivity is not sequential.");
+    VTKM_TEST_ASSERT(
+          unmergedPoints.GetPortalConstControl().Get(index) ==
+          pointPortal.Get(connectivityPortal.Get(index)),
+          "Merged point differs from triangle vertex.");
+  }
+}
+
+void TestMultipleIsoValues()
+{
+  std::cout << "Testing several isovalues in one pass." << std::endl;
+  vtkm::cont::ArrayHandleUniformPointCoordinates coordinates =
+      MakeCoordinates(DIMENSIONS);
+  vtkm::cont::ArrayHandle<vtkm::Float32> field = MakeSphereField(coordinates);
+
+  const vtkm::Float32 isoValueArray[3] = { RADIUS, 3.5f, 100.0f };
+  vtkm::cont::ArrayHandle<vtkm::Float32> isoValues =
+      vtkm::cont::make_ArrayHandle(isoValueArray, 3);
+
+  IsosurfaceType isosurface;
+  vtkm::cont::ArrayHandle<PointType> points;
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> isoValueIndices;
+  isosurface.Run(coordinates,
+                 field,
+                 isoValues,
+                 points,
+                 connectivity,
+                 isoValueIndices);
+
+  vtkm::Id numTriangles = isoValueIndices.GetNumberOfValues();
+  VTKM_TEST_ASSERT(connectivity.GetNumberOfValues() == 3*numTriangles,
+                   "Wrong number of isovalue indices.");
+
+  vtkm::Id trianglesPerIsoValue[3] = { 0, 0, 0 };
+  for (vtkm::Id triangle = 0; triangle < numTriangles; triangle++)
+  {
+    vtkm::IdComponent isoIndex =
+        isoValueIndices.GetPortalConstControl().Get(triangle);
+    VTKM_TEST_ASSERT((isoIndex >= 0) && (isoIndex < 3), "Bad isovalue index.");
+    trianglesPerIsoValue[isoIndex]++;
+    vtkm::Id pointIndex = connectivity.GetPortalConstControl().Get(3*triangle);
+    VTKM_TEST_ASSERT(
+          std::fabs(Distance(points.GetPortalConstControl().Get(pointIndex),
+                             CENTER)
+                    - isoValueArray[isoIndex]) < 0.1f,
+          "Triangle not on the surface of its isovalue.");
+  }
+
+  for (vtkm::IdComponent isoIndex = 0; isoIndex < 3; isoIndex++)
+  {
+    vtkm::cont::ArrayHandle<PointType> singlePoints;
+    vtkm::cont::ArrayHandle<vtkm::Id> singleConnectivity;
+    isosurface.Run(coordinates,
+                   field,
+                   isoValueArray[isoIndex],
+                   singlePoints,
+                   singleConnectivity);
+    VTKM_TEST_ASSERT(singleConnectivity.GetNumberOfValues()
+                     == 3*trianglesPerIsoValue[isoIndex],
+                     "Isovalues in one pass differ from separate passes.");
+  }
+  VTKM_TEST_ASSERT(trianglesPerIsoValue[2] == 0,
+                   "Isovalue outside of the field made triangles.");
+}
+
+void TestPlane()
+{
+  std::cout << "Testing isosurface of a linear field." << std::endl;
+  const vtkm::Id3 dimensions(6, 4, 3);
+  vtkm::cont::ArrayHandleUniformPointCoordinates coordinates =
+      MakeCoordinates(dimensions);
+  std::vector<vtkm::Id> values;
+  for (vtkm::Id index = 0; index < coordinates.GetNumberOfValues(); index++)
+  {
+    values.push_back(index % dimensions[0]);
+  }
+
+  vtkm::cont::ArrayHandle<PointType> points;
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  IsosurfaceType().Run(coordinates,
+                       vtkm::cont::make_ArrayHandle(values),
+                       vtkm::Id(3),
+                       points,
+                       connectivity);
+
+  // Corners at the isovalue are inside, so the surface is the plane x = 3
+  // cut through the cells to the left of it.
+  VTKM_TEST_ASSERT(connectivity.GetNumberOfValues() == 3*2*(3*2),
+                   "Wrong number of triangles.");
+  VTKM_TEST_ASSERT(points.GetNumberOfValues() == 4*3,
+                   "Wrong number of merged points.");
+  for (vtkm::Id index = 0; index < points.GetNumberOfValues(); index++)
+  {
+    VTKM_TEST_ASSERT(
+          test_equal(points.GetPortalConstControl().Get(index)[0], 3.0f),
+          "Point not on the plane.");
+  }
+}
+
+void TestBadField()
+{
+  std::cout << "Testing field of the wrong size." << std::endl;
+  vtkm::cont::ArrayHandleUniformPointCoordinates coordinates =
+      MakeCoordinates(DIMENSIONS);
+  std::vector<vtkm::Float32> values(10, 1.0f);
+  vtkm::cont::ArrayHandle<PointType> points;
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  try
+  {
+    IsosurfaceType().Run(coordinates,
+                         vtkm::cont::make_ArrayHandle(values),
+                         1.0f,
+                         points,
+                         connectivity);
+    VTKM_TEST_FAIL("Did not catch field of the wrong size.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue error)
+  {
+    std::cout << "  Caught expected error: " << error.GetMessage()
+              << std::endl;
+  }
+}
+
+void TestIsosurfaceUniformGrid()
+{
+  TestSphere();
+  TestMultipleIsoValues();
+  TestPlane();
+  TestBadField();
+}
+
+} // anonymous namespace
+
+int UnitTestIsosurfaceUniformGrid(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestIsosurfaceUniformGrid);
+}
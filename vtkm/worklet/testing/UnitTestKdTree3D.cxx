@@ -0,0 +1,315 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/KdTree3D.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/internal/PointDistance.h>
+#include <vtkm/worklet/testing/Testing.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::KdTree3D<Device> TreeType;
+typedef vtkm::Vec<vtkm::Float32,3> Vec3;
+using vtkm::worklet::testing::Random;
+using vtkm::worklet::internal::Distance2;
+
+const vtkm::Id NUMBER_OF_POINTS = 500;
+const vtkm::Id NUMBER_OF_QUERIES = 100;
+
+// Points in the box [0,4]x[0,2]x[0,1], or on the plane z = 0.5.
+std::vector<Vec3> MakePoints(vtkm::Id count, Random &random, bool flat)
+{
+  std::vector<Vec3> points;
+  for (vtkm::Id index = 0; index < count; index++)
+  {
+    vtkm::Float32 x = 4.0f*random.Next();
+    vtkm::Float32 y = 2.0f*random.Next();
+    vtkm::Float32 z = flat ? 0.5f : random.Next();
+    points.push_back(Vec3(x, y, z));
+  }
+  return points;
+}
+
+void CheckQueries(const TreeType &tree,
+                  const std::vector<Vec3> &points,
+                  const std::vector<Vec3> &queries,
+                  vtkm::IdComponent k,
+                  vtkm::FloatDefault radius)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> nearestIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances2;
+  tree.FindNearestNeighbors(vtkm::cont::make_ArrayHandle(queries),
+                            k,
+                            nearestIds,
+                            distances2);
+  VTKM_TEST_ASSERT(nearestIds.GetNumberOfValues() ==
+                   static_cast<vtkm::Id>(queries.size())*k,
+                   "Wrong number of nearest neighbors.");
+
+  vtkm::cont::ArrayHandle<vtkm::Id> counts;
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  tree.FindInRadius(vtkm::cont::make_ArrayHandle(queries),
+                    radius,
+                    counts,
+                    offsets,
+                    neighborIds);
+
+  for (std::size_t query = 0; query < queries.size(); query++)
+  {
+    vtkm::Id index = static_cast<vtkm::Id>(query);
+
+    std::vector<std::pair<vtkm::Float32,vtkm::Id> > expectedNearest;
+    std::vector<vtkm::Id> expectedNeighbors;
+    for (std::size_t point = 0; point < points.size(); point++)
+    {
+      vtkm::Float32 distance2 = Distance2(queries[query], points[point]);
+      expectedNearest.push_back(
+            std::make_pair(distance2, static_cast<vtkm::Id>(point)));
+      if (distance2 <= radius*radius)
+      {
+        expectedNeighbors.push_back(static_cast<vtkm::Id>(point));
+      }
+    }
+    std::sort(expectedNearest.begin(), expectedNearest.end());
+
+    // Points at the same distance may come in either order when rounding
+    // differs, so check the distances and that each id is at its distance.
+    std::vector<vtkm::Id> nearest;
+    for (vtkm::IdComponent slot = 0; slot < k; slot++)
+    {
+      vtkm::Id id = nearestIds.GetPortalConstControl().Get(index*k + slot);
+      if (static_cast<std::size_t>(slot) >= points.size())
+      {
+        VTKM_TEST_ASSERT(id == -1, "Missing neighbor should have id -1.");
+        continue;
+      }
+      VTKM_TEST_ASSERT((id >= 0) &&
+                       (id < static_cast<vtkm::Id>(points.size())),
+                       "Bad nearest neighbor id.");
+      vtkm::FloatDefault distance2 =
+          distances2.GetPortalConstControl().Get(index*k + slot);
+      VTKM_TEST_ASSERT(test_equal(distance2, expectedNearest[slot].first),
+                       "Wrong distance to nearest neighbor.");
+      VTKM_TEST_ASSERT(test_equal(distance2,
+                                  Distance2(queries[query],
+                                            points[static_cast<std::size_t>(
+                                                     id)])),
+                       "Nearest neighbor not at its distance.");
+      nearest.push_back(id);
+    }
+    std::sort(nearest.begin(), nearest.end());
+    VTKM_TEST_ASSERT(std::unique(nearest.begin(), nearest.end())
+                     == nearest.end(),
+                     "Nearest neighbor found twice.");
+
+    vtkm::Id count = counts.GetPortalConstControl().Get(index);
+    VTKM_TEST_ASSERT(count == static_cast<vtkm::Id>(expectedNeighbors.size()),
+                     "Wrong number of points in radius.");
+    std::vector<vtkm::Id> neighbors;
+    for (vtkm::Id entry = 0; entry < count; entry++)
+    {
+      neighbors.push_back(neighborIds.GetPortalConstControl().Get(
+                            offsets.GetPortalConstControl().Get(index)
+                            + entry));
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    VTKM_TEST_ASSERT(neighbors == expectedNeighbors,
+                     "Wrong points in radius.");
+  }
+}
+
+void TestScatteredPoints()
+{
+  std::cout << "Scattered points" << std::endl;
+  Random random;
+  std::vector<Vec3> points = MakePoints(NUMBER_OF_POINTS, random, false);
+  std::vector<Vec3> queries = MakePoints(NUMBER_OF_QUERIES, random, false);
+  // Queries outside the bounds of the points.
+  queries.push_back(Vec3(-3.0f, 1.0f, 0.5f));
+  queries.push_back(Vec3(9.0f, -4.0f, 2.0f));
+  // A query on one of the points.
+  queries.push_back(points[17]);
+
+  TreeType tree;
+  tree.Build(vtkm::cont::make_ArrayHandle(points));
+  VTKM_TEST_ASSERT(tree.GetDepth() == 6, "Wrong depth of tree.");
+  CheckQueries(tree, points, queries, 5, 0.4f);
+
+  std::cout << "Unsorted queries" << std::endl;
+  tree.SetSortQueries(false);
+  CheckQueries(tree, points, queries, 3, 0.3f);
+
+  std::cout << "One point per leaf" << std::endl;
+  TreeType smallLeaves;
+  smallLeaves.SetLeafSize(1);
+  smallLeaves.Build(vtkm::cont::make_ArrayHandle(points));
+  CheckQueries(smallLeaves, points, queries, 1, 0.25f);
+
+  std::cout << "One leaf" << std::endl;
+  TreeType oneLeaf;
+  oneLeaf.SetLeafSize(NUMBER_OF_POINTS);
+  oneLeaf.Build(vtkm::cont::make_ArrayHandle(points));
+  VTKM_TEST_ASSERT(oneLeaf.GetDepth() == 0, "Wrong depth of tree.");
+  CheckQueries(oneLeaf, points, queries, 4, 0.4f);
+}
+
+void TestFlatPoints()
+{
+  std::cout << "Points on a plane" << std::endl;
+  Random random;
+  std::vector<Vec3> points = MakePoints(NUMBER_OF_POINTS, random, true);
+  std::vector<Vec3> queries = MakePoints(NUMBER_OF_QUERIES, random, false);
+  TreeType tree;
+  tree.Build(vtkm::cont::make_ArrayHandle(points));
+  CheckQueries(tree, points, queries, 6, 0.6f);
+}
+
+void TestFewPoints()
+{
+  std::cout << "Fewer points than neighbors" << std::endl;
+  Random random;
+  std::vector<Vec3> points = MakePoints(5, random, false);
+  std::vector<Vec3> queries = MakePoints(10, random, false);
+  TreeType tree;
+  tree.Build(vtkm::cont::make_ArrayHandle(points));
+  CheckQueries(tree, points, queries, 8, 1.0f);
+
+  std::cout << "No points" << std::endl;
+  std::vector<Vec3> noPoints;
+  TreeType empty;
+  empty.Build(vtkm::cont::make_ArrayHandle(noPoints));
+  CheckQueries(empty, noPoints, queries, 2, 1.0f);
+}
+
+void TestTies()
+{
+  std::cout << "Points at equal distances" << std::endl;
+  // A lattice with every point twice, so there are ties in distance both
+  // between points and between copies of the same point.
+  std::vector<Vec3> points;
+  for (vtkm::Id copy = 0; copy < 2; copy++)
+  {
+    for (vtkm::Id index = 0; index < 64; index++)
+    {
+      points.push_back(Vec3(static_cast<vtkm::Float32>(index%4),
+                            static_cast<vtkm::Float32>((index/4)%4),
+                            static_cast<vtkm::Float32>(index/16)));
+    }
+  }
+  std::vector<Vec3> queries;
+  queries.push_back(Vec3(1.0f, 1.0f, 1.0f));
+  queries.push_back(Vec3(1.5f, 2.0f, 0.0f));
+
+  TreeType tree;
+  tree.SetLeafSize(3);
+  tree.Build(vtkm::cont::make_ArrayHandle(points));
+  vtkm::IdComponent k = 9;
+  vtkm::cont::ArrayHandle<vtkm::Id> nearestIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances2;
+  tree.FindNearestNeighbors(vtkm::cont::make_ArrayHandle(queries),
+                            k,
+                            nearestIds,
+                            distances2);
+  for (std::size_t query = 0; query < queries.size(); query++)
+  {
+    std::vector<std::pair<vtkm::Float32,vtkm::Id> > expected;
+    for (std::size_t point = 0; point < points.size(); point++)
+    {
+      expected.push_back(std::make_pair(Distance2(queries[query],
+                                                  points[point]),
+                                        static_cast<vtkm::Id>(point)));
+    }
+    std::sort(expected.begin(), expected.end());
+    for (vtkm::IdComponent slot = 0; slot < k; slot++)
+    {
+      vtkm::Id entry = static_cast<vtkm::Id>(query)*k + slot;
+      VTKM_TEST_ASSERT(nearestIds.GetPortalConstControl().Get(entry)
+                       == expected[static_cast<std::size_t>(slot)].second,
+                       "Ties should go to the smaller id.");
+      VTKM_TEST_ASSERT(distances2.GetPortalConstControl().Get(entry)
+                       == expected[static_cast<std::size_t>(slot)].first,
+                       "Wrong distance to nearest neighbor.");
+    }
+  }
+  CheckQueries(tree, points, queries, k, 1.0f);
+}
+
+void TestBadInput()
+{
+  std::cout << "Bad input" << std::endl;
+  Random random;
+  std::vector<Vec3> points = MakePoints(10, random, false);
+  TreeType tree;
+  tree.Build(vtkm::cont::make_ArrayHandle(points));
+  vtkm::cont::ArrayHandle<vtkm::Id> nearestIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances2;
+  try
+  {
+    tree.FindNearestNeighbors(vtkm::cont::make_ArrayHandle(points),
+                              0,
+                              nearestIds,
+                              distances2);
+    VTKM_TEST_FAIL("Did not catch zero neighbors.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  tree.SetLeafSize(0);
+  try
+  {
+    tree.Build(vtkm::cont::make_ArrayHandle(points));
+    VTKM_TEST_FAIL("Did not catch empty leaves.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestKdTree3D()
+{
+  TestScatteredPoints();
+  TestFlatPoints();
+  TestFewPoints();
+  TestTies();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestKdTree3D(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestKdTree3D);
+}
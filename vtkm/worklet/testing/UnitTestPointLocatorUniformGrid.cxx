@@ -0,0 +1,218 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/PointLocatorUniformGrid.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/internal/PointDistance.h>
+#include <vtkm/worklet/testing/Testing.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::PointLocatorUniformGrid<Device> LocatorType;
+typedef vtkm::Vec<vtkm::Float32,3> Vec3;
+using vtkm::worklet::testing::Random;
+using vtkm::worklet::internal::Distance2;
+
+const vtkm::Id NUMBER_OF_POINTS = 500;
+const vtkm::Id NUMBER_OF_QUERIES = 100;
+
+// Points in the box [0,4]x[0,2]x[0,1], or on the plane z = 0.5.
+std::vector<Vec3> MakePoints(vtkm::Id count, Random &random, bool flat)
+{
+  std::vector<Vec3> points;
+  for (vtkm::Id index = 0; index < count; index++)
+  {
+    vtkm::Float32 x = 4.0f*random.Next();
+    vtkm::Float32 y = 2.0f*random.Next();
+    vtkm::Float32 z = flat ? 0.5f : random.Next();
+    points.push_back(Vec3(x, y, z));
+  }
+  return points;
+}
+
+void CheckQueries(const LocatorType &locator,
+                  const std::vector<Vec3> &points,
+                  const std::vector<Vec3> &queries,
+                  vtkm::FloatDefault radius)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> nearestIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances2;
+  locator.FindNearestNeighbor(vtkm::cont::make_ArrayHandle(queries),
+                              nearestIds,
+                              distances2);
+  VTKM_TEST_ASSERT(nearestIds.GetNumberOfValues() ==
+                   static_cast<vtkm::Id>(queries.size()),
+                   "Wrong number of nearest neighbors.");
+
+  vtkm::cont::ArrayHandle<vtkm::Id> counts;
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  locator.FindInRadius(vtkm::cont::make_ArrayHandle(queries),
+                       radius,
+                       counts,
+                       offsets,
+                       neighborIds);
+
+  for (std::size_t query = 0; query < queries.size(); query++)
+  {
+    vtkm::Id index = static_cast<vtkm::Id>(query);
+
+    vtkm::Id expectedNearest = -1;
+    vtkm::Float32 expectedDistance2 = 0.0f;
+    std::vector<vtkm::Id> expectedNeighbors;
+    for (std::size_t point = 0; point < points.size(); point++)
+    {
+      vtkm::Float32 distance2 = Distance2(queries[query], points[point]);
+      if ((expectedNearest < 0) || (distance2 < expectedDistance2))
+      {
+        expectedNearest = static_cast<vtkm::Id>(point);
+        expectedDistance2 = distance2;
+      }
+      if (distance2 <= radius*radius)
+      {
+        expectedNeighbors.push_back(static_cast<vtkm::Id>(point));
+      }
+    }
+
+    VTKM_TEST_ASSERT(
+          nearestIds.GetPortalConstControl().Get(index) == expectedNearest,
+          "Wrong nearest neighbor.");
+    if (expectedNearest >= 0)
+    {
+      VTKM_TEST_ASSERT(
+            test_equal(distances2.GetPortalConstControl().Get(index),
+                       expectedDistance2),
+            "Wrong distance to nearest neighbor.");
+    }
+
+    vtkm::Id count = counts.GetPortalConstControl().Get(index);
+    VTKM_TEST_ASSERT(count == static_cast<vtkm::Id>(expectedNeighbors.size()),
+                     "Wrong number of points in radius.");
+    std::vector<vtkm::Id> neighbors;
+    for (vtkm::Id entry = 0; entry < count; entry++)
+    {
+      neighbors.push_back(neighborIds.GetPortalConstControl().Get(
+                            offsets.GetPortalConstControl().Get(index)
+                            + entry));
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    VTKM_TEST_ASSERT(neighbors == expectedNeighbors,
+                     "Wrong points in radius.");
+  }
+}
+
+void TestScatteredPoints()
+{
+  std::cout << "Scattered points" << std::endl;
+  Random random;
+  std::vector<Vec3> points = MakePoints(NUMBER_OF_POINTS, random, false);
+  std::vector<Vec3> queries = MakePoints(NUMBER_OF_QUERIES, random, false);
+  // Queries outside the bounds of the points.
+  queries.push_back(Vec3(-3.0f, 1.0f, 0.5f));
+  queries.push_back(Vec3(9.0f, -4.0f, 2.0f));
+  // A query on one of the points.
+  queries.push_back(points[17]);
+
+  LocatorType locator(vtkm::Id3(8, 5, 3));
+  locator.Build(vtkm::cont::make_ArrayHandle(points));
+  CheckQueries(locator, points, queries, 0.4f);
+
+  std::cout << "One bin" << std::endl;
+  LocatorType oneBin(vtkm::Id3(1, 1, 1));
+  oneBin.Build(vtkm::cont::make_ArrayHandle(points));
+  CheckQueries(oneBin, points, queries, 0.25f);
+
+  std::cout << "More bins than points" << std::endl;
+  LocatorType manyBins(vtkm::Id3(40, 20, 10));
+  manyBins.Build(vtkm::cont::make_ArrayHandle(points));
+  CheckQueries(manyBins, points, queries, 0.3f);
+
+  std::cout << "Bounds smaller than the points" << std::endl;
+  LocatorType smallBounds(vtkm::Id3(4, 4, 4));
+  smallBounds.Build(vtkm::cont::make_ArrayHandle(points),
+                    vtkm::Bounds(1.0, 2.0, 0.5, 1.0, 0.25, 0.5));
+  CheckQueries(smallBounds, points, queries, 0.4f);
+}
+
+void TestFlatPoints()
+{
+  std::cout << "Points on a plane" << std::endl;
+  Random random;
+  std::vector<Vec3> points = MakePoints(NUMBER_OF_POINTS, random, true);
+  std::vector<Vec3> queries = MakePoints(NUMBER_OF_QUERIES, random, false);
+  LocatorType locator(vtkm::Id3(6, 6, 6));
+  locator.Build(vtkm::cont::make_ArrayHandle(points));
+  CheckQueries(locator, points, queries, 0.6f);
+}
+
+void TestNoPoints()
+{
+  std::cout << "No points" << std::endl;
+  Random random;
+  std::vector<Vec3> points;
+  std::vector<Vec3> queries = MakePoints(5, random, false);
+  LocatorType locator(vtkm::Id3(3, 3, 3));
+  locator.Build(vtkm::cont::make_ArrayHandle(points),
+                vtkm::Bounds(0.0, 1.0, 0.0, 1.0, 0.0, 1.0));
+  CheckQueries(locator, points, queries, 1.0f);
+}
+
+void TestBadInput()
+{
+  std::cout << "Bad input" << std::endl;
+  Random random;
+  std::vector<Vec3> points = MakePoints(10, random, false);
+  LocatorType locator(vtkm::Id3(3, 0, 3));
+  try
+  {
+    locator.Build(vtkm::cont::make_ArrayHandle(points));
+    VTKM_TEST_FAIL("Did not catch zero divisions.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestPointLocatorUniformGrid()
+{
+  TestScatteredPoints();
+  TestFlatPoints();
+  TestNoPoints();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestPointLocatorUniformGrid(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestPointLocatorUniformGrid);
+}
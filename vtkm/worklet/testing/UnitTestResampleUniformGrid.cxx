@@ -0,0 +1,213 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/ResampleUniformGrid.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::ResampleUniformGrid<Device> ResampleType;
+typedef ResampleType::CellLocatorType LocatorType;
+typedef vtkm::Vec<vtkm::FloatDefault,3> Vec3;
+typedef vtkm::worklet::testing::Mesh<Vec3> Mesh;
+
+const vtkm::Id MESH_CELLS = 4;
+
+// A mesh of the unit cube: a grid with each cell either kept as a
+// hexahedron or split into a wedge and three tetrahedra, in turn.
+Mesh MakeMesh()
+{
+  Mesh mesh;
+  const vtkm::Id numPoints = MESH_CELLS + 1;
+  const vtkm::FloatDefault spacing =
+      vtkm::FloatDefault(1)/static_cast<vtkm::FloatDefault>(MESH_CELLS);
+  for (vtkm::Id index = 0; index < numPoints*numPoints*numPoints; index++)
+  {
+    vtkm::Id3 ijk(index%numPoints,
+                  (index/numPoints)%numPoints,
+                  index/(numPoints*numPoints));
+    Vec3 point;
+    for (vtkm::IdComponent axis = 0; axis < 3; axis++)
+    {
+      point[axis] = spacing*static_cast<vtkm::FloatDefault>(ijk[axis]);
+    }
+    mesh.Points.push_back(point);
+  }
+
+  for (vtkm::Id cell = 0; cell < MESH_CELLS*MESH_CELLS*MESH_CELLS; cell++)
+  {
+    vtkm::Id base = (cell/(MESH_CELLS*MESH_CELLS))*numPoints*numPoints
+        + ((cell/MESH_CELLS)%MESH_CELLS)*numPoints + cell%MESH_CELLS;
+    vtkm::Id hex[8] = {
+      base, base + 1, base + numPoints + 1, base + numPoints,
+      base + numPoints*numPoints,
+      base + numPoints*numPoints + 1,
+      base + numPoints*numPoints + numPoints + 1,
+      base + numPoints*numPoints + numPoints };
+    if (cell%2 == 0)
+    {
+      mesh.AddCell(vtkm::CELL_SHAPE_HEXAHEDRON, hex, 8);
+    }
+    else
+    {
+      // The wedge covers half the cell, and the two tetrahedra split the
+      // other half along the diagonal the wedge uses.
+      vtkm::Id wedge[6] = { hex[0], hex[1], hex[3], hex[4], hex[5], hex[7] };
+      vtkm::Id tet1[4] = { hex[1], hex[2], hex[3], hex[7] };
+      vtkm::Id tet2[4] = { hex[1], hex[2], hex[7], hex[6] };
+      vtkm::Id tet3[4] = { hex[1], hex[7], hex[6], hex[5] };
+      mesh.AddCell(vtkm::CELL_SHAPE_WEDGE, wedge, 6);
+      mesh.AddCell(vtkm::CELL_SHAPE_TETRA, tet1, 4);
+      mesh.AddCell(vtkm::CELL_SHAPE_TETRA, tet2, 4);
+      mesh.AddCell(vtkm::CELL_SHAPE_TETRA, tet3, 4);
+    }
+  }
+  return mesh;
+}
+
+// A field that is linear in space, so every cell shape interpolates it
+// exactly.
+vtkm::Float32 LinearField(const Vec3 &point, vtkm::Float32 time)
+{
+  return static_cast<vtkm::Float32>(
+        10.0f + time + 2.0f*point[0] - point[1] + 3.0f*point[2]);
+}
+
+// The target grid reaches past the unit cube on every side, and no target
+// point is on the surface of the cube.
+vtkm::cont::ArrayHandleUniformPointCoordinates MakeTarget()
+{
+  return vtkm::cont::ArrayHandleUniformPointCoordinates(
+        vtkm::Extent3(vtkm::Id3(0, 0, 0), vtkm::Id3(12, 13, 14)),
+        Vec3(-0.25f, -0.15f, -0.05f),
+        Vec3(0.11f, 0.1f, 0.09f));
+}
+
+void TestResample()
+{
+  std::cout << "Resample fields" << std::endl;
+  Mesh mesh = MakeMesh();
+  LocatorType locator(vtkm::Id3(4, 4, 4));
+  locator.Build(mesh.MakeCellSet(), vtkm::cont::make_ArrayHandle(mesh.Points));
+
+  vtkm::cont::ArrayHandleUniformPointCoordinates target = MakeTarget();
+  ResampleType resample(locator);
+  resample.Run(target);
+  vtkm::Id numTargets = target.GetNumberOfValues();
+  VTKM_TEST_ASSERT(resample.GetCellIds().GetNumberOfValues() == numTargets,
+                   "Wrong number of cell ids.");
+
+  // The same located points serve each time step, and fields of any type.
+  for (vtkm::Float32 time = 0.0f; time < 3.0f; time += 1.0f)
+  {
+    std::vector<vtkm::Float32> scalars;
+    for (std::size_t index = 0; index < mesh.Points.size(); index++)
+    {
+      scalars.push_back(LinearField(mesh.Points[index], time));
+    }
+    vtkm::cont::ArrayHandle<vtkm::Float32> resampledScalars;
+    resample.Interpolate(vtkm::cont::make_ArrayHandle(scalars),
+                         -1.0f,
+                         resampledScalars);
+    vtkm::cont::ArrayHandle<Vec3> resampledPoints;
+    resample.Interpolate(vtkm::cont::make_ArrayHandle(mesh.Points),
+                         resampledPoints);
+    VTKM_TEST_ASSERT(resampledScalars.GetNumberOfValues() == numTargets,
+                     "Wrong number of resampled values.");
+
+    vtkm::Id numInside = 0;
+    for (vtkm::Id index = 0; index < numTargets; index++)
+    {
+      Vec3 point = target.GetPortalConstControl().Get(index);
+      bool inside = (point[0] > 0) && (point[0] < 1)
+          && (point[1] > 0) && (point[1] < 1)
+          && (point[2] > 0) && (point[2] < 1);
+      vtkm::Id cellId = resample.GetCellIds().GetPortalConstControl()
+          .Get(index);
+      vtkm::Float32 value =
+          resampledScalars.GetPortalConstControl().Get(index);
+      Vec3 position = resampledPoints.GetPortalConstControl().Get(index);
+      if (inside)
+      {
+        VTKM_TEST_ASSERT(cellId >= 0, "Point inside the mesh not found.");
+        VTKM_TEST_ASSERT(test_equal(value, LinearField(point, time)),
+                         "Wrong resampled value.");
+        VTKM_TEST_ASSERT(test_equal(position, point, 0.0001),
+                         "Wrong resampled position.");
+        numInside++;
+      }
+      else
+      {
+        VTKM_TEST_ASSERT(cellId == -1, "Point outside the mesh was found.");
+        VTKM_TEST_ASSERT(value == -1.0f, "Wrong fill value.");
+        VTKM_TEST_ASSERT(position == Vec3(0.0f), "Wrong default fill value.");
+      }
+    }
+    VTKM_TEST_ASSERT(numInside > 0, "No target points in the mesh.");
+  }
+}
+
+void TestBadInput()
+{
+  std::cout << "Bad input" << std::endl;
+  Mesh mesh = MakeMesh();
+  LocatorType locator(vtkm::Id3(2, 2, 2));
+  locator.Build(mesh.MakeCellSet(), vtkm::cont::make_ArrayHandle(mesh.Points));
+  ResampleType resample(locator);
+  resample.Run(MakeTarget());
+
+  std::vector<vtkm::Float32> field(mesh.Points.size() - 1, 1.0f);
+  vtkm::cont::ArrayHandle<vtkm::Float32> output;
+  try
+  {
+    resample.Interpolate(vtkm::cont::make_ArrayHandle(field), output);
+    VTKM_TEST_FAIL("Did not catch field of the wrong size.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestResampleUniformGrid()
+{
+  TestResample();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestResampleUniformGrid(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestResampleUniformGrid);
+}
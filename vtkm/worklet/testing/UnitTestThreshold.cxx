@@ -0,0 +1,399 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/Threshold.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/ErrorExecution.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::Threshold<Device> ThresholdType;
+typedef vtkm::Vec<vtkm::Float32,3> Vec3;
+
+// A triangle, a quad, and a triangle in a strip.
+const vtkm::Id NUMBER_OF_POINTS = 6;
+const Vec3 COORDINATES[NUMBER_OF_POINTS] = {
+  Vec3(0.0f, 0.0f, 0.0f),
+  Vec3(1.0f, 0.0f, 0.0f),
+  Vec3(0.0f, 1.0f, 0.0f),
+  Vec3(2.0f, 0.0f, 0.0f),
+  Vec3(2.0f, 1.0f, 0.0f),
+  Vec3(3.0f, 0.0f, 0.0f)
+};
+const vtkm::Float64 POINT_VALUES[NUMBER_OF_POINTS] = {
+  0.5, 1.5, 2.5, 3.5, 4.5, 5.5 };
+// A second field of the same type, so it is gathered in the same pass.
+const vtkm::Float64 OTHER_POINT_VALUES[NUMBER_OF_POINTS] = {
+  -1.0, -2.0, -3.0, -4.0, -5.0, -6.0 };
+
+const vtkm::Id NUMBER_OF_CELLS = 3;
+const vtkm::UInt8 SHAPES[NUMBER_OF_CELLS] = {
+  vtkm::CELL_SHAPE_TRIANGLE, vtkm::CELL_SHAPE_QUAD, vtkm::CELL_SHAPE_TRIANGLE
+};
+const vtkm::IdComponent NUM_INDICES[NUMBER_OF_CELLS] = { 3, 4, 3 };
+const vtkm::Id CONNECTIVITY_LENGTH = 10;
+const vtkm::Id CONNECTIVITY[CONNECTIVITY_LENGTH] = {
+  0, 1, 2,  1, 3, 4, 2,  3, 5, 4 };
+const vtkm::Int32 CELL_VALUES[NUMBER_OF_CELLS] = { 1, 5, 10 };
+
+// The result of keeping the cells with values in [4, 11].
+const vtkm::Id EXPECTED_CELL_IDS[2] = { 1, 2 };
+const vtkm::Id EXPECTED_POINT_IDS[5] = { 1, 2, 3, 4, 5 };
+const vtkm::Id EXPECTED_CONNECTIVITY[7] = { 0, 2, 3, 1,  2, 4, 3 };
+
+vtkm::cont::DataSet MakeExplicitDataSet()
+{
+  vtkm::cont::DataSet dataSet;
+
+  dataSet.AddCoordinateSystem(
+        vtkm::cont::CoordinateSystem(
+          "coordinates",
+          vtkm::cont::make_ArrayHandle(COORDINATES, NUMBER_OF_POINTS)));
+
+  boost::shared_ptr<vtkm::cont::CellSetExplicit<> > cellSet(
+        new vtkm::cont::CellSetExplicit<>("cells", NUMBER_OF_POINTS, 2));
+  cellSet->Fill(vtkm::cont::make_ArrayHandle(SHAPES, NUMBER_OF_CELLS),
+                vtkm::cont::make_ArrayHandle(NUM_INDICES, NUMBER_OF_CELLS),
+                vtkm::cont::make_ArrayHandle(CONNECTIVITY,
+                                             CONNECTIVITY_LENGTH));
+  dataSet.AddCellSet(cellSet);
+
+  dataSet.AddField(vtkm::cont::Field(
+                     "pointvar",
+                     vtkm::cont::Field::ASSOC_POINTS,
+                     vtkm::cont::make_ArrayHandle(POINT_VALUES,
+                                                  NUMBER_OF_POINTS)));
+  dataSet.AddField(vtkm::cont::Field(
+                     "otherpointvar",
+                     vtkm::cont::Field::ASSOC_POINTS,
+                     vtkm::cont::make_ArrayHandle(OTHER_POINT_VALUES,
+                                                  NUMBER_OF_POINTS)));
+  dataSet.AddField(vtkm::cont::Field(
+                     "cellvar",
+                     "cells",
+                     vtkm::cont::make_ArrayHandle(CELL_VALUES,
+                                                  NUMBER_OF_CELLS)));
+  dataSet.AddField(vtkm::cont::Field(
+                     "othercellvar",
+                     "othercells",
+                     vtkm::cont::make_ArrayHandle(CELL_VALUES,
+                                                  NUMBER_OF_CELLS)));
+  dataSet.AddField(vtkm::cont::Field(
+                     "meshvar",
+                     vtkm::cont::Field::ASSOC_WHOLE_MESH,
+                     vtkm::cont::make_ArrayHandle(CELL_VALUES, 1)));
+  return dataSet;
+}
+
+template<typename T, typename PortalType>
+void CheckValues(const PortalType &portal,
+                 const T *expected,
+                 vtkm::Id numValues)
+{
+  VTKM_TEST_ASSERT(portal.GetNumberOfValues() == numValues,
+                   "Wrong number of values.");
+  for (vtkm::Id index = 0; index < numValues; index++)
+  {
+    VTKM_TEST_ASSERT(test_equal(portal.Get(index), expected[index]),
+                     "Wrong value.");
+  }
+}
+
+void TestExplicitCellField()
+{
+  std::cout << "Testing threshold of explicit cells by a cell field."
+            << std::endl;
+  vtkm::cont::DataSet input = MakeExplicitDataSet();
+  const vtkm::cont::CellSetExplicit<> &cellSet =
+      dynamic_cast<const vtkm::cont::CellSetExplicit<> &>(
+        *input.GetCellSet("cells"));
+
+  ThresholdType threshold(4.0, 11.0);
+  vtkm::cont::DataSet output = threshold.Run(input, cellSet, "cellvar");
+
+  CheckValues(threshold.GetValidCellIds().GetPortalConstControl(),
+              EXPECTED_CELL_IDS, 2);
+  CheckValues(threshold.GetValidPointIds().GetPortalConstControl(),
+              EXPECTED_POINT_IDS, 5);
+
+  VTKM_TEST_ASSERT(output.GetNumberOfCellSets() == 1,
+                   "Wrong number of cell sets.");
+  boost::shared_ptr<ThresholdType::OutputCellSetType> outputCells =
+      threshold.GetOutputCellSet();
+  VTKM_TEST_ASSERT(output.GetCellSet(0) == outputCells,
+                   "Output cell set not in data set.");
+  VTKM_TEST_ASSERT(outputCells->GetName() == "cells", "Wrong name.");
+  VTKM_TEST_ASSERT(outputCells->GetDimensionality() == 2,
+                   "Wrong dimensionality.");
+  VTKM_TEST_ASSERT(outputCells->GetNumberOfPoints() == 5,
+                   "Wrong number of points.");
+  CheckValues(outputCells->GetShapesArray().GetPortalConstControl(),
+              SHAPES + 1, 2);
+  CheckValues(outputCells->GetNumIndicesArray().GetPortalConstControl(),
+              NUM_INDICES + 1, 2);
+  CheckValues(outputCells->GetConnectivityArray().GetPortalConstControl(),
+              EXPECTED_CONNECTIVITY, 7);
+
+  std::cout << "  Checking fields." << std::endl;
+  VTKM_TEST_ASSERT(output.GetNumberOfCoordinateSystems() == 1,
+                   "Wrong number of coordinate systems.");
+  CheckValues(output.GetCoordinateSystem("coordinates").GetData()
+                .CastToArrayHandle(Vec3(), vtkm::cont::StorageTagBasic())
+                .GetPortalConstControl(),
+              COORDINATES + 1, 5);
+  VTKM_TEST_ASSERT(output.GetNumberOfFields() == 4,
+                   "Wrong number of fields.");
+  CheckValues(output.GetField("pointvar").GetData()
+                .CastToArrayHandle(vtkm::Float64(),
+                                   vtkm::cont::StorageTagBasic())
+                .GetPortalConstControl(),
+              POINT_VALUES + 1, 5);
+  CheckValues(output.GetField("otherpointvar").GetData()
+                .CastToArrayHandle(vtkm::Float64(),
+                                   vtkm::cont::StorageTagBasic())
+                .GetPortalConstControl(),
+              OTHER_POINT_VALUES + 1, 5);
+  const vtkm::cont::Field &cellField = output.GetField("cellvar");
+  VTKM_TEST_ASSERT(cellField.GetAssocCellSet() == "cells",
+                   "Wrong cell set.");
+  CheckValues(cellField.GetData()
+                .CastToArrayHandle(vtkm::Int32(),
+                                   vtkm::cont::StorageTagBasic())
+                .GetPortalConstControl(),
+              CELL_VALUES + 1, 2);
+  CheckValues(output.GetField("meshvar").GetData()
+                .CastToArrayHandle(vtkm::Int32(),
+                                   vtkm::cont::StorageTagBasic())
+                .GetPortalConstControl(),
+              CELL_VALUES, 1);
+}
+
+void TestExplicitPointField()
+{
+  std::cout << "Testing threshold of explicit cells by a point field."
+            << std::endl;
+  vtkm::cont::DataSet input = MakeExplicitDataSet();
+  const vtkm::cont::CellSetExplicit<> &cellSet =
+      dynamic_cast<const vtkm::cont::CellSetExplicit<> &>(
+        *input.GetCellSet("cells"));
+
+  // Only the first triangle has all its point values in range.
+  ThresholdType threshold(0.0, 3.0);
+  threshold.Run(cellSet,
+                vtkm::cont::make_ArrayHandle(POINT_VALUES, NUMBER_OF_POINTS),
+                vtkm::cont::Field::ASSOC_POINTS);
+  const vtkm::Id expectedIds[3] = { 0, 1, 2 };
+  CheckValues(threshold.GetValidCellIds().GetPortalConstControl(),
+              expectedIds, 1);
+  CheckValues(threshold.GetValidPointIds().GetPortalConstControl(),
+              expectedIds, 3);
+  CheckValues(threshold.GetOutputCellSet()->GetConnectivityArray()
+                .GetPortalConstControl(),
+              expectedIds, 3);
+}
+
+void TestStructuredPointField()
+{
+  std::cout << "Testing threshold of structured cells by a point field."
+            << std::endl;
+  const vtkm::Id3 dimensions(4, 3, 3);
+  const vtkm::Id numPoints = dimensions[0]*dimensions[1]*dimensions[2];
+  vtkm::Extent3 extent(vtkm::Id3(0, 0, 0), dimensions - vtkm::Id3(1, 1, 1));
+
+  vtkm::cont::DataSet input;
+  input.AddCoordinateSystem(
+        vtkm::cont::CoordinateSystem(
+          "coordinates",
+          vtkm::cont::ArrayHandleUniformPointCoordinates(
+            extent, Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f, 1.0f, 1.0f))));
+  boost::shared_ptr<vtkm::cont::CellSetStructured<3> > cellSet(
+        new vtkm::cont::CellSetStructured<3>("cells", extent));
+  input.AddCellSet(cellSet);
+
+  // The point values are the x index, so the cells in the first slab pass.
+  std::vector<vtkm::Float32> pointValues(static_cast<std::size_t>(numPoints));
+  for (vtkm::Id index = 0; index < numPoints; index++)
+  {
+    pointValues[static_cast<std::size_t>(index)] =
+        static_cast<vtkm::Float32>(index % dimensions[0]);
+  }
+  input.AddField(vtkm::cont::Field("pointvar",
+                                   vtkm::cont::Field::ASSOC_POINTS,
+                                   vtkm::cont::make_ArrayHandle(pointValues)));
+
+  ThresholdType threshold(0.0, 1.0);
+  vtkm::cont::DataSet output = threshold.Run(input, *cellSet, "pointvar");
+
+  boost::shared_ptr<ThresholdType::OutputCellSetType> outputCells =
+      threshold.GetOutputCellSet();
+  VTKM_TEST_ASSERT(outputCells->GetNumberOfCells() == 4,
+                   "Wrong number of cells.");
+  VTKM_TEST_ASSERT(outputCells->GetNumberOfPoints() == 18,
+                   "Wrong number of points.");
+  VTKM_TEST_ASSERT(outputCells->GetConnectivityArray().GetNumberOfValues()
+                   == 32,
+                   "Wrong connectivity length.");
+  for (vtkm::Id cellIndex = 0; cellIndex < 4; cellIndex++)
+  {
+    VTKM_TEST_ASSERT(outputCells->GetShapesArray().GetPortalConstControl()
+                     .Get(cellIndex) == vtkm::CELL_SHAPE_HEXAHEDRON,
+                     "Wrong shape.");
+  }
+
+  vtkm::cont::ArrayHandle<Vec3> coordinates =
+      output.GetCoordinateSystem(0).GetData()
+      .CastToArrayHandle(Vec3(), vtkm::cont::StorageTagBasic());
+  vtkm::cont::ArrayHandle<vtkm::Float32> outputValues =
+      output.GetField("pointvar").GetData()
+      .CastToArrayHandle(vtkm::Float32(), vtkm::cont::StorageTagBasic());
+  VTKM_TEST_ASSERT(coordinates.GetNumberOfValues() == 18,
+                   "Wrong number of coordinates.");
+  VTKM_TEST_ASSERT(outputValues.GetNumberOfValues() == 18,
+                   "Wrong number of point values.");
+  for (vtkm::Id index = 0; index < 18; index++)
+  {
+    Vec3 coordinate = coordinates.GetPortalConstControl().Get(index);
+    VTKM_TEST_ASSERT(coordinate[0] <= 1.0f, "Wrong point kept.");
+    VTKM_TEST_ASSERT(test_equal(coordinate[0],
+                                outputValues.GetPortalConstControl()
+                                .Get(index)),
+                     "Point values do not follow the points.");
+  }
+}
+
+void TestEmptyResult()
+{
+  std::cout << "Testing threshold that removes every cell." << std::endl;
+  vtkm::cont::DataSet input = MakeExplicitDataSet();
+  ThresholdType threshold(100.0, 200.0);
+  vtkm::cont::DataSet output =
+      threshold.Run(input,
+                    dynamic_cast<const vtkm::cont::CellSetExplicit<> &>(
+                      *input.GetCellSet("cells")),
+                    "pointvar");
+  VTKM_TEST_ASSERT(threshold.GetOutputCellSet()->GetNumberOfCells() == 0,
+                   "Cells not removed.");
+  VTKM_TEST_ASSERT(threshold.GetValidPointIds().GetNumberOfValues() == 0,
+                   "Points not removed.");
+  VTKM_TEST_ASSERT(output.GetField("pointvar").GetData().GetNumberOfValues()
+                   == 0,
+                   "Point field not emptied.");
+}
+
+void TestBadInput()
+{
+  std::cout << "Testing threshold with bad input." << std::endl;
+  vtkm::cont::DataSet input = MakeExplicitDataSet();
+  const vtkm::cont::CellSetExplicit<> &cellSet =
+      dynamic_cast<const vtkm::cont::CellSetExplicit<> &>(
+        *input.GetCellSet("cells"));
+  ThresholdType threshold(0.0, 1.0);
+
+  try
+  {
+    threshold.Run(cellSet,
+                  vtkm::cont::make_ArrayHandle(POINT_VALUES, NUMBER_OF_CELLS),
+                  vtkm::cont::Field::ASSOC_POINTS);
+    VTKM_TEST_FAIL("Did not catch field of the wrong size.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  try
+  {
+    threshold.Run(input, cellSet, "meshvar");
+    VTKM_TEST_FAIL("Did not catch whole mesh field.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  try
+  {
+    threshold.Run(input, cellSet, "othercellvar");
+    VTKM_TEST_FAIL("Did not catch field of another cell set.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  vtkm::cont::CellSetExplicit<> tooFewPoints("cells", NUMBER_OF_POINTS-1, 2);
+  tooFewPoints.Fill(vtkm::cont::make_ArrayHandle(SHAPES, NUMBER_OF_CELLS),
+                    vtkm::cont::make_ArrayHandle(NUM_INDICES, NUMBER_OF_CELLS),
+                    vtkm::cont::make_ArrayHandle(CONNECTIVITY,
+                                                 CONNECTIVITY_LENGTH));
+  // Every cell passes, so the cells that use the missing point are kept.
+  ThresholdType passAll(-1.0e30, 1.0e30);
+  try
+  {
+    passAll.Run(tooFewPoints,
+                vtkm::cont::make_ArrayHandle(CELL_VALUES, NUMBER_OF_CELLS),
+                vtkm::cont::Field::ASSOC_CELL_SET);
+    VTKM_TEST_FAIL("Did not catch point index beyond the number of points.");
+  }
+  catch (vtkm::cont::ErrorExecution &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  try
+  {
+    passAll.Run(tooFewPoints,
+                vtkm::cont::make_ArrayHandle(POINT_VALUES,
+                                             NUMBER_OF_POINTS-1),
+                vtkm::cont::Field::ASSOC_POINTS);
+    VTKM_TEST_FAIL("Did not catch point index beyond the number of points.");
+  }
+  catch (vtkm::cont::ErrorExecution &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestThreshold()
+{
+  TestExplicitCellField();
+  TestExplicitPointField();
+  TestStructuredPointField();
+  TestEmptyResult();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestThreshold(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestThreshold);
+}
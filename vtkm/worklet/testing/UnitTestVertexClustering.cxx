@@ -0,0 +1,305 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2014 Sandia Corporation.
+//  Copyright 2014 UT-Battelle, LLC.
+//  Copyright 2014. Los Alamos National Security
+//
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//  Under the terms of Contract DE-AC52-06NA25396 with Los Alamos National
+//  Laboratory (LANL), the U.S. Government retains certain rights in
+//  this software.
+//============================================================================
+#define VTKM_DEVICE_ADAPTER VTKM_DEVICE_ADAPTER_SERIAL
+
+#include <vtkm/worklet/VertexClustering.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/ErrorControlBadValue.h>
+#include <vtkm/cont/ErrorExecution.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <limits>
+#include <vector>
+
+namespace {
+
+typedef VTKM_DEFAULT_DEVICE_ADAPTER_TAG Device;
+typedef vtkm::worklet::VertexClustering<Device> VertexClusteringType;
+typedef vtkm::Vec<vtkm::Float32,3> Vec3;
+
+const vtkm::Id GRID_SIZE = 11;
+
+// A square of (GRID_SIZE-1)^2 quads on [0,1]x[0,1], each split into two
+// triangles.
+void MakePlane(std::vector<Vec3> &points, std::vector<vtkm::Id> &connectivity)
+{
+  for (vtkm::Id j = 0; j < GRID_SIZE; j++)
+  {
+    for (vtkm::Id i = 0; i < GRID_SIZE; i++)
+    {
+      points.push_back(
+            Vec3(static_cast<vtkm::Float32>(i)/(GRID_SIZE-1),
+                 static_cast<vtkm::Float32>(j)/(GRID_SIZE-1),
+                 0.0f));
+    }
+  }
+  for (vtkm::Id j = 0; j < GRID_SIZE-1; j++)
+  {
+    for (vtkm::Id i = 0; i < GRID_SIZE-1; i++)
+    {
+      vtkm::Id corner = j*GRID_SIZE + i;
+      connectivity.push_back(corner);
+      connectivity.push_back(corner + 1);
+      connectivity.push_back(corner + GRID_SIZE + 1);
+      connectivity.push_back(corner);
+      connectivity.push_back(corner + GRID_SIZE + 1);
+      connectivity.push_back(corner + GRID_SIZE);
+    }
+  }
+}
+
+void CheckTriangles(const vtkm::cont::ArrayHandle<vtkm::Id> &connectivity,
+                    vtkm::Id numPoints)
+{
+  VTKM_TEST_ASSERT(connectivity.GetNumberOfValues() % 3 == 0,
+                   "Output is not triangles.");
+  vtkm::Id numTriangles = connectivity.GetNumberOfValues()/3;
+  for (vtkm::Id triangle = 0; triangle < numTriangles; triangle++)
+  {
+    vtkm::Id3 points(connectivity.GetPortalConstControl().Get(3*triangle),
+                     connectivity.GetPortalConstControl().Get(3*triangle+1),
+                     connectivity.GetPortalConstControl().Get(3*triangle+2));
+    for (vtkm::IdComponent index = 0; index < 3; index++)
+    {
+      VTKM_TEST_ASSERT((points[index] >= 0) && (points[index] < numPoints),
+                       "Bad point index.");
+      VTKM_TEST_ASSERT(points[index] != points[(index+1)%3],
+                       "Degenerate triangle not removed.");
+    }
+  }
+}
+
+void TestClusterPlane()
+{
+  std::cout << "Testing clustering of a plane." << std::endl;
+  std::vector<Vec3> points;
+  std::vector<vtkm::Id> connectivity;
+  MakePlane(points, connectivity);
+
+  VertexClusteringType clustering(vtkm::Id3(2, 2, 1));
+  vtkm::cont::ArrayHandle<Vec3> outputPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> outputConnectivity;
+  clustering.Run(vtkm::cont::make_ArrayHandle(points),
+                 vtkm::cont::make_ArrayHandle(connectivity),
+                 outputPoints,
+                 outputConnectivity);
+
+  VTKM_TEST_ASSERT(outputPoints.GetNumberOfValues() == 4,
+                   "Wrong number of clusters.");
+  CheckTriangles(outputConnectivity, 4);
+  // Only the quad at the center touches all four bins, and only one of its
+  // triangles ends up with three different bins on each side of the
+  // diagonal.
+  VTKM_TEST_ASSERT(outputConnectivity.GetNumberOfValues() == 6,
+                   "Wrong number of triangles.");
+
+  std::cout << "  Checking averages." << std::endl;
+  std::vector<Vec3> sums(4, Vec3(0.0f));
+  std::vector<vtkm::Id> counts(4, 0);
+  const vtkm::cont::ArrayHandle<vtkm::Id> &pointMap = clustering.GetPointMap();
+  VTKM_TEST_ASSERT(pointMap.GetNumberOfValues()
+                   == static_cast<vtkm::Id>(points.size()),
+                   "Wrong point map size.");
+  for (std::size_t index = 0; index < points.size(); index++)
+  {
+    Vec3 point = points[index];
+    vtkm::Id bin = pointMap.GetPortalConstControl().Get(
+          static_cast<vtkm::Id>(index));
+    // The bins are ordered with x varying fastest.
+    vtkm::Id expectedBin = ((point[0] < 0.5f) ? 0 : 1)
+        + ((point[1] < 0.5f) ? 0 : 2);
+    VTKM_TEST_ASSERT(bin == expectedBin, "Point in wrong bin.");
+    sums[static_cast<std::size_t>(bin)] =
+        sums[static_cast<std::size_t>(bin)] + point;
+    counts[static_cast<std::size_t>(bin)]++;
+  }
+  for (vtkm::Id bin = 0; bin < 4; bin++)
+  {
+    std::size_t binIndex = static_cast<std::size_t>(bin);
+    Vec3 average = sums[binIndex]
+        * (1.0f/static_cast<vtkm::Float32>(counts[binIndex]));
+    VTKM_TEST_ASSERT(test_equal(outputPoints.GetPortalConstControl().Get(bin),
+                                average),
+                     "Wrong average point.");
+  }
+}
+
+void TestFineGrid()
+{
+  std::cout << "Testing clustering with a bin for every point." << std::endl;
+  std::vector<Vec3> points;
+  std::vector<vtkm::Id> connectivity;
+  MakePlane(points, connectivity);
+
+  VertexClusteringType clustering(vtkm::Id3(GRID_SIZE, GRID_SIZE, 1));
+  vtkm::cont::ArrayHandle<Vec3> outputPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> outputConnectivity;
+  clustering.Run(vtkm::cont::make_ArrayHandle(points),
+                 vtkm::cont::make_ArrayHandle(connectivity),
+                 vtkm::Bounds(-0.05, 1.05, -0.05, 1.05, 0.0, 0.0),
+                 outputPoints,
+                 outputConnectivity);
+
+  // The points are already in bin order, so nothing changes.
+  VTKM_TEST_ASSERT(outputPoints.GetNumberOfValues()
+                   == static_cast<vtkm::Id>(points.size()),
+                   "Points merged.");
+  for (vtkm::Id index = 0; index < outputPoints.GetNumberOfValues(); index++)
+  {
+    VTKM_TEST_ASSERT(test_equal(outputPoints.GetPortalConstControl().Get(index),
+                                points[static_cast<std::size_t>(index)]),
+                     "Point moved.");
+  }
+  VTKM_TEST_ASSERT(outputConnectivity.GetNumberOfValues()
+                   == static_cast<vtkm::Id>(connectivity.size()),
+                   "Triangles removed.");
+  for (vtkm::Id index = 0;
+       index < outputConnectivity.GetNumberOfValues();
+       index++)
+  {
+    VTKM_TEST_ASSERT(outputConnectivity.GetPortalConstControl().Get(index)
+                     == connectivity[static_cast<std::size_t>(index)],
+                     "Triangle changed.");
+  }
+}
+
+void TestSingleBin()
+{
+  std::cout << "Testing clustering into a single bin." << std::endl;
+  std::vector<Vec3> points;
+  std::vector<vtkm::Id> connectivity;
+  MakePlane(points, connectivity);
+
+  VertexClusteringType clustering(vtkm::Id3(1, 1, 1));
+  vtkm::cont::ArrayHandle<Vec3> outputPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> outputConnectivity;
+  clustering.Run(vtkm::cont::make_ArrayHandle(points),
+                 vtkm::cont::make_ArrayHandle(connectivity),
+                 outputPoints,
+                 outputConnectivity);
+  VTKM_TEST_ASSERT(outputPoints.GetNumberOfValues() == 1,
+                   "Wrong number of points.");
+  VTKM_TEST_ASSERT(test_equal(outputPoints.GetPortalConstControl().Get(0),
+                              Vec3(0.5f, 0.5f, 0.0f)),
+                   "Wrong average point.");
+  VTKM_TEST_ASSERT(outputConnectivity.GetNumberOfValues() == 0,
+                   "Degenerate triangles not removed.");
+}
+
+void TestPointsOutsideBounds()
+{
+  std::cout << "Testing clustering of points outside the bounds." << std::endl;
+  std::vector<Vec3> points;
+  std::vector<vtkm::Id> connectivity;
+  MakePlane(points, connectivity);
+  // Far beyond the bounds and not a number.
+  points[GRID_SIZE-1][0] = 1.0e30f;
+  points[0][0] = std::numeric_limits<vtkm::Float32>::quiet_NaN();
+
+  VertexClusteringType clustering(vtkm::Id3(2, 2, 1));
+  vtkm::cont::ArrayHandle<Vec3> outputPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> outputConnectivity;
+  clustering.Run(vtkm::cont::make_ArrayHandle(points),
+                 vtkm::cont::make_ArrayHandle(connectivity),
+                 vtkm::Bounds(0.4, 0.6, 0.4, 0.6, 0.0, 0.0),
+                 outputPoints,
+                 outputConnectivity);
+
+  VTKM_TEST_ASSERT(outputPoints.GetNumberOfValues() == 4,
+                   "Wrong number of clusters.");
+  const vtkm::cont::ArrayHandle<vtkm::Id> &pointMap = clustering.GetPointMap();
+  VTKM_TEST_ASSERT(pointMap.GetPortalConstControl().Get(GRID_SIZE-1) == 1,
+                   "Far point not in the nearest bin.");
+  VTKM_TEST_ASSERT(pointMap.GetPortalConstControl().Get(0) == 0,
+                   "NaN point not in the first bin.");
+}
+
+void TestBadInput()
+{
+  std::cout << "Testing clustering with bad input." << std::endl;
+  std::vector<Vec3> points;
+  std::vector<vtkm::Id> connectivity;
+  MakePlane(points, connectivity);
+  vtkm::cont::ArrayHandle<Vec3> outputPoints;
+  vtkm::cont::ArrayHandle<vtkm::Id> outputConnectivity;
+
+  try
+  {
+    VertexClusteringType clustering(vtkm::Id3(2, 0, 2));
+    clustering.Run(vtkm::cont::make_ArrayHandle(points),
+                   vtkm::cont::make_ArrayHandle(connectivity),
+                   outputPoints,
+                   outputConnectivity);
+    VTKM_TEST_FAIL("Did not catch missing divisions.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  try
+  {
+    VertexClusteringType clustering(vtkm::Id3(2, 2, 2));
+    clustering.Run(vtkm::cont::make_ArrayHandle(points),
+                   vtkm::cont::make_ArrayHandle(&connectivity.front(), 4),
+                   outputPoints,
+                   outputConnectivity);
+    VTKM_TEST_FAIL("Did not catch partial triangle.");
+  }
+  catch (vtkm::cont::ErrorControlBadValue &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+
+  std::vector<vtkm::Id> badConnectivity(connectivity);
+  badConnectivity[4] = static_cast<vtkm::Id>(points.size());
+  try
+  {
+    VertexClusteringType clustering(vtkm::Id3(2, 2, 2));
+    clustering.Run(vtkm::cont::make_ArrayHandle(points),
+                   vtkm::cont::make_ArrayHandle(badConnectivity),
+                   outputPoints,
+                   outputConnectivity);
+    VTKM_TEST_FAIL("Did not catch point index out of range.");
+  }
+  catch (vtkm::cont::ErrorExecution &error)
+  {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+  }
+}
+
+void TestVertexClustering()
+{
+  TestClusterPlane();
+  TestFineGrid();
+  TestSingleBin();
+  TestPointsOutsideBounds();
+  TestBadInput();
+}
+
+} // anonymous namespace
+
+int UnitTestVertexClustering(int, char *[])
+{
+  return vtkm::cont::testing::Testing::Run(TestVertexClustering);
+}